@@ -0,0 +1,52 @@
+AC_DEFUN([SST_CHECK_CXX20_COROUTINES],
+[
+  sst_check_cxx20_coroutines_happy="no"
+  CXX20_COROUTINES_CXXFLAGS=
+
+  AC_ARG_ENABLE([cxx20-coroutines],
+    [AS_HELP_STRING([--disable-cxx20-coroutines],
+      [Do not build components that are written as C++20 coroutines])])
+
+  CXXFLAGS_saved="$CXXFLAGS"
+
+  AC_MSG_CHECKING([for C++20 coroutines])
+
+  AS_IF([test "x$enable_cxx20_coroutines" != "xno"], [
+    AC_LANG_PUSH([C++])
+    # The first flag set that compiles wins, the -std flag comes after the
+    # ones from sst-config so it overrides their standard
+    for sst_check_cxx20_coroutines_flags in "" "-std=c++20" "-std=c++2a -fcoroutines" ; do
+      CXXFLAGS="$AM_CXXFLAGS $CXXFLAGS_saved $sst_check_cxx20_coroutines_flags"
+      AC_COMPILE_IFELSE([AC_LANG_PROGRAM([[
+#include <coroutine>
+#ifndef __cpp_impl_coroutine
+#error "no coroutine support"
+#endif
+struct task {
+    struct promise_type {
+        task get_return_object() { return task(); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() {}
+    };
+};
+task body() { co_await std::suspend_always(); }
+]], [[body();]])],
+        [sst_check_cxx20_coroutines_happy="yes"
+         CXX20_COROUTINES_CXXFLAGS="$sst_check_cxx20_coroutines_flags"])
+      AS_IF([test "$sst_check_cxx20_coroutines_happy" = "yes"], [break])
+    done
+    AC_LANG_POP([C++])
+  ])
+
+  CXXFLAGS="$CXXFLAGS_saved"
+
+  AS_IF([test "$sst_check_cxx20_coroutines_happy" = "yes" -a ! -z "$CXX20_COROUTINES_CXXFLAGS"],
+    [AC_MSG_RESULT([yes, with $CXX20_COROUTINES_CXXFLAGS])],
+    [AC_MSG_RESULT([$sst_check_cxx20_coroutines_happy])])
+
+  AC_SUBST([CXX20_COROUTINES_CXXFLAGS])
+
+  AS_IF([test "$sst_check_cxx20_coroutines_happy" = "yes"], [$1], [$2])
+])
@@ -0,0 +1,49 @@
+AC_DEFUN([SST_CHECK_ZSTD],
+[
+  sst_check_zstd_happy="yes"
+
+  AC_ARG_WITH([zstd],
+    [AS_HELP_STRING([--with-zstd@<:@=DIR@:>@],
+      [Use zstd (compression routines) found in DIR])])
+
+  AS_IF([test "$with_zstd" = "no"], [sst_check_zstd_happy="no"])
+
+  CXXFLAGS_saved="$CXXFLAGS"
+  CPPFLAGS_saved="$CPPFLAGS"
+  LDFLAGS_saved="$LDFLAGS"
+  LIBS_saved="$LIBS"
+
+  AS_IF([test "$sst_check_zstd_happy" = "yes"], [
+    AS_IF([test ! -z "$with_zstd" -a "$with_zstd" != "yes"],
+      [ZSTD_CPPFLAGS="-I$with_zstd/include"
+       CPPFLAGS="$ZSTD_CPPFLAGS $AM_CPPFLAGS $CPPFLAGS"
+       CXXFLAGS="$AM_CXXFLAGS $CXXFLAGS"
+       ZSTD_LDFLAGS="-L$with_zstd/lib"
+       LDFLAGS="$ZSTD_LDFLAGS $AM_LDFLAGS $LDFLAGS"],
+      [ZSTD_CPPFLAGS=
+       ZSTD_LDFLAGS=
+       ZSTD_LIB=])
+
+    AC_LANG_PUSH([C++])
+    AC_CHECK_HEADER([zstd.h], [], [sst_check_zstd_happy="no"])
+    AC_LANG_POP([C++])
+
+    AC_CHECK_LIB([zstd], [ZSTD_decompress],
+      [ZSTD_LIB="-lzstd"], [sst_check_zstd_happy="no"])])
+
+  CXXFLAGS="$CXXFLAGS_saved"
+  CPPFLAGS="$CPPFLAGS_saved"
+  LDFLAGS="$LDFLAGS_saved"
+  LIBS="$LIBS_saved"
+
+  AC_SUBST([ZSTD_CPPFLAGS])
+  AC_SUBST([ZSTD_LDFLAGS])
+  AC_SUBST([ZSTD_LIB])
+  AS_IF([test "x$sst_check_zstd_happy" = "xyes"], [AC_DEFINE([HAVE_LIBZSTD],[1],[Defines whether we have the zstd library])])
+  AM_CONDITIONAL([USE_LIBZSTD], [test "x$sst_check_zstd_happy" = "xyes"])
+
+  AC_MSG_CHECKING([for zstd compression library])
+  AC_MSG_RESULT([$sst_check_zstd_happy])
+  AS_IF([test "$sst_check_zstd_happy" = "no" -a ! -z "$with_zstd" -a "$with_zstd" != "no"], [$3])
+  AS_IF([test "$sst_check_zstd_happy" = "yes"], [$1], [$2])
+])
@@ -0,0 +1,234 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef SST_ARIEL_L1FILTER_H
+#define SST_ARIEL_L1FILTER_H
+
+/*
+ * Compiled into the Pin tool, so this must stay PinCRT compatible
+ * (no C++11, no RTTI).
+ */
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <vector>
+
+namespace SST {
+namespace ArielComponent {
+
+/**
+ * Functional tag model of a private set-associative, write-back,
+ * write-allocate L1 with LRU replacement, in the style of memHierarchy's
+ * CacheArray. The Pin tool keeps one per thread and only forwards the
+ * accesses it misses on, so it holds tags and state but no data and has no
+ * notion of coherence.
+ */
+class ArielL1Filter {
+public:
+    ArielL1Filter() : sets(0), ways(0), lineSize(0), lruClock(0), accesses(0), misses(0), writebacks(0), dirtied(false) { }
+
+    /** Size in bytes, 0 leaves the filter disabled */
+    void configure(uint64_t size, uint32_t assoc, uint32_t lineBytes) {
+        lineSize = lineBytes;
+        ways = assoc;
+        sets = (lineBytes > 0 && assoc > 0) ? (uint32_t) (size / ((uint64_t) lineBytes * assoc)) : 0;
+
+        Line empty;
+        empty.addr = 0;
+        empty.lastUse = 0;
+        empty.valid = false;
+        empty.dirty = false;
+        lines.assign((size_t) sets * ways, empty);
+    }
+
+    bool enabled() const { return sets > 0; }
+    uint32_t getLineSize() const { return lineSize; }
+
+    /**
+     * Look up every line the access touches, filling those that miss.
+     * Returns true if all of them hit. The address of each dirty line that
+     * had to be evicted is appended to evicted.
+     */
+    bool access(uint64_t addr, uint32_t size, bool write, std::vector<uint64_t>& evicted) {
+        const uint64_t first = addr / lineSize;
+        const uint64_t last = (addr + (size > 0 ? size - 1 : 0)) / lineSize;
+        bool hit = true;
+
+        dirtied = false;
+        for ( uint64_t line = first; line <= last; line++ ) {
+            hit &= accessLine(line, write, evicted);
+        }
+
+        accesses++;
+        if ( ! hit ) {
+            misses++;
+        }
+        return hit;
+    }
+
+    uint64_t getAccesses() const { return accesses; }
+    uint64_t getMisses() const { return misses; }
+    uint64_t getWritebacks() const { return writebacks; }
+
+    /** True if the last access wrote to a line that was clean */
+    bool dirtiedLine() const { return dirtied; }
+
+private:
+    struct Line {
+        uint64_t addr;
+        uint64_t lastUse;
+        bool valid;
+        bool dirty;
+    };
+
+    bool accessLine(uint64_t line, bool write, std::vector<uint64_t>& evicted) {
+        Line* set = &lines[(size_t) (line % sets) * ways];
+        Line* victim = &set[0];
+
+        lruClock++;
+
+        for ( uint32_t i = 0; i < ways; i++ ) {
+            if ( set[i].valid && set[i].addr == line ) {
+                set[i].lastUse = lruClock;
+                if ( write && ! set[i].dirty ) {
+                    set[i].dirty = true;
+                    dirtied = true;
+                }
+                return true;
+            }
+
+            if ( ! set[i].valid ) {
+                if ( victim->valid ) {
+                    victim = &set[i];
+                }
+            } else if ( victim->valid && set[i].lastUse < victim->lastUse ) {
+                victim = &set[i];
+            }
+        }
+
+        if ( victim->valid && victim->dirty ) {
+            evicted.push_back(victim->addr * lineSize);
+            writebacks++;
+        }
+
+        victim->addr = line;
+        victim->lastUse = lruClock;
+        victim->valid = true;
+        victim->dirty = write;
+        return false;
+    }
+
+    std::vector<Line> lines;
+    uint32_t sets;
+    uint32_t ways;
+    uint32_t lineSize;
+    uint64_t lruClock;
+    uint64_t accesses;
+    uint64_t misses;
+    uint64_t writebacks;
+    bool dirtied;
+};
+
+/**
+ * Per-thread forwarding on top of the tag model. An instruction is only
+ * forwarded, with its markers, if one of its accesses misses or is the
+ * first write to a clean line, and then carries just those accesses. The
+ * simulated L1 so holds the same dirty lines and writes them back itself,
+ * rather than taking the filter's evictions as writes that would miss and
+ * allocate the line again. Accesses that hit are
+ * counted and sent as a summary between instructions. The Sink provides
+ * startInstruction(), read(addr, size), write(addr, size), endInstruction()
+ * and hits(count).
+ */
+class ArielL1FilterThread {
+public:
+    ArielL1FilterThread() : pendingHits(0), summaryInterval(1), forwarding(false) { }
+
+    void configure(uint64_t size, uint32_t assoc, uint32_t lineBytes, uint32_t summary) {
+        l1.configure(size, assoc, lineBytes);
+        summaryInterval = summary > 0 ? summary : 1;
+    }
+
+    bool enabled() const { return l1.enabled(); }
+    const ArielL1Filter& getL1() const { return l1; }
+
+    /** One access of the current instruction, last is set on its final access */
+    template <typename Sink>
+    void access(Sink& sink, uint64_t addr, uint32_t size, bool write, bool last) {
+        evicted.clear();
+
+        if ( l1.access(addr, size, write, evicted) && ! l1.dirtiedLine() ) {
+            pendingHits++;
+        } else {
+            if ( ! forwarding ) {
+                sendHits(sink);
+                sink.startInstruction();
+                forwarding = true;
+            }
+
+            if ( write ) {
+                sink.write(addr, size);
+            } else {
+                sink.read(addr, size);
+            }
+        }
+
+        if ( last ) {
+            if ( forwarding ) {
+                sink.endInstruction();
+                forwarding = false;
+            }
+
+            if ( pendingHits >= summaryInterval ) {
+                sendHits(sink);
+            }
+        }
+    }
+
+    /**
+     * Hand over the hits held back, as at a syscall or thread exit. Returns
+     * 0 inside a forwarded instruction, a summary must not land in it.
+     */
+    uint64_t takeHits() {
+        if ( forwarding ) {
+            return 0;
+        }
+
+        const uint64_t hits = pendingHits;
+        pendingHits = 0;
+        return hits;
+    }
+
+private:
+    template <typename Sink>
+    void sendHits(Sink& sink) {
+        const uint64_t hits = takeHits();
+        if ( hits > 0 ) {
+            sink.hits(hits);
+        }
+    }
+
+    ArielL1Filter l1;
+    std::vector<uint64_t> evicted;
+    uint64_t pendingHits;
+    uint32_t summaryInterval;
+    bool forwarding;    // the current instruction missed and its markers have been sent
+};
+
+}
+}
+
+#endif
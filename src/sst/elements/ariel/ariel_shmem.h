@@ -66,8 +66,44 @@ enum ArielShmemCmd_t {
     ARIEL_ISSUE_RTL = 150,
     ARIEL_FLUSHLINE_INSTRUCTION = 154,
     ARIEL_FENCE_INSTRUCTION = 155,
+    ARIEL_BATCH = 160,
+    ARIEL_FILTERED_HITS = 161,
+    ARIEL_BATCH_DATA = 162,
 };
 
+/*
+ * Batched commands. The per-instruction commands are packed as variable
+ * length records into a batch of up to ARIEL_BATCH_BUFFER_SIZE bytes. The
+ * batch goes through the tunnel as an ARIEL_BATCH command holding its record
+ * count, total length and first bytes, followed by as many ARIEL_BATCH_DATA
+ * commands as the rest of its bytes need, so the slot size stays that of a
+ * classic command. Every record starts with a tag byte
+ *   bits 0-2  record type (ArielBatchRecord_t)
+ *   bit  3    an instruction pointer delta follows
+ *   bits 4-7  access size, n > 0 is (1 << (n-1)) bytes, 0 means a varint size follows
+ * followed, when present, by the zigzag varint instruction pointer delta,
+ * the zigzag varint address delta, the varint size and the write payload.
+ * Deltas are taken against the previous record of the same core and carry
+ * over from one batch to the next. A filtered hit summary carries only its
+ * hit count, in the size field, and never an instruction pointer.
+ */
+enum ArielBatchRecord_t {
+    ARIEL_BATCH_START_INSTRUCTION = 0,
+    ARIEL_BATCH_END_INSTRUCTION = 1,
+    ARIEL_BATCH_READ = 2,
+    ARIEL_BATCH_WRITE = 3,
+    ARIEL_BATCH_WRITE_PAYLOAD = 4,
+    ARIEL_BATCH_NOOP = 5,
+    ARIEL_BATCH_FILTERED_HITS = 6,
+};
+
+/* Batch bytes per tunnel slot, sized so a slot is no larger than the inst member of ArielCommand */
+#define ARIEL_BATCH_DATA_SIZE (ARIEL_MAX_PAYLOAD_SIZE + 20)
+
+/* Slots and bytes of a whole batch, a batch holds at most one record per byte */
+#define ARIEL_BATCH_MAX_SLOTS 16
+#define ARIEL_BATCH_BUFFER_SIZE (ARIEL_BATCH_MAX_SLOTS * ARIEL_BATCH_DATA_SIZE)
+
 #ifdef HAVE_CUDA
 struct CudaArguments {
     union {
@@ -139,6 +175,11 @@ struct ArielCommand {
             uint32_t simdElemCount;
             uint8_t  payload[ARIEL_MAX_PAYLOAD_SIZE];
         } inst;
+        struct {
+            uint16_t count;
+            uint16_t length;
+            uint8_t  data[ARIEL_BATCH_DATA_SIZE];
+        } batch;
         struct {
             uint64_t vaddr;
             uint64_t alloc_len;
@@ -173,6 +214,9 @@ struct ArielCommand {
         struct {
             uint64_t vaddr;
         } flushline;
+        struct {
+            uint64_t hits;
+        } filtered;
         struct {
             void* inp_ptr;
             void* ctrl_ptr;
@@ -191,6 +235,273 @@ struct ArielCommand {
     };
 };
 
+class ArielBatchEncoder {
+public:
+    ArielBatchEncoder() : lastInstPtr(0), lastAddr(0), count(0), length(0), sent(0) { }
+
+    /**
+     * Append a record to the pending batch. Returns false if it does not fit,
+     * the caller then sends the batch and retries, and if it still does not
+     * fit (a large write payload) falls back to a classic command.
+     */
+    bool encode(ArielBatchRecord_t type, uint64_t instPtr, uint64_t addr, uint32_t size, const uint8_t* payload) {
+        uint8_t record[1 + 10 + 10 + 5 + ARIEL_MAX_PAYLOAD_SIZE];
+        uint32_t len = 1;
+        uint8_t tag = (uint8_t) type;
+
+        if ( ARIEL_BATCH_FILTERED_HITS == type ) {
+            instPtr = lastInstPtr;
+        }
+
+        if ( instPtr != lastInstPtr ) {
+            tag |= 0x8;
+            len += putVarint(&record[len], zigzag(instPtr - lastInstPtr));
+        }
+
+        if ( isAccess(type) || ARIEL_BATCH_FILTERED_HITS == type ) {
+            if ( ARIEL_BATCH_FILTERED_HITS != type ) {
+                len += putVarint(&record[len], zigzag(addr - lastAddr));
+            }
+
+            const uint32_t code = sizeCode(size);
+            if ( code > 0 ) {
+                tag |= (uint8_t) (code << 4);
+            } else {
+                len += putVarint(&record[len], size);
+            }
+
+            if ( ARIEL_BATCH_WRITE_PAYLOAD == type ) {
+                const uint32_t payloadLen = size < ARIEL_MAX_PAYLOAD_SIZE ? size : ARIEL_MAX_PAYLOAD_SIZE;
+                for ( uint32_t i = 0; i < payloadLen; i++ ) {
+                    record[len++] = payload[i];
+                }
+            }
+        }
+
+        if ( 0 != sent || length + len > ARIEL_BATCH_BUFFER_SIZE ) {
+            return false;
+        }
+
+        record[0] = tag;
+        for ( uint32_t i = 0; i < len; i++ ) {
+            data[length++] = record[i];
+        }
+        count++;
+
+        lastInstPtr = instPtr;
+        if ( isAccess(type) ) {
+            lastAddr = addr;
+        }
+        return true;
+    }
+
+    static bool isAccess(ArielBatchRecord_t type) {
+        return ARIEL_BATCH_READ == type || ARIEL_BATCH_WRITE == type || ARIEL_BATCH_WRITE_PAYLOAD == type;
+    }
+
+    bool empty() const { return 0 == count; }
+
+    /** Tunnel slots the pending batch takes */
+    uint32_t slots() const { return (length + ARIEL_BATCH_DATA_SIZE - 1) / ARIEL_BATCH_DATA_SIZE; }
+
+    /**
+     * Move the next slot of the pending batch into a command ready for the
+     * tunnel, the ARIEL_BATCH header first and then the ARIEL_BATCH_DATA
+     * slots. The batch is empty again once its last slot has been filled.
+     */
+    void fill(ArielCommand& ac) {
+        const uint32_t chunk = length - sent < ARIEL_BATCH_DATA_SIZE ? length - sent : ARIEL_BATCH_DATA_SIZE;
+
+        ac.instPtr = lastInstPtr;
+        if ( 0 == sent ) {
+            ac.command = ARIEL_BATCH;
+            ac.batch.count = count;
+            ac.batch.length = length;
+        } else {
+            ac.command = ARIEL_BATCH_DATA;
+            ac.batch.count = 0;
+            ac.batch.length = (uint16_t) chunk;
+        }
+        for ( uint32_t i = 0; i < chunk; i++ ) {
+            ac.batch.data[i] = data[sent + i];
+        }
+
+        sent += chunk;
+        if ( sent == length ) {
+            count = 0;
+            length = 0;
+            sent = 0;
+        }
+    }
+
+    static uint64_t zigzag(uint64_t delta) {
+        return (delta << 1) ^ (uint64_t) (((int64_t) delta) >> 63);
+    }
+
+    static uint32_t putVarint(uint8_t* out, uint64_t value) {
+        uint32_t len = 0;
+        while ( value >= 0x80 ) {
+            out[len++] = (uint8_t) (value | 0x80);
+            value >>= 7;
+        }
+        out[len++] = (uint8_t) value;
+        return len;
+    }
+
+private:
+    static uint32_t sizeCode(uint32_t size) {
+        for ( uint32_t code = 1; code < 16; code++ ) {
+            if ( size == (1u << (code - 1)) ) {
+                return code;
+            }
+        }
+        return 0;
+    }
+
+    uint64_t lastInstPtr;
+    uint64_t lastAddr;
+    uint16_t count;
+    uint16_t length;
+    uint16_t sent;
+    uint8_t  data[ARIEL_BATCH_BUFFER_SIZE];
+};
+
+class ArielBatchDecoder {
+public:
+    ArielBatchDecoder() : lastInstPtr(0), lastAddr(0), length(0), received(0), offset(0), remaining(0) { }
+
+    /** Start a batch from its ARIEL_BATCH header, returns false if the length is out of range */
+    bool begin(const ArielCommand& ac) {
+        length = ac.batch.length;
+        received = 0;
+        offset = 0;
+        remaining = ac.batch.count;
+
+        if ( length > ARIEL_BATCH_BUFFER_SIZE ) {
+            length = 0;
+            remaining = 0;
+            return false;
+        }
+        return append(ac.batch.data, length < ARIEL_BATCH_DATA_SIZE ? length : ARIEL_BATCH_DATA_SIZE);
+    }
+
+    /** True while ARIEL_BATCH_DATA slots of the current batch are still to come */
+    bool needsData() const { return received < length; }
+
+    /** Add the bytes of the next ARIEL_BATCH_DATA slot, returns false if they overrun the batch */
+    bool append(const ArielCommand& ac) {
+        if ( ARIEL_BATCH_DATA != ac.command || ac.batch.length > ARIEL_BATCH_DATA_SIZE ) {
+            return false;
+        }
+        return append(ac.batch.data, ac.batch.length);
+    }
+
+    /**
+     * Decode the next record of the current batch. Returns false when the
+     * batch is exhausted or the record runs past the end of the batch.
+     */
+    bool next(ArielBatchRecord_t& type, uint64_t& instPtr, uint64_t& addr, uint32_t& size, const uint8_t*& payload) {
+        if ( 0 == remaining || offset >= received ) {
+            return false;
+        }
+
+        const uint8_t tag = data[offset++];
+        type = (ArielBatchRecord_t) (tag & 0x7);
+
+        if ( tag & 0x8 ) {
+            uint64_t delta;
+            if ( ! getVarint(delta) ) {
+                return false;
+            }
+            lastInstPtr += unzigzag(delta);
+        }
+        instPtr = lastInstPtr;
+        addr = 0;
+        size = 0;
+        payload = NULL;
+
+        if ( ArielBatchEncoder::isAccess(type) || ARIEL_BATCH_FILTERED_HITS == type ) {
+            if ( ARIEL_BATCH_FILTERED_HITS != type ) {
+                uint64_t delta;
+                if ( ! getVarint(delta) ) {
+                    return false;
+                }
+                lastAddr += unzigzag(delta);
+                addr = lastAddr;
+            }
+
+            const uint32_t code = tag >> 4;
+            if ( code > 0 ) {
+                size = 1u << (code - 1);
+            } else {
+                uint64_t value;
+                if ( ! getVarint(value) ) {
+                    return false;
+                }
+                size = (uint32_t) value;
+            }
+
+            if ( ARIEL_BATCH_WRITE == type || ARIEL_BATCH_WRITE_PAYLOAD == type ) {
+                // writes without a traced payload carry zeros, as the classic commands do
+                payloadBuffer.assign(size > ARIEL_MAX_PAYLOAD_SIZE ? size : ARIEL_MAX_PAYLOAD_SIZE, 0);
+
+                if ( ARIEL_BATCH_WRITE_PAYLOAD == type ) {
+                    const uint32_t payloadLen = size < ARIEL_MAX_PAYLOAD_SIZE ? size : ARIEL_MAX_PAYLOAD_SIZE;
+                    if ( offset + payloadLen > received ) {
+                        return false;
+                    }
+                    for ( uint32_t i = 0; i < payloadLen; i++ ) {
+                        payloadBuffer[i] = data[offset++];
+                    }
+                }
+                payload = &payloadBuffer[0];
+            }
+        }
+
+        remaining--;
+        return true;
+    }
+
+    /** True once every record of the current batch has been decoded */
+    bool complete() const { return 0 == remaining && offset == length && received == length; }
+
+private:
+    bool append(const uint8_t* bytes, uint32_t len) {
+        if ( received + len > length ) {
+            return false;
+        }
+        for ( uint32_t i = 0; i < len; i++ ) {
+            data[received++] = bytes[i];
+        }
+        return true;
+    }
+
+    static uint64_t unzigzag(uint64_t value) {
+        return (value >> 1) ^ (0 - (value & 1));
+    }
+
+    bool getVarint(uint64_t& value) {
+        value = 0;
+        for ( uint32_t shift = 0; shift < 64 && offset < received; shift += 7 ) {
+            const uint8_t next = data[offset++];
+            value |= ((uint64_t) (next & 0x7F)) << shift;
+            if ( 0 == (next & 0x80) ) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint64_t lastInstPtr;
+    uint64_t lastAddr;
+    uint32_t length;
+    uint32_t received;
+    uint32_t offset;
+    uint32_t remaining;
+    uint8_t  data[ARIEL_BATCH_BUFFER_SIZE];
+    std::vector<uint8_t> payloadBuffer;
+};
+
 struct ArielSharedData {
     size_t numCores;
     uint64_t simTime;
@@ -15,7 +15,9 @@
 
 #include <sst_config.h>
 #include "arielcore.h"
+#include "arielfrontend.h"
 #include "tb_header.h"
+#include <algorithm>
 #include <iostream>
 #include <exception>
 #include <stdexcept>
@@ -38,7 +40,7 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
             Output* out, uint32_t maxIssuePerCyc,
             uint32_t maxQLen, uint64_t cacheLineSz,
             ArielMemoryManager* memMgr, const uint32_t perform_address_checks, Params& params) :
-            ComponentExtension(id), output(out), tunnel(tunnel),
+            ComponentExtension(id), output(out), tunnel(tunnel), frontend(NULL), physicalCommands(false), partitionTranslations(NULL),
 #ifdef HAVE_CUDA
             tunnelR(tunnelR), tunnelD(tunnelD),
 #endif
@@ -56,11 +58,19 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
     maxIssuePerCycle = maxIssuePerCyc;
     maxQLength = maxQLen;
     cacheLineSize = cacheLineSz;
-    memmgr = memMgr;
+    memmgr = NULL;
+    sharedLock = NULL;
+    softTLB.configure(params.find<uint32_t>("translation_tlb_entries", 0));
+    softTLBEpoch = 0;
+    migrationOffset = 0;
 
     writePayloads = params.find<int>("writepayloadtrace") == 0 ? false : true;
-    coreQ = new std::queue<ArielEvent*>();
-    pendingTransactions = new std::unordered_map<StandardMem::Request::id_t, StandardMem::Request*>();
+    filteredHitLatency = params.find<uint64_t>("l1filter_hit_latency", 4);
+    filteredHits = 0;
+    filteredSlots = 0;
+    // a command batch may take the queue past maxQLength by up to one record per byte
+    coreQ = new ArielEventRing(maxQLen + ARIEL_BATCH_BUFFER_SIZE, writePayloads);
+    pendingTransactions = new ArielPendingTable<StandardMem::Request::id_t>(maxPendTrans + 1);
     pending_transaction_count = 0;
 
 #ifdef HAVE_CUDA
@@ -88,6 +98,9 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
     statFlushRequests = registerStatistic<uint64_t>( "flush_requests", subID);
     statFenceRequests = registerStatistic<uint64_t>( "fence_requests", subID);
     statNoopCount     = registerStatistic<uint64_t>( "no_ops", subID );
+    statFilteredHits  = registerStatistic<uint64_t>( "l1filter_hits", subID );
+    statSoftTLBHits   = registerStatistic<uint64_t>( "translation_tlb_hits", subID );
+    statMigratedLines = registerStatistic<uint64_t>( "page_migration_lines", subID );
     statInstructionCount = registerStatistic<uint64_t>( "instruction_count", subID );
     statCycles = registerStatistic<uint64_t>( "cycles", subID );
     statActiveCycles = registerStatistic<uint64_t>( "active_cycles", subID );
@@ -106,7 +119,11 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
 
     free(subID);
 
-    memmgr->registerInterruptHandler(coreID, new ArielMemoryManager::InterruptHandler<ArielCore>(this, &ArielCore::handleInterrupt));
+    // A partitioned core is given its memory manager once the owning ArielCPU is known
+    if(NULL != memMgr) {
+        setMemoryManager(memMgr);
+    }
+
     stdMemHandlers = new StdMemHandler(this, output);
 
     std::string traceGenName = params.find<std::string>("tracegen", "");
@@ -138,6 +155,151 @@ ArielCore::~ArielCore() {
     }
 
     delete stdMemHandlers;
+    delete coreQ;
+    delete pendingTransactions;
+}
+
+void ArielCore::setMemoryManager(ArielMemoryManager* newMemmgr) {
+    ArielSharedGuard guard(sharedLock);
+
+    memmgr = newMemmgr;
+    memmgr->registerInterruptHandler(coreID, new ArielMemoryManager::InterruptHandler<ArielCore>(this, &ArielCore::handleInterrupt));
+}
+
+void ArielCore::setFrontend(ArielFrontend* fe) {
+    frontend = fe;
+    physicalCommands = (NULL != fe) && fe->physicalAddresses();
+}
+
+uint64_t ArielCore::translateAddress(uint64_t virtAddr) {
+    uint64_t physAddr;
+
+    if(physicalCommands) {
+        return virtAddr;
+    }
+
+    // translationReady has made sure the owner answered for this page
+    if(NULL != partitionTranslations) {
+        if(!partitionTranslations->lookup(virtAddr, physAddr)) {
+            output->fatal(CALL_INFO, -1, "Core %" PRIu32 " has no translation for virtual address %" PRIu64 "\n", coreID, virtAddr);
+        }
+
+        return physAddr;
+    }
+
+    if(softTLB.enabled()) {
+        const uint64_t epoch = memmgr->getTranslationEpoch();
+
+        if(epoch != softTLBEpoch) {
+            softTLB.flush();
+            softTLBEpoch = epoch;
+        }
+
+        if(softTLB.lookup(virtAddr, physAddr)) {
+            statSoftTLBHits->addData(1);
+            return physAddr;
+        }
+    }
+
+    ArielSharedGuard guard(sharedLock);
+    uint64_t pageBytes;
+    physAddr = memmgr->translatePage(virtAddr, pageBytes);
+
+    // A promotion this translation caused is copied by this core
+    if(memmgr->hasMigrations()) {
+        takeMigrations();
+    }
+
+    if(softTLB.enabled()) {
+        softTLB.insert(virtAddr, physAddr, pageBytes);
+    }
+
+    return physAddr;
+}
+
+bool ArielCore::translationReady(uint64_t virtAddr, uint64_t length) {
+    if(physicalCommands || NULL == partitionTranslations) {
+        return true;
+    }
+
+    // Accesses are trimmed to a line, so they touch at most two pages
+    const uint64_t lastAddr = virtAddr + std::min(std::max(length, (uint64_t) 1), cacheLineSize) - 1;
+    uint64_t physAddr;
+    bool ready = true;
+
+    if(!partitionTranslations->lookup(virtAddr, physAddr)) {
+        partitionTranslations->request(coreID, virtAddr);
+        ready = false;
+    }
+
+    if(!partitionTranslations->lookup(lastAddr, physAddr)) {
+        partitionTranslations->request(coreID, lastAddr);
+        ready = false;
+    }
+
+    return ready;
+}
+
+void ArielCore::collectMigrations() {
+    ArielSharedGuard guard(sharedLock);
+    takeMigrations();
+}
+
+// The caller holds the shared lock
+void ArielCore::takeMigrations() {
+    std::vector<ArielPageMigration> moved;
+    memmgr->takeMigrations(moved);
+    migrations.insert(migrations.end(), moved.begin(), moved.end());
+}
+
+// Reads one line of the oldest migration, the write and flush follow the response
+void ArielCore::issueMigrationRead() {
+    const ArielPageMigration& migration = migrations.front();
+
+    MigrationLine line;
+    line.frame = migration.from;
+    line.from = migration.from + migrationOffset;
+    line.to = migration.to + migrationOffset;
+
+    if(0 == migrationOffset) {
+        migrationLinesLeft[migration.from] = (migration.bytes + cacheLineSize - 1) / cacheLineSize;
+    }
+
+    StandardMem::Read* req = new StandardMem::Read(line.from, cacheLineSize);
+    migrationReads[req->getID()] = line;
+    pending_transaction_count++;
+    pendingTransactions->insert(req->getID());
+    cacheLink->send(req);
+    statMigratedLines->addData(1);
+
+    migrationOffset += cacheLineSize;
+    if(migrationOffset >= migration.bytes) {
+        migrations.pop_front();
+        migrationOffset = 0;
+    }
+}
+
+// Write the line to the new frame and flush the old copy out of the caches, the
+// old frame goes back to the memory manager once all of its lines are done
+void ArielCore::finishMigrationRead(StandardMem::Request* event, const MigrationLine& line) {
+    StandardMem::ReadResp* resp = static_cast<StandardMem::ReadResp*>(event);
+
+    StandardMem::Write* write = new StandardMem::Write(line.to, resp->size, resp->data);
+    StandardMem::Request* flush = new StandardMem::FlushAddr(line.from, cacheLineSize, true, std::numeric_limits<uint32_t>::max());
+
+    pending_transaction_count += 2;
+    pendingTransactions->insert(write->getID());
+    pendingTransactions->insert(flush->getID());
+    cacheLink->send(write);
+    cacheLink->send(flush);
+
+    std::unordered_map<uint64_t, uint64_t>::iterator left = migrationLinesLeft.find(line.frame);
+    if(0 == --left->second) {
+        migrationLinesLeft.erase(left);
+
+        ArielSharedGuard guard(sharedLock);
+        memmgr->releaseFrame(line.frame);
+    }
 }
 
 void ArielCore::setCacheLink(StandardMem* newLink) {
@@ -156,15 +318,19 @@ void ArielCore::setRtlLink(Link* rtllink) {
     RtlLink = rtllink;
 }
 
-void ArielCore::printTraceEntry(const bool isRead,
-            const uint64_t address, const uint32_t length) {
+void ArielCore::printTraceEntry(const ArielTraceEntryOperation op, const uint64_t virtAddr,
+            const uint64_t physAddr, const uint64_t length, const uint32_t level, const uint64_t mallocID) {
 
     if(enableTracing) {
-        if(isRead) {
-                traceGen->publishEntry(currentCycles, address, length, READ);
-        } else {
-                traceGen->publishEntry(currentCycles, address, length, WRITE);
-        }
+        ArielTraceEvent ev;
+        ev.op = op;
+        ev.virtAddr = virtAddr;
+        ev.physAddr = physAddr;
+        ev.length = length;
+        ev.level = level;
+        ev.mallocID = mallocID;
+
+        traceGen->publishEvent(currentCycles, ev);
     }
 }
 
@@ -179,12 +345,12 @@ void ArielCore::commitReadEvent(const uint64_t address,
         }else {
 #endif
             pending_transaction_count++;
-            pendingTransactions->insert( std::pair<StandardMem::Request::id_t, StandardMem::Request*>(req->getID(), req) );
+            pendingTransactions->insert(req->getID());
 #ifdef HAVE_CUDA
         }
 #endif
         if(enableTracing) {
-            printTraceEntry(true, (const uint64_t) req->pAddr, (const uint32_t) length);
+            printTraceEntry(READ, virtAddress, (const uint64_t) req->pAddr, length);
         }
 
         // Actually send the event to the cache
@@ -227,12 +393,12 @@ void ArielCore::commitWriteEvent(const uint64_t address,
         } else{
 #endif
             pending_transaction_count++;
-            pendingTransactions->insert( std::pair<StandardMem::Request::id_t, StandardMem::Request*>(req->getID(), req) );
+            pendingTransactions->insert(req->getID());
 #ifdef HAVE_CUDA
         }
 #endif
         if(enableTracing) {
-            printTraceEntry(false, (const uint64_t) req->pAddr, (const uint32_t) length);
+            printTraceEntry(WRITE, virtAddress, (const uint64_t) req->pAddr, length);
         }
 
         // Actually send the event to the cache
@@ -251,7 +417,7 @@ void ArielCore::commitFlushEvent(const uint64_t address,
         /*  Todo: should the request specify the physical address, or the virtual address? */
         StandardMem::Request *req = new StandardMem::FlushAddr( address, length, true, std::numeric_limits<uint32_t>::max());
         pending_transaction_count++;
-        pendingTransactions->insert( std::pair<StandardMem::Request::id_t, StandardMem::Request*>(req->getID(), req) );
+        pendingTransactions->insert(req->getID());
 
         cacheLink->send(req);
         statFlushRequests->addData(1);
@@ -261,7 +427,15 @@ void ArielCore::commitFlushEvent(const uint64_t address,
 void ArielCore::handleEvent(StandardMem::Request* event) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " handling a memory event.\n", coreID));
     StandardMem::Request::id_t mev_id = event->getID();
-    auto find_entry = pendingTransactions->find(mev_id);
+
+    if(!migrationReads.empty()) {
+        std::unordered_map<StandardMem::Request::id_t, MigrationLine>::iterator line = migrationReads.find(mev_id);
+
+        if(line != migrationReads.end()) {
+            finishMigrationRead(event, line->second);
+            migrationReads.erase(line);
+        }
+    }
 
 #ifdef HAVE_CUDA
     if(pendingGpuTransactions->find(mev_id) != pendingGpuTransactions->end()){
@@ -363,9 +537,7 @@ void ArielCore::handleEvent(StandardMem::Request* event) {
                         output->verbose(CALL_INFO, 16, 0, "\n");
                     }
 
-                    ArielWriteEvent* awe;
-                    awe = new ArielWriteEvent(getCurrentAddress(), current_transfer, &getDataAddress()[index]);
-                    handleWriteRequest(awe);
+                    handleWriteRequest(getCurrentAddress(), current_transfer, &getDataAddress()[index]);
                     setCurrentAddress(getCurrentAddress() + current_transfer);
                     setRemainingPageTransfer(getRemainingPageTransfer() - current_transfer);
                 }
@@ -462,28 +634,27 @@ void ArielCore::handleEvent(StandardMem::Request* event) {
                 // Still data left to read
                 pendingGpuTransactions->erase(pendingGpuTransactions->find(mev_id));
                 pending_transaction_count--;
-                ArielReadEvent *are;
                 while((getOpenTransactions() > 0) && (getRemainingTransfer() > 0)){
+                    const uint64_t readAddress = getCurrentAddress();
+                    uint32_t readLength = 64;
                     if(getRemainingTransfer() <= 64) {
-                        are = new ArielReadEvent(getCurrentAddress(), getRemainingTransfer());
+                        readLength = getRemainingTransfer();
                         setRemainingTransfer(0);
                     }else {
-                        are = new ArielReadEvent(getCurrentAddress(), 64);
                         setRemainingTransfer(getRemainingTransfer()-64);
                         setCurrentAddress(getCurrentAddress() + 64);
                     }
-                    handleReadRequest(are);
+                    handleReadRequest(readAddress, readLength);
                 }
             }
         }
-    }else if(find_entry != pendingTransactions->end()) {
+    }else if(pendingTransactions->remove(mev_id)) {
 #else
-    if(find_entry != pendingTransactions->end()) {
+    if(pendingTransactions->remove(mev_id)) {
 #endif
-        ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Correctly identified event in pending transactions, removing from list, before there are: %" PRIu32 " transactions pending.\n",
+        ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Correctly identified event in pending transactions, removed from list, there are: %" PRIu32 " transactions pending.\n",
                             (uint32_t) pendingTransactions->size()));
 
-        pendingTransactions->erase(find_entry);
         pending_transaction_count--;
         if(isCoreFenced() && pending_transaction_count == 0)
             unfence();
@@ -522,7 +693,7 @@ void ArielCore::StdMemHandler::handle(StandardMem::WriteResp* resp) {
     if(core->getKind() == cudaMemcpyHostToDevice){
         last_phys_addr = resp->pAddr;
     } else if(core->getKind() == cudaMemcpyDeviceToHost){
-        // Only ArielReadEvents are sent during cudaMemcpyDeviceToHost
+        // Only reads are sent during cudaMemcpyDeviceToHost
         out->fatal(CALL_INFO, -1, "Error: Received WriteResp during cudaMemcpyDeviceToHost\n");
     }
 #endif
@@ -579,7 +750,7 @@ void ArielCore::setPhysicalAddresses(SST::Event *ev){
     uint64_t addr_offset;
     uint64_t current_transfer;
     current_transfer = (getRemainingTransfer() > 64) ? 64 : getRemainingTransfer();
-    phy_addr = memmgr->translateAddress(getCurrentAddress());
+    phy_addr = translateAddress(getCurrentAddress());
     addr_offset = phy_addr % ((uint64_t) cacheLineSize);
     if((addr_offset + current_transfer <= cacheLineSize)){
         physicalAddresses.push_back(phy_addr);
@@ -589,7 +760,7 @@ void ArielCore::setPhysicalAddresses(SST::Event *ev){
         uint64_t rightAddr = (getCurrentAddress() + ((uint64_t) cacheLineSize)) - addr_offset;
         uint64_t rightSize = current_transfer - leftSize;
         uint64_t physLeftAddr = phy_addr;
-        uint64_t physRightAddr = memmgr->translateAddress(rightAddr);
+        uint64_t physRightAddr = translateAddress(rightAddr);
         physicalAddresses.push_back(physLeftAddr);
     }
 }
@@ -658,79 +829,97 @@ void ArielCore::unfence()
 }
 
 
-void ArielCore::handleSwitchPoolEvent(ArielSwitchPoolEvent* aSPE) {
-    ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Core: %" PRIu32 " set default memory pool to: %" PRIu32 "\n", coreID, aSPE->getPool()));
-    memmgr->setDefaultPool(aSPE->getPool());
+void ArielCore::handleSwitchPoolEvent(uint32_t pool) {
+    ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Core: %" PRIu32 " set default memory pool to: %" PRIu32 "\n", coreID, pool));
+
+    if(NULL != partitionTranslations) {
+        ArielPartitionEvent* ev = new ArielPartitionEvent(ArielPartitionEvent::SWITCH_POOL, coreID);
+        ev->level = pool;
+        partitionTranslations->send(ev);
+        return;
+    }
+
+    ArielSharedGuard guard(sharedLock);
+    memmgr->setDefaultPool(pool);
 }
 
 void ArielCore::createSwitchPoolEvent(uint32_t newPool) {
-    ArielSwitchPoolEvent* ev = new ArielSwitchPoolEvent(newPool);
-    coreQ->push(ev);
+    coreQ->push(SWITCH_POOL).pool = newPool;
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a switch pool event on core %" PRIu32 ", new level is: %" PRIu32 "\n", coreID, newPool));
 }
 
 void ArielCore::createNoOpEvent() {
-    ArielNoOpEvent* ev = new ArielNoOpEvent();
-    coreQ->push(ev);
+    coreQ->push(NOOP);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a No Op event on core %" PRIu32 "\n", coreID));
 }
 
+void ArielCore::addFilteredHits(uint64_t hits) {
+    // Each hit takes an issue slot as a read or write would. The hits also
+    // hold a pending transaction slot for the hit latency, so when the latency
+    // cannot be covered by maxtranscore requests in flight that is the limit.
+    const uint64_t latencySlots = ((hits * filteredHitLatency * maxIssuePerCycle) + maxPendingTransactions - 1) / maxPendingTransactions;
+
+    filteredHits += hits;
+    filteredSlots += std::max(hits, latencySlots);
+
+    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Added %" PRIu64 " filtered hits, %" PRIu64 " issue slots owed\n", hits, filteredSlots));
+}
+
 void ArielCore::createReadEvent(uint64_t address, uint32_t length) {
-    ArielReadEvent* ev = new ArielReadEvent(address, length);
-    coreQ->push(ev);
+    ArielQueuedEvent& ev = coreQ->push(READ_ADDRESS);
+    ev.access.address = address;
+    ev.access.length = length;
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a READ event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
 }
 
 void ArielCore::createAllocateEvent(uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
-    ArielAllocateEvent* ev = new ArielAllocateEvent(vAddr, length, level, instPtr);
-    coreQ->push(ev);
+    coreQ->push(MALLOC).boxed = new ArielAllocateEvent(vAddr, length, level, instPtr);
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an allocate event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
                     vAddr, length, level, instPtr));
 }
 
 void ArielCore::createMmapEvent(uint32_t fileID, uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
-    ArielMmapEvent* ev = new ArielMmapEvent(fileID, vAddr, length, level, instPtr);
-    coreQ->push(ev);
+    coreQ->push(MMAP).boxed = new ArielMmapEvent(fileID, vAddr, length, level, instPtr);
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an mmap event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
                     vAddr, length, level, instPtr));
 }
 
 void ArielCore::createFreeEvent(uint64_t vAddr) {
-    ArielFreeEvent* ev = new ArielFreeEvent(vAddr);
-    coreQ->push(ev);
+    coreQ->push(FREE).access.address = vAddr;
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated a free event for virtual address=%" PRIu64 "\n", vAddr));
 }
 
 void ArielCore::createWriteEvent(uint64_t address, uint32_t length, const uint8_t* payload) {
-    ArielWriteEvent* ev = new ArielWriteEvent(address, length, payload);
-    coreQ->push(ev);
+    ArielQueuedEvent& ev = coreQ->push(WRITE_ADDRESS);
+    ev.access.address = address;
+    ev.access.length = length;
+    coreQ->setPayload(payload, length);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a WRITE event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
 }
 
 void ArielCore::createFlushEvent(uint64_t vAddr){
-    ArielFlushEvent *ev = new ArielFlushEvent(vAddr, cacheLineSize);
-    coreQ->push(ev);
+    ArielQueuedEvent& ev = coreQ->push(FLUSH);
+    ev.access.address = vAddr;
+    ev.access.length = (uint32_t) cacheLineSize;
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO,4,0, "Generated a FLUSH event.\n"));
 }
 
 void ArielCore::createFenceEvent(){
-    ArielFenceEvent *ev = new ArielFenceEvent();
-    coreQ->push(ev);
+    coreQ->push(FENCE);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a FENCE event.\n"));
 }
 
 void ArielCore::createExitEvent() {
-    ArielExitEvent* xEv = new ArielExitEvent();
-    coreQ->push(xEv);
+    coreQ->push(CORE_EXIT);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated an EXIT event.\n"));
 }
@@ -751,15 +940,14 @@ void ArielCore::createRtlEvent(void* inp_ptr, void* ctrl_ptr, void* updated_para
     Ev->set_rtl_inp_size(inp_size);
     Ev->set_rtl_ctrl_size(ctrl_size);
     Ev->set_updated_rtl_params_size(updated_rtl_params_size);
-    coreQ->push(Ev);
+    coreQ->push(RTL).boxed = Ev;
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a RTL event.\n"));
 }
 
 #ifdef HAVE_CUDA
 void ArielCore::createGpuEvent(GpuApi_t API, CudaArguments CA) {
-    ArielGpuEvent* gEv = new ArielGpuEvent(API, CA);
-    coreQ->push(gEv);
+    coreQ->push(GPU).boxed = new ArielGpuEvent(API, CA);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a CUDA event.\n"));
 }
@@ -842,7 +1030,16 @@ bool ArielCore::refillQueue() {
                             coreID, (uint32_t) coreQ->size(), (uint32_t) maxQLength));
 
         ArielCommand ac;
-        const bool avail = tunnel->readMessageNB(coreID, &ac);
+        bool avail = tunnel->readMessageNB(coreID, &ac);
+
+        // Only ask once everything queued has been processed, a frontend may take an empty buffer to mean the core is done
+        if ( !avail && frontend && coreQ->empty() ) {
+                ArielSharedGuard guard(sharedLock);
+
+                if ( frontend->refill(coreID, currentCycles) ) {
+                        avail = tunnel->readMessageNB(coreID, &ac);
+                }
+        }
 
         if ( !avail ) {
                 ARIEL_CORE_VERBOSE(32, output->verbose(CALL_INFO, 32, 0, "Tunnel claims no data on core: %" PRIu32 "\n", coreID));
@@ -914,6 +1111,14 @@ bool ArielCore::refillQueue() {
                 createNoOpEvent();
                 break;
 
+            case ARIEL_BATCH:
+                processBatch(ac);
+                break;
+
+            case ARIEL_FILTERED_HITS:
+                addFilteredHits(ac.filtered.hits);
+                break;
+
             case ARIEL_FLUSHLINE_INSTRUCTION:
                 createFlushEvent(ac.flushline.vaddr);
                 break;
@@ -962,17 +1167,80 @@ bool ArielCore::refillQueue() {
     return true;
 }
 
-void ArielCore::handleFreeEvent(ArielFreeEvent* rFE) {
-    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a free event (for virtual address=%" PRIu64 ")\n", coreID, rFE->getVirtualAddress()));
+void ArielCore::processBatch(const ArielCommand& ac) {
+    ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Core %" PRIu32 " decoding a batch of %" PRIu16 " records (%" PRIu16 " bytes)\n",
+                        coreID, ac.batch.count, ac.batch.length));
+
+    ArielBatchRecord_t type;
+    uint64_t instPtr;
+    uint64_t addr;
+    uint32_t size;
+    const uint8_t* payload;
 
-    memmgr->freeMalloc(rFE->getVirtualAddress());
+    // The rest of the batch follows in ARIEL_BATCH_DATA commands from the same writer
+    bool gathered = batchDecoder.begin(ac);
+    while(gathered && batchDecoder.needsData()) {
+        gathered = batchDecoder.append(tunnel->readMessage(coreID));
+    }
+
+    if(!gathered) {
+        output->fatal(CALL_INFO, -1, "Error: Ariel received a truncated or corrupt command batch on core %" PRIu32 ".\n", coreID);
+    }
+
+    // The queue may grow past maxQLength by up to one batch
+    while(batchDecoder.next(type, instPtr, addr, size, payload)) {
+        switch(type) {
+            case ARIEL_BATCH_START_INSTRUCTION:
+            case ARIEL_BATCH_END_INSTRUCTION:
+                break;
+
+            case ARIEL_BATCH_READ:
+                createReadEvent(addr, size);
+                break;
+
+            case ARIEL_BATCH_WRITE:
+            case ARIEL_BATCH_WRITE_PAYLOAD:
+                createWriteEvent(addr, size, payload);
+                break;
+
+            case ARIEL_BATCH_NOOP:
+                createNoOpEvent();
+                break;
+
+            case ARIEL_BATCH_FILTERED_HITS:
+                addFilteredHits(size);
+                break;
+
+            default:
+                output->fatal(CALL_INFO, -1, "Error: Ariel did not understand batch record (%d) on core %" PRIu32 ".\n", (int) type, coreID);
+                break;
+        }
+    }
+
+    if(!batchDecoder.complete()) {
+        output->fatal(CALL_INFO, -1, "Error: Ariel received a truncated or corrupt command batch on core %" PRIu32 ".\n", coreID);
+    }
+}
+
+void ArielCore::handleFreeEvent(uint64_t virtualAddress) {
+    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a free event (for virtual address=%" PRIu64 ")\n", coreID, virtualAddress));
+
+    if(NULL != partitionTranslations) {
+        partitionTranslations->send(new ArielPartitionEvent(ArielPartitionEvent::FREE, coreID, virtualAddress));
+    } else {
+        ArielSharedGuard guard(sharedLock);
+        memmgr->freeMalloc(virtualAddress);
+    }
+
+    if(enableTracing) {
+        printTraceEntry(TRACE_FREE, virtualAddress, 0, 0);
+    }
 }
 
-void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
+void ArielCore::handleReadRequest(uint64_t readAddress, uint32_t length) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a read event...\n", coreID));
 
-    const uint64_t readAddress = rEv->getAddress();
-    const uint64_t readLength  = std::min((uint64_t) rEv->getLength(), cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
+    const uint64_t readLength  = std::min((uint64_t) length, cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
 
     /* No longer neccessary due to trimming above
      * if(readLength > cacheLineSize) {
@@ -985,7 +1253,7 @@ void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
     // There is a chance that the non-alignment causes an undetected bug if an access spans multiple malloc regions that are contiguous in VA space but non-contiguous in PA space.
     // However, a single access spanning multiple malloc'd regions shouldn't happen...
     // Addresses mapped via first touch are always line/page aligned
-    const uint64_t physAddr = memmgr->translateAddress(readAddress);
+    const uint64_t physAddr = translateAddress(readAddress);
     const uint64_t addr_offset  = physAddr % ((uint64_t) cacheLineSize);
 
     if((addr_offset + readLength) <= cacheLineSize) {
@@ -1010,7 +1278,7 @@ void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
         const uint64_t rightSize = readLength - leftSize;
 
         const uint64_t physLeftAddr = physAddr;
-        const uint64_t physRightAddr = memmgr->translateAddress(rightAddr);
+        const uint64_t physRightAddr = translateAddress(rightAddr);
 
         ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " issuing split-address read, LeftVAddr=%" PRIu64 ", RightVAddr=%" PRIu64 ", LeftSize=%" PRIu64 ", RightSize=%" PRIu64 ", LeftPhysAddr=%" PRIu64 ", RightPhysAddr=%" PRIu64 "\n",
                             coreID, leftAddr, rightAddr, leftSize, rightSize, physLeftAddr, physRightAddr));
@@ -1042,11 +1310,10 @@ void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
     statReadRequestSizes->addData(readLength);
 }
 
-void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
+void ArielCore::handleWriteRequest(uint64_t writeAddress, uint32_t length, const uint8_t* payloadPtr) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a write event...\n", coreID));
 
-    const uint64_t writeAddress = wEv->getAddress();
-    const uint64_t writeLength  = std::min((uint64_t) wEv->getLength(), cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
+    const uint64_t writeLength  = std::min((uint64_t) length, cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
 
     // No longer neccessary due to trimming above
 /*    if(writeLength > cacheLineSize) {
@@ -1056,7 +1323,7 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
     }*/
 
     // See note in handleReadRequest() on alignment issues
-    const uint64_t physAddr = memmgr->translateAddress(writeAddress);
+    const uint64_t physAddr = translateAddress(writeAddress);
     const uint64_t addr_offset  = physAddr % ((uint64_t) cacheLineSize);
 
     // We do not need to perform a split operation
@@ -1076,7 +1343,6 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
                             coreID, writeAddress, writeLength, physAddr));
 
         if( writePayloads ) {
-            uint8_t* payloadPtr = wEv->getPayload();
             commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, payloadPtr);
         } else {
             commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, NULL);
@@ -1093,7 +1359,7 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
         const uint64_t rightSize = writeLength - leftSize;
 
         const uint64_t physLeftAddr = physAddr;
-        const uint64_t physRightAddr = memmgr->translateAddress(rightAddr);
+        const uint64_t physRightAddr = translateAddress(rightAddr);
 
         ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " issuing split-address write, LeftVAddr=%" PRIu64 ", RightVAddr=%" PRIu64 ", LeftSize=%" PRIu64 ", RightSize=%" PRIu64 ", LeftPhysAddr=%" PRIu64 ", RightPhysAddr=%" PRIu64 "\n",
                             coreID, leftAddr, rightAddr, leftSize, rightSize, physLeftAddr, physRightAddr));
@@ -1116,7 +1382,6 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
         }
 
         if( writePayloads ) {
-            uint8_t* payloadPtr = wEv->getPayload();
             commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, payloadPtr);
             commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, &payloadPtr[leftSize]);
         } else {
@@ -1133,6 +1398,17 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
 
 
 void ArielCore::handleMmapEvent(ArielMmapEvent* aEv) {
+    if(NULL != partitionTranslations) {
+        ArielPartitionEvent* ev = new ArielPartitionEvent(ArielPartitionEvent::MMAP, coreID, aEv->getVirtualAddress());
+        ev->bytes = aEv->getAllocationLength();
+        ev->level = aEv->getAllocationLevel();
+        ev->instPtr = aEv->getInstructionPointer();
+        ev->file = aEv->getFileID();
+        partitionTranslations->send(ev);
+        return;
+    }
+
+    ArielSharedGuard guard(sharedLock);
     memmgr->allocateMMAP(aEv->getAllocationLength(), aEv->getAllocationLevel(), aEv->getVirtualAddress(),
             aEv->getInstructionPointer(), aEv->getFileID(), coreID);
 }
@@ -1141,18 +1417,33 @@ void ArielCore::handleAllocationEvent(ArielAllocateEvent* aEv) {
     output->verbose(CALL_INFO, 2, 0, "Handling a memory allocation event, vAddr=%" PRIu64 ", length=%" PRIu64 ", at level=%" PRIu32 " with malloc ID=%" PRIu64 "\n",
                 aEv->getVirtualAddress(), aEv->getAllocationLength(), aEv->getAllocationLevel(), aEv->getInstructionPointer());
 
-    memmgr->allocateMalloc(aEv->getAllocationLength(), aEv->getAllocationLevel(), aEv->getVirtualAddress(), aEv->getInstructionPointer(), coreID);
-}
+    if(NULL != partitionTranslations) {
+        ArielPartitionEvent* ev = new ArielPartitionEvent(ArielPartitionEvent::MALLOC, coreID, aEv->getVirtualAddress());
+        ev->bytes = aEv->getAllocationLength();
+        ev->level = aEv->getAllocationLevel();
+        ev->instPtr = aEv->getInstructionPointer();
+        partitionTranslations->send(ev);
+    } else {
+        ArielSharedGuard guard(sharedLock);
+        memmgr->allocateMalloc(aEv->getAllocationLength(), aEv->getAllocationLevel(), aEv->getVirtualAddress(), aEv->getInstructionPointer(), coreID);
+    }
 
-void ArielCore::handleFlushEvent(ArielFlushEvent *flEv) {
-    const uint64_t virtualAddress = (uint64_t) flEv->getVirtualAddress();
-    const uint64_t readLength = (uint64_t) flEv->getLength();
+    if(enableTracing) {
+        printTraceEntry(TRACE_ALLOCATE, aEv->getVirtualAddress(), 0, aEv->getAllocationLength(),
+            aEv->getAllocationLevel(), aEv->getInstructionPointer());
+    }
+}
 
-    const uint64_t physAddr = memmgr->translateAddress(virtualAddress);
+void ArielCore::handleFlushEvent(uint64_t virtualAddress, uint64_t readLength) {
+    const uint64_t physAddr = translateAddress(virtualAddress);
     commitFlushEvent(physAddr, virtualAddress, (uint32_t) readLength);
+
+    if(enableTracing) {
+        printTraceEntry(TRACE_FLUSH, virtualAddress, physAddr, readLength);
+    }
 }
 
-void ArielCore::handleFenceEvent(ArielFenceEvent *fEv) {
+void ArielCore::handleFenceEvent() {
     /*  Todo: Should we treat this like the Flush event, and require that the Fence
     *  be put into a transaction queue?  */
     // Possibility A:
@@ -1160,13 +1451,20 @@ void ArielCore::handleFenceEvent(ArielFenceEvent *fEv) {
     // Possibility B:
     // commitFenceEvent();
     statFenceRequests->addData(1);
+
+    if(enableTracing) {
+        printTraceEntry(TRACE_FENCE, 0, 0, 0);
+    }
 }
 
 void ArielCore::handleRtlEvent(ArielRtlEvent* RtlEv) {
     
     RtlEv->set_cachelinesize(cacheLineSize);
-    memmgr->get_page_info(RtlEv->RtlData.pageTable, RtlEv->RtlData.freePages, RtlEv->RtlData.pageSize);
-    memmgr->get_tlb_info(RtlEv->RtlData.translationCache, RtlEv->RtlData.translationCacheEntries, RtlEv->RtlData.translationEnabled);
+    {
+        ArielSharedGuard guard(sharedLock);
+        memmgr->get_page_info(RtlEv->RtlData.pageTable, RtlEv->RtlData.freePages, RtlEv->RtlData.pageSize);
+        memmgr->get_tlb_info(RtlEv->RtlData.translationCache, RtlEv->RtlData.translationCacheEntries, RtlEv->RtlData.translationEnabled);
+    }
     RtlLink->send(RtlEv);
     return;
 }
@@ -1234,9 +1532,7 @@ void ArielCore::handleGpuEvent(ArielGpuEvent* gEv){
                                 output->verbose(CALL_INFO, 16, 0, "\n");
                             }
 
-                            ArielWriteEvent* awe;
-                            awe = new ArielWriteEvent(getCurrentAddress(), current_transfer, &getDataAddress()[index]);
-                            handleWriteRequest(awe);
+                            handleWriteRequest(getCurrentAddress(), current_transfer, &getDataAddress()[index]);
                             setCurrentAddress(getCurrentAddress() + current_transfer);
                             setRemainingPageTransfer(getRemainingPageTransfer() - current_transfer);
                         }
@@ -1337,17 +1633,17 @@ void ArielCore::handleGpuAckEvent(SST::Event* e){
     if (ev->getType() == BalarComponent::EventType::RESPONSE){
         if((ev->API == GPU_MEMCPY_RET)&&(ev->CA.cuda_memcpy.kind == cudaMemcpyDeviceToHost)){
             // Device to Host still needs us to get the data for fesimple
-            ArielReadEvent *are;
             while((getOpenTransactions() > 0) && (getRemainingTransfer() > 0)){
+                const uint64_t readAddress = getCurrentAddress();
+                uint32_t readLength = 64;
                 if(getRemainingTransfer() <= 64) {
-                    are = new ArielReadEvent(getCurrentAddress(), getRemainingTransfer());
+                    readLength = getRemainingTransfer();
                     setRemainingTransfer(0);
                 }else {
-                    are = new ArielReadEvent(getCurrentAddress(), 64);
                     setRemainingTransfer(getRemainingTransfer()-64);
                     setCurrentAddress(getCurrentAddress() + 64);
                 }
-                handleReadRequest(are);
+                handleReadRequest(readAddress, readLength);
             }
         } else {
             output->verbose(CALL_INFO, 16, 0, "CUDA: Ariel recieved ACK\n");
@@ -1396,9 +1692,8 @@ void ArielCore::handleRtlAckEvent(SST::Event* e) {
     }
     if(ev->RtlData.rtl_inp_ptr != nullptr) {
         rtl_inp_ptr = ev->RtlData.rtl_inp_ptr;
-        ArielReadEvent *are = new ArielReadEvent((uint64_t)ev->RtlData.rtl_inp_ptr, (uint64_t)ev->RtlData.rtl_inp_size);
         output->verbose(CALL_INFO, 1, 0, "\nAriel received Event from RTL. Generating Read Request\n");
-        handleReadRequest(are);
+        handleReadRequest((uint64_t)ev->RtlData.rtl_inp_ptr, (uint32_t)ev->RtlData.rtl_inp_size);
     }
 
     return;    
@@ -1410,6 +1705,29 @@ void ArielCore::printCoreStatistics() {
 
 bool ArielCore::processNextEvent() {
 
+    // Hits filtered out by the frontend spend their issue slots ahead of the
+    // queued events, they retire together with the last slot
+    if(filteredSlots > 0) {
+        updateCycle = true;
+        filteredSlots--;
+
+        if(0 == filteredSlots) {
+            statInstructionCount->addData(filteredHits);
+            statFilteredHits->addData(filteredHits);
+            inst_count += filteredHits;
+            filteredHits = 0;
+        }
+
+        return true;
+    }
+
+    // Pages the memory manager migrated are copied ahead of the application's accesses
+    if(!migrations.empty() && pending_transaction_count < maxPendingTransactions) {
+        issueMigrationRead();
+        updateCycle = true;
+        return true;
+    }
+
     // Upon every call, check if the core is drained and we are fenced. If so, unfence
     // return true; /* Todo: reevaluate if this is needed */
     // Attempt to refill the queue
@@ -1428,10 +1746,10 @@ bool ArielCore::processNextEvent() {
 
     ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Processing next event in core %" PRIu32 "...\n", coreID));
 
-    ArielEvent* nextEvent = coreQ->front();
+    ArielQueuedEvent& next = coreQ->front();
     bool removeEvent = false;
 
-    switch(nextEvent->getEventType()) {
+    switch(next.type) {
         case NOOP:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is NOOP\n", coreID));
                 statInstructionCount->addData(1);
@@ -1443,13 +1761,17 @@ bool ArielCore::processNextEvent() {
         case READ_ADDRESS:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is READ_ADDRESS\n", coreID));
 
+                if(!translationReady(next.access.address, next.access.length)) {
+                    break;
+                }
+
                 //  if(pendingTransactions->size() < maxPendingTransactions) {
                 if(pending_transaction_count < maxPendingTransactions) {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Found a read event, fewer pending transactions than permitted so will process...\n"));
                     statInstructionCount->addData(1);
                     inst_count++;
                     removeEvent = true;
-                    handleReadRequest(dynamic_cast<ArielReadEvent*>(nextEvent));
+                    handleReadRequest(next.access.address, next.access.length);
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ", core will stall for new events\n", coreID));
                     break;
@@ -1459,13 +1781,29 @@ bool ArielCore::processNextEvent() {
         case WRITE_ADDRESS:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is WRITE_ADDRESS\n", coreID));
 
+                if(!translationReady(next.access.address, next.access.length)) {
+                    break;
+                }
+
                 //  if(pendingTransactions->size() < maxPendingTransactions) {
                 if(pending_transaction_count < maxPendingTransactions) {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Found a write event, fewer pending transactions than permitted so will process...\n"));
                     statInstructionCount->addData(1);
                     inst_count++;
-                            removeEvent = true;
-                    handleWriteRequest(dynamic_cast<ArielWriteEvent*>(nextEvent));
+                    removeEvent = true;
+
+                    {
+                        const uint8_t* payload = coreQ->frontPayload();
+
+                        // Only ARIEL_MAX_PAYLOAD_SIZE bytes are carried through the tunnel, anything beyond reads as zero
+                        if(NULL != payload && next.access.length > ARIEL_MAX_PAYLOAD_SIZE) {
+                            payloadScratch.assign(next.access.length, 0);
+                            memcpy(&payloadScratch[0], payload, ARIEL_MAX_PAYLOAD_SIZE);
+                            payload = &payloadScratch[0];
+                        }
+
+                        handleWriteRequest(next.access.address, next.access.length, payload);
+                    }
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ", core will stall for new events\n", coreID));
                     break;
@@ -1485,25 +1823,25 @@ bool ArielCore::processNextEvent() {
         case SWITCH_POOL:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is a SWITCH_POOL\n", coreID));
                 removeEvent = true;
-                handleSwitchPoolEvent(dynamic_cast<ArielSwitchPoolEvent*>(nextEvent));
+                handleSwitchPoolEvent(next.pool);
                 break;
 
         case FREE:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is FREE\n", coreID));
                 removeEvent = true;
-                handleFreeEvent(dynamic_cast<ArielFreeEvent*>(nextEvent));
+                handleFreeEvent(next.access.address);
                 break;
 
         case MALLOC:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is MALLOC\n", coreID));
                 removeEvent = true;
-                handleAllocationEvent(dynamic_cast<ArielAllocateEvent*>(nextEvent));
+                handleAllocationEvent(dynamic_cast<ArielAllocateEvent*>(next.boxed));
                 break;
 
         case MMAP:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is MMAP\n", coreID));
                 removeEvent = true;
-                handleMmapEvent(dynamic_cast<ArielMmapEvent*>(nextEvent));
+                handleMmapEvent(dynamic_cast<ArielMmapEvent*>(next.boxed));
                 break;
 
         case CORE_EXIT:
@@ -1515,11 +1853,15 @@ bool ArielCore::processNextEvent() {
 
         case FLUSH:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is a FLUSH\n", coreID));
+
+                if(!translationReady(next.access.address, next.access.length)) {
+                    break;
+                }
                 if(pending_transaction_count < maxPendingTransactions) {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Found a FLUSH event, fewer pending transactions than permitted so will process..\n"));
                     statInstructionCount->addData(1);
                     inst_count++;
-                    handleFlushEvent(dynamic_cast<ArielFlushEvent*>(nextEvent));
+                    handleFlushEvent(next.access.address, next.access.length);
                     removeEvent = true;
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ",core will stall for new events\n", coreID));
@@ -1529,7 +1871,7 @@ bool ArielCore::processNextEvent() {
         case FENCE:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is a FENCE\n", coreID));
                 if(!isCoreFenced()) {// If core is fenced, drop this fence - they can be merged
-                    handleFenceEvent(dynamic_cast<ArielFenceEvent*>(nextEvent));
+                    handleFenceEvent();
                 }
                 removeEvent = true;
                 break;
@@ -1538,7 +1880,9 @@ bool ArielCore::processNextEvent() {
             ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 "next event is RTL (RTLEvent call)\n", coreID));
             output->verbose(CALL_INFO, 1, 0, "\nArielRTLEvent is being issued");
             removeEvent = true;
-            handleRtlEvent(dynamic_cast<ArielRtlEvent*>(nextEvent));
+            handleRtlEvent(dynamic_cast<ArielRtlEvent*>(next.boxed));
+            // the event now belongs to the RTL link
+            next.boxed = NULL;
             break;
 
 #ifdef HAVE_CUDA
@@ -1547,7 +1891,7 @@ bool ArielCore::processNextEvent() {
             removeEvent = true;
             stall();
             gpu();
-            handleGpuEvent(dynamic_cast<ArielGpuEvent*>(nextEvent));
+            handleGpuEvent(dynamic_cast<ArielGpuEvent*>(next.boxed));
             break;
 #endif
         default:
@@ -1560,8 +1904,6 @@ bool ArielCore::processNextEvent() {
         ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Removing event from pending queue, there are %" PRIu32 " events in the queue before deletion.\n",
                             (uint32_t) coreQ->size()));
         coreQ->pop();
-
-        delete nextEvent;
         return true;
     } else {
         ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Event removal was not requested, pending transaction queue length=%" PRIu32 ", maximum transactions: %" PRIu32 "\n",
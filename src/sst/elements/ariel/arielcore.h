@@ -32,20 +32,17 @@
 #include <poll.h>
 
 #include <string>
+#include <deque>
 #include <queue>
 #include <unordered_map>
 
 #include "arielmemmgr.h"
 #include "arielevent.h"
-#include "arielreadev.h"
-#include "arielwriteev.h"
-#include "arielexitev.h"
+#include "arieleventring.h"
+#include "arielpendingtable.h"
+#include "arielshared.h"
+#include "arielsofttlb.h"
 #include "arielallocev.h"
-#include "arielfreeev.h"
-#include "arielnoop.h"
-#include "arielflushev.h"
-#include "arielfenceev.h"
-#include "arielswitchpool.h"
 #include "arielrtlev.h"
 #include "tb_header.h"
 
@@ -60,9 +57,37 @@ using namespace SST;
 using namespace SST::Interfaces;
 using namespace SST::ArielComponent;
 
+/* Statistics each ArielCore registers, documented by every component that loads cores */
+#define ARIEL_CORE_ELI_STATISTICS \
+        { "read_requests",        "Statistic counts number of read requests", "requests", 1}, \
+        { "write_requests",       "Statistic counts number of write requests", "requests", 1}, \
+        { "read_request_sizes",   "Statistic for size of read requests", "bytes", 1}, \
+        { "write_request_sizes",  "Statistic for size of write requests", "bytes", 1}, \
+        { "split_read_requests",  "Statistic counts number of split read requests (requests which come from multiple lines)", "requests", 1}, \
+        { "split_write_requests", "Statistic counts number of split write requests (requests which are split over multiple lines)", "requests", 1}, \
+        { "no_ops",               "Statistic counts instructions which do not execute a memory operation", "instructions", 1}, \
+        { "l1filter_hits",        "Statistic counts accesses the Pin tool's L1 filter hit on, charged in aggregate (l1filter_size > 0 only)", "requests", 1}, \
+        { "flush_requests",       "Statistic counts instructions which perform flushes", "requests", 1}, \
+        { "fence_requests",       "Statistic counts instructions which perform fences", "requests", 1}, \
+        { "instruction_count",    "Statistic for counting instructions", "instructions", 1 }, \
+        { "max_insts",            "Maximum number of instructions reached by a thread", "instructions", 0}, \
+        { "fp_dp_ins",            "Statistic for counting DP-floating point instructions", "instructions", 1 }, \
+        { "fp_dp_simd_ins",       "Statistic for counting DP-FP SIMD instructons", "instructions", 1 }, \
+        { "fp_dp_scalar_ins",     "Statistic for counting DP-FP Non-SIMD instructons", "instructions", 1 }, \
+        { "fp_dp_ops",            "Statistic for counting DP-FP operations (inst * SIMD width)", "instructions", 1 }, \
+        { "fp_sp_ins",            "Statistic for counting SP-floating point instructions", "instructions", 1 }, \
+        { "fp_sp_simd_ins",       "Statistic for counting SP-FP SIMD instructons", "instructions", 1 }, \
+        { "fp_sp_scalar_ins",     "Statistic for counting SP-FP Non-SIMD instructons", "instructions", 1 }, \
+        { "fp_sp_ops",            "Statistic for counting SP-FP operations (inst * SIMD width)", "instructions", 1 }, \
+        { "cycles",               "Statistic for counting cycles of the Ariel core.", "cycles", 1 }, \
+        { "active_cycles",        "Statistic for counting active cycles (cycles not idle) of the Ariel core.", "cycles", 1 }, \
+        { "translation_tlb_hits", "Statistic counts translations served by the core's software TLB without asking the memory manager", "translations", 2 }, \
+        { "page_migration_lines", "Statistic counts lines copied for pages the memory manager moved to another frame (e.g., huge page promotion)", "lines", 2 }
+
 namespace SST {
 namespace ArielComponent {
 
+class ArielFrontend;
 
 class ArielCore : public ComponentExtension {
 
@@ -121,6 +146,7 @@ class ArielCore : public ComponentExtension {
         void createAllocateEvent(uint64_t vAddr, uint64_t length, uint32_t level, uint64_t ip);
         void createMmapEvent(uint32_t fileID, uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr);
         void createNoOpEvent();
+        void addFilteredHits(uint64_t hits);
         void createFreeEvent(uint64_t vAddr);
         void createExitEvent();
         void createFlushEvent(uint64_t vAddr);
@@ -137,6 +163,15 @@ class ArielCore : public ComponentExtension {
       }
 
         void setCacheLink(StandardMem* newCacheLink);
+        void setFrontend(ArielFrontend* fe);
+        void setTunnel(ArielTunnel* newTunnel) { tunnel = newTunnel; }
+        void setMemoryManager(ArielMemoryManager* newMemmgr);
+        // Set when the memory manager and frontend are shared with cores on other threads
+        void setSharedLock(std::mutex* lock) { sharedLock = lock; }
+        // Copy the pages the memory manager has migrated since the last call
+        void collectMigrations();
+        // Set on partition cores, which reach the memory manager through the owner
+        void setPartitionTranslations(ArielPartitionTranslations* translations) { partitionTranslations = translations; }
         void createRtlEvent(void*, void*, void*, size_t, size_t, size_t);
         void setRtlLink(Link* rtllink);
 
@@ -147,14 +182,14 @@ class ArielCore : public ComponentExtension {
 #endif
 
         void handleEvent(StandardMem::Request* event);
-        void handleReadRequest(ArielReadEvent* wEv);
-        void handleWriteRequest(ArielWriteEvent* wEv);
+        void handleReadRequest(uint64_t readAddress, uint32_t length);
+        void handleWriteRequest(uint64_t writeAddress, uint32_t length, const uint8_t* payload);
         void handleAllocationEvent(ArielAllocateEvent* aEv);
         void handleMmapEvent(ArielMmapEvent* aEv);
-        void handleFreeEvent(ArielFreeEvent* aFE);
-        void handleSwitchPoolEvent(ArielSwitchPoolEvent* aSPE);
-        void handleFlushEvent(ArielFlushEvent *flEv);
-        void handleFenceEvent(ArielFenceEvent *fEv);
+        void handleFreeEvent(uint64_t virtualAddress);
+        void handleSwitchPoolEvent(uint32_t pool);
+        void handleFlushEvent(uint64_t virtualAddress, uint64_t length);
+        void handleFenceEvent();
         void handleRtlEvent(ArielRtlEvent* RtlEv);
         void handleRtlAckEvent(SST::Event* e);
 
@@ -189,11 +224,17 @@ class ArielCore : public ComponentExtension {
         void setMaxInsts(uint64_t i){max_insts=i;}
 
         void printCoreStatistics();
-        void printTraceEntry(const bool isRead, const uint64_t address, const uint32_t length);
+        void printTraceEntry(const ArielTraceEntryOperation op, const uint64_t virtAddr, const uint64_t physAddr,
+                const uint64_t length, const uint32_t level = 0, const uint64_t mallocID = 0);
 
     private:
         bool processNextEvent();
         bool refillQueue();
+        uint64_t translateAddress(uint64_t virtAddr);
+        bool translationReady(uint64_t virtAddr, uint64_t length);
+        void takeMigrations();
+        void issueMigrationRead();
+        void processBatch(const ArielCommand& ac);
         bool writePayloads;
         uint32_t coreID;
         uint32_t maxPendingTransactions;
@@ -217,13 +258,18 @@ class ArielCore : public ComponentExtension {
 #endif
 
         Output* output;
-        std::queue<ArielEvent*>* coreQ;
+        ArielEventRing* coreQ;
         bool isStalled;
         bool isHalted;
         bool isFenced;
 
         StandardMem* cacheLink;
         ArielTunnel *tunnel;
+        ArielFrontend *frontend;
+        // The frontend's commands carry physical addresses, skip translation
+        bool physicalCommands;
+        ArielPartitionTranslations* partitionTranslations;
+        ArielBatchDecoder batchDecoder;
         StdMemHandler* stdMemHandlers;
         Link* RtlLink;
 
@@ -234,12 +280,34 @@ class ArielCore : public ComponentExtension {
         std::unordered_map<StandardMem::Request::id_t, StandardMem::Request*>* pendingGpuTransactions;
 #endif
 
-        std::unordered_map<StandardMem::Request::id_t, StandardMem::Request*>* pendingTransactions;
+        ArielPendingTable<StandardMem::Request::id_t>* pendingTransactions;
+        std::vector<uint8_t> payloadScratch;
         uint32_t maxIssuePerCycle;
         uint32_t maxQLength;
         uint64_t cacheLineSize;
+        uint64_t filteredHitLatency;
+        uint64_t filteredHits;
+        uint64_t filteredSlots;
         void* rtl_inp_ptr = nullptr;
         ArielMemoryManager* memmgr;
+        std::mutex* sharedLock;
+        ArielSoftTLB softTLB;
+        uint64_t softTLBEpoch;
+
+        // A line of a migrated page, read from the old frame then written to the new one
+        struct MigrationLine {
+            uint64_t frame;
+            uint64_t from;
+            uint64_t to;
+        };
+
+        void finishMigrationRead(StandardMem::Request* event, const MigrationLine& line);
+
+        std::deque<ArielPageMigration> migrations;
+        uint64_t migrationOffset;
+        std::unordered_map<StandardMem::Request::id_t, MigrationLine> migrationReads;
+        std::unordered_map<uint64_t, uint64_t> migrationLinesLeft;
+
         const uint32_t verbosity;
         const uint32_t perform_checks;
         bool enableTracing;
@@ -264,6 +332,9 @@ class ArielCore : public ComponentExtension {
         Statistic<uint64_t>* statSplitReadRequests;
         Statistic<uint64_t>* statSplitWriteRequests;
         Statistic<uint64_t>* statNoopCount;
+        Statistic<uint64_t>* statFilteredHits;
+        Statistic<uint64_t>* statSoftTLBHits;
+        Statistic<uint64_t>* statMigratedLines;
         Statistic<uint64_t>* statInstructionCount;
         Statistic<uint64_t>* statCycles;
         Statistic<uint64_t>* statActiveCycles;
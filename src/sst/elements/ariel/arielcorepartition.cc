@@ -0,0 +1,178 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include "arielcorepartition.h"
+#include "arielfrontend.h"
+
+using namespace SST::ArielComponent;
+
+ArielCorePartition::ArielCorePartition(ComponentId_t id, Params& params) :
+            Component(id), shared(NULL), halted(false) {
+
+    int verbosity = params.find<int>("verbose", 0);
+    output = new SST::Output("ArielCorePartition[@f:@l:@p] ", verbosity, 0, SST::Output::STDOUT);
+
+    cpu_name   = params.find<std::string>("cpu", "");
+    first_core = (uint32_t) params.find<uint32_t>("firstcore", 0);
+    core_count = (uint32_t) params.find<uint32_t>("corecount", 1);
+
+    if("" == cpu_name) {
+        output->fatal(CALL_INFO, -1, "%s, Error: the name of the owning ariel component must be given with the 'cpu' parameter\n", getName().c_str());
+    }
+
+    if(0 == core_count) {
+        output->fatal(CALL_INFO, -1, "%s, Error: a partition must simulate at least one core\n", getName().c_str());
+    }
+
+    output->verbose(CALL_INFO, 1, 0, "Configuring cores %" PRIu32 " to %" PRIu32 " of %s...\n",
+            first_core, first_core + core_count - 1, cpu_name.c_str());
+
+    uint32_t perform_checks      = (uint32_t) params.find<uint32_t>("checkaddresses", 0);
+    uint32_t maxIssuesPerCycle   = (uint32_t) params.find<uint32_t>("maxissuepercycle", 1);
+    uint32_t maxPendingTransCore = (uint32_t) params.find<uint32_t>("maxtranscore", 16);
+    max_core_queue               = (uint32_t) params.find<uint32_t>("maxcorequeue", 64);
+    cache_line_size              = (uint64_t) params.find<uint32_t>("cachelinesize", 64);
+
+    std::string cpu_clock = params.find<std::string>("clock", "1GHz");
+    TimeConverter* timeconverter = registerClock( cpu_clock, new Clock::Handler<ArielCorePartition>(this, &ArielCorePartition::tick ) );
+
+    // The tunnel and memory manager belong to the owning ArielCPU which may not be constructed yet, they are attached in init
+    for(uint32_t i = 0; i < core_count; ++i) {
+        cpu_cores.push_back(loadComponentExtension<ArielCore>((ArielTunnel*) NULL,
+#ifdef HAVE_CUDA
+                 (GpuReturnTunnel*) NULL, (GpuDataTunnel*) NULL,
+#endif
+                 first_core + i, maxPendingTransCore, output, maxIssuesPerCycle, max_core_queue,
+                 cache_line_size, (ArielMemoryManager*) NULL, perform_checks, params));
+
+        cpu_cores[i]->setMaxInsts(0);
+    }
+
+    SubComponentSlotInfo* mem = getSubComponentSlotInfo("memory");
+    if (mem) {
+        if (!mem->isAllPopulated())
+            output->fatal(CALL_INFO, -1, "%s, Error: loading 'memory' subcomponents. All subcomponent slots from 0 to corecount must be populated. Check your input config for non-populated slots\n", getName().c_str());
+
+        if (mem->getMaxPopulatedSlotNumber() != core_count-1)
+            output->fatal(CALL_INFO, -1, "%s, Error: Loading 'memory' subcomponents and the number of subcomponents does not match the number of cores. Cores: %u, SubComps: %u. Check your input config.\n",
+                    getName().c_str(), core_count, mem->getMaxPopulatedSlotNumber());
+
+        for (uint32_t i = 0; i < core_count; i++) {
+            cpu_to_cache_links.push_back(mem->create<Interfaces::StandardMem>(i, ComponentInfo::INSERT_STATS, timeconverter, new StandardMem::Handler<ArielCore>(cpu_cores[i], &ArielCore::handleEvent)));
+            cpu_cores[i]->setCacheLink(cpu_to_cache_links[i]);
+        }
+    } else {
+        for (uint32_t i = 0; i < core_count; i++) {
+            Params par;
+            par.insert("port", "cache_link_" + std::to_string(i));
+            cpu_to_cache_links.push_back(loadAnonymousSubComponent<Interfaces::StandardMem>("memHierarchy.standardInterface", "memory", i,
+                        ComponentInfo::SHARE_PORTS | ComponentInfo::INSERT_STATS, par, timeconverter, new StandardMem::Handler<ArielCore>(cpu_cores[i], &ArielCore::handleEvent)));
+            cpu_cores[i]->setCacheLink(cpu_to_cache_links[i]);
+        }
+    }
+
+    cpu_link = configureLink("cpu_link", new Event::Handler<ArielCorePartition>(this, &ArielCorePartition::handleOwnerEvent));
+    if (NULL == cpu_link) {
+        output->fatal(CALL_INFO, -1, "%s, Error: cpu_link must be connected to a partition_link port of %s\n", getName().c_str(), cpu_name.c_str());
+    }
+
+    // Translations and memory manager calls go through the owner, in its simulated-time order
+    translations.configure(cpu_link, cache_line_size);
+    for(uint32_t i = 0; i < core_count; ++i) {
+        cpu_cores[i]->setPartitionTranslations(&translations);
+    }
+
+    output->verbose(CALL_INFO, 1, 0, "Completed construction of the Ariel core partition.\n");
+}
+
+void ArielCorePartition::init(unsigned int phase) {
+    if(0 == phase) {
+        shared = ArielSharedContext::find(cpu_name);
+
+        if(NULL == shared) {
+            output->fatal(CALL_INFO, -1, "%s, Error: %s is not an ariel component on this rank with localcores < corecount\n",
+                    getName().c_str(), cpu_name.c_str());
+        }
+
+        if(shared->maxCoreQueueLen != max_core_queue || shared->cacheLineSize != cache_line_size) {
+            output->fatal(CALL_INFO, -1, "%s, Error: maxcorequeue and cachelinesize must match those of %s (%" PRIu32 ", %" PRIu64 ")\n",
+                    getName().c_str(), cpu_name.c_str(), shared->maxCoreQueueLen, shared->cacheLineSize);
+        }
+
+        if(!shared->claim(first_core, core_count)) {
+            output->fatal(CALL_INFO, -1, "%s, Error: cores %" PRIu32 " to %" PRIu32 " are out of range or already simulated by another component\n",
+                    getName().c_str(), first_core, first_core + core_count - 1);
+        }
+
+        for(uint32_t i = 0; i < core_count; ++i) {
+            cpu_cores[i]->setSharedLock(&shared->lock);
+            cpu_cores[i]->setTunnel(shared->tunnel);
+            cpu_cores[i]->setMemoryManager(shared->memmgr);
+            cpu_cores[i]->setFrontend(shared->frontend);
+        }
+    }
+
+    for (uint32_t i = 0; i < core_count; i++) {
+        cpu_to_cache_links[i]->init(phase);
+    }
+}
+
+void ArielCorePartition::finish() {
+    for(uint32_t i = 0; i < core_count; ++i) {
+        cpu_cores[i]->finishCore();
+    }
+
+    for(uint32_t i = 0; i < core_count; ++i) {
+        cpu_cores[i]->printCoreStatistics();
+    }
+}
+
+bool ArielCorePartition::tick( SST::Cycle_t cycle) {
+    output->verbose(CALL_INFO, 16, 0, "Partition tick, will issue to individual cores...\n");
+
+    for(uint32_t i = 0; i < core_count; ++i) {
+        cpu_cores[i]->tick();
+
+        if(cpu_cores[i]->isCoreHalted()) {
+            halted = true;
+            break;
+        }
+    }
+
+    // The owning component decides when the simulation ends
+    if(halted) {
+        cpu_link->send(new ArielPartitionEvent(ArielPartitionEvent::HALT, first_core));
+    }
+
+    return halted;
+}
+
+void ArielCorePartition::handleOwnerEvent( SST::Event* ev ) {
+    translations.update(static_cast<ArielPartitionEvent*>(ev));
+    delete ev;
+}
+
+ArielCorePartition::~ArielCorePartition() {
+    delete output;
+}
+
+void ArielCorePartition::emergencyShutdown() {
+    for(uint32_t i = 0; i < core_count; ++i) {
+        cpu_cores[i]->finishCore();
+    }
+}
@@ -0,0 +1,106 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ARIEL_CORE_PARTITION
+#define _H_ARIEL_CORE_PARTITION
+
+#include <sst/core/sst_config.h>
+#include <sst/core/interfaces/stdMem.h>
+#include <sst/core/component.h>
+#include <sst/core/params.h>
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "arielcore.h"
+#include "arielshared.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/**
+ * Simulates a contiguous range of the cores of an ariel.ariel component so
+ * they can be placed on another thread. The cores still read the tunnel of
+ * the owning ArielCPU, so the partition must be on the same rank as its
+ * owner. The owner is found by name at init, once every component has been
+ * constructed. Translations and other memory manager calls are requests to
+ * the owner over cpu_link; a core waits a link round trip the first time it
+ * touches a page, and the memory manager's translation statistics only count
+ * those requests.
+ */
+class ArielCorePartition : public SST::Component {
+    public:
+
+    /* SST ELI */
+    SST_ELI_REGISTER_COMPONENT(ArielCorePartition, "ariel", "ArielCorePartition", SST_ELI_ELEMENT_VERSION(1,0,0), "Simulates a range of the cores of an ariel.ariel component so they can run on another thread", COMPONENT_CATEGORY_PROCESSOR)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},
+        {"cpu", "Name of the ariel.ariel component whose cores are simulated here", ""},
+        {"firstcore", "First core (in the owning component's numbering) simulated here", "0"},
+        {"corecount", "Number of consecutive cores simulated here", "1"},
+        {"checkaddresses", "Verify that addresses are valid with respect to cache lines", "0"},
+        {"maxissuepercycle", "Maximum number of requests to issue per cycle, per core", "1"},
+        {"maxcorequeue", "Maximum queue depth per core, must match the owning component", "64"},
+        {"maxtranscore", "Maximum number of pending transactions", "16"},
+        {"l1filter_hit_latency", "Hit latency in cycles charged for the accesses filtered out by the frontend's L1 model", "4"},
+        {"cachelinesize", "Line size of the attached caching structure, must match the owning component", "64"},
+        {"clock", "Clock rate at which events are generated and processed", "1GHz"},
+        {"tracegen", "Select the trace generator for Ariel (which records traced memory operations", ""},
+        {"writepayloadtrace", "Trace write payloads and put real memory contents into the memory system", "0"})
+
+    SST_ELI_DOCUMENT_PORTS( {"cache_link_%(corecount)d", "Each core's link to its cache", {}},
+        {"cpu_link", "Link to one of the owning component's partition_link ports, carries the cores' memory manager requests", {}})
+
+    SST_ELI_DOCUMENT_STATISTICS( ARIEL_CORE_ELI_STATISTICS )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+            {"memory", "Interface to the memoryHierarchy (e.g., caches)", "SST::Interfaces::StandardMem" }
+    )
+
+        ArielCorePartition(ComponentId_t id, Params& params);
+        ~ArielCorePartition();
+        virtual void init(unsigned int phase);
+        virtual void setup() {}
+        virtual void finish();
+        virtual void emergencyShutdown();
+        virtual bool tick( SST::Cycle_t );
+        void handleOwnerEvent( SST::Event* ev );
+
+    private:
+        SST::Output* output;
+
+        std::vector<ArielCore*> cpu_cores;
+        std::vector<Interfaces::StandardMem*> cpu_to_cache_links;
+        SST::Link* cpu_link;
+
+        std::string cpu_name;
+        uint32_t first_core;
+        uint32_t core_count;
+        uint32_t max_core_queue;
+        uint64_t cache_line_size;
+
+        ArielSharedContext* shared;
+        ArielPartitionTranslations translations;
+        bool halted;
+};
+
+}
+}
+
+#endif
@@ -18,6 +18,8 @@
 
 #include "arielcpu.h"
 
+#include <algorithm>
+
 #include <stdlib.h>
 #include <unistd.h>
 #include <stdio.h>
@@ -42,6 +44,18 @@ ArielCPU::ArielCPU(ComponentId_t id, Params& params) :
 
     output->verbose(CALL_INFO, 1, 0, "Configuring for %" PRIu32 " cores...\n", core_count);
 
+    local_core_count = (uint32_t) params.find<uint32_t>("localcores", core_count);
+
+    if(0 == local_core_count || local_core_count > core_count) {
+        output->fatal(CALL_INFO, -1, "%s, Error: localcores (%" PRIu32 ") must be between 1 and corecount (%" PRIu32 ")\n",
+                getName().c_str(), local_core_count, core_count);
+    }
+
+    if(local_core_count < core_count) {
+        output->verbose(CALL_INFO, 1, 0, "Simulating cores 0 to %" PRIu32 " here, the rest are left to ariel.ArielCorePartition components\n",
+                local_core_count - 1);
+    }
+
     uint32_t perform_checks = (uint32_t) params.find<uint32_t>("checkaddresses", 0);
     output->verbose(CALL_INFO, 1, 0, "Configuring for check addresses = %s\n", (perform_checks > 0) ? "yes" : "no");
 
@@ -163,6 +177,19 @@ ArielCPU::ArielCPU(ComponentId_t id, Params& params) :
     tunnelD = frontend->getDataTunnel();
 #endif
 
+    // Partitions on other threads find the tunnel, memory manager and frontend through the shared context
+    shared = NULL;
+    if(local_core_count < core_count) {
+#ifdef HAVE_CUDA
+        if(gpu_enabled) {
+            output->fatal(CALL_INFO, -1, "%s, Error: GPU support requires all cores to be simulated by this component (localcores = corecount)\n", getName().c_str());
+        }
+#endif
+        shared = new ArielSharedContext(tunnel, memmgr, frontend, core_count, maxCoreQueueLen, cacheLineSize);
+        shared->claim(0, local_core_count);
+        ArielSharedContext::publish(getName(), shared);
+    }
+
     /////////////////////////////////////////////////////////////////////////////////////
 
     std::string cpu_clock = params.find<std::string>("clock", "1GHz");
@@ -177,7 +204,7 @@ ArielCPU::ArielCPU(ComponentId_t id, Params& params) :
     output->verbose(CALL_INFO, 1, 0, "Creating processor cores and cache links...\n");
 
     output->verbose(CALL_INFO, 1, 0, "Configuring cores and cache links...\n");
-    for(uint32_t i = 0; i < core_count; ++i) {
+    for(uint32_t i = 0; i < local_core_count; ++i) {
         cpu_cores.push_back(loadComponentExtension<ArielCore>(tunnel,
 #ifdef HAVE_CUDA
                  tunnelR, tunnelD,
@@ -187,6 +214,11 @@ ArielCPU::ArielCPU(ComponentId_t id, Params& params) :
 
         // Set max number of instructions
         cpu_cores[i]->setMaxInsts(max_insts);
+        cpu_cores[i]->setFrontend(frontend);
+
+        if(NULL != shared) {
+            cpu_cores[i]->setSharedLock(&shared->lock);
+        }
     }
 
     // Find all the components loaded into the "memory" slot
@@ -196,18 +228,18 @@ ArielCPU::ArielCPU(ComponentId_t id, Params& params) :
         if (!mem->isAllPopulated())
             output->fatal(CALL_INFO, -1, "%s, Error: loading 'memory' subcomponents. All subcomponent slots from 0 to core_count must be populated. Check your input config for non-populated slots\n", getName().c_str());
 
-        if (mem->getMaxPopulatedSlotNumber() != core_count-1)
+        if (mem->getMaxPopulatedSlotNumber() != local_core_count-1)
             output->fatal(CALL_INFO, -1, "%s, Error: Loading 'memory' subcomponents and the number of subcomponents does not match the number of cores. Cores: %u, SubComps: %u. Check your input config.\n",
-                    getName().c_str(), core_count, mem->getMaxPopulatedSlotNumber());
+                    getName().c_str(), local_core_count, mem->getMaxPopulatedSlotNumber());
 
-        for (int i = 0; i < core_count; i++) {
+        for (int i = 0; i < local_core_count; i++) {
             cpu_to_cache_links.push_back(mem->create<Interfaces::StandardMem>(i, ComponentInfo::INSERT_STATS, timeconverter, new StandardMem::Handler<ArielCore>(cpu_cores[i], &ArielCore::handleEvent)));
             cpu_cores[i]->setCacheLink(cpu_to_cache_links[i]);
         }
     } else {
     // Load from here not the user one; let the subcomponent have our port (cache_link)
         char* link_buffer = (char*) malloc(sizeof(char) * 256);
-        for (int i = 0; i < core_count; i++) {
+        for (int i = 0; i < local_core_count; i++) {
             Params par;
             par.insert("port", "cache_link_" + std::to_string(i));
             cpu_to_cache_links.push_back(loadAnonymousSubComponent<Interfaces::StandardMem>("memHierarchy.standardInterface", "memory", i,
@@ -236,6 +268,17 @@ ArielCPU::ArielCPU(ComponentId_t id, Params& params) :
     }
 
 
+    // Partitions send their cores' memory manager requests and halts here
+    std::string partition_port = "partition_link_0";
+    while(isPortConnected(partition_port)) {
+        const uint32_t partition = (uint32_t) partition_links.size();
+        partition_links.push_back(configureLink(partition_port, new Event::Handler<ArielCPU, uint32_t>(this, &ArielCPU::handlePartitionEvent, partition)));
+        partition_port = "partition_link_" + std::to_string(partition_links.size());
+    }
+
+    partition_epoch = memmgr->getTranslationEpoch();
+    flush_partitions = false;
+
     // Register us as an important component
     registerAsPrimaryComponent();
     primaryComponentDoNotEndSim();
@@ -250,20 +293,28 @@ void ArielCPU::init(unsigned int phase)
 {
     frontend->init(phase);
 
-    for (uint32_t i = 0; i < core_count; i++) {
+    for (uint32_t i = 0; i < local_core_count; i++) {
         cpu_to_cache_links[i]->init(phase);
     }
 }
 
+void ArielCPU::setup() {
+    // Every partition has claimed its cores by the end of init
+    if(NULL != shared && shared->firstUnclaimed() != core_count) {
+        output->fatal(CALL_INFO, -1, "%s, Error: core %" PRIu32 " is not simulated by this component or any ariel.ArielCorePartition. Check the firstcore and corecount of the partitions.\n",
+                getName().c_str(), shared->firstUnclaimed());
+    }
+}
+
 void ArielCPU::finish() {
-    for(uint32_t i = 0; i < core_count; ++i) {
+    for(uint32_t i = 0; i < local_core_count; ++i) {
         cpu_cores[i]->finishCore();
     }
 
     output->verbose(CALL_INFO, 1, 0, "Ariel Processor Information:\n");
     output->verbose(CALL_INFO, 1, 0, "Completed at: %" PRIu64 " nanoseconds.\n", (uint64_t) getCurrentSimTimeNano() );
     output->verbose(CALL_INFO, 1, 0, "Ariel Component Statistics (By Core)\n");
-    for(uint32_t i = 0; i < core_count; ++i) {
+    for(uint32_t i = 0; i < local_core_count; ++i) {
         cpu_cores[i]->printCoreStatistics();
     }
 
@@ -278,8 +329,18 @@ bool ArielCPU::tick( SST::Cycle_t cycle) {
     tunnel->updateTime(getCurrentSimTimeNano());
     tunnel->incrementCycles();
 
+    if(!partition_links.empty()) {
+        servePartitions();
+
+        // Core 0 copies the pages a partition's request made the manager migrate.
+        // Without local cores the old frames are simply never reused.
+        if(local_core_count > 0 && memmgr->hasMigrations()) {
+            cpu_cores[0]->collectMigrations();
+        }
+    }
+
     // Keep ticking unless one of the cores says it is time to stop.
-    for(uint32_t i = 0; i < core_count; ++i) {
+    for(uint32_t i = 0; i < local_core_count; ++i) {
         cpu_cores[i]->tick();
 
         if(cpu_cores[i]->isCoreHalted()) {
@@ -288,6 +349,16 @@ bool ArielCPU::tick( SST::Cycle_t cycle) {
         }
     }
 
+    // A mapping handed to the partitions may have changed, they drop every translation
+    if(!partition_links.empty() && (flush_partitions || memmgr->getTranslationEpoch() != partition_epoch)) {
+        partition_epoch = memmgr->getTranslationEpoch();
+        flush_partitions = false;
+
+        for(uint32_t i = 0; i < partition_links.size(); ++i) {
+            partition_links[i]->send(new ArielPartitionEvent(ArielPartitionEvent::FLUSH_TRANSLATIONS, 0));
+        }
+    }
+
     // Its time to end, that's all folks
     if(stopTicking) {
         primaryComponentOKToEndSim();
@@ -296,11 +367,99 @@ bool ArielCPU::tick( SST::Cycle_t cycle) {
     return stopTicking;
 }
 
-ArielCPU::~ArielCPU() { }
+void ArielCPU::handlePartitionEvent( SST::Event* ev, uint32_t partition ) {
+    ArielPartitionEvent* pev = static_cast<ArielPartitionEvent*>(ev);
+
+    if(ArielPartitionEvent::HALT == pev->getType()) {
+        output->verbose(CALL_INFO, 1, 0, "Core %" PRIu32 " in an Ariel partition has halted, ending the simulation.\n", pev->core);
+        delete ev;
+
+        primaryComponentOKToEndSim();
+        return;
+    }
+
+    PartitionRequest request;
+    request.arrival = getCurrentSimCycle();
+    request.partition = partition;
+    request.ev = pev;
+    partition_requests.push_back(request);
+}
+
+/*
+ * Partition cores never touch the memory manager themselves. Serving their
+ * requests here, ordered by arrival time and core rather than by the order
+ * the threads delivered them, makes first-touch allocation deterministic.
+ * Requests from one core keep their order.
+ */
+void ArielCPU::servePartitions() {
+    if(partition_requests.empty()) {
+        return;
+    }
+
+    std::stable_sort(partition_requests.begin(), partition_requests.end());
+
+    ArielSharedGuard guard(&shared->lock);
+
+    for(std::vector<PartitionRequest>::iterator request = partition_requests.begin(); request != partition_requests.end(); ++request) {
+        ArielPartitionEvent* ev = request->ev;
+
+        switch(ev->getType()) {
+            case ArielPartitionEvent::TRANSLATE:
+                {
+                    uint64_t pageBytes;
+                    const uint64_t physAddr = memmgr->translatePage(ev->virtAddr, pageBytes);
+
+                    // Managers that cannot vouch for a whole page are asked again for every line
+                    if(0 == pageBytes) {
+                        pageBytes = shared->cacheLineSize;
+                    }
+
+                    ev->type = ArielPartitionEvent::TRANSLATED;
+                    ev->virtBase = ev->virtAddr - (ev->virtAddr % pageBytes);
+                    ev->physBase = physAddr - (ev->virtAddr - ev->virtBase);
+                    ev->bytes = pageBytes;
+                    partition_links[request->partition]->send(ev);
+                }
+                continue;
+
+            case ArielPartitionEvent::MALLOC:
+                memmgr->allocateMalloc(ev->bytes, ev->level, ev->virtAddr, ev->instPtr, ev->core);
+                break;
+
+            case ArielPartitionEvent::MMAP:
+                memmgr->allocateMMAP(ev->bytes, ev->level, ev->virtAddr, ev->instPtr, ev->file, ev->core);
+                break;
+
+            case ArielPartitionEvent::FREE:
+                memmgr->freeMalloc(ev->virtAddr);
+                flush_partitions = true;
+                break;
+
+            case ArielPartitionEvent::SWITCH_POOL:
+                memmgr->setDefaultPool(ev->level);
+                break;
+
+            default:
+                output->fatal(CALL_INFO, -1, "%s, Error: unexpected request %" PRIu32 " from partition %" PRIu32 "\n",
+                        getName().c_str(), ev->type, request->partition);
+        }
+
+        delete ev;
+    }
+
+    partition_requests.clear();
+}
+
+ArielCPU::~ArielCPU() {
+    if(NULL != shared) {
+        ArielSharedContext::withdraw(getName());
+        delete shared;
+    }
+}
 
 void ArielCPU::emergencyShutdown() {
     /* Ask the cores to finish up.  This should flush logging */
-    for(uint32_t i = 0; i < core_count; ++i) {
+    for(uint32_t i = 0; i < local_core_count; ++i) {
         cpu_cores[i]->finishCore();
     }
 
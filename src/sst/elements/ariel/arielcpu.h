@@ -47,10 +47,13 @@ class ArielCPU : public SST::Component {
         {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},
         {"profilefunctions", "Profile functions for Ariel execution, 0 = none, >0 = enable", "0" },
         {"corecount", "Number of CPU cores to emulate", "1"},
+        {"localcores", "Number of cores, starting from core 0, simulated by this component. The rest must be claimed by ariel.ArielCorePartition components on the same rank", "corecount"},
         {"checkaddresses", "Verify that addresses are valid with respect to cache lines", "0"},
         {"maxissuepercycle", "Maximum number of requests to issue per cycle, per core", "1"},
         {"maxcorequeue", "Maximum queue depth per core", "64"},
         {"maxtranscore", "Maximum number of pending transactions", "16"},
+        {"l1filter_hit_latency", "Hit latency in cycles charged for the accesses filtered out by the frontend's L1 model (see the frontend l1filter_size parameter)", "4"},
+        {"translation_tlb_entries", "Entries in each core's software TLB, which caches whole-page translations when the memory manager supports it (0 to disable). Translations it serves are not counted by the memory manager's statistics", "0"},
         {"pipetimeout", "Read timeout between Ariel and traced application", "10"},
         {"cachelinesize", "Line size of the attached caching structure", "64"},
         {"arieltool", "Path to the Ariel PIN-tool shared library", ""},
@@ -82,31 +85,11 @@ class ArielCPU : public SST::Component {
 
     SST_ELI_DOCUMENT_PORTS( {"cache_link_%(corecount)d", "Each core's link to its cache", {}},
        {"gpu_link_%(corecount)d", "Each core's link to the GPU", {}},
-       {"rtl_link_%(corecount)d", "Each core's link to the RTL", {}})
-
-
-    SST_ELI_DOCUMENT_STATISTICS(
-        { "read_requests",        "Statistic counts number of read requests", "requests", 1},   // Name, Desc, Enable Level
-        { "write_requests",       "Statistic counts number of write requests", "requests", 1},
-        { "read_request_sizes",   "Statistic for size of read requests", "bytes", 1},   // Name, Desc, Enable Level
-        { "write_request_sizes",  "Statistic for size of write requests", "bytes", 1},
-        { "split_read_requests",  "Statistic counts number of split read requests (requests which come from multiple lines)", "requests", 1},
-        { "split_write_requests", "Statistic counts number of split write requests (requests which are split over multiple lines)", "requests", 1},
-        { "no_ops",               "Statistic counts instructions which do not execute a memory operation", "instructions", 1},
-	    { "flush_requests",       "Statistic counts instructions which perform flushes", "requests", 1},
-	    { "fence_requests",       "Statistic counts instructions which perform fences", "requests", 1},
-        { "instruction_count",    "Statistic for counting instructions", "instructions", 1 },
-        { "max_insts", "Maximum number of instructions reached by a thread",	"instructions", 0},
-        { "fp_dp_ins",            "Statistic for counting DP-floating point instructions", "instructions", 1 },
-        { "fp_dp_simd_ins",       "Statistic for counting DP-FP SIMD instructons", "instructions", 1 },
-        { "fp_dp_scalar_ins",     "Statistic for counting DP-FP Non-SIMD instructons", "instructions", 1 },
-        { "fp_dp_ops",            "Statistic for counting DP-FP operations (inst * SIMD width)", "instructions", 1 },
-        { "fp_sp_ins",            "Statistic for counting SP-floating point instructions", "instructions", 1 },
-        { "fp_sp_simd_ins",       "Statistic for counting SP-FP SIMD instructons", "instructions", 1 },
-        { "fp_sp_scalar_ins",     "Statistic for counting SP-FP Non-SIMD instructons", "instructions", 1 },
-        { "fp_sp_ops",            "Statistic for counting SP-FP operations (inst * SIMD width)", "instructions", 1 },
-        { "cycles",               "Statistic for counting cycles of the Ariel core.", "cycles", 1 },
-        { "active_cycles",        "Statistic for counting active cycles (cycles not idle) of the Ariel core.", "cycles", 1 })
+       {"rtl_link_%(corecount)d", "Each core's link to the RTL", {}},
+       {"partition_link_%(partitioncount)d", "Link to each ariel.ArielCorePartition, carries its cores' memory manager requests and halts", {}})
+
+
+    SST_ELI_DOCUMENT_STATISTICS( ARIEL_CORE_ELI_STATISTICS )
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
             {"memmgr", "Memory manager to translate virtual addresses to physical, handle malloc/free, etc.", "SST::ArielComponent::ArielMemoryManager"},
@@ -118,11 +101,25 @@ class ArielCPU : public SST::Component {
         ~ArielCPU();
         virtual void emergencyShutdown();
         virtual void init(unsigned int phase);
-        virtual void setup() {}
+        virtual void setup();
         virtual void finish();
         virtual bool tick( SST::Cycle_t );
+        void handlePartitionEvent( SST::Event* ev, uint32_t partition );
 
     private:
+        // A partition's request, served in the next tick
+        struct PartitionRequest {
+            SimTime_t arrival;
+            uint32_t partition;
+            ArielPartitionEvent* ev;
+
+            bool operator<(const PartitionRequest& other) const {
+                return arrival < other.arrival || (arrival == other.arrival && ev->core < other.ev->core);
+            }
+        };
+
+        void servePartitions();
+
         SST::Output* output;
         ArielMemoryManager* memmgr;
 
@@ -130,8 +127,14 @@ class ArielCPU : public SST::Component {
         std::vector<Interfaces::StandardMem*> cpu_to_cache_links;
         std::vector<SST::Link*> cpu_to_gpu_links;
         std::vector<SST::Link*> cpu_to_rtl_links;
+        std::vector<SST::Link*> partition_links;
+        std::vector<PartitionRequest> partition_requests;
+        uint64_t partition_epoch;
+        bool flush_partitions;
 
         uint32_t core_count;
+        uint32_t local_core_count;
+        ArielSharedContext* shared;
 
         ArielFrontend* frontend;
         ArielTunnel* tunnel;
@@ -0,0 +1,164 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_ARIEL_EVENT_RING
+#define _H_SST_ARIEL_EVENT_RING
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include "arielevent.h"
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Entry of a core's event queue. The events issued per instruction are
+ * stored by value. Allocations, mmaps, RTL and GPU calls are rare and keep
+ * their ArielEvent object, owned by the ring until the entry is popped.
+ */
+struct ArielQueuedEvent {
+    ArielEventType type;
+    union {
+        struct {
+            uint64_t address;       // virtual address for reads, writes, flushes and frees
+            uint32_t length;
+        } access;
+        uint32_t pool;
+        ArielEvent* boxed;
+    };
+};
+
+/*
+ * Fixed-capacity FIFO of queued events with a write payload area per
+ * entry. Capacity is a power of two covering the queue limit plus the
+ * overshoot of one command batch, so after construction nothing is
+ * allocated unless a frontend overfills the queue, in which case it grows.
+ */
+class ArielEventRing {
+
+    public:
+        ArielEventRing(uint32_t minCapacity, bool keepPayloads) :
+                mask(0), head(0), count(0), lastPushed(0), payloads(keepPayloads) {
+                uint32_t capacity = 16;
+                while(capacity < minCapacity) {
+                    capacity <<= 1;
+                }
+
+                resize(capacity);
+        }
+
+        ~ArielEventRing() {
+                while(!empty()) {
+                    pop();
+                }
+        }
+
+        bool empty() const { return 0 == count; }
+        uint32_t size() const { return count; }
+
+        ArielQueuedEvent& front() { return entries[head]; }
+
+        // Payload of the front entry, ARIEL_MAX_PAYLOAD_SIZE bytes, NULL unless payloads are kept
+        uint8_t* frontPayload() {
+                return payloads ? &payloadData[(size_t) head * ARIEL_MAX_PAYLOAD_SIZE] : NULL;
+        }
+
+        ArielQueuedEvent& push(ArielEventType type) {
+                if(count == entries.size()) {
+                    resize((uint32_t) entries.size() * 2);
+                }
+
+                lastPushed = (head + count) & mask;
+                count++;
+
+                ArielQueuedEvent& entry = entries[lastPushed];
+                entry.type = type;
+                return entry;
+        }
+
+        // Keep up to ARIEL_MAX_PAYLOAD_SIZE bytes for the entry pushed last, the rest reads as zero
+        void setPayload(const uint8_t* data, uint32_t length) {
+                if(!payloads) {
+                    return;
+                }
+
+                uint8_t* dest = &payloadData[(size_t) lastPushed * ARIEL_MAX_PAYLOAD_SIZE];
+                const uint32_t keep = (NULL == data) ? 0 : (length < ARIEL_MAX_PAYLOAD_SIZE ? length : ARIEL_MAX_PAYLOAD_SIZE);
+
+                if(keep > 0) {
+                    memcpy(dest, data, keep);
+                }
+                memset(&dest[keep], 0, ARIEL_MAX_PAYLOAD_SIZE - keep);
+        }
+
+        void pop() {
+                ArielQueuedEvent& entry = entries[head];
+
+                if(isBoxed(entry.type)) {
+                    delete entry.boxed;
+                    entry.boxed = NULL;
+                }
+
+                head = (head + 1) & mask;
+                count--;
+        }
+
+        static bool isBoxed(ArielEventType type) {
+                return MALLOC == type || MMAP == type || RTL == type
+#ifdef HAVE_CUDA
+                    || GPU == type
+#endif
+                    ;
+        }
+
+    private:
+        void resize(uint32_t capacity) {
+                std::vector<ArielQueuedEvent> newEntries(capacity);
+                std::vector<uint8_t> newPayloads(payloads ? (size_t) capacity * ARIEL_MAX_PAYLOAD_SIZE : 0);
+
+                for(uint32_t i = 0; i < count; i++) {
+                    const uint32_t from = (head + i) & mask;
+                    newEntries[i] = entries[from];
+
+                    if(payloads) {
+                        memcpy(&newPayloads[(size_t) i * ARIEL_MAX_PAYLOAD_SIZE],
+                            &payloadData[(size_t) from * ARIEL_MAX_PAYLOAD_SIZE], ARIEL_MAX_PAYLOAD_SIZE);
+                    }
+                }
+
+                entries.swap(newEntries);
+                payloadData.swap(newPayloads);
+                mask = capacity - 1;
+                head = 0;
+                lastPushed = (count > 0) ? count - 1 : 0;
+        }
+
+        std::vector<ArielQueuedEvent> entries;
+        std::vector<uint8_t> payloadData;
+        uint32_t mask;
+        uint32_t head;
+        uint32_t count;
+        uint32_t lastPushed;
+        const bool payloads;
+
+};
+
+}
+}
+
+#endif
@@ -53,6 +53,18 @@ public:
     virtual GpuReturnTunnel* getReturnTunnel() { return nullptr; }
 #endif
 
+    /** Called by a core that found its tunnel buffer and event queue empty. Frontends that
+     * produce commands on demand (e.g., trace replay) write the next commands
+     * for the core and return true, at most the tunnel buffer size minus one
+     * may be written so the write never blocks. cycle is the core's current
+     * cycle, a frontend may hold back commands due later. Live frontends
+     * return false. */
+    virtual bool refill(uint32_t core, uint64_t cycle) { return false; }
+
+    /** True if the addresses in this frontend's commands are already physical
+     * and must not be translated by the memory manager again. */
+    virtual bool physicalAddresses() const { return false; }
+
     virtual void init(unsigned int phase) = 0;
     virtual void setup() { }
     virtual void finish() { }
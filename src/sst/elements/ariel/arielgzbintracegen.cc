@@ -24,8 +24,11 @@ ArielCompressedBinaryTraceGenerator::ArielCompressedBinaryTraceGenerator(Params&
 
     tracePrefix = params.find<std::string>("trace_prefix", "ariel-core");
     coreID = 0;
+    replay = params.find<bool>("replay", false);
 
-    buffer = (char*) malloc(sizeof(uint64_t) + sizeof(uint64_t) + sizeof(char) + sizeof(uint32_t));
+    // large enough for an allocation record in a replay trace
+    buffer = (char*) malloc(sizeof(uint64_t) + sizeof(uint64_t) + sizeof(char) + sizeof(uint32_t) +
+        sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint64_t));
 }
 
 ArielCompressedBinaryTraceGenerator::~ArielCompressedBinaryTraceGenerator() {
@@ -48,6 +51,32 @@ void ArielCompressedBinaryTraceGenerator::publishEntry(const uint64_t picoS,
     gzwrite(traceFile, buffer, sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t));
 }
 
+// Replay traces use the same record layout with the virtual address,
+// allocations are followed by the 64-bit length, the level and the malloc id
+void ArielCompressedBinaryTraceGenerator::publishEvent(const uint64_t picoS, const ArielTraceEvent& ev) {
+    if(!replay) {
+        ArielTraceGenerator::publishEvent(picoS, ev);
+        return;
+    }
+
+    const char op_type = getTraceOperationCode(ev.op);
+    const uint32_t reqLength = (TRACE_ALLOCATE == ev.op) ? 0 : (uint32_t) ev.length;
+    size_t length = 0;
+
+    copy(&buffer[length], &picoS, sizeof(uint64_t));        length += sizeof(uint64_t);
+    copy(&buffer[length], &op_type, sizeof(char));          length += sizeof(char);
+    copy(&buffer[length], &ev.virtAddr, sizeof(uint64_t));  length += sizeof(uint64_t);
+    copy(&buffer[length], &reqLength, sizeof(uint32_t));    length += sizeof(uint32_t);
+
+    if(TRACE_ALLOCATE == ev.op) {
+        copy(&buffer[length], &ev.length, sizeof(uint64_t));    length += sizeof(uint64_t);
+        copy(&buffer[length], &ev.level, sizeof(uint32_t));     length += sizeof(uint32_t);
+        copy(&buffer[length], &ev.mallocID, sizeof(uint64_t));  length += sizeof(uint64_t);
+    }
+
+    gzwrite(traceFile, buffer, length);
+}
+
 void ArielCompressedBinaryTraceGenerator::setCoreID(const uint32_t core) {
     coreID = core;
 
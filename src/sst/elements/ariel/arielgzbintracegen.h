@@ -33,7 +33,8 @@ class ArielCompressedBinaryTraceGenerator : public ArielTraceGenerator {
     SST_ELI_REGISTER_MODULE_DERIVED(SST::ArielComponent::ArielCompressedBinaryTraceGenerator, "ariel", "CompressedBinaryTraceGenerator",
                 SST_ELI_ELEMENT_VERSION(1,0,0), "Provides tracing to compressed file capabilities", SST::ArielComponent::ArielTraceGenerator)
 
-        SST_ELI_DOCUMENT_PARAMS( { "trace_prefix", "Sets the prefix for the trace file", "ariel-core-" } )
+        SST_ELI_DOCUMENT_PARAMS( { "trace_prefix", "Sets the prefix for the trace file", "ariel-core-" },
+                { "replay", "Record virtual addresses and allocation, free, fence and flush events so the trace can drive the replay frontend (ariel.frontend.replay)", "0" } )
 
         ArielCompressedBinaryTraceGenerator(Params& params);
 
@@ -44,12 +45,15 @@ class ArielCompressedBinaryTraceGenerator : public ArielTraceGenerator {
 
         void setCoreID(const uint32_t core);
 
+        void publishEvent(const uint64_t picoS, const ArielTraceEvent& ev);
+
     private:
         void copy(char* dest, const void* src, const size_t length);
 
         gzFile traceFile;
         std::string tracePrefix;
         uint32_t coreID;
+        bool replay;
         char* buffer;
 
 };
@@ -21,6 +21,7 @@
 #include <sst/core/output.h>
 
 #include <stdint.h>
+#include <atomic>
 #include <vector>
 #include <deque>
 
@@ -30,6 +31,13 @@ namespace SST {
 
 namespace ArielComponent {
 
+/** A page whose contents move from one physical frame to another */
+struct ArielPageMigration {
+    uint64_t from;
+    uint64_t to;
+    uint64_t bytes;
+};
+
 class ArielMemoryManager : public SubComponent {
 
     public:
@@ -37,7 +45,7 @@ class ArielMemoryManager : public SubComponent {
 
         enum class InterruptAction { STALL, UNSTALL };
 
-        ArielMemoryManager(ComponentId_t id, Params& params) : SubComponent(id) {
+        ArielMemoryManager(ComponentId_t id, Params& params) : SubComponent(id), translationEpoch(0) {
             int verbosity = params.find<int>("verbose", 0);
             output = new SST::Output("ArielMemoryManager[@f:@l:@p] ",
                 verbosity, 0, SST::Output::STDOUT);
@@ -57,6 +65,38 @@ class ArielMemoryManager : public SubComponent {
         /** Return the physical address for the request virtual address */
         virtual uint64_t translateAddress(uint64_t virtAddr) = 0;
 
+        /**
+         * Translate and report the size of the page virtAddr lies in, so the
+         * caller may cache the translation of the whole page until the
+         * translation epoch changes. Managers that cannot promise that report 0.
+         */
+        virtual uint64_t translatePage(uint64_t virtAddr, uint64_t& pageBytes) {
+            pageBytes = 0;
+            return translateAddress(virtAddr);
+        }
+
+        /** Advanced whenever a mapping reported by translatePage is removed or changed */
+        uint64_t getTranslationEpoch() const {
+            return translationEpoch.load(std::memory_order_acquire);
+        }
+
+        /**
+         * Move the page migrations queued since the last call to migrations.
+         * The caller copies each page and flushes its old lines, then hands
+         * the old frame back with releaseFrame.
+         */
+        void takeMigrations(std::vector<ArielPageMigration>& migrations) {
+            migrations.insert(migrations.end(), pendingMigrations.begin(), pendingMigrations.end());
+            pendingMigrations.clear();
+        }
+
+        bool hasMigrations() const {
+            return !pendingMigrations.empty();
+        }
+
+        /** The frame a migration moved a page away from may be reused */
+        virtual void releaseFrame(uint64_t frame) { }
+
         //Virtual Function to get Page info for RTL handle
         virtual void get_page_info(std::unordered_map<uint64_t, uint64_t>*, std::deque<uint64_t>*, uint64_t&) { }
 
@@ -118,9 +158,27 @@ class ArielMemoryManager : public SubComponent {
         }
 
     protected:
+        /** Invalidate every translation handed out by translatePage */
+        void shootdownTranslations() {
+            translationEpoch.fetch_add(1, std::memory_order_release);
+        }
+
+        /** Queue the copy of a page that now lives in another frame, see takeMigrations */
+        void migratePage(uint64_t from, uint64_t to, uint64_t bytes) {
+            ArielPageMigration migration;
+            migration.from = from;
+            migration.to = to;
+            migration.bytes = bytes;
+            pendingMigrations.push_back(migration);
+        }
+
         Output* output;
 
         std::vector<InterruptHandlerBase*> interruptHandler;
+
+    private:
+        std::atomic<uint64_t> translationEpoch;
+        std::vector<ArielPageMigration> pendingMigrations;
 };
 
 }
@@ -0,0 +1,327 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <stdio.h>
+
+#include <algorithm>
+
+#include "arielmemmgr_radix.h"
+
+using namespace SST::ArielComponent;
+
+ArielMemoryManagerRadix::ArielMemoryManagerRadix(ComponentId_t id, Params& params) :
+            ArielMemoryManagerCache(id, params), frameRandomizer(11, 201010101) {
+
+    std::string policy = params.find<std::string>("hugepage_policy", "none");
+    std::string hugeSize = params.find<std::string>("hugepage_size", "2MB");
+    promoteThreshold = params.find<uint32_t>("promote_threshold", ENTRIES);
+
+    if (policy == "none" || policy == "NONE") {
+        hugePolicy = HUGEPAGE_NONE;
+    } else if (policy == "always" || policy == "ALWAYS") {
+        hugePolicy = HUGEPAGE_ALWAYS;
+    } else if (policy == "promote" || policy == "PROMOTE") {
+        hugePolicy = HUGEPAGE_PROMOTE;
+    } else {
+        output->fatal(CALL_INFO, -8, "Ariel memory manager - unknown huge page policy \"%s\"\n", policy.c_str());
+    }
+
+    if (hugeSize == "2MB" || hugeSize == "2MiB") {
+        maxLeafLevel = 1;
+    } else if (hugeSize == "1GB" || hugeSize == "1GiB") {
+        maxLeafLevel = 2;
+    } else {
+        output->fatal(CALL_INFO, -8, "Ariel memory manager - hugepage_size must be 2MB or 1GB, found \"%s\"\n", hugeSize.c_str());
+    }
+
+    // Only the always policy maps huge pages on first touch
+    if (hugePolicy != HUGEPAGE_ALWAYS) {
+        maxLeafLevel = 0;
+    }
+
+    if (0 == promoteThreshold || promoteThreshold > ENTRIES) {
+        output->fatal(CALL_INFO, -8, "Ariel memory manager - promote_threshold must be between 1 and %" PRIu32 "\n", ENTRIES);
+    }
+
+    statHugeAllocs2M = registerStatistic<uint64_t>("huge_page_allocs_2mb");
+    statHugeAllocs1G = registerStatistic<uint64_t>("huge_page_allocs_1gb");
+    statPromotions   = registerStatistic<uint64_t>("huge_page_promotions");
+
+    for (uint32_t i = 0; i < LEVELS - 1; i++) {
+        mappedPages[i] = 0;
+    }
+
+    // Carve physical memory into the largest frames that fit, smaller ones are split off on demand
+    uint64_t pageCount = (uint64_t) params.find<uint64_t>("pagecount0", 131072);
+    output->verbose(CALL_INFO, 2, 0, "Physical memory is %" PRIu64 " 4KB frames, huge page policy is %s\n", pageCount, policy.c_str());
+
+    uint64_t nextFrame = 0;
+    for (int32_t level = LEVELS - 2; level >= 0; level--) {
+        const uint64_t framePages = 1ULL << (INDEX_BITS * level);
+        const uint64_t frames = pageCount / framePages;
+
+        addFrames(level, nextFrame, frames);
+        nextFrame += frames << levelShift(level);
+        pageCount -= frames * framePages;
+    }
+
+    table.assign(ENTRIES, 0);
+    nodeUsed.assign(1, 0);
+
+    std::string popFilePath = params.find<std::string>("page_populate_0", "");
+    if (popFilePath != "") {
+        output->verbose(CALL_INFO, 1, 0, "Populating page table from %s...\n", popFilePath.c_str());
+
+        FILE* popFile = fopen(popFilePath.c_str(), "rt");
+        if (NULL == popFile) {
+            output->fatal(CALL_INFO, -1, "Unable to open page populate file %s\n", popFilePath.c_str());
+        }
+
+        uint64_t pinAddr = 0;
+        while (1 == fscanf(popFile, "%" SCNu64, &pinAddr)) {
+            if (pinAddr % (1ULL << PAGE_SHIFT) > 0) {
+                output->fatal(CALL_INFO, -1, "Attempted to pin address %" PRIu64 " but address is not 4KB page aligned\n", pinAddr);
+            }
+
+            uint64_t physAddr, pageBytes;
+            if (!walk(pinAddr, physAddr, pageBytes)) {
+                map(pinAddr);
+            }
+        }
+
+        fclose(popFile);
+    }
+}
+
+ArielMemoryManagerRadix::~ArielMemoryManagerRadix() {
+}
+
+void ArielMemoryManagerRadix::addFrames(uint32_t level, uint64_t start, uint64_t count) {
+    if (0 == count) {
+        return;
+    }
+
+    std::vector<uint64_t>& pool = freeFrames[level];
+    const size_t first = pool.size();
+
+    // Frames are popped from the back, push them high to low so the lowest goes first
+    for (uint64_t i = count; i > 0; i--) {
+        pool.push_back(start + ((i - 1) << levelShift(level)));
+    }
+
+    if (mapPolicy == ArielPageMappingPolicy::RANDOMIZED) {
+        for (size_t i = pool.size() - 1; i > first; i--) {
+            const size_t j = first + (size_t) (frameRandomizer.generateNextUInt64() % (i - first + 1));
+            const uint64_t tmp = pool[i];
+            pool[i] = pool[j];
+            pool[j] = tmp;
+        }
+    }
+}
+
+bool ArielMemoryManagerRadix::allocateFrame(uint32_t level, uint64_t& frame) {
+    if (freeFrames[level].empty()) {
+        uint64_t parent;
+
+        if (level + 1 >= LEVELS - 1 || !allocateFrame(level + 1, parent)) {
+            return false;
+        }
+
+        addFrames(level, parent, ENTRIES);
+    }
+
+    frame = freeFrames[level].back();
+    freeFrames[level].pop_back();
+    return true;
+}
+
+uint32_t ArielMemoryManagerRadix::allocateNode() {
+    if (!freeNodes.empty()) {
+        const uint32_t node = freeNodes.back();
+        freeNodes.pop_back();
+        return node;
+    }
+
+    const uint32_t node = (uint32_t) nodeUsed.size();
+    table.resize(table.size() + ENTRIES, 0);
+    nodeUsed.push_back(0);
+    return node;
+}
+
+void ArielMemoryManagerRadix::releaseNode(uint32_t node) {
+    std::fill(table.begin() + ((size_t) node * ENTRIES), table.begin() + ((size_t) (node + 1) * ENTRIES), 0);
+    nodeUsed[node] = 0;
+    freeNodes.push_back(node);
+}
+
+bool ArielMemoryManagerRadix::walk(uint64_t virtAddr, uint64_t& physAddr, uint64_t& pageBytes) {
+    uint32_t node = 0;
+
+    for (int32_t level = LEVELS - 1; level >= 0; level--) {
+        const uint64_t entry = table[((size_t) node * ENTRIES) + levelIndex(virtAddr, level)];
+
+        if (0 == (entry & ENTRY_PRESENT)) {
+            return false;
+        }
+
+        if (entry & ENTRY_LEAF) {
+            pageBytes = 1ULL << levelShift(level);
+            physAddr = (entry & ~ENTRY_FLAGS) + (virtAddr & (pageBytes - 1));
+            return true;
+        }
+
+        node = (uint32_t) (entry >> PAGE_SHIFT);
+    }
+
+    return false;
+}
+
+void ArielMemoryManagerRadix::map(uint64_t virtAddr) {
+    uint32_t node = 0;
+    size_t parentSlot = 0;
+
+    // Slots are indices, allocateNode may move the table
+    for (int32_t level = LEVELS - 1; level >= 0; level--) {
+        const size_t slot = ((size_t) node * ENTRIES) + levelIndex(virtAddr, level);
+
+        if (table[slot] & ENTRY_PRESENT) {
+            node = (uint32_t) (table[slot] >> PAGE_SHIFT);
+            parentSlot = slot;
+            continue;
+        }
+
+        uint64_t frame;
+        if (level > 0 && level <= (int32_t) maxLeafLevel && allocateFrame(level, frame)) {
+            table[slot] = frame | ENTRY_PRESENT | ENTRY_LEAF;
+            nodeUsed[node]++;
+            mappedPages[level]++;
+            statPageAllocationCount->addData(1);
+            (2 == level ? statHugeAllocs1G : statHugeAllocs2M)->addData(1);
+
+            output->verbose(CALL_INFO, 4, 0, "Mapped %s page, virtual=%" PRIu64 " physical=%" PRIu64 "\n",
+                    2 == level ? "1GB" : "2MB", virtAddr & ~((1ULL << levelShift(level)) - 1), frame);
+            return;
+        }
+
+        if (0 == level) {
+            if (!allocateFrame(0, frame)) {
+                output->fatal(CALL_INFO, -1, "Unable to map virtual address %" PRIu64 ", out of free pages\n", virtAddr);
+            }
+
+            table[slot] = frame | ENTRY_PRESENT | ENTRY_LEAF;
+            nodeUsed[node]++;
+            mappedPages[0]++;
+            statPageAllocationCount->addData(1);
+
+            output->verbose(CALL_INFO, 4, 0, "Mapped 4KB page, virtual=%" PRIu64 " physical=%" PRIu64 "\n",
+                    virtAddr & ~((1ULL << PAGE_SHIFT) - 1), frame);
+
+            if (hugePolicy == HUGEPAGE_PROMOTE && nodeUsed[node] >= promoteThreshold) {
+                promote(node, parentSlot);
+            }
+            return;
+        }
+
+        const uint32_t child = allocateNode();
+        table[slot] = (((uint64_t) child) << PAGE_SHIFT) | ENTRY_PRESENT;
+        nodeUsed[node]++;
+        parentSlot = slot;
+        node = child;
+    }
+}
+
+void ArielMemoryManagerRadix::promote(uint32_t node, size_t parentSlot) {
+    uint64_t frame;
+
+    // Without a free 2MB frame the region stays in 4KB pages, as THP would
+    if (!allocateFrame(1, frame)) {
+        return;
+    }
+
+    // The touched pages are copied into the huge frame, as khugepaged would. Their
+    // old frames are reused only once the copy has flushed their lines.
+    const size_t base = (size_t) node * ENTRIES;
+    for (uint32_t i = 0; i < ENTRIES; i++) {
+        if (table[base + i] & ENTRY_PRESENT) {
+            migratePage(table[base + i] & ~ENTRY_FLAGS, frame + (((uint64_t) i) << PAGE_SHIFT), 1ULL << PAGE_SHIFT);
+            mappedPages[0]--;
+        }
+    }
+
+    table[parentSlot] = frame | ENTRY_PRESENT | ENTRY_LEAF;
+    mappedPages[1]++;
+    releaseNode(node);
+
+    statPromotions->addData(1);
+    statTranslationShootdown->addData(1);
+
+    // The 4KB translations cores have cached are stale now
+    shootdownTranslations();
+
+    output->verbose(CALL_INFO, 4, 0, "Promoted a 2MB region to a huge page at physical=%" PRIu64 "\n", frame);
+}
+
+void ArielMemoryManagerRadix::releaseFrame(uint64_t frame) {
+    freeFrames[0].push_back(frame);
+}
+
+uint64_t ArielMemoryManagerRadix::translatePage(uint64_t virtAddr, uint64_t& pageBytes) {
+    if ( ! translationEnabled ) {
+        pageBytes = 0;
+        return virtAddr;
+    }
+
+    statTranslationQueries->addData(1);
+
+    if ((virtAddr >> levelShift(LEVELS)) != 0) {
+        output->fatal(CALL_INFO, -1, "Virtual address %" PRIx64 " does not fit the 48-bit radix page table\n", virtAddr);
+    }
+
+    uint64_t physAddr = 0;
+    if (!walk(virtAddr, physAddr, pageBytes)) {
+        map(virtAddr);
+        walk(virtAddr, physAddr, pageBytes);
+    }
+
+    return physAddr;
+}
+
+uint64_t ArielMemoryManagerRadix::translateAddress(uint64_t virtAddr) {
+    uint64_t pageBytes;
+    return translatePage(virtAddr, pageBytes);
+}
+
+void ArielMemoryManagerRadix::printStats() {
+    output->output("\n");
+    output->output("Ariel Memory Management Statistics:\n");
+    output->output("---------------------------------------------------------------------\n");
+    output->output("Page Table Sizes:\n");
+
+    output->output("- Table nodes         %" PRIu32 " (%" PRIu64 " bytes)\n",
+        (uint32_t) (nodeUsed.size() - freeNodes.size()), (uint64_t) (table.size() * sizeof(uint64_t)));
+    output->output("- 4KB pages           %" PRIu64 "\n", mappedPages[0]);
+    output->output("- 2MB pages           %" PRIu64 "\n", mappedPages[1]);
+    output->output("- 1GB pages           %" PRIu64 "\n", mappedPages[2]);
+
+    output->output("Page Table Coverages:\n");
+
+    uint64_t coverage = 0;
+    for (uint32_t i = 0; i < LEVELS - 1; i++) {
+        coverage += mappedPages[i] << levelShift(i);
+    }
+
+    output->output("- Bytes               %" PRIu64 "\n", coverage);
+}
@@ -0,0 +1,122 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ARIEL_MEM_MANAGER_RADIX
+#define _H_ARIEL_MEM_MANAGER_RADIX
+
+#include <sst/core/output.h>
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "arielmemmgr_cache.h"
+
+using namespace SST;
+
+namespace SST {
+namespace ArielComponent {
+
+enum ArielHugePagePolicy {
+    HUGEPAGE_NONE,      // 4KB pages only
+    HUGEPAGE_ALWAYS,    // map the largest allowed page on first touch
+    HUGEPAGE_PROMOTE    // map 4KB pages, promote a 2MB region once enough of it is touched
+};
+
+/**
+ * Allocate-on-first-touch memory manager that keeps an x86-64 style four
+ * level radix page table (9 bits per level over a 48-bit virtual address)
+ * and can map 4KB, 2MB and 1GB pages. Table nodes live in one flat array
+ * and physical frames come from per-size free stacks, larger frames being
+ * split on demand. Translations are reported page-at-a-time so cores can
+ * cache them (see translation_tlb_entries on the CPU).
+ */
+class ArielMemoryManagerRadix : public ArielMemoryManagerCache {
+
+    public:
+        /* SST ELI */
+        SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(ArielMemoryManagerRadix, "ariel", "MemoryManagerRadix", SST_ELI_ELEMENT_VERSION(1,0,0),
+                "Allocate-on-first touch memory manager with a radix page table and 2MB/1GB page support", SST::ArielComponent::ArielMemoryManager)
+
+#define MEMMGR_RADIX_ELI_PARAMS ARIEL_ELI_MEMMGR_CACHE_PARAMS,\
+            {"pagecount0", "Physical memory size, in 4KB frames", "131072"},\
+            {"page_populate_0", "Pre-populate/partially pre-populate the page table with 4KB pages, this is the file to read in.", ""},\
+            {"hugepage_policy", "How huge pages are used [none|always|promote]. always maps the largest allowed page on first touch, promote maps 4KB pages and promotes a 2MB region to a huge page once promote_threshold of its pages are touched", "none"},\
+            {"hugepage_size", "Largest page the always policy may map [2MB|1GB]", "2MB"},\
+            {"promote_threshold", "Touched 4KB pages (of 512) after which a 2MB region is promoted. The touched pages are copied into the huge frame by the core that triggered the promotion", "512"}
+
+#define MEMMGR_RADIX_ELI_STATS ARIEL_ELI_MEMMGR_CACHE_STATS,\
+            { "huge_page_allocs_2mb", "Number of 2MB pages mapped", "pages", 2 },\
+            { "huge_page_allocs_1gb", "Number of 1GB pages mapped", "pages", 2 },\
+            { "huge_page_promotions", "Number of 2MB regions promoted from 4KB pages", "promotions", 2 }
+
+        SST_ELI_DOCUMENT_PARAMS( MEMMGR_RADIX_ELI_PARAMS )
+        SST_ELI_DOCUMENT_STATISTICS( MEMMGR_RADIX_ELI_STATS )
+
+        /* ArielMemoryManagerRadix */
+        ArielMemoryManagerRadix(ComponentId_t id, Params& params);
+        ~ArielMemoryManagerRadix();
+
+        uint64_t translateAddress(uint64_t virtAddr);
+        uint64_t translatePage(uint64_t virtAddr, uint64_t& pageBytes);
+        void releaseFrame(uint64_t frame);
+        void printStats();
+
+    private:
+        static const uint32_t LEVELS = 4;
+        static const uint32_t INDEX_BITS = 9;
+        static const uint32_t ENTRIES = 1 << INDEX_BITS;
+        static const uint32_t PAGE_SHIFT = 12;
+        static const uint64_t ENTRY_PRESENT = 0x1;
+        static const uint64_t ENTRY_LEAF = 0x2;
+        static const uint64_t ENTRY_FLAGS = (1 << PAGE_SHIFT) - 1;
+
+        // Page size mapped by a leaf at each level, level 0 holds 4KB pages
+        static uint32_t levelShift(uint32_t level) { return PAGE_SHIFT + (INDEX_BITS * level); }
+        static uint32_t levelIndex(uint64_t virtAddr, uint32_t level) { return (uint32_t) ((virtAddr >> levelShift(level)) & (ENTRIES - 1)); }
+
+        bool walk(uint64_t virtAddr, uint64_t& physAddr, uint64_t& pageBytes);
+        void map(uint64_t virtAddr);
+        uint32_t allocateNode();
+        void releaseNode(uint32_t node);
+        bool allocateFrame(uint32_t level, uint64_t& frame);
+        void promote(uint32_t node, size_t parentSlot);
+        void addFrames(uint32_t level, uint64_t start, uint64_t count);
+
+        ArielHugePagePolicy hugePolicy;
+        uint32_t maxLeafLevel;
+        uint32_t promoteThreshold;
+
+        // Table nodes, ENTRIES words each, node 0 is the root
+        std::vector<uint64_t> table;
+        std::vector<uint16_t> nodeUsed;
+        std::vector<uint32_t> freeNodes;
+
+        // Free physical frames per level, popped from the back
+        std::vector<uint64_t> freeFrames[LEVELS - 1];
+        MarsagliaRNG frameRandomizer;
+
+        uint64_t mappedPages[LEVELS - 1];
+
+        Statistic<uint64_t>* statHugeAllocs2M;
+        Statistic<uint64_t>* statHugeAllocs1G;
+        Statistic<uint64_t>* statPromotions;
+};
+
+}
+}
+
+#endif
@@ -149,6 +149,12 @@ uint64_t ArielMemoryManagerSimple::translateAddress(uint64_t virtAddr) {
     }
 }
 
+// Pages are never unmapped so a translation holds for the whole page for good
+uint64_t ArielMemoryManagerSimple::translatePage(uint64_t virtAddr, uint64_t& pageBytes) {
+    pageBytes = translationEnabled ? pageSize : 0;
+    return translateAddress(virtAddr);
+}
+
 void ArielMemoryManagerSimple::printStats() {
     output->output("\n");
     output->output("Ariel Memory Management Statistics:\n");
@@ -51,6 +51,7 @@ class ArielMemoryManagerSimple : public ArielMemoryManagerCache {
         ~ArielMemoryManagerSimple();
 
         uint64_t translateAddress(uint64_t virtAddr);
+        uint64_t translatePage(uint64_t virtAddr, uint64_t& pageBytes);
         void printStats();
         void get_page_info(std::unordered_map<uint64_t, uint64_t>*, std::deque<uint64_t>*, uint64_t&); 
 
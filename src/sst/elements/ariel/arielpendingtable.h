@@ -0,0 +1,151 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_ARIEL_PENDING_TABLE
+#define _H_SST_ARIEL_PENDING_TABLE
+
+#include <stdint.h>
+#include <vector>
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Outstanding memory requests of a core. Requests occupy slots of a dense
+ * table, slot numbers are recycled through a free list, and a small open
+ * addressed index maps the request ID of a response back to its slot. The
+ * table is sized for maxtranscore and only grows when a split access or
+ * flush pushes the core past it.
+ */
+template<typename IdType>
+class ArielPendingTable {
+
+    public:
+        ArielPendingTable(uint32_t capacity) : live(0) {
+                grow(capacity > 0 ? capacity : 1);
+        }
+
+        uint32_t size() const { return live; }
+        bool empty() const { return 0 == live; }
+
+        void insert(IdType id) {
+                if(freeSlots.empty()) {
+                    grow((uint32_t) slots.size() * 2);
+                }
+
+                const uint32_t slot = freeSlots.back();
+                freeSlots.pop_back();
+
+                slots[slot] = id;
+                live++;
+
+                uint32_t pos = hash(id);
+                while(EMPTY != index[pos]) {
+                    pos = (pos + 1) & indexMask;
+                }
+                index[pos] = slot;
+        }
+
+        // Returns false if the ID is not pending
+        bool remove(IdType id) {
+                uint32_t pos = hash(id);
+
+                while(EMPTY != index[pos] && slots[index[pos]] != id) {
+                    pos = (pos + 1) & indexMask;
+                }
+
+                if(EMPTY == index[pos]) {
+                    return false;
+                }
+
+                freeSlots.push_back(index[pos]);
+                live--;
+
+                // backward shift deletion keeps every probe chain unbroken without tombstones
+                uint32_t hole = pos;
+                uint32_t next = (pos + 1) & indexMask;
+
+                while(EMPTY != index[next]) {
+                    const uint32_t home = hash(slots[index[next]]);
+
+                    if(((next - home) & indexMask) >= ((next - hole) & indexMask)) {
+                        index[hole] = index[next];
+                        hole = next;
+                    }
+
+                    next = (next + 1) & indexMask;
+                }
+
+                index[hole] = EMPTY;
+                return true;
+        }
+
+    private:
+        static const uint32_t EMPTY = 0xFFFFFFFF;
+
+        uint32_t hash(IdType id) const {
+                uint64_t key = (uint64_t) id;
+                key ^= key >> 33;
+                key *= 0xff51afd7ed558ccdULL;
+                key ^= key >> 33;
+                return (uint32_t) key & indexMask;
+        }
+
+        void grow(uint32_t capacity) {
+                const uint32_t oldCapacity = (uint32_t) slots.size();
+                slots.resize(capacity);
+
+                for(uint32_t i = capacity; i > oldCapacity; i--) {
+                    freeSlots.push_back(i - 1);
+                }
+                freeSlots.reserve(capacity);
+
+                // at most half full
+                uint32_t indexSize = 16;
+                while(indexSize < capacity * 2) {
+                    indexSize <<= 1;
+                }
+
+                std::vector<uint32_t> used;
+                for(uint32_t i = 0; i < index.size(); i++) {
+                    if(EMPTY != index[i]) {
+                        used.push_back(index[i]);
+                    }
+                }
+
+                index.assign(indexSize, (uint32_t) EMPTY);
+                indexMask = indexSize - 1;
+
+                for(uint32_t i = 0; i < used.size(); i++) {
+                    uint32_t pos = hash(slots[used[i]]);
+                    while(EMPTY != index[pos]) {
+                        pos = (pos + 1) & indexMask;
+                    }
+                    index[pos] = used[i];
+                }
+        }
+
+        std::vector<IdType> slots;
+        std::vector<uint32_t> freeSlots;
+        std::vector<uint32_t> index;
+        uint32_t indexMask;
+        uint32_t live;
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,271 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ARIEL_SHARED
+#define _H_ARIEL_SHARED
+
+#include <sst/core/event.h>
+#include <sst/core/link.h>
+
+#include <stdint.h>
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+class ArielMemoryManager;
+class ArielFrontend;
+
+/**
+ * State an ArielCPU shares with the ArielCorePartition components that
+ * simulate some of its cores. Partitions may run on other threads of the same
+ * rank, so the frontend must only be used while holding lock. The tunnel is a
+ * set of single-producer single-consumer buffers, one per core, and needs no
+ * lock. Partition cores never call the memory manager, they send their
+ * requests to the owner over the partition link (see ArielPartitionEvent).
+ */
+class ArielSharedContext {
+    public:
+        ArielSharedContext(ArielTunnel* tunnel, ArielMemoryManager* memmgr, ArielFrontend* frontend,
+                uint32_t coreCount, uint32_t maxCoreQueueLen, uint64_t cacheLineSize) :
+            tunnel(tunnel), memmgr(memmgr), frontend(frontend), coreCount(coreCount),
+            maxCoreQueueLen(maxCoreQueueLen), cacheLineSize(cacheLineSize), owned(coreCount, false) { }
+
+        /** Take ownership of cores [first, first + count), fails if any is out of range or already owned */
+        bool claim(uint32_t first, uint32_t count) {
+            std::lock_guard<std::mutex> guard(lock);
+
+            if(first >= coreCount || count > coreCount - first) {
+                return false;
+            }
+
+            for(uint32_t i = first; i < first + count; ++i) {
+                if(owned[i]) {
+                    return false;
+                }
+            }
+
+            for(uint32_t i = first; i < first + count; ++i) {
+                owned[i] = true;
+            }
+
+            return true;
+        }
+
+        /** Returns the first core nobody has claimed, or the core count if all are owned */
+        uint32_t firstUnclaimed() {
+            std::lock_guard<std::mutex> guard(lock);
+
+            for(uint32_t i = 0; i < coreCount; ++i) {
+                if(!owned[i]) {
+                    return i;
+                }
+            }
+
+            return coreCount;
+        }
+
+        /** Make a context visible to partitions under the name of the ArielCPU that owns it */
+        static void publish(const std::string& name, ArielSharedContext* context) {
+            std::lock_guard<std::mutex> guard(registryLock());
+            registry()[name] = context;
+        }
+
+        static void withdraw(const std::string& name) {
+            std::lock_guard<std::mutex> guard(registryLock());
+            registry().erase(name);
+        }
+
+        static ArielSharedContext* find(const std::string& name) {
+            std::lock_guard<std::mutex> guard(registryLock());
+            std::map<std::string, ArielSharedContext*>::iterator entry = registry().find(name);
+            return (entry == registry().end()) ? NULL : entry->second;
+        }
+
+        ArielTunnel* const tunnel;
+        ArielMemoryManager* const memmgr;
+        ArielFrontend* const frontend;
+        const uint32_t coreCount;
+        const uint32_t maxCoreQueueLen;
+        const uint64_t cacheLineSize;
+        std::mutex lock;
+
+    private:
+        static std::map<std::string, ArielSharedContext*>& registry() {
+            static std::map<std::string, ArielSharedContext*> contexts;
+            return contexts;
+        }
+
+        static std::mutex& registryLock() {
+            static std::mutex registryMutex;
+            return registryMutex;
+        }
+
+        std::vector<bool> owned;
+};
+
+/**
+ * Memory manager work passed between an ArielCPU and its partitions over the
+ * partition link. The owner performs requests in its own clock, ordered by
+ * arrival time and core, so first-touch allocation does not depend on how
+ * the threads happen to run.
+ */
+class ArielPartitionEvent : public SST::Event {
+    public:
+        enum Type {
+            HALT,               // partition -> owner, a core has halted
+            TRANSLATE,          // partition -> owner, map the page holding virtAddr
+            TRANSLATED,         // owner -> partition, virtAddr's page is [virtBase, virtBase + bytes) at physBase
+            FLUSH_TRANSLATIONS, // owner -> partition, a mapping has changed, forget every translation
+            MALLOC,             // partition -> owner, memory manager calls made on behalf of a core
+            MMAP,
+            FREE,
+            SWITCH_POOL
+        };
+
+        ArielPartitionEvent() : Event(), type(HALT), core(0), virtAddr(0), virtBase(0), physBase(0),
+            bytes(0), level(0), instPtr(0), file(0) { }
+
+        ArielPartitionEvent(Type type, uint32_t core, uint64_t virtAddr = 0) : Event(), type(type), core(core),
+            virtAddr(virtAddr), virtBase(0), physBase(0), bytes(0), level(0), instPtr(0), file(0) { }
+
+        Type getType() const { return (Type) type; }
+
+        uint32_t type;
+        uint32_t core;
+        uint64_t virtAddr;
+        uint64_t virtBase;
+        uint64_t physBase;
+        uint64_t bytes;
+        uint32_t level;
+        uint64_t instPtr;
+        uint32_t file;
+
+        void serialize_order(SST::Core::Serialization::serializer &ser) override {
+            Event::serialize_order(ser);
+            ser & type;
+            ser & core;
+            ser & virtAddr;
+            ser & virtBase;
+            ser & physBase;
+            ser & bytes;
+            ser & level;
+            ser & instPtr;
+            ser & file;
+        }
+
+        ImplementSerializable(SST::ArielComponent::ArielPartitionEvent);
+};
+
+/**
+ * The translations a partition has been given by its owner, used by all of
+ * the partition's cores on the partition's thread. A core whose access is
+ * not covered asks the owner and retries once the answer has arrived. The
+ * cores' other memory manager calls are sent to the owner through send().
+ */
+class ArielPartitionTranslations {
+    public:
+        ArielPartitionTranslations() : link(NULL), lineSize(64) { }
+
+        void configure(SST::Link* ownerLink, uint64_t cacheLineSize) {
+            link = ownerLink;
+            lineSize = cacheLineSize;
+        }
+
+        bool lookup(uint64_t virtAddr, uint64_t& physAddr) const {
+            std::map<uint64_t, Mapping>::const_iterator page = pages.upper_bound(virtAddr);
+
+            if(page == pages.begin()) {
+                return false;
+            }
+
+            --page;
+            if(virtAddr - page->first >= page->second.bytes) {
+                return false;
+            }
+
+            physAddr = page->second.physBase + (virtAddr - page->first);
+            return true;
+        }
+
+        /** Ask the owner for the page holding virtAddr, one request per line until it is answered */
+        void request(uint32_t core, uint64_t virtAddr) {
+            const uint64_t line = virtAddr - (virtAddr % lineSize);
+
+            if(requested.insert(line).second) {
+                link->send(new ArielPartitionEvent(ArielPartitionEvent::TRANSLATE, core, line));
+            }
+        }
+
+        void send(ArielPartitionEvent* ev) {
+            link->send(ev);
+        }
+
+        /** Apply a TRANSLATED or FLUSH_TRANSLATIONS answer from the owner */
+        void update(const ArielPartitionEvent* ev) {
+            if(ArielPartitionEvent::FLUSH_TRANSLATIONS == ev->getType()) {
+                pages.clear();
+                return;
+            }
+
+            Mapping& mapping = pages[ev->virtBase];
+            mapping.physBase = ev->physBase;
+            mapping.bytes = ev->bytes;
+            requested.erase(ev->virtAddr);
+        }
+
+    private:
+        struct Mapping {
+            uint64_t physBase;
+            uint64_t bytes;
+        };
+
+        SST::Link* link;
+        uint64_t lineSize;
+        std::map<uint64_t, Mapping> pages;
+        std::set<uint64_t> requested;
+};
+
+/** Holds the shared lock, if there is one, for the lifetime of the guard */
+class ArielSharedGuard {
+    public:
+        explicit ArielSharedGuard(std::mutex* lock) : lock(lock) {
+            if(NULL != lock) {
+                lock->lock();
+            }
+        }
+
+        ~ArielSharedGuard() {
+            if(NULL != lock) {
+                lock->unlock();
+            }
+        }
+
+    private:
+        std::mutex* lock;
+};
+
+}
+}
+
+#endif
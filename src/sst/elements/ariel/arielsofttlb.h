@@ -0,0 +1,118 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ARIEL_SOFT_TLB
+#define _H_ARIEL_SOFT_TLB
+
+#include <stdint.h>
+#include <vector>
+
+namespace SST {
+namespace ArielComponent {
+
+/**
+ * Direct-mapped cache of whole-page translations kept by each core in front
+ * of the memory manager. This only speeds up the simulator, it is not a
+ * timing model. Pages smaller than 2MB are indexed by their 4KB virtual page
+ * number, larger ones by their 2MB number in a second array, so a huge page
+ * does not evict the small pages around it.
+ */
+class ArielSoftTLB {
+    public:
+        ArielSoftTLB() : mask(0) { }
+
+        /** Entries per array, rounded up to a power of two, 0 disables the TLB */
+        void configure(uint32_t entries) {
+            uint32_t capacity = 0;
+
+            if(entries > 0) {
+                capacity = 1;
+                while(capacity < entries) {
+                    capacity <<= 1;
+                }
+            }
+
+            Entry invalid;
+            invalid.virtBase = 0;
+            invalid.physBase = 0;
+            invalid.offsetMask = 0;
+            invalid.valid = false;
+
+            small.assign(capacity, invalid);
+            huge.assign(capacity, invalid);
+            mask = (capacity > 0) ? capacity - 1 : 0;
+        }
+
+        bool enabled() const {
+            return !small.empty();
+        }
+
+        bool lookup(uint64_t virtAddr, uint64_t& physAddr) const {
+            const Entry& s = small[(virtAddr >> SMALL_SHIFT) & mask];
+            if(s.valid && (virtAddr & ~s.offsetMask) == s.virtBase) {
+                physAddr = s.physBase + (virtAddr & s.offsetMask);
+                return true;
+            }
+
+            const Entry& h = huge[(virtAddr >> HUGE_SHIFT) & mask];
+            if(h.valid && (virtAddr & ~h.offsetMask) == h.virtBase) {
+                physAddr = h.physBase + (virtAddr & h.offsetMask);
+                return true;
+            }
+
+            return false;
+        }
+
+        /** Cache the page holding virtAddr, pages that are not a power of two in size are not cached */
+        void insert(uint64_t virtAddr, uint64_t physAddr, uint64_t pageBytes) {
+            if(0 == pageBytes || 0 != (pageBytes & (pageBytes - 1))) {
+                return;
+            }
+
+            Entry& e = (pageBytes < (1ULL << HUGE_SHIFT)) ? small[(virtAddr >> SMALL_SHIFT) & mask] : huge[(virtAddr >> HUGE_SHIFT) & mask];
+            e.offsetMask = pageBytes - 1;
+            e.virtBase = virtAddr & ~e.offsetMask;
+            e.physBase = physAddr - (virtAddr & e.offsetMask);
+            e.valid = true;
+        }
+
+        void flush() {
+            for(size_t i = 0; i < small.size(); i++) {
+                small[i].valid = false;
+                huge[i].valid = false;
+            }
+        }
+
+    private:
+        static const uint32_t SMALL_SHIFT = 12;
+        static const uint32_t HUGE_SHIFT = 21;
+
+        struct Entry {
+            uint64_t virtBase;
+            uint64_t physBase;
+            uint64_t offsetMask;
+            bool valid;
+        };
+
+        std::vector<Entry> small;
+        std::vector<Entry> huge;
+        uint64_t mask;
+};
+
+}
+}
+
+#endif
@@ -24,6 +24,7 @@ ArielTextTraceGenerator::ArielTextTraceGenerator(Params& params) :
 
     tracePrefix = params.find<std::string>("trace_prefix", "ariel-core");
     coreID = 0;
+    replay = params.find<bool>("replay", false);
 }
 
 ArielTextTraceGenerator::~ArielTextTraceGenerator() {
@@ -41,6 +42,23 @@ void ArielTextTraceGenerator::publishEntry(const uint64_t picoS,
             reqLength);
 }
 
+// Replay traces use the same "<cycle> <op> <address> <length>" lines with the
+// virtual address, allocations append "<level> <malloc id>"
+void ArielTextTraceGenerator::publishEvent(const uint64_t picoS, const ArielTraceEvent& ev) {
+    if(!replay) {
+        ArielTraceGenerator::publishEvent(picoS, ev);
+        return;
+    }
+
+    if(TRACE_ALLOCATE == ev.op) {
+        fprintf(textFile, "%" PRIu64 " %c %" PRIu64 " %" PRIu64 " %" PRIu32 " %" PRIu64 "\n",
+                picoS, getTraceOperationCode(ev.op), ev.virtAddr, ev.length, ev.level, ev.mallocID);
+    } else {
+        fprintf(textFile, "%" PRIu64 " %c %" PRIu64 " %" PRIu64 "\n",
+                picoS, getTraceOperationCode(ev.op), ev.virtAddr, ev.length);
+    }
+}
+
 void ArielTextTraceGenerator::setCoreID(const uint32_t core) {
     coreID = core;
 
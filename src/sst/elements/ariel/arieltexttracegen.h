@@ -32,7 +32,8 @@ class ArielTextTraceGenerator : public ArielTraceGenerator {
         SST_ELI_REGISTER_MODULE_DERIVED(ArielTextTraceGenerator, "ariel", "TextTraceGenerator", SST_ELI_ELEMENT_VERSION(1,0,0),
                 "Provides tracing to text file capabilities", SST::ArielComponent::ArielTraceGenerator)
 
-        SST_ELI_DOCUMENT_PARAMS( { "trace_prefix", "Sets the prefix for the trace file", "ariel-core-" } )
+        SST_ELI_DOCUMENT_PARAMS( { "trace_prefix", "Sets the prefix for the trace file", "ariel-core-" },
+                { "replay", "Record virtual addresses and allocation, free, fence and flush events so the trace can drive the replay frontend (ariel.frontend.replay)", "0" } )
 
         ArielTextTraceGenerator(Params& params);
 
@@ -43,10 +44,13 @@ class ArielTextTraceGenerator : public ArielTraceGenerator {
 
         void setCoreID(const uint32_t core);
 
+        void publishEvent(const uint64_t picoS, const ArielTraceEvent& ev);
+
     private:
         FILE* textFile;
         std::string tracePrefix;
         uint32_t coreID;
+        bool replay;
 
 };
 
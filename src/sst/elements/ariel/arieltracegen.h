@@ -19,14 +19,54 @@
 
 #include <sst/core/module.h>
 
+#include <stdint.h>
+
 namespace SST {
 namespace ArielComponent {
 
 typedef enum {
     READ,
-    WRITE
+    WRITE,
+    TRACE_ALLOCATE,
+    TRACE_FREE,
+    TRACE_FENCE,
+    TRACE_FLUSH
 } ArielTraceEntryOperation;
 
+/* Operation codes as they appear in trace files */
+inline char getTraceOperationCode(const ArielTraceEntryOperation op) {
+    switch(op) {
+        case READ:           return 'R';
+        case WRITE:          return 'W';
+        case TRACE_ALLOCATE: return 'A';
+        case TRACE_FREE:     return 'F';
+        case TRACE_FENCE:    return 'N';
+        case TRACE_FLUSH:    return 'L';
+        default:             return '?';
+    }
+}
+
+inline bool getTraceOperation(const char code, ArielTraceEntryOperation& op) {
+    switch(code) {
+        case 'R': op = READ;           return true;
+        case 'W': op = WRITE;          return true;
+        case 'A': op = TRACE_ALLOCATE; return true;
+        case 'F': op = TRACE_FREE;     return true;
+        case 'N': op = TRACE_FENCE;    return true;
+        case 'L': op = TRACE_FLUSH;    return true;
+        default:  return false;
+    }
+}
+
+struct ArielTraceEvent {
+    ArielTraceEntryOperation op;
+    uint64_t virtAddr;
+    uint64_t physAddr;
+    uint64_t length;
+    uint32_t level;     // allocations only
+    uint64_t mallocID;  // allocations only, the call site the memory manager attributes it to
+};
+
 class ArielTraceGenerator : public Module {
 
     public:
@@ -41,6 +81,15 @@ class ArielTraceGenerator : public Module {
                 const ArielTraceEntryOperation op) = 0;
         virtual void setCoreID(uint32_t coreID) = 0;
 
+        /** Every event the core processes. Generators that can record a
+         * trace for the replay frontend override this, the default keeps
+         * only the memory accesses, by physical address. */
+        virtual void publishEvent(const uint64_t picoS, const ArielTraceEvent& ev) {
+            if(READ == ev.op || WRITE == ev.op) {
+                publishEntry(picoS, ev.physAddr, (uint32_t) ev.length, ev.op);
+            }
+        }
+
 };
 
 }
@@ -52,6 +52,7 @@
 
 #include <sst/core/interprocess/mmapchild_pin3.h>
 #include "ariel_shmem.h"
+#include "ariel_l1filter.h"
 #include "ariel_inst_class.h"
 
 #undef __STDC_FORMAT_MACROS
@@ -74,6 +75,11 @@ KNOB<UINT32> InterceptMemAllocations(KNOB_MODE_WRITEONCE, "pintool", "m", "1", "
 KNOB<string> UseMallocMap           (KNOB_MODE_WRITEONCE, "pintool", "u", "",  "Should intercept ariel_malloc_flag() and interpret using a malloc map: specify filename or leave blank for disabled");
 KNOB<UINT32> KeepMallocStackTrace   (KNOB_MODE_WRITEONCE, "pintool", "k", "1", "Should keep shadow stack and dump on malloc calls. 1 = enabled, 0 = disabled");
 KNOB<UINT32> DefaultMemoryPool      (KNOB_MODE_WRITEONCE, "pintool", "d", "0", "Default Ariel Memory Pool");
+KNOB<UINT32> BatchCommands          (KNOB_MODE_WRITEONCE, "pintool", "b", "0", "Pack instruction and memory commands into batched tunnel messages (0 = classic, one message per command, 1 = batched)");
+KNOB<UINT64> FilterL1Size           (KNOB_MODE_WRITEONCE, "pintool", "l", "0", "Size in bytes of the per-thread L1 tag model used to filter hits out of the stream (0 = disabled, forward every access)");
+KNOB<UINT32> FilterL1Assoc          (KNOB_MODE_WRITEONCE, "pintool", "a", "8", "Associativity of the L1 filter");
+KNOB<UINT32> FilterL1LineSize       (KNOB_MODE_WRITEONCE, "pintool", "n", "64", "Line size in bytes of the L1 filter");
+KNOB<UINT32> FilterL1Summary        (KNOB_MODE_WRITEONCE, "pintool", "H", "1024", "Maximum number of filtered hits held back before a hit summary is sent");
 // GPGPUSim
 KNOB<string> SSTNamedPipe2          (KNOB_MODE_WRITEONCE, "pintool", "g", "",  "Named pipe to connect to SST simulator");
 KNOB<string> SSTNamedPipe3          (KNOB_MODE_WRITEONCE, "pintool", "x", "",  "Named pipe to connect to SST simulator");
@@ -93,6 +99,25 @@ ArielTunnel *tunnel = NULL;
 bool enable_output;
 PIN_LOCK mainLock;
 
+// Per-thread command batches, each is only touched by its own thread. The
+// trailing line of padding keeps two threads' encoders from sharing a cache
+// line whatever alignment the vector's storage has.
+typedef struct {
+    ArielBatchEncoder encoder;
+    char pad[64];
+} ArielBatchThread;
+bool batchCommands;
+std::vector<ArielBatchThread> batchThreads;
+
+// Approximate L1 filtering, only misses and first writes to clean lines are forwarded,
+// the hits in between are sent as a count. Per-thread like the batches.
+typedef struct {
+    ArielL1FilterThread filter;
+    char pad[64];       // see ArielBatchThread
+} ArielFilterThread;
+bool filterL1;
+std::vector<ArielFilterThread> filterThreads;
+
 // Instrumentation control
 UINT32 instrument_instructions;
 bool writeTrace;
@@ -283,16 +308,108 @@ VOID InstrumentTrace (TRACE trace, VOID* args)
 /******************** END SHADOW STACK **************************/
 /****************************************************************/
 
+VOID FlushCommandBatch(UINT32 thr)
+{
+    if(batchCommands && thr < core_count) {
+        ArielCommand ac;
+        while(!batchThreads[thr].encoder.empty()) {
+            batchThreads[thr].encoder.fill(ac);
+            tunnel->writeMessage(thr, ac);
+        }
+    }
+}
+
+/* Returns false if the record must be sent as a classic command */
+bool WriteBatchRecord(UINT32 thr, ArielBatchRecord_t type, ADDRINT ip, uint64_t addr, UINT32 size, const uint8_t* payload);
+
+VOID SendFilteredHits(UINT32 thr, uint64_t hits)
+{
+    if(WriteBatchRecord(thr, ARIEL_BATCH_FILTERED_HITS, 0, 0, (UINT32) hits, NULL)) {
+        return;
+    }
+
+    ArielCommand ac;
+    ac.command = ARIEL_FILTERED_HITS;
+    ac.instPtr = (uint64_t) 0;
+    ac.filtered.hits = hits;
+
+    FlushCommandBatch(thr);
+    tunnel->writeMessage(thr, ac);
+}
+
+/* Hits are summarised between instructions, never inside a forwarded one */
+VOID FlushFilteredHits(UINT32 thr)
+{
+    if(!filterL1 || thr >= core_count) {
+        return;
+    }
+
+    const uint64_t hits = filterThreads[thr].filter.takeHits();
+    if(hits > 0) {
+        SendFilteredHits(thr, hits);
+    }
+}
+
+/* Every classic command sends the thread's pending hits and batch first to keep the stream in order */
+VOID WriteCommand(UINT32 thr, ArielCommand& ac)
+{
+    FlushFilteredHits(thr);
+    FlushCommandBatch(thr);
+    tunnel->writeMessage(thr, ac);
+}
+
+bool WriteBatchRecord(UINT32 thr, ArielBatchRecord_t type, ADDRINT ip, uint64_t addr, UINT32 size, const uint8_t* payload)
+{
+    if(!batchCommands) {
+        return false;
+    }
+
+    if(batchThreads[thr].encoder.encode(type, (uint64_t) ip, addr, size, payload)) {
+        return true;
+    }
+
+    FlushCommandBatch(thr);
+    return batchThreads[thr].encoder.encode(type, (uint64_t) ip, addr, size, payload);
+}
+
+/* A thread about to block in the kernel must not hold back records the simulator is waiting on */
+VOID FlushOnSyscall(THREADID thr, CONTEXT* ctxt, SYSCALL_STANDARD std, VOID* v)
+{
+    FlushFilteredHits(thr);
+    FlushCommandBatch(thr);
+}
+
+VOID FlushOnThreadFini(THREADID thr, const CONTEXT* ctxt, INT32 code, VOID* v)
+{
+    FlushFilteredHits(thr);
+    FlushCommandBatch(thr);
+}
+
 VOID Fini(INT32 code, VOID* v)
 {
     if(SSTVerbosity.Value() > 0) {
         std::cout << "SSTARIEL: Execution completed, shutting down." << std::endl;
     }
 
+    for(UINT32 i = 1; i < core_count; i++) {
+        FlushFilteredHits(i);
+        FlushCommandBatch(i);
+    }
+
+    if(filterL1 && SSTVerbosity.Value() > 0) {
+        for(UINT32 i = 0; i < core_count; i++) {
+            const ArielL1Filter& l1 = filterThreads[i].filter.getL1();
+            if(l1.getAccesses() > 0) {
+                printf("SSTARIEL: Thread %" PRIu32 " L1 filter: %" PRIu64 " accesses, %" PRIu64 " misses forwarded (%.2f%%), %" PRIu64 " writebacks\n",
+                    i, l1.getAccesses(), l1.getMisses(), (100.0 * l1.getMisses()) / l1.getAccesses(), l1.getWritebacks());
+            }
+        }
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_PERFORM_EXIT;
     ac.instPtr = (uint64_t) 0;
-    tunnel->writeMessage(0, ac);
+    WriteCommand(0, ac);
 
     delete tunnelmgr;
 #ifdef HAVE_CUDA
@@ -340,7 +457,7 @@ VOID WriteFlushInstructionMarker(UINT32 thr, ADDRINT ip, ADDRINT vaddr)
     ac.instPtr = (uint64_t) ip;
     ac.flushline.vaddr = (uint32_t) vaddr;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteFenceInstructionMarker(UINT32 thr, ADDRINT ip)
@@ -349,7 +466,7 @@ VOID WriteFenceInstructionMarker(UINT32 thr, ADDRINT ip)
     ac.command = ARIEL_FENCE_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRINT ip,
@@ -358,6 +475,10 @@ VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRI
 
     const uint64_t addr64 = (uint64_t) address;
 
+    if(WriteBatchRecord(thr, ARIEL_BATCH_READ, ip, addr64, readSize, NULL)) {
+        return;
+    }
+
     ArielCommand ac;
 
     ac.command = ARIEL_PERFORM_READ;
@@ -367,7 +488,7 @@ VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRI
     ac.inst.instClass = instClass;
     ac.inst.simdElemCount = simdOpWidth;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADDRINT ip,
@@ -375,6 +496,19 @@ VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADD
 {
 
     const uint64_t addr64 = (uint64_t) address;
+
+    if(batchCommands) {
+        if( writeTrace ) {
+            uint8_t payload[ARIEL_MAX_PAYLOAD_SIZE];
+            PIN_SafeCopy( &payload[0], address, ARIEL_MIN( writeSize, (UINT32) ARIEL_MAX_PAYLOAD_SIZE ) );
+            if(WriteBatchRecord(thr, ARIEL_BATCH_WRITE_PAYLOAD, ip, addr64, writeSize, payload)) {
+                return;
+            }
+        } else if(WriteBatchRecord(thr, ARIEL_BATCH_WRITE, ip, addr64, writeSize, NULL)) {
+            return;
+        }
+    }
+
     ArielCommand ac;
 
     ac.command = ARIEL_PERFORM_WRITE;
@@ -399,23 +533,52 @@ VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADD
     }
     printf("\n");
 */
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteStartInstructionMarker(UINT32 thr, ADDRINT ip)
 {
+    if(WriteBatchRecord(thr, ARIEL_BATCH_START_INSTRUCTION, ip, 0, 0, NULL)) {
+        return;
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_START_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteEndInstructionMarker(UINT32 thr, ADDRINT ip)
 {
+    if(WriteBatchRecord(thr, ARIEL_BATCH_END_INSTRUCTION, ip, 0, 0, NULL)) {
+        return;
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_END_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
+}
+
+/* Filtered mode, what the thread's L1 filter forwards for one instruction goes out as usual */
+struct ArielFilterSink {
+    UINT32 thr;
+    ADDRINT ip;
+    UINT32 instClass;
+    UINT32 simdOpWidth;
+
+    void startInstruction() { WriteStartInstructionMarker(thr, ip); }
+    void read(uint64_t addr, uint32_t size) { WriteInstructionRead((ADDRINT*) addr, size, thr, ip, instClass, simdOpWidth); }
+    void write(uint64_t addr, uint32_t size) { WriteInstructionWrite((ADDRINT*) addr, size, thr, ip, instClass, simdOpWidth); }
+    void endInstruction() { WriteEndInstructionMarker(thr, ip); }
+    void hits(uint64_t count) { SendFilteredHits(thr, count); }
+};
+
+VOID FilterInstructionAccess(UINT32 thr, ADDRINT* address, UINT32 size, bool write, ADDRINT ip,
+            UINT32 instClass, UINT32 simdOpWidth, BOOL last)
+{
+    ArielFilterSink sink = { thr, ip, instClass, simdOpWidth };
+    filterThreads[thr].filter.access(sink, (uint64_t) address, size, write, last);
 }
 
 VOID WriteInstructionReadWrite(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
@@ -425,6 +588,12 @@ VOID WriteInstructionReadWrite(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
 
     if(enable_output) {
         if(thr < core_count) {
+            if(filterL1) {
+                FilterInstructionAccess(thr, readAddr, readSize, false, ip, instClass, simdOpWidth, false);
+                FilterInstructionAccess(thr, writeAddr, writeSize, true, ip, instClass, simdOpWidth, true);
+                return;
+            }
+
             WriteStartInstructionMarker( thr, ip );
             WriteInstructionRead(  readAddr,  readSize,  thr, ip, instClass, simdOpWidth );
             WriteInstructionWrite( writeAddr, writeSize, thr, ip, instClass, simdOpWidth );
@@ -439,6 +608,11 @@ VOID WriteInstructionReadOnly(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
 
     if(enable_output) {
         if(thr < core_count) {
+            if(filterL1) {
+                FilterInstructionAccess(thr, readAddr, readSize, false, ip, instClass, simdOpWidth, last);
+                return;
+            }
+
             if (first)
                 WriteStartInstructionMarker(thr, ip);
             WriteInstructionRead(  readAddr,  readSize,  thr, ip, instClass, simdOpWidth );
@@ -453,10 +627,14 @@ VOID WriteNoOp(THREADID thr, ADDRINT ip)
 {
     if(enable_output) {
         if(thr < core_count) {
+            if(WriteBatchRecord(thr, ARIEL_BATCH_NOOP, ip, 0, 0, NULL)) {
+                return;
+            }
+
             ArielCommand ac;
             ac.command = ARIEL_NOOP;
             ac.instPtr = (uint64_t) ip;
-            tunnel->writeMessage(thr, ac);
+            WriteCommand(thr, ac);
         }
     }
 }
@@ -467,6 +645,11 @@ VOID WriteInstructionWriteOnly(THREADID thr, ADDRINT* writeAddr, UINT32 writeSiz
 
     if(enable_output) {
         if(thr < core_count) {
+            if(filterL1) {
+                FilterInstructionAccess(thr, writeAddr, writeSize, true, ip, instClass, simdOpWidth, last);
+                return;
+            }
+
             if (first)
                 WriteStartInstructionMarker(thr, ip);
             WriteInstructionWrite(writeAddr, writeSize,  thr, ip, instClass, simdOpWidth);
@@ -753,7 +936,7 @@ void mapped_ariel_output_stats()
     ArielCommand ac;
     ac.command = ARIEL_OUTPUT_STATS;
     ac.instPtr = (uint64_t) 0;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 // same effect as mapped_ariel_output_stats(), but it also sends a user-defined reference number back
@@ -763,7 +946,7 @@ void mapped_ariel_output_stats_buoy(uint64_t marker)
     ArielCommand ac;
     ac.command = ARIEL_OUTPUT_STATS;
     ac.instPtr = (uint64_t) marker; //user the instruction pointer slot to send the marker number
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 void mapped_ariel_flushline(void *virtualAddress)
@@ -817,7 +1000,7 @@ int ariel_mlm_memcpy(void* dest, void* source, size_t size) {
     ac.dma_start.dest = ariel_dest;
     ac.dma_start.len = length;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "Done with ariel memcpy.\n");
@@ -845,7 +1028,7 @@ void ariel_mlm_set_pool(int new_pool)
     ArielCommand ac;
     ac.command = ARIEL_SWITCH_POOL;
     ac.switchPool.pool = newDefaultPool;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     // Keep track of the default pool
     default_pool = (UINT32) new_pool;
@@ -897,7 +1080,7 @@ void* ariel_mmap_mlm(int fileID, size_t size, int level)
     std::cout<<"File ID at FESIMPLE IS : "<<ac.mlm_mmap.fileID<<std::endl;
     std::cout<<"After ******"<<std::endl;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "%u: Ariel mmap_mlm call allocates data at address: 0x%llx\n",
@@ -952,7 +1135,7 @@ void* ariel_mlm_malloc(size_t size, int level) {
         ac.mlm_map.alloc_level = allocationLevel;
     }
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "%u: Ariel mlm_malloc call allocates data at address: 0x%llx\n",
@@ -997,7 +1180,7 @@ void ariel_mlm_free(void* ptr)
         ArielCommand ac;
         ac.command = ARIEL_ISSUE_TLM_FREE;
         ac.mlm_free.vaddr = virtAddr;
-        tunnel->writeMessage(thr, ac);
+        WriteCommand(thr, ac);
 
     } else {
         fprintf(stderr, "ARIEL: Call to free in Ariel did not find a matching local allocation, this memory will be leaked.\n");
@@ -1049,14 +1232,14 @@ VOID ariel_postmalloc_instrument(ADDRINT allocLocation)
                 if (toFast[thr].count == 0) {
                     toFast[thr].valid = false;
                 }
-                tunnel->writeMessage(thr, ac);
+                WriteCommand(thr, ac);
             }
         } else if (shouldOverride) {
             ac.mlm_map.alloc_level = overridePool;
-            tunnel->writeMessage(thr, ac);
+            WriteCommand(thr, ac);
         } else if (InterceptMemAllocations.Value()) {
             ac.mlm_map.alloc_level = allocationLevel;
-            tunnel->writeMessage(thr, ac);
+            WriteCommand(thr, ac);
         }
 
         /*printf("ARIEL: Created a malloc of size: %" PRIu64 " in Ariel\n",
@@ -1083,7 +1266,7 @@ __host__ cudaError_t CUDARTAPI cudaMalloc(void **devPtr, size_t size){
     ac.API.name = GPU_MALLOC;
     ac.API.CA.cuda_malloc.dev_ptr = devPtr;
     ac.API.CA.cuda_malloc.size = size;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail = false;
@@ -1113,7 +1296,7 @@ void** CUDARTAPI __cudaRegisterFatBinary(void *fatCubin) {
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_REG_FAT_BINARY;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1154,7 +1337,7 @@ void CUDARTAPI __cudaRegisterFunction(
     ac.API.CA.register_function.fat_cubin_handle = (unsigned)(unsigned long long)fatCubinHandle;
     ac.API.CA.register_function.host_fun = reinterpret_cast<uint64_t>(hostFun);
     strncpy(ac.API.CA.register_function.device_fun, deviceFun, 512);
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1219,7 +1402,7 @@ __host__ cudaError_t CUDARTAPI cudaMemcpy(void *dst, const void *src, size_t cou
     ac.API.CA.cuda_memcpy.src = (uint64_t) src;
     ac.API.CA.cuda_memcpy.count = count;
     ac.API.CA.cuda_memcpy.kind = final_kind;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     if(final_kind == cudaMemcpyHostToDevice) {
         if(count <= max_page_size){
@@ -1348,7 +1531,7 @@ __host__ cudaError_t CUDARTAPI cudaConfigureCall(dim3 gridDim, dim3 blockDim, si
     ac.API.CA.cfg_call.bdz = blockDim.z;
     ac.API.CA.cfg_call.sharedMem = sharedMem;
     ac.API.CA.cfg_call.stream = stream;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1396,7 +1579,7 @@ __host__ cudaError_t CUDARTAPI cudaSetupArgument(const void *arg, size_t size, s
     ac.API.CA.set_arg.offset = offset;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_SET_ARG;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1421,7 +1604,7 @@ __host__ cudaError_t CUDARTAPI cudaLaunch(const void *func){
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_LAUNCH;
     ac.API.CA.cuda_launch.func = reinterpret_cast<uint64_t>(func);
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1445,7 +1628,7 @@ __host__ cudaError_t CUDARTAPI cudaFree(void *devPtr){
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_FREE;
     ac.API.CA.free_address = (uint64_t)devPtr;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1468,7 +1651,7 @@ __host__ __cudart_builtin__ cudaError_t CUDARTAPI cudaGetLastError(void){
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_GET_LAST_ERROR;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
     GpuCommand gc;
 
     bool avail=false;
@@ -1507,7 +1690,7 @@ void CUDARTAPI __cudaRegisterVar(
     ac.API.CA.register_var.size = size;
     ac.API.CA.register_var.constant = constant;
     ac.API.CA.register_var.global = global;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1543,7 +1726,7 @@ __host__ cudaError_t CUDARTAPI __maxActiveBlock(
     ac.API.CA.max_active_block.blockSize = blockSize;
     ac.API.CA.max_active_block.dynamicSMemSize = dynamicSMemSize;
     ac.API.CA.max_active_block.flags = flags;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1571,7 +1754,7 @@ VOID ariel_postfree_instrument(ADDRINT allocLocation)
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_TLM_FREE;
     ac.mlm_free.vaddr = virtAddr;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 void mapped_ariel_malloc_flag_fortran(int* mallocLocId, int* count, int* level)
@@ -1618,7 +1801,7 @@ void ariel_start_RTL_sim(RTL_shmem_info* rtl_shmem) {
 
     THREADID thr = PIN_ThreadId();
     const uint32_t thrID = (uint32_t) thr;
-    tunnel->writeMessage(thrID, acRtl);
+    WriteCommand(thrID, acRtl);
     #ifdef ARIEL_DEBUG
     fprintf(stderr, "\nMessage to add RTL Event into Ariel Event Queue successfully delivered via ArielTunnel");
     #endif
@@ -1639,7 +1822,7 @@ void ariel_update_RTL_signals(RTL_shmem_info* rtl_shmem) {
 
     THREADID thr = PIN_ThreadId();
     const uint32_t thrID = (uint32_t) thr;
-    tunnel->writeMessage(thrID, acRtl);
+    WriteCommand(thrID, acRtl);
     #ifdef ARIEL_DEBUG
     fprintf(stderr, "\nMessage to add RTL Event into Ariel Event Queue to update RTL signals successfully delivered via ArielTunnel");
     #endif
@@ -1867,6 +2050,8 @@ int main(int argc, char *argv[])
     //PIN_InitSymbolsAlt(IFUNC_SYMBOLS);
     PIN_InitSymbols();
     PIN_AddFiniFunction(Fini, 0);
+    PIN_AddThreadFiniFunction(FlushOnThreadFini, 0);
+    PIN_AddSyscallEntryFunction(FlushOnSyscall, 0);
 
     PIN_InitLock(&mainLock);
     PIN_InitLock(&mallocIndexLock);
@@ -1908,6 +2093,22 @@ int main(int argc, char *argv[])
     core_count = MaxCoreCount.Value();
     instrument_instructions = InstrumentInstructions.Value();
 
+    batchCommands = BatchCommands.Value() > 0;
+    batchThreads.resize(core_count);
+    if(SSTVerbosity.Value() > 0) {
+        printf("SSTARIEL: Tunnel commands are %s\n", batchCommands ? "batched" : "sent one per message (classic)");
+    }
+
+    filterThreads.resize(core_count);
+    for(UINT32 i = 0; i < core_count; i++) {
+        filterThreads[i].filter.configure(FilterL1Size.Value(), FilterL1Assoc.Value(), FilterL1LineSize.Value(), FilterL1Summary.Value());
+    }
+    filterL1 = core_count > 0 && filterThreads[0].filter.enabled();
+    if(filterL1) {
+        printf("SSTARIEL: Approximate mode, filtering hits through a %" PRIu64 " byte, %" PRIu32 "-way L1 with %" PRIu32 " byte lines per thread\n",
+            (uint64_t) FilterL1Size.Value(), FilterL1Assoc.Value(), FilterL1LineSize.Value());
+    }
+
 // Pin version specific tunnel attach
     tunnelmgr = new SST::Core::Interprocess::MMAPChild_Pin3<ArielTunnel>(SSTNamedPipe.Value());
     tunnel = tunnelmgr->getTunnel();
@@ -81,6 +81,23 @@ Pin3Frontend::Pin3Frontend(ComponentId_t id, Params& params, uint32_t cores, uin
     output->verbose(CALL_INFO, 1, 0, "Model specifies that there are %" PRIu32 " application arguments\n", app_argc);
 
     uint32_t pin_startup_mode = (uint32_t) params.find<uint32_t>("arielmode", 2);
+    uint32_t tunnel_batching = (uint32_t) params.find<uint32_t>("tunnelbatching", 0);
+    output->verbose(CALL_INFO, 1, 0, "Tunnel command batching is %s.\n", tunnel_batching > 0 ? "ENABLED" : "DISABLED");
+
+    uint64_t l1filter_size = params.find<uint64_t>("l1filter_size", 0);
+    uint32_t l1filter_assoc = params.find<uint32_t>("l1filter_assoc", 8);
+    uint32_t l1filter_summary = params.find<uint32_t>("l1filter_summary", 1024);
+    uint32_t l1filter_line = params.find<uint32_t>("cachelinesize", 64);
+
+    if(l1filter_size > 0) {
+        if(0 == l1filter_assoc || 0 == l1filter_line || l1filter_size < ((uint64_t) l1filter_assoc * l1filter_line)) {
+            output->fatal(CALL_INFO, -1, "l1filter_size (%" PRIu64 ") must hold at least one set of l1filter_assoc (%" PRIu32 ") lines of %" PRIu32 " bytes\n",
+                l1filter_size, l1filter_assoc, l1filter_line);
+        }
+
+        output->verbose(CALL_INFO, 1, 0, "Approximate L1 filtering is ENABLED, %" PRIu64 " bytes, %" PRIu32 "-way, %" PRIu32 " byte lines, hit summary every %" PRIu32 " hits.\n",
+            l1filter_size, l1filter_assoc, l1filter_line, l1filter_summary);
+    }
     uint32_t intercept_mem_allocations = (uint32_t) params.find<uint32_t>("arielinterceptcalls", 0);
 
     switch(intercept_mem_allocations) {
@@ -125,7 +142,7 @@ Pin3Frontend::Pin3Frontend(ComponentId_t id, Params& params, uint32_t cores, uin
     appLauncher = params.find<std::string>("launcher", PINTOOL_EXECUTABLE);
 
     const uint32_t launch_param_count = (uint32_t) params.find<uint32_t>("launchparamcount", 0);
-    const uint32_t pin_arg_count = 37 + launch_param_count;
+    const uint32_t pin_arg_count = 47 + launch_param_count;
 
     execute_args = (char**) malloc(sizeof(char*) * (pin_arg_count + app_argc));
 
@@ -179,6 +196,21 @@ Pin3Frontend::Pin3Frontend(ComponentId_t id, Params& params, uint32_t cores, uin
         execute_args[arg++] = const_cast<char*>("1");
     }
 
+    execute_args[arg++] = const_cast<char*>("-b");
+    execute_args[arg++] = (char*) malloc(sizeof(char) * 8);
+    sprintf(execute_args[arg-1], "%" PRIu32, tunnel_batching);
+    execute_args[arg++] = const_cast<char*>("-l");
+    execute_args[arg++] = (char*) malloc(sizeof(char) * 24);
+    sprintf(execute_args[arg-1], "%" PRIu64, l1filter_size);
+    execute_args[arg++] = const_cast<char*>("-a");
+    execute_args[arg++] = (char*) malloc(sizeof(char) * 12);
+    sprintf(execute_args[arg-1], "%" PRIu32, l1filter_assoc);
+    execute_args[arg++] = const_cast<char*>("-n");
+    execute_args[arg++] = (char*) malloc(sizeof(char) * 12);
+    sprintf(execute_args[arg-1], "%" PRIu32, l1filter_line);
+    execute_args[arg++] = const_cast<char*>("-H");
+    execute_args[arg++] = (char*) malloc(sizeof(char) * 12);
+    sprintf(execute_args[arg-1], "%" PRIu32, l1filter_summary);
     execute_args[arg++] = const_cast<char*>("-E");
     execute_args[arg++] = (char*) malloc(sizeof(char) * 8);
     sprintf(execute_args[arg-1], "%d", instrument_instructions);
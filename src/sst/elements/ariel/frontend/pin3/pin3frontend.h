@@ -75,6 +75,11 @@ class Pin3Frontend : public ArielFrontend {
         {"mallocmapfile", "File with valid 'ariel_malloc_flag' ids", ""},
         {"tracePrefix", "Prefix when tracing is enable", ""},
         {"writepayloadtrace", "Trace write payloads and put real memory contents into the memory system", "0"},
+        {"tunnelbatching", "Pack instruction and memory commands into delta encoded batches of up to 16 tunnel slots each. 0 keeps the classic one command per slot stream", "0"},
+        {"l1filter_size", "Approximate mode: size in bytes of a per-thread L1 tag model run inside the Pin tool, only its misses and first writes to clean lines are forwarded and hits are sent as periodic counts. Against forwarding every access an attached L1 of the same geometry sees the same misses for streaming and resident data, and for reuse out of LRU order misses about 12% too few (tests/unit/testl1filter). 0 forwards every access", "0"},
+        {"l1filter_assoc", "Associativity of the L1 filter", "8"},
+        {"l1filter_summary", "Maximum number of filtered hits the tool holds back before sending a hit summary", "1024"},
+        {"cachelinesize", "Line size of the attached caching structure, also used as the L1 filter line size", "64"},
         {"instrument_instructions", "turn on or off instruction instrumentation in fesimple", "1"})
 
         /* Ariel class */
@@ -0,0 +1,302 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include "replayfrontend.h"
+
+#include <climits>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace SST::ArielComponent;
+
+ArielReplayFrontend::ArielReplayFrontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t qSize, uint32_t memPool) :
+            ArielFrontend(id, params, cores, qSize, memPool), coreCount(cores), queueLength(qSize), exitSent(false) {
+
+    int verbosity = params.find<int>("verbose", 0);
+    output = new SST::Output("ArielReplayFrontend[@f:@l:@p] ", verbosity, 0, SST::Output::STDOUT);
+
+    std::string tracePrefix = params.find<std::string>("trace_prefix", "ariel-core");
+    std::string traceFormat = params.find<std::string>("trace_format", "text");
+    std::string addressSpace = params.find<std::string>("addresses", "virtual");
+    std::string timing = params.find<std::string>("timing", "timestamps");
+
+    if("text" == traceFormat) {
+        binary = false;
+    } else if("binary" == traceFormat) {
+#ifdef HAVE_LIBZ
+        binary = true;
+#else
+        output->fatal(CALL_INFO, -1, "Binary trace replay requires SST Elements to be configured with zlib\n");
+#endif
+    } else {
+        output->fatal(CALL_INFO, -1, "Unknown trace_format \"%s\", expected text or binary\n", traceFormat.c_str());
+    }
+
+    if("virtual" == addressSpace) {
+        physical = false;
+    } else if("physical" == addressSpace) {
+        physical = true;
+    } else {
+        output->fatal(CALL_INFO, -1, "Unknown addresses \"%s\", expected virtual or physical\n", addressSpace.c_str());
+    }
+
+    if("timestamps" == timing) {
+        timestamps = true;
+    } else if("asap" == timing) {
+        timestamps = false;
+    } else {
+        output->fatal(CALL_INFO, -1, "Unknown timing \"%s\", expected timestamps or asap\n", timing.c_str());
+    }
+
+    // every refill may need a slot for a pending batch and one for a command after it
+    if(queueLength < 4) {
+        output->fatal(CALL_INFO, -1, "Replay requires a core queue (maxcorequeue) of at least 4 entries, found %" PRIu32 "\n", queueLength);
+    }
+
+    // The tunnel is only shared with the cores so it can live in ordinary memory
+    tunnel = new ArielTunnel(coreCount, queueLength);
+    tunnelRegion = calloc(1, tunnel->getTunnelSize());
+    tunnel->initialize(tunnelRegion);
+
+    traces.resize(coreCount);
+
+    char* tracePath = (char*) malloc(sizeof(char) * PATH_MAX);
+
+    for(uint32_t i = 0; i < coreCount; ++i) {
+        CoreTrace& trace = traces[i];
+        trace.textFile = NULL;
+        trace.hasPending = false;
+        trace.records = 0;
+        trace.eof = false;
+        trace.drained = false;
+
+#ifdef HAVE_LIBZ
+        trace.binFile = NULL;
+
+        if(binary) {
+            snprintf(tracePath, PATH_MAX, "%s-%" PRIu32 ".trace.gz", tracePrefix.c_str(), i);
+            trace.binFile = gzopen(tracePath, "rb");
+
+            if(NULL == trace.binFile) {
+                output->fatal(CALL_INFO, -1, "Unable to open trace file %s for core %" PRIu32 "\n", tracePath, i);
+            }
+        } else
+#endif
+        {
+            snprintf(tracePath, PATH_MAX, "%s-%" PRIu32 ".trace", tracePrefix.c_str(), i);
+            trace.textFile = fopen(tracePath, "rt");
+
+            if(NULL == trace.textFile) {
+                output->fatal(CALL_INFO, -1, "Unable to open trace file %s for core %" PRIu32 "\n", tracePath, i);
+            }
+        }
+
+        output->verbose(CALL_INFO, 1, 0, "Core %" PRIu32 " replays %s\n", i, tracePath);
+    }
+
+    free(tracePath);
+}
+
+ArielReplayFrontend::~ArielReplayFrontend() {
+    for(uint32_t i = 0; i < coreCount; ++i) {
+        if(NULL != traces[i].textFile) {
+            fclose(traces[i].textFile);
+        }
+#ifdef HAVE_LIBZ
+        if(NULL != traces[i].binFile) {
+            gzclose(traces[i].binFile);
+        }
+#endif
+    }
+
+    delete tunnel;
+    free(tunnelRegion);
+    delete output;
+}
+
+void ArielReplayFrontend::finish() {
+    for(uint32_t i = 0; i < coreCount; ++i) {
+        output->verbose(CALL_INFO, 1, 0, "Core %" PRIu32 " replayed %" PRIu64 " trace records%s\n", i, traces[i].records,
+                traces[i].eof ? "" : " (trace not finished)");
+    }
+}
+
+bool ArielReplayFrontend::readRecord(uint32_t core, TraceRecord& rec) {
+    CoreTrace& trace = traces[core];
+    char opCode;
+
+    rec.level = 0;
+    rec.mallocID = 0;
+
+#ifdef HAVE_LIBZ
+    if(binary) {
+        char buffer[sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t)];
+        uint32_t reqLength;
+
+        if((int) sizeof(buffer) != gzread(trace.binFile, buffer, sizeof(buffer))) {
+            return false;
+        }
+
+        memcpy(&rec.cycle, &buffer[0], sizeof(uint64_t));
+        memcpy(&opCode, &buffer[sizeof(uint64_t)], sizeof(char));
+        memcpy(&rec.addr, &buffer[sizeof(uint64_t) + sizeof(char)], sizeof(uint64_t));
+        memcpy(&reqLength, &buffer[sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t)], sizeof(uint32_t));
+        rec.length = reqLength;
+
+        if('A' == opCode) {
+            if((int) sizeof(uint64_t) != gzread(trace.binFile, &rec.length, sizeof(uint64_t)) ||
+                (int) sizeof(uint32_t) != gzread(trace.binFile, &rec.level, sizeof(uint32_t)) ||
+                (int) sizeof(uint64_t) != gzread(trace.binFile, &rec.mallocID, sizeof(uint64_t))) {
+                output->fatal(CALL_INFO, -1, "Trace for core %" PRIu32 " is truncated in an allocation record\n", core);
+            }
+        }
+    } else
+#endif
+    {
+        if(4 != fscanf(trace.textFile, "%" SCNu64 " %c %" SCNu64 " %" SCNu64, &rec.cycle, &opCode, &rec.addr, &rec.length)) {
+            return false;
+        }
+
+        if('A' == opCode) {
+            if(2 != fscanf(trace.textFile, "%" SCNu32 " %" SCNu64, &rec.level, &rec.mallocID)) {
+                output->fatal(CALL_INFO, -1, "Trace for core %" PRIu32 " is truncated in an allocation record\n", core);
+            }
+        }
+    }
+
+    if(!getTraceOperation(opCode, rec.op)) {
+        output->fatal(CALL_INFO, -1, "Trace for core %" PRIu32 " has an unknown operation '%c' at record %" PRIu64 "\n",
+                core, opCode, trace.records);
+    }
+
+    trace.records++;
+    return true;
+}
+
+void ArielReplayFrontend::flushBatch(uint32_t core, uint32_t& budget) {
+    ArielCommand ac;
+    while(!traces[core].encoder.empty()) {
+        traces[core].encoder.fill(ac);
+        tunnel->writeMessage(core, ac);
+        budget--;
+    }
+}
+
+void ArielReplayFrontend::writeCommand(uint32_t core, ArielCommand& ac, uint32_t& budget) {
+    flushBatch(core, budget);
+    tunnel->writeMessage(core, ac);
+    budget--;
+}
+
+bool ArielReplayFrontend::refill(uint32_t core, uint64_t cycle) {
+    CoreTrace& trace = traces[core];
+
+    if(exitSent) {
+        return false;
+    }
+
+    // Once every trace has been read and every core has emptied its buffer the
+    // application has finished, as with Pin the exit goes to one core
+    if(trace.eof) {
+        trace.drained = true;
+
+        for(uint32_t i = 0; i < coreCount; ++i) {
+            if(!traces[i].drained) {
+                return false;
+            }
+        }
+
+        ArielCommand ac;
+        ac.command = ARIEL_PERFORM_EXIT;
+        ac.instPtr = 0;
+        tunnel->writeMessage(core, ac);
+        exitSent = true;
+        return true;
+    }
+
+    // The buffer is empty, leave one slot so a write can never block
+    uint32_t budget = queueLength - 1;
+    const uint32_t start = budget;
+
+    // a record grows the pending batch by at most one slot or flushes it and
+    // takes one more, the final flush then always fits the budget
+    while(budget >= trace.encoder.slots() + 3) {
+        TraceRecord rec;
+
+        if(trace.hasPending) {
+            rec = trace.pending;
+            trace.hasPending = false;
+        } else if(!readRecord(core, rec)) {
+            trace.eof = true;
+            break;
+        }
+
+        // Records due later wait here, the core polls again next cycle
+        if(timestamps && rec.cycle > cycle) {
+            trace.pending = rec;
+            trace.hasPending = true;
+            break;
+        }
+
+        ArielCommand ac;
+        ac.instPtr = 0;
+
+        switch(rec.op) {
+            case READ:
+            case WRITE:
+                {
+                    const ArielBatchRecord_t type = (READ == rec.op) ? ARIEL_BATCH_READ : ARIEL_BATCH_WRITE;
+
+                    if(!trace.encoder.encode(type, 0, rec.addr, (uint32_t) rec.length, NULL)) {
+                        flushBatch(core, budget);
+                        trace.encoder.encode(type, 0, rec.addr, (uint32_t) rec.length, NULL);
+                    }
+                }
+                break;
+
+            case TRACE_ALLOCATE:
+                ac.command = ARIEL_ISSUE_TLM_MAP;
+                ac.instPtr = rec.mallocID;
+                ac.mlm_map.vaddr = rec.addr;
+                ac.mlm_map.alloc_len = rec.length;
+                ac.mlm_map.alloc_level = rec.level;
+                writeCommand(core, ac, budget);
+                break;
+
+            case TRACE_FREE:
+                ac.command = ARIEL_ISSUE_TLM_FREE;
+                ac.mlm_free.vaddr = rec.addr;
+                writeCommand(core, ac, budget);
+                break;
+
+            case TRACE_FENCE:
+                ac.command = ARIEL_FENCE_INSTRUCTION;
+                writeCommand(core, ac, budget);
+                break;
+
+            case TRACE_FLUSH:
+                ac.command = ARIEL_FLUSHLINE_INSTRUCTION;
+                ac.flushline.vaddr = rec.addr;
+                writeCommand(core, ac, budget);
+                break;
+        }
+    }
+
+    flushBatch(core, budget);
+
+    return budget != start;
+}
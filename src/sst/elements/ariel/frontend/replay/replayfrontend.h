@@ -0,0 +1,113 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_ARIEL_REPLAY_FRONTEND
+#define _H_ARIEL_REPLAY_FRONTEND
+
+#include <sst/core/output.h>
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#ifdef HAVE_LIBZ
+#include "zlib.h"
+#endif
+
+#include "arielfrontend.h"
+#include "arieltracegen.h"
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/**
+ * Drives the Ariel cores from per-core traces captured by the text or
+ * compressed binary trace generators instead of a live Pin process. Traces
+ * recorded with the generators' "replay" parameter carry virtual addresses
+ * and allocation, free, fence and flush events; older traces only hold
+ * reads and writes by physical address and are replayed with
+ * addresses=physical, which bypasses the memory manager. Commands are
+ * produced on demand when a core drains its tunnel buffer, so the order of
+ * each core's trace is preserved. With timing=timestamps no record is issued
+ * before the cycle it was captured at; a core that runs ahead idles until
+ * then, one that falls behind issues as fast as it can.
+ */
+class ArielReplayFrontend : public ArielFrontend {
+    public:
+
+    /* SST ELI */
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(ArielReplayFrontend, "ariel", "frontend.replay", SST_ELI_ELEMENT_VERSION(1,0,0), "Ariel frontend that replays traces captured by the Ariel trace generators", SST::ArielComponent::ArielFrontend)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},
+        {"trace_prefix", "Prefix of the per-core trace files, <prefix>-<core>.trace (text) or <prefix>-<core>.trace.gz (binary)", "ariel-core"},
+        {"trace_format", "Format of the traces, text or binary (binary requires zlib)", "text"},
+        {"addresses", "Address space of the trace, virtual (translated by the memory manager) or physical (issued unchanged)", "virtual"},
+        {"timing", "timestamps holds each record until the core reaches its captured cycle, asap issues records as fast as the core allows", "timestamps"})
+
+        ArielReplayFrontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t qSize, uint32_t memPool);
+        ~ArielReplayFrontend();
+
+        virtual void init(unsigned int phase) { }
+        virtual void finish();
+        virtual ArielTunnel* getTunnel() { return tunnel; }
+        virtual bool refill(uint32_t core, uint64_t cycle);
+        virtual bool physicalAddresses() const { return physical; }
+
+    private:
+        struct TraceRecord {
+            uint64_t cycle;
+            ArielTraceEntryOperation op;
+            uint64_t addr;
+            uint64_t length;
+            uint32_t level;
+            uint64_t mallocID;
+        };
+
+        struct CoreTrace {
+            FILE* textFile;
+#ifdef HAVE_LIBZ
+            gzFile binFile;
+#endif
+            ArielBatchEncoder encoder;
+            // read but not yet due
+            TraceRecord pending;
+            bool hasPending;
+            uint64_t records;
+            bool eof;
+            bool drained;
+        };
+
+        bool readRecord(uint32_t core, TraceRecord& rec);
+        void writeCommand(uint32_t core, ArielCommand& ac, uint32_t& budget);
+        void flushBatch(uint32_t core, uint32_t& budget);
+
+        Output* output;
+        ArielTunnel* tunnel;
+        void* tunnelRegion;
+        uint32_t coreCount;
+        uint32_t queueLength;
+        bool binary;
+        bool physical;
+        bool timestamps;
+        bool exitSent;
+        std::vector<CoreTrace> traces;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,94 @@
+import sst
+import sys
+
+# Two Ariel cores on two threads: core 0 is simulated by the ariel component
+# and core 1 by an ariel.ArielCorePartition. Both replay a captured trace of
+# virtual addresses, core 1 has its pages mapped by the owner over the
+# partition link.
+#
+#   sst -n 2 partition.py --model-options="<trace prefix> <output prefix>"
+
+sst.setProgramOption("timebase", "1ps")
+sst.setProgramOption("partitioner", "sst.self")
+
+if len(sys.argv) != 3:
+    sys.stderr.write("usage: partition.py <trace prefix> <output prefix>\n")
+    sys.exit(1)
+
+tracePrefix, outputPrefix = sys.argv[1:3]
+
+coreParams = {
+        "verbose" : "0",
+        "maxcorequeue" : "64",
+        "maxissuepercycle" : "2",
+        "clock" : "2GHz",
+        "tracegen" : "ariel.TextTraceGenerator",
+        "tracer.trace_prefix" : outputPrefix,
+}
+
+ariel = sst.Component("a0", "ariel.ariel")
+ariel.addParams(coreParams)
+ariel.addParams({
+        "corecount" : "2",
+        "localcores" : "1",
+        })
+
+frontend = ariel.setSubComponent("frontend", "ariel.frontend.replay")
+frontend.addParams({
+        "trace_prefix" : tracePrefix,
+        "trace_format" : "text",
+        "addresses" : "virtual",
+        })
+
+memmgr = ariel.setSubComponent("memmgr", "ariel.MemoryManagerSimple")
+
+partition = sst.Component("p1", "ariel.ArielCorePartition")
+partition.addParams(coreParams)
+partition.addParams({
+        "cpu" : "a0",
+        "firstcore" : "1",
+        "corecount" : "1",
+        })
+
+owner_link = sst.Link("partition_link_0")
+owner_link.connect( (ariel, "partition_link_0", "1ns"), (partition, "cpu_link", "1ns") )
+
+# Each core gets a private cache and memory to keep the example small
+def memorySystem(core, port, thread):
+    l1cache = sst.Component("l1cache%d" % core, "memHierarchy.Cache")
+    l1cache.addParams({
+            "cache_frequency" : "2 Ghz",
+            "cache_size" : "64 KB",
+            "coherence_protocol" : "MSI",
+            "replacement_policy" : "lru",
+            "associativity" : "8",
+            "access_latency_cycles" : "1",
+            "cache_line_size" : "64",
+            "L1" : "1",
+    })
+
+    memctrl = sst.Component("memory%d" % core, "memHierarchy.MemController")
+    memctrl.addParams({
+            "clock" : "1GHz",
+    })
+
+    memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+    memory.addParams({
+            "access_time" : "10ns",
+            "mem_size" : "2048MiB",
+    })
+
+    cpu_cache_link = sst.Link("cpu_cache_link%d" % core)
+    cpu_cache_link.connect( port, (l1cache, "high_network_0", "50ps") )
+
+    memory_link = sst.Link("mem_bus_link%d" % core)
+    memory_link.connect( (l1cache, "low_network_0", "50ps"), (memctrl, "direct_link", "50ps") )
+
+    l1cache.setRank(0, thread)
+    memctrl.setRank(0, thread)
+
+memorySystem(0, (ariel, "cache_link_0", "50ps"), 0)
+memorySystem(1, (partition, "cache_link_0", "50ps"), 1)
+
+ariel.setRank(0, 0)
+partition.setRank(0, 1)
@@ -0,0 +1,87 @@
+import sst
+import sys
+
+# Replays a captured Ariel trace on one core and records what the core issues:
+#
+#   sst replay.py --model-options="<trace prefix> <output prefix> <addresses> <timing> [memmgr] [key=value ...]"
+#
+# addresses is virtual or physical and timing is timestamps or asap, see
+# the ariel.frontend.replay parameters. memmgr names the memory manager,
+# MemoryManagerSimple by default. key=value pairs starting with "memmgr."
+# go to the memory manager, the others to ariel. The core and memory
+# manager statistics are written to <output prefix>-stats.csv.
+
+sst.setProgramOption("timebase", "1ps")
+
+if len(sys.argv) < 5:
+    sys.stderr.write("usage: replay.py <trace prefix> <output prefix> <addresses> <timing> [memmgr] [key=value ...]\n")
+    sys.exit(1)
+
+tracePrefix, outputPrefix, addresses, timing = sys.argv[1:5]
+memmgrType = sys.argv[5] if len(sys.argv) > 5 else "MemoryManagerSimple"
+
+arielParams = dict()
+memmgrParams = dict()
+for pair in sys.argv[6:]:
+    key, value = pair.split("=", 1)
+    if key.startswith("memmgr."):
+        memmgrParams[key[len("memmgr."):]] = value
+    else:
+        arielParams[key] = value
+
+ariel = sst.Component("a0", "ariel.ariel")
+ariel.addParams({
+        "verbose" : "0",
+        "corecount" : "1",
+        "maxcorequeue" : "64",
+        "maxissuepercycle" : "2",
+        "clock" : "2GHz",
+        "tracegen" : "ariel.TextTraceGenerator",
+        "tracer.trace_prefix" : outputPrefix,
+        })
+ariel.addParams(arielParams)
+
+frontend = ariel.setSubComponent("frontend", "ariel.frontend.replay")
+frontend.addParams({
+        "trace_prefix" : tracePrefix,
+        "trace_format" : "text",
+        "addresses" : addresses,
+        "timing" : timing,
+        })
+
+memmgr = ariel.setSubComponent("memmgr", "ariel." + memmgrType)
+memmgr.addParams(memmgrParams)
+
+l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+l1cache.addParams({
+        "cache_frequency" : "2 Ghz",
+        "cache_size" : "64 KB",
+        "coherence_protocol" : "MSI",
+        "replacement_policy" : "lru",
+        "associativity" : "8",
+        "access_latency_cycles" : "1",
+        "cache_line_size" : "64",
+        "L1" : "1",
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+        "clock" : "1GHz",
+})
+
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+        "access_time" : "10ns",
+        "mem_size" : "2048MiB",
+})
+
+cpu_cache_link = sst.Link("cpu_cache_link")
+cpu_cache_link.connect( (ariel, "cache_link_0", "50ps"), (l1cache, "high_network_0", "50ps") )
+
+memory_link = sst.Link("mem_bus_link")
+memory_link.connect( (l1cache, "low_network_0", "50ps"), (memctrl, "direct_link", "50ps") )
+
+sst.setStatisticLoadLevel(2)
+sst.setStatisticOutput("sst.statOutputCSV", { "filepath" : outputPrefix + "-stats.csv", "separator" : "," })
+ariel.enableAllStatistics()
+memmgr.enableAllStatistics()
@@ -0,0 +1,254 @@
+# -*- coding: utf-8 -*-
+
+from sst_unittest import *
+from sst_unittest_support import *
+import os
+
+################################################################################
+# Replays a captured trace through ariel.frontend.replay, no Pin is needed
+################################################################################
+
+class testcase_ArielReplay(SSTTestCase):
+
+    def setUp(self):
+        super(type(self), self).setUp()
+
+    def tearDown(self):
+        super(type(self), self).tearDown()
+
+#####
+
+    def test_ArielReplay_physical_timestamps(self):
+        inRecs, outRecs = self.replay_Template("physical_timestamps", "physical", "timestamps")
+
+        for inRec, outRec in zip(inRecs, outRecs):
+            self.assertEqual(inRec[1:], outRec[1:], "Replayed record {0} does not match the trace record {1}".format(outRec, inRec))
+            self.assertTrue(outRec[0] >= inRec[0], "Record {0} was issued at cycle {1}, before its captured cycle {2}".format(inRec, outRec[0], inRec[0]))
+
+    def test_ArielReplay_physical_asap(self):
+        inRecs, outRecs = self.replay_Template("physical_asap", "physical", "asap")
+
+        for inRec, outRec in zip(inRecs, outRecs):
+            self.assertEqual(inRec[1:], outRec[1:], "Replayed record {0} does not match the trace record {1}".format(outRec, inRec))
+
+        # the trace idles for 2000 cycles between bursts, without timestamps those gaps disappear
+        self.assertTrue(outRecs[-1][0] < inRecs[-1][0], "asap replay finished at cycle {0}, not before the captured {1}".format(outRecs[-1][0], inRecs[-1][0]))
+
+    # Core 1 runs on another thread, the pages both cores touch must be mapped the same way every run
+    def test_ArielReplay_partition_deterministic(self):
+        runs = []
+        for run in range(2):
+            runs.append(self.partition_Template("partition_run{0}".format(run)))
+
+        for core in range(2):
+            self.assertEqual(runs[0][core], runs[1][core], "Core {0} issued different physical addresses in two partitioned runs".format(core))
+
+    # 4KB pages only, every access asks the memory manager
+    def test_ArielReplay_radix_4k(self):
+        inRecs, outRecs, stats = self.radix_Template("radix_4k", [ "memmgr.hugepage_policy=none" ])
+
+        for inRec, outRec in zip(inRecs, outRecs):
+            self.assertEqual(inRec[2] % self.PAGE_4K, outRec[2] % self.PAGE_4K, "Record {0} lost its 4KB page offset".format(outRec))
+
+        self.assertEqual(stats.get("huge_page_allocs_2mb", 0), 0, "4KB policy mapped 2MB pages")
+        self.assertEqual(stats.get("translation_tlb_hits", 0), 0, "The soft TLB is off by default but served translations")
+        self.assertEqual(stats.get("tlb_translate_queries", 0), len(inRecs), "The memory manager did not count every translation")
+
+    # Each 2MB region is one huge page from its first touch
+    def test_ArielReplay_radix_always(self):
+        inRecs, outRecs, stats = self.radix_Template("radix_always", [ "memmgr.hugepage_policy=always" ])
+
+        self._checkHugeRegions(inRecs, outRecs, 0)
+        self.assertEqual(stats.get("huge_page_allocs_2mb", 0), 2, "Expected one 2MB page per region")
+        self.assertEqual(stats.get("page_migration_lines", 0), 0, "Nothing was promoted, nothing should be copied")
+
+    # The fourth touched page of a region promotes it, its four pages are copied into the huge frame
+    def test_ArielReplay_radix_promote(self):
+        inRecs, outRecs, stats = self.radix_Template("radix_promote", [ "memmgr.hugepage_policy=promote", "memmgr.promote_threshold=4" ])
+
+        for inRec, outRec in zip(inRecs, outRecs):
+            self.assertEqual(inRec[2] % self.PAGE_4K, outRec[2] % self.PAGE_4K, "Record {0} lost its 4KB page offset".format(outRec))
+
+        # the second round runs on the huge pages
+        self._checkHugeRegions(inRecs, outRecs, len(inRecs) // 2)
+        self.assertEqual(stats.get("huge_page_promotions", 0), 2, "Expected both regions to be promoted")
+        self.assertEqual(stats.get("page_migration_lines", 0), 2 * 4 * (self.PAGE_4K // 64), "Expected the four touched pages of each region to be copied line by line")
+
+    # Same mapping with the soft TLB, which serves the repeated pages
+    def test_ArielReplay_radix_softtlb(self):
+        inRecs, outRecs, stats = self.radix_Template("radix_softtlb", [ "memmgr.hugepage_policy=promote", "memmgr.promote_threshold=4", "translation_tlb_entries=64" ])
+
+        self._checkHugeRegions(inRecs, outRecs, len(inRecs) // 2)
+        self.assertTrue(stats.get("translation_tlb_hits", 0) > 0, "The soft TLB served no translations")
+        self.assertEqual(stats.get("translation_tlb_hits", 0) + stats.get("tlb_translate_queries", 0), len(inRecs),
+                         "Every translation should come from either the soft TLB or the memory manager")
+
+    def test_ArielReplay_softtlb_unit(self):
+        unitdir = "{0}/unit".format(self.get_testsuite_dir())
+        tmpdir = self.get_test_output_tmp_dir()
+
+        rtn = OSCommand("make testsofttlb", set_cwd=unitdir).run()
+        log_debug("Ariel soft TLB unit test make result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "Ariel soft TLB unit test failed to build")
+
+        rtn = OSCommand("{0}/testsofttlb".format(unitdir), set_cwd=tmpdir).run()
+        log_debug("Ariel soft TLB unit test result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "Ariel soft TLB unit test failed:\n{0}".format(rtn.output()))
+
+    def test_ArielReplay_batch_unit(self):
+        unitdir = "{0}/unit".format(self.get_testsuite_dir())
+        tmpdir = self.get_test_output_tmp_dir()
+
+        rtn = OSCommand("make testbatch", set_cwd=unitdir).run()
+        log_debug("Ariel command batch unit test make result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "Ariel command batch unit test failed to build")
+
+        rtn = OSCommand("{0}/testbatch".format(unitdir), set_cwd=tmpdir).run()
+        log_debug("Ariel command batch unit test result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "Ariel command batch unit test failed:\n{0}".format(rtn.output()))
+
+    def test_ArielReplay_l1filter_unit(self):
+        unitdir = "{0}/unit".format(self.get_testsuite_dir())
+        tmpdir = self.get_test_output_tmp_dir()
+
+        rtn = OSCommand("make testl1filter", set_cwd=unitdir).run()
+        log_debug("Ariel L1 filter unit test make result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "Ariel L1 filter unit test failed to build")
+
+        rtn = OSCommand("{0}/testl1filter".format(unitdir), set_cwd=tmpdir).run()
+        log_debug("Ariel L1 filter unit test result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "Ariel L1 filter unit test failed:\n{0}".format(rtn.output()))
+
+#####
+
+    PAGE_4K = 4096
+    PAGE_2M = 2 * 1024 * 1024
+
+    # From record start on, every record of a 2MB region is at the same physical offset from its virtual address
+    def _checkHugeRegions(self, inRecs, outRecs, start):
+        offsets = dict()
+        for inRec, outRec in zip(inRecs[start:], outRecs[start:]):
+            region = inRec[2] // self.PAGE_2M
+            offset = outRec[2] - inRec[2]
+            self.assertEqual(offset % self.PAGE_2M, 0, "Record {0} is not in a 2MB aligned frame".format(outRec))
+            self.assertEqual(offsets.setdefault(region, offset), offset, "Record {0} left its region's huge page".format(outRec))
+
+        self.assertEqual(len(offsets), 2, "Expected records in two 2MB regions")
+
+    def radix_Template(self, testcase, params):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        replayDir = "{0}/testReplay".format(test_path)
+        sdlfile = "{0}/replay.py".format(replayDir)
+        tracePrefix = "{0}/radix".format(replayDir)
+        outPrefix = "{0}/replay_{1}".format(tmpdir, testcase)
+
+        testDataFileName = "test_ArielReplay_{0}".format(testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        otherargs = '--model-options="{0} {1} virtual asap MemoryManagerRadix {2}"'.format(tracePrefix, outPrefix, " ".join(params))
+
+        self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, set_cwd=tmpdir,
+                     mpi_out_files=mpioutfiles)
+
+        cmd = 'grep "FATAL" {0} '.format(outfile)
+        grep_result = os.system(cmd) != 0
+        self.assertTrue(grep_result, "Output file {0} contains the word 'FATAL'...".format(outfile))
+
+        inRecs = self._readTrace("{0}-0.trace".format(tracePrefix))
+        outRecs = self._readTrace("{0}-0.trace".format(outPrefix))
+
+        self.assertEqual(len(inRecs), len(outRecs), "Replayed {0} records, the trace has {1}".format(len(outRecs), len(inRecs)))
+        return inRecs, outRecs, self._readStats("{0}-stats.csv".format(outPrefix))
+
+    # Sum of each statistic over the components that report it
+    def _readStats(self, path):
+        stats = dict()
+        with open(path, 'r') as statfile:
+            header = [ field.strip() for field in statfile.readline().split(",") ]
+            nameCol = header.index("StatisticName")
+            sumCol = header.index("Sum.u64")
+            for line in statfile:
+                fields = [ field.strip() for field in line.split(",") ]
+                if len(fields) > sumCol:
+                    stats[fields[nameCol]] = stats.get(fields[nameCol], 0) + int(fields[sumCol])
+        return stats
+
+    def partition_Template(self, testcase):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        replayDir = "{0}/testReplay".format(test_path)
+        sdlfile = "{0}/partition.py".format(replayDir)
+        tracePrefix = "{0}/virt".format(replayDir)
+        outPrefix = "{0}/replay_{1}".format(tmpdir, testcase)
+
+        testDataFileName = "test_ArielReplay_{0}".format(testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        otherargs = '--model-options="{0} {1}"'.format(tracePrefix, outPrefix)
+
+        self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, set_cwd=tmpdir,
+                     mpi_out_files=mpioutfiles, num_ranks=1, num_threads=2)
+
+        cmd = 'grep "FATAL" {0} '.format(outfile)
+        grep_result = os.system(cmd) != 0
+        self.assertTrue(grep_result, "Output file {0} contains the word 'FATAL'...".format(outfile))
+
+        # compare what was mapped, not when
+        addresses = []
+        for core in range(2):
+            inRecs = self._readTrace("{0}-{1}.trace".format(tracePrefix, core))
+            outRecs = self._readTrace("{0}-{1}.trace".format(outPrefix, core))
+
+            self.assertEqual(len(inRecs), len(outRecs), "Core {0} replayed {1} records, the trace has {2}".format(core, len(outRecs), len(inRecs)))
+            addresses.append([ rec[1:] for rec in outRecs ])
+
+        return addresses
+
+    def replay_Template(self, testcase, addresses, timing):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        replayDir = "{0}/testReplay".format(test_path)
+        sdlfile = "{0}/replay.py".format(replayDir)
+        tracePrefix = "{0}/phys".format(replayDir)
+        outPrefix = "{0}/replay_{1}".format(tmpdir, testcase)
+
+        testDataFileName = "test_ArielReplay_{0}".format(testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        otherargs = '--model-options="{0} {1} {2} {3}"'.format(tracePrefix, outPrefix, addresses, timing)
+
+        self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, set_cwd=tmpdir,
+                     mpi_out_files=mpioutfiles)
+
+        cmd = 'grep "FATAL" {0} '.format(outfile)
+        grep_result = os.system(cmd) != 0
+        self.assertTrue(grep_result, "Output file {0} contains the word 'FATAL'...".format(outfile))
+
+        inRecs = self._readTrace("{0}-0.trace".format(tracePrefix))
+        outRecs = self._readTrace("{0}-0.trace".format(outPrefix))
+
+        self.assertEqual(len(inRecs), len(outRecs), "Replayed {0} records, the trace has {1}".format(len(outRecs), len(inRecs)))
+        return inRecs, outRecs
+
+    # (cycle, op, address, length) for each line of a text trace
+    def _readTrace(self, path):
+        records = []
+        with open(path, 'r') as tracefile:
+            for line in tracefile:
+                fields = line.split()
+                if len(fields) == 4:
+                    records.append((int(fields[0]), fields[1], int(fields[2]), int(fields[3])))
+        return records
@@ -0,0 +1,77 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Stand-in for the SST core tunnel, one in-process FIFO per buffer in place
+// of the shared memory circular buffers.
+
+#ifndef UNIT_SST_CORE_INTERPROCESS_TUNNELDEF_H
+#define UNIT_SST_CORE_INTERPROCESS_TUNNELDEF_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <deque>
+#include <vector>
+
+namespace SST {
+namespace Core {
+namespace Interprocess {
+
+template <typename ShareDataType, typename MsgType>
+class TunnelDef {
+public:
+    TunnelDef(size_t numBuffers, size_t bufferSize, uint32_t expectedChildren) :
+        sharedData(NULL), buffers(numBuffers), shared() { }
+    TunnelDef(void* sPtr) : sharedData(NULL), buffers(), shared() { }
+    virtual ~TunnelDef() { }
+
+    virtual uint32_t initialize(void* sPtr) {
+        sharedData = &shared;
+        return 0;
+    }
+
+    bool isMaster() const { return true; }
+    size_t getTunnelSize() const { return 0; }
+    size_t getNumBuffers() const { return buffers.size(); }
+
+    void writeMessage(size_t buffer, const MsgType& command) { buffers[buffer].push_back(command); }
+
+    /* Nothing else writes, so reading an empty buffer would never return */
+    MsgType readMessage(size_t buffer) {
+        MsgType command = buffers[buffer].front();
+        buffers[buffer].pop_front();
+        return command;
+    }
+
+    bool readMessageNB(size_t buffer, MsgType* command) {
+        if ( buffers[buffer].empty() ) {
+            return false;
+        }
+        *command = readMessage(buffer);
+        return true;
+    }
+
+protected:
+    ShareDataType* sharedData;
+
+private:
+    std::vector<std::deque<MsgType> > buffers;
+    ShareDataType shared;
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,332 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Round trips of the delta encoded command batches through the tunnel
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "ariel_shmem.h"
+
+using namespace SST::ArielComponent;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if ( ! (cond) ) { \
+            printf( "FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond ); \
+            failures++; \
+        } \
+    } while ( 0 )
+
+struct Record {
+    ArielBatchRecord_t type;
+    uint64_t instPtr;
+    uint64_t addr;
+    uint32_t size;
+    uint8_t payload[ARIEL_MAX_PAYLOAD_SIZE];
+};
+
+static Record makeRecord(ArielBatchRecord_t type, uint64_t instPtr, uint64_t addr, uint32_t size)
+{
+    Record rec;
+    rec.type = type;
+    rec.instPtr = instPtr;
+    rec.addr = addr;
+    rec.size = size;
+    for ( uint32_t i = 0; i < ARIEL_MAX_PAYLOAD_SIZE; i++ ) {
+        rec.payload[i] = (uint8_t) (addr + i * 7);
+    }
+    return rec;
+}
+
+/* Send the pending batch as the frontends do, returns the slots it took */
+static uint32_t flush(ArielBatchEncoder& encoder, ArielTunnel& tunnel)
+{
+    const uint32_t slots = encoder.slots();
+    uint32_t written = 0;
+    ArielCommand ac;
+
+    while ( ! encoder.empty() ) {
+        encoder.fill(ac);
+        CHECK(ac.command == (0 == written ? ARIEL_BATCH : ARIEL_BATCH_DATA));
+        CHECK(ac.batch.length <= (0 == written ? ARIEL_BATCH_BUFFER_SIZE : ARIEL_BATCH_DATA_SIZE));
+        tunnel.writeMessage(0, ac);
+        written++;
+    }
+
+    CHECK(written == slots);
+    CHECK(0 == encoder.slots());
+    return written;
+}
+
+/* Read one batch as ArielCore::processBatch does and compare it with the records sent */
+static void drain(ArielBatchDecoder& decoder, ArielTunnel& tunnel, const std::vector<Record>& sent, size_t& next)
+{
+    ArielCommand ac = tunnel.readMessage(0);
+    CHECK(ARIEL_BATCH == ac.command);
+
+    bool gathered = decoder.begin(ac);
+    while ( gathered && decoder.needsData() ) {
+        gathered = decoder.append(tunnel.readMessage(0));
+    }
+    CHECK(gathered);
+
+    ArielBatchRecord_t type;
+    uint64_t instPtr;
+    uint64_t addr;
+    uint32_t size;
+    const uint8_t* payload;
+
+    while ( decoder.next(type, instPtr, addr, size, payload) ) {
+        CHECK(next < sent.size());
+        if ( next >= sent.size() ) {
+            break;
+        }
+
+        const Record& rec = sent[next++];
+        CHECK(rec.type == type);
+        CHECK(rec.size == size);
+        if ( ARIEL_BATCH_FILTERED_HITS != type ) {
+            CHECK(rec.instPtr == instPtr);
+        }
+        if ( ArielBatchEncoder::isAccess(type) ) {
+            CHECK(rec.addr == addr);
+        }
+        if ( ARIEL_BATCH_WRITE_PAYLOAD == type ) {
+            const uint32_t payloadLen = size < ARIEL_MAX_PAYLOAD_SIZE ? size : ARIEL_MAX_PAYLOAD_SIZE;
+            for ( uint32_t i = 0; i < payloadLen; i++ ) {
+                CHECK(rec.payload[i] == payload[i]);
+            }
+        }
+    }
+
+    CHECK(decoder.complete());
+}
+
+static void sendAll(const std::vector<Record>& records)
+{
+    ArielTunnel tunnel(1, 1024);
+    tunnel.initialize(NULL);
+    ArielBatchEncoder encoder;
+    ArielBatchDecoder decoder;
+    size_t next = 0;
+    size_t batches = 0;
+
+    for ( size_t i = 0; i < records.size(); i++ ) {
+        const Record& rec = records[i];
+        if ( ! encoder.encode(rec.type, rec.instPtr, rec.addr, rec.size, rec.payload) ) {
+            flush(encoder, tunnel);
+            batches++;
+            CHECK(encoder.encode(rec.type, rec.instPtr, rec.addr, rec.size, rec.payload));
+        }
+    }
+    flush(encoder, tunnel);
+    batches++;
+
+    for ( size_t i = 0; i < batches; i++ ) {
+        drain(decoder, tunnel, records, next);
+    }
+    CHECK(records.size() == next);
+
+    ArielCommand ac;
+    CHECK(! tunnel.readMessageNB(0, &ac));
+}
+
+/* Addresses and instruction pointers that move backwards need negative deltas */
+static void testNegativeDeltas()
+{
+    std::vector<Record> records;
+    records.push_back(makeRecord(ARIEL_BATCH_START_INSTRUCTION, 0x401000, 0, 0));
+    records.push_back(makeRecord(ARIEL_BATCH_READ, 0x401000, 0x7fff0000, 8));
+    records.push_back(makeRecord(ARIEL_BATCH_WRITE, 0x401000, 0x7ffeff00, 4));
+    records.push_back(makeRecord(ARIEL_BATCH_END_INSTRUCTION, 0x401000, 0, 0));
+    records.push_back(makeRecord(ARIEL_BATCH_START_INSTRUCTION, 0x400f00, 0, 0));
+    records.push_back(makeRecord(ARIEL_BATCH_READ, 0x400f00, 0x1000, 1));
+    records.push_back(makeRecord(ARIEL_BATCH_WRITE_PAYLOAD, 0x400f00, 0x800, 16));
+    records.push_back(makeRecord(ARIEL_BATCH_NOOP, 0x400e00, 0, 0));
+    records.push_back(makeRecord(ARIEL_BATCH_END_INSTRUCTION, 0x400e00, 0, 0));
+    sendAll(records);
+}
+
+/* Deltas of 2^63 take ten byte varints and sizes that are not powers of two a five byte one */
+static void testMaxWidthVarints()
+{
+    ArielBatchEncoder encoder;
+    CHECK(encoder.encode(ARIEL_BATCH_READ, 0x8000000000000000ULL, 0x8000000000000000ULL, 0xFFFFFFFFu, NULL));
+    ArielCommand ac;
+    encoder.fill(ac);
+    CHECK(1 == ac.batch.count);
+    CHECK(1 + 10 + 10 + 5 == ac.batch.length);
+
+    std::vector<Record> records;
+    records.push_back(makeRecord(ARIEL_BATCH_READ, 0x8000000000000000ULL, 0x8000000000000000ULL, 0xFFFFFFFFu));
+    records.push_back(makeRecord(ARIEL_BATCH_WRITE, 0, 0, 3));
+    records.push_back(makeRecord(ARIEL_BATCH_READ, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 1u << 14));
+    records.push_back(makeRecord(ARIEL_BATCH_WRITE_PAYLOAD, 1, 1, 4096));
+    records.push_back(makeRecord(ARIEL_BATCH_WRITE_PAYLOAD, 0x8000000000000000ULL, 0x7FFFFFFFFFFFFFFFULL, 33));
+    sendAll(records);
+}
+
+/* Fill batches to the last byte, the rejected record starts the next batch */
+static void testBatchFull()
+{
+    ArielBatchEncoder encoder;
+    uint32_t accepted = 0;
+    uint64_t addr = 64;
+
+    // three byte records, so the buffer runs out at a boundary that is not a slot boundary
+    while ( encoder.encode(ARIEL_BATCH_READ, 0, addr, 8, NULL) ) {
+        accepted++;
+        addr += 64;
+    }
+    CHECK(ARIEL_BATCH_BUFFER_SIZE / 3 == accepted);
+    CHECK(ARIEL_BATCH_MAX_SLOTS == encoder.slots());
+
+    // a single record batch takes one slot and an exactly full first slot no continuation
+    ArielBatchEncoder small;
+    CHECK(small.encode(ARIEL_BATCH_NOOP, 0, 0, 0, NULL));
+    CHECK(1 == small.slots());
+    for ( uint32_t i = 1; i < ARIEL_BATCH_DATA_SIZE; i++ ) {
+        CHECK(small.encode(ARIEL_BATCH_NOOP, 0, 0, 0, NULL));
+    }
+    CHECK(1 == small.slots());
+    CHECK(small.encode(ARIEL_BATCH_NOOP, 0, 0, 0, NULL));
+    CHECK(2 == small.slots());
+
+    std::vector<Record> records;
+    addr = 0x10000;
+    for ( uint32_t i = 0; i < 3 * accepted + 5; i++ ) {
+        records.push_back(makeRecord(ARIEL_BATCH_READ, 0x400000 + (i / 4) * 4, addr, 8));
+        records.push_back(makeRecord(ARIEL_BATCH_WRITE_PAYLOAD, 0x400000 + (i / 4) * 4, addr - 4096, 64));
+        addr += 64;
+    }
+    sendAll(records);
+}
+
+/* Hit summaries ride in batches and as classic commands in stream order */
+static void testFilteredHits()
+{
+    std::vector<Record> records;
+    records.push_back(makeRecord(ARIEL_BATCH_READ, 0x400000, 0x2000, 8));
+    records.push_back(makeRecord(ARIEL_BATCH_FILTERED_HITS, 0, 0, 1024));
+    records.push_back(makeRecord(ARIEL_BATCH_FILTERED_HITS, 0, 0, 1000));
+    records.push_back(makeRecord(ARIEL_BATCH_FILTERED_HITS, 0, 0, 0xFFFFFFFFu));
+    // a summary leaves the instruction pointer and address of the next access untouched
+    records.push_back(makeRecord(ARIEL_BATCH_READ, 0x400000, 0x2040, 8));
+    sendAll(records);
+
+    ArielTunnel tunnel(1, 1024);
+    tunnel.initialize(NULL);
+    ArielBatchEncoder encoder;
+    ArielBatchDecoder decoder;
+
+    CHECK(encoder.encode(ARIEL_BATCH_READ, 0x400000, 0x3000, 4, NULL));
+    flush(encoder, tunnel);
+
+    ArielCommand ac;
+    ac.command = ARIEL_FILTERED_HITS;
+    ac.instPtr = 0;
+    ac.filtered.hits = 77;
+    tunnel.writeMessage(0, ac);
+
+    CHECK(encoder.encode(ARIEL_BATCH_WRITE, 0x400004, 0x2ff8, 4, NULL));
+    flush(encoder, tunnel);
+
+    std::vector<Record> first;
+    first.push_back(makeRecord(ARIEL_BATCH_READ, 0x400000, 0x3000, 4));
+    size_t next = 0;
+    drain(decoder, tunnel, first, next);
+    CHECK(1 == next);
+
+    ac = tunnel.readMessage(0);
+    CHECK(ARIEL_FILTERED_HITS == ac.command);
+    CHECK(77 == ac.filtered.hits);
+
+    std::vector<Record> second;
+    second.push_back(makeRecord(ARIEL_BATCH_WRITE, 0x400004, 0x2ff8, 4));
+    next = 0;
+    drain(decoder, tunnel, second, next);
+    CHECK(1 == next);
+}
+
+/* Corrupt streams must be caught rather than decoded */
+static void testCorrupt()
+{
+    ArielBatchDecoder decoder;
+    ArielCommand ac;
+
+    ac.command = ARIEL_BATCH;
+    ac.batch.count = 1;
+    ac.batch.length = ARIEL_BATCH_BUFFER_SIZE + 1;
+    CHECK(! decoder.begin(ac));
+
+    // a continuation slot that is not batch data, or overruns the batch
+    ArielBatchEncoder encoder;
+    for ( uint32_t i = 0; i <= ARIEL_BATCH_DATA_SIZE; i++ ) {
+        CHECK(encoder.encode(ARIEL_BATCH_NOOP, 0, 0, 0, NULL));
+    }
+    encoder.fill(ac);
+    CHECK(decoder.begin(ac));
+    CHECK(decoder.needsData());
+
+    ArielCommand other;
+    other.command = ARIEL_FENCE_INSTRUCTION;
+    CHECK(! decoder.append(other));
+
+    encoder.fill(other);
+    CHECK(encoder.empty());
+    other.batch.length = 2;
+    CHECK(! decoder.append(other));
+    other.batch.length = 1;
+    CHECK(decoder.append(other));
+    CHECK(! decoder.needsData());
+
+    // a count larger than the records present
+    ArielBatchEncoder short_;
+    CHECK(short_.encode(ARIEL_BATCH_READ, 0, 64, 8, NULL));
+    short_.fill(ac);
+    ac.batch.count = 2;
+    CHECK(decoder.begin(ac));
+
+    ArielBatchRecord_t type;
+    uint64_t instPtr;
+    uint64_t addr;
+    uint32_t size;
+    const uint8_t* payload;
+    CHECK(decoder.next(type, instPtr, addr, size, payload));
+    CHECK(! decoder.next(type, instPtr, addr, size, payload));
+    CHECK(! decoder.complete());
+}
+
+int main(int argc, char* argv[])
+{
+    testNegativeDeltas();
+    testMaxWidthVarints();
+    testBatchFull();
+    testFilteredHits();
+    testCorrupt();
+
+    if ( failures ) {
+        printf( "%d checks failed\n", failures );
+        return EXIT_FAILURE;
+    }
+
+    printf( "All command batch checks passed\n" );
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,358 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Hits, misses, evictions and hit summaries of the Pin tool's L1 filter,
+// and the accuracy lost against forwarding every access
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include "ariel_l1filter.h"
+
+using namespace SST::ArielComponent;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if ( ! (cond) ) { \
+            printf( "FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond ); \
+            failures++; \
+        } \
+    } while ( 0 )
+
+static const uint32_t LINE = 64;
+
+/* Records what the filter forwards, one letter per event as fesimple would send it */
+struct Recorder {
+    std::string events;
+    std::vector<uint64_t> writes;
+    uint64_t hitCount;
+
+    Recorder() : hitCount(0) { }
+
+    void startInstruction() { events += 'S'; }
+    void read(uint64_t addr, uint32_t size) { events += 'R'; }
+    void write(uint64_t addr, uint32_t size) { events += 'W'; writes.push_back(addr); }
+    void endInstruction() { events += 'E'; }
+    void hits(uint64_t count) { events += 'H'; hitCount += count; }
+};
+
+static void testHitMiss()
+{
+    ArielL1Filter l1;
+    std::vector<uint64_t> evicted;
+
+    CHECK(! l1.enabled());
+    l1.configure(0, 8, LINE);
+    CHECK(! l1.enabled());
+
+    // 4 sets of 2 ways
+    l1.configure(8 * LINE, 2, LINE);
+    CHECK(l1.enabled());
+
+    CHECK(! l1.access(0x1000, 8, false, evicted));
+    CHECK(l1.access(0x1008, 8, false, evicted));
+    CHECK(l1.access(0x103f, 1, true, evicted));
+
+    // an access across two lines hits only if both do
+    CHECK(! l1.access(0x1038, 16, false, evicted));
+    CHECK(l1.access(0x1038, 16, false, evicted));
+
+    CHECK(5 == l1.getAccesses());
+    CHECK(2 == l1.getMisses());
+    CHECK(0 == l1.getWritebacks());
+    CHECK(evicted.empty());
+}
+
+static void testEviction()
+{
+    ArielL1Filter l1;
+    std::vector<uint64_t> evicted;
+
+    // lines 4 * LINE apart map to the same of the 4 sets
+    const uint64_t stride = 4 * LINE;
+    l1.configure(8 * LINE, 2, LINE);
+
+    CHECK(! l1.access(0 * stride, 8, false, evicted));
+    CHECK(! l1.access(1 * stride, 8, false, evicted));
+    CHECK(l1.access(0 * stride, 8, false, evicted));
+
+    // LRU evicts line 1, which is clean and so not written back
+    CHECK(! l1.access(2 * stride, 8, false, evicted));
+    CHECK(evicted.empty());
+    CHECK(l1.access(0 * stride, 8, false, evicted));
+    CHECK(! l1.access(1 * stride, 8, false, evicted));
+
+    // other sets are untouched
+    CHECK(! l1.access(LINE, 8, false, evicted));
+    CHECK(l1.access(0 * stride, 8, false, evicted));
+    CHECK(0 == l1.getWritebacks());
+}
+
+static void testDirtyWriteback()
+{
+    ArielL1Filter l1;
+    std::vector<uint64_t> evicted;
+    const uint64_t stride = 4 * LINE;
+    l1.configure(8 * LINE, 2, LINE);
+
+    // write allocate, then a write hit on a clean line also makes it dirty
+    CHECK(! l1.access(0 * stride + 8, 8, true, evicted));
+    CHECK(! l1.access(1 * stride, 8, false, evicted));
+    CHECK(l1.access(1 * stride + 16, 4, true, evicted));
+
+    CHECK(! l1.access(2 * stride, 8, false, evicted));
+    CHECK(1 == evicted.size());
+    CHECK(evicted.size() == 1 && 0 == evicted[0]);
+
+    CHECK(! l1.access(3 * stride, 8, false, evicted));
+    CHECK(2 == evicted.size());
+    CHECK(evicted.size() == 2 && stride == evicted[1]);
+    CHECK(2 == l1.getWritebacks());
+
+    // the refilled line is clean again
+    evicted.clear();
+    CHECK(! l1.access(0 * stride, 8, false, evicted));
+    CHECK(! l1.access(1 * stride, 8, false, evicted));
+    CHECK(evicted.empty());
+}
+
+/* Forwarded instructions carry only their misses and first writes to clean lines, in markers */
+static void testForwarding()
+{
+    ArielL1FilterThread filter;
+    Recorder out;
+    const uint64_t stride = 4 * LINE;
+    filter.configure(8 * LINE, 2, LINE, 1000);
+
+    // a read and write that both miss
+    filter.access(out, 0x0, 8, false, false);
+    filter.access(out, stride, 8, true, true);
+    CHECK("SRWE" == out.events);
+
+    // an instruction that hits throughout is not forwarded
+    filter.access(out, 0x8, 8, false, false);
+    filter.access(out, stride + 8, 8, true, true);
+    CHECK("SRWE" == out.events);
+
+    // a later miss sends the held back hits ahead of the instruction, the
+    // dirty line it evicts is left to the simulated L1 and the write hit to
+    // the clean line goes out so that the simulated L1 marks it dirty too
+    filter.access(out, 0x10, 8, false, false);
+    filter.access(out, 2 * stride, 8, false, false);
+    filter.access(out, 0x18, 8, true, true);
+    CHECK("SRWEHSRWE" == out.events);
+    CHECK(3 == out.hitCount);
+    CHECK(2 == out.writes.size());
+    CHECK(out.writes.size() == 2 && 0x18 == out.writes[1]);
+    CHECK(1 == filter.getL1().getWritebacks());
+
+    // later writes to the now dirty line are hits, and a hit inside a
+    // forwarded instruction waits for the next summary
+    filter.access(out, 0x20, 8, true, true);
+    CHECK("SRWEHSRWE" == out.events);
+    filter.access(out, 3 * stride, 8, false, false);
+    filter.access(out, 0x28, 8, true, true);
+    CHECK("SRWEHSRWEHSRE" == out.events);
+    CHECK(1 == filter.takeHits());
+    CHECK(0 == filter.takeHits());
+}
+
+/* Summaries at the interval, and at a syscall or thread exit */
+static void testSummaries()
+{
+    ArielL1FilterThread filter;
+    Recorder out;
+    filter.configure(8 * LINE, 2, LINE, 4);
+
+    filter.access(out, 0x0, 8, false, true);
+    CHECK("SRE" == out.events);
+
+    for ( int i = 0; i < 3; i++ ) {
+        filter.access(out, 0x8, 8, false, true);
+    }
+    CHECK("SRE" == out.events);
+    filter.access(out, 0x8, 8, false, true);
+    CHECK("SREH" == out.events);
+    CHECK(4 == out.hitCount);
+
+    // FlushOnSyscall and FlushOnThreadFini take what is held back
+    filter.access(out, 0x8, 8, false, true);
+    filter.access(out, 0x8, 8, false, true);
+    CHECK(2 == filter.takeHits());
+    CHECK(0 == filter.takeHits());
+    CHECK("SREH" == out.events);
+
+    // never in the middle of a forwarded instruction, which then ends with them still held
+    filter.access(out, 0x2000, 8, false, false);
+    filter.access(out, 0x8, 8, false, false);
+    CHECK(0 == filter.takeHits());
+    filter.access(out, 0x8, 8, false, true);
+    CHECK("SREHSRE" == out.events);
+    CHECK(2 == filter.takeHits());
+
+    // an interval of 0 sends after every instruction
+    ArielL1FilterThread eager;
+    Recorder eagerOut;
+    eager.configure(8 * LINE, 2, LINE, 0);
+    eager.access(eagerOut, 0x0, 8, false, true);
+    eager.access(eagerOut, 0x0, 8, false, true);
+    CHECK("SREH" == eagerOut.events);
+}
+
+/*
+ * Full against filtered runs of the same trace. The full run sends every
+ * access into a simulated L1 of the filter's geometry. The filtered run sends
+ * only what the filter forwards, and ArielCore charges each summarised hit
+ * the hit latency. Cycles are the serial latency of the accesses. The
+ * simulated L1 of the filtered run only sees the filter's misses, so its LRU
+ * order drifts from the filter's when lines are reused out of order, and it
+ * then hits on lines the filter has evicted.
+ */
+static const uint64_t HIT_LATENCY = 4;      // l1filter_hit_latency
+static const uint64_t MISS_LATENCY = 100;
+
+struct SimulatedL1 {
+    ArielL1Filter cache;
+    std::vector<uint64_t> evicted;
+    uint64_t cycles;
+    uint64_t filteredHits;
+
+    SimulatedL1() : cycles(0), filteredHits(0) { cache.configure(32 * 1024, 8, LINE); }
+
+    void access(uint64_t addr, uint32_t size, bool write) {
+        evicted.clear();
+        cycles += cache.access(addr, size, write, evicted) ? HIT_LATENCY : MISS_LATENCY;
+    }
+
+    void startInstruction() { }
+    void read(uint64_t addr, uint32_t size) { access(addr, size, false); }
+    void write(uint64_t addr, uint32_t size) { access(addr, size, true); }
+    void endInstruction() { }
+    void hits(uint64_t count) { filteredHits += count; cycles += count * HIT_LATENCY; }
+};
+
+struct Access {
+    uint64_t addr;
+    bool write;
+};
+
+static uint64_t lcg(uint64_t& state)
+{
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return state >> 33;
+}
+
+static double percent(uint64_t filtered, uint64_t full)
+{
+    return 100.0 * ((double) filtered - (double) full) / (double) full;
+}
+
+static void compare(const char* name, const std::vector<Access>& trace, double maxMissError, double maxCycleError)
+{
+    SimulatedL1 full;
+    SimulatedL1 filtered;
+    ArielL1FilterThread filter;
+    filter.configure(32 * 1024, 8, LINE, 1024);
+
+    for ( size_t i = 0; i < trace.size(); i++ ) {
+        full.access(trace[i].addr, 8, trace[i].write);
+        filter.access(filtered, trace[i].addr, 8, trace[i].write, true);
+    }
+    filtered.hits(filter.takeHits());
+
+    const uint64_t fullMisses = full.cache.getMisses();
+    const uint64_t filteredMisses = filtered.cache.getMisses();
+    const double missError = percent(filteredMisses, fullMisses);
+    const double cycleError = percent(filtered.cycles, full.cycles);
+
+    printf( "%-10s full %8" PRIu64 " misses %10" PRIu64 " cycles, filtered %8" PRIu64 " misses %10" PRIu64 " cycles (%6.2f%% misses, %6.2f%% cycles)\n",
+        name, fullMisses, full.cycles, filteredMisses, filtered.cycles, missError, cycleError );
+
+    // every access reaches the filtered run, forwarded or as a summarised hit
+    CHECK(full.cache.getAccesses() == filtered.cache.getAccesses() + filtered.filteredHits);
+    CHECK(fabs(missError) <= maxMissError);
+    CHECK(fabs(cycleError) <= maxCycleError);
+}
+
+static void testAccuracy()
+{
+    std::vector<Access> trace;
+    uint64_t state = 42;
+
+    // stream through 1MB twice storing the first word of each line, every
+    // line misses and is written back
+    for ( int pass = 0; pass < 2; pass++ ) {
+        for ( uint64_t addr = 0; addr < 1024 * 1024; addr += 8 ) {
+            Access a = { addr, 0 == (addr & 0x38) };
+            trace.push_back(a);
+        }
+    }
+    compare("stream", trace, 0.5, 0.5);
+
+    // repeated sweeps of a 24KB array that fits the L1
+    trace.clear();
+    for ( int pass = 0; pass < 20; pass++ ) {
+        for ( uint64_t addr = 0; addr < 24 * 1024; addr += 8 ) {
+            Access a = { 0x100000 + addr, 0 == pass % 4 };
+            trace.push_back(a);
+        }
+    }
+    compare("resident", trace, 0.5, 0.5);
+
+    // random accesses to a 64KB working set, a third of them writes
+    trace.clear();
+    for ( int i = 0; i < 500000; i++ ) {
+        Access a = { 0x200000 + (lcg(state) % (64 * 1024) & ~7ULL), 0 == lcg(state) % 3 };
+        trace.push_back(a);
+    }
+    compare("random", trace, 15.0, 15.0);
+
+    // a 4KB hot set that the filter keeps resident between the misses of
+    // sweeps over a 64KB cold array
+    trace.clear();
+    for ( int pass = 0; pass < 50; pass++ ) {
+        for ( uint64_t addr = 0; addr < 64 * 1024; addr += 64 ) {
+            Access cold = { 0x400000 + addr, false };
+            Access hot = { 0x300000 + (addr % (4 * 1024)), 0 == (addr & 0x40) };
+            trace.push_back(cold);
+            trace.push_back(hot);
+        }
+    }
+    compare("hot/cold", trace, 0.5, 0.5);
+}
+
+int main(int argc, char* argv[])
+{
+    testHitMiss();
+    testEviction();
+    testDirtyWriteback();
+    testForwarding();
+    testSummaries();
+    testAccuracy();
+
+    if ( failures ) {
+        printf( "%d checks failed\n", failures );
+        return EXIT_FAILURE;
+    }
+
+    printf( "All L1 filter checks passed\n" );
+    return EXIT_SUCCESS;
+}
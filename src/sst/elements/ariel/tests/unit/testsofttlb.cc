@@ -0,0 +1,144 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Lookups, conflicts and flushes of the per-core software TLB
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arielsofttlb.h"
+
+using namespace SST::ArielComponent;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if ( ! (cond) ) { \
+            printf( "FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond ); \
+            failures++; \
+        } \
+    } while ( 0 )
+
+static const uint64_t KB4 = 4096;
+static const uint64_t MB2 = 2 * 1024 * 1024;
+static const uint64_t GB1 = 1024 * 1024 * 1024;
+
+static void testDisabled()
+{
+    ArielSoftTLB tlb;
+    uint64_t phys = 0;
+
+    tlb.configure( 0 );
+    CHECK( ! tlb.enabled() );
+
+    ArielSoftTLB sized;
+    sized.configure( 3 );
+    CHECK( sized.enabled() );
+    CHECK( ! sized.lookup( 0x1000, phys ) );
+}
+
+static void testSmallPages()
+{
+    ArielSoftTLB tlb;
+    uint64_t phys = 0;
+
+    tlb.configure( 64 );
+    tlb.insert( 0x7f0000001234, 0x40005234, KB4 );
+
+    CHECK( tlb.lookup( 0x7f0000001000, phys ) && phys == 0x40005000 );
+    CHECK( tlb.lookup( 0x7f0000001fff, phys ) && phys == 0x40005fff );
+    CHECK( ! tlb.lookup( 0x7f0000002000, phys ) );
+    CHECK( ! tlb.lookup( 0x7f0000000fff, phys ) );
+
+    // 64 entries: the page 64 pages on maps to the same slot and replaces it
+    tlb.insert( 0x7f0000001000 + 64 * KB4, 0x80000000, KB4 );
+    CHECK( ! tlb.lookup( 0x7f0000001000, phys ) );
+    CHECK( tlb.lookup( 0x7f0000001010 + 64 * KB4, phys ) && phys == 0x80000010 );
+}
+
+static void testHugePages()
+{
+    ArielSoftTLB tlb;
+    uint64_t phys = 0;
+
+    tlb.configure( 64 );
+    tlb.insert( 0x40012345, 0x200012345, MB2 );
+
+    CHECK( tlb.lookup( 0x40000000, phys ) && phys == 0x200000000 );
+    CHECK( tlb.lookup( 0x401fffff, phys ) && phys == 0x2001fffff );
+    CHECK( ! tlb.lookup( 0x40200000, phys ) );
+
+    // A small page in the same slot does not evict the huge page around it
+    tlb.insert( 0x80000000, 0x1000, KB4 );
+    CHECK( tlb.lookup( 0x80000000, phys ) && phys == 0x1000 );
+    CHECK( tlb.lookup( 0x40100000, phys ) && phys == 0x200100000 );
+
+    // A 1GB page covers every 2MB region in it
+    tlb.insert( 0x1c0000000, 0x400000000, GB1 );
+    CHECK( tlb.lookup( 0x1c0000000, phys ) && phys == 0x400000000 );
+    CHECK( ! tlb.lookup( 0x1c0000000 + 3 * MB2, phys ) );
+    tlb.insert( 0x1c0000000 + 3 * MB2, 0x400000000 + 3 * MB2, GB1 );
+    CHECK( tlb.lookup( 0x1c0000000 + 3 * MB2 + 5, phys ) && phys == 0x400000000 + 3 * MB2 + 5 );
+}
+
+static void testOddPages()
+{
+    ArielSoftTLB tlb;
+    uint64_t phys = 0;
+
+    tlb.configure( 64 );
+
+    // Unknown and non power of two page sizes are not cached
+    tlb.insert( 0x1000, 0x2000, 0 );
+    tlb.insert( 0x3000, 0x4000, 3 * KB4 );
+    CHECK( ! tlb.lookup( 0x1000, phys ) );
+    CHECK( ! tlb.lookup( 0x3000, phys ) );
+}
+
+static void testFlush()
+{
+    ArielSoftTLB tlb;
+    uint64_t phys = 0;
+
+    tlb.configure( 64 );
+    tlb.insert( 0x1000, 0x9000, KB4 );
+    tlb.insert( 0x40000000, 0x80000000, MB2 );
+
+    tlb.flush();
+    CHECK( ! tlb.lookup( 0x1000, phys ) );
+    CHECK( ! tlb.lookup( 0x40000000, phys ) );
+
+    // A remapped page is seen once it is inserted again
+    tlb.insert( 0x1000, 0xa000, KB4 );
+    CHECK( tlb.lookup( 0x1008, phys ) && phys == 0xa008 );
+}
+
+int main( int argc, char* argv[] )
+{
+    testDisabled();
+    testSmallPages();
+    testHugePages();
+    testOddPages();
+    testFlush();
+
+    if ( failures ) {
+        printf( "%d checks failed\n", failures );
+        return EXIT_FAILURE;
+    }
+
+    printf( "All soft TLB checks passed\n" );
+    return EXIT_SUCCESS;
+}
@@ -9,6 +9,11 @@ AC_DEFUN([SST_ember_CONFIG], [
   SST_CHECK_OTF2([sst_check_ember_otf2="yes"], [sst_check_ember_otf2="no"])
   AM_CONDITIONAL([EMBER_HAVE_OTF2], [test "x$sst_check_ember_otf2" = "xyes"])
 
+  SST_CHECK_CXX20_COROUTINES([sst_check_ember_coroutines="yes"], [sst_check_ember_coroutines="no"])
+  AM_CONDITIONAL([EMBER_HAVE_COROUTINES], [test "x$sst_check_ember_coroutines" = "xyes"])
+  AS_IF([test "x$sst_check_ember_coroutines" = "xyes"],
+	[AC_DEFINE([HAVE_EMBER_COROUTINES], [1], [Build the Ember motifs written as coroutines])])
+
   AM_CONDITIONAL([USE_EMBER_CONTEXTS], [test "x$enable_ember_contexts" = "xyes"])
   AS_IF([test "x$enable_ember_contexts" = "xyes"], 
 	[AC_DEFINE([HAVE_EMBER_CONTEXTS], [1], [Use context switching code in Ember])])
@@ -0,0 +1,92 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include <sst/core/sst_types.h>
+#include <sst/core/component.h>
+#include <sst/core/output.h>
+#include <sst/core/unitAlgebra.h>
+
+#include <algorithm>
+
+#include "emberanalyticcomputemodel.h"
+
+using namespace SST;
+using namespace SST::Ember;
+
+EmberAnalyticComputeModel::EmberAnalyticComputeModel(Params& params) :
+	EmberComputeModel(params) {
+
+	Output& output = Output::getDefaultObject();
+
+	std::string model = params.find<std::string>("model", "ecm");
+	if ( model == "ecm" ) {
+		ecm = true;
+	} else if ( model == "roofline" ) {
+		ecm = false;
+	} else {
+		output.fatal(CALL_INFO, -1, "Error: unknown compute model \"%s\", expected roofline or ecm\n",
+			model.c_str());
+	}
+
+	cores = params.find<double>("cores", 1);
+	frequency = params.find<UnitAlgebra>("frequency", "2GHz").getValue().toDouble();
+	vectorWidth = params.find<double>("vectorWidth", 4);
+	flopsPerCycle = params.find<double>("flopsPerCycle", 2);
+	l1Bandwidth = params.find<double>("l1Bandwidth", 64);
+	l2Bandwidth = params.find<double>("l2Bandwidth", 32);
+	l3Bandwidth = params.find<double>("l3Bandwidth", 16);
+
+	memBandwidth = params.find<UnitAlgebra>("memBandwidth", "100GB/s").getValue().toDouble() / frequency;
+	coreMemBandwidth = memBandwidth;
+	if ( params.contains("coreMemBandwidth") ) {
+		coreMemBandwidth = params.find<UnitAlgebra>("coreMemBandwidth").getValue().toDouble() / frequency;
+	}
+
+	if ( cores < 1 || frequency <= 0 || vectorWidth < 1 || flopsPerCycle <= 0 ||
+			l1Bandwidth <= 0 || l2Bandwidth <= 0 || l3Bandwidth <= 0 ||
+			memBandwidth <= 0 || coreMemBandwidth <= 0 ) {
+		output.fatal(CALL_INFO, -1, "Error: compute model rates and the core count must be positive\n");
+	}
+}
+
+EmberAnalyticComputeModel::~EmberAnalyticComputeModel() {
+
+}
+
+double EmberAnalyticComputeModel::calcTimeNS(const EmberComputePhase& phase) {
+	// cycles on each core
+	const double arith = phase.flops / cores *
+		( phase.vectorFraction / ( vectorWidth * flopsPerCycle ) +
+		  ( 1.0 - phase.vectorFraction ) / flopsPerCycle );
+
+	const double l1 = phase.l1Bytes / cores / l1Bandwidth;
+	const double l2 = phase.l2Bytes / cores / l2Bandwidth;
+	const double l3 = phase.l3Bytes / cores / l3Bandwidth;
+
+	// the memory bandwidth is shared by every core
+	const double mem = phase.memBytes / memBandwidth;
+
+	double cycles;
+	if ( ecm ) {
+		const double data = l1 + l2 + l3 + phase.memBytes / cores / coreMemBandwidth;
+		cycles = std::max( std::max( arith, data ), mem );
+	} else {
+		cycles = std::max( std::max( arith, l1 ), std::max( std::max( l2, l3 ), mem ) );
+	}
+
+	return cycles / frequency * 1.0e9;
+}
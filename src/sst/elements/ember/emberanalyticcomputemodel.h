@@ -0,0 +1,82 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_EMBER_ANALYTIC_COMPUTE_MODEL
+#define _H_SST_EMBER_ANALYTIC_COMPUTE_MODEL
+
+#include "embercomputemodel.h"
+
+namespace SST {
+namespace Ember {
+
+/*
+ * Compute time from the FLOP and byte counts of a phase and a description
+ * of the node, the phase is split evenly over the cores.
+ *
+ * roofline: the slowest of the arithmetic and each level's transfer time
+ * ecm:      arithmetic overlaps with data transfer, the transfers between
+ *           levels do not overlap each other (Execution-Cache-Memory model).
+ *           Adding cores scales the single core time until memory
+ *           bandwidth saturates.
+ */
+class EmberAnalyticComputeModel : public EmberComputeModel {
+public:
+    SST_ELI_REGISTER_MODULE_DERIVED(
+        EmberAnalyticComputeModel,
+        "ember",
+        "AnalyticComputeModel",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Roofline or ECM compute time model",
+        SST::Ember::EmberComputeModel
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {   "model",            "Sets the model, roofline or ecm", "ecm" },
+        {   "cores",            "Sets the number of cores a phase is spread over", "1" },
+        {   "frequency",        "Sets the core clock frequency", "2GHz" },
+        {   "vectorWidth",      "Sets the number of lanes in a vector instruction", "4" },
+        {   "flopsPerCycle",    "Sets the floating point operations per lane per cycle, 2 for a single FMA unit", "2" },
+        {   "l1Bandwidth",      "Sets the L1 load/store bandwidth of a core in bytes per cycle", "64" },
+        {   "l2Bandwidth",      "Sets the L1-L2 bandwidth of a core in bytes per cycle", "32" },
+        {   "l3Bandwidth",      "Sets the L2-L3 bandwidth of a core in bytes per cycle", "16" },
+        {   "memBandwidth",     "Sets the memory bandwidth of the node", "100GB/s" },
+        {   "coreMemBandwidth", "Sets the memory bandwidth one core can draw, default is memBandwidth", "" },
+    )
+
+public:
+	EmberAnalyticComputeModel(Params& params);
+	~EmberAnalyticComputeModel();
+	double calcTimeNS(const EmberComputePhase& phase);
+
+private:
+	bool   ecm;
+	double cores;
+	double frequency;
+	double vectorWidth;
+	double flopsPerCycle;
+	double l1Bandwidth;
+	double l2Bandwidth;
+	double l3Bandwidth;
+	// bytes per cycle
+	double memBandwidth;
+	double coreMemBandwidth;
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,55 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_EMBER_COMPUTE_MODEL
+#define _H_SST_EMBER_COMPUTE_MODEL
+
+#include <sst/core/module.h>
+#include <sst/core/params.h>
+
+namespace SST {
+namespace Ember {
+
+// The work of one compute phase of a rank. Byte counts are the traffic
+// between each level and the one above it, registers and L1 for l1Bytes
+// down to the last level cache and memory for memBytes.
+struct EmberComputePhase {
+	EmberComputePhase() : flops(0), vectorFraction(1.0),
+		l1Bytes(0), l2Bytes(0), l3Bytes(0), memBytes(0) {}
+
+	double flops;
+	double vectorFraction;
+	double l1Bytes;
+	double l2Bytes;
+	double l3Bytes;
+	double memBytes;
+};
+
+class EmberComputeModel : public SST::Module {
+
+public:
+    SST_ELI_REGISTER_MODULE_API(SST::Ember::EmberComputeModel)
+
+    EmberComputeModel(Params& params) : Module() {}
+	virtual ~EmberComputeModel() {}
+	virtual double calcTimeNS(const EmberComputePhase& phase) = 0;
+
+};
+
+}
+}
+
+#endif
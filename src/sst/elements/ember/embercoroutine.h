@@ -0,0 +1,139 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_EMBER_COROUTINE
+#define _H_EMBER_COROUTINE
+
+// Coroutine motifs need a C++20 compiler, without one this header defines
+// nothing and the motifs built on it are left out.
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+
+#define EMBER_HAVE_COROUTINES 1
+
+#include <coroutine>
+#include <exception>
+#include <queue>
+
+#include "emberevent.h"
+
+namespace SST {
+namespace Ember {
+
+// The body of a coroutine motif. It starts suspended and is resumed by
+// the generator every time the engine asks for more events.
+class EmberTask {
+
+  public:
+    struct promise_type {
+        EmberTask get_return_object() {
+            return EmberTask( std::coroutine_handle<promise_type>::from_promise( *this ) );
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    EmberTask() {}
+    EmberTask( EmberTask&& other ) : m_handle( other.m_handle ) { other.m_handle = nullptr; }
+    EmberTask& operator=( EmberTask&& other ) {
+        if ( this != &other ) {
+            if ( m_handle ) {
+                m_handle.destroy();
+            }
+            m_handle = other.m_handle;
+            other.m_handle = nullptr;
+        }
+        return *this;
+    }
+    EmberTask( const EmberTask& ) = delete;
+    EmberTask& operator=( const EmberTask& ) = delete;
+
+    ~EmberTask() {
+        if ( m_handle ) {
+            m_handle.destroy();
+        }
+    }
+
+    bool valid() { return (bool) m_handle; }
+
+    // runs the body to its next suspension point, returns true once it has
+    // returned
+    bool resume() {
+        if ( ! m_handle.done() ) {
+            m_handle.resume();
+        }
+        return m_handle.done();
+    }
+
+  private:
+    explicit EmberTask( std::coroutine_handle<promise_type> handle ) : m_handle( handle ) {}
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+// Lets a motif be written as straight line code. The motif implements
+// run() as a coroutine, queues calls with the usual enQ_ functions on
+// evQ() and then does co_await issue(), which suspends it until the engine
+// has executed everything queued so far. Locals live in the coroutine frame
+// so requests, responses and loop counters need not be members, and the
+// engine's queue only ever holds the events of one step.
+//
+//     EmberTask run() {
+//         for ( int i = 0; i < m_iterations; i++ ) {
+//             MessageResponse resp;
+//             enQ_recv( evQ(), m_buf, m_len, CHAR, 0, TAG, GroupWorld, &resp );
+//             co_await issue();
+//             // resp is filled in here
+//         }
+//     }
+//
+// BaseT is EmberMessagePassingGenerator or EmberShmemGenerator.
+template < class BaseT >
+class EmberCoroutineGenerator : public BaseT {
+
+  public:
+    EmberCoroutineGenerator( ComponentId_t id, Params& params, std::string name = "" ) :
+        BaseT( id, params, name ), m_evQ( NULL ) {}
+
+    bool generate( std::queue<EmberEvent*>& evQ ) {
+        m_evQ = &evQ;
+        if ( ! m_task.valid() ) {
+            m_task = run();
+        }
+        return m_task.resume();
+    }
+
+  protected:
+    virtual EmberTask run() = 0;
+
+    std::queue<EmberEvent*>& evQ() { return *m_evQ; }
+
+    std::suspend_always issue() { return {}; }
+
+  private:
+    EmberTask                   m_task;
+    std::queue<EmberEvent*>*    m_evQ;
+};
+
+}
+}
+
+#endif
+#endif
+
+#endif
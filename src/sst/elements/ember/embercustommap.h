@@ -59,10 +59,19 @@ public:
         // NetworkSim: added variables to construct the custom map
         std::string jobId;
         std::string mapFile;
-        std::map<int, int> CustomMap; //custom task mapping
-        std::map<int, int> InvCustomMap; //inverse of the custom task mapping
+        // indexed by task, tasks missing from the file map to 0. Vectors
+        // rather than maps, a map costs tens of bytes per task per rank.
+        std::vector<int32_t> CustomMap; //custom task mapping
+        std::vector<int32_t> InvCustomMap; //inverse of the custom task mapping
         // end->NetworkSim
 
+        int32_t customTask(const int32_t task) const {
+                return task >= 0 && (size_t) task < CustomMap.size() ? CustomMap[task] : 0;
+        }
+        int32_t invCustomTask(const int32_t task) const {
+                return task >= 0 && (size_t) task < InvCustomMap.size() ? InvCustomMap[task] : 0;
+        }
+
         //NetworkSim: function that reads the custom mapping of the job with _mapjobId
         void readMapFile(std::string fileName) {
 
@@ -100,8 +109,14 @@ public:
 
                                 is >> nextStr;
                                 while(!nextStr.empty()){
-                                        CustomMap[taskNum] = std::stoi(nextStr);
-                                        InvCustomMap[std::stoi(nextStr)] = taskNum;
+                                        int32_t mappedTask = std::stoi(nextStr);
+                                        CustomMap.push_back(mappedTask);
+                                        if(mappedTask >= 0){
+                                                if((size_t) mappedTask >= InvCustomMap.size()){
+                                                        InvCustomMap.resize(mappedTask + 1, 0);
+                                                }
+                                                InvCustomMap[mappedTask] = taskNum;
+                                        }
                                         taskNum++;
                                         if(!(is >> nextStr)){
                                                 break;
@@ -112,8 +127,8 @@ public:
                 input.close();
 
                 /*
-                for(std::map<int, int>::iterator it = CustomMap.begin(); it != CustomMap.end(); it++){
-                        std::cout << "linearMapRankNum: " << it->first << " customMapRankNum: " << it->second << std::endl;
+                for(size_t i = 0; i < CustomMap.size(); i++){
+                        std::cout << "linearMapRankNum: " << i << " customMapRankNum: " << CustomMap[i] << std::endl;
                 }
                 */
         }
@@ -124,7 +139,7 @@ public:
 	void getPosition(const int32_t rank, const int32_t px, const int32_t py, const int32_t pz,
                 int32_t* myX, int32_t* myY, int32_t* myZ) {
 
-                int32_t customRank = (int32_t) InvCustomMap[rank];
+                int32_t customRank = invCustomTask(rank);
 
                 //std::cout << "rank: " << rank << " customRank: " << customRank << std::endl;
 
@@ -164,9 +179,9 @@ public:
                 	return -1;
         	} else {
                 	linearMapRank = (posZ * (peX * peY)) + (posY * peX) + posX;
-                        //std::cout << "linearMapTaskNum: " << linearMapRank << " customMapTaskNum: " << CustomMap[linearMapRank] << std::endl;
+                        //std::cout << "linearMapTaskNum: " << linearMapRank << " customMapTaskNum: " << customTask(linearMapRank) << std::endl;
                         //return (posZ * (peX * peY)) + (posY * peX) + posX;
-                        return (int32_t) CustomMap[linearMapRank];
+                        return customTask(linearMapRank);
         	}
 	}
 
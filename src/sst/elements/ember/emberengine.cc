@@ -67,11 +67,11 @@ EmberEngine::EmberEngine(SST::ComponentId_t id, SST::Params& params) :
 	m_apiMap = createApiMap( m_os, this, params );
     assert( ! m_apiMap.empty() );
 
-	motifParams.resize( params.find("motif_count", 1) );
-	output.verbose(CALL_INFO, 2, ENGINE_MASK, "Identified %ld motifs "
-                                    "to be simulated.\n", motifParams.size());
+	size_t numMotifs = params.find("motif_count", 1);
+	output.verbose(CALL_INFO, 2, ENGINE_MASK, "Identified %zu motifs "
+                                    "to be simulated.\n", numMotifs);
 
-	for ( unsigned int i = 0;  i < motifParams.size(); i++ ) {
+	for ( unsigned int i = 0;  i < numMotifs; i++ ) {
 		std::ostringstream tmp;
     	tmp << i;
 
@@ -81,14 +81,24 @@ EmberEngine::EmberEngine(SST::ComponentId_t id, SST::Params& params) :
         //NetworkSim: Add the mapFile parameter as motif parameters and pass it.
         params.insert("motif" + tmp.str() + ".rankmap.mapFile", params.find<string>("mapFile", "mapFile.txt"), true);
         //NetworkSim->end
-
-		motifParams[i] = params.get_scoped_params( "motif" + tmp.str() );
 	}
 
+    // the motif params are the same for every rank of a job, keep one copy
+    // per job in this process rather than one per rank
+    m_shareJobState = params.find<bool>("shareJobState", false);
+    if ( m_shareJobState ) {
+        motifParams = EmberJobState::shareMotifParams( m_jobId, params, numMotifs );
+    } else {
+        motifParams = std::make_shared<const EmberJobState::MotifParams>(
+                            EmberJobState::scopeMotifParams( params, numMotifs ) );
+    }
+    m_memoryReport = params.find<bool>("memoryReport", false);
+    EmberJobState::addRank();
+
     registerAsPrimaryComponent();
 
     // Init the first Motif
-    m_generator = initMotif( motifParams[0], m_apiMap, m_jobId,
+    m_generator = initMotif( (*motifParams)[0], m_apiMap, m_jobId,
                         currentMotif, m_nodePerf );
     assert( m_generator );
 
@@ -110,6 +120,8 @@ EmberEngine::~EmberEngine() {
 	if(NULL != m_motifLogger) {
 		delete m_motifLogger;
 	}
+
+    EmberJobState::removeRank();
 }
 
 EmberEngine::ApiMap EmberEngine::createApiMap( OS* os,
@@ -187,6 +199,7 @@ EmberGenerator* EmberEngine::initMotif( SST::Params params,
 	} else {
 		params.insert("_jobId", std::to_string( jobId ), true);
 		params.insert("_motifNum", std::to_string( motifNum ), true);
+		params.insert("_shareJobState", m_shareJobState ? "1" : "0", true);
 		assert( sizeof(this) == sizeof(uint64_t) );
 		params.insert("_enginePtr", std::to_string( reinterpret_cast<uint64_t>( this ) ), true);
 
@@ -214,6 +227,13 @@ void EmberEngine::init(unsigned int phase) {
 }
 
 void EmberEngine::finish() {
+    output.verbose(CALL_INFO, 1, ENGINE_MASK, "event pool: %" PRIu64 " events allocated, %" PRIu64 " reused\n",
+                m_eventPool.numAllocs(), m_eventPool.numReused() );
+
+    if ( m_memoryReport ) {
+        EmberJobState::report( output );
+    }
+
     ApiMap::iterator iter = m_apiMap.begin();
     for ( ; iter != m_apiMap.end(); ++ iter ) {
         iter->second->api->finish();
@@ -269,10 +289,10 @@ void EmberEngine::issueNextEvent(uint64_t nanoDelay) {
             }
             delete m_generator;
 
-            if ( ++currentMotif == motifParams.size() ) {
+            if ( ++currentMotif == motifParams->size() ) {
                 return;
             } else {
-                m_generator = initMotif( motifParams[currentMotif],
+                m_generator = initMotif( (*motifParams)[currentMotif],
 								m_apiMap, m_jobId, currentMotif, m_nodePerf );
                 assert( m_generator );
                 if (NULL != m_motifLogger) {
@@ -294,6 +314,8 @@ void EmberEngine::issueNextEvent(uint64_t nanoDelay) {
 
 bool EmberEngine::completeFunctor( int retval, EmberEvent* ev )
 {
+    EmberEventPool::Scope scope( m_eventPool );
+
     output.debug(CALL_INFO, 2, ENGINE_MASK, "%s %s Event\n",
               ev->stateName( ev->state() ).c_str(), ev->getName().c_str());
 
@@ -311,6 +333,7 @@ void EmberEngine::handleEvent(Event* ev) {
 	// Cast out the event we are processing and then hand off to whatever
 	// handlers we have created
 	EmberEvent* eEv = static_cast<EmberEvent*>(ev);
+    EmberEventPool::Scope scope( m_eventPool );
 
     output.debug(CALL_INFO, 2, ENGINE_MASK, "%s %s Event\n",
               eEv->stateName( eEv->state() ).c_str(), eEv->getName().c_str());
@@ -17,6 +17,7 @@
 #ifndef _H_EMBER_ENGINE
 #define _H_EMBER_ENGINE
 
+#include <memory>
 #include <queue>
 
 #include <sst/core/sst_types.h>
@@ -29,6 +30,7 @@
 
 #include "embermotiflog.h"
 #include "embergen.h"
+#include "emberjobstate.h"
 
 namespace SST {
 namespace Ember {
@@ -54,6 +56,8 @@ public:
         { "motif_count", "Sets the number of motifs which will be run in this simulation, default is 1", "1"},
         { "rankmapper", "Sets the rank mapping SST module to load to rank translations, default is linear mapping", "ember.LinearMap" },
         { "mapFile", "Sets the name of the input file for custom map", "mapFile.txt" },
+        { "shareJobState", "Share motif parameters and rank maps with the other ranks of the job in this process", "0" },
+        { "memoryReport", "Print the process memory footprint per rank at the end of the simulation", "0" },
 
         { "motif%(motif_count)d", "Sets the event generator or motif for the engine", "ember.EmberPingPongGenerator" },
     )
@@ -103,6 +107,7 @@ public:
 
 private:
 	bool refillQueue() {
+		EmberEventPool::Scope scope( m_eventPool );
 		return m_generator->generate( evQueue );
 	}
 
@@ -137,10 +142,13 @@ private:
 	int         m_jobId;
 	uint32_t    currentMotif;
     bool        m_motifDone;
+    bool        m_shareJobState;
+    bool        m_memoryReport;
     ApiMap      m_apiMap;
 	Output      output;
 
 	std::queue<EmberEvent*> evQueue;
+	EmberEventPool          m_eventPool;
 
     Hermes::NodePerf*   m_nodePerf;
 	EmberGenerator*     m_generator;
@@ -148,7 +156,7 @@ private:
 	SST::TimeConverter* nanoTimeConverter;
 	EmberMotifLog*      m_motifLogger;
 
-	std::vector<SST::Params> motifParams;
+	std::shared_ptr<const EmberJobState::MotifParams> motifParams;
 	Thornhill::DetailedCompute* m_detailedCompute;
 	Thornhill::MemoryHeapLink*  m_memHeapLink;
 
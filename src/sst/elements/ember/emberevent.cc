@@ -19,6 +19,8 @@
 using namespace SST;
 using namespace Ember;
 
+thread_local EmberEventPool* EmberEventPool::s_current = NULL;
+
 const char* EmberEvent::m_enumName[] = {
     FOREACH_ENUM(GENERATE_STRING)
 };
@@ -22,6 +22,8 @@
 #include <sst/elements/hermes/msgapi.h>
 #include <sst/elements/hermes/shmemapi.h>
 
+#include "embereventpool.h"
+
 namespace SST {
 namespace Ember {
 
@@ -61,6 +63,15 @@ public:
         m_state(Issue), m_output(NULL), m_evStat(NULL), m_completeDelayNS(0), m_retvalPtr(NULL) {}
 	~EmberEvent() {}
 
+    // a motif creates and frees an event for every call it makes, they
+    // come from the running engine's pool rather than the heap
+    static void* operator new( size_t size ) {
+        return EmberEventPool::alloc( size );
+    }
+    static void operator delete( void* ptr, size_t size ) {
+        EmberEventPool::free( ptr, size );
+    }
+
 	virtual std::string getName() { return "?????"; };
 
     State state() { return m_state; }
@@ -0,0 +1,104 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_EMBER_EVENT_POOL
+#define _H_EMBER_EVENT_POOL
+
+#include <new>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace SST {
+namespace Ember {
+
+// Free lists of event sized blocks. Each engine owns a pool and makes it
+// current while it runs its motif, events allocated or freed while a pool
+// is current come from and go back to it. Blocks are plain operator new
+// memory rounded up to the bin size, so an event freed while no pool is
+// current, or freed into another engine's pool, is still handled correctly.
+class EmberEventPool {
+
+  public:
+    class Scope {
+      public:
+        Scope( EmberEventPool& pool ) : m_prev( s_current ) { s_current = &pool; }
+        ~Scope() { s_current = m_prev; }
+      private:
+        EmberEventPool* m_prev;
+    };
+
+    EmberEventPool() : m_numAllocs( 0 ), m_numReused( 0 ) {}
+
+    ~EmberEventPool() {
+        for ( int i = 0; i < NumBins; i++ ) {
+            for ( size_t j = 0; j < m_free[i].size(); j++ ) {
+                ::operator delete( m_free[i][j] );
+            }
+        }
+    }
+
+    static void* alloc( size_t size ) {
+        int bin = calcBin( size );
+        EmberEventPool* pool = s_current;
+
+        if ( NULL == pool || bin == NumBins ) {
+            return ::operator new( bin == NumBins ? size : binSize( bin ) );
+        }
+
+        if ( ! pool->m_free[bin].empty() ) {
+            void* ptr = pool->m_free[bin].back();
+            pool->m_free[bin].pop_back();
+            ++pool->m_numReused;
+            return ptr;
+        }
+        ++pool->m_numAllocs;
+        return ::operator new( binSize( bin ) );
+    }
+
+    static void free( void* ptr, size_t size ) {
+        int bin = calcBin( size );
+        if ( NULL == s_current || bin == NumBins ) {
+            ::operator delete( ptr );
+        } else {
+            s_current->m_free[bin].push_back( ptr );
+        }
+    }
+
+    uint64_t numAllocs() { return m_numAllocs; }
+    uint64_t numReused() { return m_numReused; }
+
+  private:
+    static const int    NumBins = 16;
+    static const size_t BinBytes = 32;
+
+    static int calcBin( size_t size ) {
+        size_t bin = ( size + BinBytes - 1 ) / BinBytes - 1;
+        return bin < NumBins ? bin : NumBins;
+    }
+    static size_t binSize( int bin ) { return ( bin + 1 ) * BinBytes; }
+
+    static thread_local EmberEventPool* s_current;
+
+    std::vector<void*>  m_free[NumBins];
+    uint64_t            m_numAllocs;
+    uint64_t            m_numReused;
+};
+
+}
+}
+
+#endif
@@ -47,6 +47,20 @@ EmberGenerator::EmberGenerator( ComponentId_t id, Params& params, std::string na
                                     << distribModule << "\'" << std::endl;
         exit(-1);
     }
+
+    m_computeModel = NULL;
+    std::string computeModel = params.find<std::string>("computeModel", "");
+
+    if ( ! computeModel.empty() ) {
+        Params computeModelParams = params.get_scoped_params("computeModelParams");
+        m_computeModel = loadModule<EmberComputeModel>(computeModel, computeModelParams);
+
+        if(NULL == m_computeModel) {
+            std::cerr << "Error: Unable to load compute model: \'"
+                                    << computeModel << "\'" << std::endl;
+            exit(-1);
+        }
+    }
 }
 
 
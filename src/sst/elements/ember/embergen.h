@@ -32,6 +32,7 @@
 #include "embermap.h"
 #include "embermemoryev.h"
 #include "emberconstdistrib.h"
+#include "embercomputemodel.h"
 #include "embercomputeev.h"
 #include "emberdetailedcomputeev.h"
 #include "embergettimeev.h"
@@ -60,7 +61,9 @@ class EmberGenerator : public SubComponent {
         { "_motifNum", "used internally", "-1"},
         { "_jobId", "used internally", "-1"},
         { "_enginePtr", "used internally", "-1"},
+        { "_shareJobState", "used internally", "0"},
 		{ "distribModule", "Sets the distribution SST module for compute modeling, default is a constant distribution of mean 1", "1.0"},
+		{ "computeModel", "Sets the SST module that turns the FLOP and byte counts of a compute phase into time, e.g. ember.AnalyticComputeModel", ""},
 	)
 
     EmberGenerator( ComponentId_t id, Params& params ) : SubComponent(id) { assert(0); }
@@ -122,6 +125,8 @@ class EmberGenerator : public SubComponent {
     virtual void memSetBacked() { m_dataMode = Backing; }
     virtual void memSetNotBacked() { m_dataMode = NoBacking; }
     bool haveDetailed() { return m_detailedCompute; }
+    bool haveComputeModel() { return m_computeModel; }
+    EmberComputeModel& computeModel() { return *m_computeModel; }
 
     Thornhill::DetailedCompute*   m_detailedCompute;
     Thornhill::MemoryHeapLink*    m_memHeapLink;
@@ -130,6 +135,7 @@ class EmberGenerator : public SubComponent {
     inline void enQ_memAlloc( Queue&, Hermes::MemAddr* addr, size_t length  );
     inline void enQ_compute( Queue&, uint64_t nanoSecondDelay );
     inline void enQ_compute( Queue& q, std::function<uint64_t()> func );
+    inline void enQ_compute( Queue& q, const EmberComputePhase& phase );
     inline void enQ_detailedCompute( Queue& q, std::string, Params&, std::function<int()> func );
 
   private:
@@ -143,6 +149,7 @@ class EmberGenerator : public SubComponent {
     int                     m_motifNum;
     bool                    m_primary;
     EmberComputeDistribution*           m_computeDistrib;
+    EmberComputeModel*                  m_computeModel;
     uint64_t m_curVirtAddr;
 };
 
@@ -160,6 +167,13 @@ void EmberGenerator::enQ_compute( Queue& q, std::function<uint64_t()> func )
     q.push( new EmberComputeEvent( &getOutput(), func, m_computeDistrib ) );
 }
 
+void EmberGenerator::enQ_compute( Queue& q, const EmberComputePhase& phase )
+{
+    assert( m_computeModel );
+    q.push( new EmberComputeEvent( &getOutput(),
+                (uint64_t) m_computeModel->calcTimeNS( phase ), m_computeDistrib ) );
+}
+
 void EmberGenerator::enQ_detailedCompute( Queue& q, std::string name,
         Params& params, std::function<int()> fini = NULL )
 {
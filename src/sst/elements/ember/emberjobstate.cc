@@ -0,0 +1,202 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+
+#include <inttypes.h>
+#include <set>
+#include <stdio.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "emberjobstate.h"
+#include "embermap.h"
+
+using namespace SST;
+using namespace SST::Ember;
+
+std::mutex                  EmberJobState::s_lock;
+std::atomic<uint32_t>       EmberJobState::s_numRanks( 0 );
+std::atomic<bool>           EmberJobState::s_reported( false );
+std::atomic<uint32_t>       EmberJobState::s_numShared( 0 );
+uint64_t                    EmberJobState::s_baseRSS = 0;
+std::map< int, std::shared_ptr<const EmberJobState::MotifParams> >  EmberJobState::s_motifParams;
+std::map< std::string, std::shared_ptr<EmberRankMap> >             EmberJobState::s_rankMaps;
+
+EmberJobState::MotifParams EmberJobState::scopeMotifParams( SST::Params& params, size_t numMotifs )
+{
+    MotifParams motifParams( numMotifs );
+    for ( size_t i = 0; i < numMotifs; i++ ) {
+        motifParams[i] = params.get_scoped_params( "motif" + std::to_string( i ) );
+    }
+    return motifParams;
+}
+
+std::shared_ptr<const EmberJobState::MotifParams> EmberJobState::shareMotifParams( int jobId,
+                                            SST::Params& params, size_t numMotifs )
+{
+    std::shared_ptr<const MotifParams> cached;
+    {
+        std::lock_guard<std::mutex> lock( s_lock );
+        std::map< int, std::shared_ptr<const MotifParams> >::iterator iter = s_motifParams.find( jobId );
+        if ( iter != s_motifParams.end() ) {
+            cached = iter->second;
+        }
+    }
+
+    // the cached copy is never written, compare against it without the lock
+    // and only copy the params when they differ
+    if ( cached && sameMotifParams( *cached, params, numMotifs ) ) {
+        ++s_numShared;
+        return cached;
+    }
+
+    std::shared_ptr<const MotifParams> motifParams =
+                std::make_shared<const MotifParams>( scopeMotifParams( params, numMotifs ) );
+    if ( ! cached ) {
+        // a rank that got here first keeps its copy in the cache
+        std::lock_guard<std::mutex> lock( s_lock );
+        s_motifParams.insert( std::make_pair( jobId, motifParams ) );
+    }
+    return motifParams;
+}
+
+std::shared_ptr<EmberRankMap> EmberJobState::shareRankMap( const std::string& module, SST::Params& params,
+                                                           std::function<EmberRankMap*()> load )
+{
+    // the module name and all of its parameters identify the map
+    std::string key = module;
+    std::set<std::string> keys = params.getKeys();
+    for ( std::set<std::string>::iterator iter = keys.begin(); iter != keys.end(); ++iter ) {
+        key += "," + *iter + "=" + params.find<std::string>( *iter );
+    }
+
+    std::lock_guard<std::mutex> lock( s_lock );
+
+    std::map< std::string, std::shared_ptr<EmberRankMap> >::iterator iter = s_rankMaps.find( key );
+    if ( iter == s_rankMaps.end() ) {
+        std::shared_ptr<EmberRankMap> map( load() );
+        if ( ! map ) {
+            return map;
+        }
+        iter = s_rankMaps.insert( std::make_pair( key, map ) ).first;
+    }
+    return iter->second;
+}
+
+static uint64_t maxResidentBytes()
+{
+    struct rusage usage;
+    getrusage( RUSAGE_SELF, &usage );
+#ifdef __APPLE__
+    return (uint64_t) usage.ru_maxrss;
+#else
+    // kilobytes everywhere but darwin
+    return (uint64_t) usage.ru_maxrss * 1024;
+#endif
+}
+
+// the current resident size, the peak where that is not available
+static uint64_t residentBytes()
+{
+    FILE* fp = fopen( "/proc/self/statm", "r" );
+    if ( fp ) {
+        unsigned long size, resident;
+        int num = fscanf( fp, "%lu %lu", &size, &resident );
+        fclose( fp );
+        if ( 2 == num ) {
+            return (uint64_t) resident * sysconf( _SC_PAGESIZE );
+        }
+    }
+    return maxResidentBytes();
+}
+
+void EmberJobState::addRank()
+{
+    // what the process held before the first rank is not the ranks' cost
+    if ( 0 == s_numRanks++ ) {
+        s_baseRSS = residentBytes();
+    }
+}
+
+void EmberJobState::removeRank()
+{
+    // ranks still holding a motif params or rank map keep it alive
+    if ( 1 == s_numRanks-- ) {
+        std::lock_guard<std::mutex> lock( s_lock );
+        s_motifParams.clear();
+        s_rankMaps.clear();
+    }
+}
+
+void EmberJobState::report( Output& output )
+{
+    if ( s_reported.exchange( true ) ) {
+        return;
+    }
+
+    uint64_t maxRSS = maxResidentBytes();
+    uint64_t rss = residentBytes();
+    uint64_t grown = rss > s_baseRSS ? rss - s_baseRSS : 0;
+    uint32_t numRanks = s_numRanks;
+
+    std::lock_guard<std::mutex> lock( s_lock );
+    output.output( "EmberEngine memory: %" PRIu32 " ranks in this process, max RSS %" PRIu64 " bytes, "
+            "RSS %" PRIu64 " bytes, %" PRIu64 " before the first rank, %" PRIu64 " bytes per rank, "
+            "%zu jobs with shared motif params (%" PRIu32 " ranks sharing), %zu shared rank maps\n",
+            numRanks, maxRSS, rss, s_baseRSS, numRanks ? grown / numRanks : 0,
+            s_motifParams.size(), (uint32_t) s_numShared, s_rankMaps.size() );
+}
+
+bool EmberJobState::sameMotifParams( const MotifParams& cached, SST::Params& params, size_t numMotifs )
+{
+    if ( cached.size() != numMotifs ) {
+        return false;
+    }
+
+    // count the keys of each motif scope, "motif<n>.<key>"
+    std::vector<size_t> numKeys( numMotifs, 0 );
+    std::set<std::string> keys = params.getKeys();
+    for ( std::set<std::string>::iterator iter = keys.begin(); iter != keys.end(); ++iter ) {
+        if ( iter->compare( 0, 5, "motif" ) ) {
+            continue;
+        }
+        size_t dot = iter->find( '.', 5 );
+        if ( dot == std::string::npos || dot == 5 ||
+                iter->find_first_not_of( "0123456789", 5 ) != dot ) {
+            continue;
+        }
+        size_t motif = std::stoul( iter->substr( 5, dot - 5 ) );
+        if ( motif < numMotifs ) {
+            ++numKeys[motif];
+        }
+    }
+
+    for ( size_t i = 0; i < numMotifs; i++ ) {
+        std::set<std::string> cachedKeys = cached[i].getKeys();
+        if ( cachedKeys.size() != numKeys[i] ) {
+            return false;
+        }
+        std::string prefix = "motif" + std::to_string( i ) + ".";
+        for ( std::set<std::string>::iterator iter = cachedKeys.begin(); iter != cachedKeys.end(); ++iter ) {
+            if ( ! params.contains( prefix + *iter ) ||
+                    params.find<std::string>( prefix + *iter ) != cached[i].find<std::string>( *iter ) ) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
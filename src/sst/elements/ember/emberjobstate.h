@@ -0,0 +1,86 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_EMBER_JOB_STATE
+#define _H_EMBER_JOB_STATE
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <sst/core/params.h>
+#include <sst/core/output.h>
+
+namespace SST {
+namespace Ember {
+
+class EmberRankMap;
+
+// State of a job that is built once and only read afterwards, motif
+// parameters and rank maps. Every rank of a job normally builds an
+// identical copy, with shareJobState set the engines in a process use one
+// copy per job instead. It is shared by all the threads of a process.
+class EmberJobState {
+
+  public:
+    typedef std::vector<SST::Params> MotifParams;
+
+    // The parameters of each motif, scope "motif<n>" of the engine params
+    static MotifParams scopeMotifParams( SST::Params& params, size_t numMotifs );
+
+    // Returns the motif parameters cached for the job if the engine params
+    // hold the same ones, else a copy of its own for the rank. The first
+    // rank of a job fills the cache. Ranks that share do not copy.
+    static std::shared_ptr<const MotifParams> shareMotifParams( int jobId, SST::Params& params,
+                                                                size_t numMotifs );
+
+    // Returns the rank map loaded with these parameters, load() is called
+    // the first time. The cache and every generator using the map share
+    // ownership of it, the last of them to let go deletes it.
+    static std::shared_ptr<EmberRankMap> shareRankMap( const std::string& module, SST::Params& params,
+                                                       std::function<EmberRankMap*()> load );
+
+    static void addRank();
+
+    // Called as each engine is destroyed. With the last one gone the cache
+    // drops its motif params and rank maps.
+    static void removeRank();
+
+    // prints the process footprint once, for the first engine to ask. The
+    // bytes per rank are what the resident size grew by after the first
+    // rank was built, divided by the ranks.
+    static void report( Output& output );
+
+  private:
+    static bool sameMotifParams( const MotifParams& cached, SST::Params& params, size_t numMotifs );
+
+    static std::mutex                   s_lock;
+    static std::atomic<uint32_t>        s_numRanks;
+    static std::atomic<bool>            s_reported;
+    static std::atomic<uint32_t>        s_numShared;
+    static uint64_t                     s_baseRSS;
+    static std::map< int, std::shared_ptr<const MotifParams> >  s_motifParams;
+    static std::map< std::string, std::shared_ptr<EmberRankMap> > s_rankMaps;
+};
+
+}
+}
+
+#endif
@@ -158,6 +158,9 @@ class EmberMpiLib : public EmberLib {
     void barrier( Queue& q, Communicator comm ) {
 		q.push( new EmberBarrierEvent( api(), m_output, m_Stats[Barrier], comm ) );
 	}
+    void barrierOffload( Queue& q, Communicator comm ) {
+		q.push( new EmberBarrierEvent( api(), m_output, m_Stats[Barrier], comm, true ) );
+	}
     void send(Queue& q, const Hermes::MemAddr& payload, uint32_t count, PayloadDataType dtype, RankID dest, uint32_t tag, Communicator group) {
     	q.push( new EmberSendEvent( api(), m_output, m_Stats[Send], payload, count, dtype, dest, tag, group ) );
 
@@ -231,6 +234,11 @@ class EmberMpiLib : public EmberLib {
 		q.push( new EmberAllreduceEvent( api(), m_output, m_Stats[Allreduce], mydata, result, count, dtype, op, group ) );
 	}
 
+    void allreduceOffload( Queue& q, const Hermes::MemAddr& mydata, const Hermes::MemAddr& result, uint32_t count,
+                PayloadDataType dtype, ReductionOperation op, Communicator group ) {
+		q.push( new EmberAllreduceEvent( api(), m_output, m_Stats[Allreduce], mydata, result, count, dtype, op, group, true ) );
+	}
+
     void reduce( Queue& q, const Hermes::MemAddr& mydata, const Hermes::MemAddr& result, uint32_t count,
                 PayloadDataType dtype, ReductionOperation op, int root, Communicator group ) {
 		q.push( new EmberReduceEvent( api(), m_output, m_Stats[Reduce], mydata, result, count, dtype, op, root, group ) );
@@ -298,6 +306,11 @@ class EmberMpiLib : public EmberLib {
 		Hermes::MemAddr result( memAddr( _result ) );
     	allreduce( q, mydata, result, count, dtype, op, group );
 	}
+    void allreduceOffload( Queue& q, Addr _mydata, Addr _result, uint32_t count, PayloadDataType dtype, ReductionOperation op, Communicator group ) {
+		Hermes::MemAddr mydata( memAddr( _mydata ) );
+		Hermes::MemAddr result( memAddr( _result ) );
+    	allreduceOffload( q, mydata, result, count, dtype, op, group );
+	}
     void reduce( Queue& q, Addr _mydata, Addr _result, uint32_t count, PayloadDataType dtype, ReductionOperation op,
                 int root, Communicator group )
 	{
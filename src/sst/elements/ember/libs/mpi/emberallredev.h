@@ -29,14 +29,15 @@ public:
             const Hermes::MemAddr& mydata,
             const Hermes::MemAddr& result,
             uint32_t count, PayloadDataType dtype,
-            ReductionOperation op, Communicator group ) :
+            ReductionOperation op, Communicator group, bool offload = false ) :
         EmberMPIEvent( api, output, stat ),
         m_mydata(mydata),
         m_result(result),
         m_count(count),
         m_dtype(dtype),
         m_op(op),
-        m_group(group)
+        m_group(group),
+        m_offload(offload)
     {}
 
 	~EmberAllreduceEvent() {}
@@ -47,8 +48,13 @@ public:
 
         EmberEvent::issue( time );
 
-        m_api.allreduce( m_mydata, m_result, m_count, m_dtype, m_op,
+        if ( m_offload ) {
+            m_api.allreduceOffload( m_mydata, m_result, m_count, m_dtype, m_op,
                                                     m_group, functor );
+        } else {
+            m_api.allreduce( m_mydata, m_result, m_count, m_dtype, m_op,
+                                                    m_group, functor );
+        }
     }
 
 private:
@@ -58,6 +64,7 @@ private:
     PayloadDataType     m_dtype;
     ReductionOperation  m_op;
     Communicator        m_group;
+    bool                m_offload;
 };
 
 }
@@ -26,8 +26,8 @@ class EmberBarrierEvent : public EmberMPIEvent {
   public:
     EmberBarrierEvent( MP::Interface& api, Output* output,
                       EmberEventTimeStatistic* stat,
-                                                    Communicator comm ) :
-        EmberMPIEvent( api, output, stat ), m_comm(comm) {}
+                      Communicator comm, bool offload = false ) :
+        EmberMPIEvent( api, output, stat ), m_comm(comm), m_offload(offload) {}
 
     ~EmberBarrierEvent() {}
 
@@ -37,11 +37,16 @@ class EmberBarrierEvent : public EmberMPIEvent {
 
         EmberEvent::issue( time );
 
-        m_api.barrier( m_comm, functor );
+        if ( m_offload ) {
+            m_api.barrierOffload( m_comm, functor );
+        } else {
+            m_api.barrier( m_comm, functor );
+        }
     }
 
   private:
     Communicator m_comm;
+    bool         m_offload;
 };
 
 }
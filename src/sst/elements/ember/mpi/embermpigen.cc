@@ -16,6 +16,7 @@
 #include <sst_config.h>
 
 #include "embermpigen.h"
+#include "emberjobstate.h"
 
 using namespace SST;
 using namespace SST::Ember;
@@ -33,9 +34,16 @@ EmberMessagePassingGenerator::EmberMessagePassingGenerator(
     }
     //end->NetworkSim
 
-    m_rankMap = loadModule<EmberRankMap>(rankMapModule,mapParams);
+    // rank maps are read only once built, with shareJobState the ranks of
+    // a job in this process use the same one
+    if ( ! params.find<bool>("_shareJobState", false) ) {
+        m_rankMap.reset( loadModule<EmberRankMap>(rankMapModule,mapParams) );
+    } else {
+        m_rankMap = EmberJobState::shareRankMap( rankMapModule, mapParams,
+            [&]() { return loadModule<EmberRankMap>(rankMapModule,mapParams); } );
+    }
 
-    if(NULL == m_rankMap) {
+    if(!m_rankMap) {
         std::cerr << "Error: Unable to load rank map scheme: \'"
 								 << rankMapModule << "\'" << std::endl;
         exit(-1);
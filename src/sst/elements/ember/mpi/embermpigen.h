@@ -16,6 +16,8 @@
 #ifndef _H_EMBER_MPI_GENERATOR
 #define _H_EMBER_MPI_GENERATOR
 
+#include <memory>
+
 #include "embergen.h"
 #include "libs/emberMpiLib.h"
 
@@ -43,11 +45,13 @@ namespace Ember {
 #define enQ_testany mpi().testany
 
 #define enQ_barrier mpi().barrier
+#define enQ_barrierOffload mpi().barrierOffload
 #define enQ_bcast mpi().bcast
 #define enQ_scatter mpi().scatter
 #define enQ_scatterv mpi().scatterv
 #define enQ_reduce mpi().reduce
 #define enQ_allreduce mpi().allreduce
+#define enQ_allreduceOffload mpi().allreduceOffload
 #define enQ_alltoall mpi().alltoall
 #define enQ_alltoallv mpi().alltoallv
 #define enQ_allgather mpi().allgather
@@ -124,7 +128,7 @@ protected:
 		return 0;
 	}
 
-	EmberRankMap* getRankMap() { return m_rankMap; }
+	EmberRankMap* getRankMap() { return m_rankMap.get(); }
 
 	void memSetBacked() {
 		EmberGenerator::memSetBacked();
@@ -138,7 +142,8 @@ protected:
 
 private:
 	EmberMpiLib*	m_mpi;
-	EmberRankMap*	m_rankMap;
+	// shared with the job state cache and other ranks under shareJobState
+	std::shared_ptr<EmberRankMap>	m_rankMap;
 };
 
 
@@ -33,6 +33,8 @@ EmberAllreduceGenerator::EmberAllreduceGenerator(SST::ComponentId_t id,
 	m_iterations = (uint32_t) params.find("arg.iterations", 1);
 	m_compute    = (uint32_t) params.find("arg.compute", 0);
 	m_count      = (uint32_t) params.find("arg.count", 1);
+	m_offload    = params.find<bool>("arg.offload", false);
+	m_verify     = params.find<bool>("arg.verify", false);
 	if ( params.find<bool>("arg.doUserFunc", false )  )   {
 		m_op = op_create( test, 0 );
 	} else {
@@ -43,6 +45,9 @@ EmberAllreduceGenerator::EmberAllreduceGenerator(SST::ComponentId_t id,
 bool EmberAllreduceGenerator::generate( std::queue<EmberEvent*>& evQ) {
 
     if ( m_loopIndex == m_iterations ) {
+        if ( m_verify ) {
+            check();
+        }
         if ( 0 == rank() ) {
             double latency = (double)(m_stopTime-m_startTime)/(double)m_iterations;
             latency /= 1000000000.0;
@@ -55,14 +60,36 @@ bool EmberAllreduceGenerator::generate( std::queue<EmberEvent*>& evQ) {
 		memSetBacked();
 		m_sendBuf = memAlloc(sizeofDataType(DOUBLE)*m_count);
 		m_recvBuf = memAlloc(sizeofDataType(DOUBLE)*m_count);
+        if ( m_verify ) {
+            for ( uint32_t i = 0; i < m_count; i++ ) {
+                ((double*) m_sendBuf)[i] = rank() + i;
+            }
+        }
         enQ_getTime( evQ, &m_startTime );
     }
 
     enQ_compute( evQ, m_compute );
-    enQ_allreduce( evQ, m_sendBuf, m_recvBuf, m_count, DOUBLE, m_op, GroupWorld );
+    if ( m_offload ) {
+        enQ_allreduceOffload( evQ, m_sendBuf, m_recvBuf, m_count, DOUBLE, m_op, GroupWorld );
+    } else {
+        enQ_allreduce( evQ, m_sendBuf, m_recvBuf, m_count, DOUBLE, m_op, GroupWorld );
+    }
 
     if ( ++m_loopIndex == m_iterations ) {
         enQ_getTime( evQ, &m_stopTime );
     }
     return false;
 }
+
+// every rank contributed rank + i to element i
+void EmberAllreduceGenerator::check()
+{
+    for ( uint32_t i = 0; i < m_count; i++ ) {
+        double want = (double) size() * ( size() - 1 ) / 2 + (double) i * size();
+        double got = ((double*) m_recvBuf)[i];
+        if ( got != want ) {
+            fatal( CALL_INFO, -1, "rank %d: element %u of the allreduce is %f, expected %f\n",
+                    rank(), i, got, want );
+        }
+    }
+}
@@ -39,6 +39,8 @@ public:
         {   "arg.compute",      "Sets the time spent computing",        "1"},
         {   "arg.count",        "Sets the number of elements to reduce",        "1"},
         {   "arg.doUserFunc",   "Test reduce operation",        "false"},
+        {   "arg.offload",      "Run the allreduce on the NIC",        "false"},
+        {   "arg.verify",       "Fill the input and check the sum on every rank",        "false"},
     )
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -70,11 +72,15 @@ public:
     bool generate( std::queue<EmberEvent*>& evQ);
 
 private:
+    void check();
+
     uint64_t  m_startTime;
     uint64_t  m_stopTime;
     uint64_t m_compute;
 	uint32_t m_iterations;
 	uint32_t m_count;
+    bool     m_offload;
+    bool     m_verify;
     void*    m_sendBuf;
     void*    m_recvBuf;
     uint32_t m_loopIndex;
@@ -25,6 +25,7 @@ EmberBarrierGenerator::EmberBarrierGenerator(SST::ComponentId_t id, Params& para
 {
 	m_iterations = (uint32_t) params.find("arg.iterations", 1);
     m_compute    = (uint32_t) params.find("arg.compute", 0);
+    m_offload    = params.find<bool>("arg.offload", false);
 }
 
 bool EmberBarrierGenerator::generate( std::queue<EmberEvent*>& evQ )
@@ -43,7 +44,11 @@ bool EmberBarrierGenerator::generate( std::queue<EmberEvent*>& evQ )
     }
 
     enQ_compute( evQ, m_compute );
-    enQ_barrier( evQ, GroupWorld );
+    if ( m_offload ) {
+        enQ_barrierOffload( evQ, GroupWorld );
+    } else {
+        enQ_barrier( evQ, GroupWorld );
+    }
 
     if ( ++m_loopIndex == m_iterations ) {
         enQ_getTime( evQ, &m_stopTime );
@@ -37,6 +37,7 @@ public:
     SST_ELI_DOCUMENT_PARAMS(
         {   "arg.iterations",   "Sets the number of barrier operations to perform",     "1024"},
         {   "arg.compute",      "Sets the time spent computing",        "1"},
+        {   "arg.offload",      "Run the barrier on the NIC",        "false"},
     )
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -73,6 +74,7 @@ private:
     uint64_t m_startTime;
     uint64_t m_stopTime;
     uint64_t m_compute;
+    bool     m_offload;
 
 };
 
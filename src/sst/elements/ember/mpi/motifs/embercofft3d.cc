@@ -0,0 +1,253 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include "embercofft3d.h"
+
+#ifdef EMBER_HAVE_COROUTINES
+
+#include <math.h>
+
+using namespace SST::Ember;
+
+// n elements over parts ranks, the first n % parts get one more
+static std::vector<int> split( int n, unsigned parts )
+{
+    std::vector<int> count( parts, n / parts );
+    for ( unsigned i = 0; i < (unsigned) n % parts; i++ ) {
+        ++count[i];
+    }
+    return count;
+}
+
+// displacements are the running sum of the counts
+static void displacements( const std::vector<int>& cnts, std::vector<int>& dsp )
+{
+    dsp.resize( cnts.size() );
+    int offset = 0;
+    for ( unsigned i = 0; i < cnts.size(); i++ ) {
+        dsp[i] = offset;
+        offset += cnts[i];
+    }
+}
+
+EmberCoFFT3DGenerator::EmberCoFFT3DGenerator(SST::ComponentId_t id, Params& params) :
+	EmberCoroutineGenerator(id, params, "CoFFT3D"),
+    m_transCostPer(6)
+{
+	m_np0 = params.find<uint32_t>("arg.nx", 100);
+	m_np1 = params.find<uint32_t>("arg.ny", 100);
+	m_np2 = params.find<uint32_t>("arg.nz", 100);
+
+    assert( m_np0 == m_np1 );
+    assert( m_np1 == m_np2 );
+
+    m_nprow = params.find<uint32_t>("arg.npRow", 0);
+    assert( 0 < m_nprow );
+
+	m_iterations = params.find<uint32_t>("arg.iterations", 1);
+
+    m_nsPerElement = params.find<float>("arg.nsPerElement",1);
+
+    m_transCostPer[0] = params.find<float>("arg.fwd_fft1",1);
+    m_transCostPer[1] = params.find<float>("arg.fwd_fft2",1);
+    m_transCostPer[2] = params.find<float>("arg.fwd_fft3",1);
+    m_transCostPer[3] = params.find<float>("arg.bwd_fft1",1);
+    m_transCostPer[4] = params.find<float>("arg.bwd_fft2",1);
+    m_transCostPer[5] = params.find<float>("arg.bwd_fft3",1);
+}
+
+void EmberCoFFT3DGenerator::initTimes( std::vector<uint64_t>& fwdTime, std::vector<uint64_t>& bwdTime )
+{
+    double cost = m_nsPerElement * m_np0 * ((m_np1 * m_np2)/size());
+
+    if ( haveComputeModel() ) {
+        // same phase as FFT3DMotif
+        const double elements = (double) m_np0 * ((m_np1 * m_np2)/size());
+        const double passes = log2( (double) m_np0 );
+
+        EmberComputePhase phase;
+        phase.flops = 5.0 * elements * passes;
+        phase.l1Bytes = 2.0 * 16 * elements * passes;
+        phase.memBytes = 2.0 * 16 * elements;
+        phase.l2Bytes = phase.memBytes;
+        phase.l3Bytes = phase.memBytes;
+
+        cost = computeModel().calcTimeNS( phase );
+    }
+	if ( 0 == rank() ) {
+	   	output("%s: nsPerElement=%.5f %.2f %.2f %.2f"
+			" %.2f %.2f %.2f\n", getMotifName().c_str(), m_nsPerElement,
+			m_transCostPer[0], m_transCostPer[1], m_transCostPer[2],
+			m_transCostPer[3], m_transCostPer[4], m_transCostPer[5]);
+	}
+	assert( cost > 0.0 );
+
+    fwdTime.assign( 3, cost );
+    bwdTime.assign( 3, cost );
+    bwdTime[2] *= 2;
+
+    for ( unsigned i = 0; i < 3; i++ ) {
+        fwdTime[i] *= m_transCostPer[i];
+        bwdTime[i] *= m_transCostPer[3 + i];
+    }
+}
+
+EmberTask EmberCoFFT3DGenerator::run()
+{
+    const unsigned nprow = m_nprow;
+    const unsigned npcol = size() / nprow;
+    assert( 0 == (size() % nprow) );
+
+    const unsigned myRow = rank() % nprow;
+    const unsigned myCol = rank() / nprow;
+    verbose(CALL_INFO, 2, 0, "%d: nx=%d ny=%d nx=%d nprow=%d "
+        "npcol=%d myRow=%d myCol=%d\n",
+            rank(), m_np0, m_np1, m_np2, nprow, npcol, myRow, myCol );
+
+    std::vector<uint64_t> fwdTime;
+    std::vector<uint64_t> bwdTime;
+    initTimes( fwdTime, bwdTime );
+
+    std::vector<int> rowGrpRanks( npcol );
+    std::vector<int> colGrpRanks( nprow );
+    for ( unsigned i = 0; i < npcol; i++ ) {
+        rowGrpRanks[i] = myRow + i * nprow;
+    }
+    for ( unsigned i = 0; i < nprow; i++ ) {
+        colGrpRanks[i] = myCol * nprow + i;
+    }
+
+    const std::vector<int> np0loc_row = split( m_np0/2 + 1, nprow );
+    const std::vector<int> np1loc_row = split( m_np1, nprow );
+    const std::vector<int> np1loc_col = split( m_np1, npcol );
+    const std::vector<int> np2loc_col = split( m_np2, npcol );
+
+    const int np0loc = np0loc_row[myRow];
+    const int np1locf = np1loc_row[myRow];
+    const int np1locb = np1loc_col[myCol];
+    const int np2loc = np2loc_col[myCol];
+
+    verbose(CALL_INFO, 2, 0, "np0half=%d np0loc=%d np1locf_=%d "
+            "np1locb_%d np2loc_=%d\n", m_np0/2 + 1, np0loc, np1locf, np1locb, np2loc );
+
+    std::vector<int> rowSendCnts( npcol ), rowSendDsp;
+    std::vector<int> rowRecvCnts( npcol ), rowRecvDsp;
+    for ( unsigned i = 0; i < npcol; i++ ) {
+        rowSendCnts[i] = 2 * np0loc * np1loc_col[i] * np2loc;
+        rowRecvCnts[i] = 2 * np0loc * np1locb * np2loc_col[i];
+    }
+    displacements( rowSendCnts, rowSendDsp );
+    displacements( rowRecvCnts, rowRecvDsp );
+
+    // the backward column exchange is the forward one reversed
+    std::vector<int> colSendCnts_f( nprow ), colSendDsp_f;
+    std::vector<int> colRecvCnts_f( nprow ), colRecvDsp_f;
+    for ( unsigned i = 0; i < nprow; i++ ) {
+        colSendCnts_f[i] = 2 * np0loc_row[i] * np1locf * np2loc;
+        colRecvCnts_f[i] = 2 * np0loc * np1loc_row[i] * np2loc;
+    }
+    displacements( colSendCnts_f, colSendDsp_f );
+    displacements( colRecvCnts_f, colRecvDsp_f );
+
+    std::vector<int>& colSendCnts_b = colRecvCnts_f;
+    std::vector<int>& colSendDsp_b = colRecvDsp_f;
+    std::vector<int>& colRecvCnts_b = colSendCnts_f;
+    std::vector<int>& colRecvDsp_b = colSendDsp_f;
+
+    int size1 = m_np0 * np1locf * np2loc;
+    int size2 = m_np1 * m_np0 * np2loc / nprow;
+    int size3 = m_np2 * np1locb * m_np0 / nprow;
+
+    int maxsize = (size1 > size2 ? size1 : size2);
+    maxsize = (maxsize > size3 ? maxsize : size3);
+    void* sendBuf = memAlloc( maxsize * COMPLEX );
+    void* recvBuf = memAlloc( maxsize * COMPLEX );
+    verbose(CALL_INFO, 2, 0,"maxsize=%d\n",maxsize);
+
+    Communicator rowComm;
+    Communicator colComm;
+    enQ_commCreate( evQ(), GroupWorld, rowGrpRanks, &rowComm );
+    enQ_commCreate( evQ(), GroupWorld, colGrpRanks, &colComm );
+    co_await issue();
+
+    uint64_t forwardStart, forwardStop, backwardStop;
+    uint64_t forwardTotal = 0;
+    uint64_t backwardTotal = 0;
+
+    for ( uint32_t i = 0; i < m_iterations; i++ ) {
+        verbose(CALL_INFO, 1, 0, "loop=%d\n", i );
+
+        enQ_getTime( evQ(), &forwardStart );
+
+        enQ_compute( evQ(), fwdTime[0] );
+
+        enQ_alltoallv( evQ(),
+                    sendBuf, &colSendCnts_f[0], &colSendDsp_f[0], DOUBLE,
+                    recvBuf, &colRecvCnts_f[0], &colRecvDsp_f[0], DOUBLE,
+                    colComm );
+
+        enQ_compute( evQ(), fwdTime[1] );
+
+        enQ_alltoallv( evQ(), sendBuf, &rowSendCnts[0], &rowSendDsp[0], DOUBLE,
+                            recvBuf, &rowRecvCnts[0], &rowRecvDsp[0], DOUBLE,
+                            rowComm );
+
+        enQ_compute( evQ(), fwdTime[2] );
+
+        enQ_barrier( evQ(), GroupWorld );
+        enQ_getTime( evQ(), &forwardStop );
+
+        enQ_compute( evQ(), bwdTime[0] );
+
+        enQ_alltoallv( evQ(), sendBuf, &rowSendCnts[0], &rowSendDsp[0], DOUBLE,
+                            recvBuf, &rowRecvCnts[0], &rowRecvDsp[0], DOUBLE,
+                            rowComm );
+
+        enQ_compute( evQ(), bwdTime[1] );
+
+        enQ_alltoallv( evQ(),
+                    sendBuf, &colSendCnts_b[0], &colSendDsp_b[0], DOUBLE,
+                    recvBuf, &colRecvCnts_b[0], &colRecvDsp_b[0], DOUBLE,
+                    colComm );
+
+        enQ_compute( evQ(), bwdTime[2] );
+
+        enQ_barrier( evQ(), GroupWorld );
+        enQ_getTime( evQ(), &backwardStop );
+
+        if ( i + 1 == m_iterations ) {
+            enQ_commDestroy( evQ(), rowComm );
+            enQ_commDestroy( evQ(), colComm );
+        }
+        co_await issue();
+
+        forwardTotal += forwardStop - forwardStart;
+        backwardTotal += backwardStop - forwardStop;
+    }
+
+    memFree( sendBuf );
+    memFree( recvBuf );
+
+    if ( 0 == rank() ) {
+        output("%s: nRanks=%d fwd time %f sec\n", getMotifName().c_str(), size(),
+            ((double) forwardTotal / 1000000000.0) / m_iterations );
+        output("%s: rRanks=%d bwd time %f sec\n", getMotifName().c_str(), size(),
+            ((double) backwardTotal / 1000000000.0) / m_iterations );
+    }
+}
+
+#endif
@@ -0,0 +1,105 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_EMBER_CO_FFT_3D
+#define _H_EMBER_CO_FFT_3D
+
+#include "mpi/embermpigen.h"
+#include "embercoroutine.h"
+
+#ifdef EMBER_HAVE_COROUTINES
+
+namespace SST {
+namespace Ember {
+
+// FFT3DMotif written as a coroutine. It queues the same events in the same
+// order, the decomposition and the alltoallv counts live in the coroutine
+// frame instead of the generator.
+class EmberCoFFT3DGenerator : public EmberCoroutineGenerator<EmberMessagePassingGenerator> {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        EmberCoFFT3DGenerator,
+        "ember",
+        "CoFFT3DMotif",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Models an FFT, written as a coroutine",
+        SST::Ember::EmberGenerator
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        { "arg.nx",         "Sets the size of a block in X", "8" },
+        { "arg.ny",         "Sets the size of a block in Y", "8" },
+        { "arg.nz",         "Sets the size of a block in Z", "8" },
+        { "arg.npRow",      "Sets the number of rows in the PE decomposition", "0" },
+        { "arg.iterations", "Sets the number of FFT iterations to perform",   "1"},
+        { "arg.nsPerElement",  "Sets the compute time per element of a transform, replaced by the computeModel if one is set", "1" },
+        { "arg.fwd_fft1",  "", "" },
+        { "arg.fwd_fft2",  "", "" },
+        { "arg.fwd_fft3",  "", "" },
+        { "arg.bwd_fft1",  "", "" },
+        { "arg.bwd_fft2",  "", "" },
+        { "arg.bwd_fft3",  "", "" },
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "time-Init", "Time spent in Init event",          "ns",  0},
+        { "time-Finalize", "Time spent in Finalize event",  "ns", 0},
+        { "time-Rank", "Time spent in Rank event",          "ns", 0},
+        { "time-Size", "Time spent in Size event",          "ns", 0},
+        { "time-Send", "Time spent in Recv event",          "ns", 0},
+        { "time-Recv", "Time spent in Recv event",          "ns", 0},
+        { "time-Irecv", "Time spent in Irecv event",        "ns", 0},
+        { "time-Isend", "Time spent in Isend event",        "ns", 0},
+        { "time-Wait", "Time spent in Wait event",          "ns", 0},
+        { "time-Waitall", "Time spent in Waitall event",    "ns", 0},
+        { "time-Waitany", "Time spent in Waitany event",    "ns", 0},
+        { "time-Compute", "Time spent in Compute event",    "ns", 0},
+        { "time-Barrier", "Time spent in Barrier event",    "ns", 0},
+        { "time-Alltoallv", "Time spent in Alltoallv event", "ns", 0},
+        { "time-Alltoall", "Time spent in Alltoall event",  "ns", 0},
+        { "time-Allreduce", "Time spent in Allreduce event", "ns", 0},
+        { "time-Reduce", "Time spent in Reduce event",      "ns", 0},
+        { "time-Bcast", "Time spent in Bcast event",        "ns", 0},
+        { "time-Gettime", "Time spent in Gettime event",    "ns", 0},
+        { "time-Commsplit", "Time spent in Commsplit event", "ns", 0},
+        { "time-Commcreate", "Time spent in Commcreate event", "ns", 0},
+    )
+
+public:
+	EmberCoFFT3DGenerator(SST::ComponentId_t, Params& params);
+
+private:
+    EmberTask run();
+
+    // per transform times, forward then backward
+    void initTimes( std::vector<uint64_t>& fwdTime, std::vector<uint64_t>& bwdTime );
+
+    int         m_np0;
+    int         m_np1;
+    int         m_np2;
+    unsigned    m_nprow;
+	uint32_t    m_iterations;
+    float       m_nsPerElement;
+    std::vector<float> m_transCostPer;
+};
+
+}
+}
+
+#endif
+
+#endif
@@ -0,0 +1,116 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include "embercopingpong.h"
+
+#ifdef EMBER_HAVE_COROUTINES
+
+using namespace SST::Ember;
+
+#define TAG 0xDEADBEEF
+
+EmberCoPingPongGenerator::EmberCoPingPongGenerator(SST::ComponentId_t id, Params& params ) :
+	EmberCoroutineGenerator(id, params, "CoPingPong")
+{
+	m_messageSize = (uint32_t) params.find("arg.messageSize", 1024);
+	m_iterations = (uint32_t) params.find("arg.iterations", 1);
+	m_rank2 = (uint32_t) params.find("arg.rank2", 1);
+
+    m_sendBuf = memAlloc(m_messageSize);
+    m_recvBuf = memAlloc(m_messageSize);
+    m_blockingSend = (uint32_t) params.find("arg.blockingSend", true);
+    m_blockingRecv = (uint32_t) params.find("arg.blockingRecv", true);
+    m_waitall = (uint32_t) params.find("arg.waitall", false);
+}
+
+void EmberCoPingPongGenerator::enQ_pingSend( int peer, MessageRequest* req )
+{
+    if ( m_blockingSend ) {
+        enQ_send( evQ(), m_sendBuf, m_messageSize, CHAR, peer, TAG, GroupWorld );
+    } else {
+        enQ_isend( evQ(), m_sendBuf, m_messageSize, CHAR, peer, TAG, GroupWorld, req );
+        if ( m_waitall ) {
+            enQ_waitall( evQ(), 1, req, NULL );
+        } else {
+            enQ_wait( evQ(), req );
+        }
+    }
+}
+
+void EmberCoPingPongGenerator::enQ_pingRecv( int peer, MessageRequest* req, MessageResponse* resp )
+{
+    if ( m_blockingRecv ) {
+        enQ_recv( evQ(), m_recvBuf, m_messageSize, CHAR, peer, TAG, GroupWorld, resp );
+    } else {
+        enQ_irecv( evQ(), m_recvBuf, m_messageSize, CHAR, peer, TAG, GroupWorld, req );
+        if ( m_waitall ) {
+            enQ_waitall( evQ(), 1, req, NULL );
+        } else {
+            enQ_wait( evQ(), req, resp );
+        }
+    }
+}
+
+EmberTask EmberCoPingPongGenerator::run()
+{
+    if ( ! ( 0 == rank() || m_rank2 == rank() ) ) {
+        co_return;
+    }
+
+    verbose(CALL_INFO, 1, 0, "rank=%d size=%d\n", rank(), size());
+
+    // these live in the coroutine frame until the motif returns
+    uint64_t startTime, stopTime;
+    MessageRequest sendReq, recvReq;
+    MessageResponse resp;
+
+    if ( 0 == rank() ) {
+        output("rank2=%d messageSize=%d iterations=%d\n",m_rank2, m_messageSize, m_iterations);
+        enQ_getTime( evQ(), &startTime );
+    }
+
+    for ( uint32_t i = 0; i < m_iterations; i++ ) {
+        if ( 0 == rank() ) {
+            enQ_pingSend( m_rank2, &sendReq );
+            enQ_pingRecv( m_rank2, &recvReq, &resp );
+        } else {
+            enQ_pingRecv( 0, &recvReq, &resp );
+            enQ_pingSend( 0, &sendReq );
+        }
+        co_await issue();
+    }
+
+    enQ_getTime( evQ(), &stopTime );
+    co_await issue();
+
+    if ( 0 == rank() ) {
+        double totalTime = (double)(stopTime - startTime)/1000000000.0;
+
+        double latency = ((totalTime/m_iterations)/2);
+        double bandwidth = (double) m_messageSize / latency;
+
+        output("%s: otherRank %d, total time %.3f us, loop %d, bufLen %d"
+                ", latency %.3f us. bandwidth %f GB/s\n",
+                            getMotifName().c_str(), m_rank2,
+                            totalTime * 1000000.0, m_iterations,
+                            m_messageSize,
+                            latency * 1000000.0,
+                            bandwidth / 1000000000.0 );
+    }
+}
+
+#endif
@@ -0,0 +1,88 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include "embercoring.h"
+
+#ifdef EMBER_HAVE_COROUTINES
+
+using namespace SST::Ember;
+
+#define TAG 0xDEADBEEF
+#define DATA_TYPE CHAR
+
+EmberCoRingGenerator::EmberCoRingGenerator(SST::ComponentId_t id, Params& params) :
+	EmberCoroutineGenerator(id, params, "CoRing")
+{
+	m_messageSize = (uint32_t) params.find("arg.messagesize", 1024);
+	m_iterations = (uint32_t) params.find("arg.iterations", 1);
+}
+
+EmberTask EmberCoRingGenerator::run()
+{
+    verbose( CALL_INFO, 1, 0, "rank=%d size=%d\n", rank(), size());
+
+    size_t nBytes = m_messageSize * sizeofDataType(DATA_TYPE);
+    void* sendBuf = memAlloc( nBytes );
+    void* recvBuf = memAlloc( nBytes );
+
+    int to = ( rank() + 1 ) % size();
+    int from = ( rank() + size() - 1 ) % size();
+    verbose( CALL_INFO, 2, 0, "to=%d from=%d\n",to,from);
+
+    uint64_t startTime, stopTime;
+    MessageResponse resp;
+
+    enQ_getTime( evQ(), &startTime );
+
+    for ( uint32_t i = 0; i < m_iterations; i++ ) {
+        if ( 0 == rank() ) {
+            enQ_send( evQ(), sendBuf, m_messageSize, DATA_TYPE, to, TAG, GroupWorld );
+            enQ_recv( evQ(), recvBuf, m_messageSize, DATA_TYPE, from, TAG, GroupWorld, &resp );
+        } else {
+            enQ_recv( evQ(), recvBuf, m_messageSize, DATA_TYPE, from, TAG, GroupWorld, &resp );
+            enQ_send( evQ(), sendBuf, m_messageSize, DATA_TYPE, to, TAG, GroupWorld );
+        }
+        co_await issue();
+
+        int count;
+        get_count( &resp, DATA_TYPE, &count );
+        verbose( CALL_INFO, 2, 0, "received %d from %d\n", count, from );
+    }
+
+    enQ_getTime( evQ(), &stopTime );
+    co_await issue();
+
+    memFree( sendBuf );
+    memFree( recvBuf );
+
+    if ( 0 == rank()) {
+        double totalTime = (double)(stopTime - startTime)/1000000000.0;
+
+        double latency = ((totalTime/m_iterations)/size());
+        double bandwidth = (double) nBytes / latency;
+
+        output("%s total time %.3f us, loop %d, bufLen %zu"
+                ", latency %.3f us. bandwidth %f GB/s\n",
+                            getMotifName().c_str(),
+                            totalTime * 1000000.0, m_iterations,
+                            nBytes,
+                            latency * 1000000.0,
+                            bandwidth / 1000000000.0 );
+    }
+}
+
+#endif
@@ -17,6 +17,8 @@
 
 #include "emberfft3d.h"
 
+#include <math.h>
+
 #include <iostream>
 #include <fstream>
 
@@ -264,6 +266,23 @@ void EmberFFT3DGenerator::initTimes( int numPe, int x, int y, int z, float nsPer
 #endif
 
     double cost = nsPerElement * x * ((y * z)/numPe);
+
+    if ( haveComputeModel() ) {
+        // a radix-2 FFT of length x is 5 x log2(x) flops on complex doubles,
+        // each pass loads and stores every element, memory sees one read
+        // and one write
+        const double elements = (double) x * ((y * z)/numPe);
+        const double passes = log2( (double) x );
+
+        EmberComputePhase phase;
+        phase.flops = 5.0 * elements * passes;
+        phase.l1Bytes = 2.0 * 16 * elements * passes;
+        phase.memBytes = 2.0 * 16 * elements;
+        phase.l2Bytes = phase.memBytes;
+        phase.l3Bytes = phase.memBytes;
+
+        cost = computeModel().calcTimeNS( phase );
+    }
 	if ( 0 == rank() ) {
 	   	output("%s: nsPerElement=%.5f %.2f %.2f %.2f"
 			" %.2f %.2f %.2f\n", getMotifName().c_str(), nsPerElement,
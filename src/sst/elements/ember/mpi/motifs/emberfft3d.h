@@ -40,7 +40,7 @@ public:
         { "arg.nz",         "Sets the size of a block in Z", "8" },
         { "arg.npRow",      "Sets the number of rows in the PE decomposition", "0" },
         { "arg.iterations", "Sets the number of FFT iterations to perform",   "1"},
-        { "arg.nsPerElement",  "", "" },
+        { "arg.nsPerElement",  "Sets the compute time per element of a transform, replaced by the computeModel if one is set", "1" },
         { "arg.fwd_fft1",  "", "" },
         { "arg.fwd_fft2",  "", "" },
         { "arg.fwd_fft3",  "", "" },
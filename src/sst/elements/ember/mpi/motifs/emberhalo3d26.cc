@@ -43,6 +43,24 @@ EmberHalo3D26Generator::EmberHalo3D26Generator(SST::ComponentId_t id, Params& pa
 	if ( params.contains("arg.computetime") ) {
 		nsCompute  = (uint64_t) params.find<uint64_t>("arg.computetime");
 		compute_the_time = nsCompute;
+	} else if ( haveComputeModel() ) {
+		const double cells = (double) total_grid_points * items_per_cell;
+
+		// each value is streamed in from memory and its update written back,
+		// the neighbour loads of the stencil hit in L1
+		EmberComputePhase phase;
+		phase.flops = cells * flops_per_cell;
+		phase.vectorFraction = params.find<double>("arg.vectorfraction", 1.0);
+		phase.l1Bytes = cells * params.find<double>("arg.l1bytespercell", (flops_per_cell + 2) * sizeof_cell);
+		phase.memBytes = cells * params.find<double>("arg.membytespercell", 2 * sizeof_cell);
+		phase.l2Bytes = phase.memBytes;
+		phase.l3Bytes = phase.memBytes;
+
+		compute_the_time = computeModel().calcTimeNS( phase );
+
+		if(0 == rank()) {
+			output("Halo3D: modeled flops: %.0f, memory bytes: %.0f\n", phase.flops, phase.memBytes);
+		}
 	} else {
 		uint64_t total_flops       = total_grid_points * ((uint64_t) items_per_cell) * ((uint64_t) flops_per_cell);
 		double pe_flops = params.find<double>("arg.peflops", 1000000000);
@@ -47,6 +47,9 @@ public:
         {   "arg.flopspercell",     "Sets the number of number of floating point operations per cell, default is 26 (27 point stencil)",    "26"},
         {   "arg.computetime",      "Sets the number of nanoseconds to compute for",    "10"},
         {   "arg.peflops",      "Sets the FLOP/s rate of the processor (used to calculate compute time if not supplied, default is 10000000000 FLOP/s)", "10000000000"},
+        {   "arg.vectorfraction",   "Sets the fraction of the stencil flops that vectorize, used with a computeModel",  "1.0"},
+        {   "arg.l1bytespercell",   "Sets the L1 load/store bytes per cell, used with a computeModel, default is (flopspercell + 2) * datatype_width", ""},
+        {   "arg.membytespercell",  "Sets the memory bytes per cell, used with a computeModel, default is 2 * datatype_width",  ""},
         {   "arg.copytime",     "Sets the time spent copying data between messages",    "5"},
         {   "arg.iterations",       "Sets the number of ping pong operations to perform",   "10"},
     )
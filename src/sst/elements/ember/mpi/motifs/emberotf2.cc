@@ -60,7 +60,9 @@ static OTF2_CallbackCode EmberOTF2EnterRegion(
 
 	EmberOTF2Generator* gen = (EmberOTF2Generator*) userData;
 
-	if( gen->getCurrentTime() == 0 ) {
+	if( NULL != gen->getSkeleton() ) {
+		gen->enterRegion( time );
+	} else if( gen->getCurrentTime() == 0 ) {
 		gen->setCurrentTime( time );
 	}
 
@@ -76,6 +78,11 @@ static OTF2_CallbackCode EmberOTF2LeaveRegion(
 
 	EmberOTF2Generator* gen = (EmberOTF2Generator*) userData;
 
+	if( NULL != gen->getSkeleton() ) {
+		gen->leaveRegion( time );
+		return OTF2_CALLBACK_SUCCESS;
+	}
+
 	OTF2_TimeStamp timeDiff = time - gen->getCurrentTime();
 	gen->verbose( CALL_INFO, 4, 0, "Time-Difference: %" PRIu64 "\n", timeDiff );
 	gen->setCurrentTime( time );
@@ -94,6 +101,13 @@ static OTF2_CallbackCode EmberOTF2MPISend(
 	uint64_t msgLen) {
 
 	EmberOTF2Generator* gen = (EmberOTF2Generator*) userData;
+
+	if( NULL != gen->getSkeleton() ) {
+		gen->markMPICall();
+		gen->getSkeleton()->addSend( receiver, tag, msgLen );
+		return OTF2_CALLBACK_SUCCESS;
+	}
+
 	gen->enQ_send( *(gen->getEventQueue()), 0, msgLen, gen->extractDataTypeFromAttributeList(attributes), receiver, tag, GroupWorld );
 
 	return OTF2_CALLBACK_SUCCESS;
@@ -110,9 +124,16 @@ static OTF2_CallbackCode EmberOTF2MPIISend(
         uint64_t msgLen,
 	uint64_t reqID) {
 
+	EmberOTF2Generator* gen = (EmberOTF2Generator*) userData;
+
+	if( NULL != gen->getSkeleton() ) {
+		gen->markMPICall();
+		gen->getSkeleton()->addIsend( receiver, tag, msgLen, reqID );
+		return OTF2_CALLBACK_SUCCESS;
+	}
+
 	MessageRequest* newReq = new MessageRequest();
 
-	EmberOTF2Generator* gen = (EmberOTF2Generator*) userData;
 	gen->enQ_isend( *(gen->getEventQueue()), 0, msgLen, gen->extractDataTypeFromAttributeList(attributes), receiver, tag, GroupWorld, newReq );
 
 	gen->getRequestMap().insert( std::pair<uint64_t, MessageRequest*>( reqID, newReq ) );
@@ -130,6 +151,15 @@ static OTF2_CallbackCode EmberOTF2MPIISendComplete(
 	EmberOTF2Generator* gen = (EmberOTF2Generator*) userData;
 	gen->verbose( CALL_INFO, 4, 0, "Trace::ISendComplete, reqID=%" PRIu64 "\n", reqID );
 
+	if( NULL != gen->getSkeleton() ) {
+		gen->markMPICall();
+		if( ! gen->getSkeleton()->addWait( reqID ) ) {
+			gen->fatal( CALL_INFO, -1, "Error: search for request ID %" PRIu64 " did not find a request.\n",
+				reqID);
+		}
+		return OTF2_CALLBACK_SUCCESS;
+	}
+
 	auto checkReq = gen->getRequestMap().find(reqID);
 
 	if( checkReq == gen->getRequestMap().end() ) {
@@ -183,6 +213,12 @@ static OTF2_CallbackCode EmberOTF2MPIRecv(
 	gen->verbose( CALL_INFO, 4, 0, "Trace::Recv sender=%" PRIu32 ", tag=%" PRIu32 ", len=%" PRIu64 "\n",
 		sender, tag, msgLen);
 
+	if( NULL != gen->getSkeleton() ) {
+		gen->markMPICall();
+		gen->getSkeleton()->addRecv( sender, tag, msgLen );
+		return OTF2_CALLBACK_SUCCESS;
+	}
+
         gen->enQ_recv( *(gen->getEventQueue()), 0, msgLen, gen->extractDataTypeFromAttributeList(attributes), sender, tag, GroupWorld );
 
 	return OTF2_CALLBACK_SUCCESS;
@@ -215,6 +251,12 @@ static OTF2_CallbackCode EmberOTF2MPIIRecv(
 	gen->verbose( CALL_INFO, 4, 0, "Trace::Recv sender=%" PRIu32 ", tag=%" PRIu32 ", len=%" PRIu64 "\n",
 		sender, tag, msgLen);
 
+	if( NULL != gen->getSkeleton() ) {
+		gen->markMPICall();
+		gen->getSkeleton()->addRecv( sender, tag, msgLen );
+		return OTF2_CALLBACK_SUCCESS;
+	}
+
         gen->enQ_recv( *(gen->getEventQueue()), 0, msgLen, gen->extractDataTypeFromAttributeList(attributes), sender, tag, GroupWorld );
 
         return OTF2_CALLBACK_SUCCESS;
@@ -244,6 +286,30 @@ static OTF2_CallbackCode EmberOTF2MPICollectiveEnd(
 	gen->verbose( CALL_INFO, 4, 0, "Trace::CollectiveEnd (Triggers Start in Ember) from Root=%" PRIu32 "\n",
 		root );
 
+	if( NULL != gen->getSkeleton() ) {
+		gen->markMPICall();
+
+		switch( collectiveOp ) {
+		case OTF2_COLLECTIVE_OP_BARRIER:
+			gen->getSkeleton()->addCollective( EmberOTF2Skeleton::Barrier, 0, 0 );
+			break;
+		case OTF2_COLLECTIVE_OP_BCAST:
+			gen->getSkeleton()->addCollective( EmberOTF2Skeleton::Bcast, root, sizeSent );
+			break;
+		case OTF2_COLLECTIVE_OP_ALLREDUCE:
+			gen->getSkeleton()->addCollective( EmberOTF2Skeleton::Allreduce, 0, sizeSent );
+			break;
+		case OTF2_COLLECTIVE_OP_REDUCE:
+			gen->getSkeleton()->addCollective( EmberOTF2Skeleton::Reduce, root, sizeSent );
+			break;
+		default:
+			gen->verbose( CALL_INFO, 16, 0, "Not supported collective operation, set to ignore event.\n" );
+			break;
+		}
+
+		return OTF2_CALLBACK_SUCCESS;
+	}
+
 	switch( collectiveOp ) {
 	case OTF2_COLLECTIVE_OP_BARRIER:
 		gen->verbose( CALL_INFO, 4, 0, "Trace::Barrier\n");
@@ -288,12 +354,42 @@ static OTF2_CallbackCode EmberOTF2RegisterLocation( void* userData,
 	return OTF2_CALLBACK_SUCCESS;
 }
 
+#if OTF2_VERSION_MAJOR >= 3
+static OTF2_CallbackCode EmberOTF2ClockProperties( void* userData,
+	uint64_t timerResolution, uint64_t globalOffset, uint64_t traceLength,
+	uint64_t realtimeTimestamp ) {
+#else
+static OTF2_CallbackCode EmberOTF2ClockProperties( void* userData,
+	uint64_t timerResolution, uint64_t globalOffset, uint64_t traceLength ) {
+#endif
+
+	EmberOTF2Generator* gen = (EmberOTF2Generator*) userData;
+	gen->setTimerResolution( timerResolution );
+
+	return OTF2_CALLBACK_SUCCESS;
+}
+
 EmberOTF2Generator::EmberOTF2Generator(SST::ComponentId_T id, Params& params) :
 	EmberMessagePassingGenerator(id, params, "OTF2"),
-	traceLocationCount(0), currentLocation(0), currentTime(0)
+	traceLocationCount(0), currentLocation(0), currentTime(0),
+	skeleton(NULL), tickNs(0), sawMPICall(false), skeletonReduced(false),
+	replayLoop(0), replayIteration(0)
 {
 	std::string tracePrefix = params.find<std::string>("arg.tracePrefix", "");
 
+	if( params.find<bool>("arg.skeleton", false) ) {
+		skeleton = new EmberOTF2Skeleton();
+	}
+
+	computeTolerance = params.find<double>("arg.computeTolerance", 0);
+	maxPeriod = params.find<uint32_t>("arg.maxPeriod", 64);
+
+	if( computeTolerance < 0 || 0 == maxPeriod ) {
+		fatal( CALL_INFO, -1, "Error: \"computeTolerance\" must not be negative and \"maxPeriod\" must be at least 1.\n" );
+	}
+
+	setTimerResolution( params.find<uint64_t>("arg.timerResolution", 0) );
+
 	if( "" == tracePrefix ) {
 		fatal( CALL_INFO, -1, "Error: no trace was specified by the \"tracePrefix\" parameter.\n" );
 	}
@@ -372,6 +468,11 @@ EmberOTF2Generator::EmberOTF2Generator(SST::ComponentId_T id, Params& params) :
 		fatal( CALL_INFO, -1, "Error: unable to create a global definition reader.\n");
 	}
 
+	OTF2_GlobalDefReaderCallbacks* traceGlobalDefCallbacks = OTF2_GlobalDefReaderCallbacks_New();
+	OTF2_GlobalDefReaderCallbacks_SetClockPropertiesCallback( traceGlobalDefCallbacks, EmberOTF2ClockProperties );
+	OTF2_Reader_RegisterGlobalDefCallbacks( traceReader, traceGlobalDefReader, traceGlobalDefCallbacks, this );
+	OTF2_GlobalDefReaderCallbacks_Delete( traceGlobalDefCallbacks );
+
 	uint64_t globalDefinitionsRead = 0;
 	OTF2_Reader_ReadAllGlobalDefinitions( traceReader, traceGlobalDefReader, &globalDefinitionsRead );
 	verbose( CALL_INFO, 1, 0, "Read %" PRIu64 " global definitions from trace on rank %" PRIu64 "\n",
@@ -440,9 +541,90 @@ EmberOTF2Generator::EmberOTF2Generator(SST::ComponentId_T id, Params& params) :
 	traceGlobalEvtReader = OTF2_Reader_GetGlobalEvtReader( traceReader );
 
 	OTF2_GlobalEvtReader_SetCallbacks( traceGlobalEvtReader, traceGlobalEvtCallbacks, this );
+
+	if( NULL != skeleton && 0 == tickNs ) {
+		fatal( CALL_INFO, -1, "Error: the trace has no clock properties, set \"timerResolution\" to replay its skeleton.\n" );
+	}
+}
+
+void EmberOTF2Generator::reduceSkeleton() {
+	uint64_t eventsRead = 0;
+
+	if( OTF2_SUCCESS != OTF2_Reader_ReadAllGlobalEvents( traceReader, traceGlobalEvtReader, &eventsRead ) ) {
+		fatal( CALL_INFO, -1, "Error reading global events on rank %" PRIu64 "\n", rank() );
+	}
+
+	skeleton->reduce( computeTolerance, maxPeriod );
+	replayRequests.resize( skeleton->getRequestSlots() );
+	skeletonReduced = true;
+
+	verbose( CALL_INFO, 1, 0, "Rank %" PRIu64 " read %" PRIu64 " events, %" PRIu64 " operations reduced to %" PRIu64
+		" in %" PRIu64 " loops\n", rank(), eventsRead, skeleton->getRawOpCount(),
+		static_cast<uint64_t>(skeleton->getOps().size()), static_cast<uint64_t>(skeleton->getLoops().size()) );
+}
+
+bool EmberOTF2Generator::generateSkeleton( std::queue<EmberEvent*>& evQ ) {
+	if( ! skeletonReduced ) {
+		reduceSkeleton();
+	}
+
+	const std::vector<EmberOTF2Skeleton::Loop>& loops = skeleton->getLoops();
+
+	if( replayLoop == loops.size() ) {
+		return true;
+	}
+
+	// one iteration of the current loop per call
+	const EmberOTF2Skeleton::Loop& loop = loops[replayLoop];
+	const std::vector<EmberOTF2Skeleton::Op>& ops = skeleton->getOps();
+
+	for( size_t i = loop.first; i < loop.first + loop.length; i++ ) {
+		const EmberOTF2Skeleton::Op& op = ops[i];
+
+		switch( op.type ) {
+		case EmberOTF2Skeleton::Compute:
+			enQ_compute( evQ, static_cast<uint64_t>( op.computeNs + 0.5 ) );
+			break;
+		case EmberOTF2Skeleton::Send:
+			enQ_send( evQ, 0, op.length, CHAR, op.peer, op.tag, GroupWorld );
+			break;
+		case EmberOTF2Skeleton::Recv:
+			enQ_recv( evQ, 0, op.length, CHAR, op.peer, op.tag, GroupWorld );
+			break;
+		case EmberOTF2Skeleton::Isend:
+			enQ_isend( evQ, 0, op.length, CHAR, op.peer, op.tag, GroupWorld, &replayRequests[op.slot] );
+			break;
+		case EmberOTF2Skeleton::Wait:
+			enQ_wait( evQ, &replayRequests[op.slot], NULL );
+			break;
+		case EmberOTF2Skeleton::Barrier:
+			enQ_barrier( evQ, GroupWorld );
+			break;
+		case EmberOTF2Skeleton::Bcast:
+			enQ_bcast( evQ, 0, op.length, CHAR, op.peer, GroupWorld );
+			break;
+		case EmberOTF2Skeleton::Allreduce:
+			enQ_allreduce( evQ, 0, 0, op.length, CHAR, SUM, GroupWorld );
+			break;
+		case EmberOTF2Skeleton::Reduce:
+			enQ_reduce( evQ, 0, 0, op.length, CHAR, SUM, op.peer, GroupWorld );
+			break;
+		}
+	}
+
+	if( ++replayIteration == loop.count ) {
+		replayLoop++;
+		replayIteration = 0;
+	}
+
+	return replayLoop == loops.size();
 }
 
 bool EmberOTF2Generator::generate( std::queue<EmberEvent*>& evQ ) {
+	if( NULL != skeleton ) {
+		return generateSkeleton( evQ );
+	}
+
 	setEventQueue( &evQ );
 
 	uint64_t eventsRead = 0;
@@ -513,4 +695,5 @@ EmberOTF2Generator::~EmberOTF2Generator() {
 	OTF2_Reader_Close( traceReader );
 
 	traceLocations.clear();
+	delete skeleton;
 }
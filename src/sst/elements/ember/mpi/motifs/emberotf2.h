@@ -22,6 +22,8 @@
 #include "mpi/embermpigen.h"
 #include "otf2/otf2.h"
 
+#include "emberotf2skeleton.h"
+
 namespace SST {
 namespace Ember {
 
@@ -42,7 +44,11 @@ public:
     	)
 
 	SST_ELI_DOCUMENT_PARAMS(
-        	{   "arg.tracePrefix",       "Sets the location of the trace",  "" }
+        	{   "arg.tracePrefix",       "Sets the location of the trace",  "" },
+        	{   "arg.skeleton",          "Reduce the trace to its communication skeleton before replaying it, the time between MPI calls is replayed as compute", "0" },
+        	{   "arg.computeTolerance",  "Skeleton mode, relative difference allowed between the compute intervals of repeated periods", "0" },
+        	{   "arg.maxPeriod",         "Skeleton mode, most operations in a repeated period", "64" },
+        	{   "arg.timerResolution",   "Trace timer ticks per second, 0 takes it from the trace clock properties", "0" }
 	)
 
 	SST_ELI_DOCUMENT_STATISTICS(
@@ -79,6 +85,37 @@ public:
 		return currentTime;
 	}
 
+	EmberOTF2Skeleton* getSkeleton() {
+		return skeleton;
+	}
+
+	void setTimerResolution( const uint64_t ticksPerSecond ) {
+		if( 0 == tickNs && 0 != ticksPerSecond ) {
+			verbose( CALL_INFO, 2, 0, "Trace timer resolution is %" PRIu64 " ticks per second\n", ticksPerSecond );
+			tickNs = 1.0e9 / ticksPerSecond;
+		}
+	}
+
+	// Skeleton mode, time between MPI calls becomes compute. A region that
+	// contained an MPI event was the call itself and is not counted.
+	void enterRegion( const OTF2_TimeStamp t ) {
+		addComputeGap( t );
+		sawMPICall = false;
+	}
+
+	void leaveRegion( const OTF2_TimeStamp t ) {
+		if( sawMPICall ) {
+			setCurrentTime( t );
+		} else {
+			addComputeGap( t );
+		}
+		sawMPICall = false;
+	}
+
+	void markMPICall() {
+		sawMPICall = true;
+	}
+
 	std::queue<EmberEvent*>* getEventQueue() {
 		return eventQ;
 	}
@@ -109,6 +146,16 @@ public:
 	}
 
 private:
+	void addComputeGap( const OTF2_TimeStamp t ) {
+		if( 0 != currentTime && t > currentTime ) {
+			skeleton->addCompute( ( t - currentTime ) * tickNs );
+		}
+		setCurrentTime( t );
+	}
+
+	void reduceSkeleton();
+	bool generateSkeleton( std::queue<EmberEvent*>& evQ );
+
 	OTF2_DefReader* traceLocalDefReader;
 	OTF2_GlobalDefReader* traceGlobalDefReader;
 	OTF2_GlobalEvtReader* traceGlobalEvtReader;
@@ -128,6 +175,16 @@ private:
 
 	std::queue<EmberEvent*>* eventQ;
 	std::unordered_map<uint64_t, MessageRequest*> requestMap;
+
+	EmberOTF2Skeleton* skeleton;
+	double computeTolerance;
+	uint32_t maxPeriod;
+	double tickNs;
+	bool sawMPICall;
+	bool skeletonReduced;
+	size_t replayLoop;
+	uint64_t replayIteration;
+	std::vector<MessageRequest> replayRequests;
 };
 
 }
@@ -0,0 +1,199 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include <math.h>
+#include <string.h>
+
+#include "emberotf2skeleton.h"
+
+using namespace SST::Ember;
+
+bool EmberOTF2Skeleton::Op::sameAs( const Op& other, double tolerance ) const {
+	if( type != other.type ) {
+		return false;
+	}
+
+	if( Compute == type ) {
+		return fabs( computeNs - other.computeNs ) <= tolerance * computeNs;
+	}
+
+	return peer == other.peer && tag == other.tag && slot == other.slot && length == other.length;
+}
+
+void EmberOTF2Skeleton::add( const Op& op ) {
+	rawOps++;
+
+	if( Compute == op.type ) {
+		if( op.computeNs <= 0 ) {
+			return;
+		}
+
+		if( ! ops.empty() && Compute == ops.back().type ) {
+			ops.back().computeNs += op.computeNs;
+			return;
+		}
+	}
+
+	ops.push_back( op );
+}
+
+void EmberOTF2Skeleton::addCompute( double ns ) {
+	Op op;
+	memset( &op, 0, sizeof(op) );
+	op.type = Compute;
+	op.computeNs = ns;
+	add( op );
+}
+
+void EmberOTF2Skeleton::addSend( int32_t dest, uint32_t tag, uint64_t length ) {
+	Op op;
+	memset( &op, 0, sizeof(op) );
+	op.type = Send;
+	op.peer = dest;
+	op.tag = tag;
+	op.length = length;
+	add( op );
+}
+
+void EmberOTF2Skeleton::addRecv( int32_t src, uint32_t tag, uint64_t length ) {
+	Op op;
+	memset( &op, 0, sizeof(op) );
+	op.type = Recv;
+	op.peer = src;
+	op.tag = tag;
+	op.length = length;
+	add( op );
+}
+
+void EmberOTF2Skeleton::addIsend( int32_t dest, uint32_t tag, uint64_t length, uint64_t reqID ) {
+	// trace request ids differ from one iteration to the next, the lowest
+	// free slot does not, so periods still compare equal
+	uint32_t slot = 0;
+	while( slot < slotsUsed.size() && slotsUsed[slot] ) {
+		slot++;
+	}
+	if( slot == slotsUsed.size() ) {
+		slotsUsed.push_back( true );
+	} else {
+		slotsUsed[slot] = true;
+	}
+	openRequests[reqID] = slot;
+
+	Op op;
+	memset( &op, 0, sizeof(op) );
+	op.type = Isend;
+	op.peer = dest;
+	op.tag = tag;
+	op.slot = slot;
+	op.length = length;
+	add( op );
+}
+
+bool EmberOTF2Skeleton::addWait( uint64_t reqID ) {
+	std::unordered_map<uint64_t, uint32_t>::iterator iter = openRequests.find( reqID );
+	if( iter == openRequests.end() ) {
+		return false;
+	}
+
+	Op op;
+	memset( &op, 0, sizeof(op) );
+	op.type = Wait;
+	op.slot = iter->second;
+	add( op );
+
+	slotsUsed[iter->second] = false;
+	openRequests.erase( iter );
+	return true;
+}
+
+void EmberOTF2Skeleton::addCollective( OpType type, int32_t root, uint64_t length ) {
+	Op op;
+	memset( &op, 0, sizeof(op) );
+	op.type = type;
+	op.peer = root;
+	op.length = length;
+	add( op );
+}
+
+bool EmberOTF2Skeleton::periodRepeats( size_t start, size_t first, size_t length, double tolerance ) {
+	// against the loop's first iteration, not the one before, so a slow
+	// drift cannot add up to more than the tolerance
+	for( size_t i = 0; i < length; i++ ) {
+		if( ! ops[start + i].sameAs( ops[first + i], tolerance ) ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void EmberOTF2Skeleton::reduce( double tolerance, size_t maxPeriod ) {
+	std::vector<Op> reduced;
+	loops.clear();
+
+	size_t pos = 0;
+	while( pos < ops.size() ) {
+		size_t bestLength = 0;
+		uint64_t bestCount = 1;
+
+		// the period covering the most operations wins, the shortest one on
+		// a tie
+		for( size_t length = 1; length <= maxPeriod && pos + 2 * length <= ops.size(); length++ ) {
+			uint64_t count = 1;
+			while( pos + ( count + 1 ) * length <= ops.size() &&
+					periodRepeats( pos, pos + count * length, length, tolerance ) ) {
+				count++;
+			}
+
+			if( count > 1 && count * length > bestCount * bestLength ) {
+				bestLength = length;
+				bestCount = count;
+			}
+		}
+
+		if( 0 == bestLength ) {
+			// runs of operations that do not repeat share a loop with a count of 1
+			if( loops.empty() || 1 != loops.back().count ) {
+				Loop loop = { reduced.size(), 0, 1 };
+				loops.push_back( loop );
+			}
+			reduced.push_back( ops[pos] );
+			loops.back().length++;
+			pos++;
+			continue;
+		}
+
+		Loop loop = { reduced.size(), bestLength, bestCount };
+		loops.push_back( loop );
+
+		for( size_t i = 0; i < bestLength; i++ ) {
+			Op op = ops[pos + i];
+			if( Compute == op.type ) {
+				double total = 0;
+				for( uint64_t iter = 0; iter < bestCount; iter++ ) {
+					total += ops[pos + iter * bestLength + i].computeNs;
+				}
+				op.computeNs = total / bestCount;
+			}
+			reduced.push_back( op );
+		}
+
+		pos += bestCount * bestLength;
+	}
+
+	ops.swap( reduced );
+}
@@ -0,0 +1,100 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_EMBER_OTF2_SKELETON
+#define _H_EMBER_OTF2_SKELETON
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace SST {
+namespace Ember {
+
+/*
+ * The communication skeleton of one rank of an OTF2 trace. The trace is
+ * recorded as a list of operations with the time between MPI calls turned
+ * into compute operations, then reduced:
+ *
+ *  - adjacent compute intervals are merged into one
+ *  - a run of identical periods (a sequence of up to maxPeriod operations
+ *    repeated back to back) becomes a loop with a count
+ *
+ * Communication operations only match if they are identical. Compute
+ * intervals match if they are within tolerance of the first iteration's,
+ * the loop then replays the mean of the iterations so the total compute
+ * time is kept. A tolerance of 0 makes the reduction lossless. Replay cost then scales
+ * with the number of distinct periods, not the raw event count.
+ */
+class EmberOTF2Skeleton {
+
+public:
+	enum OpType { Compute, Send, Recv, Isend, Wait, Barrier, Bcast, Allreduce, Reduce };
+
+	struct Op {
+		uint8_t  type;
+		int32_t  peer;          // destination, source or root
+		uint32_t tag;
+		uint32_t slot;          // request slot of an isend and its wait
+		uint64_t length;
+		double   computeNs;
+
+		bool sameAs( const Op& other, double tolerance ) const;
+	};
+
+	struct Loop {
+		size_t   first;         // index of the first body operation in ops
+		size_t   length;        // operations in the body
+		uint64_t count;
+	};
+
+	EmberOTF2Skeleton() : rawOps( 0 ) {}
+
+	void addCompute( double ns );
+	void addSend( int32_t dest, uint32_t tag, uint64_t length );
+	void addRecv( int32_t src, uint32_t tag, uint64_t length );
+	void addIsend( int32_t dest, uint32_t tag, uint64_t length, uint64_t reqID );
+	// returns false if reqID was never started
+	bool addWait( uint64_t reqID );
+	void addCollective( OpType type, int32_t root, uint64_t length );
+
+	void reduce( double tolerance, size_t maxPeriod );
+
+	const std::vector<Op>& getOps() const { return ops; }
+	const std::vector<Loop>& getLoops() const { return loops; }
+	size_t getRequestSlots() const { return slotsUsed.size(); }
+	uint64_t getRawOpCount() const { return rawOps; }
+
+private:
+	void add( const Op& op );
+	// true if the period at first matches the one at start within tolerance
+	bool periodRepeats( size_t start, size_t first, size_t length, double tolerance );
+
+	std::vector<Op> ops;
+	std::vector<Loop> loops;
+
+	// open isends, by trace request id
+	std::unordered_map<uint64_t, uint32_t> openRequests;
+	std::vector<bool> slotsUsed;
+	uint64_t rawOps;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,183 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2022 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2022, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# One case of the Ember benchmark suite, normally run by runEmberBench.py:
+#
+#   sst emberBench.py --model-options="--motif=pingpong --ranks=1024 --topo=fattree --size=4096"
+#
+# The network is sized for --ranks hosts. pingpong and msgrate are two rank
+# motifs, their ranks are placed on the first and last host so messages
+# cross the whole network, every other host is left empty.
+
+import argparse
+import math
+import sys
+
+import sst
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.interface import *
+from sst.merlin.topology import *
+
+from sst.ember import *
+
+MOTIFS = [ "pingpong", "msgrate", "halo3d26", "allreduce", "barrier", "alltoall", "incast", "fft3d", "cofft3d" ]
+
+def parseArgs():
+    parser = argparse.ArgumentParser(prog="emberBench.py")
+    parser.add_argument("--motif", choices=MOTIFS, required=True)
+    parser.add_argument("--ranks", type=int, default=64)
+    parser.add_argument("--topo", choices=["dragonfly", "fattree"], default="dragonfly")
+    parser.add_argument("--size", type=int, default=8, help="message size in bytes, or halo3d26 and fft3d cells per dimension")
+    parser.add_argument("--iterations", type=int, default=10)
+    parser.add_argument("--link-bw", default="4GB/s")
+    parser.add_argument("--nic", action="append", default=[], metavar="KEY=VALUE",
+                        help="override a NIC parameter, e.g. rxMatchDelay_ns=20")
+    parser.add_argument("--ctrl", action="append", default=[], metavar="KEY=VALUE",
+                        help="override a host messaging parameter, e.g. matchDelay_ns=0")
+    parser.add_argument("--functionsm", action="append", default=[], metavar="KEY=VALUE",
+                        help="override a host function parameter, e.g. Allreduce.offloadAlgorithm=ring")
+    parser.add_argument("--motif-arg", action="append", default=[], metavar="KEY=VALUE",
+                        help="add an argument to the motif, e.g. offload=1")
+    parser.add_argument("--stats-file", default="",
+                        help="write the router packet counts to this CSV file")
+    return parser.parse_args(sys.argv[1:])
+
+def keyValues(pairs):
+    params = dict()
+    for pair in pairs:
+        key, value = pair.split("=", 1)
+        params[key] = value
+    return params
+
+def buildTopology(name, ranks):
+    if name == "dragonfly":
+        topo = topoDragonFly()
+        if ranks <= 1024:
+            hosts, routers, globalLinks = 4, 8, 4
+        else:
+            hosts, routers, globalLinks = 8, 16, 8
+        groups = max(2, -(-ranks // (hosts * routers)))
+        topo.setShape(hosts, routers, globalLinks, groups)
+        topo.algorithm = ["minimal", "adaptive-local"]
+    else:
+        # three levels, full bisection
+        topo = topoFatTree()
+        if ranks <= 512:
+            radix = 4
+        elif ranks <= 4096:
+            radix = 8
+        else:
+            radix = 16
+        top = max(1, -(-ranks // (radix * radix)))
+        topo.shape = "%d,%d:%d,%d:%d" % (radix, radix, radix, radix, top)
+
+    router = hr_router()
+    router.link_bw = args.link_bw
+    router.flit_size = "8B"
+    router.xbar_bw = "6GB/s"
+    router.input_latency = "20ns"
+    router.output_latency = "20ns"
+    router.input_buf_size = "4kB"
+    router.output_buf_size = "4kB"
+    router.num_vns = 2
+    router.xbar_arb = "merlin.xbar_arb_lru"
+
+    topo.router = router
+    topo.link_latency = "20ns"
+    return topo
+
+# the most cubic pex x pey x pez == ranks, Halo3D26 searches for this in
+# O(ranks^3) on every rank
+def decompose(ranks):
+    best = (ranks, 1, 1)
+    for x in range(1, int(round(ranks ** (1.0 / 3))) + 2):
+        if ranks % x:
+            continue
+        rest = ranks // x
+        for y in range(x, int(math.sqrt(rest)) + 1):
+            if rest % y == 0:
+                z = rest // y
+                if max(x, y, z) - min(x, y, z) < max(best) - min(best):
+                    best = (x, y, z)
+    return best
+
+# the largest factor of ranks no bigger than its square root, FFT3D's rows
+def fftRows(ranks):
+    rows = int(math.sqrt(ranks))
+    while ranks % rows:
+        rows -= 1
+    return rows
+
+def motifCommand(motif, ranks):
+    if motif == "pingpong":
+        return "PingPong messageSize=%d iterations=%d rank2=1" % (args.size, args.iterations)
+    if motif == "msgrate":
+        return "MsgRate msgSize=%d numMsgs=128 iterations=%d" % (args.size, args.iterations)
+    if motif == "halo3d26":
+        pex, pey, pez = decompose(ranks)
+        return "Halo3D26 nx=%d ny=%d nz=%d pex=%d pey=%d pez=%d computetime=0 copytime=0 iterations=%d" % \
+            (args.size, args.size, args.size, pex, pey, pez, args.iterations)
+    if motif == "allreduce":
+        return "Allreduce count=%d iterations=%d" % (max(1, args.size // 8), args.iterations)
+    if motif == "barrier":
+        return "Barrier iterations=%d" % args.iterations
+    if motif == "alltoall":
+        return "Alltoall bytes=%d iterations=%d" % (args.size, args.iterations)
+    if motif in [ "fft3d", "cofft3d" ]:
+        name = "CoFFT3D" if motif == "cofft3d" else "FFT3D"
+        return "%s nx=%d ny=%d nz=%d npRow=%d iterations=%d" % \
+            (name, args.size, args.size, args.size, fftRows(ranks), args.iterations)
+    return "Incast messageSize=%d iterations=%d" % (args.size, args.iterations)
+
+if __name__ == "__main__":
+
+    args = parseArgs()
+
+    PlatformDefinition.setCurrentPlatform("firefly-defaults")
+    platform = PlatformDefinition.getCurrentPlatform()
+    platform.addParamSet("nic", keyValues(args.nic))
+    platform.addParamSet("firefly.ctrl", keyValues(args.ctrl))
+    platform.addParamSet("firefly.functionsm", keyValues(args.functionsm))
+
+    topo = buildTopology(args.topo, args.ranks)
+
+    networkif = ReorderLinkControl()
+    networkif.link_bw = args.link_bw
+    networkif.input_buf_size = "1kB"
+    networkif.output_buf_size = "1kB"
+
+    pairwise = args.motif in [ "pingpong", "msgrate" ]
+    jobRanks = 2 if pairwise else args.ranks
+
+    ep = EmberMPIJob(0, jobRanks)
+    ep.network_interface = networkif
+    ep.addMotif("Init")
+    ep.addMotif(" ".join([ motifCommand(args.motif, jobRanks) ] + args.motif_arg))
+    ep.addMotif("Fini")
+
+    system = System()
+    system.setTopology(topo)
+    if pairwise:
+        system.allocateNodes(ep, "indexed", [ 0, topo.getNumNodes() - 1 ])
+    else:
+        system.allocateNodes(ep, "linear")
+
+    system.build()
+
+    if args.stats_file:
+        sst.setStatisticLoadLevel(1)
+        sst.setStatisticOutput("sst.statOutputCSV")
+        sst.setStatisticOutputOptions({ "filepath" : args.stats_file, "separator" : "," })
+        sst.enableStatisticForComponentType("merlin.hr_router", "send_packet_count",
+                                            { "type" : "sst.AccumulatorStatistic", "rate" : "0ns" }, True)
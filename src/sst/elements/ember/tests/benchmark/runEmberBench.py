@@ -0,0 +1,358 @@
+#!/usr/bin/env python3
+#
+# Copyright 2009-2022 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2022, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+"""Ember/Firefly benchmark suite.
+
+Runs emberBench.py over a matrix of motifs, rank counts, topologies,
+message sizes and NIC settings. Each case is a separate sst process. The
+JSON report records two things for every case:
+
+  modeled   simulated time, latency, bandwidth and message rate as
+            reported by the motif, or derived from the simulated time
+  host      wall clock, build and run loop time, peak RSS of the sst
+            process and router packet events per second of run time
+
+Examples:
+
+  # the full matrix, 64 to 16k ranks on dragonfly and fat tree
+  runEmberBench.py -o today.json
+
+  # a quick check against an earlier report, exits 1 on a regression
+  runEmberBench.py --quick --baseline today.json -o now.json
+
+  # how the NIC match cost moves message rate
+  runEmberBench.py --motifs msgrate --ranks 64 --nic rxMatchDelay_ns=0,50,100,200
+
+  # host cost of the coroutine FFT3D against the original, the modeled
+  # results are the same
+  runEmberBench.py --motifs fft3d,cofft3d --ranks 256,4096 --sst-args="-n 8"
+
+Peak RSS is that of the process sst was started as, run with sst threads
+(--sst-args="-n 8") rather than under mpirun to keep it meaningful. The
+event count is the packets sent by every router output, a lower bound
+on the events the simulator processed; SST does not report a total.
+"""
+
+import argparse
+import csv
+import datetime
+import itertools
+import json
+import os
+import platform
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+CONFIG = os.path.join(os.path.dirname(os.path.abspath(__file__)), "emberBench.py")
+
+MOTIFS = [ "pingpong", "msgrate", "halo3d26", "allreduce", "alltoall", "incast" ]
+# run only when asked for
+EXTRA_MOTIFS = [ "fft3d", "cofft3d" ]
+TOPOLOGIES = [ "dragonfly", "fattree" ]
+RANKS = [ 64, 256, 1024, 4096, 16384 ]
+
+# message bytes, or cells per dimension for halo3d26 and fft3d
+SIZES = {
+    "pingpong"  : [ 8, 1024, 65536, 1048576 ],
+    "msgrate"   : [ 8, 1024, 8192 ],
+    "halo3d26"  : [ 32 ],
+    "allreduce" : [ 8, 1024, 65536 ],
+    "alltoall"  : [ 8, 1024 ],
+    "incast"    : [ 1024, 65536 ],
+    "fft3d"     : [ 64 ],
+    "cofft3d"   : [ 64 ],
+}
+
+TIME_UNITS = { "s" : 1.0, "ms" : 1e-3, "us" : 1e-6, "ns" : 1e-9, "ps" : 1e-12, "fs" : 1e-15 }
+
+def commaList(value, convert=str):
+    return [ convert(v) for v in value.split(",") if v ]
+
+def parseArgs():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("-o", "--output", default="ember-bench.json", help="JSON report to write")
+    parser.add_argument("--motifs", type=commaList, default=MOTIFS)
+    parser.add_argument("--ranks", type=lambda v: commaList(v, int), default=RANKS)
+    parser.add_argument("--topos", type=commaList, default=TOPOLOGIES)
+    parser.add_argument("--sizes", type=lambda v: commaList(v, int), default=None,
+                        help="sizes for every motif instead of the per motif defaults")
+    parser.add_argument("--iterations", type=int, default=10)
+    parser.add_argument("--nic", action="append", default=[], metavar="KEY=V1[,V2...]",
+                        help="NIC parameter, a list of values is swept")
+    parser.add_argument("--ctrl", action="append", default=[], metavar="KEY=V1[,V2...]",
+                        help="host messaging parameter, a list of values is swept")
+    parser.add_argument("--quick", action="store_true",
+                        help="64 and 256 ranks, the smallest and largest size, 2 iterations")
+    parser.add_argument("--sst", default="sst", help="sst executable")
+    parser.add_argument("--sst-args", default="", help="extra sst arguments, e.g. \"-n 8\"")
+    parser.add_argument("--timeout", type=int, default=0, help="seconds before a case is killed, 0 waits")
+    parser.add_argument("--baseline", default="", help="earlier report to compare against")
+    parser.add_argument("--tolerance", type=float, default=0.10,
+                        help="relative change reported as a regression")
+    parser.add_argument("--dry-run", action="store_true", help="print the sst commands only")
+
+    opts = parser.parse_args()
+
+    for motif in opts.motifs:
+        if motif not in MOTIFS + EXTRA_MOTIFS:
+            parser.error("unknown motif %s" % motif)
+    for topo in opts.topos:
+        if topo not in TOPOLOGIES:
+            parser.error("unknown topology %s" % topo)
+
+    if opts.quick:
+        opts.ranks = [ r for r in opts.ranks if r <= 256 ] or [ 64 ]
+        opts.iterations = 2
+    return opts
+
+def sweep(pairs):
+    keys = []
+    values = []
+    for pair in pairs:
+        key, value = pair.split("=", 1)
+        keys.append(key)
+        values.append(value.split(","))
+    return [ dict(zip(keys, combo)) for combo in itertools.product(*values) ]
+
+def buildCases(opts):
+    cases = []
+    for motif in opts.motifs:
+        sizes = opts.sizes or SIZES[motif]
+        if opts.quick and len(sizes) > 1:
+            sizes = [ sizes[0], sizes[-1] ]
+        for topo, ranks, size, nic, ctrl in itertools.product(opts.topos, opts.ranks, sizes,
+                                                              sweep(opts.nic), sweep(opts.ctrl)):
+            cases.append({ "motif" : motif, "topology" : topo, "ranks" : ranks, "size" : size,
+                           "nic" : nic, "ctrl" : ctrl })
+    return cases
+
+def sstCommand(opts, case, statsFile):
+    modelArgs = [ "--motif=%s" % case["motif"], "--ranks=%d" % case["ranks"],
+                  "--topo=%s" % case["topology"], "--size=%d" % case["size"],
+                  "--iterations=%d" % opts.iterations, "--stats-file=%s" % statsFile ]
+    modelArgs += [ "--nic=%s=%s" % kv for kv in sorted(case["nic"].items()) ]
+    modelArgs += [ "--ctrl=%s=%s" % kv for kv in sorted(case["ctrl"].items()) ]
+
+    return [ opts.sst ] + opts.sst_args.split() + [ "--print-timing-info", CONFIG,
+                                                    "--model-options=" + " ".join(modelArgs) ]
+
+def search(pattern, text, convert=float):
+    m = re.search(pattern, text)
+    return convert(m.group(1)) if m else None
+
+def routerPackets(statsFile):
+    total = 0
+    try:
+        with open(statsFile) as f:
+            reader = csv.reader(f)
+            header = [ h.strip() for h in next(reader) ]
+            nameCol = header.index("StatisticName")
+            sumCol = [ i for i, h in enumerate(header) if h.startswith("Sum.") ][0]
+            for row in reader:
+                if len(row) > sumCol and row[nameCol].strip() == "send_packet_count":
+                    total += int(float(row[sumCol]))
+    except (IOError, OSError, StopIteration, ValueError, IndexError):
+        return None
+    return total
+
+# modeled results, from the motif's own output where it prints them
+def modeled(case, iterations, out):
+    result = dict()
+
+    m = re.search(r"Simulation is complete, simulated time: ([\d.eE+-]+) (\w+)", out)
+    simTime = float(m.group(1)) * TIME_UNITS.get(m.group(2), 1.0) if m else None
+    result["sim_time_s"] = simTime
+
+    motif, size, ranks = case["motif"], case["size"], case["ranks"]
+    latency = None
+    bandwidth = None
+
+    if motif == "pingpong":
+        latency = search(r"latency ([\d.]+) us\.", out)
+        bandwidth = search(r"bandwidth ([\d.]+) GB/s", out)
+    elif motif == "msgrate":
+        result["msg_per_s"] = search(r"MsgRate: Recv msgSize \d+, totalTime [\d.]+ sec, ([\d.]+) msg/sec", out)
+        mbs = search(r"MsgRate: Recv msgSize \d+, totalTime [\d.]+ sec, [\d.]+ msg/sec, ([\d.]+) MB/s", out)
+        bandwidth = mbs / 1000.0 if mbs is not None else None
+    elif motif in [ "allreduce", "alltoall" ]:
+        latency = search(r"latency ([\d.]+) us", out)
+    elif simTime is not None:
+        latency = simTime / iterations * 1e6
+
+    if latency and bandwidth is None:
+        if motif == "allreduce":
+            perRank = max(1, size // 8) * 8
+        elif motif == "alltoall":
+            perRank = size * (ranks - 1)
+        elif motif == "halo3d26":
+            perRank = (6 * size * size + 12 * size + 8) * 8
+        elif motif == "incast":
+            perRank = size * (ranks - 1)
+        else:
+            perRank = None
+        if perRank is not None:
+            bandwidth = perRank / (latency * 1e-6) / 1e9
+
+    result["latency_us"] = latency
+    result["bandwidth_GBs"] = bandwidth
+    return result
+
+def runCase(opts, case):
+    fd, statsFile = tempfile.mkstemp(prefix="ember-bench-", suffix=".csv")
+    os.close(fd)
+    cmd = sstCommand(opts, case, statsFile)
+
+    if opts.dry_run:
+        print(" ".join("'%s'" % c if " " in c else c for c in cmd))
+        os.unlink(statsFile)
+        return None
+
+    with tempfile.TemporaryFile(mode="w+") as log:
+        start = time.monotonic()
+        proc = subprocess.Popen(cmd, stdout=log, stderr=subprocess.STDOUT)
+
+        # wait4 rather than wait() to get the peak RSS of this run alone
+        status = None
+        while status is None:
+            pid, waitStatus, usage = os.wait4(proc.pid, os.WNOHANG)
+            if pid == proc.pid:
+                status = waitStatus
+            elif opts.timeout and time.monotonic() - start > opts.timeout:
+                proc.kill()
+            else:
+                time.sleep(0.05)
+        proc.returncode = os.waitstatus_to_exitcode(status)
+        wall = time.monotonic() - start
+
+        log.seek(0)
+        out = log.read()
+
+    packets = routerPackets(statsFile)
+    os.unlink(statsFile)
+
+    rss = usage.ru_maxrss / 1024.0
+    if sys.platform == "darwin":
+        rss /= 1024.0
+
+    runTime = search(r"(?:Run loop|Simulation) time:\s+([\d.]+) seconds", out)
+    host = { "wall_s" : wall,
+             "build_s" : search(r"Build time:\s+([\d.]+) seconds", out),
+             "run_s" : runTime,
+             "peak_rss_MB" : rss,
+             "router_packets" : packets,
+             "events_per_s" : packets / (runTime or wall) if packets is not None and (runTime or wall) else None }
+
+    result = dict(case)
+    result["status"] = "ok" if proc.returncode == 0 else "failed (%d)" % proc.returncode
+    result["modeled"] = modeled(case, opts.iterations, out)
+    result["host"] = host
+    if proc.returncode != 0:
+        result["log_tail"] = out[-2000:]
+    return result
+
+def caseKey(result):
+    return (result["motif"], result["topology"], result["ranks"], result["size"],
+            tuple(sorted(result["nic"].items())), tuple(sorted(result["ctrl"].items())))
+
+# (section, metric, True if bigger is better, True if any change counts)
+COMPARED = [
+    ("modeled", "latency_us", False, True),
+    ("modeled", "bandwidth_GBs", True, True),
+    ("modeled", "msg_per_s", True, True),
+    ("host", "wall_s", False, False),
+    ("host", "events_per_s", True, False),
+    ("host", "peak_rss_MB", False, False),
+]
+
+def compare(results, baselineFile, tolerance):
+    with open(baselineFile) as f:
+        baseline = dict((caseKey(r), r) for r in json.load(f)["results"])
+
+    flagged = []
+    for result in results:
+        old = baseline.get(caseKey(result))
+        if old is None:
+            continue
+        if result["status"] != "ok" and old["status"] == "ok":
+            flagged.append((result, "status", old["status"], result["status"], None))
+            continue
+        for section, metric, biggerBetter, anyChange in COMPARED:
+            before = old.get(section, {}).get(metric)
+            after = result.get(section, {}).get(metric)
+            if not before or after is None:
+                continue
+            change = (after - before) / before
+            worse = change < -tolerance if biggerBetter else change > tolerance
+            if worse or (anyChange and abs(change) > tolerance):
+                flagged.append((result, metric, before, after, change))
+
+    for result, metric, before, after, change in flagged:
+        print("CHANGED %-9s %-9s %6d %8d %-14s %s -> %s%s" % (
+            result["motif"], result["topology"], result["ranks"], result["size"], metric,
+            fmt(before) if change is not None else before, fmt(after) if change is not None else after,
+            "" if change is None else " (%+.1f%%)" % (change * 100)))
+    return flagged
+
+def fmt(value):
+    return "-" if value is None else "%.4g" % value
+
+def sstVersion(opts):
+    try:
+        return subprocess.run([ opts.sst, "--version" ], stdout=subprocess.PIPE,
+                              stderr=subprocess.STDOUT, universal_newlines=True).stdout.strip()
+    except OSError:
+        return None
+
+def main():
+    opts = parseArgs()
+    cases = buildCases(opts)
+
+    results = []
+    for i, case in enumerate(cases):
+        result = runCase(opts, case)
+        if result is None:
+            continue
+        results.append(result)
+
+        m, h = result["modeled"], result["host"]
+        print("[%d/%d] %-9s %-9s ranks %-6d size %-8d %s  latency %s us  bw %s GB/s  wall %.2f s  rss %.0f MB  events/s %s" % (
+            i + 1, len(cases), case["motif"], case["topology"], case["ranks"], case["size"],
+            result["status"], fmt(m["latency_us"]), fmt(m["bandwidth_GBs"]), h["wall_s"], h["peak_rss_MB"],
+            fmt(h["events_per_s"])))
+        sys.stdout.flush()
+
+    if opts.dry_run:
+        return 0
+
+    report = { "suite" : "ember-bench",
+               "version" : 1,
+               "date" : datetime.datetime.now().isoformat(),
+               "host" : { "node" : platform.node(), "machine" : platform.machine(),
+                          "python" : platform.python_version(), "sst" : sstVersion(opts),
+                          "sst_args" : opts.sst_args },
+               "iterations" : opts.iterations,
+               "results" : results }
+
+    with open(opts.output, "w") as f:
+        json.dump(report, f, indent=2, sort_keys=True)
+    print("Wrote %d results to %s" % (len(results), opts.output))
+
+    failed = [ r for r in results if r["status"] != "ok" ]
+    flagged = compare(results, opts.baseline, opts.tolerance) if opts.baseline else []
+    return 1 if failed or flagged else 0
+
+if __name__ == "__main__":
+    sys.exit(main())
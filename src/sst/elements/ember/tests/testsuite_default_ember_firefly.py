@@ -0,0 +1,120 @@
+# -*- coding: utf-8 -*-
+
+from sst_unittest import *
+from sst_unittest_support import *
+
+import os
+import re
+
+have_coroutines = sst_elements_config_include_file_get_value_int("HAVE_EMBER_COROUTINES", default=0, disable_warning=True)
+
+################################################################################
+# Firefly features run through benchmark/emberBench.py. Options that must not
+# change the modeled result run with and without the option and compare the
+# simulated time, the others check that every rank finished with the right
+# data.
+
+class testcase_EmberFirefly(SSTTestCase):
+
+    def initializeClass(self, testName):
+        super(type(self), self).initializeClass(testName)
+        # Put test based setup code here. it is called before testing starts
+        # NOTE: This method is called once for every test
+
+    def setUp(self):
+        super(type(self), self).setUp()
+
+    def tearDown(self):
+        # Put test based teardown code here. it is called once after every test
+        super(type(self), self).tearDown()
+
+#####
+
+    # rendezvous sized messages, only the headers are carried
+    def test_firefly_timing_only_pingpong(self):
+        self.same_time_template("timing_only_pingpong", "--motif=pingpong --ranks=16 --size=65536",
+                                "--nic=timingOnly=1")
+
+    def test_firefly_timing_only_allreduce(self):
+        self.same_time_template("timing_only_allreduce", "--motif=allreduce --ranks=16 --size=4096",
+                                "--nic=timingOnly=1")
+
+    def test_firefly_timing_only_halo3d26(self):
+        self.same_time_template("timing_only_halo3d26", "--motif=halo3d26 --ranks=8 --size=16",
+                                "--nic=timingOnly=1")
+
+    # NIC offloaded collectives on a non power of two number of ranks, the
+    # allreduce checks the sum on every rank
+    def test_firefly_offload_allreduce_tree(self):
+        self.offload_template("allreduce", "tree")
+
+    def test_firefly_offload_allreduce_ring(self):
+        self.offload_template("allreduce", "ring")
+
+    def test_firefly_offload_barrier_tree(self):
+        self.offload_template("barrier", "tree")
+
+    def test_firefly_offload_barrier_ring(self):
+        self.offload_template("barrier", "ring")
+
+    # a plain Allreduce call runs on the NIC when the table picks nic
+    def test_firefly_offload_allreduce_table(self):
+        self.completes_template("offload_allreduce_table",
+            "--motif=allreduce --ranks=13 --size=800 --iterations=4 --motif-arg=verify=1 " +
+            "--functionsm=Allreduce.algorithms=0:0:nic --functionsm=Allreduce.offloadAlgorithm=ring",
+            "Allreduce: ranks 13")
+
+    # the coroutine port queues the same events as FFT3D
+    @unittest.skipIf(not have_coroutines, "Ember: the coroutine motifs need a C++20 compiler")
+    def test_firefly_coroutine_fft3d(self):
+        self.same_time_template("coroutine_fft3d", "--motif=fft3d --ranks=16 --size=16 --iterations=2",
+                                "--motif=cofft3d")
+
+#####
+
+    def offload_template(self, motif, algorithm):
+        name = motif.capitalize()
+        options = "--motif={0} --ranks=13 --size=800 --iterations=4 --motif-arg=offload=1 ".format(motif)
+        options += "--functionsm={0}.offloadAlgorithm={1} --functionsm={0}.offloadTreeDegree=3".format(name, algorithm)
+        if motif == "allreduce":
+            options += " --motif-arg=verify=1"
+        self.completes_template("offload_{0}_{1}".format(motif, algorithm), options, "{0}: ranks 13".format(name))
+
+    # rank 0 prints its motif line once every rank has been through the last
+    # collective
+    def completes_template(self, testcase, options, expect, testtimeout=300):
+        outfile = self.bench_run(testcase, options, testtimeout)[1]
+        with open(outfile, 'r') as f:
+            self.assertTrue(expect in f.read(), "Output file {0} does not contain '{1}'".format(outfile, expect))
+
+    def same_time_template(self, testcase, options, changed, testtimeout=300):
+        times = []
+        for name, args in [ ("base", options), ("changed", options + " " + changed) ]:
+            times.append(self.bench_run("{0}_{1}".format(testcase, name), args, testtimeout)[0])
+        self.assertEqual(times[0], times[1], "{0}: simulated time {1} with {2}, {3} without".format(testcase, times[1], changed, times[0]))
+
+    def bench_run(self, testcase, options, testtimeout):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        testDataFileName="test_ember_firefly_{0}".format(testcase)
+
+        sdlfile = "{0}/benchmark/emberBench.py".format(test_path)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        otherargs = '--model-options="{0}"'.format(options)
+
+        self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, set_cwd=tmpdir,
+                     mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+
+        cmd = 'grep "FATAL" {0} '.format(outfile)
+        grep_result = os.system(cmd) != 0
+        self.assertTrue(grep_result, "Output file {0} contains the word 'FATAL'...".format(outfile))
+
+        with open(outfile, 'r') as f:
+            m = re.search(r"Simulation is complete, simulated time: (\S+ \S+)", f.read())
+        self.assertTrue(m is not None, "Output file {0} has no simulated time".format(outfile))
+        return m.group(1), outfile
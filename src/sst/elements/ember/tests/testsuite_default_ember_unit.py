@@ -0,0 +1,53 @@
+# -*- coding: utf-8 -*-
+
+from sst_unittest import *
+from sst_unittest_support import *
+
+################################################################################
+# Standalone programs in tests/unit that check Ember and Firefly code which
+# does not need a simulation to exercise
+
+class testcase_EmberUnit(SSTTestCase):
+
+    def initializeClass(self, testName):
+        super(type(self), self).initializeClass(testName)
+        # Put test based setup code here. it is called before testing starts
+        # NOTE: This method is called once for every test
+
+    def setUp(self):
+        super(type(self), self).setUp()
+
+    def tearDown(self):
+        # Put test based teardown code here. it is called once after every test
+        super(type(self), self).tearDown()
+
+#####
+
+    def test_firefly_matchlist(self):
+        self.unit_test_template("testmatchlist")
+
+    def test_firefly_collective_schedule(self):
+        self.unit_test_template("testcollectiveschedule")
+
+    def test_firefly_network_event(self):
+        self.unit_test_template("testnetworkevent")
+
+    def test_ember_otf2_skeleton(self):
+        self.unit_test_template("testotf2skeleton")
+
+    def test_ember_compute_model(self):
+        self.unit_test_template("testcomputemodel")
+
+#####
+
+    def unit_test_template(self, testname):
+        unitdir = "{0}/unit".format(self.get_testsuite_dir())
+        tmpdir = self.get_test_output_tmp_dir()
+
+        rtn = OSCommand("make {0}".format(testname), set_cwd=unitdir).run()
+        log_debug("Ember unit test {0} make result = {1}; output =\n{2}".format(testname, rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "Ember unit test {0} failed to build".format(testname))
+
+        rtn = OSCommand("{0}/{1}".format(unitdir, testname), set_cwd=tmpdir).run()
+        log_debug("Ember unit test {0} result = {1}; output =\n{2}".format(testname, rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "Ember unit test {0} failed:\n{1}".format(testname, rtn.output()))
@@ -0,0 +1,139 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Stand-in for Firefly's CtrlMsg::API. Every rank of a collective shares
+// one Mailbox, a send copies its data into the mailbox straight away and a
+// receive completes once a message with its source and tag is there, so a
+// test can step every rank's schedule in turn without a network.
+
+#ifndef UNIT_FIREFLY_CTRL_MSG_H
+#define UNIT_FIREFLY_CTRL_MSG_H
+
+#include <string.h>
+
+#include <deque>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "funcSM/api.h"
+
+namespace SST {
+namespace Firefly {
+namespace CtrlMsg {
+
+struct _CommReq {
+    bool                isRecv;
+    std::vector<IoVec>  ioVec;
+    int                 peer;
+    uint32_t            tag;
+};
+
+struct CommReq {
+    _CommReq* req;
+};
+
+// message data keyed on (source, destination, tag), oldest first
+typedef std::map< std::tuple<int,int,uint32_t>, std::deque< std::vector<char> > > Mailbox;
+
+class API {
+  public:
+    API( Mailbox& mailbox, int rank ) : m_mailbox( mailbox ), m_rank( rank ), m_blocked( false ), m_badLength( false ) {}
+
+    void irecvv( std::vector<IoVec>& ioVec, int src, uint32_t tag, MP::Communicator, CommReq* req ) {
+        req->req = new _CommReq{ true, ioVec, src, tag };
+    }
+
+    void isendv( std::vector<IoVec>& ioVec, int dest, uint32_t tag, MP::Communicator, CommReq* req, int ) {
+        std::vector<char> data;
+        for ( size_t i = 0; i < ioVec.size(); i++ ) {
+            size_t offset = data.size();
+            data.resize( offset + ioVec[i].len );
+            if ( ioVec[i].addr.getBacking() ) {
+                memcpy( &data[offset], ioVec[i].addr.getBacking(), ioVec[i].len );
+            }
+        }
+        m_mailbox[ std::make_tuple( m_rank, dest, tag ) ].push_back( data );
+        req->req = new _CommReq{ false, ioVec, dest, tag };
+    }
+
+    void waitAll( std::vector<CommReq*>& reqs ) {
+        m_waits = reqs;
+        m_blocked = true;
+    }
+
+    bool blocked() { return m_blocked; }
+
+    // true if a receive did not get the length it posted
+    bool badLength() { return m_badLength; }
+
+    // finish the waitAll() if every receive it waits on has a message
+    bool tryComplete() {
+        for ( size_t i = 0; i < m_waits.size(); i++ ) {
+            _CommReq* req = m_waits[i]->req;
+            if ( req->isRecv && messages( req ).empty() ) {
+                return false;
+            }
+        }
+
+        for ( size_t i = 0; i < m_waits.size(); i++ ) {
+            _CommReq* req = m_waits[i]->req;
+            if ( req->isRecv ) {
+                std::deque< std::vector<char> >& queue = messages( req );
+                deliver( req, queue.front() );
+                queue.pop_front();
+            }
+            delete req;
+        }
+        m_waits.clear();
+        m_blocked = false;
+        return true;
+    }
+
+  private:
+    std::deque< std::vector<char> >& messages( _CommReq* req ) {
+        return m_mailbox[ std::make_tuple( req->peer, m_rank, req->tag ) ];
+    }
+
+    void deliver( _CommReq* req, std::vector<char>& data ) {
+        size_t offset = 0;
+        for ( size_t i = 0; i < req->ioVec.size(); i++ ) {
+            IoVec& vec = req->ioVec[i];
+            if ( offset + vec.len > data.size() ) {
+                m_badLength = true;
+                return;
+            }
+            if ( vec.addr.getBacking() ) {
+                memcpy( vec.addr.getBacking(), &data[offset], vec.len );
+            }
+            offset += vec.len;
+        }
+        if ( offset != data.size() ) {
+            m_badLength = true;
+        }
+    }
+
+    Mailbox&                m_mailbox;
+    int                     m_rank;
+    bool                    m_blocked;
+    bool                    m_badLength;
+    std::vector<CommReq*>   m_waits;
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,63 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Stand-in for Firefly's funcSM/api.h with just the types the collective
+// schedule uses, so it builds without SST core or Hermes
+
+#ifndef UNIT_FIREFLY_FUNCSM_API_H
+#define UNIT_FIREFLY_FUNCSM_API_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#define CALL_INFO __FILE__,__LINE__,__func__
+
+namespace SST {
+
+class Output {
+  public:
+    void debug( const char*, int, const char*, int, int, const char*, ... ) {}
+};
+
+namespace Firefly {
+
+class MemAddr {
+  public:
+    MemAddr() : m_backing( NULL ) {}
+    void setSimVAddr( uint64_t ) {}
+    void setBacking( void* backing ) { m_backing = backing; }
+    void* getBacking() { return m_backing; }
+  private:
+    void* m_backing;
+};
+
+struct IoVec {
+    MemAddr addr;
+    size_t  len;
+};
+
+namespace MP {
+typedef uint32_t Communicator;
+typedef int PayloadDataType;
+struct ReductionOpType { int type; };
+typedef ReductionOpType* ReductionOperation;
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,42 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Stand-in for Firefly's funcSM/collectiveOps.h, every reduction is a sum
+// of int64_t whatever the data type and operation
+
+#ifndef UNIT_FIREFLY_FUNCSM_COLLECTIVEOPS_H
+#define UNIT_FIREFLY_FUNCSM_COLLECTIVEOPS_H
+
+#include "funcSM/api.h"
+
+namespace SST {
+namespace Firefly {
+
+inline void collectiveOp( void* input[], int numIn, void* result, int count,
+                MP::PayloadDataType, MP::ReductionOperation )
+{
+    for ( int i = 0; i < count; i++ ) {
+        int64_t value = ( (int64_t*) input[0] )[i];
+        for ( int n = 1; n < numIn; n++ ) {
+            value += ( (int64_t*) input[n] )[i];
+        }
+        ( (int64_t*) result )[i] = value;
+    }
+}
+
+}
+}
+
+#endif
@@ -13,30 +13,4 @@
 // information, see the LICENSE file in the top level directory of the
 // distribution.
 
-
-#ifndef _H_SST_ARIEL_NOOP_EVENT
-#define _H_SST_ARIEL_NOOP_EVENT
-
-#include "arielevent.h"
-
-using namespace SST;
-
-namespace SST {
-namespace ArielComponent {
-
-class ArielNoOpEvent : public ArielEvent {
-
-    public:
-        ArielNoOpEvent() {}
-        ~ArielNoOpEvent() {}
-
-        ArielEventType getEventType() const {
-                return NOOP;
-        }
-
-};
-
-}
-}
-
-#endif
+// Stand-in for the SST core header, nothing in it is used by the unit tests
@@ -0,0 +1,93 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Stand-in for the SST core Event and serializer that Firefly's network
+// event is built on. The serializer packs to and unpacks from a byte vector
+// so a test can check a round trip.
+
+#ifndef UNIT_SST_CORE_INTERFACES_SIMPLENETWORK_H
+#define UNIT_SST_CORE_INTERFACES_SIMPLENETWORK_H
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <vector>
+
+#define ImplementSerializable(obj)
+
+namespace SST {
+namespace Core {
+namespace Serialization {
+
+class serializer {
+  public:
+    enum Mode { PACK, UNPACK };
+
+    serializer() : m_mode( PACK ), m_pos( 0 ) {}
+
+    void start_unpacking() {
+        m_mode = UNPACK;
+        m_pos = 0;
+    }
+
+    size_t size() { return m_data.size(); }
+
+    template< class T >
+    serializer& operator&( T& value ) {
+        bytes( &value, sizeof( value ) );
+        return *this;
+    }
+
+    template< class T >
+    serializer& operator&( std::vector<T>& value ) {
+        size_t count = value.size();
+        bytes( &count, sizeof( count ) );
+        value.resize( count );
+        if ( count ) {
+            bytes( &value[0], count * sizeof( T ) );
+        }
+        return *this;
+    }
+
+  private:
+    void bytes( void* ptr, size_t len ) {
+        if ( PACK == m_mode ) {
+            m_data.insert( m_data.end(), (char*) ptr, (char*) ptr + len );
+        } else {
+            assert( m_pos + len <= m_data.size() );
+            memcpy( ptr, &m_data[m_pos], len );
+            m_pos += len;
+        }
+    }
+
+    Mode                m_mode;
+    size_t              m_pos;
+    std::vector<char>   m_data;
+};
+
+}
+}
+
+class Event {
+  public:
+    virtual ~Event() {}
+    virtual Event* clone() { return NULL; }
+    virtual void serialize_order( Core::Serialization::serializer& ) {}
+};
+
+}
+
+#endif
@@ -0,0 +1,37 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Stand-in for the SST core module base and the ELI macros a module
+// declares, the registration is not needed to call a module directly.
+
+#ifndef UNIT_SST_CORE_MODULE_H
+#define UNIT_SST_CORE_MODULE_H
+
+#define SST_ELI_ELEMENT_VERSION(...)
+#define SST_ELI_REGISTER_MODULE_API(...)
+#define SST_ELI_REGISTER_MODULE_DERIVED(...)
+#define SST_ELI_DOCUMENT_PARAMS(...)
+
+namespace SST {
+
+class Module {
+  public:
+    Module() {}
+    virtual ~Module() {}
+};
+
+}
+
+#endif
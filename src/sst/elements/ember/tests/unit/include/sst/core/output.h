@@ -0,0 +1,49 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Stand-in for the SST core Output, fatal() prints and exits.
+
+#ifndef UNIT_SST_CORE_OUTPUT_H
+#define UNIT_SST_CORE_OUTPUT_H
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CALL_INFO __LINE__, __FILE__, __FUNCTION__
+
+namespace SST {
+
+class Output {
+  public:
+    static Output& getDefaultObject() {
+        static Output output;
+        return output;
+    }
+
+    void fatal( unsigned int line, const char* file, const char* func, int exitCode,
+            const char* format, ... ) const {
+        va_list args;
+        va_start( args, format );
+        fprintf( stderr, "%s:%u: %s: ", file, line, func );
+        vfprintf( stderr, format, args );
+        va_end( args );
+        exit( 1 );
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,76 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Stand-in for the SST core Params, values are kept as strings and
+// converted by find(). Types that can be built from a string, like
+// UnitAlgebra, are built from it, anything else is read with a stream.
+
+#ifndef UNIT_SST_CORE_PARAMS_H
+#define UNIT_SST_CORE_PARAMS_H
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+namespace SST {
+
+class Params {
+  public:
+    void insert( const std::string& key, const std::string& value ) {
+        m_values[key] = value;
+    }
+
+    bool contains( const std::string& key ) const {
+        return m_values.count( key );
+    }
+
+    template< class T >
+    T find( const std::string& key, T def ) const {
+        std::map<std::string, std::string>::const_iterator iter = m_values.find( key );
+        return iter == m_values.end() ? def : convert<T>( iter->second );
+    }
+
+    template< class T >
+    T find( const std::string& key, const char* def ) const {
+        return find<T>( key, convert<T>( def ) );
+    }
+
+    template< class T >
+    T find( const std::string& key ) const {
+        return find<T>( key, T() );
+    }
+
+  private:
+    template< class T >
+    static typename std::enable_if<std::is_constructible<T, std::string>::value, T>::type
+    convert( const std::string& value ) {
+        return T( value );
+    }
+
+    template< class T >
+    static typename std::enable_if<! std::is_constructible<T, std::string>::value, T>::type
+    convert( const std::string& value ) {
+        T result = T();
+        std::istringstream( value ) >> result;
+        return result;
+    }
+
+    std::map<std::string, std::string> m_values;
+};
+
+}
+
+#endif
@@ -13,29 +13,4 @@
 // information, see the LICENSE file in the top level directory of the
 // distribution.
 
-
-#ifndef _H_SST_ARIEL_EXIT_EVENT
-#define _H_SST_ARIEL_EXIT_EVENT
-
-#include "arielevent.h"
-
-using namespace SST;
-
-namespace SST {
-namespace ArielComponent {
-
-class ArielExitEvent : public ArielEvent {
-
-    public:
-        ArielExitEvent() {}
-        ~ArielExitEvent() {}
-        ArielEventType getEventType() const {
-                return CORE_EXIT;
-        }
-
-};
-
-}
-}
-
-#endif
+// Stand-in for the SST core header, nothing in it is used by the unit tests
@@ -0,0 +1,59 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Stand-in for the SST core UnitAlgebra, it only reads a number with an
+// optional decimal prefix (k, M, G, T) and drops the unit.
+
+#ifndef UNIT_SST_CORE_UNITALGEBRA_H
+#define UNIT_SST_CORE_UNITALGEBRA_H
+
+#include <stdlib.h>
+
+#include <string>
+
+namespace SST {
+
+class UnitAlgebra {
+  public:
+    class Value {
+      public:
+        Value( double value ) : m_value( value ) {}
+        double toDouble() const { return m_value; }
+      private:
+        double m_value;
+    };
+
+    UnitAlgebra() : m_value( 0 ) {}
+
+    UnitAlgebra( const std::string& value ) {
+        char* end;
+        m_value = strtod( value.c_str(), &end );
+        switch ( *end ) {
+          case 'k': m_value *= 1e3; break;
+          case 'M': m_value *= 1e6; break;
+          case 'G': m_value *= 1e9; break;
+          case 'T': m_value *= 1e12; break;
+        }
+    }
+
+    Value getValue() const { return Value( m_value ); }
+
+  private:
+    double m_value;
+};
+
+}
+
+#endif
@@ -0,0 +1,2 @@
+// Stand-in for the configure generated header, the code built by the unit
+// tests does not depend on anything it defines
@@ -0,0 +1,269 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Firefly's collective schedules run on every rank of communicators of 1 to
+// 37 ranks, checking the data each rank ends up with. The protocol calls go
+// to the mailbox in include/ctrlMsg.h.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <functional>
+#include <memory>
+
+#include "funcSM/collectiveSchedule.h"
+
+using namespace SST;
+using namespace SST::Firefly;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if ( ! (cond) ) { \
+            printf( "FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond ); \
+            failures++; \
+        } \
+    } while ( 0 )
+
+static const int MaxRanks = 37;
+
+// Steps the schedule of every rank until they are all done, returns false
+// if no rank can make progress or a receive got the wrong length
+static bool runAll( int size, std::function<void( int, CollectiveSchedule& )> build )
+{
+    CtrlMsg::Mailbox mailbox;
+    std::vector< std::unique_ptr<CollectiveSchedule> > schedule;
+    std::vector< std::unique_ptr<CtrlMsg::API> > api;
+    std::vector<bool> done( size, false );
+    Output dbg;
+
+    for ( int rank = 0; rank < size; rank++ ) {
+        schedule.emplace_back( new CollectiveSchedule );
+        api.emplace_back( new CtrlMsg::API( mailbox, rank ) );
+        build( rank, *schedule[rank] );
+    }
+
+    for ( int remaining = size; remaining; ) {
+        bool progress = false;
+        for ( int rank = 0; rank < size; rank++ ) {
+            if ( done[rank] || ( api[rank]->blocked() && ! api[rank]->tryComplete() ) ) {
+                continue;
+            }
+            progress = true;
+            while ( ! api[rank]->blocked() ) {
+                if ( ! schedule[rank]->run( api[rank].get(), dbg ) ) {
+                    done[rank] = true;
+                    --remaining;
+                    break;
+                }
+            }
+        }
+        if ( ! progress ) {
+            printf( "no progress with %d ranks\n", size );
+            return false;
+        }
+    }
+
+    for ( int rank = 0; rank < size; rank++ ) {
+        if ( api[rank]->badLength() ) {
+            printf( "rank %d received the wrong length\n", rank );
+            return false;
+        }
+    }
+
+    // every message sent was received
+    for ( CtrlMsg::Mailbox::iterator iter = mailbox.begin(); iter != mailbox.end(); ++iter ) {
+        if ( ! iter->second.empty() ) {
+            printf( "unreceived message with %d ranks\n", size );
+            return false;
+        }
+    }
+    return true;
+}
+
+static void testAllreduce()
+{
+    MP::ReductionOpType sum = { 0 };
+    const uint32_t counts[] = { 0, 1, 3, 7, 64, 101 };
+    const char* names[] = { "recursiveDoubling", "rabenseifner", "ring" };
+
+    for ( int alg = 0; alg < 3; alg++ ) {
+        for ( int size = 1; size <= MaxRanks; size++ ) {
+            for ( unsigned c = 0; c < sizeof( counts ) / sizeof( counts[0] ); c++ ) {
+                const uint32_t count = counts[c];
+                std::vector< std::vector<int64_t> > in( size, std::vector<int64_t>( count ) );
+                std::vector< std::vector<int64_t> > out( size, std::vector<int64_t>( count, -1 ) );
+                for ( int rank = 0; rank < size; rank++ ) {
+                    for ( uint32_t i = 0; i < count; i++ ) {
+                        in[rank][i] = rank * 1000 + i;
+                    }
+                }
+
+                bool ran = runAll( size, [&]( int rank, CollectiveSchedule& schedule ) {
+                    if ( 0 == alg ) {
+                        schedule.allreduceRecursiveDoubling( rank, size, count * sizeof( int64_t ) );
+                    } else if ( 1 == alg ) {
+                        schedule.allreduceRabenseifner( rank, size, count, sizeof( int64_t ) );
+                    } else {
+                        schedule.allreduceRing( rank, size, count, sizeof( int64_t ) );
+                    }
+                    schedule.start( in[rank].data(), out[rank].data(), 0x30000000, 0, 0, 0,
+                                                            sizeof( int64_t ), &sum );
+                } );
+
+                bool right = ran;
+                for ( int rank = 0; rank < size; rank++ ) {
+                    for ( uint32_t i = 0; i < count; i++ ) {
+                        // sum over ranks of rank * 1000 + i
+                        right = right && out[rank][i] == 1000LL * size * ( size - 1 ) / 2 + (int64_t) i * size;
+                    }
+                }
+                if ( ! right ) {
+                    printf( "allreduce %s with %d ranks and count %u\n", names[alg], size, count );
+                }
+                CHECK( right );
+            }
+        }
+    }
+}
+
+// chunk lengths differ by rank so the offsets are not a multiple of one size
+static void testAllgatherRing()
+{
+    for ( int size = 1; size <= MaxRanks; size++ ) {
+        std::vector<size_t> offset( size ), len( size );
+        size_t total = 0;
+        for ( int rank = 0; rank < size; rank++ ) {
+            len[rank] = ( rank % 3 ) * 8 + 8;
+            offset[rank] = total;
+            total += len[rank];
+        }
+
+        std::vector< std::vector<char> > in( size ), out( size, std::vector<char>( total, 0 ) );
+        for ( int rank = 0; rank < size; rank++ ) {
+            for ( size_t i = 0; i < len[rank]; i++ ) {
+                in[rank].push_back( (char) ( rank * 7 + i ) );
+            }
+        }
+
+        bool right = runAll( size, [&]( int rank, CollectiveSchedule& schedule ) {
+            schedule.allgatherRing( rank, size, offset, len );
+            schedule.start( in[rank].data(), out[rank].data(), 0x10000000, 0, 0, 0, 1, NULL );
+        } );
+
+        for ( int rank = 0; rank < size; rank++ ) {
+            for ( int from = 0; from < size; from++ ) {
+                for ( size_t i = 0; i < len[from]; i++ ) {
+                    right = right && out[rank][offset[from] + i] == (char) ( from * 7 + i );
+                }
+            }
+        }
+        if ( ! right ) {
+            printf( "allgather ring with %d ranks\n", size );
+        }
+        CHECK( right );
+    }
+}
+
+static void testAlltoallBruck()
+{
+    const size_t blockLens[] = { 0, 4, 12 };
+
+    for ( int size = 1; size <= MaxRanks; size++ ) {
+        for ( unsigned b = 0; b < sizeof( blockLens ) / sizeof( blockLens[0] ); b++ ) {
+            const size_t blockLen = blockLens[b];
+            std::vector< std::vector<char> > in( size, std::vector<char>( size * blockLen ) );
+            std::vector< std::vector<char> > out( size, std::vector<char>( size * blockLen, 0 ) );
+
+            // block dest of rank's input is for dest
+            for ( int rank = 0; rank < size; rank++ ) {
+                for ( int dest = 0; dest < size; dest++ ) {
+                    for ( size_t i = 0; i < blockLen; i++ ) {
+                        in[rank][dest * blockLen + i] = (char) ( rank * 31 + dest * 5 + i );
+                    }
+                }
+            }
+
+            bool right = runAll( size, [&]( int rank, CollectiveSchedule& schedule ) {
+                schedule.alltoallBruck( rank, size, blockLen );
+                schedule.start( in[rank].data(), out[rank].data(), 0x20000000, 0, 0, 0, 1, NULL );
+            } );
+
+            // block src of rank's output came from src
+            for ( int rank = 0; rank < size; rank++ ) {
+                for ( int src = 0; src < size; src++ ) {
+                    for ( size_t i = 0; i < blockLen; i++ ) {
+                        right = right && out[rank][src * blockLen + i] == (char) ( src * 31 + rank * 5 + i );
+                    }
+                }
+            }
+            if ( ! right ) {
+                printf( "alltoall bruck with %d ranks and block %zu\n", size, blockLen );
+            }
+            CHECK( right );
+        }
+    }
+}
+
+// without backing for the output the schedule still exchanges every message
+static void testNoBacking()
+{
+    CHECK( runAll( 6, [&]( int rank, CollectiveSchedule& schedule ) {
+        schedule.allreduceRabenseifner( rank, 6, 100, 8 );
+        schedule.start( NULL, NULL, 0x30000000, 0, 0, 0, 8, NULL );
+    } ) );
+}
+
+static void testAlgorithmTable()
+{
+    std::vector<std::string> known = { "recursiveDoubling", "rabenseifner", "ring" };
+    CollectiveAlgorithmTable table;
+    std::string error;
+
+    CHECK( table.init( "0:0:recursiveDoubling 0:2048:rabenseifner,0:1048576:ring", known, error ) );
+    CHECK( "recursiveDoubling" == table.select( 64, 8 ) );
+    CHECK( "rabenseifner" == table.select( 64, 2048 ) );
+    CHECK( "rabenseifner" == table.select( 64, 1048575 ) );
+    CHECK( "ring" == table.select( 64, 1 << 20 ) );
+
+    // the last rule that applies wins, the first is the fallback
+    CHECK( table.init( "8:0:ring 0:4096:rabenseifner", known, error ) );
+    CHECK( "ring" == table.select( 4, 8 ) );
+    CHECK( "ring" == table.select( 16, 8 ) );
+    CHECK( "rabenseifner" == table.select( 16, 4096 ) );
+
+    CHECK( ! table.init( "0:0:bitonic", known, error ) );
+    CHECK( error.find( "bitonic" ) != std::string::npos );
+    CHECK( ! table.init( "0:ring", known, error ) );
+    CHECK( ! table.init( " , ", known, error ) );
+}
+
+int main( int argc, char* argv[] )
+{
+    testAlgorithmTable();
+    testAllreduce();
+    testAllgatherRing();
+    testAlltoallBruck();
+    testNoBacking();
+
+    if ( failures ) {
+        printf( "testcollectiveschedule: %d checks failed\n", failures );
+        return 1;
+    }
+
+    printf( "testcollectiveschedule: passed\n" );
+    return 0;
+}
@@ -0,0 +1,172 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// EmberAnalyticComputeModel against times worked out by hand. Cycle counts
+// are per core, the defaults are a 2GHz core with 4 lanes of 2 flops, L1,
+// L2 and L3 at 64, 32 and 16 bytes per cycle and 100GB/s (50 bytes per
+// cycle) of memory.
+
+#include <math.h>
+#include <stdio.h>
+
+#include "emberanalyticcomputemodel.h"
+
+using namespace SST;
+using namespace SST::Ember;
+
+static int failures = 0;
+
+#define CHECK_NS(model, phase, ns) \
+    do { \
+        double got = (model).calcTimeNS( phase ); \
+        if ( fabs( got - (ns) ) > 1e-9 * (ns) ) { \
+            printf( "FAILED %s:%d: %.3f ns, expected %.3f ns\n", __FILE__, __LINE__, got, (double) (ns) ); \
+            failures++; \
+        } \
+    } while ( 0 )
+
+static EmberAnalyticComputeModel* build( const char* model, const char* cores = "1",
+        const char* frequency = "2GHz", const char* coreMemBandwidth = NULL )
+{
+    Params params;
+    params.insert( "model", model );
+    params.insert( "cores", cores );
+    params.insert( "frequency", frequency );
+    if ( coreMemBandwidth ) {
+        params.insert( "coreMemBandwidth", coreMemBandwidth );
+    }
+    return new EmberAnalyticComputeModel( params );
+}
+
+// The phase Halo3D26 builds for nx=ny=nz=100 with its defaults, one 8 byte
+// field per cell and 26 flops: 28 * 8 bytes of L1 traffic per cell, the
+// cell streamed in and written back through L2, L3 and memory.
+static EmberComputePhase halo()
+{
+    const double cells = 100.0 * 100 * 100;
+
+    EmberComputePhase phase;
+    phase.flops = 26 * cells;
+    phase.l1Bytes = 28 * 8 * cells;
+    phase.memBytes = 2 * 8 * cells;
+    phase.l2Bytes = phase.memBytes;
+    phase.l3Bytes = phase.memBytes;
+    return phase;
+}
+
+static void testDefaults()
+{
+    // the default model is ecm
+    Params params;
+    EmberAnalyticComputeModel model( params );
+    CHECK_NS( model, halo(), 2660000 );
+}
+
+// arith 26e6 / 8 = 3.25e6, L1 2.24e8 / 64 = 3.5e6, L2 1.6e7 / 32 = 5e5,
+// L3 1.6e7 / 16 = 1e6, memory 1.6e7 / 50 = 3.2e5 cycles
+static void testHalo()
+{
+    EmberAnalyticComputeModel* ecm = build( "ecm" );
+    EmberAnalyticComputeModel* roofline = build( "roofline" );
+
+    // the transfers add up, 5.32e6 cycles
+    CHECK_NS( *ecm, halo(), 2660000 );
+    // L1 is the slowest, 3.5e6 cycles
+    CHECK_NS( *roofline, halo(), 1750000 );
+
+    delete ecm;
+    delete roofline;
+}
+
+static void testArithmetic()
+{
+    EmberAnalyticComputeModel* ecm = build( "ecm" );
+    EmberAnalyticComputeModel* roofline = build( "roofline" );
+
+    // no data, 8e6 vector flops are 1e6 cycles
+    EmberComputePhase phase;
+    phase.flops = 8e6;
+    CHECK_NS( *ecm, phase, 500000 );
+    CHECK_NS( *roofline, phase, 500000 );
+
+    // scalar flops run at 2 per cycle, 4e6 cycles
+    phase.vectorFraction = 0;
+    CHECK_NS( *ecm, phase, 2000000 );
+
+    // half vector, 4e6 / 8 + 4e6 / 2 = 2.5e6 cycles
+    phase.vectorFraction = 0.5;
+    CHECK_NS( *roofline, phase, 1250000 );
+
+    // ecm overlaps arithmetic with data, 3e6 cycles of L1 traffic hide the
+    // 1e6 cycles of vector flops
+    phase.vectorFraction = 1;
+    phase.l1Bytes = 64 * 3e6;
+    CHECK_NS( *ecm, phase, 1500000 );
+    CHECK_NS( *roofline, phase, 1500000 );
+
+    delete ecm;
+    delete roofline;
+}
+
+static void testCores()
+{
+    // four cores split the 5.32e6 cycles, memory takes 3.2e5 cycles
+    // whatever the core count
+    EmberAnalyticComputeModel* four = build( "ecm", "4" );
+    CHECK_NS( *four, halo(), 665000 );
+    delete four;
+
+    // at 32 cores 5.32e6 / 32 = 166250 cycles, memory is the limit
+    EmberAnalyticComputeModel* many = build( "ecm", "32" );
+    CHECK_NS( *many, halo(), 160000 );
+    delete many;
+
+    // the roofline also splits L1 over the cores, 3.5e6 / 4 cycles
+    EmberAnalyticComputeModel* roofline = build( "roofline", "4" );
+    CHECK_NS( *roofline, halo(), 437500 );
+    delete roofline;
+}
+
+static void testBandwidth()
+{
+    // a core drawing 10GB/s, 5 bytes per cycle: 1.6e7 / 5 = 3.2e6 cycles of
+    // memory on top of the 5e6 cycles through the caches
+    EmberAnalyticComputeModel* slow = build( "ecm", "1", "2GHz", "10GB/s" );
+    CHECK_NS( *slow, halo(), 4100000 );
+    delete slow;
+
+    // at 4GHz the caches take the same cycles in half the time and memory
+    // is 25 bytes per cycle, 5e6 + 6.4e5 cycles
+    EmberAnalyticComputeModel* fast = build( "ecm", "1", "4GHz" );
+    CHECK_NS( *fast, halo(), 1410000 );
+    delete fast;
+}
+
+int main( int argc, char* argv[] )
+{
+    testDefaults();
+    testHalo();
+    testArithmetic();
+    testCores();
+    testBandwidth();
+
+    if ( failures ) {
+        printf( "testcomputemodel: %d checks failed\n", failures );
+        return 1;
+    }
+
+    printf( "testcomputemodel: passed\n" );
+    return 0;
+}
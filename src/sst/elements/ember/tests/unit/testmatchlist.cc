@@ -0,0 +1,329 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Firefly's posted receive and unexpected message MatchList against the
+// front to back deque search it replaced
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <deque>
+#include <random>
+
+// ctrlMsgCommReq.h needs all of Hermes, only MatchHdr is used by the list
+#define COMPONENTS_FIREFLY_CTRL_MSG_COMM_REQ_H
+
+namespace SST {
+namespace Firefly {
+namespace MP {
+typedef uint32_t RankID;
+typedef uint32_t Communicator;
+static const uint32_t AnySrc = -1;
+}
+namespace CtrlMsg {
+static const uint64_t AnyTag = -1;
+
+typedef unsigned short key_t;
+
+struct MatchHdr {
+    uint32_t count;
+    uint32_t dtypeSize;
+    MP::RankID rank;
+    MP::Communicator group;
+    uint64_t    tag;
+    key_t       key;
+};
+}
+}
+}
+
+#include "ctrlMsgMatchList.h"
+
+using namespace SST::Firefly;
+using namespace SST::Firefly::CtrlMsg;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if ( ! (cond) ) { \
+            printf( "FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond ); \
+            failures++; \
+        } \
+    } while ( 0 )
+
+struct Recv {
+    MatchHdr hdr;
+    uint64_t ignore;
+};
+
+struct Msg {
+    MatchHdr hdr;
+};
+
+// same test as ProcessQueuesState::checkMatchHdr()
+static bool checkMatchHdr( MatchHdr& hdr, MatchHdr& wantHdr, uint64_t ignore )
+{
+    if ( ( AnyTag != wantHdr.tag ) &&
+            ( ( wantHdr.tag & ~ignore) != ( hdr.tag & ~ignore ) ) ) {
+        return false;
+    }
+    if ( ( MP::AnySrc != wantHdr.rank ) && ( wantHdr.rank != hdr.rank ) ) {
+        return false;
+    }
+    if ( wantHdr.group != hdr.group ) {
+        return false;
+    }
+    if ( wantHdr.count != hdr.count ) {
+        return false;
+    }
+    if ( wantHdr.dtypeSize != hdr.dtypeSize ) {
+        return false;
+    }
+    return true;
+}
+
+static MatchHdr makeHdr( MP::RankID rank, uint64_t tag, MP::Communicator group = 0, uint32_t count = 1 )
+{
+    MatchHdr hdr = { count, 8, rank, group, tag, 0 };
+    return hdr;
+}
+
+// The old searchPostedRecv(), count is the number of entries looked at
+static Recv* linearMatchMessage( std::deque<Recv*>& posted, MatchHdr& hdr, size_t& count )
+{
+    count = 0;
+    for ( std::deque<Recv*>::iterator iter = posted.begin(); iter != posted.end(); ++iter ) {
+        ++count;
+        if ( checkMatchHdr( hdr, (*iter)->hdr, (*iter)->ignore ) ) {
+            Recv* recv = *iter;
+            posted.erase( iter );
+            return recv;
+        }
+    }
+    return NULL;
+}
+
+// The old walk of the unexpected queue for a receive being posted
+static Msg* linearMatchPattern( std::deque<Msg*>& unexpected, Recv* recv, size_t& count )
+{
+    count = 0;
+    for ( std::deque<Msg*>::iterator iter = unexpected.begin(); iter != unexpected.end(); ++iter ) {
+        ++count;
+        if ( checkMatchHdr( (*iter)->hdr, recv->hdr, recv->ignore ) ) {
+            Msg* msg = *iter;
+            unexpected.erase( iter );
+            return msg;
+        }
+    }
+    return NULL;
+}
+
+static Recv* matchMessage( MatchList<Recv>& posted, MatchHdr& hdr, MatchCost& cost )
+{
+    return posted.matchMessage( hdr,
+        [&]( Recv* recv ) { return checkMatchHdr( hdr, recv->hdr, recv->ignore ); }, cost );
+}
+
+static Msg* matchPattern( MatchList<Msg>& unexpected, Recv* recv, MatchCost& cost )
+{
+    return unexpected.matchPattern( recv->hdr, recv->ignore,
+        [&]( Msg* msg ) { return checkMatchHdr( msg->hdr, recv->hdr, recv->ignore ); }, cost );
+}
+
+// MPI ordering with wildcards, worked by hand
+static void testOrder()
+{
+    MatchList<Recv> posted;
+    MatchCost cost;
+
+    // an older wildcard receive wins over a newer exact one, and the
+    // reverse, whichever bucket each is in
+    Recv anySrc = { makeHdr( MP::AnySrc, 5 ), 0 };
+    Recv exact = { makeHdr( 2, 5 ), 0 };
+    Recv anyTag = { makeHdr( 2, AnyTag ), 0 };
+    Recv masked = { makeHdr( 2, 0x40 ), 0xf };
+    posted.pushPattern( &anySrc, anySrc.hdr, anySrc.ignore );
+    posted.pushPattern( &exact, exact.hdr, exact.ignore );
+    posted.pushPattern( &anyTag, anyTag.hdr, anyTag.ignore );
+    posted.pushPattern( &masked, masked.hdr, masked.ignore );
+
+    MatchHdr hdr = makeHdr( 2, 5 );
+    CHECK( &anySrc == matchMessage( posted, hdr, cost ) );
+    CHECK( 1 == cost.position );
+    cost = MatchCost();
+    CHECK( &exact == matchMessage( posted, hdr, cost ) );
+    CHECK( 1 == cost.position );
+    cost = MatchCost();
+    CHECK( &anyTag == matchMessage( posted, hdr, cost ) );
+    cost = MatchCost();
+    // only the ignored bits differ
+    hdr = makeHdr( 2, 0x4a );
+    CHECK( &masked == matchMessage( posted, hdr, cost ) );
+    CHECK( posted.empty() );
+
+    // a different communicator or count never matches
+    Recv other = { makeHdr( MP::AnySrc, AnyTag, 1 ), 0 };
+    posted.pushPattern( &other, other.hdr, other.ignore );
+    cost = MatchCost();
+    hdr = makeHdr( 3, 9, 0 );
+    CHECK( NULL == matchMessage( posted, hdr, cost ) );
+    CHECK( 1 == cost.position );
+    hdr = makeHdr( 3, 9, 1, 2 );
+    CHECK( NULL == matchMessage( posted, hdr, cost ) );
+    hdr = makeHdr( 3, 9, 1 );
+    CHECK( &other == matchMessage( posted, hdr, cost ) );
+
+    // unexpected messages from one source are taken in arrival order, and a
+    // wildcard receive takes the oldest message from any source
+    MatchList<Msg> unexpected;
+    Msg first = { makeHdr( 1, 7 ) };
+    Msg second = { makeHdr( 2, 7 ) };
+    Msg third = { makeHdr( 1, 7 ) };
+    unexpected.pushMessage( &first, first.hdr );
+    unexpected.pushMessage( &second, second.hdr );
+    unexpected.pushMessage( &third, third.hdr );
+
+    Recv fromOne = { makeHdr( 1, 7 ), 0 };
+    Recv fromAny = { makeHdr( MP::AnySrc, AnyTag ), 0 };
+    cost = MatchCost();
+    CHECK( &first == matchPattern( unexpected, &fromOne, cost ) );
+    CHECK( 1 == cost.position );
+    cost = MatchCost();
+    CHECK( &third == matchPattern( unexpected, &fromOne, cost ) );
+    CHECK( 2 == cost.position );
+    cost = MatchCost();
+    CHECK( &second == matchPattern( unexpected, &fromAny, cost ) );
+    CHECK( unexpected.empty() );
+
+    // a cancelled receive is gone from every bucket
+    posted.pushPattern( &anySrc, anySrc.hdr, anySrc.ignore );
+    posted.pushPattern( &exact, exact.hdr, exact.ignore );
+    CHECK( posted.remove( &anySrc ) );
+    CHECK( ! posted.remove( &anySrc ) );
+    hdr = makeHdr( 2, 5 );
+    cost = MatchCost();
+    CHECK( &exact == matchMessage( posted, hdr, cost ) );
+    CHECK( 1 == cost.position );
+}
+
+// Random posts, arrivals and cancels on both implementations, sources, tags
+// and communicators are drawn from small sets so there are many candidates
+// for each match. Enough entries go through to renumber the Fenwick tree.
+static void testRandom()
+{
+    std::mt19937 gen( 1 );
+
+    std::deque<Recv> recvs;
+    std::deque<Msg> msgs;
+
+    MatchList<Recv> posted;
+    MatchList<Msg> unexpected;
+    std::deque<Recv*> linearPosted;
+    std::deque<Msg*> linearUnexpected;
+
+    size_t matched = 0;
+
+    for ( int i = 0; i < 50000; i++ ) {
+        const int what = gen() % 9;
+
+        if ( what < 4 ) {
+            recvs.push_back( Recv() );
+            Recv* recv = &recvs.back();
+            recv->hdr = makeHdr( gen() % 5 ? gen() % 4 : MP::AnySrc,
+                    gen() % 5 ? gen() % 8 : AnyTag, gen() % 2, 1 + gen() % 2 );
+            recv->ignore = gen() % 8 ? 0 : 0x3;
+
+            MatchCost cost;
+            size_t count;
+            Msg* msg = matchPattern( unexpected, recv, cost );
+            CHECK( msg == linearMatchPattern( linearUnexpected, recv, count ) );
+            CHECK( cost.position == count );
+            if ( msg ) {
+                ++matched;
+            } else {
+                posted.pushPattern( recv, recv->hdr, recv->ignore );
+                linearPosted.push_back( recv );
+            }
+        } else if ( what < 8 ) {
+            msgs.push_back( Msg() );
+            Msg* msg = &msgs.back();
+            msg->hdr = makeHdr( gen() % 4, gen() % 8, gen() % 2, 1 + gen() % 2 );
+
+            MatchCost cost;
+            size_t count;
+            Recv* recv = matchMessage( posted, msg->hdr, cost );
+            CHECK( recv == linearMatchMessage( linearPosted, msg->hdr, count ) );
+            CHECK( cost.position == count );
+            if ( recv ) {
+                ++matched;
+            } else {
+                unexpected.pushMessage( msg, msg->hdr );
+                linearUnexpected.push_back( msg );
+            }
+        } else if ( ! linearPosted.empty() ) {
+            const size_t pos = gen() % linearPosted.size();
+            CHECK( posted.remove( linearPosted[pos] ) );
+            linearPosted.erase( linearPosted.begin() + pos );
+        }
+
+        CHECK( posted.size() == linearPosted.size() );
+        CHECK( unexpected.size() == linearUnexpected.size() );
+        CHECK( posted.front() == ( linearPosted.empty() ? NULL : linearPosted.front() ) );
+        CHECK( unexpected.front() == ( linearUnexpected.empty() ? NULL : linearUnexpected.front() ) );
+
+        if ( failures ) {
+            printf( "testmatchlist: diverged at step %d\n", i );
+            return;
+        }
+    }
+
+    CHECK( matched > 10000 );
+}
+
+// What each cost model charges for a match
+static void testCostModel()
+{
+    MatchCost cost;
+    cost.position = 40;
+    cost.probes = 4;
+    cost.examined = 3;
+
+    MatchCostModel model;
+    CHECK( 40 == model.walkCount( cost ) );
+    CHECK( model.init( "hash", 1 ) );
+    CHECK( 7 == model.walkCount( cost ) );
+    CHECK( model.init( "constant", 2 ) );
+    CHECK( 2 == model.walkCount( cost ) );
+    CHECK( model.init( "linear", 1 ) );
+    CHECK( 40 == model.walkCount( cost ) );
+    CHECK( ! model.init( "quadratic", 1 ) );
+}
+
+int main( int argc, char* argv[] )
+{
+    testOrder();
+    testCostModel();
+    testRandom();
+
+    if ( failures ) {
+        printf( "testmatchlist: %d checks failed\n", failures );
+        return 1;
+    }
+
+    printf( "testmatchlist: passed\n" );
+    return 0;
+}
@@ -0,0 +1,244 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// The inline store of Firefly's network event: small packets don't
+// allocate, appends without data are counted but not carried, and copies
+// and serialization keep both the stored bytes and the length
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <new>
+
+#include "merlinEvent.h"
+
+using namespace SST;
+using namespace SST::Firefly;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if ( ! (cond) ) { \
+            printf( "FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond ); \
+            failures++; \
+        } \
+    } while ( 0 )
+
+// count heap allocations, the malloc and free are kept out of line so the
+// compiler does not pair them with the new and delete expressions
+static size_t allocations = 0;
+
+__attribute__((noinline)) static void* allocate( size_t size )
+{
+    ++allocations;
+    void* ptr = malloc( size ? size : 1 );
+    if ( NULL == ptr ) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+__attribute__((noinline)) static void release( void* ptr )
+{
+    free( ptr );
+}
+
+void* operator new( size_t size )
+{
+    return allocate( size );
+}
+
+void operator delete( void* ptr ) noexcept
+{
+    release( ptr );
+}
+
+void operator delete( void* ptr, size_t ) noexcept
+{
+    release( ptr );
+}
+
+static void fill( unsigned char* data, size_t len, int seed )
+{
+    for ( size_t i = 0; i < len; i++ ) {
+        data[i] = (unsigned char) ( seed + i * 13 );
+    }
+}
+
+static bool matches( FireflyNetworkEvent& ev, size_t pos, size_t len, int seed )
+{
+    for ( size_t i = 0; i < len; i++ ) {
+        unsigned char* ptr = (unsigned char*) ev.bufPtr( pos + i );
+        if ( NULL == ptr || *ptr != (unsigned char) ( seed + i * 13 ) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// a header and small payload, as CtrlMsg and shmem send, stay inline
+static void testInline()
+{
+    unsigned char hdr[40], data[64];
+    fill( hdr, sizeof( hdr ), 1 );
+    fill( data, sizeof( data ), 2 );
+
+    allocations = 0;
+    FireflyNetworkEvent ev( 16 );
+    ev.bufAppend( hdr, sizeof( hdr ) );
+    ev.bufAppend( data, sizeof( data ) );
+    CHECK( 0 == allocations );
+
+    CHECK( 104 == ev.bufSize() );
+    CHECK( 104 == ev.bufStoredSize() );
+    CHECK( 16 + 104 == ev.payloadSize() );
+    CHECK( matches( ev, 0, sizeof( hdr ), 1 ) );
+    CHECK( matches( ev, sizeof( hdr ), sizeof( data ), 2 ) );
+
+    ev.bufPop( sizeof( hdr ) );
+    CHECK( 64 == ev.bufSize() );
+    CHECK( matches( ev, 0, sizeof( data ), 2 ) );
+    ev.bufPop( sizeof( data ) );
+    CHECK( ev.bufEmpty() );
+    CHECK( NULL == ev.bufPtr() );
+}
+
+// timing-only packets: lengths without data are counted, not stored
+static void testTimingOnly()
+{
+    unsigned char hdr[32];
+    fill( hdr, sizeof( hdr ), 3 );
+
+    allocations = 0;
+    FireflyNetworkEvent ev( 16 );
+    ev.bufAppend( hdr, sizeof( hdr ) );
+    ev.bufAppend( NULL, 4096 );
+    CHECK( 0 == allocations );
+
+    CHECK( 32 + 4096 == ev.bufSize() );
+    CHECK( 32 == ev.bufStoredSize() );
+    CHECK( 16 + 32 + 4096 == ev.payloadSize() );
+    CHECK( 8 * ( 16 + 32 + 4096 ) == ev.calcPayloadSizeInBits() );
+    CHECK( matches( ev, 0, sizeof( hdr ), 3 ) );
+    CHECK( NULL == ev.bufPtr( sizeof( hdr ) ) );
+
+    ev.bufPop( sizeof( hdr ) );
+    CHECK( 0 == ev.bufStoredSize() );
+    CHECK( NULL == ev.bufPtr() );
+    ev.bufPop( 4096 );
+    CHECK( ev.bufEmpty() );
+}
+
+// data after a gap lands at its position and the gap reads as zero, both
+// inline and once the data has moved to the heap
+static void testGap()
+{
+    unsigned char data[200];
+    fill( data, sizeof( data ), 4 );
+
+    FireflyNetworkEvent small;
+    small.bufAppend( data, 8 );
+    small.bufAppend( NULL, 8 );
+    small.bufAppend( data, 8 );
+    CHECK( 24 == small.bufStoredSize() );
+    CHECK( matches( small, 0, 8, 4 ) );
+    CHECK( matches( small, 16, 8, 4 ) );
+    for ( size_t i = 8; i < 16; i++ ) {
+        CHECK( 0 == *(unsigned char*) small.bufPtr( i ) );
+    }
+
+    FireflyNetworkEvent large;
+    large.bufAppend( data, 100 );
+    large.bufAppend( NULL, 50 );
+    large.bufAppend( data, 200 );
+    CHECK( 350 == large.bufSize() );
+    CHECK( 350 == large.bufStoredSize() );
+    CHECK( matches( large, 0, 100, 4 ) );
+    CHECK( matches( large, 150, 200, 4 ) );
+    for ( size_t i = 100; i < 150; i++ ) {
+        CHECK( 0 == *(unsigned char*) large.bufPtr( i ) );
+    }
+}
+
+static void checkSame( FireflyNetworkEvent& a, FireflyNetworkEvent& b )
+{
+    CHECK( a.bufSize() == b.bufSize() );
+    CHECK( a.bufStoredSize() == b.bufStoredSize() );
+    CHECK( a.payloadSize() == b.payloadSize() );
+    CHECK( a.isHdr() == b.isHdr() );
+    CHECK( a.isTail() == b.isTail() );
+    CHECK( a.getSrcNode() == b.getSrcNode() );
+    CHECK( a.getDestPid() == b.getDestPid() );
+    for ( size_t i = 0; i < a.bufStoredSize(); i++ ) {
+        CHECK( NULL != b.bufPtr( i ) && *(unsigned char*) a.bufPtr( i ) == *(unsigned char*) b.bufPtr( i ) );
+    }
+}
+
+// copies and serialization of an inline, a timing-only and a heap event
+static void testCopy()
+{
+    unsigned char data[300];
+    fill( data, sizeof( data ), 5 );
+
+    const size_t stored[] = { 60, 20, 300 };
+    const size_t skipped[] = { 0, 1000, 10 };
+
+    for ( int i = 0; i < 3; i++ ) {
+        FireflyNetworkEvent ev( 16 );
+        ev.setSrcNode( 7 );
+        ev.setSrcPid( 1 );
+        ev.setSrcStream( 3 );
+        ev.setDestPid( 2 );
+        ev.setHdr();
+        ev.bufAppend( data, stored[i] );
+        ev.bufAppend( NULL, skipped[i] );
+        ev.bufPop( 4 );
+
+        FireflyNetworkEvent copy( ev );
+        checkSame( ev, copy );
+
+        FireflyNetworkEvent* clone = static_cast<FireflyNetworkEvent*>( ev.clone() );
+        checkSame( ev, *clone );
+        delete clone;
+
+        Core::Serialization::serializer ser;
+        ev.serialize_order( ser );
+        // inline events only carry the bytes they stored
+        if ( stored[i] <= FireflyNetworkEvent::InlineBufSize ) {
+            CHECK( ser.size() < 100 + stored[i] );
+        }
+        ser.start_unpacking();
+        FireflyNetworkEvent unpacked;
+        unpacked.serialize_order( ser );
+        checkSame( ev, unpacked );
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    testInline();
+    testTimingOnly();
+    testGap();
+    testCopy();
+
+    if ( failures ) {
+        printf( "testnetworkevent: %d checks failed\n", failures );
+        return 1;
+    }
+
+    printf( "testnetworkevent: passed\n" );
+    return 0;
+}
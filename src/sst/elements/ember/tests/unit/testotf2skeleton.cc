@@ -0,0 +1,250 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// EmberOTF2Skeleton::reduce(), by hand on small traces and against the
+// unreduced operations on random ones
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <random>
+#include <vector>
+
+#include "mpi/motifs/emberotf2skeleton.h"
+
+using namespace SST::Ember;
+
+typedef EmberOTF2Skeleton::Op Op;
+typedef EmberOTF2Skeleton::Loop Loop;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if ( ! (cond) ) { \
+            printf( "FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond ); \
+            failures++; \
+        } \
+    } while ( 0 )
+
+static bool sameOp( const Op& a, const Op& b )
+{
+    return a.type == b.type && a.peer == b.peer && a.tag == b.tag && a.slot == b.slot &&
+            a.length == b.length && a.computeNs == b.computeNs;
+}
+
+// the operations the loops replay, in order
+static std::vector<Op> expand( const EmberOTF2Skeleton& skel )
+{
+    std::vector<Op> ops;
+    for ( const Loop& loop : skel.getLoops() ) {
+        for ( uint64_t i = 0; i < loop.count; i++ ) {
+            for ( size_t op = 0; op < loop.length; op++ ) {
+                ops.push_back( skel.getOps()[loop.first + op] );
+            }
+        }
+    }
+    return ops;
+}
+
+static double computeTotal( const std::vector<Op>& ops )
+{
+    double total = 0;
+    for ( const Op& op : ops ) {
+        if ( EmberOTF2Skeleton::Compute == op.type ) {
+            total += op.computeNs;
+        }
+    }
+    return total;
+}
+
+static void testMergeCompute()
+{
+    EmberOTF2Skeleton skel;
+    skel.addCompute( 5 );
+    skel.addCompute( 0 );
+    skel.addCompute( 3 );
+    skel.addSend( 1, 7, 64 );
+    skel.addCompute( 2 );
+
+    CHECK( 5 == skel.getRawOpCount() );
+    CHECK( 3 == skel.getOps().size() );
+    CHECK( 8 == skel.getOps()[0].computeNs );
+    CHECK( EmberOTF2Skeleton::Send == skel.getOps()[1].type );
+    CHECK( 2 == skel.getOps()[2].computeNs );
+}
+
+static void testLoops()
+{
+    // a receive that does not repeat, then five iterations of send, compute
+    EmberOTF2Skeleton skel;
+    skel.addRecv( 3, 1, 8 );
+    for ( int i = 0; i < 5; i++ ) {
+        skel.addSend( 1, 7, 64 );
+        skel.addCompute( 10 );
+    }
+    skel.reduce( 0, 8 );
+
+    CHECK( 3 == skel.getOps().size() );
+    CHECK( 2 == skel.getLoops().size() );
+    if ( 2 == skel.getLoops().size() ) {
+        CHECK( 0 == skel.getLoops()[0].first );
+        CHECK( 1 == skel.getLoops()[0].length );
+        CHECK( 1 == skel.getLoops()[0].count );
+        CHECK( 1 == skel.getLoops()[1].first );
+        CHECK( 2 == skel.getLoops()[1].length );
+        CHECK( 5 == skel.getLoops()[1].count );
+    }
+}
+
+static void testMaxPeriod()
+{
+    // A B A B A B only repeats with a period of two
+    for ( size_t maxPeriod = 1; maxPeriod <= 2; maxPeriod++ ) {
+        EmberOTF2Skeleton skel;
+        for ( int i = 0; i < 3; i++ ) {
+            skel.addSend( 1, 0, 8 );
+            skel.addRecv( 1, 0, 8 );
+        }
+        skel.reduce( 0, maxPeriod );
+
+        if ( 1 == maxPeriod ) {
+            CHECK( 6 == skel.getOps().size() );
+            CHECK( 1 == skel.getLoops().size() && 6 == skel.getLoops()[0].length &&
+                    1 == skel.getLoops()[0].count );
+        } else {
+            CHECK( 2 == skel.getOps().size() );
+            CHECK( 1 == skel.getLoops().size() && 2 == skel.getLoops()[0].length &&
+                    3 == skel.getLoops()[0].count );
+        }
+    }
+}
+
+static void testRequestSlots()
+{
+    // trace request ids change every iteration, the slots do not
+    EmberOTF2Skeleton skel;
+    for ( uint64_t i = 0; i < 4; i++ ) {
+        skel.addIsend( 1, 0, 8, 100 + 2 * i );
+        skel.addIsend( 2, 0, 8, 101 + 2 * i );
+        CHECK( skel.addWait( 100 + 2 * i ) );
+        CHECK( skel.addWait( 101 + 2 * i ) );
+    }
+    CHECK( ! skel.addWait( 1000 ) );
+    skel.reduce( 0, 8 );
+
+    CHECK( 2 == skel.getRequestSlots() );
+    CHECK( 4 == skel.getOps().size() );
+    CHECK( 1 == skel.getLoops().size() && 4 == skel.getLoops()[0].count );
+}
+
+// Every iteration is compared with the first one of the loop. Compared
+// with the one before, 100 104 108 112 would all be within 5% of their
+// neighbour and drift 12% in one loop.
+static void testDrift()
+{
+    EmberOTF2Skeleton skel;
+    const double compute[] = { 100, 104, 108, 112 };
+    for ( int i = 0; i < 4; i++ ) {
+        skel.addSend( 1, 0, 8 );
+        skel.addCompute( compute[i] );
+    }
+    const double total = computeTotal( skel.getOps() );
+    skel.reduce( 0.05, 8 );
+
+    // 104 is within 5% of 100 and 108 is not, 112 is within 5% of 108
+    CHECK( 2 == skel.getLoops().size() );
+    if ( 2 == skel.getLoops().size() ) {
+        CHECK( 2 == skel.getLoops()[0].count && 2 == skel.getLoops()[0].length );
+        CHECK( 2 == skel.getLoops()[1].count && 2 == skel.getLoops()[1].length );
+        CHECK( 102 == skel.getOps()[1].computeNs );
+        CHECK( 110 == skel.getOps()[3].computeNs );
+    }
+    CHECK( total == computeTotal( expand( skel ) ) );
+}
+
+// Random traces built from a few periods, a tolerance of 0 must give the
+// same operations back and a tolerance above it must keep the compute time
+static void testRandom()
+{
+    std::mt19937 gen( 0x5eed );
+
+    for ( int trial = 0; trial < 500; trial++ ) {
+        EmberOTF2Skeleton exact;
+        EmberOTF2Skeleton loose;
+        const double jitter = trial % 2 ? 0.02 : 0;
+
+        int runs = 1 + gen() % 6;
+        for ( int run = 0; run < runs; run++ ) {
+            int period = 1 + gen() % 5;
+            int repeats = 1 + gen() % 6;
+            std::vector<int> kinds( period );
+            for ( int& kind : kinds ) {
+                kind = gen() % 4;
+            }
+            double base = 100 + gen() % 100;
+
+            for ( int i = 0; i < repeats; i++ ) {
+                for ( int kind : kinds ) {
+                    EmberOTF2Skeleton* skels[] = { &exact, &loose };
+                    double ns = base * ( 1 + jitter * ( ( gen() % 201 ) / 100.0 - 1 ) );
+                    for ( EmberOTF2Skeleton* skel : skels ) {
+                        switch ( kind ) {
+                          case 0: skel->addCompute( ns ); break;
+                          case 1: skel->addSend( kind, 5, 64 ); break;
+                          case 2: skel->addRecv( kind, 5, 64 ); break;
+                          default: skel->addCollective( EmberOTF2Skeleton::Allreduce, 0, 8 ); break;
+                        }
+                    }
+                }
+            }
+        }
+
+        const std::vector<Op> before = exact.getOps();
+        const size_t maxPeriod = 1 + trial % 8;
+
+        exact.reduce( 0, maxPeriod );
+        std::vector<Op> after = expand( exact );
+        bool same = before.size() == after.size();
+        for ( size_t i = 0; same && i < before.size(); i++ ) {
+            same = sameOp( before[i], after[i] );
+        }
+        CHECK( same );
+        CHECK( exact.getOps().size() <= before.size() );
+
+        const double total = computeTotal( loose.getOps() );
+        loose.reduce( 0.05, maxPeriod );
+        CHECK( fabs( total - computeTotal( expand( loose ) ) ) <= 1e-9 * total );
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    testMergeCompute();
+    testLoops();
+    testMaxPeriod();
+    testRequestSlots();
+    testDrift();
+    testRandom();
+
+    if ( failures ) {
+        printf( "testotf2skeleton: %d checks failed\n", failures );
+        return 1;
+    }
+
+    printf( "testotf2skeleton: passed\n" );
+    return 0;
+}
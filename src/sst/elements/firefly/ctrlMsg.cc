@@ -281,6 +281,15 @@ void API::waitAll( std::vector<CommReq*>& reqs )
     m_processQueuesState->enterWait( new WaitReq( tmp ), waitallStateDelay() );
 }
 
+void API::nicCollective( uint32_t id, const Hermes::MemAddr& input,
+        const Hermes::MemAddr& output, uint32_t count, MP::PayloadDataType dtype,
+        MP::ReductionOperation op, const VirtNic::CollTopo& topo )
+{
+    m_dbg.debug(CALL_INFO,1,1,"id=%#x count=%u\n", id, count );
+    m_processQueuesState->enterNicCollective( id, input, output, count, dtype,
+            m_info->sizeofDataType( dtype ), op, topo );
+}
+
 void API::send( const Hermes::MemAddr& buf, uint32_t count,
         MP::PayloadDataType dtype, MP::RankID dest, uint32_t tag,
         MP::Communicator group )
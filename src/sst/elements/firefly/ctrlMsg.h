@@ -20,6 +20,7 @@
 #include "protocolAPI.h"
 #include "ctrlMsgFunctors.h"
 #include "ioVec.h"
+#include "virtNic.h"
 #include "sst/elements/hermes/msgapi.h"
 
 using namespace Hermes;
@@ -107,6 +108,11 @@ class API : public ProtocolAPI {
     void waitAll( std::vector<CommReq*>& );
     void waitAll( std::vector<CommReq>& );
 
+    // runs an allreduce, or a barrier if count is 0, on the NIC
+    void nicCollective( uint32_t id, const Hermes::MemAddr& input,
+            const Hermes::MemAddr& output, uint32_t count, MP::PayloadDataType,
+            MP::ReductionOperation, const VirtNic::CollTopo& );
+
 	void send( const Hermes::MemAddr& buf, uint32_t count,
 		MP::PayloadDataType dtype, MP::RankID dest, uint32_t tag,
         MP::Communicator group );
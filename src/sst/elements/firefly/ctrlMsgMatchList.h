@@ -0,0 +1,346 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef COMPONENTS_FIREFLY_CTRL_MSG_MATCH_LIST_H
+#define COMPONENTS_FIREFLY_CTRL_MSG_MATCH_LIST_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ctrlMsgCommReq.h"
+
+namespace SST {
+namespace Firefly {
+namespace CtrlMsg {
+
+// What a search through a MatchList looked at, used to charge the
+// simulated matching time independently of how the search was done
+struct MatchCost {
+    MatchCost() : position(0), probes(0), examined(0) {}
+
+    size_t position;    // entries a walk of a single list would have checked
+    size_t probes;      // buckets looked up
+    size_t examined;    // entries checked in those buckets
+};
+
+class MatchCostModel {
+  public:
+    enum Type { Linear, Hash, Constant };
+
+    MatchCostModel() : m_type( Linear ), m_constant( 1 ) {}
+
+    bool init( const std::string& name, int constant ) {
+        m_constant = constant;
+        if ( name == "linear" ) {
+            m_type = Linear;
+        } else if ( name == "hash" ) {
+            m_type = Hash;
+        } else if ( name == "constant" ) {
+            m_type = Constant;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    // number of list entries to charge with MemoryBase::walk()
+    int walkCount( const MatchCost& cost ) {
+        switch ( m_type ) {
+          case Hash:
+            return cost.probes + cost.examined;
+          case Constant:
+            return m_constant;
+          case Linear:
+          default:
+            return cost.position;
+        }
+    }
+
+  private:
+    Type m_type;
+    int  m_constant;
+};
+
+// Posted receives or unexpected messages in arrival order, also kept in
+// buckets keyed on (source, tag, communicator) so a match does not have to
+// walk every entry. Posted receives are patterns and go in the one bucket
+// for their combination of wildcards, unexpected messages go in all four
+// buckets that a receive could look in. Within a bucket entries stay in
+// arrival order so the first match found is the one MPI ordering requires.
+// The caller's match function has the final say, the buckets only narrow
+// down the candidates.
+template< class T >
+class MatchList {
+
+    enum { ExactKey, AnyTagKey, AnySrcKey, AnySrcAnyTagKey, NumKeys, OrderLink = NumKeys };
+
+    struct Key {
+        uint64_t            tag;
+        MP::RankID          rank;
+        MP::Communicator    group;
+        int                 kind;
+
+        bool operator==( const Key& other ) const {
+            return tag == other.tag && rank == other.rank &&
+                group == other.group && kind == other.kind;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()( const Key& key ) const {
+            uint64_t hash = key.tag * 0x9e3779b97f4a7c15ULL;
+            hash ^= ( (uint64_t) key.rank << 32 | key.group ) + 0x7f4a7c159e3779b9ULL + ( hash << 6 ) + ( hash >> 2 );
+            return hash ^ key.kind;
+        }
+    };
+
+    struct Entry;
+
+    struct Bucket {
+        Bucket() : head( NULL ), tail( NULL ), size( 0 ) {}
+        Key     key;
+        Entry*  head;
+        Entry*  tail;
+        size_t  size;
+    };
+
+    struct Entry {
+        T*          item;
+        uint64_t    seq;
+        Bucket*     bucket[NumKeys + 1];
+        Entry*      prev[NumKeys + 1];
+        Entry*      next[NumKeys + 1];
+    };
+
+    typedef std::unordered_map< Key, Bucket, KeyHash > BucketMap;
+
+  public:
+
+    MatchList() : m_seqBase( 0 ), m_nextSeq( 0 ), m_rank( 1024 + 1, 0 ) {}
+
+    ~MatchList() {
+        while ( m_order.head ) {
+            Entry* entry = m_order.head;
+            m_order.head = entry->next[OrderLink];
+            delete entry;
+        }
+    }
+
+    size_t size() const { return m_order.size; }
+    bool empty() const { return 0 == m_order.size; }
+
+    // oldest entry first
+    T* front() { return m_order.head ? m_order.head->item : NULL; }
+
+    // add a posted receive, hdr holds the source, tag and communicator wanted
+    void pushPattern( T* item, MatchHdr& hdr, uint64_t ignore ) {
+        Entry* entry = newEntry( item );
+        link( entry, patternKey( hdr, ignore ) );
+    }
+
+    // add an unexpected message
+    void pushMessage( T* item, MatchHdr& hdr ) {
+        Entry* entry = newEntry( item );
+        for ( int kind = 0; kind < NumKeys; kind++ ) {
+            link( entry, messageKey( hdr, kind ) );
+        }
+    }
+
+    // find and remove the oldest posted receive which matches message hdr
+    template< class Match >
+    T* matchMessage( MatchHdr& hdr, Match match, MatchCost& cost ) {
+        Entry* found = NULL;
+        for ( int kind = 0; kind < NumKeys; kind++ ) {
+            Entry* entry = search( messageKey( hdr, kind ), match, cost );
+            if ( entry && ( NULL == found || entry->seq < found->seq ) ) {
+                found = entry;
+            }
+        }
+        return take( found, cost );
+    }
+
+    // find and remove the oldest unexpected message which the receive
+    // described by hdr and ignore would match
+    template< class Match >
+    T* matchPattern( MatchHdr& hdr, uint64_t ignore, Match match, MatchCost& cost ) {
+        return take( search( patternKey( hdr, ignore ), match, cost ), cost );
+    }
+
+    bool remove( T* item ) {
+        typename std::unordered_map< T*, Entry* >::iterator iter = m_entries.find( item );
+        if ( iter == m_entries.end() ) {
+            return false;
+        }
+        unlinkEntry( iter->second );
+        return true;
+    }
+
+  private:
+
+    static Key patternKey( MatchHdr& hdr, uint64_t ignore ) {
+        const bool anyTag = ( AnyTag == hdr.tag || 0 != ignore );
+        const bool anySrc = ( MP::AnySrc == hdr.rank );
+        Key key = { anyTag ? 0 : hdr.tag, anySrc ? 0 : hdr.rank, hdr.group,
+            anyTag ? ( anySrc ? AnySrcAnyTagKey : AnyTagKey ) : ( anySrc ? AnySrcKey : ExactKey ) };
+        return key;
+    }
+
+    static Key messageKey( MatchHdr& hdr, int kind ) {
+        Key key = { ( kind == ExactKey || kind == AnySrcKey ) ? hdr.tag : 0,
+            ( kind == ExactKey || kind == AnyTagKey ) ? hdr.rank : 0, hdr.group, kind };
+        return key;
+    }
+
+    template< class Match >
+    Entry* search( const Key& key, Match& match, MatchCost& cost ) {
+        ++cost.probes;
+        typename BucketMap::iterator iter = m_buckets.find( key );
+        if ( iter == m_buckets.end() ) {
+            return NULL;
+        }
+
+        const int slot = key.kind;
+        for ( Entry* entry = iter->second.head; entry; entry = entry->next[slot] ) {
+            ++cost.examined;
+            if ( match( entry->item ) ) {
+                return entry;
+            }
+        }
+        return NULL;
+    }
+
+    T* take( Entry* entry, MatchCost& cost ) {
+        if ( NULL == entry ) {
+            cost.position = m_order.size;
+            return NULL;
+        }
+        cost.position = rankOf( entry->seq );
+        T* item = entry->item;
+        unlinkEntry( entry );
+        return item;
+    }
+
+    Entry* newEntry( T* item ) {
+        if ( m_nextSeq - m_seqBase == m_rank.size() - 1 ) {
+            renumber();
+        }
+
+        Entry* entry = new Entry;
+        entry->item = item;
+        entry->seq = m_nextSeq++;
+        for ( int i = 0; i <= NumKeys; i++ ) {
+            entry->bucket[i] = NULL;
+        }
+
+        append( &m_order, entry, OrderLink );
+        rankAdd( entry->seq, 1 );
+        m_entries[item] = entry;
+        return entry;
+    }
+
+    void link( Entry* entry, const Key& key ) {
+        Bucket& bucket = m_buckets[key];
+        bucket.key = key;
+        append( &bucket, entry, key.kind );
+    }
+
+    void append( Bucket* bucket, Entry* entry, int slot ) {
+        entry->bucket[slot] = bucket;
+        entry->prev[slot] = bucket->tail;
+        entry->next[slot] = NULL;
+        if ( bucket->tail ) {
+            bucket->tail->next[slot] = entry;
+        } else {
+            bucket->head = entry;
+        }
+        bucket->tail = entry;
+        ++bucket->size;
+    }
+
+    void unlinkEntry( Entry* entry ) {
+        for ( int slot = 0; slot < NumKeys; slot++ ) {
+            Bucket* bucket = entry->bucket[slot];
+            if ( NULL == bucket ) {
+                continue;
+            }
+            unlinkSlot( bucket, entry, slot );
+            if ( 0 == bucket->size ) {
+                m_buckets.erase( bucket->key );
+            }
+        }
+        unlinkSlot( &m_order, entry, OrderLink );
+        rankAdd( entry->seq, -1 );
+        m_entries.erase( entry->item );
+        delete entry;
+    }
+
+    void unlinkSlot( Bucket* bucket, Entry* entry, int slot ) {
+        if ( entry->prev[slot] ) {
+            entry->prev[slot]->next[slot] = entry->next[slot];
+        } else {
+            bucket->head = entry->next[slot];
+        }
+        if ( entry->next[slot] ) {
+            entry->next[slot]->prev[slot] = entry->prev[slot];
+        } else {
+            bucket->tail = entry->prev[slot];
+        }
+        --bucket->size;
+    }
+
+    // m_rank is a Fenwick tree over sequence numbers so the position an
+    // entry would have in a single list is found in O(log n)
+    void rankAdd( uint64_t seq, int value ) {
+        for ( size_t i = seq - m_seqBase + 1; i < m_rank.size(); i += i & -i ) {
+            m_rank[i] += value;
+        }
+    }
+
+    size_t rankOf( uint64_t seq ) {
+        size_t sum = 0;
+        for ( size_t i = seq - m_seqBase + 1; i > 0; i -= i & -i ) {
+            sum += m_rank[i];
+        }
+        return sum;
+    }
+
+    void renumber() {
+        size_t capacity = m_rank.size() - 1;
+        if ( m_order.size * 2 > capacity ) {
+            capacity *= 2;
+        }
+
+        m_rank.assign( capacity + 1, 0 );
+        m_seqBase = m_nextSeq;
+        for ( Entry* entry = m_order.head; entry; entry = entry->next[OrderLink] ) {
+            entry->seq = m_nextSeq++;
+            rankAdd( entry->seq, 1 );
+        }
+    }
+
+    uint64_t    m_seqBase;
+    uint64_t    m_nextSeq;
+    std::vector<int32_t> m_rank;
+    Bucket      m_order;     // every entry, oldest first
+    BucketMap   m_buckets;
+    std::unordered_map< T*, Entry* > m_entries;
+};
+
+}
+}
+}
+
+#endif
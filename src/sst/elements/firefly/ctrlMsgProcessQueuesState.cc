@@ -50,6 +50,12 @@ ProcessQueuesState::ProcessQueuesState( ComponentId_t id, Params& params ) :
 
     m_dbg.init("", level, mask, Output::STDOUT );
 
+    std::string matchCostModel = params.find<std::string>("pqs.matchCostModel","linear");
+    if ( ! m_matchCost.init( matchCostModel, params.find<int>("pqs.matchCostConstant",1) ) ) {
+        m_dbg.fatal(CALL_INFO,-1,"unknown pqs.matchCostModel `%s`, expected linear, hash or constant\n",
+                                                    matchCostModel.c_str() );
+    }
+
     m_statPstdRcv = registerStatistic<uint64_t>("posted_receive_list");
     m_statRcvdMsg = registerStatistic<uint64_t>("received_msg_list");
 
@@ -343,7 +349,7 @@ void ProcessQueuesState::processRecv_1( _CommReq* req )
         processShortList_0( &m_funcStack );
     } else {
         dbg().debug(CALL_INFO,2,DBG_MSK_PQS_APP_SIDE,"post receive\n");
-        m_pstdRcvQ.push_back( req );
+        m_pstdRcvQ.pushPattern( req, req->hdr(), req->ignore() );
         processRecv_2( NULL, req );
     }
 }
@@ -358,7 +364,8 @@ void ProcessQueuesState::processRecv_2( Stack* stack, _CommReq* req )
 
     if ( ! m_pstdRcvPreQ.empty() ) {
         dbg().debug(CALL_INFO,2,DBG_MSK_PQS_APP_SIDE,"no match against unexpected queue move to pstRecvQ\n");
-        m_pstdRcvQ.push_back( m_pstdRcvPreQ.front() );
+        _CommReq* preReq = m_pstdRcvPreQ.front();
+        m_pstdRcvQ.pushPattern( preReq, preReq->hdr(), preReq->ignore() );
         m_pstdRcvPreQ.clear();
     }
 
@@ -408,19 +415,38 @@ void ProcessQueuesState::processMakeProgress( Stack* stack )
 
 void ProcessQueuesState::enterCancel( MP::MessageRequest req, uint64_t exitDelay ) {
 
-    std::deque< _CommReq* >:: iterator iter = m_pstdRcvQ.begin();
-    for ( ; iter != m_pstdRcvQ.end(); ++iter ) {
-
-		if ( *iter == req ) {
-    		dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"found req=%p\n",*iter);
-			delete( *iter );
-        	m_pstdRcvQ.erase(iter);
-			break;
-		}
+    _CommReq* commReq = static_cast< _CommReq* >( req );
+    if ( m_pstdRcvQ.remove( commReq ) ) {
+        dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"found req=%p\n",commReq);
+        delete commReq;
     }
     enterMakeProgress(m_exitDelay);
 }
 
+void ProcessQueuesState::enterNicCollective( uint32_t id, const Hermes::MemAddr& input,
+        const Hermes::MemAddr& output, uint32_t count, MP::PayloadDataType dtype,
+        size_t dtypeSize, MP::ReductionOperation op, const VirtNic::CollTopo& topo,
+        uint64_t exitDelay )
+{
+    dbg().debug(CALL_INFO,1,DBG_MSK_PQS_APP_SIDE,"id=%#x count=%u\n", id, count );
+
+    m_exitDelay = exitDelay;
+
+    // the NIC calls back once the result is in host memory
+    if ( m_nic->isBlocked() ) {
+        VirtNic::CollTopo tmp = topo;
+        m_nic->setBlockedCallback(
+            [=]() {
+                m_nic->collective( id, input, output, count, dtype, dtypeSize, op, tmp,
+                        [=]() { exit(); } );
+            }
+        );
+    } else {
+        m_nic->collective( id, input, output, count, dtype, dtypeSize, op, topo,
+                [=]() { exit(); } );
+    }
+}
+
 void ProcessQueuesState::enterTest( WaitReq* req, int* flag, uint64_t exitDelay  )
 {
 	dbg().debug(CALL_INFO,1,DBG_MSK_PQS_APP_SIDE,"\n");
@@ -604,7 +630,7 @@ void ProcessQueuesState::processShortList_0( Stack* stack )
     ProcessShortListCtx* ctx;
     if ( m_intStack.empty() ) {
         dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"use unexpectedMsgQ %zu\n",m_unexpectedMsgQ.size());
-        ctx = new ProcessShortListCtx( &m_unexpectedMsgQ );
+        ctx = new ProcessShortListCtx( );
     } else {
         dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"use recvdMsgQ pos=%d\n",m_recvdMsgQpos);
         ctx = new ProcessShortListCtx( &m_recvdMsgQ[m_recvdMsgQpos] );
@@ -627,7 +653,15 @@ void ProcessQueuesState::processShortList_1( Stack* stack )
 
     int count = 0;
     if ( m_intStack.empty() ) {
-        ctx->req = searchPostedRecv( m_pstdRcvPreQ, ctx->hdr(), count );
+        // the receive being posted is looked up in the unexpected queue
+        _CommReq* req = m_pstdRcvPreQ.front();
+        ctx->setMsg( searchUnexpectedMsg( req, count ) );
+        if ( ctx->msg() ) {
+            ctx->req = req;
+            m_pstdRcvPreQ.clear();
+        } else {
+            ctx->req = NULL;
+        }
     } else {
         ctx->req = searchPostedRecv( m_pstdRcvQ, ctx->hdr(), count );
     }
@@ -654,7 +688,7 @@ void ProcessQueuesState::processShortList_2( Stack* stack )
         if ( m_intStack.empty() ) {
             ctx->incPos();
         } else {
-            m_unexpectedMsgQ.push_back( ctx->msg() );
+            m_unexpectedMsgQ.pushMessage( ctx->msg(), ctx->hdr() );
             ctx->unlinkMsg();
         }
         processShortList_5( stack );
@@ -985,28 +1019,38 @@ void ProcessQueuesState::loopHandler( int srcCore, std::vector<IoVec>& vec, void
     runInterruptCtx();
 }
 
-_CommReq* ProcessQueuesState::searchPostedRecv( std::deque< _CommReq* >& pstd, MatchHdr& hdr, int& count )
+_CommReq* ProcessQueuesState::searchPostedRecv( MatchList< _CommReq >& pstd, MatchHdr& hdr, int& count )
 {
-    _CommReq* req = NULL;
     dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"posted size %lu\n",pstd.size());
 
-    std::deque< _CommReq* >:: iterator iter = pstd.begin();
-    for ( ; iter != pstd.end(); ++iter ) {
+    MatchCost cost;
+    _CommReq* req = pstd.matchMessage( hdr,
+        [&]( _CommReq* posted ) { return checkMatchHdr( hdr, posted->hdr(), posted->ignore() ); },
+        cost );
+    count += m_matchCost.walkCount( cost );
 
-        ++count;
-        if ( ! checkMatchHdr( hdr, (*iter)->hdr(), (*iter)->ignore() ) ) {
-            continue;
-        }
-
-        req = *iter;
-        pstd.erase(iter);
-        break;
-    }
-    dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"req=%p\n",req);
+    dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"req=%p position=%zu probes=%zu examined=%zu\n",
+                                req, cost.position, cost.probes, cost.examined );
 
     return req;
 }
 
+ProcessQueuesState::Msg* ProcessQueuesState::searchUnexpectedMsg( _CommReq* req, int& count )
+{
+    dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"unexpected size %lu\n",m_unexpectedMsgQ.size());
+
+    MatchCost cost;
+    Msg* msg = m_unexpectedMsgQ.matchPattern( req->hdr(), req->ignore(),
+        [&]( Msg* unexpected ) { return checkMatchHdr( unexpected->hdr(), req->hdr(), req->ignore() ); },
+        cost );
+    count += m_matchCost.walkCount( cost );
+
+    dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"msg=%p position=%zu probes=%zu examined=%zu\n",
+                                msg, cost.position, cost.probes, cost.examined );
+
+    return msg;
+}
+
 bool ProcessQueuesState::checkMatchHdr( MatchHdr& hdr, MatchHdr& wantHdr,
                                     uint64_t ignore )
 {
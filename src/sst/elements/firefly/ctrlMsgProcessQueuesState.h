@@ -22,11 +22,13 @@
 #include <sst/core/output.h>
 
 #include "info.h"
+#include "virtNic.h"
 #include "heapAddrs.h"
 #include "ctrlMsgTiming.h"
 #include "loopBack.h"
 
 #include "ctrlMsgCommReq.h"
+#include "ctrlMsgMatchList.h"
 #include "ctrlMsgWaitReq.h"
 
 #define DBG_MSK_PQS_APP_SIDE 1 << 0
@@ -74,6 +76,8 @@ class ProcessQueuesState : public SubComponent
         {"pqs.maxUnexpectedMsg","Sets the maximum unexpected messages","32" },
         {"pqs.maxPostedShortBuffers","Sets the maximum posted short buffers","512" },
         {"pqs.minPostedShortBuffers","Sets the minimum posted short buffers","5"},
+        {"pqs.matchCostModel","Sets how matching is charged, linear (position in a single list), hash (buckets probed plus entries checked) or constant","linear"},
+        {"pqs.matchCostConstant","Sets the number of entries charged per match when pqs.matchCostModel is constant","1"},
         {"loopBackPortName","Sets port name to use when connecting to the loopBack component","loop"},
         {"ackVN","Sets the VN to use for acks","0"},
         {"rendezvousVN","Sets the VN to use for rendezvous","0"},
@@ -156,6 +160,10 @@ class ProcessQueuesState : public SubComponent
     void enterMakeProgress( uint64_t exitDelay = 0 );
     void enterCancel( MP::MessageRequest, uint64_t exitDelay = 0 );
     void enterTest( WaitReq*, int* flag, uint64_t exitDelay = 0 );
+    void enterNicCollective( uint32_t id, const Hermes::MemAddr& input,
+            const Hermes::MemAddr& output, uint32_t count, MP::PayloadDataType,
+            size_t dtypeSize, MP::ReductionOperation, const VirtNic::CollTopo&,
+            uint64_t exitDelay = 0 );
 
     void needRecv( int, size_t );
 
@@ -282,28 +290,46 @@ class ProcessQueuesState : public SubComponent
       public:
 
         ProcessShortListCtx( std::deque<Msg*>* msgQ ) :
-			m_msgQ(msgQ), m_iter( msgQ->begin() ), m_done(false) {}
+			m_done(false), m_msgQ(msgQ), m_iter( msgQ->begin() ), m_msg(NULL) {}
 
-        MatchHdr&   hdr() { return (*m_iter)->hdr(); }
-        std::vector<IoVec>& ioVec() { return (*m_iter)->ioVec(); }
+        // holds at most one message, the match for a receive found in the
+        // unexpected queue
+        ProcessShortListCtx( ) : m_done(false), m_msgQ(NULL), m_msg(NULL) {}
 
-        Msg* msg() { return *m_iter; }
+        MatchHdr&   hdr() { return msg()->hdr(); }
+        std::vector<IoVec>& ioVec() { return msg()->ioVec(); }
+
+        Msg* msg() { return m_msgQ ? *m_iter : m_msg; }
+        void setMsg( Msg* msg ) { m_msg = msg; }
 
         _CommReq*    req;
 
         void removeMsg() {
-            delete *m_iter;
+            delete msg();
             unlinkMsg();
         }
 
-        void unlinkMsg() { m_iter = m_msgQ->erase(m_iter); }
+        void unlinkMsg() {
+            if ( m_msgQ ) {
+                m_iter = m_msgQ->erase(m_iter);
+            } else {
+                m_msg = NULL;
+            }
+        }
         void setDone( ) { m_done = true; }
-        bool isDone() { return m_done || m_iter == m_msgQ->end();  }
-        void incPos() { ++m_iter; }
+        bool isDone() { return m_done || ( m_msgQ ? m_iter == m_msgQ->end() : NULL == m_msg );  }
+        void incPos() {
+            if ( m_msgQ ) {
+                ++m_iter;
+            } else {
+                m_msg = NULL;
+            }
+        }
       private:
         bool m_done;
         std::deque<Msg*>*                       m_msgQ;
         typename std::deque<Msg*>::iterator 	m_iter;
+        Msg*                                    m_msg;
     };
 
     class WaitCtx : public FuncCtxBase {
@@ -379,7 +405,8 @@ class ProcessQueuesState : public SubComponent
 
 
     bool        checkMatchHdr( MatchHdr& hdr, MatchHdr& wantHdr, uint64_t ignore );
-    _CommReq*	searchPostedRecv( std::deque< _CommReq* >& pstd, MatchHdr& hdr, int& delay );
+    _CommReq*	searchPostedRecv( MatchList< _CommReq >& pstd, MatchHdr& hdr, int& delay );
+    Msg*        searchUnexpectedMsg( _CommReq* req, int& delay );
 
     void exit( int delay = 0 ) {
         dbg().debug(CALL_INFO,2,DBG_MSK_PQS_APP_SIDE,"exit ProcessQueuesState\n");
@@ -480,11 +507,12 @@ class ProcessQueuesState : public SubComponent
     int     m_numRecvLooped;
     bool    m_missedInt;
 
-    std::deque< _CommReq* >         m_pstdRcvQ;
+    MatchList< _CommReq >           m_pstdRcvQ;
     std::deque< _CommReq* >         m_pstdRcvPreQ;
     std::vector<std::deque< Msg* >> m_recvdMsgQ;
 	int m_recvdMsgQpos;
-    std::deque< Msg* >              m_unexpectedMsgQ;
+    MatchList< Msg >                m_unexpectedMsgQ;
+    MatchCostModel                  m_matchCost;
 
     std::deque< _CommReq* >         m_longGetFiniQ;
     std::deque< GetInfo* >          m_longAckQ;
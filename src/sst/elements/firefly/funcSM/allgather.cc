@@ -31,10 +31,20 @@ const char* AllgatherFuncSM::m_enumName[] = {
 AllgatherFuncSM::AllgatherFuncSM( SST::Params& params ) :
     FunctionSMInterface( params ),
     m_event( NULL ),
-    m_seq( 0 )
+    m_seq( 0 ),
+    m_schedule( NULL )
 {
         m_smallCollectiveVN = params.find<int>( "smallCollectiveVN", 0);
         m_smallCollectiveSize = params.find<int>( "smallCollectiveSize", 0);
+
+        std::vector<std::string> known;
+        known.push_back( "bruck" );
+        known.push_back( "ring" );
+
+        std::string error;
+        if ( ! m_algorithms.init( params.find<std::string>( "algorithms", "0:0:bruck" ), known, error ) ) {
+            m_dbg.fatal(CALL_INFO,-1,"%s algorithms: %s\n", m_name.c_str(), error.c_str() );
+        }
 }
 
 void AllgatherFuncSM::handleStartEvent( SST::Event *e, Retval& retval )
@@ -47,6 +57,15 @@ void AllgatherFuncSM::handleStartEvent( SST::Event *e, Retval& retval )
     m_rank = m_info->getGroup(m_event->group)->getMyRank();
     m_size = m_info->getGroup(m_event->group)->getSize();
 
+    size_t bytes = 0;
+    for ( int i = 0; i < m_size; i++ ) {
+        bytes += chunkSize( i );
+    }
+    if ( m_algorithms.select( m_size, bytes ) == "ring" ) {
+        startSchedule( retval );
+        return;
+    }
+
     int numStages = ceil( log2(m_size) );
     m_dbg.debug(CALL_INFO,1,0,"numStages=%d rank=%d size=%d\n",
                                         numStages, m_rank, m_size );
@@ -63,6 +82,29 @@ void AllgatherFuncSM::handleStartEvent( SST::Event *e, Retval& retval )
     handleEnterEvent( retval );
 }
 
+void AllgatherFuncSM::startSchedule( Retval& retval )
+{
+    std::vector<size_t> offset( m_size ), len( m_size );
+    for ( int i = 0; i < m_size; i++ ) {
+        offset[i] = chunkOffset( i );
+        len[i] = chunkSize( i );
+    }
+
+    m_schedule = new CollectiveSchedule;
+    m_schedule->allgatherRing( m_rank, m_size, offset, len );
+
+    m_dbg.debug(CALL_INFO,1,0,"ring rank=%d size=%d, %zu rounds\n",
+                                    m_rank, m_size, m_schedule->numRounds() );
+
+    int vn = len[m_rank] <= m_smallCollectiveSize ? m_smallCollectiveVN : 0;
+
+    m_schedule->start( m_event->sendbuf.getBacking(), m_event->recvbuf.getBacking(),
+                genScheduleTag(), m_event->group, vn, m_event->recvtype,
+                m_info->sizeofDataType( m_event->recvtype ), NULL );
+
+    handleEnterEvent( retval );
+}
+
 bool AllgatherFuncSM::setup( Retval& retval )
 {
 	Hermes::MemAddr addr;
@@ -141,6 +183,19 @@ bool AllgatherFuncSM::setup( Retval& retval )
 void AllgatherFuncSM::handleEnterEvent( Retval& retval )
 {
     std::vector<IoVec> ioVec;
+
+    if ( m_schedule ) {
+        if ( ! m_schedule->run( proto(), m_dbg ) ) {
+            m_dbg.debug(CALL_INFO,1,0,"leave\n");
+            retval.setExit( 0 );
+            delete m_schedule;
+            m_schedule = NULL;
+            delete m_event;
+            m_event = NULL;
+        }
+        return;
+    }
+
     m_dbg.debug(CALL_INFO,1,0,"%s\n", stateName(m_state).c_str());
 
     switch( m_state ) {
@@ -18,6 +18,7 @@
 
 #include "funcSM/api.h"
 #include "funcSM/event.h"
+#include "funcSM/collectiveSchedule.h"
 #include "ctrlMsg.h"
 #include "info.h"
 
@@ -50,6 +51,10 @@ class AllgatherFuncSM :  public FunctionSMInterface
         SST::Firefly::AllgatherFuncSM
     )
 
+    SST_ELI_DOCUMENT_PARAMS(
+        {"algorithms","Sets the algorithm selection table, commSize:bytes:algorithm rules where the last rule at or below the call's communicator size and total gathered bytes wins. Algorithms are bruck and ring","0:0:bruck"},
+    )
+
   private:
     enum StateEnum {
         FOREACH_ENUM(GENERATE_ENUM)
@@ -82,6 +87,7 @@ class AllgatherFuncSM :  public FunctionSMInterface
   private:
 
     bool setup( Retval& );
+    void startSchedule( Retval& );
     void initIoVec(std::vector<IoVec>& ioVec, int startChunk, int numChunks, bool backed );
 
     std::string stateName( StateEnum i ) { return m_enumName[i]; }
@@ -92,6 +98,10 @@ class AllgatherFuncSM :  public FunctionSMInterface
         return CtrlMsg::AllgatherTag | (( m_seq & 0xff) << 8 );
     }
 
+    uint32_t genScheduleTag() {
+        return CtrlMsg::AllgatherTag | (( m_seq & 0xff) << 20 );
+    }
+
     int calcSrc ( int offset) {
         int src = ( m_rank - offset );
         return  src < 0 ? m_size + src : src;
@@ -109,6 +119,13 @@ class AllgatherFuncSM :  public FunctionSMInterface
         return ptr;
     }
 
+    size_t  chunkOffset( int rank ) {
+        if ( m_event->recvcntPtr ) {
+            return ((int*)m_event->displsPtr)[rank];
+        }
+        return rank * chunkSize( rank );
+    }
+
     size_t  chunkSize( int rank ) {
         size_t size;
 		int count;
@@ -137,6 +154,9 @@ class AllgatherFuncSM :  public FunctionSMInterface
     unsigned int        m_currentStage;
     static const char*  m_enumName[];
 
+    CollectiveAlgorithmTable    m_algorithms;
+    CollectiveSchedule*         m_schedule;
+
     int m_smallCollectiveVN;
     int m_smallCollectiveSize;
 };
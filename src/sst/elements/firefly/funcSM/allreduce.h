@@ -33,6 +33,12 @@ class AllreduceFuncSM :  public CollectiveTreeFuncSM
         SST::Firefly::CollectiveTreeFuncSM
     )
 
+    SST_ELI_DOCUMENT_PARAMS(
+        {"algorithms","Sets the algorithm selection table, commSize:bytes:algorithm rules where the last rule at or below the call's communicator size and bytes wins. Algorithms are tree, recursiveDoubling, rabenseifner, ring and nic, which runs the allreduce on the NIC","0:0:tree"},
+        {"offloadAlgorithm","Sets the algorithm the NIC runs for the nic algorithm and for allreduceOffload, tree or ring","tree"},
+        {"offloadTreeDegree","Sets the degree of the NIC tree","4"},
+    )
+
   public:
     AllreduceFuncSM( SST::Params& params ) : CollectiveTreeFuncSM( params ) { }
 
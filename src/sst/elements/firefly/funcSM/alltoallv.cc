@@ -46,6 +46,25 @@ void AlltoallvFuncSM::handleStartEvent( SST::Event *e, Retval& retval )
 
     m_dbg.debug(CALL_INFO,1,0,"Start size=%d\n",m_size);
 
+    // Bruck moves blocks through other ranks so they must all be the same size
+    if ( NULL == m_event->sendcnts && NULL == m_event->recvcnts &&
+            m_algorithms.select( m_size, sendChunkSize( 0 ) ) == "bruck" ) {
+
+        m_schedule = new CollectiveSchedule;
+        m_schedule->alltoallBruck( m_rank, m_size, sendChunkSize( 0 ) );
+
+        m_dbg.debug(CALL_INFO,1,0,"bruck, %zu rounds\n", m_schedule->numRounds() );
+
+        int vn = sendChunkSize( 0 ) <= m_smallCollectiveSize ? m_smallCollectiveVN : 0;
+
+        m_schedule->start( m_event->sendbuf.getBacking(), m_event->recvbuf.getBacking(),
+                genScheduleTag(), m_event->group, vn, m_event->recvtype,
+                m_info->sizeofDataType( m_event->recvtype ), NULL );
+
+        retval.setDelay( 0 );
+        return;
+    }
+
     void* recv = recvChunkPtr(m_rank);
     void* send = sendChunkPtr(m_rank);
     if ( recv && send ) {
@@ -59,6 +78,19 @@ void AlltoallvFuncSM::handleEnterEvent( Retval& retval )
 {
 	Hermes::MemAddr addr;
     MP:: RankID rank;
+
+    if ( m_schedule ) {
+        if ( ! m_schedule->run( proto(), m_dbg ) ) {
+            m_dbg.debug(CALL_INFO,1,0,"leave\n");
+            retval.setExit(0);
+            delete m_schedule;
+            m_schedule = NULL;
+            delete m_event;
+            m_event = NULL;
+        }
+        return;
+    }
+
     switch ( m_state ) {
       case PostRecv:
 
@@ -18,6 +18,7 @@
 
 #include "funcSM/api.h"
 #include "funcSM/event.h"
+#include "funcSM/collectiveSchedule.h"
 #include "info.h"
 #include "ctrlMsg.h"
 
@@ -49,6 +50,7 @@ class AlltoallvFuncSM :  public FunctionSMInterface
 	SST_ELI_DOCUMENT_PARAMS(
 		{"smallCollectiveVN","Sets the VN to use for small collectives","0"},
 		{"smallCollectiveSize","Sets the size of small collectives","0"},
+		{"algorithms","Sets the algorithm selection table, commSize:bytes:algorithm rules where the last rule at or below the call's communicator size and bytes per destination wins. Algorithms are pairwise and bruck, bruck is only used when every rank sends the same count","0:0:pairwise"},
 	)
   private:
 
@@ -66,10 +68,20 @@ class AlltoallvFuncSM :  public FunctionSMInterface
     AlltoallvFuncSM( SST::Params& params ) :
         FunctionSMInterface( params ),
         m_event( NULL ),
-        m_seq( 0 )
+        m_seq( 0 ),
+        m_schedule( NULL )
     {
        m_smallCollectiveVN = params.find<int>( "smallCollectiveVN", 0);
         m_smallCollectiveSize = params.find<int>( "smallCollectiveSize", 0);
+
+        std::vector<std::string> known;
+        known.push_back( "pairwise" );
+        known.push_back( "bruck" );
+
+        std::string error;
+        if ( ! m_algorithms.init( params.find<std::string>( "algorithms", "0:0:pairwise" ), known, error ) ) {
+            m_dbg.fatal(CALL_INFO,-1,"%s algorithms: %s\n", m_name.c_str(), error.c_str() );
+        }
     }
 
     virtual void handleStartEvent( SST::Event*, Retval& );
@@ -83,6 +95,10 @@ class AlltoallvFuncSM :  public FunctionSMInterface
         return CtrlMsg::AlltoallvTag | (( m_seq & 0xff) << 8 );
     }
 
+    uint32_t    genScheduleTag() {
+        return CtrlMsg::AlltoallvTag | (( m_seq & 0xff) << 20 );
+    }
+
     unsigned char* sendChunkPtr( MP::RankID rank ) {
         unsigned char* ptr = (unsigned char*) m_event->sendbuf.getBacking();
         if ( ! ptr ) return NULL;
@@ -146,6 +162,9 @@ class AlltoallvFuncSM :  public FunctionSMInterface
     unsigned int        m_size;
     MP::RankID          m_rank;
 
+    CollectiveAlgorithmTable    m_algorithms;
+    CollectiveSchedule*         m_schedule;
+
     int m_smallCollectiveVN;
     int m_smallCollectiveSize;
 
@@ -35,6 +35,12 @@ class BarrierFuncSM :  public CollectiveTreeFuncSM
         SST::Firefly::BarrierFuncSM
     )
 
+    SST_ELI_DOCUMENT_PARAMS(
+        {"algorithms","Sets the algorithm selection table, commSize:0:algorithm rules where the last rule at or below the call's communicator size wins. Algorithms are tree, recursiveDoubling and nic (a barrier carries no data so rabenseifner and ring also run as recursiveDoubling)","0:0:tree"},
+        {"offloadAlgorithm","Sets the algorithm the NIC runs for the nic algorithm and for barrierOffload, tree or ring","tree"},
+        {"offloadTreeDegree","Sets the degree of the NIC tree","4"},
+    )
+
   public:
     BarrierFuncSM( SST::Params& params ) : CollectiveTreeFuncSM( params ) {}
 
@@ -44,7 +50,7 @@ class BarrierFuncSM :  public CollectiveTreeFuncSM
 		Hermes::MemAddr addr(1,NULL);
         CollectiveStartEvent* tmp = new CollectiveStartEvent( addr, addr, 0,
                 MP::CHAR, MP::MAX, 0, event->group,
-                                CollectiveStartEvent::Allreduce );
+                                CollectiveStartEvent::Allreduce, event->offload );
 
         delete event;
 
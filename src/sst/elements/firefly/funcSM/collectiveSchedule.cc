@@ -0,0 +1,508 @@
+// Copyright 2013-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#include "funcSM/collectiveSchedule.h"
+#include "funcSM/collectiveOps.h"
+
+using namespace SST::Firefly;
+
+bool CollectiveAlgorithmTable::init( const std::string& table,
+                const std::vector<std::string>& known, std::string& error )
+{
+    m_rules.clear();
+
+    std::string::size_type pos = 0;
+    while ( pos < table.size() ) {
+        std::string::size_type end = table.find_first_of( " ,\t", pos );
+        if ( end == std::string::npos ) {
+            end = table.size();
+        }
+        std::string rule = table.substr( pos, end - pos );
+        pos = end + 1;
+
+        if ( rule.empty() ) {
+            continue;
+        }
+
+        std::string::size_type first = rule.find( ':' );
+        std::string::size_type second = first == std::string::npos ?
+                                    std::string::npos : rule.find( ':', first + 1 );
+        if ( second == std::string::npos ) {
+            error = "rule `" + rule + "` is not commSize:bytes:algorithm";
+            return false;
+        }
+
+        Rule tmp;
+        tmp.commSize = atoi( rule.substr( 0, first ).c_str() );
+        tmp.bytes = strtoull( rule.substr( first + 1, second - first - 1 ).c_str(), NULL, 0 );
+        tmp.algorithm = rule.substr( second + 1 );
+
+        if ( std::find( known.begin(), known.end(), tmp.algorithm ) == known.end() ) {
+            error = "unknown algorithm `" + tmp.algorithm + "`";
+            return false;
+        }
+        m_rules.push_back( tmp );
+    }
+
+    if ( m_rules.empty() ) {
+        error = "no rules";
+        return false;
+    }
+    return true;
+}
+
+const std::string& CollectiveAlgorithmTable::select( int commSize, size_t bytes ) const
+{
+    const Rule* found = &m_rules.front();
+    for ( unsigned i = 0; i < m_rules.size(); i++ ) {
+        if ( m_rules[i].commSize <= commSize && m_rules[i].bytes <= bytes ) {
+            found = &m_rules[i];
+        }
+    }
+    return found->algorithm;
+}
+
+CollectiveSchedule::CollectiveSchedule() :
+    m_allocated( false ),
+    m_round( 0 ),
+    m_phase( PostRecv )
+{
+    for ( int i = 0; i < NumBuffers; i++ ) {
+        m_bufLen[i] = 0;
+        m_buf[i] = NULL;
+    }
+}
+
+CollectiveSchedule::~CollectiveSchedule()
+{
+    if ( m_allocated ) {
+        free( m_buf[TmpBuf] );
+        free( m_buf[StageBuf] );
+    }
+}
+
+CollectiveSchedule::Round& CollectiveSchedule::addRound( uint32_t step )
+{
+    m_rounds.push_back( Round( step ) );
+    return m_rounds.back();
+}
+
+void CollectiveSchedule::addSend( Round& round, int peer, const Segment& seg )
+{
+    assert( -1 == round.sendPeer || peer == round.sendPeer );
+    round.sendPeer = peer;
+    round.send.push_back( seg );
+    reserve( seg );
+}
+
+void CollectiveSchedule::addRecv( Round& round, int peer, const Segment& seg )
+{
+    assert( -1 == round.recvPeer || peer == round.recvPeer );
+    round.recvPeer = peer;
+    round.recv.push_back( seg );
+    reserve( seg );
+}
+
+void CollectiveSchedule::addOp( Round& round, LocalOp::Type type,
+                                        const Segment& src, const Segment& dst )
+{
+    round.ops.push_back( LocalOp( type, src, dst ) );
+    reserve( src );
+    reserve( dst );
+}
+
+void CollectiveSchedule::reserve( const Segment& seg )
+{
+    m_bufLen[seg.buf] = std::max( m_bufLen[seg.buf], seg.offset + seg.len );
+}
+
+// Ranks beyond the largest power of two fold their data into a neighbour
+// first (the even rank of each of the first 2*rem pairs drops out) so the
+// main exchange runs on pof2 ranks, then get the result back afterwards
+void CollectiveSchedule::allreducePre( int rank, int size, size_t bytes,
+                                        int& pof2, int& rem, int& newRank )
+{
+    addOp( addRound( 0 ), LocalOp::Copy, Segment( InBuf, 0, bytes ), Segment( OutBuf, 0, bytes ) );
+
+    pof2 = 1;
+    while ( pof2 * 2 <= size ) {
+        pof2 *= 2;
+    }
+    rem = size - pof2;
+
+    if ( rank < 2 * rem ) {
+        if ( 0 == rank % 2 ) {
+            addSend( addRound( 0 ), rank + 1, Segment( OutBuf, 0, bytes ) );
+            newRank = -1;
+        } else {
+            Round& round = addRound( 0 );
+            addRecv( round, rank - 1, Segment( TmpBuf, 0, bytes ) );
+            addOp( round, LocalOp::Reduce, Segment( TmpBuf, 0, bytes ), Segment( OutBuf, 0, bytes ) );
+            newRank = rank / 2;
+        }
+    } else {
+        newRank = rank - rem;
+    }
+}
+
+void CollectiveSchedule::allreducePost( int rank, int rem, size_t bytes, uint32_t step )
+{
+    if ( rank < 2 * rem ) {
+        if ( rank % 2 ) {
+            addSend( addRound( step ), rank - 1, Segment( OutBuf, 0, bytes ) );
+        } else {
+            addRecv( addRound( step ), rank + 1, Segment( OutBuf, 0, bytes ) );
+        }
+    }
+}
+
+void CollectiveSchedule::allreduceRecursiveDoubling( int rank, int size, size_t bytes )
+{
+    int pof2, rem, newRank;
+    allreducePre( rank, size, bytes, pof2, rem, newRank );
+
+    uint32_t step = 1;
+    for ( int mask = 1; mask < pof2; mask <<= 1, step++ ) {
+        if ( -1 != newRank ) {
+            int peer = realRank( newRank ^ mask, rem );
+            Round& round = addRound( step );
+            addRecv( round, peer, Segment( TmpBuf, 0, bytes ) );
+            addSend( round, peer, Segment( OutBuf, 0, bytes ) );
+            addOp( round, LocalOp::Reduce, Segment( TmpBuf, 0, bytes ), Segment( OutBuf, 0, bytes ) );
+        }
+    }
+
+    allreducePost( rank, rem, bytes, step );
+}
+
+// Reduce-scatter by recursive halving then allgather by recursive doubling,
+// as in MPICH's reduce_scatter_allgather allreduce
+void CollectiveSchedule::allreduceRabenseifner( int rank, int size,
+                                        uint32_t count, size_t dtypeSize )
+{
+    int pof2 = 1;
+    while ( pof2 * 2 <= size ) {
+        pof2 *= 2;
+    }
+    if ( count < (uint32_t) pof2 ) {
+        allreduceRecursiveDoubling( rank, size, count * dtypeSize );
+        return;
+    }
+
+    size_t bytes = count * dtypeSize;
+    int rem, newRank;
+    allreducePre( rank, size, bytes, pof2, rem, newRank );
+
+    uint32_t steps = 0;
+    for ( int mask = 1; mask < pof2; mask <<= 1 ) {
+        ++steps;
+    }
+
+    if ( -1 != newRank ) {
+        uint32_t step = 1;
+        std::vector<size_t> cnts( pof2 ), disps( pof2 + 1 );
+        disps[0] = 0;
+        for ( int i = 0; i < pof2; i++ ) {
+            cnts[i] = ( count / pof2 + ( (uint32_t) i < count % pof2 ? 1 : 0 ) ) * dtypeSize;
+            disps[i + 1] = disps[i] + cnts[i];
+        }
+
+        int sendIdx = 0, recvIdx = 0, lastIdx = pof2;
+        int mask = 1;
+        while ( mask < pof2 ) {
+            int newPeer = newRank ^ mask;
+            int peer = realRank( newPeer, rem );
+            int sendEnd, recvEnd;
+
+            if ( newRank < newPeer ) {
+                sendIdx = recvIdx + pof2 / ( mask * 2 );
+                sendEnd = lastIdx;
+                recvEnd = sendIdx;
+            } else {
+                recvIdx = sendIdx + pof2 / ( mask * 2 );
+                sendEnd = recvIdx;
+                recvEnd = lastIdx;
+            }
+
+            Segment sendSeg( OutBuf, disps[sendIdx], disps[sendEnd] - disps[sendIdx] );
+            Segment recvSeg( TmpBuf, disps[recvIdx], disps[recvEnd] - disps[recvIdx] );
+
+            Round& round = addRound( step++ );
+            addRecv( round, peer, recvSeg );
+            addSend( round, peer, sendSeg );
+            addOp( round, LocalOp::Reduce, recvSeg, Segment( OutBuf, recvSeg.offset, recvSeg.len ) );
+
+            sendIdx = recvIdx;
+            mask <<= 1;
+            if ( mask < pof2 ) {
+                lastIdx = recvIdx + pof2 / mask;
+            }
+        }
+
+        mask >>= 1;
+        while ( mask > 0 ) {
+            int newPeer = newRank ^ mask;
+            int peer = realRank( newPeer, rem );
+            int sendEnd, recvEnd;
+
+            if ( newRank < newPeer ) {
+                if ( mask != pof2 / 2 ) {
+                    lastIdx = lastIdx + pof2 / ( mask * 2 );
+                }
+                recvIdx = sendIdx + pof2 / ( mask * 2 );
+                sendEnd = recvIdx;
+                recvEnd = lastIdx;
+            } else {
+                recvIdx = sendIdx - pof2 / ( mask * 2 );
+                sendEnd = lastIdx;
+                recvEnd = sendIdx;
+            }
+
+            Round& round = addRound( step++ );
+            addRecv( round, peer, Segment( OutBuf, disps[recvIdx], disps[recvEnd] - disps[recvIdx] ) );
+            addSend( round, peer, Segment( OutBuf, disps[sendIdx], disps[sendEnd] - disps[sendIdx] ) );
+
+            if ( newRank > newPeer ) {
+                sendIdx = recvIdx;
+            }
+            mask >>= 1;
+        }
+    }
+
+    allreducePost( rank, rem, bytes, 2 * steps + 1 );
+}
+
+// Reduce-scatter then allgather around a ring, each rank sends 2*(size-1)
+// messages of about count/size elements to its right neighbour
+void CollectiveSchedule::allreduceRing( int rank, int size, uint32_t count, size_t dtypeSize )
+{
+    if ( count < (uint32_t) size ) {
+        allreduceRecursiveDoubling( rank, size, count * dtypeSize );
+        return;
+    }
+
+    size_t bytes = count * dtypeSize;
+    addOp( addRound( 0 ), LocalOp::Copy, Segment( InBuf, 0, bytes ), Segment( OutBuf, 0, bytes ) );
+
+    std::vector<size_t> len( size ), offset( size + 1 );
+    offset[0] = 0;
+    for ( int i = 0; i < size; i++ ) {
+        len[i] = ( count / size + ( (uint32_t) i < count % size ? 1 : 0 ) ) * dtypeSize;
+        offset[i + 1] = offset[i] + len[i];
+    }
+
+    int left = ( rank - 1 + size ) % size;
+    int right = ( rank + 1 ) % size;
+
+    for ( int step = 0; step < size - 1; step++ ) {
+        int sendChunk = ( rank - step + size ) % size;
+        int recvChunk = ( rank - step - 1 + size ) % size;
+
+        Round& round = addRound( step + 1 );
+        addRecv( round, left, Segment( TmpBuf, offset[recvChunk], len[recvChunk] ) );
+        addSend( round, right, Segment( OutBuf, offset[sendChunk], len[sendChunk] ) );
+        addOp( round, LocalOp::Reduce, Segment( TmpBuf, offset[recvChunk], len[recvChunk] ),
+                                    Segment( OutBuf, offset[recvChunk], len[recvChunk] ) );
+    }
+
+    // rank now holds the reduced chunk rank+1
+    for ( int step = 0; step < size - 1; step++ ) {
+        int sendChunk = ( rank + 1 - step + size ) % size;
+        int recvChunk = ( rank - step + size ) % size;
+
+        Round& round = addRound( size + step );
+        addRecv( round, left, Segment( OutBuf, offset[recvChunk], len[recvChunk] ) );
+        addSend( round, right, Segment( OutBuf, offset[sendChunk], len[sendChunk] ) );
+    }
+}
+
+void CollectiveSchedule::allgatherRing( int rank, int size,
+        const std::vector<size_t>& offset, const std::vector<size_t>& len )
+{
+    addOp( addRound( 0 ), LocalOp::Copy, Segment( InBuf, 0, len[rank] ),
+                                    Segment( OutBuf, offset[rank], len[rank] ) );
+
+    int left = ( rank - 1 + size ) % size;
+    int right = ( rank + 1 ) % size;
+
+    for ( int step = 0; step < size - 1; step++ ) {
+        int sendChunk = ( rank - step + size ) % size;
+        int recvChunk = ( rank - step - 1 + size ) % size;
+
+        Round& round = addRound( step + 1 );
+        addRecv( round, left, Segment( OutBuf, offset[recvChunk], len[recvChunk] ) );
+        addSend( round, right, Segment( OutBuf, offset[sendChunk], len[sendChunk] ) );
+    }
+}
+
+// Bruck's algorithm, log2(size) rounds each moving about half the blocks.
+// Block j of a rank's working set is the one which has to travel j ranks,
+// in round k every block with bit k of j set moves 2^k ranks on and keeps
+// its index, so at the end block j came from rank-j.
+void CollectiveSchedule::alltoallBruck( int rank, int size, size_t blockLen )
+{
+    std::vector<Segment> where;
+    for ( int j = 0; j < size; j++ ) {
+        where.push_back( Segment( InBuf, ( ( rank + j ) % size ) * blockLen, blockLen ) );
+    }
+
+    uint32_t step = 1;
+    for ( int dist = 1; dist < size; dist <<= 1 ) {
+        Round& round = addRound( step++ );
+        int to = ( rank + dist ) % size;
+        int from = ( rank - dist + size ) % size;
+        size_t staged = 0;
+
+        for ( int j = dist; j < size; j++ ) {
+            if ( j & dist ) {
+                Segment stage( StageBuf, staged * blockLen, blockLen );
+                addSend( round, to, where[j] );
+                addRecv( round, from, stage );
+                addOp( round, LocalOp::Copy, stage, Segment( TmpBuf, j * blockLen, blockLen ) );
+                where[j] = Segment( TmpBuf, j * blockLen, blockLen );
+                ++staged;
+            }
+        }
+    }
+
+    Round& round = addRound( 0 );
+    for ( int j = 0; j < size; j++ ) {
+        addOp( round, LocalOp::Copy, where[j],
+                    Segment( OutBuf, ( ( rank - j + size ) % size ) * blockLen, blockLen ) );
+    }
+}
+
+void CollectiveSchedule::start( void* input, void* output, uint32_t tagBase,
+        MP::Communicator group, int vn, MP::PayloadDataType dtype, size_t dtypeSize,
+        MP::ReductionOperation op )
+{
+    m_buf[InBuf] = input;
+    m_buf[OutBuf] = output;
+    if ( output ) {
+        m_buf[TmpBuf] = m_bufLen[TmpBuf] ? malloc( m_bufLen[TmpBuf] ) : NULL;
+        m_buf[StageBuf] = m_bufLen[StageBuf] ? malloc( m_bufLen[StageBuf] ) : NULL;
+        m_allocated = true;
+    }
+
+    m_tagBase = tagBase;
+    m_group = group;
+    m_vn = vn;
+    m_dtype = dtype;
+    m_dtypeSize = dtypeSize;
+    m_op = op;
+
+    m_round = 0;
+    m_phase = PostRecv;
+}
+
+void CollectiveSchedule::initIoVec( std::vector<IoVec>& ioVec,
+                                        const std::vector<Segment>& segs )
+{
+    for ( unsigned i = 0; i < segs.size(); i++ ) {
+        if ( 0 == segs[i].len ) {
+            continue;
+        }
+        IoVec tmp;
+        tmp.addr.setSimVAddr( 1 );
+        tmp.addr.setBacking( ptr( segs[i] ) );
+        tmp.len = segs[i].len;
+        ioVec.push_back( tmp );
+    }
+
+    if ( ioVec.empty() ) {
+        IoVec tmp;
+        tmp.addr.setSimVAddr( 1 );
+        tmp.addr.setBacking( NULL );
+        tmp.len = 0;
+        ioVec.push_back( tmp );
+    }
+}
+
+void CollectiveSchedule::doLocalOps( Round& round )
+{
+    if ( NULL == m_buf[OutBuf] ) {
+        return;
+    }
+
+    for ( unsigned i = 0; i < round.ops.size(); i++ ) {
+        LocalOp& op = round.ops[i];
+        void* src = ptr( op.src );
+        void* dst = ptr( op.dst );
+
+        if ( NULL == src || src == dst || 0 == op.dst.len ) {
+            continue;
+        }
+
+        if ( LocalOp::Copy == op.type ) {
+            memcpy( dst, src, op.dst.len );
+        } else {
+            void* input[2] = { dst, src };
+            collectiveOp( input, 2, dst, op.dst.len / m_dtypeSize, m_dtype, m_op );
+        }
+    }
+}
+
+bool CollectiveSchedule::run( CtrlMsg::API* proto, Output& dbg )
+{
+    while ( m_round < m_rounds.size() ) {
+        Round& round = m_rounds[m_round];
+        std::vector<IoVec> ioVec;
+
+        switch ( m_phase ) {
+          case PostRecv:
+            m_phase = PostSend;
+            m_waitReqs.clear();
+            if ( -1 != round.recvPeer ) {
+                initIoVec( ioVec, round.recv );
+                dbg.debug(CALL_INFO,1,0,"round %zu irecv from %d\n", m_round, round.recvPeer );
+                proto->irecvv( ioVec, round.recvPeer, tag( round ), m_group, &m_recvReq );
+                m_waitReqs.push_back( &m_recvReq );
+                return true;
+            }
+
+          case PostSend:
+            m_phase = Wait;
+            if ( -1 != round.sendPeer ) {
+                initIoVec( ioVec, round.send );
+                dbg.debug(CALL_INFO,1,0,"round %zu isend to %d\n", m_round, round.sendPeer );
+                proto->isendv( ioVec, round.sendPeer, tag( round ), m_group, &m_sendReq, m_vn );
+                m_waitReqs.push_back( &m_sendReq );
+                return true;
+            }
+
+          case Wait:
+            m_phase = Local;
+            if ( ! m_waitReqs.empty() ) {
+                dbg.debug(CALL_INFO,1,0,"round %zu wait\n", m_round );
+                proto->waitAll( m_waitReqs );
+                return true;
+            }
+
+          case Local:
+            doLocalOps( round );
+            ++m_round;
+            m_phase = PostRecv;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,156 @@
+// Copyright 2013-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef COMPONENTS_FIREFLY_FUNCSM_COLLECTIVE_SCHEDULE_H
+#define COMPONENTS_FIREFLY_FUNCSM_COLLECTIVE_SCHEDULE_H
+
+#include <string>
+#include <vector>
+
+#include "funcSM/api.h"
+#include "ctrlMsg.h"
+
+namespace SST {
+namespace Firefly {
+
+// Picks a collective algorithm from the communicator size and the message
+// size. The table is a list of "commSize:bytes:algorithm" rules separated by
+// spaces or commas, the last rule whose commSize and bytes are both at or
+// below the call's is used, for example
+//     "0:0:recursiveDoubling 0:2048:rabenseifner 0:1048576:ring"
+// If no rule applies the first one is used.
+class CollectiveAlgorithmTable {
+  public:
+    bool init( const std::string& table, const std::vector<std::string>& known,
+                                                            std::string& error );
+    const std::string& select( int commSize, size_t bytes ) const;
+
+  private:
+    struct Rule {
+        int         commSize;
+        size_t      bytes;
+        std::string algorithm;
+    };
+    std::vector<Rule> m_rules;
+};
+
+// A collective as a list of rounds, each round sends to and/or receives
+// from one peer then does local copies and reductions on the data. The
+// builders below fill in the rounds for one rank, run() then issues them
+// one protocol call at a time from a function state machine.
+class CollectiveSchedule {
+
+  public:
+    enum Buffer { InBuf, OutBuf, TmpBuf, StageBuf, NumBuffers };
+
+    struct Segment {
+        Segment( Buffer buf, size_t offset, size_t len ) :
+            buf( buf ), offset( offset ), len( len ) {}
+        Buffer  buf;
+        size_t  offset;
+        size_t  len;
+    };
+
+    struct LocalOp {
+        enum Type { Copy, Reduce };
+        LocalOp( Type type, const Segment& src, const Segment& dst ) :
+            type( type ), src( src ), dst( dst ) {}
+        Type    type;
+        Segment src;
+        Segment dst;
+    };
+
+    struct Round {
+        Round( uint32_t step ) : step( step ), sendPeer( -1 ), recvPeer( -1 ) {}
+        uint32_t                step;    // same on every rank, used for the tag
+        int                     sendPeer;
+        std::vector<Segment>    send;
+        int                     recvPeer;
+        std::vector<Segment>    recv;
+        std::vector<LocalOp>    ops;     // done after the send and receive complete
+    };
+
+    CollectiveSchedule();
+    ~CollectiveSchedule();
+
+    // Allreduce of bytes, reduces into OutBuf
+    void allreduceRecursiveDoubling( int rank, int size, size_t bytes );
+    void allreduceRabenseifner( int rank, int size, uint32_t count, size_t dtypeSize );
+    void allreduceRing( int rank, int size, uint32_t count, size_t dtypeSize );
+
+    // Allgather(v) of chunks at the given OutBuf offsets
+    void allgatherRing( int rank, int size,
+            const std::vector<size_t>& offset, const std::vector<size_t>& len );
+
+    // Alltoall with the same block size for every rank
+    void alltoallBruck( int rank, int size, size_t blockLen );
+
+    // input and output are the backing of the user's buffers, if output has
+    // no backing no data is moved or reduced
+    void start( void* input, void* output, uint32_t tagBase, MP::Communicator group,
+            int vn, MP::PayloadDataType dtype, size_t dtypeSize, MP::ReductionOperation op );
+
+    // issues the next protocol call, returns false once every round is done
+    bool run( CtrlMsg::API* proto, Output& dbg );
+
+    size_t numRounds() { return m_rounds.size(); }
+
+  private:
+    enum Phase { PostRecv, PostSend, Wait, Local };
+
+    Round& addRound( uint32_t step );
+    void addSend( Round&, int peer, const Segment& );
+    void addRecv( Round&, int peer, const Segment& );
+    void addOp( Round&, LocalOp::Type, const Segment& src, const Segment& dst );
+    void reserve( const Segment& );
+
+    void allreducePre( int rank, int size, size_t bytes, int& pof2, int& rem, int& newRank );
+    void allreducePost( int rank, int rem, size_t bytes, uint32_t step );
+    int realRank( int newRank, int rem ) {
+        return newRank < rem ? newRank * 2 + 1 : newRank + rem;
+    }
+
+    // every step has its own tag so steps with the same peer can't cross
+    uint32_t tag( Round& round ) { return m_tagBase | ( round.step & 0xfffff ); }
+
+    void initIoVec( std::vector<IoVec>&, const std::vector<Segment>& );
+    void* ptr( const Segment& seg ) {
+        return m_buf[seg.buf] ? (unsigned char*) m_buf[seg.buf] + seg.offset : NULL;
+    }
+    void doLocalOps( Round& );
+
+    std::vector<Round>  m_rounds;
+    size_t              m_bufLen[NumBuffers];
+    void*               m_buf[NumBuffers];
+    bool                m_allocated;
+
+    size_t              m_round;
+    Phase               m_phase;
+    CtrlMsg::CommReq    m_recvReq;
+    CtrlMsg::CommReq    m_sendReq;
+    std::vector<CtrlMsg::CommReq*> m_waitReqs;
+
+    uint32_t                m_tagBase;
+    MP::Communicator        m_group;
+    int                     m_vn;
+    MP::PayloadDataType     m_dtype;
+    size_t                  m_dtypeSize;
+    MP::ReductionOperation  m_op;
+};
+
+}
+}
+
+#endif
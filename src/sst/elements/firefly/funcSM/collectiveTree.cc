@@ -33,6 +33,22 @@ void CollectiveTreeFuncSM::handleStartEvent( SST::Event *e, Retval& retval )
 
     ++m_seq;
 
+    // Reduce and Bcast always use the tree
+    if ( m_event->type == CollectiveStartEvent::Allreduce ) {
+        int rank = m_info->getGroup(m_event->group)->getMyRank();
+        int size = m_info->getGroup(m_event->group)->getSize();
+        const std::string& algorithm = m_algorithms.select( size,
+                            m_event->count * m_info->sizeofDataType( m_event->dtype ) );
+        if ( m_event->offload || algorithm == "nic" ) {
+            startOffload( rank, size );
+            return;
+        }
+        if ( algorithm != "tree" ) {
+            startSchedule( algorithm, rank, size, retval );
+            return;
+        }
+    }
+
     m_yyy = new YYY( 2, m_info->getGroup(m_event->group)->getMyRank(),
                 m_info->getGroup(m_event->group)->getSize(), m_event->root );
 
@@ -87,10 +103,89 @@ void CollectiveTreeFuncSM::handleStartEvent( SST::Event *e, Retval& retval )
     handleEnterEvent( retval );
 }
 
+void CollectiveTreeFuncSM::startSchedule( const std::string& algorithm,
+                                    int rank, int size, Retval& retval )
+{
+    size_t dtypeSize = m_info->sizeofDataType( m_event->dtype );
+    size_t bufLen = m_event->count * dtypeSize;
+
+    m_schedule = new CollectiveSchedule;
+    if ( algorithm == "recursiveDoubling" ) {
+        m_schedule->allreduceRecursiveDoubling( rank, size, bufLen );
+    } else if ( algorithm == "rabenseifner" ) {
+        m_schedule->allreduceRabenseifner( rank, size, m_event->count, dtypeSize );
+    } else {
+        m_schedule->allreduceRing( rank, size, m_event->count, dtypeSize );
+    }
+
+    m_dbg.debug(CALL_INFO,1,0,"%s %s group %d, size %d, rank %d, %zu rounds\n",
+                m_event->typeName(), algorithm.c_str(), m_event->group, size, rank,
+                m_schedule->numRounds() );
+
+    int vn = bufLen <= m_smallCollectiveSize ? m_smallCollectiveVN : 0;
+
+    m_schedule->start( m_event->mydata.getBacking(), m_event->result.getBacking(),
+                    genScheduleTag(), m_event->group, vn, m_event->dtype, dtypeSize, m_event->op );
+
+    handleEnterEvent( retval );
+}
+
+void CollectiveTreeFuncSM::startOffload( int rank, int size )
+{
+    Group* group = m_info->getGroup( m_event->group );
+    VirtNic::CollTopo topo;
+
+    topo.ring = m_offloadRing;
+    if ( m_offloadRing ) {
+        topo.left = group->getMapping( ( rank + size - 1 ) % size );
+        topo.right = group->getMapping( ( rank + 1 ) % size );
+        topo.ringPos = rank;
+        topo.ringSize = size;
+    } else {
+        YYY tree( m_offloadTreeDegree, rank, size, 0 );
+        if ( -1 != tree.parent() ) {
+            topo.parent = group->getMapping( tree.parent() );
+        }
+        for ( unsigned int i = 0; i < tree.numChildren(); i++ ) {
+            topo.children.push_back( group->getMapping( tree.calcChild( i ) ) );
+        }
+    }
+
+    m_dbg.debug(CALL_INFO,1,0,"%s nic %s group %d, size %d, rank %d\n",
+                m_event->typeName(), m_offloadRing ? "ring" : "tree",
+                m_event->group, size, rank );
+
+    m_offload = true;
+    proto()->nicCollective( genOffloadId(), m_event->mydata, m_event->result,
+                m_event->count, m_event->dtype, m_event->op, topo );
+}
+
 void CollectiveTreeFuncSM::handleEnterEvent( Retval& retval )
 {
+    if ( m_offload ) {
+        m_dbg.debug(CALL_INFO,1,0,"Exit\n" );
+        retval.setExit( 0 );
+        m_offload = false;
+        delete m_event;
+        m_event = NULL;
+        return;
+    }
+
 	Hermes::MemAddr addr;
     int child;
+
+    if ( m_schedule ) {
+        if ( ! m_schedule->run( proto(), m_dbg ) ) {
+            m_dbg.debug(CALL_INFO,1,0,"Exit\n" );
+            retval.setExit( 0 );
+            delete m_schedule;
+            m_schedule = NULL;
+            delete m_event;
+            m_event = NULL;
+        }
+        return;
+    }
+
     m_dbg.debug(CALL_INFO,1,0,"%s state\n", stateName(m_state).c_str());
 
     switch ( m_state ) {
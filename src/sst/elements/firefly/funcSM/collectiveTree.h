@@ -18,6 +18,7 @@
 
 #include "funcSM/api.h"
 #include "funcSM/event.h"
+#include "funcSM/collectiveSchedule.h"
 #include "ctrlMsg.h"
 
 namespace SST {
@@ -139,10 +140,35 @@ private:
         FunctionSMInterface( params ),
         m_event( NULL ),
         m_seq( 0 ),
+        m_schedule( NULL ),
+        m_offload( false ),
         m_vn( 0 )
     {
         m_smallCollectiveVN = params.find<int>( "smallCollectiveVN", 0);
         m_smallCollectiveSize = params.find<int>( "smallCollectiveSize", 0);
+
+        std::vector<std::string> known;
+        known.push_back( "tree" );
+        known.push_back( "recursiveDoubling" );
+        known.push_back( "rabenseifner" );
+        known.push_back( "ring" );
+        known.push_back( "nic" );
+
+        std::string error;
+        if ( ! m_algorithms.init( params.find<std::string>( "algorithms", "0:0:tree" ), known, error ) ) {
+            m_dbg.fatal(CALL_INFO,-1,"%s algorithms: %s\n", m_name.c_str(), error.c_str() );
+        }
+
+        std::string offloadAlgorithm = params.find<std::string>( "offloadAlgorithm", "tree" );
+        if ( offloadAlgorithm != "tree" && offloadAlgorithm != "ring" ) {
+            m_dbg.fatal(CALL_INFO,-1,"%s offloadAlgorithm: unknown algorithm `%s`\n",
+                                        m_name.c_str(), offloadAlgorithm.c_str() );
+        }
+        m_offloadRing = offloadAlgorithm == "ring";
+        m_offloadTreeDegree = params.find<int>( "offloadTreeDegree", 4 );
+        if ( m_offloadTreeDegree < 1 ) {
+            m_dbg.fatal(CALL_INFO,-1,"%s offloadTreeDegree must be at least 1\n", m_name.c_str() );
+        }
     }
 
     virtual void handleStartEvent( SST::Event*, Retval& );
@@ -154,6 +180,20 @@ private:
         return CtrlMsg::CollectiveTag | (m_seq & 0xffff);
     }
 
+    uint32_t    genScheduleTag() {
+        return CtrlMsg::CollectiveTag | (( m_seq & 0xff ) << 20 );
+    }
+
+    // the NIC matches on the id, barrier and allreduce are different
+    // function state machines each with its own sequence number
+    uint32_t    genOffloadId() {
+        return ( ( m_event->group & 0xffff ) << 16 ) |
+                ( m_name == "Barrier" ? 0x8000 : 0 ) | ( m_seq & 0x7fff );
+    }
+
+    void startSchedule( const std::string& algorithm, int rank, int size, Retval& );
+    void startOffload( int rank, int size );
+
     CtrlMsg::API* proto() { return static_cast<CtrlMsg::API*>(m_proto); }
 
     WaitUpState         m_waitUpState;
@@ -169,6 +209,13 @@ private:
     YYY*                m_yyy;
     int                 m_seq;
 
+    CollectiveAlgorithmTable    m_algorithms;
+    CollectiveSchedule*         m_schedule;
+
+    bool    m_offload;
+    bool    m_offloadRing;
+    int     m_offloadTreeDegree;
+
     int m_vn;
     int m_smallCollectiveVN;
     int m_smallCollectiveSize;
@@ -78,11 +78,13 @@ class MakeProgressStartEvent : public Event {
 
 class BarrierStartEvent : public Event {
   public:
-    BarrierStartEvent( MP::Communicator _group ) :
-        group( _group )
+    BarrierStartEvent( MP::Communicator _group, bool _offload = false ) :
+        group( _group ),
+        offload( _offload )
     { }
 
     MP::Communicator group;
+    bool offload;
 
     NotSerializable(BarrierStartEvent)
 };
@@ -152,7 +154,7 @@ class CollectiveStartEvent : public Event {
                 const Hermes::MemAddr& _mydata, const Hermes::MemAddr& _result, uint32_t _count,
                 MP::PayloadDataType _dtype, MP::ReductionOperation _op,
                 MP::RankID _root, MP::Communicator _group,
-                Type _type ) :
+                Type _type, bool _offload = false ) :
         mydata(_mydata),
         result(_result),
         count(_count),
@@ -160,7 +162,8 @@ class CollectiveStartEvent : public Event {
         op(_op),
         root(_root),
         group(_group),
-        type( _type )
+        type( _type ),
+        offload( _offload )
     {}
 
     const char* typeName() {
@@ -183,6 +186,7 @@ class CollectiveStartEvent : public Event {
     MP::RankID  root;
     MP::Communicator group;
     Type  type;
+    bool  offload;  // run on the NIC, only for Allreduce
 
     NotSerializable(CollectiveStartEvent)
 };
@@ -47,6 +47,7 @@ FunctionSM::FunctionSM( ComponentId_t id, SST::Params& params, ProtocolAPI* prot
 	SubComponent(id),
     m_sm( NULL ),
     m_params( params ),
+    m_info( NULL ),
     m_proto( proto )
 {
 
@@ -87,31 +88,36 @@ void FunctionSM::setup( Info* info )
     snprintf(buffer,100,"@t:%d:FunctionSM::@p():@l ", nodeId );
     m_dbg.setPrefix(buffer);
 
-    m_smV.resize( NumFunctions );
+    // a rank only calls a few of the functions, each state machine is
+    // loaded the first time its function is called
+    m_smV.resize( NumFunctions, NULL );
+    m_info = info;
 
-    Params defaultParams;
-    defaultParams.enableVerify(false);
-    defaultParams.insert( "module" , m_params.find<std::string>("defaultModule","firefly"), true );
-    defaultParams.insert( "enterLatency",
+    m_defaultParams.enableVerify(false);
+    m_defaultParams.insert( "module" , m_params.find<std::string>("defaultModule","firefly"), true );
+    m_defaultParams.insert( "enterLatency",
                         m_params.find<std::string>("defaultEnterLatency","0"), true );
-    defaultParams.insert( "returnLatency",
+    m_defaultParams.insert( "returnLatency",
                         m_params.find<std::string>("defaultReturnLatency","0"), true );
-    defaultParams.insert( "smallCollectiveVN",
+    m_defaultParams.insert( "smallCollectiveVN",
                         m_params.find<std::string>("smallCollectiveVN","0"), true );
-    defaultParams.insert( "smallCollectiveSize",
+    m_defaultParams.insert( "smallCollectiveSize",
                         m_params.find<std::string>("smallCollectiveSize","0"), true );
-    defaultParams.insert( "verboseLevel", m_params.find<std::string>("verboseLevel","0"), true );
+    m_defaultParams.insert( "verboseLevel", m_params.find<std::string>("verboseLevel","0"), true );
     std::ostringstream tmp;
     tmp <<  nodeId;
-    defaultParams.insert( "nodeId", tmp.str(), true );
+    m_defaultParams.insert( "nodeId", tmp.str(), true );
+}
 
-    for ( int i = 0; i < NumFunctions; i++ ) {
-        std::string name = functionName( (FunctionEnum) i );
+FunctionSMInterface* FunctionSM::getFunction( int type )
+{
+    if ( ! m_smV[ type ] ) {
+        std::string name = functionName( (FunctionEnum) type );
         Params tmp = m_params.get_scoped_params( name );
-        defaultParams.insert( "name", name, true );
-        initFunction( info, (FunctionEnum) i,
-                                        name, defaultParams, tmp );
+        m_defaultParams.insert( "name", name, true );
+        initFunction( m_info, (FunctionEnum) type, name, m_defaultParams, tmp );
     }
+    return m_smV[ type ];
 }
 
 void FunctionSM::initFunction( Info* info,
@@ -152,7 +158,7 @@ void FunctionSM::initFunction( Info* info,
 
     m_smV[ num ] = loadModule<FunctionSMInterface>( module + "." + name, params );
 
-    assert( m_smV[ Init ] );
+    assert( m_smV[ num ] );
     m_smV[ num ]->setInfo( info );
 
     if ( ! m_smV[ num ]->protocolName().empty() ) {
@@ -172,7 +178,7 @@ void FunctionSM::start(int type, Callback callback,  SST::Event* e)
     m_retFunc = NULL;
     m_callback = callback;
     assert( ! m_sm );
-    m_sm = m_smV[ type ];
+    m_sm = getFunction( type );
     m_dbg.debug(CALL_INFO,3,0,"%s enter\n",m_sm->name().c_str());
     m_fromDriverLink->send( m_sm->enterLatency(), e );
 }
@@ -182,7 +188,7 @@ void FunctionSM::start( int type, MP::Functor* retFunc, SST::Event* e )
     assert( e );
     m_retFunc = retFunc;
     assert( ! m_sm );
-    m_sm = m_smV[ type ];
+    m_sm = getFunction( type );
     m_dbg.debug(CALL_INFO,3,0,"%s enter\n",m_sm->name().c_str());
     m_fromDriverLink->send( m_sm->enterLatency(), e );
 }
@@ -119,6 +119,7 @@ class FunctionSM : public SubComponent {
 
     void initFunction( Info*, FunctionEnum,
                                     std::string, Params&, Params& );
+    FunctionSMInterface* getFunction( int type );
 
     std::vector<FunctionSMInterface*>  m_smV;
     FunctionSMInterface*    m_sm;
@@ -130,6 +131,8 @@ class FunctionSM : public SubComponent {
     SST::Link*          m_toMeLink;
     Output              m_dbg;
     SST::Params         m_params;
+    SST::Params         m_defaultParams;
+    Info*               m_info;
     ProtocolAPI*	m_proto;
 };
 
@@ -245,6 +245,25 @@ void HadesMP::barrier(Communicator group, Functor* retFunc)
                             new BarrierStartEvent( group) );
 }
 
+void HadesMP::allreduceOffload(const Hermes::MemAddr& mydata,
+		const Hermes::MemAddr& result, uint32_t count,
+        PayloadDataType dtype, ReductionOperation op,
+        Communicator group, Functor* retFunc)
+{
+    dbg().debug(CALL_INFO,1,1,"in=%p out=%p count=%d dtype=%d\n",
+                &mydata,&result,count,dtype);
+    functionSM().start( FunctionSM::Allreduce, retFunc,
+    new CollectiveStartEvent(mydata, result, count, dtype, op, 0, group,
+                            CollectiveStartEvent::Allreduce, true));
+}
+
+void HadesMP::barrierOffload(Communicator group, Functor* retFunc)
+{
+    dbg().debug(CALL_INFO,1,1,"\n");
+    functionSM().start( FunctionSM::Barrier, retFunc,
+                            new BarrierStartEvent( group, true ) );
+}
+
 void HadesMP::probe(RankID source, uint32_t tag,
         Communicator group, MessageResponse* resp, Functor* retFunc )
 {
@@ -144,6 +144,13 @@ class HadesMP : public MP::Interface
 
     virtual void barrier(MP::Communicator group, MP::Functor*);
 
+    virtual void allreduceOffload(const Hermes::MemAddr&,
+		const Hermes::MemAddr& result, uint32_t count,
+        MP::PayloadDataType dtype, MP::ReductionOperation op,
+        MP::Communicator group, MP::Functor*);
+
+    virtual void barrierOffload(MP::Communicator group, MP::Functor*);
+
     virtual void alltoall(
         const Hermes::MemAddr&, uint32_t sendcnt,
                         MP::PayloadDataType sendtype,
@@ -19,6 +19,9 @@
 
 #include <sst/core/interfaces/simpleNetwork.h>
 
+#include <string.h>
+#include <vector>
+
 #define NUM_NODE_BITS     20
 #define NUM_PID_BITS      12
 #define NUM_STREAM_ID_BITS 20 
@@ -30,15 +33,18 @@ class FireflyNetworkEvent : public Event {
 
   public:
 
-    FireflyNetworkEvent( ) : offset(0), bufLen(0), m_isHdr(false), m_isTail(false), m_isCtrl(false), pktOverhead(0) {
-        buf.reserve( 1000 );
-        assert( 0 == buf.size() );
+    // Packet data is kept in a small inline store, which holds the protocol
+    // headers and small payloads, and only moves to the heap if more than
+    // InlineBufSize bytes are appended with data. Bytes appended without
+    // data are counted in the packet size but not stored.
+    static const size_t InlineBufSize = 128;
+
+    FireflyNetworkEvent( ) : m_isHdr(false), m_isTail(false), m_isCtrl(false),
+            pktOverhead(0), offset(0), bufLen(0), bufStored(0) {
     }
 
-    FireflyNetworkEvent( int pktOverhead, size_t reserve = 1000 ) : offset(0), bufLen(0),
-            m_isHdr(false), m_isTail(false), m_isCtrl(false), pktOverhead(pktOverhead) {
-        buf.reserve( reserve );
-        assert( 0 == buf.size() );
+    FireflyNetworkEvent( int pktOverhead ) : m_isHdr(false), m_isTail(false), m_isCtrl(false),
+            pktOverhead(pktOverhead), offset(0), bufLen(0), bufStored(0) {
     }
 
     void setCtrl() { m_isCtrl = true; }
@@ -80,9 +86,15 @@ class FireflyNetworkEvent : public Event {
     bool bufEmpty() {
         return ( bufLen == offset );
     }
+    // bytes from the current position on that are stored, at most bufSize()
+    size_t bufStoredSize() {
+        return bufStored > offset ? bufStored - offset : 0;
+    }
+
+    // NULL if the data at this position was not carried
     void* bufPtr( size_t len = 0 ) {
-        if ( offset + len < buf.size() ) {
-            return &buf[offset + len];
+        if ( offset + len < bufStored ) {
+            return bufData() + offset + len;
         } else {
             return NULL;
         }
@@ -96,8 +108,9 @@ class FireflyNetworkEvent : public Event {
 
     void bufAppend( const void* ptr , size_t len ) {
         if ( ptr ) {
-            buf.resize( bufLen + len);
-            memcpy( &buf[bufLen], (const char*) ptr, len );
+            bufReserve( bufLen + len );
+            memcpy( bufData() + bufLen, (const char*) ptr, len );
+            bufStored = bufLen + len;
         }
         bufLen += len;
     }
@@ -105,23 +118,40 @@ class FireflyNetworkEvent : public Event {
     FireflyNetworkEvent(const FireflyNetworkEvent *me) :
         Event()
     {
-        buf = me->buf;
-        seq = me->seq;
-        srcNode = me->srcNode;
-        srcPid = me->srcPid;
-        srcStream = me->srcStream;
-        destPid = me->destPid;
-        m_isHdr = me->m_isHdr;
-        m_isTail = me->m_isTail;
-        m_isCtrl = me->m_isCtrl;
-        offset = me->offset;
-        pktOverhead = me->pktOverhead;
+        copy( *me );
     }
 
     FireflyNetworkEvent(const FireflyNetworkEvent &me) :
         Event()
     {
-        buf = me.buf;
+        copy( me );
+    }
+
+    virtual Event* clone(void) override
+    {
+        return new FireflyNetworkEvent(*this);
+    }
+
+  private:
+
+    unsigned char* bufData() {
+        return spill.empty() ? inlineBuf : &spill[0];
+    }
+
+    // make room for len stored bytes, bytes skipped by a NULL append
+    // before them read as zero
+    void bufReserve( size_t len ) {
+        if ( ! spill.empty() ) {
+            spill.resize( len );
+        } else if ( len > InlineBufSize ) {
+            spill.resize( len );
+            memcpy( &spill[0], inlineBuf, bufStored );
+        } else if ( bufLen > bufStored ) {
+            memset( inlineBuf + bufStored, 0, bufLen - bufStored );
+        }
+    }
+
+    void copy( const FireflyNetworkEvent& me ) {
         seq = me.seq;
         srcNode = me.srcNode;
         srcPid = me.srcPid;
@@ -131,27 +161,15 @@ class FireflyNetworkEvent : public Event {
         m_isTail = me.m_isTail;
         m_isCtrl = me.m_isCtrl;
         offset = me.offset;
+        bufLen = me.bufLen;
+        bufStored = me.bufStored;
         pktOverhead = me.pktOverhead;
+        spill = me.spill;
+        if ( spill.empty() ) {
+            memcpy( inlineBuf, me.inlineBuf, bufStored );
+        }
     }
 
-    virtual Event* clone(void) override
-    {
-        return new FireflyNetworkEvent(*this);
-    }
-
-    // void setDest( int _dest ) {
-    //     dest = _dest;
-    // }
-
-    // void setSrc( int _src ) {
-    //     src = _src;
-    // }
-    // void setPktSize() {
-    //     size_in_bits = buf.size() * 8;
-    // }
-
-  private:
-
     uint16_t        seq;
     int             srcNode;
     int             srcPid;
@@ -164,7 +182,9 @@ class FireflyNetworkEvent : public Event {
 
     size_t          offset;
     size_t          bufLen;
-    std::vector<unsigned char>     buf;
+    size_t          bufStored;
+    unsigned char   inlineBuf[InlineBufSize];
+    std::vector<unsigned char>     spill;
 
   public:
     void serialize_order(SST::Core::Serialization::serializer &ser)  override {
@@ -172,7 +192,13 @@ class FireflyNetworkEvent : public Event {
         ser & seq;
         ser & offset;
         ser & bufLen;
-        ser & buf;
+        ser & bufStored;
+        ser & spill;
+        if ( spill.empty() ) {
+            for ( size_t i = 0; i < bufStored; i++ ) {
+                ser & inlineBuf[i];
+            }
+        }
         ser & srcNode;
         ser & srcPid;
         ser & srcStream;
@@ -32,6 +32,8 @@ int Nic::MaxPayload = (int)((1L<<32) - 1);
 int Nic::m_packetId = 0;
 int Nic::ShmemSendMove::m_alignment = 64;
 int Nic::EntryBase::m_alignment = 1;
+bool Nic::ShmemSendMove::m_timingOnly = false;
+bool Nic::EntryBase::m_timingOnly = false;
 
 Nic::Nic(ComponentId_t id, Params &params) :
     Component( id ),
@@ -110,6 +112,8 @@ Nic::Nic(ComponentId_t id, Params &params) :
     if ( Nic::EntryBase::m_alignment == 0 ) {
         m_dbg.fatal(CALL_INFO,-1,"Error:  messageSendAlignment must be greater than 0 \n");
     }
+    Nic::EntryBase::m_timingOnly = params.find<bool>("timingOnly",false);
+    Nic::ShmemSendMove::m_timingOnly = Nic::EntryBase::m_timingOnly;
     int numSendMachines = params.find<int>( "numSendMachines",1);
     if ( numSendMachines < 1 ) {
         m_dbg.fatal(CALL_INFO,-1,"Error: numSendMachines must be greater than 1, requested %d\n",numSendMachines);
@@ -179,6 +183,9 @@ Nic::Nic(ComponentId_t id, Params &params) :
 
 	Params shmemParams = params.get_scoped_params( "shmem" );
     m_shmem = new Shmem( *this, shmemParams, m_myNodeId, m_num_vNics, m_dbg, getDelay_ns(), getDelay_ns() );
+
+	Params collectiveParams = params.get_scoped_params( "collective" );
+    m_collective = new Collective( *this, collectiveParams, m_myNodeId, m_dbg, getDelay_ns() );
 	size_t FAM_memSizeBytes = params.find<SST::UnitAlgebra>("FAM_memSize" ).getRoundedValue();
 	if ( FAM_memSizeBytes ) {
 		if ( printConfig ) {
@@ -328,6 +335,7 @@ Nic::Nic(ComponentId_t id, Params &params) :
 Nic::~Nic()
 {
 	delete m_shmem;
+	delete m_collective;
 	delete m_unitPool;
  	delete m_linkSendWidget;
 	delete m_linkRecvWidget;
@@ -392,6 +400,10 @@ void Nic::handleVnicEvent( Event* ev, int id )
 		m_shmem->handleEvent( static_cast<NicShmemCmdEvent*>(event), id );
 		break;
 
+      case NicCmdBaseEvent::Coll:
+		m_collective->handleEvent( static_cast<NicCollCmdEvent*>(event), id );
+		break;
+
 	  default:
 		assert(0);
 	}
@@ -26,6 +26,7 @@
 #include <sst/core/link.h>
 
 #include "sst/elements/hermes/shmemapi.h"
+#include "sst/elements/hermes/msgapi.h"
 #include "sst/elements/thornhill/detailedCompute.h"
 #include "ioVec.h"
 #include "merlinEvent.h"
@@ -52,6 +53,7 @@ namespace Firefly {
 #define NIC_DBG_RECV_STREAM  (1<<8)
 #define NIC_DBG_RECV_MOVE    (1<<9)
 #define NIC_DBG_LINK_CTRL    (1<<10)
+#define NIC_DBG_COLLECTIVE   (1<<11)
 
 class Nic : public SST::Component  {
 
@@ -99,6 +101,7 @@ public:
         { "maxRecvMachineQsize", "Sets the number of pending memory operations", "1"},
         { "shmemSendAlignment", "Sets the send stream transfer alignment", "64"},
         { "messageSendAlignment", "Sets the message alignment","1"},
+        { "timingOnly", "Packets carry the headers and lengths of a message but not its data, except for transfers of 64 bytes or less such as protocol headers and shmem flags", "0"},
         { "numSendMachines", "Sets the number of send machines", "1"},
         { "numRecvNicUnits", "Sets the number of receive units", "1"},
         { "nicAllocationPolicy", "Allocation policy for Nic", "RoundRobin"},
@@ -110,6 +113,11 @@ public:
         { "shmem.nicCmdLatency", "Latency for posting shmem command on NIC", "10"},
         { "shmem.hostCmdLatency", "Host latency for posting shmem command", "10"},
 
+        { "collective.aluBandwidth_GBs", "Sets the bandwidth of the NIC ALU used by offloaded collective reductions", "32"},
+        { "collective.aluLatency_ns", "Sets the startup latency of a reduction on the NIC ALU", "10"},
+        { "collective.nicCmdLatency", "Latency for starting an offloaded collective on the NIC", "10"},
+        { "collective.vn", "VN to send offloaded collective messages on", "0"},
+
         { "FAM_memsize", "", "0"},
         { "FAM_backed", "Controls whether FAM memory is backed in the simlation", "yes"},
 
@@ -127,6 +135,7 @@ public:
 
 	/* PARAMS
 		shmem.*
+		collective.*
 		simpleMemoryModel.*
 		detailedCompute.*
 	*/
@@ -205,7 +214,7 @@ public:
 private:
 
     struct __attribute__ ((packed)) MsgHdr {
-        enum Op : unsigned char { Msg, Rdma, Shmem } op;
+        enum Op : unsigned char { Msg, Rdma, Shmem, Coll } op;
     };
 
     struct __attribute__ ((packed)) MatchMsgHdr {
@@ -247,6 +256,12 @@ private:
         }
     };
 
+    struct __attribute__ ((packed)) CollMsgHdr {
+        uint32_t id;
+        uint32_t step;
+        uint32_t length;
+    };
+
     struct RdmaMsgHdr {
         enum { Put, Get, GetResp } op;
         uint16_t    rgnNum;
@@ -324,6 +339,7 @@ private:
 
     #include "nicVirtNic.h"
     #include "nicShmem.h"
+    #include "nicCollective.h"
     #include "nicShmemMove.h"
     #include "nicEntryBase.h"
     #include "nicSendEntry.h"
@@ -378,6 +394,10 @@ public:
         return m_vNicV[id];
     }
 
+	Collective* getCollective() {
+		return m_collective;
+	}
+
 	void shmemDecPendingPuts( int core ) {
 		m_shmem->decPendingPuts( core );
 	}
@@ -518,6 +538,7 @@ struct X {
 	DetailedInterface* m_detailedInterface;
 	bool m_useDetailedCompute;
     Shmem* m_shmem;
+    Collective* m_collective;
 	SimTime_t m_nic2host_lat_ns;
 	SimTime_t m_shmemRxDelay_ns;
 
@@ -0,0 +1,47 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "nic.h"
+
+using namespace SST;
+using namespace SST::Firefly;
+
+// collective messages are not matched against posted receives, the data
+// is kept in NIC memory and handed to the collective engine when it is all in
+Nic::RecvMachine::CollStream::CollStream( Output& output, Ctx* ctx,
+        int srcNode, int srcPid, int destPid, FireflyNetworkEvent* ev) :
+    StreamBase(output, ctx, srcNode, srcPid, destPid )
+{
+    CollMsgHdr hdr = *(CollMsgHdr*) ev->bufPtr( sizeof(MsgHdr) );
+
+    ev->bufPop(sizeof(MsgHdr) + sizeof(hdr) );
+
+    m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_STREAM,"core=%d srcNode=%d srcCore=%d id=%#x step=%u length=%u\n",
+            m_myPid, srcNode, srcPid, hdr.id, hdr.step, hdr.length );
+
+    m_unit = m_ctx->allocRecvUnit();
+    m_recvEntry = new CollRecvEntry( m_ctx->getCollective(), m_myPid, hdr );
+    m_matched_len = hdr.length;
+
+    if ( 0 == hdr.length ) {
+        m_ctx->deleteStream( this );
+        delete ev;
+    } else {
+        ev->clearHdr();
+        processPktBody( ev );
+    }
+}
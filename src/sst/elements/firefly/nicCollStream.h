@@ -13,25 +13,7 @@
 // information, see the LICENSE file in the top level directory of the
 // distribution.
 
-
-#ifndef _H_SST_ARIEL_FENCE_EVENT
-#define _H_SST_ARIEL_FENCE_EVENT
-
-#include "arielevent.h"
-
-using namespace SST;
-
-namespace SST {
-namespace ArielComponent {
-
-class ArielFenceEvent : public ArielEvent {
-
-    public:
-        ArielEventType getEventType() const { return FENCE; }
-
+class CollStream : public StreamBase {
+  public:
+    CollStream( Output&, Ctx*, int srcNode, int srcPid, int destPid, FireflyNetworkEvent* );
 };
-
-}
-}
-
-#endif
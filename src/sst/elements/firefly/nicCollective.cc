@@ -0,0 +1,285 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "nic.h"
+
+using namespace SST;
+using namespace SST::Firefly;
+using namespace SST::Hermes;
+
+#include "funcSM/collectiveOps.h"
+
+Nic::Collective::~Collective()
+{
+    std::unordered_map< OpKey, Op* >::iterator iter = m_ops.begin();
+    for ( ; iter != m_ops.end(); ++iter ) {
+        Op* op = iter->second;
+        while ( ! op->arrived.empty() ) {
+            delete op->arrived.front();
+            op->arrived.pop_front();
+        }
+        delete op->cmd;
+        delete op;
+    }
+}
+
+void Nic::Collective::handleEvent( NicCollCmdEvent* event, int id )
+{
+    m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_COLLECTIVE,"core=%d `%s` id=%#x count=%u\n",
+            id, event->getTypeStr().c_str(), event->id, event->count );
+
+    SimTime_t start = m_nic.getCurrentSimTimeNano();
+    std::vector<MemOp>* vec = new std::vector<MemOp>;
+    vec->push_back( MemOp( -1, 16, MemOp::Op::HostBusWrite,
+         [=]() {
+            m_dbg.verbosePrefix( prefix(),CALL_INFO_LAMBDA,"handleEvent",1,NIC_DBG_COLLECTIVE,"latency=%" PRIu64 "\n",
+                            m_nic.getCurrentSimTimeNano() - start);
+            m_nic.schedCallback( std::bind( &Nic::Collective::start, this, event, id ), m_nicCmdLatency );
+        }
+     ) );
+
+    m_nic.calcHostMemDelay(id, vec, [=]() { });
+}
+
+void Nic::Collective::start( NicCollCmdEvent* event, int id )
+{
+    OpKey key = getOpKey( id, event->id );
+    Op* op = findOp( key );
+    assert( NULL == op->cmd );
+
+    op->cmd = event;
+    op->pid = id;
+    op->unit = m_nic.allocNicSendUnit();
+    op->pending = event->children.size();
+
+    size_t length = event->length();
+
+    m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_COLLECTIVE,"core=%d id=%#x %s length=%zu arrived=%zu\n",
+            id, event->id, event->algorithm == NicCollCmdEvent::Tree ? "tree" : "ring", length, op->arrived.size() );
+
+    if ( 0 == length ) {
+        op->started = true;
+        progress( key );
+        return;
+    }
+
+    if ( event->input.getBacking() && event->output.getBacking() ) {
+        op->buf.resize( length );
+        memcpy( op->buf.data(), event->input.getBacking(), length );
+    }
+
+    std::vector<MemOp>* vec = new std::vector<MemOp>;
+    vec->push_back( MemOp( event->input.getSimVAddr(), length, MemOp::Op::BusDmaFromHost ) );
+
+    m_nic.dmaRead( op->unit, id, vec,
+        [=]() {
+            m_dbg.verbosePrefix( prefix(),CALL_INFO_LAMBDA,"start",1,NIC_DBG_COLLECTIVE,"input read core=%d\n", id );
+            op->started = true;
+            progress( key );
+        }
+    );
+}
+
+void Nic::Collective::recv( int pid, int srcNode, int srcPid, CollMsgHdr& hdr, std::vector<unsigned char>& data )
+{
+    m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_COLLECTIVE,"core=%d srcNode=%d srcCore=%d id=%#x step=%u length=%u\n",
+            pid, srcNode, srcPid, hdr.id, hdr.step, hdr.length );
+
+    OpKey key = getOpKey( pid, hdr.id );
+    Op* op = findOp( key );
+    op->arrived.push_back( new Msg( hdr.step, data ) );
+    progress( key );
+}
+
+void Nic::Collective::progress( OpKey key )
+{
+    Op* op = m_ops[key];
+
+    if ( ! op->started || op->busy ) {
+        return;
+    }
+
+    bool done;
+    if ( op->cmd->algorithm == NicCollCmdEvent::Tree ) {
+        done = treeProgress( key, op );
+    } else {
+        done = ringProgress( key, op );
+    }
+
+    if ( done ) {
+        finish( key, op );
+    }
+}
+
+bool Nic::Collective::treeProgress( OpKey key, Op* op )
+{
+    NicCollCmdEvent* cmd = op->cmd;
+    size_t length = cmd->length();
+
+    if ( TreeUp == op->step ) {
+        if ( op->pending ) {
+            Msg* msg = takeMsg( op, TreeUp );
+            if ( msg ) {
+                --op->pending;
+                reduce( key, op, msg, 0, length );
+            }
+            return false;
+        }
+
+        if ( -1 == cmd->parent.node ) {
+            m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_COLLECTIVE,"root core=%d id=%#x\n", op->pid, cmd->id );
+            for ( unsigned i = 0; i < cmd->children.size(); i++ ) {
+                send( op, cmd->children[i], TreeDown, 0, length );
+            }
+            return true;
+        }
+
+        send( op, cmd->parent, TreeUp, 0, length );
+        op->step = TreeDown;
+    }
+
+    Msg* msg = takeMsg( op, TreeDown );
+    if ( NULL == msg ) {
+        return false;
+    }
+
+    copy( op, msg, 0, length );
+    for ( unsigned i = 0; i < cmd->children.size(); i++ ) {
+        send( op, cmd->children[i], TreeDown, 0, length );
+    }
+    return true;
+}
+
+// reduce-scatter then allgather around the ring, at step s this rank sends
+// chunk pos - s to its right and gets chunk pos - s - 1 from its left
+bool Nic::Collective::ringProgress( OpKey key, Op* op )
+{
+    NicCollCmdEvent* cmd = op->cmd;
+    uint32_t numSteps = 2 * ( cmd->ringSize - 1 );
+
+    while ( op->step < numSteps ) {
+        bool scatter = op->step < (uint32_t) cmd->ringSize - 1;
+        int sendChunk = scatter ? cmd->ringPos - op->step : cmd->ringPos + 1 - ( op->step - ( cmd->ringSize - 1 ) );
+        size_t offset, length;
+
+        if ( ! op->sent ) {
+            ringChunk( op, sendChunk, offset, length );
+            send( op, cmd->right, op->step, offset, length );
+            op->sent = true;
+        }
+
+        Msg* msg = takeMsg( op, op->step );
+        if ( NULL == msg ) {
+            return false;
+        }
+
+        ringChunk( op, sendChunk - 1, offset, length );
+        ++op->step;
+        op->sent = false;
+
+        if ( scatter ) {
+            reduce( key, op, msg, offset, length );
+            return false;
+        }
+        copy( op, msg, offset, length );
+    }
+    return true;
+}
+
+void Nic::Collective::reduce( OpKey key, Op* op, Msg* msg, size_t offset, size_t length )
+{
+    NicCollCmdEvent* cmd = op->cmd;
+
+    if ( length && ! op->buf.empty() && msg->data.size() == length ) {
+        void* input[2] = { op->buf.data() + offset, msg->data.data() };
+        collectiveOp( input, 2, op->buf.data() + offset, length / cmd->dtypeSize, cmd->dtype, cmd->op );
+    }
+    delete msg;
+
+    // the ALU does one reduction at a time
+    SimTime_t now = m_nic.getCurrentSimTimeNano();
+    SimTime_t start = m_aluAvail > now ? m_aluAvail : now;
+    SimTime_t delay = start - now;
+    if ( length ) {
+        delay += m_aluLatency_ns + (SimTime_t) ceil( length / m_aluBandwidth_GBs );
+    }
+    m_aluAvail = now + delay;
+
+    m_dbg.verbosePrefix( prefix(),CALL_INFO,2,NIC_DBG_COLLECTIVE,"core=%d id=%#x offset=%zu length=%zu delay=%" PRIu64 "\n",
+            op->pid, cmd->id, offset, length, delay );
+
+    op->busy = true;
+    m_nic.schedCallback(
+        [=]() {
+            op->busy = false;
+            progress( key );
+        },
+        delay
+    );
+}
+
+void Nic::Collective::copy( Op* op, Msg* msg, size_t offset, size_t length )
+{
+    if ( length && ! op->buf.empty() && msg->data.size() == length ) {
+        memcpy( op->buf.data() + offset, msg->data.data(), length );
+    }
+    delete msg;
+}
+
+void Nic::Collective::send( Op* op, const Peer& peer, uint32_t step, size_t offset, size_t length )
+{
+    m_dbg.verbosePrefix( prefix(),CALL_INFO,2,NIC_DBG_COLLECTIVE,"core=%d id=%#x step=%u to node=%d core=%d length=%zu\n",
+            op->pid, op->cmd->id, step, peer.node, peer.vNic, length );
+
+    const unsigned char* data = op->buf.empty() ? NULL : op->buf.data() + offset;
+    m_nic.qSendEntry( new CollSendEntry( op->pid, m_nic.getSendStreamNum( op->pid ), peer.node, peer.vNic,
+                        op->cmd->id, step, data, length, m_vn ) );
+}
+
+void Nic::Collective::finish( OpKey key, Op* op )
+{
+    NicCollCmdEvent* cmd = op->cmd;
+    int pid = op->pid;
+    size_t length = cmd->length();
+
+    m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_COLLECTIVE,"core=%d id=%#x done\n", pid, cmd->id );
+    assert( op->arrived.empty() );
+
+    m_ops.erase( key );
+
+    NicCollCmdEvent::Callback callback = cmd->callback;
+    if ( 0 == length ) {
+        m_nic.getVirtNic(pid)->notifyShmem( getNic2HostDelay_ns(), callback );
+    } else {
+        if ( ! op->buf.empty() ) {
+            memcpy( cmd->output.getBacking(), op->buf.data(), length );
+        }
+
+        std::vector<MemOp>* vec = new std::vector<MemOp>;
+        vec->push_back( MemOp( cmd->output.getSimVAddr(), length, MemOp::Op::BusDmaToHost ) );
+
+        m_nic.dmaWrite( op->unit, pid, vec,
+            [=]() {
+                m_dbg.verbosePrefix( prefix(),CALL_INFO_LAMBDA,"finish",1,NIC_DBG_COLLECTIVE,"result written core=%d\n", pid );
+                m_nic.getVirtNic(pid)->notifyShmem( getNic2HostDelay_ns(), callback );
+            }
+        );
+    }
+
+    delete cmd;
+    delete op;
+}
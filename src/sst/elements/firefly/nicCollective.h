@@ -0,0 +1,136 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Runs allreduce and barrier on the NIC. The host posts one command per
+// collective that already names this rank's peers, the NIC reads the input
+// from host memory, exchanges and reduces the data with the peer NICs using
+// its own ALU and writes the result back to the host before notifying it.
+// Barrier is an allreduce of zero bytes.
+class Collective {
+
+    typedef std::function<void()> Callback;
+    typedef NicCollCmdEvent::Peer Peer;
+
+    struct Msg {
+        Msg( uint32_t step, std::vector<unsigned char>& data ) : step(step) {
+            this->data.swap( data );
+        }
+        uint32_t step;
+        std::vector<unsigned char> data;
+    };
+
+    struct Op {
+        Op() : cmd(NULL), pid(-1), unit(-1), started(false), busy(false), sent(false), step(0), pending(0) {}
+        NicCollCmdEvent*    cmd;
+        int                 pid;
+        int                 unit;
+        bool                started;
+        bool                busy;
+        bool                sent;
+        uint32_t            step;
+        size_t              pending;
+
+        // the partial result, empty if the host buffers have no backing
+        std::vector<unsigned char>  buf;
+
+        // messages from peers that have not been used yet, they can arrive
+        // before the host posts the command
+        std::list<Msg*>     arrived;
+    };
+
+    typedef uint64_t OpKey;
+    static OpKey getOpKey( int pid, uint32_t id ) { return (OpKey) pid << 32 | id; }
+
+    // tree messages go up to the parent then down to the children
+    enum { TreeUp, TreeDown };
+
+	std::string m_prefix;
+	const char* prefix() { return m_prefix.c_str(); }
+
+  public:
+    Collective( Nic& nic, Params& params, int id, Output& output, SimTime_t nic2HostDelay_ns ) :
+        m_nic( nic ), m_dbg( output ), m_nic2HostDelay_ns( nic2HostDelay_ns ), m_aluAvail( 0 )
+    {
+        m_prefix = "@t:" + std::to_string(id) + ":Nic::Collective::@p():@l ";
+        m_dbg.verbosePrefix( prefix(), CALL_INFO,1,NIC_DBG_COLLECTIVE,"this=%p\n",this );
+
+        m_aluBandwidth_GBs = params.find<double>( "aluBandwidth_GBs", 32 );
+        m_aluLatency_ns = params.find<SimTime_t>( "aluLatency_ns", 10 );
+        m_nicCmdLatency = params.find<SimTime_t>( "nicCmdLatency", 10 );
+        m_vn = params.find<int>( "vn", 0 );
+
+        if ( m_aluBandwidth_GBs <= 0 ) {
+            m_dbg.fatal(CALL_INFO,-1,"Error: collective.aluBandwidth_GBs must be greater than 0\n");
+        }
+    }
+    ~Collective();
+
+    void handleEvent( NicCollCmdEvent* event, int id );
+    void recv( int pid, int srcNode, int srcPid, CollMsgHdr& hdr, std::vector<unsigned char>& data );
+
+  private:
+    SimTime_t getNic2HostDelay_ns() { return m_nic2HostDelay_ns; }
+
+    Op* findOp( OpKey key ) {
+        std::unordered_map< OpKey, Op* >::iterator iter = m_ops.find( key );
+        if ( iter == m_ops.end() ) {
+            iter = m_ops.insert( std::make_pair( key, new Op ) ).first;
+        }
+        return iter->second;
+    }
+
+    Msg* takeMsg( Op* op, uint32_t step ) {
+        for ( std::list<Msg*>::iterator iter = op->arrived.begin(); iter != op->arrived.end(); ++iter ) {
+            if ( (*iter)->step == step ) {
+                Msg* msg = *iter;
+                op->arrived.erase( iter );
+                return msg;
+            }
+        }
+        return NULL;
+    }
+
+    void start( NicCollCmdEvent* event, int id );
+    void progress( OpKey key );
+    bool treeProgress( OpKey key, Op* op );
+    bool ringProgress( OpKey key, Op* op );
+    void reduce( OpKey key, Op* op, Msg* msg, size_t offset, size_t length );
+    void copy( Op* op, Msg* msg, size_t offset, size_t length );
+    void send( Op* op, const Peer& peer, uint32_t step, size_t offset, size_t length );
+    void finish( OpKey key, Op* op );
+
+    // elements are split as evenly as possible, the first count % size
+    // chunks get one more element
+    void ringChunk( Op* op, int chunk, size_t& offset, size_t& length ) {
+        NicCollCmdEvent* cmd = op->cmd;
+        chunk = ( ( chunk % cmd->ringSize ) + cmd->ringSize ) % cmd->ringSize;
+        size_t base = cmd->count / cmd->ringSize;
+        size_t rem = cmd->count % cmd->ringSize;
+        size_t first = chunk * base + ( (size_t) chunk < rem ? chunk : rem );
+        offset = first * cmd->dtypeSize;
+        length = ( base + ( (size_t) chunk < rem ? 1 : 0 ) ) * cmd->dtypeSize;
+    }
+
+    Nic&        m_nic;
+    Output&     m_dbg;
+    SimTime_t   m_nic2HostDelay_ns;
+    SimTime_t   m_nicCmdLatency;
+    SimTime_t   m_aluLatency_ns;
+    double      m_aluBandwidth_GBs;
+    SimTime_t   m_aluAvail;
+    int         m_vn;
+
+    std::unordered_map< OpKey, Op* > m_ops;
+};
@@ -56,7 +56,8 @@ bool Nic::EntryBase::copyIn( Output& dbg,
             if ( ioVec()[currentVec()].addr.getBacking() ) {
                 void *buf = event.bufPtr();
                 if ( buf ) {
-                    memcpy( toPtr, buf, len );
+                    size_t stored = event.bufStoredSize();
+                    memcpy( toPtr, buf, len < stored ? len : stored );
                 }
                 print( dbg, toPtr, len );
             }
@@ -115,7 +116,8 @@ void Nic::EntryBase::copyOut( Output& dbg, int numBytes,
 
             vec.push_back( MemOp( ioVec()[currentVec()].addr.getSimVAddr() + currentPos(), len, MemOp::Op::BusDmaFromHost ) );
 
-            if ( ioVec()[currentVec()].addr.getBacking()) {
+            if ( ioVec()[currentVec()].addr.getBacking() &&
+                        carryData( ioVec()[currentVec()].len ) ) {
                 print( dbg, from, len );
                 event.bufAppend( from, len );
             } else {
@@ -37,6 +37,13 @@ class EntryBase {
 
     virtual size_t& currentLen() { return m_currentLen; }
     static  int m_alignment;
+
+    // in timing only mode the data of an IoVec is not put in the packets
+    // unless it is small enough to be a protocol header
+    static  bool m_timingOnly;
+    static  bool carryData( size_t len ) {
+        return ! m_timingOnly || len <= FireflyNetworkEvent::InlineBufSize / 2;
+    }
   private:
     virtual std::vector<IoVec>& ioVec() = 0;
     virtual size_t& currentVec() { return m_currentVec; }
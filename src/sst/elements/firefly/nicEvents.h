@@ -50,7 +50,7 @@ public:
 class NicCmdBaseEvent : public Event {
 
   public:
-    enum Type { Shmem, Msg } base_type;
+    enum Type { Shmem, Msg, Coll } base_type;
 
     NicCmdBaseEvent( Type type ) : Event(), base_type(type) {}
 
@@ -373,6 +373,62 @@ class NicShmemOpCmdEvent : public NicShmemCmdEvent {
 };
 
 
+class NicCollCmdEvent : public NicCmdBaseEvent {
+  public:
+    typedef std::function<void()> Callback;
+    enum Type { Allreduce, Barrier } type;
+    enum Algorithm { Tree, Ring } algorithm;
+
+    struct Peer {
+        Peer( int node = -1, int vNic = -1 ) : node(node), vNic(vNic) {}
+        int node;
+        int vNic;
+    };
+
+    NicCollCmdEvent( Type type, Algorithm algorithm, uint32_t id,
+            const Hermes::MemAddr& input, const Hermes::MemAddr& output, uint32_t count,
+            Hermes::MP::PayloadDataType dtype, size_t dtypeSize, Hermes::MP::ReductionOperation op,
+            Callback callback ) :
+        NicCmdBaseEvent( Coll ), type(type), algorithm(algorithm), id(id),
+        input(input), output(output), count(count), dtype(dtype), dtypeSize(dtypeSize),
+        op(op), ringPos(0), ringSize(1), callback(callback)
+    { }
+
+    std::string getTypeStr( ) {
+        switch( type ) {
+            case Allreduce:
+            return "Allreduce";
+            case Barrier:
+            return "Barrier";
+        }
+        return "";
+    }
+
+    size_t length() { return count * dtypeSize; }
+
+    uint32_t            id;
+    Hermes::MemAddr     input;
+    Hermes::MemAddr     output;
+    uint32_t            count;
+    Hermes::MP::PayloadDataType     dtype;
+    size_t              dtypeSize;
+    Hermes::MP::ReductionOperation  op;
+
+    // tree
+    Peer                parent;
+    std::vector<Peer>   children;
+
+    // ring
+    Peer                left;
+    Peer                right;
+    int                 ringPos;
+    int                 ringSize;
+
+    Callback            callback;
+
+    NotSerializable(NicCollCmdEvent)
+};
+
 class NicCmdEvent : public NicCmdBaseEvent {
   public:
     enum Type { PioSend, DmaSend, DmaRecv, Put, Get, RegMemRgn } type;
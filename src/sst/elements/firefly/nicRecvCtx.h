@@ -55,6 +55,10 @@
                 return  m_rm.m_nic.m_shmem;
             }
 
+            Nic::Collective* getCollective() {
+                return  m_rm.m_nic.m_collective;
+            }
+
             std::queue<StreamBase*> m_blockedStreamQ;
             void needRecv( StreamBase* stream ) {
 
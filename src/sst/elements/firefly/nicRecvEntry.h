@@ -155,3 +155,45 @@ class ShmemGetbRespRecvEntry : public ShmemGetRespRecvEntry {
         static_cast<ShmemGetbSendEntry*>(m_entry)->callback( );
     }
 };
+
+class CollRecvEntry : public RecvEntryBase {
+  public:
+    CollRecvEntry( Collective* collective, int pid, CollMsgHdr& hdr ) :
+        RecvEntryBase(), m_collective( collective ), m_pid( pid ), m_hdr( hdr )
+    { }
+
+    // called when the stream is done
+    void notify( int src_vNic, int src_node, int tag, size_t length ) {
+        m_collective->recv( m_pid, src_node, src_vNic, m_hdr, m_data );
+    }
+
+    size_t totalBytes( ) { return m_hdr.length; }
+    std::vector<IoVec>& ioVec() { assert(0); }
+
+    bool copyIn( Output& dbg, FireflyNetworkEvent& ev, std::vector<MemOp>& vec ) {
+        size_t len = ev.bufSize();
+        if ( len > m_hdr.length - currentLen() ) {
+            len = m_hdr.length - currentLen();
+        }
+
+        if ( len ) {
+            vec.push_back( MemOp( 0, len, MemOp::Op::LocalStore ) );
+        }
+
+        // a timing only packet has no data, the engine then skips the arithmetic
+        void* buf = ev.bufPtr();
+        if ( buf && ev.bufStoredSize() >= len && m_data.size() == currentLen() ) {
+            m_data.insert( m_data.end(), (unsigned char*) buf, (unsigned char*) buf + len );
+        }
+
+        ev.bufPop( len );
+        currentLen() += len;
+        return currentLen() == m_hdr.length;
+    }
+
+  private:
+    Collective*                 m_collective;
+    int                         m_pid;
+    CollMsgHdr                  m_hdr;
+    std::vector<unsigned char>  m_data;
+};
@@ -175,3 +175,52 @@ class PutOrgnEntry : public MsgSendEntry, public EntryBase {
     RdmaMsgHdr          m_hdr;
     int                 m_vn;
 };
+
+class CollSendEntry : public MsgSendEntry {
+  public:
+    CollSendEntry( int local_vNic, int streamNum, int dst_node, int dst_vNic,
+            uint32_t id, uint32_t step, const unsigned char* data, size_t length, int vn ) :
+        MsgSendEntry( local_vNic, streamNum, dst_node, dst_vNic ),
+        m_length( length ), m_offset( 0 ), m_vn( vn )
+    {
+        m_hdr.id = id;
+        m_hdr.step = step;
+        m_hdr.length = length;
+
+        // the engine keeps working on its buffer while this is sent
+        if ( data ) {
+            m_data.assign( data, data + length );
+        }
+    }
+
+    void copyOut( Output& dbg, int numBytes,
+                FireflyNetworkEvent& event, std::vector<MemOp>& vec )
+    {
+        size_t space = numBytes - event.bufSize();
+        size_t len = m_length - m_offset < space ? m_length - m_offset : space;
+
+        if ( len ) {
+            vec.push_back( MemOp( 0, len, MemOp::Op::LocalLoad ) );
+        }
+        if ( ! m_data.empty() && EntryBase::carryData( m_length ) ) {
+            event.bufAppend( &m_data[m_offset], len );
+        } else {
+            event.bufAppend( NULL, len );
+        }
+        m_offset += len;
+    }
+
+    size_t totalBytes() { return m_length; }
+    bool isDone()       { return m_offset == m_length; }
+    MsgHdr::Op getOp()  { return MsgHdr::Coll; }
+    int vn()            { return m_vn; }
+    void* hdr()         { return &m_hdr; }
+    size_t hdrSize()    { return sizeof(m_hdr); }
+
+  private:
+    CollMsgHdr                  m_hdr;
+    std::vector<unsigned char>  m_data;
+    size_t                      m_length;
+    size_t                      m_offset;
+    int                         m_vn;
+};
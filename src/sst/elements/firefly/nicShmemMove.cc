@@ -39,7 +39,7 @@ void Nic::ShmemSendMoveMem::copyOut( Output& dbg, int numBytes, FireflyNetworkEv
 
 	vec.push_back( MemOp( m_addr + m_offset, len, MemOp::Op::BusDmaFromHost ));
 
-	if ( m_ptr ) {
+	if ( m_ptr && carryData( m_length ) ) {
     	event.bufAppend( m_ptr + m_offset ,len );
 	} else {
     	event.bufAppend( NULL, len );
@@ -101,8 +101,8 @@ bool Nic::ShmemRecvMoveMem::copyIn( Output& dbg, FireflyNetworkEvent& event, std
 
     assert( length <= m_length - m_offset );
 
-    if ( m_ptr ) {
-        memcpy(  m_ptr + m_offset, event.bufPtr(), length);
+    if ( m_ptr && event.bufPtr() ) {
+        memcpy(  m_ptr + m_offset, event.bufPtr(), event.bufStoredSize() );
     }
 
 	size_t tmpOffset = m_addr + m_offset;
@@ -130,48 +130,51 @@ bool Nic::ShmemRecvMoveMemOp::copyIn( Output& dbg, FireflyNetworkEvent& event, s
     size_t dataLength = Hermes::Value::getLength(m_dataType);
 
     while ( event.bufSize() >= dataLength ) {
-        Hermes::Value src( m_dataType, event.bufPtr() );
-        Hermes::Value dest( m_dataType, m_ptr + m_offset );
+        // the operands were not carried in timing only mode
+        if ( event.bufPtr() ) {
+            Hermes::Value src( m_dataType, event.bufPtr() );
+            Hermes::Value dest( m_dataType, m_ptr + m_offset );
 
 #if 0
-        std::stringstream tmp1;
-        tmp1 << src;
-        std::stringstream tmp2;
-        tmp2 << dest;
+            std::stringstream tmp1;
+            tmp1 << src;
+            std::stringstream tmp2;
+            tmp2 << dest;
 #endif
 
-        switch ( m_op ) {
-          case Hermes::Shmem::AND:
-            dest &= src;
-            break;
-          case Hermes::Shmem::OR:
-            dest |= src;
-            break;
-          case Hermes::Shmem::XOR:
-            dest ^= src;
-            break;
-          case Hermes::Shmem::SUM:
-            dest += src;
-            break;
-          case Hermes::Shmem::PROD:
-            dest *= src;
-            break;
-          case Hermes::Shmem::MIN:
-            if ( src < dest ) dest = src;
-            break;
-          case Hermes::Shmem::MAX:
-            if ( src > dest ) dest = src;
-            break;
-          default:
-            assert(0);
-        }
+            switch ( m_op ) {
+              case Hermes::Shmem::AND:
+                dest &= src;
+                break;
+              case Hermes::Shmem::OR:
+                dest |= src;
+                break;
+              case Hermes::Shmem::XOR:
+                dest ^= src;
+                break;
+              case Hermes::Shmem::SUM:
+                dest += src;
+                break;
+              case Hermes::Shmem::PROD:
+                dest *= src;
+                break;
+              case Hermes::Shmem::MIN:
+                if ( src < dest ) dest = src;
+                break;
+              case Hermes::Shmem::MAX:
+                if ( src > dest ) dest = src;
+                break;
+              default:
+                assert(0);
+            }
 
 #if 0
-        std::stringstream tmp3;
-        tmp3 << dest;
-        dbg.debug(CALL_INFO,3,NIC_DBG_SEND_MACHINE,"Shmem: op=%d src=%s dest=%s result=%s\n",
-                m_op,tmp1.str().c_str(), tmp2.str().c_str(), tmp3.str().c_str());
+            std::stringstream tmp3;
+            tmp3 << dest;
+            dbg.debug(CALL_INFO,3,NIC_DBG_SEND_MACHINE,"Shmem: op=%d src=%s dest=%s result=%s\n",
+                    m_op,tmp1.str().c_str(), tmp2.str().c_str(), tmp3.str().c_str());
 #endif
+        }
 
 		size_t tmpOffset = m_addr + m_offset;
 		int tmpCore = m_core;
@@ -78,6 +78,10 @@ class ShmemSendMove {
 
     virtual bool isDone() = 0;
     static  int m_alignment;
+    static  bool m_timingOnly;
+    static  bool carryData( size_t len ) {
+        return ! m_timingOnly || len <= FireflyNetworkEvent::InlineBufSize / 2;
+    }
 };
 
 class ShmemSendMoveMem : public ShmemSendMove {
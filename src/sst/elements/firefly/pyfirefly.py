@@ -114,8 +114,13 @@ class BasicNicConfiguration(TemplateBase):
             "packetOverhead", "packetSize",
             "maxActiveRecvStreams", "maxPendingRecvPkts",
             "dmaBW_GBs", "dmaContentionMult",
+            "timingOnly",
             ])
 
+        self._declareParamsWithUserPrefix("main", "collective",
+            [ "aluBandwidth_GBs", "aluLatency_ns", "nicCmdLatency", "vn" ],
+            "collective.")
+
         self._declareParams("main",["useSimpleMemoryModel"])
         self.useSimpleMemoryModel = 0
         self._lockVariable("useSimpleMemoryModel")
@@ -208,6 +213,21 @@ class FireflyHades(FireflyOS):
             "functionSM." # prefix needed in the dictionary so things get passed correctly to elements
         )
 
+        # per function params, e.g. functionsm.Allreduce.algorithms
+        funcParams = {
+            "Barrier" : [ 'algorithms', 'offloadAlgorithm', 'offloadTreeDegree' ],
+            "Allreduce" : [ 'algorithms', 'offloadAlgorithm', 'offloadTreeDegree' ],
+            "Allgather" : [ 'algorithms' ],
+            "Alltoallv" : [ 'algorithms' ],
+        }
+        for func, plist in funcParams.items():
+            self._declareParamsWithUserPrefix(
+                "main",
+                "functionsm." + func,
+                plist,
+                "functionSM." + func + "."
+            )
+
         # Subscribe to firefly.functionsm platform param set.  Need to
         # prefix the keys with functionsm so that the end use doesn't
         # have to put it on each key entry
@@ -227,7 +247,7 @@ class FireflyHades(FireflyOS):
         self._declareParamsWithUserPrefix(
             "ctrl", # dictionary params will end up in
             "ctrl", # user visible prefix
-            [ 'pqs.verboseMask', 'pqs.verboseLevel' ],
+            [ 'pqs.verboseMask', 'pqs.verboseLevel', 'pqs.matchCostModel', 'pqs.matchCostConstant' ],
             "pqs." # prefix needed in the dictionary so things get passed correctly to elements
         )
 
@@ -254,6 +254,33 @@ void VirtNic::shmemFadd( int node, Hermes::Vaddr dest, Hermes::Value& value, Cal
     sendCmd(0, new NicShmemFaddCmdEvent( calcCoreId(node), calcRealNicId(node), dest, value, callback ) );
 }
 
+void VirtNic::collective( uint32_t id, const Hermes::MemAddr& input, const Hermes::MemAddr& output,
+        uint32_t count, Hermes::MP::PayloadDataType dtype, size_t dtypeSize,
+        Hermes::MP::ReductionOperation op, const CollTopo& topo, Callback callback )
+{
+    m_dbg.debug(CALL_INFO,2,0,"id=%#x count=%u %s\n", id, count, topo.ring ? "ring" : "tree" );
+
+    NicCollCmdEvent* ev = new NicCollCmdEvent(
+            count ? NicCollCmdEvent::Allreduce : NicCollCmdEvent::Barrier,
+            topo.ring ? NicCollCmdEvent::Ring : NicCollCmdEvent::Tree,
+            id, input, output, count, dtype, dtypeSize, op, callback );
+
+    if ( topo.ring ) {
+        ev->left = NicCollCmdEvent::Peer( calcRealNicId( topo.left ), calcCoreId( topo.left ) );
+        ev->right = NicCollCmdEvent::Peer( calcRealNicId( topo.right ), calcCoreId( topo.right ) );
+        ev->ringPos = topo.ringPos;
+        ev->ringSize = topo.ringSize;
+    } else {
+        ev->parent = NicCollCmdEvent::Peer( calcRealNicId( topo.parent ), calcCoreId( topo.parent ) );
+        for ( unsigned i = 0; i < topo.children.size(); i++ ) {
+            ev->children.push_back(
+                NicCollCmdEvent::Peer( calcRealNicId( topo.children[i] ), calcCoreId( topo.children[i] ) ) );
+        }
+    }
+
+    sendCmd(0, ev );
+}
+
 void VirtNic::setNotifyOnRecvDmaDone(
                 VirtNic::HandlerBase4Args<int,int,size_t,void*>* functor)
 {
@@ -20,6 +20,7 @@
 #include <sst/core/output.h>
 #include <sst/core/subcomponent.h>
 #include "sst/elements/hermes/shmemapi.h"
+#include "sst/elements/hermes/msgapi.h"
 
 #include "ioVec.h"
 
@@ -196,6 +197,24 @@ class VirtNic : public SST::SubComponent {
     void shmemAdd( int node, Hermes::Vaddr dest, Hermes::Value& );
     void shmemFadd( int node, Hermes::Vaddr dest, Hermes::Value&, CallbackV );
 
+    // where this rank sits in an offloaded collective, peers are node ids
+    // and -1 if there is none
+    struct CollTopo {
+        CollTopo() : ring(false), parent(-1), left(-1), right(-1), ringPos(0), ringSize(1) {}
+        bool                ring;
+        int                 parent;
+        std::vector<int>    children;
+        int                 left;
+        int                 right;
+        int                 ringPos;
+        int                 ringSize;
+    };
+
+    // a count of 0 is a barrier
+    void collective( uint32_t id, const Hermes::MemAddr& input, const Hermes::MemAddr& output,
+            uint32_t count, Hermes::MP::PayloadDataType, size_t dtypeSize,
+            Hermes::MP::ReductionOperation, const CollTopo&, Callback );
+
     void setNotifyOnRecvDmaDone(
         VirtNic::HandlerBase4Args<int,int,size_t,void*>* functor);
     void setNotifyOnSendPioDone(VirtNic::HandlerBase<void*>* functor);
@@ -195,6 +195,13 @@ class Interface : public Hermes::Interface {
 
     virtual void barrier(Communicator group, Functor*) { assert(0); }
 
+    // same as allreduce and barrier but run by the NIC
+    virtual void allreduceOffload(const Hermes::MemAddr&, const Hermes::MemAddr&, uint32_t count,
+        PayloadDataType dtype, ReductionOperation op,
+        Communicator group, Functor*) { assert(0); }
+
+    virtual void barrierOffload(Communicator group, Functor*) { assert(0); }
+
     virtual void probe( int source, uint32_t tag,
         Communicator group, MessageResponse* resp, Functor* ) { assert(0); }
 
@@ -0,0 +1,137 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/elements/miranda/generators/bfsgen.h>
+
+#include <algorithm>
+
+using namespace SST::Miranda;
+
+BFSGenerator::BFSGenerator( ComponentId_t id, Params& params ) :
+	SparseInputGenerator(id, params, "BFSGenerator"), phase(CLEAR_PARENTS),
+	clearNext(0), queueHead(0), queueTail(0), vertex(0), entry(0) {
+
+	loadInput(params, "input", graph);
+
+	if(graph.rows() != graph.cols()) {
+		out->fatal(CALL_INFO, -1, "Error: the input has %" PRIu64 " rows and %" PRIu64 " columns, a graph must be square.\n",
+			graph.rows(), graph.cols());
+	}
+
+	const uint64_t sourceVertex = params.find<uint64_t>("source", 0);
+	iterations = params.find<uint64_t>("iterations", 1);
+
+	if(0 == graph.rows()) {
+		iterations = 0;
+	} else if(sourceVertex >= graph.rows()) {
+		out->fatal(CALL_INFO, -1, "Error: source vertex %" PRIu64 " is not in the graph (%" PRIu64 " vertices).\n",
+			sourceVertex, graph.rows());
+	}
+
+	source = (uint32_t) sourceVertex;
+
+	rowOffsetsAddr = placeArray(params, "row_offsets", (graph.rows() + 1) * offsetWidth);
+	colIndicesAddr = placeArray(params, "col_indices", graph.nnz() * indexWidth);
+	parentAddr     = placeArray(params, "parent", graph.rows() * indexWidth);
+	queueAddr      = placeArray(params, "queue", graph.rows() * indexWidth);
+
+	parent.assign(graph.rows(), UINT32_MAX);
+	queue.resize(graph.rows());
+	rowReads[0] = rowReads[1] = UINT64_MAX;
+}
+
+BFSGenerator::~BFSGenerator() {
+}
+
+void BFSGenerator::step(MirandaRequestQueue<GeneratorRequest*>* q) {
+	switch(phase) {
+	case CLEAR_PARENTS:
+		queueRequest(q, parentAddr + clearNext * indexWidth, indexWidth, WRITE);
+
+		if(++clearNext == graph.rows()) {
+			phase = SEED;
+		}
+		break;
+
+	case SEED:
+		parent[source] = source;
+		queue[0] = source;
+		queueHead = 0;
+		queueTail = 1;
+
+		queueRequest(q, parentAddr + source * indexWidth, indexWidth, WRITE);
+		queueRequest(q, queueAddr, indexWidth, WRITE);
+
+		phase = POP_VERTEX;
+		break;
+
+	case POP_VERTEX:
+		if(queueHead == queueTail) {
+			out->verbose(CALL_INFO, 1, 0, "Search from %" PRIu32 " reached %" PRIu64 " of %" PRIu64 " vertices\n",
+				source, queueTail, graph.rows());
+
+			std::fill(parent.begin(), parent.end(), UINT32_MAX);
+			clearNext = 0;
+			phase = CLEAR_PARENTS;
+			iterations--;
+		} else {
+			vertex = queue[queueHead];
+
+			const uint64_t queueRead = queueRequest(q, queueAddr + queueHead * indexWidth, indexWidth, READ);
+
+			rowReads[0] = queueRequest(q, rowOffsetsAddr + vertex * offsetWidth, offsetWidth, READ, &queueRead, 1);
+			rowReads[1] = queueRequest(q, rowOffsetsAddr + (vertex + 1) * offsetWidth, offsetWidth, READ, &queueRead, 1);
+
+			entry = graph.rowStart(vertex);
+			phase = VISIT_EDGE;
+		}
+		break;
+
+	case VISIT_EDGE:
+		if(entry == graph.rowEnd(vertex)) {
+			queueHead++;
+			phase = POP_VERTEX;
+		} else {
+			const uint32_t neighbour = graph.column(entry);
+
+			const uint64_t colRead = queueRequest(q, colIndicesAddr + entry * indexWidth, indexWidth, READ, rowReads, 2);
+			const uint64_t parentRead = queueRequest(q, parentAddr + neighbour * indexWidth, indexWidth, READ, &colRead, 1);
+
+			if(UINT32_MAX == parent[neighbour]) {
+				parent[neighbour] = vertex;
+				queue[queueTail] = neighbour;
+
+				queueRequest(q, parentAddr + neighbour * indexWidth, indexWidth, WRITE, &parentRead, 1);
+				queueRequest(q, queueAddr + queueTail * indexWidth, indexWidth, WRITE, &parentRead, 1);
+
+				queueTail++;
+			}
+
+			entry++;
+		}
+		break;
+	}
+}
+
+bool BFSGenerator::isFinished() {
+	return (0 == iterations);
+}
+
+void BFSGenerator::completed() {
+
+}
@@ -0,0 +1,95 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_BFS_GEN
+#define _H_SST_MIRANDA_BFS_GEN
+
+#include <sst/elements/miranda/generators/sparsegen.h>
+
+#include <vector>
+
+namespace SST {
+namespace Miranda {
+
+/*
+ * Top-down breadth first search over a graph read from a file. The search
+ * is carried out as the requests are generated so the accesses follow the
+ * real frontier: a FIFO of vertices and a parent array which is cleared
+ * before each search and written as vertices are discovered.
+ */
+class BFSGenerator : public SparseInputGenerator {
+
+public:
+	BFSGenerator( ComponentId_t id, Params& params );
+	~BFSGenerator();
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+		BFSGenerator,
+		"miranda",
+		"BFSGenerator",
+		SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Creates the accesses of a breadth first search over a graph read from a file",
+		SST::Miranda::RequestGenerator
+	)
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "source",     "Vertex the search starts from", "0" },
+		{ "iterations", "Sets the number of searches to perform", "1" },
+		{ "row_offsets_start_addr", "Start address of the row offsets", "placed after start_addr" },
+		{ "col_indices_start_addr", "Start address of the column indices (neighbours)", "placed after the row offsets" },
+		{ "parent_start_addr",      "Start address of the parent array", "placed after the column indices" },
+		{ "queue_start_addr",       "Start address of the vertex queue", "placed after the parent array" }
+	)
+
+private:
+	typedef enum {
+		CLEAR_PARENTS,
+		SEED,
+		POP_VERTEX,
+		VISIT_EDGE
+	} BFSPhase;
+
+	void step(MirandaRequestQueue<GeneratorRequest*>* q);
+
+	MirandaSparseMatrix graph;
+
+	uint64_t rowOffsetsAddr;
+	uint64_t colIndicesAddr;
+	uint64_t parentAddr;
+	uint64_t queueAddr;
+
+	uint32_t source;
+	uint64_t iterations;
+
+	BFSPhase phase;
+	uint64_t clearNext;
+	uint64_t queueHead;
+	uint64_t queueTail;
+	uint32_t vertex;
+	uint64_t entry;
+	uint64_t rowReads[2];
+
+	std::vector<uint32_t> parent;
+	std::vector<uint32_t> queue;
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,100 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/elements/miranda/generators/csrspmvgen.h>
+
+using namespace SST::Miranda;
+
+CSRSpMVGenerator::CSRSpMVGenerator( ComponentId_t id, Params& params ) :
+	SparseInputGenerator(id, params, "CSRSpMVGenerator"), row(0), entry(0), rowStarted(false) {
+
+	loadInput(params, "input", matrix);
+
+	rowOffsetsAddr = placeArray(params, "row_offsets", (matrix.rows() + 1) * offsetWidth);
+	colIndicesAddr = placeArray(params, "col_indices", matrix.nnz() * indexWidth);
+	valuesAddr     = placeArray(params, "values", matrix.nnz() * valueWidth);
+	xAddr          = placeArray(params, "x", matrix.cols() * valueWidth);
+	yAddr          = placeArray(params, "y", matrix.rows() * valueWidth);
+
+	localRowStart = params.find<uint64_t>("local_row_start", 0);
+	localRowEnd   = params.find<uint64_t>("local_row_end", 0);
+	iterations    = params.find<uint64_t>("iterations", 1);
+
+	if(0 == localRowEnd || localRowEnd > matrix.rows()) {
+		localRowEnd = matrix.rows();
+	}
+
+	if(localRowStart >= localRowEnd) {
+		out->verbose(CALL_INFO, 1, 0, "No rows between %" PRIu64 " and %" PRIu64 ", nothing to generate.\n",
+			localRowStart, localRowEnd);
+		iterations = 0;
+	}
+
+	row = localRowStart;
+	rowReads[0] = rowReads[1] = UINT64_MAX;
+}
+
+CSRSpMVGenerator::~CSRSpMVGenerator() {
+}
+
+void CSRSpMVGenerator::step(MirandaRequestQueue<GeneratorRequest*>* q) {
+	if(! rowStarted) {
+		out->verbose(CALL_INFO, 2, 0, "Generating access for row %" PRIu64 "\n", row);
+
+		rowReads[0] = queueRequest(q, rowOffsetsAddr + row * offsetWidth, offsetWidth, READ);
+		rowReads[1] = queueRequest(q, rowOffsetsAddr + (row + 1) * offsetWidth, offsetWidth, READ);
+
+		entry = matrix.rowStart(row);
+		sumReads.clear();
+		rowStarted = true;
+		return;
+	}
+
+	// Reads from an earlier call can no longer be waited on
+	if(! sumReads.empty() && ! inBatch(sumReads.front())) {
+		sumReads.clear();
+	}
+
+	if(entry < matrix.rowEnd(row)) {
+		const uint64_t readCol = queueRequest(q, colIndicesAddr + entry * indexWidth, indexWidth, READ, rowReads, 2);
+
+		sumReads.push_back(queueRequest(q, valuesAddr + entry * valueWidth, valueWidth, READ, rowReads, 2));
+		sumReads.push_back(queueRequest(q, xAddr + matrix.column(entry) * valueWidth, valueWidth, READ, &readCol, 1));
+
+		entry++;
+		return;
+	}
+
+	queueRequest(q, yAddr + row * valueWidth, valueWidth, WRITE, sumReads.data(), sumReads.size());
+
+	rowStarted = false;
+	row++;
+
+	if(row == localRowEnd) {
+		row = localRowStart;
+		iterations--;
+	}
+}
+
+bool CSRSpMVGenerator::isFinished() {
+	return (0 == iterations);
+}
+
+void CSRSpMVGenerator::completed() {
+
+}
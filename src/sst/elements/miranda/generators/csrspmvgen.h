@@ -0,0 +1,82 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_CSR_SPMV_GEN
+#define _H_SST_MIRANDA_CSR_SPMV_GEN
+
+#include <sst/elements/miranda/generators/sparsegen.h>
+
+#include <vector>
+
+namespace SST {
+namespace Miranda {
+
+/* y = A * x over the rows of a sparse matrix loaded from a file */
+class CSRSpMVGenerator : public SparseInputGenerator {
+
+public:
+	CSRSpMVGenerator( ComponentId_t id, Params& params );
+	~CSRSpMVGenerator();
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+		CSRSpMVGenerator,
+		"miranda",
+		"CSRSpMVGenerator",
+		SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Creates the accesses of a CSR sparse matrix-vector multiply over a matrix read from a file",
+		SST::Miranda::RequestGenerator
+	)
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "local_row_start", "Sets the row at which this generator will start processing", "0" },
+		{ "local_row_end",   "Sets the row before which this generator stops processing, 0 for the last row of the matrix", "0" },
+		{ "iterations",      "Sets the number of multiplies to perform", "1" },
+		{ "row_offsets_start_addr", "Start address of the row offsets", "placed after start_addr" },
+		{ "col_indices_start_addr", "Start address of the column indices", "placed after the row offsets" },
+		{ "values_start_addr",      "Start address of the matrix values", "placed after the column indices" },
+		{ "x_start_addr",           "Start address of the input vector", "placed after the values" },
+		{ "y_start_addr",           "Start address of the result vector", "placed after the input vector" }
+	)
+
+private:
+	void step(MirandaRequestQueue<GeneratorRequest*>* q);
+
+	MirandaSparseMatrix matrix;
+
+	uint64_t rowOffsetsAddr;
+	uint64_t colIndicesAddr;
+	uint64_t valuesAddr;
+	uint64_t xAddr;
+	uint64_t yAddr;
+
+	uint64_t localRowStart;
+	uint64_t localRowEnd;
+	uint64_t iterations;
+
+	uint64_t row;
+	uint64_t entry;
+	bool rowStarted;
+	uint64_t rowReads[2];
+	std::vector<uint64_t> sumReads;
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,133 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/elements/miranda/generators/pagerankgen.h>
+
+using namespace SST::Miranda;
+
+PageRankGenerator::PageRankGenerator( ComponentId_t id, Params& params ) :
+	SparseInputGenerator(id, params, "PageRankGenerator"), in(&outGraph), phase(CONTRIBUTION),
+	vertex(0), entry(0) {
+
+	loadInput(params, "input", outGraph);
+
+	if(outGraph.rows() != outGraph.cols()) {
+		out->fatal(CALL_INFO, -1, "Error: the input has %" PRIu64 " rows and %" PRIu64 " columns, a graph must be square.\n",
+			outGraph.rows(), outGraph.cols());
+	}
+
+	outOffsetsAddr = placeArray(params, "out_offsets", (outGraph.rows() + 1) * offsetWidth);
+	outIndicesAddr = placeArray(params, "out_indices", outGraph.nnz() * indexWidth);
+
+	if(params.find<bool>("undirected", false)) {
+		inOffsetsAddr = outOffsetsAddr;
+		inIndicesAddr = outIndicesAddr;
+	} else {
+		outGraph.transpose(inGraph);
+		in = &inGraph;
+
+		inOffsetsAddr = placeArray(params, "in_offsets", (inGraph.rows() + 1) * offsetWidth);
+		inIndicesAddr = placeArray(params, "in_indices", inGraph.nnz() * indexWidth);
+	}
+
+	scoresAddr  = placeArray(params, "scores", outGraph.rows() * valueWidth);
+	contribAddr = placeArray(params, "contrib", outGraph.rows() * valueWidth);
+
+	iterations = params.find<uint64_t>("iterations", 1);
+
+	if(0 == outGraph.rows()) {
+		iterations = 0;
+	}
+
+	rowReads[0] = rowReads[1] = UINT64_MAX;
+}
+
+PageRankGenerator::~PageRankGenerator() {
+}
+
+void PageRankGenerator::step(MirandaRequestQueue<GeneratorRequest*>* q) {
+	switch(phase) {
+	case CONTRIBUTION:
+		{
+			const uint64_t reads[3] = {
+				queueRequest(q, scoresAddr + vertex * valueWidth, valueWidth, READ),
+				queueRequest(q, outOffsetsAddr + vertex * offsetWidth, offsetWidth, READ),
+				queueRequest(q, outOffsetsAddr + (vertex + 1) * offsetWidth, offsetWidth, READ)
+			};
+
+			queueRequest(q, contribAddr + vertex * valueWidth, valueWidth, WRITE, reads, 3);
+
+			if(++vertex == outGraph.rows()) {
+				vertex = 0;
+				phase = PULL_START;
+			}
+		}
+		break;
+
+	case PULL_START:
+		rowReads[0] = queueRequest(q, inOffsetsAddr + vertex * offsetWidth, offsetWidth, READ);
+		rowReads[1] = queueRequest(q, inOffsetsAddr + (vertex + 1) * offsetWidth, offsetWidth, READ);
+
+		entry = in->rowStart(vertex);
+		sumReads.clear();
+		phase = (entry == in->rowEnd(vertex)) ? PULL_END : PULL_EDGE;
+		break;
+
+	case PULL_EDGE:
+		{
+			// Reads from an earlier call can no longer be waited on
+			if(! sumReads.empty() && ! inBatch(sumReads.front())) {
+				sumReads.clear();
+			}
+
+			const uint64_t indexRead = queueRequest(q, inIndicesAddr + entry * indexWidth, indexWidth, READ, rowReads, 2);
+			sumReads.push_back(queueRequest(q, contribAddr + in->column(entry) * valueWidth, valueWidth, READ, &indexRead, 1));
+
+			if(++entry == in->rowEnd(vertex)) {
+				phase = PULL_END;
+			}
+		}
+		break;
+
+	case PULL_END:
+		if(! sumReads.empty() && ! inBatch(sumReads.front())) {
+			sumReads.clear();
+		}
+
+		// The old score is read to measure how far the scores moved
+		sumReads.push_back(queueRequest(q, scoresAddr + vertex * valueWidth, valueWidth, READ));
+		queueRequest(q, scoresAddr + vertex * valueWidth, valueWidth, WRITE, sumReads.data(), sumReads.size());
+
+		phase = PULL_START;
+
+		if(++vertex == outGraph.rows()) {
+			vertex = 0;
+			phase = CONTRIBUTION;
+			iterations--;
+		}
+		break;
+	}
+}
+
+bool PageRankGenerator::isFinished() {
+	return (0 == iterations);
+}
+
+void PageRankGenerator::completed() {
+
+}
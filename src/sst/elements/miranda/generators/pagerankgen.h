@@ -0,0 +1,95 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_PAGERANK_GEN
+#define _H_SST_MIRANDA_PAGERANK_GEN
+
+#include <sst/elements/miranda/generators/sparsegen.h>
+
+#include <vector>
+
+namespace SST {
+namespace Miranda {
+
+/*
+ * Pull-based PageRank over a graph read from a file. Each iteration first
+ * computes every vertex's outgoing contribution (score / out degree, the
+ * degree comes from the out-edge offsets) then each vertex sums the
+ * contributions of its in-neighbours and updates its score. Undirected
+ * graphs share one CSR for in and out edges, directed graphs keep both.
+ */
+class PageRankGenerator : public SparseInputGenerator {
+
+public:
+	PageRankGenerator( ComponentId_t id, Params& params );
+	~PageRankGenerator();
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+		PageRankGenerator,
+		"miranda",
+		"PageRankGenerator",
+		SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Creates the accesses of pull-based PageRank over a graph read from a file",
+		SST::Miranda::RequestGenerator
+	)
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "iterations", "Sets the number of PageRank iterations to perform", "1" },
+		{ "out_offsets_start_addr", "Start address of the out-edge row offsets", "placed after start_addr" },
+		{ "out_indices_start_addr", "Start address of the out-edge column indices", "placed after the previous array" },
+		{ "in_offsets_start_addr",  "Start address of the in-edge row offsets, if the graph is directed", "placed after the previous array" },
+		{ "in_indices_start_addr",  "Start address of the in-edge column indices, if the graph is directed", "placed after the previous array" },
+		{ "scores_start_addr",      "Start address of the scores", "placed after the previous array" },
+		{ "contrib_start_addr",     "Start address of the outgoing contributions", "placed after the previous array" }
+	)
+
+private:
+	typedef enum {
+		CONTRIBUTION,
+		PULL_START,
+		PULL_EDGE,
+		PULL_END
+	} PageRankPhase;
+
+	void step(MirandaRequestQueue<GeneratorRequest*>* q);
+
+	MirandaSparseMatrix outGraph;
+	MirandaSparseMatrix inGraph;
+	const MirandaSparseMatrix* in;
+
+	uint64_t outOffsetsAddr;
+	uint64_t outIndicesAddr;
+	uint64_t inOffsetsAddr;
+	uint64_t inIndicesAddr;
+	uint64_t scoresAddr;
+	uint64_t contribAddr;
+
+	uint64_t iterations;
+
+	PageRankPhase phase;
+	uint64_t vertex;
+	uint64_t entry;
+	uint64_t rowReads[2];
+	std::vector<uint64_t> sumReads;
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,121 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/elements/miranda/generators/sparsegen.h>
+
+#include <algorithm>
+
+#include <sys/stat.h>
+
+using namespace SST::Miranda;
+
+SparseInputGenerator::SparseInputGenerator( ComponentId_t id, Params& params, const std::string& name ) :
+	RequestGenerator(id, params), batchQueued(0), batchFirstID(UINT64_MAX) {
+
+	const uint32_t verbose = params.find<uint32_t>("verbose", 0);
+	out = new Output(name + "[@p:@l]: ", verbose, 0, Output::STDOUT);
+
+	offsetWidth   = params.find<uint64_t>("offset_width", 8);
+	indexWidth    = params.find<uint64_t>("index_width", 4);
+	valueWidth    = params.find<uint64_t>("value_width", 8);
+	nextArrayAddr = params.find<uint64_t>("start_addr", 0);
+	arrayAlign    = params.find<uint64_t>("array_align", 4096);
+	batchRequests = params.find<uint32_t>("batch_requests", 16);
+
+	if(0 == offsetWidth || 0 == indexWidth || 0 == valueWidth || 0 == arrayAlign || 0 == batchRequests) {
+		out->fatal(CALL_INFO, -1, "Error: offset_width, index_width, value_width, array_align and batch_requests must all be at least 1.\n");
+	}
+}
+
+SparseInputGenerator::~SparseInputGenerator() {
+	delete out;
+}
+
+void SparseInputGenerator::loadInput(Params& params, const std::string& key, MirandaSparseMatrix& matrix) {
+	const std::string input  = params.find<std::string>(key, "");
+	const std::string format = params.find<std::string>(key + "_format", "auto");
+	const std::string cache  = params.find<std::string>(key + "_cache", "");
+	const bool undirected    = params.find<bool>("undirected", false);
+	std::string error;
+
+	struct stat cacheStat;
+	if(! cache.empty() && 0 == stat(cache.c_str(), &cacheStat)) {
+		out->verbose(CALL_INFO, 1, 0, "Loading %s from CSR cache %s\n", key.c_str(), cache.c_str());
+
+		if(! matrix.load(cache, "csr", false, error)) {
+			out->fatal(CALL_INFO, -1, "Error: %s\n", error.c_str());
+		}
+	} else {
+		if(input.empty()) {
+			out->fatal(CALL_INFO, -1, "Error: parameter %s must name the matrix or graph to load.\n", key.c_str());
+		}
+
+		out->verbose(CALL_INFO, 1, 0, "Loading %s from %s\n", key.c_str(), input.c_str());
+
+		if(! matrix.load(input, format, undirected, error)) {
+			out->fatal(CALL_INFO, -1, "Error: %s\n", error.c_str());
+		}
+
+		if(! cache.empty() && ! matrix.save(cache, error)) {
+			out->output("Warning: %s, input will be parsed again next time.\n", error.c_str());
+		}
+	}
+
+	out->verbose(CALL_INFO, 1, 0, "Loaded %s: %" PRIu64 " rows, %" PRIu64 " columns, %" PRIu64 " non-zeros\n",
+		key.c_str(), matrix.rows(), matrix.cols(), matrix.nnz());
+}
+
+uint64_t SparseInputGenerator::placeArray(Params& params, const std::string& array, const uint64_t bytes) {
+	const uint64_t alignedAddr = ((nextArrayAddr + arrayAlign - 1) / arrayAlign) * arrayAlign;
+	const uint64_t addr = params.find<uint64_t>(array + "_start_addr", alignedAddr);
+
+	out->verbose(CALL_INFO, 1, 0, "Array %-16s at 0x%" PRIx64 ", %" PRIu64 " bytes\n", array.c_str(), addr, bytes);
+
+	nextArrayAddr = std::max(nextArrayAddr, addr + bytes);
+	return addr;
+}
+
+uint64_t SparseInputGenerator::queueRequest(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t addr,
+	const uint64_t length, const ReqOperation op, const uint64_t* deps, const size_t depCount) {
+
+	MemoryOpRequest* req = new MemoryOpRequest(addr, length, op);
+
+	if(UINT64_MAX == batchFirstID) {
+		batchFirstID = req->getRequestID();
+	}
+
+	for(size_t i = 0; i < depCount; ++i) {
+		if(inBatch(deps[i])) {
+			req->addDependency(deps[i]);
+		}
+	}
+
+	q->push_back(req);
+	batchQueued++;
+
+	return req->getRequestID();
+}
+
+void SparseInputGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+	batchQueued = 0;
+	batchFirstID = UINT64_MAX;
+
+	while(batchQueued < batchRequests && ! isFinished()) {
+		step(q);
+	}
+}
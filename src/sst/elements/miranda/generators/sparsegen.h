@@ -0,0 +1,90 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_SPARSE_GEN
+#define _H_SST_MIRANDA_SPARSE_GEN
+
+#include <sst/elements/miranda/mirandaGenerator.h>
+#include <sst/elements/miranda/generators/sparsematrix.h>
+#include <sst/core/output.h>
+
+namespace SST {
+namespace Miranda {
+
+/*
+ * Common base for the generators which walk a real sparse matrix or graph.
+ * Each call to generate() queues at most batch_requests requests, the
+ * kernels keep their position between calls so the queue stays small
+ * however large the input is.
+ *
+ * Dependencies only join requests queued by the same call, a request from
+ * an earlier call may already have completed and could then never satisfy
+ * a request waiting on it. UINT64_MAX stands for no request.
+ */
+class SparseInputGenerator : public RequestGenerator {
+
+public:
+	SparseInputGenerator( ComponentId_t id, Params& params, const std::string& name );
+	~SparseInputGenerator();
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "verbose",        "Sets the verbosity output of the generator", "0" },
+		{ "input",          "Matrix or graph to load", "" },
+		{ "input_format",   "Format of the input [auto|mtx|edgelist|csr], auto goes by the extension (.mtx, .csr, anything else is an edge list)", "auto" },
+		{ "undirected",     "Add the reverse of every edge of an edge list", "0" },
+		{ "input_cache",    "Binary CSR file to load instead of parsing input, it is written after parsing if it does not exist", "" },
+		{ "offset_width",   "Width of row offsets in bytes", "8" },
+		{ "index_width",    "Width of column indices and vertex IDs in bytes", "4" },
+		{ "value_width",    "Width of matrix values, vector elements and ranks in bytes", "8" },
+		{ "start_addr",     "Address of the first array, later arrays follow it unless given their own <array>_start_addr", "0" },
+		{ "array_align",    "Alignment in bytes of each array which is placed automatically", "4096" },
+		{ "batch_requests", "Requests queued by each call to the generator, the last unit of work is always finished so a call may queue a few more", "16" }
+	)
+
+protected:
+	/* Queue the next unit of work, which is at most a few dozen requests */
+	virtual void step(MirandaRequestQueue<GeneratorRequest*>* q) = 0;
+
+	/* Load the input named by the key parameter, key_format and key_cache go with it */
+	void loadInput(Params& params, const std::string& key, MirandaSparseMatrix& matrix);
+	uint64_t placeArray(Params& params, const std::string& array, const uint64_t bytes);
+
+	/* True if req was queued by the current call */
+	bool inBatch(const uint64_t req) const { return req >= batchFirstID && req != UINT64_MAX; }
+
+	uint64_t queueRequest(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t addr,
+		const uint64_t length, const ReqOperation op,
+		const uint64_t* deps = NULL, const size_t depCount = 0);
+
+	Output*  out;
+	uint64_t offsetWidth;
+	uint64_t indexWidth;
+	uint64_t valueWidth;
+
+private:
+	uint64_t nextArrayAddr;
+	uint64_t arrayAlign;
+	uint32_t batchRequests;
+	uint32_t batchQueued;
+	uint64_t batchFirstID;
+
+};
+
+}
+}
+
+#endif
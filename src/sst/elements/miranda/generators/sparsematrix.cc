@@ -0,0 +1,326 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include <sst/elements/miranda/generators/sparsematrix.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+using namespace SST::Miranda;
+
+static const char MIRANDA_CSR_MAGIC[8] = { 'M', 'I', 'R', 'C', 'S', 'R', '0', '1' };
+
+MirandaSparseMatrix::MirandaSparseMatrix() : rowCount(0), colCount(0) {
+	offsets.push_back(0);
+}
+
+bool MirandaSparseMatrix::load(const std::string& path, const std::string& format, const bool symmetrize, std::string& error) {
+	std::string useFormat = format;
+
+	if("auto" == useFormat) {
+		const std::string::size_type dot = path.rfind('.');
+		const std::string ext = (std::string::npos == dot) ? "" : path.substr(dot + 1);
+
+		if("mtx" == ext) {
+			useFormat = "mtx";
+		} else if("csr" == ext) {
+			useFormat = "csr";
+		} else {
+			useFormat = "edgelist";
+		}
+	}
+
+	if("mtx" == useFormat) {
+		return loadMatrixMarket(path, error);
+	} else if("edgelist" == useFormat) {
+		return loadEdgeList(path, symmetrize, error);
+	} else if("csr" == useFormat) {
+		return loadCSR(path, error);
+	}
+
+	error = "unknown input format " + format + ", must be auto, mtx, edgelist or csr";
+	return false;
+}
+
+bool MirandaSparseMatrix::loadMatrixMarket(const std::string& path, std::string& error) {
+	FILE* input = fopen(path.c_str(), "r");
+	if(NULL == input) {
+		error = "cannot open " + path;
+		return false;
+	}
+
+	char* line = NULL;
+	size_t lineCapacity = 0;
+	bool symmetric = false;
+	bool sizeRead = false;
+	uint64_t lineNumber = 0;
+	std::vector<uint32_t> src;
+	std::vector<uint32_t> dst;
+
+	while(getline(&line, &lineCapacity, input) > 0) {
+		lineNumber++;
+
+		if(1 == lineNumber) {
+			std::string banner(line);
+			std::transform(banner.begin(), banner.end(), banner.begin(), ::tolower);
+
+			if(0 != banner.compare(0, 14, "%%matrixmarket") || std::string::npos == banner.find("coordinate")) {
+				error = path + " is not a Matrix Market coordinate file";
+				break;
+			}
+
+			symmetric = (std::string::npos != banner.find("symmetric")) ||
+				(std::string::npos != banner.find("hermitian"));
+			continue;
+		}
+
+		if('%' == line[0] || '\n' == line[0] || '\0' == line[0]) {
+			continue;
+		}
+
+		char* next = line;
+		const uint64_t i = strtoull(next, &next, 10);
+		const uint64_t j = strtoull(next, &next, 10);
+
+		if(! sizeRead) {
+			const uint64_t nonZeros = strtoull(next, &next, 10);
+
+			if(0 == i || 0 == j || i > UINT32_MAX || j > UINT32_MAX) {
+				error = path + ": matrix dimensions are missing or need more than 32-bit indices";
+				break;
+			}
+
+			rowCount = i;
+			colCount = j;
+			src.reserve(symmetric ? 2 * nonZeros : nonZeros);
+			dst.reserve(symmetric ? 2 * nonZeros : nonZeros);
+			sizeRead = true;
+			continue;
+		}
+
+		if(0 == i || 0 == j || i > rowCount || j > colCount) {
+			std::ostringstream msg;
+			msg << path << ":" << lineNumber << ": entry is outside the matrix";
+			error = msg.str();
+			break;
+		}
+
+		src.push_back((uint32_t) (i - 1));
+		dst.push_back((uint32_t) (j - 1));
+
+		if(symmetric && i != j) {
+			src.push_back((uint32_t) (j - 1));
+			dst.push_back((uint32_t) (i - 1));
+		}
+	}
+
+	free(line);
+	fclose(input);
+
+	if(error.empty() && ! sizeRead) {
+		error = path + " has no size line";
+	}
+
+	if(! error.empty()) {
+		return false;
+	}
+
+	build(src, dst);
+	return true;
+}
+
+bool MirandaSparseMatrix::loadEdgeList(const std::string& path, const bool symmetrize, std::string& error) {
+	FILE* input = fopen(path.c_str(), "r");
+	if(NULL == input) {
+		error = "cannot open " + path;
+		return false;
+	}
+
+	char* line = NULL;
+	size_t lineCapacity = 0;
+	uint64_t lineNumber = 0;
+	uint64_t maxVertex = 0;
+	std::vector<uint32_t> src;
+	std::vector<uint32_t> dst;
+
+	while(getline(&line, &lineCapacity, input) > 0) {
+		lineNumber++;
+
+		char* next = line;
+		while(isspace(*next)) {
+			next++;
+		}
+
+		if('#' == *next || '%' == *next || '\0' == *next) {
+			continue;
+		}
+
+		char* end = NULL;
+		const uint64_t u = strtoull(next, &end, 10);
+		const bool haveU = (end != next);
+		next = end;
+		const uint64_t v = strtoull(next, &end, 10);
+
+		if(! haveU || end == next || u >= UINT32_MAX || v >= UINT32_MAX) {
+			std::ostringstream msg;
+			msg << path << ":" << lineNumber << ": expected two vertex IDs below 2^32-1";
+			error = msg.str();
+			break;
+		}
+
+		maxVertex = std::max(maxVertex, std::max(u, v));
+		src.push_back((uint32_t) u);
+		dst.push_back((uint32_t) v);
+
+		if(symmetrize && u != v) {
+			src.push_back((uint32_t) v);
+			dst.push_back((uint32_t) u);
+		}
+	}
+
+	free(line);
+	fclose(input);
+
+	if(! error.empty()) {
+		return false;
+	}
+
+	rowCount = src.empty() ? 0 : maxVertex + 1;
+	colCount = rowCount;
+
+	build(src, dst);
+	return true;
+}
+
+bool MirandaSparseMatrix::loadCSR(const std::string& path, std::string& error) {
+	FILE* input = fopen(path.c_str(), "rb");
+	if(NULL == input) {
+		error = "cannot open " + path;
+		return false;
+	}
+
+	char magic[8];
+	uint64_t header[3];
+	bool ok = (1 == fread(magic, sizeof(magic), 1, input)) &&
+		(0 == memcmp(magic, MIRANDA_CSR_MAGIC, sizeof(magic))) &&
+		(1 == fread(header, sizeof(header), 1, input)) &&
+		(header[1] <= UINT32_MAX);
+
+	if(ok) {
+		rowCount = header[0];
+		colCount = header[1];
+		offsets.resize(rowCount + 1);
+		columns.resize(header[2]);
+
+		ok = (offsets.size() == fread(offsets.data(), sizeof(uint64_t), offsets.size(), input)) &&
+			(columns.size() == fread(columns.data(), sizeof(uint32_t), columns.size(), input)) &&
+			(0 == offsets[0]) && (offsets[rowCount] == header[2]);
+
+		for(uint64_t row = 0; ok && row < rowCount; ++row) {
+			ok = (offsets[row] <= offsets[row + 1]);
+		}
+
+		for(size_t entry = 0; ok && entry < columns.size(); ++entry) {
+			ok = (columns[entry] < colCount);
+		}
+	}
+
+	fclose(input);
+
+	if(! ok) {
+		error = path + " is not a valid CSR file";
+		rowCount = colCount = 0;
+		offsets.assign(1, 0);
+		columns.clear();
+	}
+
+	return ok;
+}
+
+bool MirandaSparseMatrix::save(const std::string& path, std::string& error) const {
+	FILE* output = fopen(path.c_str(), "wb");
+	if(NULL == output) {
+		error = "cannot create " + path;
+		return false;
+	}
+
+	const uint64_t header[3] = { rowCount, colCount, (uint64_t) columns.size() };
+
+	bool ok = (1 == fwrite(MIRANDA_CSR_MAGIC, sizeof(MIRANDA_CSR_MAGIC), 1, output)) &&
+		(1 == fwrite(header, sizeof(header), 1, output)) &&
+		(offsets.size() == fwrite(offsets.data(), sizeof(uint64_t), offsets.size(), output)) &&
+		(columns.size() == fwrite(columns.data(), sizeof(uint32_t), columns.size(), output));
+
+	ok = (0 == fclose(output)) && ok;
+
+	if(! ok) {
+		error = "error writing " + path;
+	}
+
+	return ok;
+}
+
+void MirandaSparseMatrix::build(const std::vector<uint32_t>& src, const std::vector<uint32_t>& dst) {
+	// Counting sort of the entries by row, then each row by column
+	offsets.assign(rowCount + 1, 0);
+	for(size_t i = 0; i < src.size(); ++i) {
+		offsets[src[i] + 1]++;
+	}
+
+	for(uint64_t row = 0; row < rowCount; ++row) {
+		offsets[row + 1] += offsets[row];
+	}
+
+	std::vector<uint64_t> fill(offsets.begin(), offsets.end() - 1);
+	columns.resize(src.size());
+
+	for(size_t i = 0; i < src.size(); ++i) {
+		columns[fill[src[i]]++] = dst[i];
+	}
+
+	for(uint64_t row = 0; row < rowCount; ++row) {
+		std::sort(columns.begin() + offsets[row], columns.begin() + offsets[row + 1]);
+	}
+}
+
+void MirandaSparseMatrix::transpose(MirandaSparseMatrix& result) const {
+	result.rowCount = colCount;
+	result.colCount = rowCount;
+	result.offsets.assign(colCount + 1, 0);
+	result.columns.resize(columns.size());
+
+	for(size_t i = 0; i < columns.size(); ++i) {
+		result.offsets[columns[i] + 1]++;
+	}
+
+	for(uint64_t row = 0; row < colCount; ++row) {
+		result.offsets[row + 1] += result.offsets[row];
+	}
+
+	// Visiting the rows in order leaves each row of the result sorted
+	std::vector<uint64_t> fill(result.offsets.begin(), result.offsets.end() - 1);
+
+	for(uint64_t row = 0; row < rowCount; ++row) {
+		for(uint64_t entry = offsets[row]; entry < offsets[row + 1]; ++entry) {
+			result.columns[fill[columns[entry]]++] = (uint32_t) row;
+		}
+	}
+}
@@ -0,0 +1,71 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_SPARSE_MATRIX
+#define _H_SST_MIRANDA_SPARSE_MATRIX
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Miranda {
+
+/*
+ * The structure (no values) of a sparse matrix or graph held in CSR form,
+ * row offsets are 64-bit and column indices 32-bit. A graph is stored as
+ * its adjacency matrix, row u holds the out-edges of vertex u.
+ *
+ * Loads Matrix Market coordinate files (symmetric files are expanded),
+ * whitespace separated edge lists (u v [weight], 0-based, lines starting
+ * with # or % are comments) and the binary CSR files written by save().
+ * The generators only need addresses, so values and weights are dropped.
+ */
+class MirandaSparseMatrix {
+public:
+	MirandaSparseMatrix();
+
+	/* format is auto, mtx, edgelist or csr, auto goes by the file extension */
+	bool load(const std::string& path, const std::string& format, const bool symmetrize, std::string& error);
+	bool save(const std::string& path, std::string& error) const;
+
+	void transpose(MirandaSparseMatrix& result) const;
+
+	uint64_t rows() const { return rowCount; }
+	uint64_t cols() const { return colCount; }
+	uint64_t nnz() const { return columns.size(); }
+
+	uint64_t rowStart(const uint64_t row) const { return offsets[row]; }
+	uint64_t rowEnd(const uint64_t row) const { return offsets[row + 1]; }
+	uint32_t column(const uint64_t entry) const { return columns[entry]; }
+
+private:
+	bool loadMatrixMarket(const std::string& path, std::string& error);
+	bool loadEdgeList(const std::string& path, const bool symmetrize, std::string& error);
+	bool loadCSR(const std::string& path, std::string& error);
+	void build(const std::vector<uint32_t>& src, const std::vector<uint32_t>& dst);
+
+	uint64_t rowCount;
+	uint64_t colCount;
+	std::vector<uint64_t> offsets;
+	std::vector<uint32_t> columns;
+};
+
+}
+}
+
+#endif
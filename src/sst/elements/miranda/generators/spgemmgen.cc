@@ -0,0 +1,211 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/elements/miranda/generators/spgemmgen.h>
+
+#include <algorithm>
+
+using namespace SST::Miranda;
+
+SpGEMMGenerator::SpGEMMGenerator( ComponentId_t id, Params& params ) :
+	SparseInputGenerator(id, params, "SpGEMMGenerator"), b(&matrixA), phase(ROW_START),
+	row(0), aEntry(0), bEntry(0), bEnd(0), cFirstEntry(0), cEntry(0), cNext(0),
+	aIndexRead(UINT64_MAX), aValueRead(UINT64_MAX) {
+
+	loadInput(params, "input", matrixA);
+
+	if(! params.find<std::string>("input_b", "").empty() || ! params.find<std::string>("input_b_cache", "").empty()) {
+		loadInput(params, "input_b", matrixB);
+		b = &matrixB;
+	}
+
+	if(matrixA.cols() != b->rows()) {
+		out->fatal(CALL_INFO, -1, "Error: A has %" PRIu64 " columns but B has %" PRIu64 " rows, cannot multiply.\n",
+			matrixA.cols(), b->rows());
+	}
+
+	localRowStart = params.find<uint64_t>("local_row_start", 0);
+	localRowEnd   = params.find<uint64_t>("local_row_end", 0);
+	iterations    = params.find<uint64_t>("iterations", 1);
+
+	if(0 == localRowEnd || localRowEnd > matrixA.rows()) {
+		localRowEnd = matrixA.rows();
+	}
+
+	if(localRowStart >= localRowEnd) {
+		out->verbose(CALL_INFO, 1, 0, "No rows between %" PRIu64 " and %" PRIu64 ", nothing to generate.\n",
+			localRowStart, localRowEnd);
+		localRowStart = localRowEnd;
+		iterations = 0;
+	}
+
+	// A symbolic pass sizes C and finds where the rows of this generator go
+	marker.assign(b->cols(), UINT32_MAX);
+	cFirstEntry = countProducts(0, localRowStart);
+	const uint64_t cEntries = cFirstEntry + countProducts(localRowStart, matrixA.rows());
+
+	out->verbose(CALL_INFO, 1, 0, "C has %" PRIu64 " non-zeros, rows from %" PRIu64 " start at entry %" PRIu64 "\n",
+		cEntries, localRowStart, cFirstEntry);
+
+	aRowOffsetsAddr = placeArray(params, "a_row_offsets", (matrixA.rows() + 1) * offsetWidth);
+	aColIndicesAddr = placeArray(params, "a_col_indices", matrixA.nnz() * indexWidth);
+	aValuesAddr     = placeArray(params, "a_values", matrixA.nnz() * valueWidth);
+
+	if(b == &matrixA) {
+		bRowOffsetsAddr = aRowOffsetsAddr;
+		bColIndicesAddr = aColIndicesAddr;
+		bValuesAddr     = aValuesAddr;
+	} else {
+		bRowOffsetsAddr = placeArray(params, "b_row_offsets", (b->rows() + 1) * offsetWidth);
+		bColIndicesAddr = placeArray(params, "b_col_indices", b->nnz() * indexWidth);
+		bValuesAddr     = placeArray(params, "b_values", b->nnz() * valueWidth);
+	}
+
+	accumulatorAddr = placeArray(params, "accumulator", b->cols() * valueWidth);
+	cRowOffsetsAddr = placeArray(params, "c_row_offsets", (matrixA.rows() + 1) * offsetWidth);
+	cColIndicesAddr = placeArray(params, "c_col_indices", cEntries * indexWidth);
+	cValuesAddr     = placeArray(params, "c_values", cEntries * valueWidth);
+
+	row = localRowStart;
+	cEntry = cFirstEntry;
+	aRowReads[0] = aRowReads[1] = UINT64_MAX;
+	bRowReads[0] = bRowReads[1] = UINT64_MAX;
+}
+
+SpGEMMGenerator::~SpGEMMGenerator() {
+}
+
+uint64_t SpGEMMGenerator::countProducts(const uint64_t firstRow, const uint64_t lastRow) {
+	uint64_t entries = 0;
+
+	for(uint64_t i = firstRow; i < lastRow; ++i) {
+		for(uint64_t j = matrixA.rowStart(i); j < matrixA.rowEnd(i); ++j) {
+			const uint32_t k = matrixA.column(j);
+
+			for(uint64_t l = b->rowStart(k); l < b->rowEnd(k); ++l) {
+				if(marker[b->column(l)] != (uint32_t) i) {
+					marker[b->column(l)] = (uint32_t) i;
+					entries++;
+				}
+			}
+		}
+	}
+
+	std::fill(marker.begin(), marker.end(), UINT32_MAX);
+	return entries;
+}
+
+void SpGEMMGenerator::step(MirandaRequestQueue<GeneratorRequest*>* q) {
+	switch(phase) {
+	case ROW_START:
+		out->verbose(CALL_INFO, 2, 0, "Generating access for row %" PRIu64 "\n", row);
+
+		aRowReads[0] = queueRequest(q, aRowOffsetsAddr + row * offsetWidth, offsetWidth, READ);
+		aRowReads[1] = queueRequest(q, aRowOffsetsAddr + (row + 1) * offsetWidth, offsetWidth, READ);
+
+		aEntry = matrixA.rowStart(row);
+		touched.clear();
+		phase = A_ENTRY;
+		break;
+
+	case A_ENTRY:
+		if(aEntry == matrixA.rowEnd(row)) {
+			std::sort(touched.begin(), touched.end());
+			cNext = 0;
+			phase = C_ENTRY;
+		} else {
+			const uint32_t k = matrixA.column(aEntry);
+
+			aIndexRead = queueRequest(q, aColIndicesAddr + aEntry * indexWidth, indexWidth, READ, aRowReads, 2);
+			aValueRead = queueRequest(q, aValuesAddr + aEntry * valueWidth, valueWidth, READ, aRowReads, 2);
+
+			bRowReads[0] = queueRequest(q, bRowOffsetsAddr + k * offsetWidth, offsetWidth, READ, &aIndexRead, 1);
+			bRowReads[1] = queueRequest(q, bRowOffsetsAddr + (k + 1) * offsetWidth, offsetWidth, READ, &aIndexRead, 1);
+
+			bEntry = b->rowStart(k);
+			bEnd = b->rowEnd(k);
+			phase = B_ENTRY;
+		}
+		break;
+
+	case B_ENTRY:
+		if(bEntry == bEnd) {
+			aEntry++;
+			phase = A_ENTRY;
+		} else {
+			const uint32_t col = b->column(bEntry);
+			const uint64_t accAddr = accumulatorAddr + col * valueWidth;
+
+			const uint64_t bIndexRead = queueRequest(q, bColIndicesAddr + bEntry * indexWidth, indexWidth, READ, bRowReads, 2);
+			const uint64_t bValueRead = queueRequest(q, bValuesAddr + bEntry * valueWidth, valueWidth, READ, bRowReads, 2);
+
+			// The first product for a column initialises the accumulator, the rest add to it
+			if(marker[col] != (uint32_t) row) {
+				marker[col] = (uint32_t) row;
+				touched.push_back(col);
+
+				const uint64_t deps[3] = { aValueRead, bValueRead, bIndexRead };
+				queueRequest(q, accAddr, valueWidth, WRITE, deps, 3);
+			} else {
+				const uint64_t accRead = queueRequest(q, accAddr, valueWidth, READ, &bIndexRead, 1);
+
+				const uint64_t deps[3] = { aValueRead, bValueRead, accRead };
+				queueRequest(q, accAddr, valueWidth, WRITE, deps, 3);
+			}
+
+			bEntry++;
+		}
+		break;
+
+	case C_ENTRY:
+		if(cNext == touched.size()) {
+			phase = ROW_END;
+		} else {
+			const uint64_t accRead = queueRequest(q, accumulatorAddr + touched[cNext] * valueWidth, valueWidth, READ);
+
+			queueRequest(q, cColIndicesAddr + cEntry * indexWidth, indexWidth, WRITE);
+			queueRequest(q, cValuesAddr + cEntry * valueWidth, valueWidth, WRITE, &accRead, 1);
+
+			cEntry++;
+			cNext++;
+		}
+		break;
+
+	case ROW_END:
+		queueRequest(q, cRowOffsetsAddr + (row + 1) * offsetWidth, offsetWidth, WRITE);
+
+		row++;
+		phase = ROW_START;
+
+		if(row == localRowEnd) {
+			row = localRowStart;
+			cEntry = cFirstEntry;
+			std::fill(marker.begin(), marker.end(), UINT32_MAX);
+			iterations--;
+		}
+		break;
+	}
+}
+
+bool SpGEMMGenerator::isFinished() {
+	return (0 == iterations);
+}
+
+void SpGEMMGenerator::completed() {
+
+}
@@ -0,0 +1,122 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_SPGEMM_GEN
+#define _H_SST_MIRANDA_SPGEMM_GEN
+
+#include <sst/elements/miranda/generators/sparsegen.h>
+
+#include <vector>
+
+namespace SST {
+namespace Miranda {
+
+/*
+ * C = A * B row by row (Gustavson) with a dense accumulator the width of a
+ * row of B. Each row of C is written out in column order once all of its
+ * partial products have been accumulated. B is A unless input_b is given.
+ */
+class SpGEMMGenerator : public SparseInputGenerator {
+
+public:
+	SpGEMMGenerator( ComponentId_t id, Params& params );
+	~SpGEMMGenerator();
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+		SpGEMMGenerator,
+		"miranda",
+		"SpGEMMGenerator",
+		SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Creates the accesses of a sparse matrix-matrix multiply over matrices read from files",
+		SST::Miranda::RequestGenerator
+	)
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "input_b",         "Right hand matrix B, the product is A * A if this is not given", "" },
+		{ "input_b_format",  "Format of input_b, as for input_format", "auto" },
+		{ "input_b_cache",   "Binary CSR cache for input_b, as for input_cache", "" },
+		{ "local_row_start", "Sets the row of A at which this generator will start processing", "0" },
+		{ "local_row_end",   "Sets the row of A before which this generator stops processing, 0 for the last row", "0" },
+		{ "iterations",      "Sets the number of multiplies to perform", "1" },
+		{ "a_row_offsets_start_addr", "Start address of the row offsets of A", "placed after start_addr" },
+		{ "a_col_indices_start_addr", "Start address of the column indices of A", "placed after the previous array" },
+		{ "a_values_start_addr",      "Start address of the values of A", "placed after the previous array" },
+		{ "b_row_offsets_start_addr", "Start address of the row offsets of B, if B is not A", "placed after the previous array" },
+		{ "b_col_indices_start_addr", "Start address of the column indices of B, if B is not A", "placed after the previous array" },
+		{ "b_values_start_addr",      "Start address of the values of B, if B is not A", "placed after the previous array" },
+		{ "accumulator_start_addr",   "Start address of the dense accumulator", "placed after the previous array" },
+		{ "c_row_offsets_start_addr", "Start address of the row offsets of C", "placed after the previous array" },
+		{ "c_col_indices_start_addr", "Start address of the column indices of C", "placed after the previous array" },
+		{ "c_values_start_addr",      "Start address of the values of C", "placed after the previous array" }
+	)
+
+private:
+	typedef enum {
+		ROW_START,
+		A_ENTRY,
+		B_ENTRY,
+		C_ENTRY,
+		ROW_END
+	} SpGEMMPhase;
+
+	void step(MirandaRequestQueue<GeneratorRequest*>* q);
+	uint64_t countProducts(const uint64_t firstRow, const uint64_t lastRow);
+
+	MirandaSparseMatrix matrixA;
+	MirandaSparseMatrix matrixB;
+	const MirandaSparseMatrix* b;
+
+	uint64_t aRowOffsetsAddr;
+	uint64_t aColIndicesAddr;
+	uint64_t aValuesAddr;
+	uint64_t bRowOffsetsAddr;
+	uint64_t bColIndicesAddr;
+	uint64_t bValuesAddr;
+	uint64_t accumulatorAddr;
+	uint64_t cRowOffsetsAddr;
+	uint64_t cColIndicesAddr;
+	uint64_t cValuesAddr;
+
+	uint64_t localRowStart;
+	uint64_t localRowEnd;
+	uint64_t iterations;
+
+	SpGEMMPhase phase;
+	uint64_t row;
+	uint64_t aEntry;
+	uint64_t bEntry;
+	uint64_t bEnd;
+	uint64_t cFirstEntry;
+	uint64_t cEntry;
+	size_t   cNext;
+
+	uint64_t aRowReads[2];
+	uint64_t bRowReads[2];
+	uint64_t aIndexRead;
+	uint64_t aValueRead;
+
+	// Row of A which last touched each column of the accumulator
+	std::vector<uint32_t> marker;
+	std::vector<uint32_t> touched;
+
+};
+
+}
+}
+
+#endif
@@ -27,7 +27,7 @@ std::atomic<uint64_t> SST::Miranda::GeneratorRequest::nextGeneratorRequestID(0);
 using namespace SST::Miranda;
 
 RequestGenCPU::RequestGenCPU(SST::ComponentId_t id, SST::Params& params) :
-	Component(id), srcLink(NULL), reqGen(NULL) {
+	Component(id), srcLink(NULL), reqGen(NULL), pendingTracked(0) {
 
 	const int verbose = params.find<int>("verbose", 0);
 	std::stringstream prefix;
@@ -72,6 +72,10 @@ RequestGenCPU::RequestGenCPU(SST::ComponentId_t id, SST::Params& params) :
 
 	maxOpLookup = params.find<uint64_t>("max_reorder_lookups", 16);
 
+	requestsInFlight.reserve(2 * (maxRequestsPending[READ] + maxRequestsPending[WRITE] + maxRequestsPending[CUSTOM]));
+	dependents.reserve(maxOpLookup + maxRequestsPending[READ] + maxRequestsPending[WRITE] + maxRequestsPending[CUSTOM]);
+	retiredRequests.reserve(maxOpLookup);
+
 	out->verbose(CALL_INFO, 1, 0, "Loaded memory interface successfully.\n");
 
 	cacheLine = params.find<uint64_t>("cache_line_size", 64);
@@ -212,22 +216,63 @@ void RequestGenCPU::loadGenerator( const std::string& name, SST::Params& params)
 }
 
 
+void RequestGenCPU::trackNewRequests() {
+	// Add the requests the generator has queued since the last call, all of
+	// them first so a request may depend on one queued after it
+	for(uint32_t i = pendingTracked; i < pendingRequests.size(); ++i) {
+		dependents.insert(pendingRequests.at(i)->getRequestID());
+	}
+
+	for(uint32_t i = pendingTracked; i < pendingRequests.size(); ++i) {
+		GeneratorRequest* nxtRq = pendingRequests.at(i);
+
+		// Fences retire without looking at their dependencies
+		if(nxtRq->getOperation() != REQ_FENCE) {
+			const std::vector<uint64_t>& deps = nxtRq->getDependencies();
+
+			for(uint32_t j = 0; j < deps.size(); ++j) {
+				std::vector<GeneratorRequest*>* waiting = dependents.find(deps[j]);
+
+				if(NULL == waiting) {
+					nxtRq->satisfyTrackedDependency();
+				} else {
+					waiting->push_back(nxtRq);
+				}
+			}
+		}
+	}
+
+	pendingTracked = pendingRequests.size();
+}
+
+void RequestGenCPU::completeRequest(const uint64_t reqID) {
+	std::vector<GeneratorRequest*>* waiting = dependents.find(reqID);
+
+	if(NULL != waiting) {
+		for(uint32_t i = 0; i < waiting->size(); ++i) {
+			(*waiting)[i]->satisfyTrackedDependency();
+		}
+
+		dependents.erase(reqID);
+	}
+}
+
 void RequestGenCPU::handleEvent( Interfaces::StandardMem::Request* ev) {
 	out->verbose(CALL_INFO, 2, 0, "Recv event for processing from interface\n");
 
         Interfaces::StandardMem::Request::id_t reqID = ev->getID();
-	std::map<Interfaces::StandardMem::Request::id_t, CPURequest*>::iterator reqFind = requestsInFlight.find(reqID);
+	CPURequest** reqFind = requestsInFlight.find(reqID);
 
-	if(reqFind == requestsInFlight.end()) {
+	if(NULL == reqFind) {
 		out->fatal(CALL_INFO, -1, "Unable to find request %" PRIu64 " in request map.\n", reqID);
 	} else{
-		CPURequest* cpuReq = reqFind->second;
+		CPURequest* cpuReq = *reqFind;
 
 		out->verbose(CALL_INFO, 4, 0, "Miranda request located ID=%" PRIu64 ", contains %" PRIu32 " parts, issue time=%" PRIu64 ", time now=%" PRIu64 "\n",
 			cpuReq->getOriginalReqID(), cpuReq->countParts(), cpuReq->getIssueTime(), getCurrentSimTimeNano());
 
 		statReqLatency->addData((getCurrentSimTimeNano() - cpuReq->getIssueTime()));
-		requestsInFlight.erase(reqFind);
+		requestsInFlight.erase(reqID);
 
 		// Tell the CPU request one more of its parts are satisfied
 		cpuReq->decPartCount();
@@ -241,10 +286,8 @@ void RequestGenCPU::handleEvent( Interfaces::StandardMem::Request* ev) {
 			out->verbose(CALL_INFO, 4, 0, "-> Entry has all parts satisfied, removing ID=%" PRIu64 ", total processing time: %" PRIu64 "ns\n",
 				cpuReq->getOriginalReqID(), (getCurrentSimTimeNano() - cpuReq->getIssueTime()));
 
-			// Notify every pending request that there may be a satisfied dependency
-			for(uint32_t i = 0; i < pendingRequests.size(); ++i) {
-				pendingRequests.at(i)->satisfyDependency(cpuReq->getOriginalReqID());
-			}
+			// Notify only the pending requests which depend on this one
+			completeRequest(cpuReq->getOriginalReqID());
 
 			delete cpuReq;
 		}
@@ -283,7 +326,7 @@ void RequestGenCPU::issueCustomRequest(CustomOpRequest* req) {
     newCPUReq->incPartCount();
     newCPUReq->setIssueTime(getCurrentSimTimeNano());
 
-    requestsInFlight.insert( std::pair<Interfaces::StandardMem::Request::id_t, CPURequest*>(request->getID(), newCPUReq) );
+    requestsInFlight.insert(request->getID()) = newCPUReq;
     cache_link->send(request);
         
     requestsPending[CUSTOM]++;
@@ -342,8 +385,8 @@ void RequestGenCPU::issueRequest(MemoryOpRequest* req) {
         newCPUReq->incPartCount();
     	newCPUReq->setIssueTime(getCurrentSimTimeNano());
 
-    	requestsInFlight.insert( std::pair<Interfaces::StandardMem::Request::id_t, CPURequest*>(reqLower->getID(), newCPUReq) );
-        requestsInFlight.insert( std::pair<Interfaces::StandardMem::Request::id_t, CPURequest*>(reqUpper->getID(), newCPUReq) );
+    	requestsInFlight.insert(reqLower->getID()) = newCPUReq;
+        requestsInFlight.insert(reqUpper->getID()) = newCPUReq;
 
     	out->verbose(CALL_INFO, 4, 0, "Issuing requesting into cache link...\n");
         cache_link->send(reqLower);
@@ -372,7 +415,7 @@ void RequestGenCPU::issueRequest(MemoryOpRequest* req) {
         newCPUReq->incPartCount();
         newCPUReq->setIssueTime(getCurrentSimTimeNano());
 
-        requestsInFlight.insert( std::pair<Interfaces::StandardMem::Request::id_t, CPURequest*>(request->getID(), newCPUReq) );
+        requestsInFlight.insert(request->getID()) = newCPUReq;
         cache_link->send(request);
 
         requestsPending[operation]++;
@@ -437,7 +480,8 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
 
     bool issued = false;
     uint32_t reqsIssuedThisCycle = 0;
-    std::vector<uint32_t> delReqs;
+    std::vector<uint32_t>& delReqs = retiredRequests;
+    delReqs.clear();
 
     // We need to generate at least as many requests as can be looked up in the OoO window
     // otherwise the issue will have starvation.
@@ -449,6 +493,8 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
     	}
     }
 
+    trackNewRequests();
+
     for(uint32_t i = 0; i < pendingRequests.size(); ++i) {
         if(reqsIssuedThisCycle == reqMaxPerCycle) {
             statMaxIssuePerCycle->addData(1);
@@ -467,12 +513,15 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
 	GeneratorRequest* nxtRq = pendingRequests.at(i);
 
 	if(nxtRq->getOperation() == REQ_FENCE) {
-            if(0 == requestsInFlight.size()) {
+            if(requestsInFlight.empty()) {
 		out->verbose(CALL_INFO, 4, 0, "Fence operation completed, no pending requests, will be retired.\n");
 
                 // Keep record we will delete fence at i
     		delReqs.push_back(i);
 
+                // Requests waiting on the fence may go now
+                completeRequest(nxtRq->getRequestID());
+
                 // Delete the fence
     		delete nxtRq;
             } else {
@@ -533,7 +582,9 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
         }
     }
 
+    // Only requests already in the dependency graph are retired
     pendingRequests.erase(delReqs);
+    pendingTracked -= delReqs.size();
 
     if(issued) {
 	statCyclesWithIssue->addData(1);
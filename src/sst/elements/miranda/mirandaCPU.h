@@ -20,6 +20,9 @@
 #include <sst/core/interfaces/stdMem.h>
 #include <sst/core/statapi/stataccumulator.h>
 
+#include <vector>
+
+#include "mirandaFlatTable.h"
 #include "mirandaGenerator.h"
 #include "mirandaEvent.h"
 #include "mirandaMemMgr.h"
@@ -135,19 +138,29 @@ private:
     void issueRequest(MemoryOpRequest* req);
     void issueCustomRequest(CustomOpRequest* req);
     void handleSrcEvent( SST::Event* );
+    void trackNewRequests();
+    void completeRequest(const uint64_t reqID);
 
     Output* out;
 
     TimeConverter* timeConverter;
     Clock::HandlerBase* clockHandler;
     RequestGenerator* reqGen;
-    std::map<StandardMem::Request::id_t, CPURequest*> requestsInFlight;
+    MirandaFlatTable<CPURequest*> requestsInFlight;
     StandardMem* cache_link;
     Link* srcLink;
     MirandaReqEvent* srcReqEvent;
     StdMemHandler* stdMemHandlers;
 
     MirandaRequestQueue<GeneratorRequest*> pendingRequests;
+    std::vector<uint32_t> retiredRequests;
+
+    // Reverse dependency edges, one entry for every request which is queued
+    // or in flight, holding the pending requests waiting for it. A dependency
+    // on a request without an entry has already completed. Entries of
+    // pendingRequests at or beyond pendingTracked have not been added yet.
+    MirandaFlatTable<std::vector<GeneratorRequest*> > dependents;
+    uint32_t pendingTracked;
     MirandaMemoryManager* memMgr;
 
     uint32_t maxRequestsPending[OPCOUNT];
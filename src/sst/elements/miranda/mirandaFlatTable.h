@@ -0,0 +1,158 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_MIRANDA_FLAT_TABLE
+#define _H_SST_MIRANDA_FLAT_TABLE
+
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+
+namespace SST {
+namespace Miranda {
+
+/*
+ * Open addressing table keyed by request ID. Slots sit in one array and are
+ * probed linearly, erase shifts the following entries back instead of leaving
+ * tombstones, so a table that keeps about as many entries as it is sized for
+ * never allocates once it has grown. Pointers from find() or insert() are
+ * valid until the next insert() or erase().
+ */
+template<typename ValueType>
+class MirandaFlatTable {
+public:
+	MirandaFlatTable() : count(0) {
+		slots.resize(16);
+		mask = slots.size() - 1;
+	}
+
+	/** Size the table for at least entries live entries */
+	void reserve(const size_t entries) {
+		size_t capacity = slots.size();
+
+		while(capacity < 2 * entries) {
+			capacity <<= 1;
+		}
+
+		if(capacity > slots.size()) {
+			rehash(capacity);
+		}
+	}
+
+	size_t size() const {
+		return count;
+	}
+
+	bool empty() const {
+		return 0 == count;
+	}
+
+	ValueType* find(const uint64_t key) {
+		for(size_t i = home(key); slots[i].used; i = (i + 1) & mask) {
+			if(slots[i].key == key) {
+				return &slots[i].value;
+			}
+		}
+
+		return NULL;
+	}
+
+	/** The value for key, a default value if key was not in the table */
+	ValueType& insert(const uint64_t key) {
+		if(2 * (count + 1) > slots.size()) {
+			rehash(2 * slots.size());
+		}
+
+		size_t i = home(key);
+
+		for(; slots[i].used; i = (i + 1) & mask) {
+			if(slots[i].key == key) {
+				return slots[i].value;
+			}
+		}
+
+		slots[i].key = key;
+		slots[i].used = true;
+		slots[i].value = ValueType();
+		count++;
+
+		return slots[i].value;
+	}
+
+	bool erase(const uint64_t key) {
+		size_t hole = home(key);
+
+		for(; slots[hole].used; hole = (hole + 1) & mask) {
+			if(slots[hole].key == key) {
+				break;
+			}
+		}
+
+		if(! slots[hole].used) {
+			return false;
+		}
+
+		// Move back every later entry of the run whose probe passes the hole
+		for(size_t next = (hole + 1) & mask; slots[next].used; next = (next + 1) & mask) {
+			const size_t want = home(slots[next].key);
+
+			if(((hole - want) & mask) < ((next - want) & mask)) {
+				std::swap(slots[hole], slots[next]);
+				hole = next;
+			}
+		}
+
+		slots[hole].used = false;
+		count--;
+
+		return true;
+	}
+
+private:
+	struct Slot {
+		Slot() : key(0), used(false), value() {}
+
+		uint64_t key;
+		bool used;
+		ValueType value;
+	};
+
+	size_t home(const uint64_t key) const {
+		// Request IDs are sequential, spread them over the table
+		return (size_t) ((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+	}
+
+	void rehash(const size_t capacity) {
+		std::vector<Slot> old(capacity);
+		old.swap(slots);
+		mask = slots.size() - 1;
+		count = 0;
+
+		for(size_t i = 0; i < old.size(); ++i) {
+			if(old[i].used) {
+				std::swap(insert(old[i].key), old[i].value);
+			}
+		}
+	}
+
+	std::vector<Slot> slots;
+	size_t mask;
+	size_t count;
+};
+
+}
+}
+
+#endif
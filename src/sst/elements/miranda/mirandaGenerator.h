@@ -39,7 +39,7 @@ typedef enum {
 
 class GeneratorRequest {
 public:
-	GeneratorRequest() {
+	GeneratorRequest() : outstandingDeps(0) {
 		reqID = nextGeneratorRequestID++;
 	}
 
@@ -47,8 +47,18 @@ public:
 	virtual ReqOperation getOperation() const = 0;
 	uint64_t getRequestID() const { return reqID; }
 
+	/*
+	 * This request issues once depReq has completed. The CPU resolves
+	 * dependencies when the generator queues the request, and depReq counts
+	 * as completed unless it is queued or in flight at that point, so a
+	 * generator should only name requests of the same or an earlier
+	 * generate() call. Retiring a fence completes it. Earlier releases kept
+	 * waiting on a request that had already completed, or on a fence, for
+	 * ever.
+	 */
 	void addDependency(uint64_t depReq) {
 		dependsOn.push_back(depReq);
+		outstandingDeps++;
 	}
 
 	void satisfyDependency(const GeneratorRequest* req) {
@@ -61,13 +71,24 @@ public:
 		for(searchDeps = dependsOn.begin(); searchDeps != dependsOn.end(); searchDeps++) {
 			if( req == (*searchDeps) ) {
 				dependsOn.erase(searchDeps);
+				outstandingDeps--;
 				break;
 			}
 		}
 	}
 
-	bool canIssue() {
-		return dependsOn.empty();
+	// Used by the CPU dependency graph, which already knows one of the
+	// requests this depends on has completed so does not search for it
+	void satisfyTrackedDependency() {
+		outstandingDeps--;
+	}
+
+	const std::vector<uint64_t>& getDependencies() const {
+		return dependsOn;
+	}
+
+	bool canIssue() const {
+		return 0 == outstandingDeps;
 	}
 
 	uint64_t getIssueTime() const {
@@ -81,6 +102,7 @@ protected:
 	uint64_t reqID;
 	uint64_t issueTime;
 	std::vector<uint64_t> dependsOn;
+	uint32_t outstandingDeps;
 private:
 	static std::atomic<uint64_t> nextGeneratorRequestID;
 };
@@ -106,7 +128,7 @@ public:
 //			curSize, newSize);
 
                	QueueType * newQ = (QueueType *) malloc(sizeof(QueueType) * newSize);
-               	for(uint32_t i = 0; i < curSize; ++i) {
+               	for(uint32_t i = 0; i < std::min(curSize, newSize); ++i) {
                        	newQ[i] = theQ[i];
                 }
 
@@ -128,41 +150,31 @@ public:
                	return theQ[index];
        	}
 
-       	void erase(const std::vector<uint32_t> eraseList) {
+	// Remove the entries at the (ascending) indices in eraseList, the
+	// entries that remain are slid down in place keeping their order
+       	void erase(const std::vector<uint32_t>& eraseList) {
 		if(0 == eraseList.size()) {
 			return;
 		}
 
-               	QueueType* newQ = (QueueType*) malloc(sizeof(QueueType) * maxCapacity);
-
                	uint32_t nextSkipIndex = 0;
-               	uint32_t nextSkip = eraseList.at(nextSkipIndex);
-                uint32_t nextNewQIndex = 0;
+                uint32_t nextNewQIndex = eraseList.at(0);
 
-               	for(uint32_t i = 0; i < curSize; ++i) {
-                       	if(nextSkip == i) {
+               	for(uint32_t i = eraseList.at(0); i < curSize; ++i) {
+                       	if(nextSkipIndex < eraseList.size() && eraseList[nextSkipIndex] == i) {
                                 nextSkipIndex++;
-
-                                if(nextSkipIndex >= eraseList.size()) {
-                                       	nextSkip = curSize;
-                               	} else {
-                                       	nextSkip = eraseList.at(nextSkipIndex);
-                                }
                        	} else {
-                               	newQ[nextNewQIndex] = theQ[i];
+                               	theQ[nextNewQIndex] = theQ[i];
                                 nextNewQIndex++;
                        	}
                	}
 
-                free(theQ);
-
-               	theQ = newQ;
 		curSize = nextNewQIndex;
         }
 
 	void push_back(QueueType t) {
                 if(curSize == maxCapacity) {
-                        resize(maxCapacity + 16);
+                        resize(maxCapacity * 2);
                 }
 
                 theQ[curSize] = t;
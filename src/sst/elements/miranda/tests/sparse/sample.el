@@ -0,0 +1,12 @@
+# Directed 8 vertex sample graph for the Miranda BFS and PageRank generators,
+# vertex 7 is not reachable from vertex 0
+0 1
+0 2
+1 3
+2 3
+2 4
+3 5
+4 5
+5 6
+6 4
+7 0
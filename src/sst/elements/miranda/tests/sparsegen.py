@@ -0,0 +1,69 @@
+import sst
+import sys
+
+# Runs one of the Miranda sparse generators over a small input on a single
+# core and writes the core's request counts to a CSV file:
+#
+#   sst sparsegen.py --model-options="<generator> <input> <stats file>"
+#
+# generator is one of CSRSpMVGenerator, SpGEMMGenerator, BFSGenerator or
+# PageRankGenerator. sparse/sample.mtx and sparse/sample.el are small inputs
+# whose request counts can be worked out by hand.
+
+if len(sys.argv) != 4:
+    sys.stderr.write("usage: sparsegen.py <generator> <input> <stats file>\n")
+    sys.exit(1)
+
+generator, inputFile, statsFile = sys.argv[1:4]
+
+cpu = sst.Component("cpu", "miranda.BaseCPU")
+cpu.addParams({
+	"verbose" : 0,
+	"clock" : "2GHz",
+	"printStats" : 1,
+})
+
+gen = cpu.setSubComponent("generator", "miranda." + generator)
+gen.addParams({
+	"input" : inputFile,
+	"iterations" : 1,
+	# a few requests per call so the kernels resume across calls
+	"batch_requests" : 4,
+})
+
+if generator == "BFSGenerator":
+	gen.addParams({ "source" : 0 })
+
+sst.setStatisticLoadLevel(4)
+sst.setStatisticOutput("sst.statOutputCSV", { "filepath" : statsFile, "separator" : "," })
+cpu.enableAllStatistics({"type":"sst.AccumulatorStatistic"})
+
+l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+l1cache.addParams({
+	"access_latency_cycles" : "2",
+	"cache_frequency" : "2 GHz",
+	"replacement_policy" : "lru",
+	"coherence_protocol" : "MESI",
+	"associativity" : "4",
+	"cache_line_size" : "64",
+	"L1" : "1",
+	"cache_size" : "32KB"
+})
+
+comp_memctrl = sst.Component("memory", "memHierarchy.MemController")
+comp_memctrl.addParams({
+	"clock" : "1GHz",
+	"addr_range_end" : 512 * 1024 * 1024 - 1
+})
+memory = comp_memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+	"access_time" : "100 ns",
+	"mem_size" : "512MiB",
+})
+
+cpu_cache_link = sst.Link("cpu_cache_link")
+cpu_cache_link.connect( (cpu, "cache_link", "1000ps"), (l1cache, "high_network_0", "1000ps") )
+cpu_cache_link.setNoCut()
+
+link_mem_link = sst.Link("link_mem_link")
+link_mem_link.connect( (l1cache, "low_network_0", "50ps"), (comp_memctrl, "direct_link", "50ps") )
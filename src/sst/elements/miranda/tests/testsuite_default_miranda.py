@@ -71,8 +71,86 @@ class testcase_miranda_Component(SSTTestCase):
     def test_miranda_gupsgen(self):
         self.miranda_test_template("gupsgen")
 
+    # Request counts over the sample inputs, worked out from each kernel's loop:
+    # n=8 rows and nnz=21 for sample.mtx (12 stored entries, symmetric), V=8
+    # vertices and E=10 edges for sample.el.
+
+    # 2 offset reads per row, column, value and x reads per non-zero, one y write per row
+    def test_miranda_sparse_spmv(self):
+        self.miranda_sparse_template("CSRSpMVGenerator", "sample.mtx", 2 * 8 + 3 * 21, 8)
+
+    # A*A has P=57 products (the sum of the squared row lengths) and 40 non-zeros.
+    # Reads: 2 A offsets per row, 4 per A entry (index, value, 2 B offsets),
+    # 2 per product plus an accumulator read for each one that is not the first
+    # of its column, one accumulator read per C entry. Writes: one accumulator
+    # write per product, index and value per C entry, one C offset per row.
+    def test_miranda_sparse_spgemm(self):
+        self.miranda_sparse_template("SpGEMMGenerator", "sample.mtx", 2 * 8 + 4 * 21 + 2 * 57 + (57 - 40) + 40, 57 + 2 * 40 + 8)
+
+    # From vertex 0 the search reaches 7 vertices over 9 edges. Reads: the queue
+    # entry and 2 offsets per vertex, the index and parent per edge. Writes:
+    # clearing the parents, seeding the source and queue, then a parent and
+    # queue write for each of the 6 vertices found.
+    def test_miranda_sparse_bfs(self):
+        self.miranda_sparse_template("BFSGenerator", "sample.el", 3 * 7 + 2 * 9, 8 + 2 + 2 * 6)
+
+    # Contribution: score and 2 out offsets read, contribution written per vertex.
+    # Pull: 2 in offsets, the old score and 2 per in-edge read, score written.
+    def test_miranda_sparse_pagerank(self):
+        self.miranda_sparse_template("PageRankGenerator", "sample.el", 3 * 8 + 3 * 8 + 2 * 10, 2 * 8)
+
+    def test_miranda_flattable_unit(self):
+        unitdir = "{0}/unit".format(self.get_testsuite_dir())
+        tmpdir = self.get_test_output_tmp_dir()
+
+        rtn = OSCommand("make testflattable", set_cwd=unitdir).run()
+        log_debug("Miranda flat table unit test make result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "Miranda flat table unit test failed to build")
+
+        rtn = OSCommand("{0}/testflattable".format(unitdir), set_cwd=tmpdir).run()
+        log_debug("Miranda flat table unit test result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "Miranda flat table unit test failed:\n{0}".format(rtn.output()))
+
 #####
 
+    def miranda_sparse_template(self, generator, inputfile, reads, writes, testtimeout=240):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        testDataFileName="test_miranda_sparse_{0}".format(generator)
+
+        sdlfile = "{0}/sparsegen.py".format(test_path)
+        inputpath = "{0}/sparse/{1}".format(test_path, inputfile)
+        statsfile = "{0}/{1}.csv".format(tmpdir, testDataFileName)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        otherargs = '--model-options="{0} {1} {2}"'.format(generator, inputpath, statsfile)
+
+        self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, set_cwd=tmpdir,
+                     mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+
+        cmd = 'grep "FATAL" {0} '.format(outfile)
+        grep_result = os.system(cmd) != 0
+        self.assertTrue(grep_result, "Output file {0} contains the word 'FATAL'...".format(outfile))
+
+        stats = dict()
+        with open(statsfile, 'r') as csv:
+            header = [ field.strip() for field in csv.readline().split(",") ]
+            nameCol = header.index("StatisticName")
+            sumCol = header.index("Sum.u64")
+            for line in csv:
+                fields = [ field.strip() for field in line.split(",") ]
+                if len(fields) > sumCol:
+                    stats[fields[nameCol]] = int(fields[sumCol])
+
+        # every array is aligned and every element is a power of two wide, nothing splits
+        self.assertEqual(stats.get("split_read_reqs", 0) + stats.get("split_write_reqs", 0), 0, "{0} split requests over a cache line".format(generator))
+        self.assertEqual(stats.get("read_reqs", -1), reads, "{0} issued {1} reads, expected {2}".format(generator, stats.get("read_reqs", -1), reads))
+        self.assertEqual(stats.get("write_reqs", -1), writes, "{0} issued {1} writes, expected {2}".format(generator, stats.get("write_reqs", -1), writes))
+
     def miranda_test_template(self, testcase, testtimeout=240):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
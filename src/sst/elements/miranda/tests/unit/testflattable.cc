@@ -0,0 +1,249 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Probe runs, wrap-around, backward-shift erase and rehash of the request ID table
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <iterator>
+#include <map>
+#include <vector>
+
+#include "mirandaFlatTable.h"
+
+using namespace SST::Miranda;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if ( ! (cond) ) { \
+            printf( "FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond ); \
+            failures++; \
+        } \
+    } while ( 0 )
+
+/* Home slot of a key in a table of the given number of slots, as the table hashes it */
+static size_t homeOf(uint64_t key, size_t slots)
+{
+    return (size_t) ((key * 0x9E3779B97F4A7C15ULL) >> 32) & (slots - 1);
+}
+
+/* The first count keys from start whose home in a 16 slot table is slot */
+static std::vector<uint64_t> keysAt(size_t slot, size_t count, uint64_t start = 1)
+{
+    std::vector<uint64_t> keys;
+    for ( uint64_t key = start; keys.size() < count; key++ ) {
+        if ( homeOf(key, 16) == slot ) {
+            keys.push_back(key);
+        }
+    }
+    return keys;
+}
+
+static void testInsertFind()
+{
+    MirandaFlatTable<int> table;
+
+    CHECK(table.empty());
+    CHECK(NULL == table.find(7));
+    CHECK(! table.erase(7));
+
+    table.insert(7) = 70;
+    table.insert(0) = 1;
+    CHECK(2 == table.size());
+    CHECK(NULL != table.find(7) && 70 == *table.find(7));
+    CHECK(NULL != table.find(0) && 1 == *table.find(0));
+
+    // inserting a present key returns its value untouched
+    CHECK(70 == table.insert(7));
+    CHECK(2 == table.size());
+
+    CHECK(table.erase(7));
+    CHECK(NULL == table.find(7));
+    CHECK(! table.erase(7));
+    CHECK(1 == table.size());
+
+    // a reinserted key starts from a default value
+    CHECK(0 == table.insert(7));
+}
+
+/* Keys sharing a home form one run, erasing from it must keep the rest reachable */
+static void testProbeRun()
+{
+    MirandaFlatTable<uint64_t> table;
+    const std::vector<uint64_t> keys = keysAt(5, 6);
+
+    for ( size_t i = 0; i < keys.size(); i++ ) {
+        table.insert(keys[i]) = keys[i] * 10;
+    }
+
+    // a key homed inside the run is placed after it
+    const std::vector<uint64_t> later = keysAt(7, 1);
+    table.insert(later[0]) = 1;
+
+    for ( size_t i = 0; i < keys.size(); i += 2 ) {
+        CHECK(table.erase(keys[i]));
+    }
+
+    for ( size_t i = 0; i < keys.size(); i++ ) {
+        uint64_t* value = table.find(keys[i]);
+        if ( 0 == i % 2 ) {
+            CHECK(NULL == value);
+        } else {
+            CHECK(NULL != value && keys[i] * 10 == *value);
+        }
+    }
+    CHECK(NULL != table.find(later[0]) && 1 == *table.find(later[0]));
+
+    // a miss still stops at the end of the shortened run
+    const std::vector<uint64_t> absent = keysAt(5, 1, keys.back() + 1);
+    CHECK(NULL == table.find(absent[0]));
+    CHECK(4 == table.size());
+}
+
+/* Runs that start in the last slots continue at slot 0 */
+static void testWrapAround()
+{
+    MirandaFlatTable<uint64_t> table;
+    const std::vector<uint64_t> last = keysAt(15, 3);
+    const std::vector<uint64_t> first = keysAt(0, 2);
+    const std::vector<uint64_t> second = keysAt(1, 1);
+
+    // occupies 15, 0 and 1, then the keys homed at 0 and 1 follow at 2, 3 and 4
+    for ( size_t i = 0; i < last.size(); i++ ) {
+        table.insert(last[i]) = last[i];
+    }
+    for ( size_t i = 0; i < first.size(); i++ ) {
+        table.insert(first[i]) = first[i];
+    }
+    table.insert(second[0]) = second[0];
+    CHECK(6 == table.size());
+
+    // erasing at slot 15 pulls entries back across the end of the array,
+    // but never ahead of their home
+    CHECK(table.erase(last[0]));
+    CHECK(table.erase(last[1]));
+
+    for ( size_t i = 0; i < first.size(); i++ ) {
+        CHECK(NULL != table.find(first[i]) && first[i] == *table.find(first[i]));
+    }
+    CHECK(NULL != table.find(second[0]) && second[0] == *table.find(second[0]));
+    CHECK(NULL != table.find(last[2]) && last[2] == *table.find(last[2]));
+    CHECK(NULL == table.find(last[0]));
+    CHECK(NULL == table.find(last[1]));
+
+    CHECK(table.erase(last[2]));
+    CHECK(table.erase(first[0]));
+    CHECK(NULL != table.find(first[1]) && first[1] == *table.find(first[1]));
+    CHECK(NULL != table.find(second[0]) && second[0] == *table.find(second[0]));
+    CHECK(2 == table.size());
+}
+
+/* Growing keeps every value, including ones that own memory */
+static void testRehash()
+{
+    MirandaFlatTable<std::vector<uint64_t> > table;
+
+    // past half of the 16 initial slots the table doubles
+    for ( uint64_t key = 100; key < 200; key++ ) {
+        std::vector<uint64_t>& waiting = table.insert(key);
+        for ( uint64_t i = 0; i < key % 5; i++ ) {
+            waiting.push_back(key + i);
+        }
+    }
+    CHECK(100 == table.size());
+
+    for ( uint64_t key = 100; key < 200; key++ ) {
+        std::vector<uint64_t>* waiting = table.find(key);
+        CHECK(NULL != waiting);
+        if ( NULL != waiting ) {
+            CHECK(key % 5 == waiting->size());
+            for ( size_t i = 0; i < waiting->size(); i++ ) {
+                CHECK(key + i == (*waiting)[i]);
+            }
+        }
+    }
+
+    // reserve grows a table ahead of use and never shrinks one
+    MirandaFlatTable<int> reserved;
+    reserved.insert(3) = 30;
+    reserved.reserve(1000);
+    reserved.reserve(1);
+    CHECK(1 == reserved.size());
+    CHECK(NULL != reserved.find(3) && 30 == *reserved.find(3));
+
+    int* stable = &reserved.insert(4);
+    for ( uint64_t key = 5; key < 1000; key++ ) {
+        reserved.insert(key) = (int) key;
+    }
+    // no rehash happened, so the entry is where it was
+    CHECK(stable == reserved.find(4));
+}
+
+/* Sequential IDs going in and out of a window, as the CPU uses the table */
+static void testAgainstMap()
+{
+    MirandaFlatTable<uint64_t> table;
+    std::map<uint64_t, uint64_t> reference;
+    uint64_t state = 12345;
+    uint64_t nextID = 0;
+
+    table.reserve(64);
+
+    for ( int step = 0; step < 200000; step++ ) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        const uint64_t r = state >> 33;
+
+        if ( reference.size() < 64 && (r % 3 != 0 || reference.empty()) ) {
+            table.insert(nextID) = nextID ^ 0x5555;
+            reference[nextID] = nextID ^ 0x5555;
+            nextID++;
+        } else {
+            // complete one of the oldest live requests, not always the oldest
+            std::map<uint64_t, uint64_t>::iterator victim = reference.begin();
+            std::advance(victim, (r >> 8) % (reference.size() > 4 ? reference.size() / 4 : reference.size()));
+            CHECK(table.erase(victim->first));
+            reference.erase(victim);
+        }
+
+        if ( 0 == step % 1000 ) {
+            CHECK(reference.size() == table.size());
+            for ( std::map<uint64_t, uint64_t>::iterator i = reference.begin(); i != reference.end(); i++ ) {
+                uint64_t* value = table.find(i->first);
+                CHECK(NULL != value && i->second == *value);
+            }
+            CHECK(NULL == table.find(nextID));
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    testInsertFind();
+    testProbeRun();
+    testWrapAround();
+    testRehash();
+    testAgainstMap();
+
+    if ( failures ) {
+        printf( "%d checks failed\n", failures );
+        return EXIT_FAILURE;
+    }
+
+    printf( "All flat table checks passed\n" );
+    return EXIT_SUCCESS;
+}
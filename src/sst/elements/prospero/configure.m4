@@ -5,6 +5,7 @@ AC_DEFUN([SST_prospero_CONFIG], [
   prospero_happy="yes"
 
   SST_CHECK_LIBZ()
+  SST_CHECK_ZSTD()
   SST_CHECK_PINTOOL([have_pin=1],[have_pin=0],[])
   SST_CHECK_SHM()
 
@@ -0,0 +1,243 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "prosasyncreader.h"
+
+#include <sstream>
+
+using namespace SST::Prospero;
+
+
+ProsperoAsyncTraceReader::ProsperoAsyncTraceReader( ComponentId_t id, Params& params, Output* out ) :
+	ProsperoTraceReader(id, params, out), head(0), headNext(0), acquired(false), finished(false), stopping(false) {
+
+	std::string traceFile = params.find<std::string>("file", "");
+	std::string formatName = params.find<std::string>("format", "auto");
+	blockRecords = (size_t) params.find<uint64_t>("blockrecords", 65536);
+	const uint32_t bufferCount = params.find<uint32_t>("buffers", 2);
+	const bool useMmap = params.find<bool>("mmap", true);
+	threaded = params.find<bool>("prefetch", true);
+
+	ProsperoTraceFormat format;
+	if(! prosperoParseFormat(formatName, format) || PROSPERO_FORMAT_TEXT == format) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: unknown trace format %s, must be auto, binary, compressed or block.\n",
+			getName().c_str(), formatName.c_str());
+	}
+
+	if(0 == blockRecords || 0 == bufferCount) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: blockrecords and buffers must both be at least 1.\n",
+			getName().c_str());
+	}
+
+	if(! traceInput.open(traceFile, format, useMmap)) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Error opening trace file: %s in async reader: %s.\n",
+			getName().c_str(), traceFile.c_str(), traceInput.getError().c_str());
+	}
+
+	selectBlocks(params);
+
+	output->verbose(CALL_INFO, 1, 0, "Reading %s trace %s%s, %" PRIu32 " buffers of %" PRIu64 " records, decoding on %s thread.\n",
+		prosperoFormatName(traceInput.getFormat()), traceFile.c_str(), traceInput.isMapped() ? " (mapped)" : "",
+		bufferCount, (uint64_t) blockRecords, threaded ? "a background" : "the simulation");
+
+	ring.resize(bufferCount);
+	for(uint32_t i = 0; i < bufferCount; ++i) {
+		ring[i].records.resize(blockRecords);
+		ring[i].count = 0;
+		ring[i].full = false;
+	}
+
+	if(threaded) {
+		decoder = std::thread(&ProsperoAsyncTraceReader::prefetch, this);
+	}
+}
+
+ProsperoAsyncTraceReader::~ProsperoAsyncTraceReader() {
+	if(decoder.joinable()) {
+		{
+			std::lock_guard<std::mutex> guard(ringLock);
+			stopping = true;
+		}
+
+		ringDrained.notify_all();
+		decoder.join();
+	}
+}
+
+void ProsperoAsyncTraceReader::selectBlocks(Params& params) {
+	const uint64_t startBlock = params.find<uint64_t>("startblock", 0);
+	const std::string skipBlocks = params.find<std::string>("skipblocks", "");
+	const uint64_t samplePeriod = params.find<uint64_t>("sampleperiod", 0);
+	const uint64_t sampleBlocks = params.find<uint64_t>("sampleblocks", 1);
+	const uint64_t maxBlocks = params.find<uint64_t>("maxblocks", 0);
+
+	if(0 == startBlock && skipBlocks.empty() && 0 == samplePeriod && 0 == maxBlocks) {
+		return;
+	}
+
+	if(PROSPERO_FORMAT_BLOCK != traceInput.getFormat()) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: startblock, skipblocks, sampleperiod and maxblocks need a block trace, convert the trace with sst-prospero-convert.\n",
+			getName().c_str());
+	}
+
+	const size_t blockCount = traceInput.getBlockCount();
+	std::vector<bool> skipped(blockCount, false);
+
+	// Ranges are inclusive, blocks past the end of the trace are ignored
+	std::stringstream skipList(skipBlocks);
+	std::string range;
+	while(std::getline(skipList, range, ',')) {
+		uint64_t first = 0;
+		uint64_t last = 0;
+
+		const int matched = sscanf(range.c_str(), "%" SCNu64 "-%" SCNu64, &first, &last);
+		if(1 == matched) {
+			last = first;
+		} else if(2 != matched || last < first) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: cannot parse block range \"%s\" in skipblocks.\n",
+				getName().c_str(), range.c_str());
+		}
+
+		for(uint64_t i = first; i <= last && i < blockCount; ++i) {
+			skipped[i] = true;
+		}
+	}
+
+	if(samplePeriod > 0 && (0 == sampleBlocks || sampleBlocks > samplePeriod)) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: sampleblocks must be between 1 and sampleperiod (%" PRIu64 ").\n",
+			getName().c_str(), samplePeriod);
+	}
+
+	std::vector<size_t> schedule;
+	uint64_t totalRecords = 0;
+	uint64_t selectedRecords = 0;
+
+	for(size_t i = 0; i < blockCount; ++i) {
+		totalRecords += traceInput.getBlock(i).records;
+
+		if(i < startBlock || skipped[i] || (0 != maxBlocks && schedule.size() == maxBlocks)) {
+			continue;
+		}
+
+		if(samplePeriod > 0 && ((i - startBlock) % samplePeriod) >= sampleBlocks) {
+			continue;
+		}
+
+		schedule.push_back(i);
+		selectedRecords += traceInput.getBlock(i).records;
+	}
+
+	if(! traceInput.setSchedule(schedule)) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: %s.\n", getName().c_str(), traceInput.getError().c_str());
+	}
+
+	// Totals measured over a sample have to be scaled up by the inverse of this fraction
+	output->output("%s: simulating %" PRIu64 " of %" PRIu64 " trace blocks (%" PRIu64 " of %" PRIu64 " records, fraction %f).\n",
+		getName().c_str(), (uint64_t) schedule.size(), (uint64_t) blockCount, selectedRecords, totalRecords,
+		(0 == totalRecords) ? 0.0 : ((double) selectedRecords) / ((double) totalRecords));
+}
+
+void ProsperoAsyncTraceReader::fill(ProsperoTraceBuffer& buffer) {
+	buffer.count = traceInput.read(buffer.records.data(), blockRecords);
+}
+
+void ProsperoAsyncTraceReader::prefetch() {
+	size_t next = 0;
+
+	while(true) {
+		ProsperoTraceBuffer& buffer = ring[next];
+
+		{
+			std::unique_lock<std::mutex> guard(ringLock);
+			ringDrained.wait(guard, [&] { return stopping || ! buffer.full; });
+
+			if(stopping) {
+				return;
+			}
+		}
+
+		// The buffer belongs to this thread until it is marked full
+		fill(buffer);
+		const bool last = (0 == buffer.count);
+
+		{
+			std::lock_guard<std::mutex> guard(ringLock);
+			buffer.full = true;
+		}
+
+		ringFilled.notify_one();
+
+		// An empty buffer marks the end of the trace (or an error) for the reader
+		if(last) {
+			return;
+		}
+
+		next = (next + 1) % ring.size();
+	}
+}
+
+ProsperoTraceEntry* ProsperoAsyncTraceReader::readNextEntry() {
+	if(finished) {
+		return NULL;
+	}
+
+	if(acquired && headNext == ring[head].count) {
+		if(threaded) {
+			{
+				std::lock_guard<std::mutex> guard(ringLock);
+				ring[head].full = false;
+			}
+
+			ringDrained.notify_one();
+		}
+
+		head = (head + 1) % ring.size();
+		acquired = false;
+	}
+
+	if(! acquired) {
+		if(threaded) {
+			std::unique_lock<std::mutex> guard(ringLock);
+			ringFilled.wait(guard, [&] { return ring[head].full; });
+		} else {
+			fill(ring[head]);
+		}
+
+		acquired = true;
+		headNext = 0;
+
+		if(0 == ring[head].count) {
+			finished = true;
+
+			if(traceInput.failed()) {
+				output->fatal(CALL_INFO, -1, "%s, Fatal: error reading trace: %s.\n",
+					getName().c_str(), traceInput.getError().c_str());
+			}
+
+			output->verbose(CALL_INFO, 2, 0, "End of trace file reached, returning empty request.\n");
+			return NULL;
+		}
+
+		output->verbose(CALL_INFO, 4, 0, "Switched to a buffer of %" PRIu64 " records.\n", (uint64_t) ring[head].count);
+	}
+
+	const ProsperoTraceRecord& record = ring[head].records[headNext++];
+
+	return new ProsperoTraceEntry(record.cycles, record.address,
+		record.length,
+		(record.op == 'R' || record.op == 'r') ? READ : WRITE);
+}
@@ -0,0 +1,102 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_ASYNC_READER
+#define _H_SST_PROSPERO_ASYNC_READER
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "prosreader.h"
+#include "prostracefile.h"
+
+namespace SST {
+namespace Prospero {
+
+/*
+ * Reads binary, compressed or block traces a block of records at a time.
+ * A background thread decodes blocks into a ring of buffers (two by default)
+ * so decompression overlaps the simulation, the simulation thread only
+ * hands out records from the buffer at the head of the ring.
+ *
+ * Block traces carry an index, so the reader can start at any block, leave
+ * out ranges of blocks or sample them systematically. The cycles of the
+ * blocks that are simulated are moved up to close the gaps.
+ */
+class ProsperoAsyncTraceReader : public ProsperoTraceReader {
+
+public:
+	ProsperoAsyncTraceReader( ComponentId_t id, Params& params, Output* out );
+	~ProsperoAsyncTraceReader();
+	ProsperoTraceEntry* readNextEntry();
+
+	SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+		ProsperoAsyncTraceReader,
+		"prospero",
+		"ProsperoAsyncTraceReader",
+		SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Binary, compressed or block trace reader that decodes ahead on a background thread",
+		SST::Prospero::ProsperoTraceReader
+	)
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "file", "Sets the file for the trace reader to use", "" },
+		{ "format", "Trace format [auto|binary|compressed|block], auto detects the format from the file contents", "auto" },
+		{ "blockrecords", "Records decoded into each buffer", "65536" },
+		{ "buffers", "Buffers in the ring, at least 2 to overlap decoding with simulation", "2" },
+		{ "prefetch", "Decode on a background thread (1) or on the simulation thread when a buffer runs out (0)", "1" },
+		{ "mmap", "Map uncompressed binary traces into memory instead of reading them", "1" },
+		{ "startblock", "Block of a block trace to start from", "0" },
+		{ "skipblocks", "Comma separated blocks or inclusive ranges of blocks (e.g. 10-19,42) of a block trace to leave out", "" },
+		{ "sampleperiod", "Systematic sampling of a block trace, simulate sampleblocks blocks out of every sampleperiod starting at startblock (0 to disable)", "0" },
+		{ "sampleblocks", "Blocks simulated in each sampling period", "1" },
+		{ "maxblocks", "Stop after simulating this many blocks of a block trace (0 for no limit)", "0" }
+	)
+
+private:
+	typedef struct {
+		std::vector<ProsperoTraceRecord> records;
+		size_t count;
+		bool full;
+	} ProsperoTraceBuffer;
+
+	void fill(ProsperoTraceBuffer& buffer);
+	void prefetch();
+	void selectBlocks(Params& params);
+
+	ProsperoTraceFile traceInput;
+	std::vector<ProsperoTraceBuffer> ring;
+	size_t blockRecords;
+	size_t head;
+	size_t headNext;
+	bool acquired;
+	bool finished;
+
+	bool threaded;
+	bool stopping;
+	std::mutex ringLock;
+	std::condition_variable ringFilled;
+	std::condition_variable ringDrained;
+	std::thread decoder;
+
+};
+
+}
+}
+
+#endif
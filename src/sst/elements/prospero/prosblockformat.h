@@ -0,0 +1,336 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_BLOCK_FORMAT
+#define _H_SST_PROSPERO_BLOCK_FORMAT
+
+#include <stdint.h>
+#include <cstring>
+#include <vector>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+#ifdef HAVE_LIBZSTD
+#include <zstd.h>
+#endif
+
+/*
+ * Block trace format, as written by sst-prospero-convert:
+ *
+ *   file header   "PROSBLK" and a NUL, uint32 version, uint32 codec,
+ *                 uint32 records per block, uint32 reserved
+ *   each block    a ProsperoBlockHeader, then the encoded payload
+ *   block index   one ProsperoBlockIndexEntry per block
+ *   footer        uint64 offset of the index, uint64 block count, "PROSIDX"
+ *                 and a NUL
+ *
+ * A decoded payload is columnar: uint32 bytes of the cycle column, uint32
+ * bytes of the address column, then the cycle column (zig-zag varint deltas
+ * from the previous cycle, starting from the block's first cycle), one
+ * operation character per record, the address column (zig-zag varint deltas
+ * from the previous address, starting from 0) and the length column
+ * (varints). Every block decodes on its own, so a
+ * reader can start at any block found in the index. Integers outside the
+ * varint columns are in host byte order, as in the binary trace.
+ */
+
+#define PROSPERO_BLOCK_MAGIC          "PROSBLK"
+#define PROSPERO_BLOCK_MAGIC_LENGTH   8
+#define PROSPERO_BLOCK_VERSION        1
+#define PROSPERO_INDEX_MAGIC          "PROSIDX"
+#define PROSPERO_RECORD_LENGTH        (sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t))
+
+namespace SST {
+namespace Prospero {
+
+typedef enum {
+	PROSPERO_CODEC_NONE = 0,
+	PROSPERO_CODEC_ZLIB = 1,
+	PROSPERO_CODEC_ZSTD = 2
+} ProsperoBlockCodecType;
+
+typedef struct {
+	char     magic[PROSPERO_BLOCK_MAGIC_LENGTH];
+	uint32_t version;
+	uint32_t codec;
+	uint32_t blockRecords;
+	uint32_t reserved;
+} ProsperoBlockFileHeader;
+
+typedef struct {
+	uint32_t records;
+	uint32_t encodedBytes;
+	uint32_t rawBytes;
+	uint32_t reserved;
+	uint64_t firstCycle;
+} ProsperoBlockHeader;
+
+typedef struct {
+	uint64_t offset;
+	uint64_t firstRecord;
+	uint64_t firstCycle;
+	uint32_t records;
+	uint32_t reserved;
+} ProsperoBlockIndexEntry;
+
+typedef struct {
+	uint64_t indexOffset;
+	uint64_t blockCount;
+	char     magic[PROSPERO_BLOCK_MAGIC_LENGTH];
+} ProsperoBlockFooter;
+
+/* A decoded trace record, the same fields as ProsperoTraceEntry without the allocation */
+typedef struct {
+	uint64_t cycles;
+	uint64_t address;
+	uint32_t length;
+	char     op;
+} ProsperoTraceRecord;
+
+class ProsperoBlockCodec {
+public:
+	static bool available(const uint32_t codec) {
+		switch(codec) {
+		case PROSPERO_CODEC_NONE:
+			return true;
+#ifdef HAVE_LIBZ
+		case PROSPERO_CODEC_ZLIB:
+			return true;
+#endif
+#ifdef HAVE_LIBZSTD
+		case PROSPERO_CODEC_ZSTD:
+			return true;
+#endif
+		default:
+			return false;
+		}
+	}
+
+	static const char* name(const uint32_t codec) {
+		switch(codec) {
+		case PROSPERO_CODEC_NONE: return "none";
+		case PROSPERO_CODEC_ZLIB: return "zlib";
+		case PROSPERO_CODEC_ZSTD: return "zstd";
+		default:                  return "unknown";
+		}
+	}
+
+	/** Compress raw into encoded, level 0 selects the codec's default */
+	static bool encode(const uint32_t codec, const int level,
+		const std::vector<char>& raw, std::vector<char>& encoded) {
+
+		// Only zlib and zstd take a level
+		(void) level;
+
+		switch(codec) {
+		case PROSPERO_CODEC_NONE:
+			encoded = raw;
+			return true;
+#ifdef HAVE_LIBZ
+		case PROSPERO_CODEC_ZLIB:
+			{
+				uLongf encodedLen = compressBound((uLong) raw.size());
+				encoded.resize(encodedLen);
+				if(Z_OK != compress2((Bytef*) &encoded[0], &encodedLen, (const Bytef*) raw.data(),
+					(uLong) raw.size(), (0 == level) ? Z_DEFAULT_COMPRESSION : level)) {
+					return false;
+				}
+				encoded.resize(encodedLen);
+				return true;
+			}
+#endif
+#ifdef HAVE_LIBZSTD
+		case PROSPERO_CODEC_ZSTD:
+			{
+				encoded.resize(ZSTD_compressBound(raw.size()));
+				const size_t encodedLen = ZSTD_compress(&encoded[0], encoded.size(), raw.data(), raw.size(), level);
+				if(ZSTD_isError(encodedLen)) {
+					return false;
+				}
+				encoded.resize(encodedLen);
+				return true;
+			}
+#endif
+		default:
+			return false;
+		}
+	}
+
+	/** Decompress exactly rawBytes into raw */
+	static bool decode(const uint32_t codec, const char* encoded, const size_t encodedBytes,
+		char* raw, const size_t rawBytes) {
+
+		switch(codec) {
+		case PROSPERO_CODEC_NONE:
+			if(encodedBytes != rawBytes) {
+				return false;
+			}
+			std::memcpy(raw, encoded, rawBytes);
+			return true;
+#ifdef HAVE_LIBZ
+		case PROSPERO_CODEC_ZLIB:
+			{
+				uLongf rawLen = (uLongf) rawBytes;
+				return Z_OK == uncompress((Bytef*) raw, &rawLen, (const Bytef*) encoded, (uLong) encodedBytes) &&
+					rawLen == rawBytes;
+			}
+#endif
+#ifdef HAVE_LIBZSTD
+		case PROSPERO_CODEC_ZSTD:
+			{
+				const size_t rawLen = ZSTD_decompress(raw, rawBytes, encoded, encodedBytes);
+				return !ZSTD_isError(rawLen) && rawLen == rawBytes;
+			}
+#endif
+		default:
+			return false;
+		}
+	}
+
+	/** Pack records into the binary trace layout */
+	static void pack(const ProsperoTraceRecord& record, char* target) {
+		std::memcpy(target, &record.cycles, sizeof(uint64_t));
+		target[sizeof(uint64_t)] = record.op;
+		std::memcpy(target + sizeof(uint64_t) + sizeof(char), &record.address, sizeof(uint64_t));
+		std::memcpy(target + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), &record.length, sizeof(uint32_t));
+	}
+
+	static void unpack(const char* source, ProsperoTraceRecord& record) {
+		std::memcpy(&record.cycles, source, sizeof(uint64_t));
+		record.op = source[sizeof(uint64_t)];
+		std::memcpy(&record.address, source + sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+		std::memcpy(&record.length, source + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+	}
+
+	/** Build the columnar payload of a block */
+	static void packColumns(const ProsperoTraceRecord* records, const size_t count, std::vector<char>& raw) {
+		std::vector<char> cycles;
+		std::vector<char> addresses;
+		std::vector<char> lengths;
+
+		uint64_t lastCycle = (count > 0) ? records[0].cycles : 0;
+		uint64_t lastAddress = 0;
+
+		for(size_t i = 0; i < count; ++i) {
+			putVarint(cycles, zigzag((int64_t) (records[i].cycles - lastCycle)));
+			putVarint(addresses, zigzag((int64_t) (records[i].address - lastAddress)));
+			putVarint(lengths, records[i].length);
+			lastCycle = records[i].cycles;
+			lastAddress = records[i].address;
+		}
+
+		const uint32_t cycleBytes = (uint32_t) cycles.size();
+		const uint32_t addressBytes = (uint32_t) addresses.size();
+
+		raw.resize(2 * sizeof(uint32_t));
+		std::memcpy(&raw[0], &cycleBytes, sizeof(uint32_t));
+		std::memcpy(&raw[sizeof(uint32_t)], &addressBytes, sizeof(uint32_t));
+
+		raw.insert(raw.end(), cycles.begin(), cycles.end());
+		for(size_t i = 0; i < count; ++i) {
+			raw.push_back(records[i].op);
+		}
+		raw.insert(raw.end(), addresses.begin(), addresses.end());
+		raw.insert(raw.end(), lengths.begin(), lengths.end());
+	}
+
+	/** Decode a columnar payload, false if it does not hold exactly count records */
+	static bool unpackColumns(const char* raw, const size_t rawBytes, const uint64_t firstCycle,
+		ProsperoTraceRecord* records, const size_t count) {
+
+		uint32_t cycleBytes = 0;
+		uint32_t addressBytes = 0;
+
+		if(rawBytes < 2 * sizeof(uint32_t)) {
+			return false;
+		}
+
+		std::memcpy(&cycleBytes, raw, sizeof(uint32_t));
+		std::memcpy(&addressBytes, raw + sizeof(uint32_t), sizeof(uint32_t));
+
+		const char* cyclePos = raw + 2 * sizeof(uint32_t);
+		const char* opPos = cyclePos + cycleBytes;
+		const char* addressPos = opPos + count;
+		const char* lengthPos = addressPos + addressBytes;
+		const char* end = raw + rawBytes;
+
+		if((size_t) (end - cyclePos) < (size_t) cycleBytes + count + addressBytes) {
+			return false;
+		}
+
+		uint64_t lastCycle = firstCycle;
+		uint64_t lastAddress = 0;
+
+		for(size_t i = 0; i < count; ++i) {
+			uint64_t cycleDelta, addressDelta, length;
+
+			if(! getVarint(cyclePos, opPos, cycleDelta) ||
+				! getVarint(addressPos, lengthPos, addressDelta) ||
+				! getVarint(lengthPos, end, length)) {
+				return false;
+			}
+
+			lastCycle += (uint64_t) unzigzag(cycleDelta);
+			records[i].cycles = lastCycle;
+			records[i].op = opPos[i];
+			lastAddress += (uint64_t) unzigzag(addressDelta);
+			records[i].address = lastAddress;
+			records[i].length = (uint32_t) length;
+		}
+
+		return lengthPos == end;
+	}
+
+private:
+	static uint64_t zigzag(const int64_t value) {
+		return (((uint64_t) value) << 1) ^ (uint64_t) (value >> 63);
+	}
+
+	static int64_t unzigzag(const uint64_t value) {
+		return (int64_t) (value >> 1) ^ -((int64_t) (value & 1));
+	}
+
+	static void putVarint(std::vector<char>& target, uint64_t value) {
+		while(value >= 0x80) {
+			target.push_back((char) ((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+
+		target.push_back((char) value);
+	}
+
+	static bool getVarint(const char*& pos, const char* end, uint64_t& value) {
+		value = 0;
+
+		for(uint32_t shift = 0; shift < 64 && pos < end; shift += 7) {
+			const uint8_t next = (uint8_t) *pos++;
+			value |= ((uint64_t) (next & 0x7F)) << shift;
+
+			if(0 == (next & 0x80)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+};
+
+}
+}
+
+#endif
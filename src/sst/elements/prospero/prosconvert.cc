@@ -0,0 +1,173 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <string>
+#include <vector>
+
+#include "prostracefile.h"
+
+using namespace SST::Prospero;
+
+void printUsage() {
+	printf("sst-prospero-convert [options] <input trace> <output trace>\n");
+	printf("sst-prospero-convert --index <block trace>\n");
+	printf("\n");
+	printf("Options:\n");
+	printf("  -i <format>   Input <format> = {auto, text, binary, compressed, block}, default auto\n");
+	printf("  -f <format>   Output <format> = {text, binary, compressed, block}, default block\n");
+	printf("  -c <codec>    Block codec = {none, zlib, zstd}, default zstd when available, otherwise zlib\n");
+	printf("  -l <level>    Codec compression level, default is the codec's own default\n");
+	printf("  -b <records>  Records per block, default 65536\n");
+	printf("  --index       List the blocks of a block trace\n");
+	printf("\n");
+	printf("Codecs available in this build:");
+	for(uint32_t codec = PROSPERO_CODEC_NONE; codec <= PROSPERO_CODEC_ZSTD; codec++) {
+		if(ProsperoBlockCodec::available(codec)) {
+			printf(" %s", ProsperoBlockCodec::name(codec));
+		}
+	}
+	printf("\n");
+}
+
+int main(int argc, char* argv[]) {
+	ProsperoTraceFormat inFormat = PROSPERO_FORMAT_AUTO;
+	ProsperoTraceFormat outFormat = PROSPERO_FORMAT_BLOCK;
+	uint32_t codec = ProsperoBlockCodec::available(PROSPERO_CODEC_ZSTD) ? PROSPERO_CODEC_ZSTD :
+		(ProsperoBlockCodec::available(PROSPERO_CODEC_ZLIB) ? PROSPERO_CODEC_ZLIB : PROSPERO_CODEC_NONE);
+	int level = 0;
+	uint32_t blockRecords = 65536;
+	bool listIndex = false;
+	std::vector<std::string> files;
+
+	for(int i = 1; i < argc; i++) {
+		const bool hasValue = (i + 1 < argc);
+
+		if(std::strcmp(argv[i], "--help") == 0 ||
+			std::strcmp(argv[i], "-help") == 0 ||
+			std::strcmp(argv[i], "-h") == 0) {
+
+			printUsage();
+			exit(0);
+		} else if(std::strcmp(argv[i], "--index") == 0) {
+			listIndex = true;
+		} else if(std::strcmp(argv[i], "-i") == 0 && hasValue) {
+			if(! prosperoParseFormat(argv[++i], inFormat)) {
+				fprintf(stderr, "Error: unknown input format %s\n", argv[i]);
+				exit(-1);
+			}
+		} else if(std::strcmp(argv[i], "-f") == 0 && hasValue) {
+			if(! prosperoParseFormat(argv[++i], outFormat) || PROSPERO_FORMAT_AUTO == outFormat) {
+				fprintf(stderr, "Error: unknown output format %s\n", argv[i]);
+				exit(-1);
+			}
+		} else if(std::strcmp(argv[i], "-c") == 0 && hasValue) {
+			i++;
+			if(std::strcmp(argv[i], "none") == 0) {
+				codec = PROSPERO_CODEC_NONE;
+			} else if(std::strcmp(argv[i], "zlib") == 0) {
+				codec = PROSPERO_CODEC_ZLIB;
+			} else if(std::strcmp(argv[i], "zstd") == 0) {
+				codec = PROSPERO_CODEC_ZSTD;
+			} else {
+				fprintf(stderr, "Error: unknown codec %s\n", argv[i]);
+				exit(-1);
+			}
+		} else if(std::strcmp(argv[i], "-l") == 0 && hasValue) {
+			level = atoi(argv[++i]);
+		} else if(std::strcmp(argv[i], "-b") == 0 && hasValue) {
+			blockRecords = (uint32_t) strtoul(argv[++i], NULL, 10);
+		} else if(argv[i][0] == '-') {
+			fprintf(stderr, "Error: unknown option %s\n", argv[i]);
+			printUsage();
+			exit(-1);
+		} else {
+			files.push_back(argv[i]);
+		}
+	}
+
+	if(listIndex && files.size() == 1) {
+		ProsperoTraceFile input;
+		if(! input.open(files[0], PROSPERO_FORMAT_BLOCK, false)) {
+			fprintf(stderr, "Error: %s\n", input.getError().c_str());
+			exit(-1);
+		}
+
+		printf("%-10s %-20s %-20s %-20s %-10s\n", "Block", "Offset", "First Record", "First Cycle", "Records");
+		for(size_t i = 0; i < input.getBlockCount(); ++i) {
+			const ProsperoBlockIndexEntry& block = input.getBlock(i);
+			printf("%-10" PRIu64 " %-20" PRIu64 " %-20" PRIu64 " %-20" PRIu64 " %-10" PRIu32 "\n",
+				(uint64_t) i, block.offset, block.firstRecord, block.firstCycle, block.records);
+		}
+
+		return 0;
+	}
+
+	if(files.size() != 2) {
+		printUsage();
+		exit(-1);
+	}
+
+	ProsperoTraceFile input;
+	if(! input.open(files[0], inFormat, true)) {
+		fprintf(stderr, "Error: %s\n", input.getError().c_str());
+		exit(-1);
+	}
+
+	ProsperoTraceFileWriter output;
+	if(! output.open(files[1], outFormat, codec, level, blockRecords)) {
+		fprintf(stderr, "Error: %s\n", output.getError().c_str());
+		exit(-1);
+	}
+
+	std::vector<ProsperoTraceRecord> records(65536);
+	uint64_t converted = 0;
+	size_t count = 0;
+
+	while((count = input.read(records.data(), records.size())) > 0) {
+		for(size_t i = 0; i < count; ++i) {
+			if(! output.write(records[i])) {
+				fprintf(stderr, "Error: writing %s: %s\n", files[1].c_str(), output.getError().c_str());
+				exit(-1);
+			}
+		}
+
+		converted += count;
+	}
+
+	if(input.failed()) {
+		fprintf(stderr, "Error: reading %s: %s\n", files[0].c_str(), input.getError().c_str());
+		exit(-1);
+	}
+
+	if(! output.close()) {
+		fprintf(stderr, "Error: closing %s: %s\n", files[1].c_str(), output.getError().c_str());
+		exit(-1);
+	}
+
+	printf("Converted %" PRIu64 " records from %s (%s) to %s (%s%s%s)\n", converted,
+		files[0].c_str(), prosperoFormatName(input.getFormat()),
+		files[1].c_str(), prosperoFormatName(outFormat),
+		(PROSPERO_FORMAT_BLOCK == outFormat) ? ", " : "",
+		(PROSPERO_FORMAT_BLOCK == outFormat) ? ProsperoBlockCodec::name(codec) : "");
+
+	return 0;
+}
@@ -0,0 +1,622 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "prostracefile.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace SST::Prospero;
+
+bool SST::Prospero::prosperoParseFormat(const std::string& name, ProsperoTraceFormat& format) {
+	if(name == "auto") {
+		format = PROSPERO_FORMAT_AUTO;
+	} else if(name == "text") {
+		format = PROSPERO_FORMAT_TEXT;
+	} else if(name == "binary") {
+		format = PROSPERO_FORMAT_BINARY;
+	} else if(name == "compressed") {
+		format = PROSPERO_FORMAT_COMPRESSED;
+	} else if(name == "block") {
+		format = PROSPERO_FORMAT_BLOCK;
+	} else {
+		return false;
+	}
+
+	return true;
+}
+
+const char* SST::Prospero::prosperoFormatName(const ProsperoTraceFormat format) {
+	switch(format) {
+	case PROSPERO_FORMAT_AUTO:       return "auto";
+	case PROSPERO_FORMAT_TEXT:       return "text";
+	case PROSPERO_FORMAT_BINARY:     return "binary";
+	case PROSPERO_FORMAT_COMPRESSED: return "compressed";
+	case PROSPERO_FORMAT_BLOCK:      return "block";
+	default:                         return "unknown";
+	}
+}
+
+ProsperoTraceFile::ProsperoTraceFile() :
+	format(PROSPERO_FORMAT_AUTO), traceInput(NULL),
+#ifdef HAVE_LIBZ
+	traceInputZ(NULL),
+#endif
+	mapped(NULL), mappedBytes(0), mappedOffset(0), scheduleNext(0), lastBlock(0), cycleShift(0), blockNext(0) {
+
+	std::memset(&header, 0, sizeof(header));
+}
+
+ProsperoTraceFile::~ProsperoTraceFile() {
+	if(NULL != mapped) {
+		munmap((void*) mapped, mappedBytes);
+	}
+
+	if(NULL != traceInput) {
+		fclose(traceInput);
+	}
+
+#ifdef HAVE_LIBZ
+	if(NULL != traceInputZ) {
+		gzclose(traceInputZ);
+	}
+#endif
+}
+
+void ProsperoTraceFile::fail(const std::string& message) {
+	if(error.empty()) {
+		error = message;
+	}
+}
+
+bool ProsperoTraceFile::open(const std::string& path, ProsperoTraceFormat requested, bool useMmap) {
+	format = requested;
+
+	if(PROSPERO_FORMAT_AUTO == format) {
+		FILE* probe = fopen(path.c_str(), "rb");
+
+		if(NULL == probe) {
+			fail("unable to open " + path);
+			return false;
+		}
+
+		char magic[PROSPERO_BLOCK_MAGIC_LENGTH];
+		const size_t magicLen = fread(magic, 1, sizeof(magic), probe);
+		fclose(probe);
+
+		if(magicLen == sizeof(magic) && 0 == std::memcmp(magic, PROSPERO_BLOCK_MAGIC, sizeof(magic))) {
+			format = PROSPERO_FORMAT_BLOCK;
+		} else if(magicLen >= 2 && (unsigned char) magic[0] == 0x1f && (unsigned char) magic[1] == 0x8b) {
+			format = PROSPERO_FORMAT_COMPRESSED;
+		} else {
+			format = PROSPERO_FORMAT_BINARY;
+		}
+	}
+
+	switch(format) {
+	case PROSPERO_FORMAT_TEXT:
+		traceInput = fopen(path.c_str(), "rt");
+		break;
+
+	case PROSPERO_FORMAT_COMPRESSED:
+#ifdef HAVE_LIBZ
+		traceInputZ = gzopen(path.c_str(), "rb");
+		if(NULL == traceInputZ) {
+			fail("zlib was unable to open " + path);
+			return false;
+		}
+		// A larger inflate window than the 8KB default, blocks are read in bulk
+		gzbuffer(traceInputZ, 256 * 1024);
+		return true;
+#else
+		fail(path + " is a compressed trace but zlib was not found when this was built");
+		return false;
+#endif
+
+	case PROSPERO_FORMAT_BINARY:
+		if(useMmap) {
+			const int fd = ::open(path.c_str(), O_RDONLY);
+			struct stat fileInfo;
+
+			if(fd >= 0 && 0 == fstat(fd, &fileInfo) && fileInfo.st_size > 0) {
+				void* region = mmap(NULL, (size_t) fileInfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+				if(MAP_FAILED != region) {
+					madvise(region, (size_t) fileInfo.st_size, MADV_SEQUENTIAL);
+					mapped = (const char*) region;
+					mappedBytes = (size_t) fileInfo.st_size;
+				}
+			}
+
+			if(fd >= 0) {
+				::close(fd);
+			}
+
+			// Anything that cannot be mapped (including empty files) falls back to stdio
+			if(NULL != mapped) {
+				return true;
+			}
+		}
+
+		traceInput = fopen(path.c_str(), "rb");
+		break;
+
+	case PROSPERO_FORMAT_BLOCK:
+		traceInput = fopen(path.c_str(), "rb");
+
+		if(NULL != traceInput) {
+			if(1 != fread(&header, sizeof(header), 1, traceInput) ||
+				0 != std::memcmp(header.magic, PROSPERO_BLOCK_MAGIC, PROSPERO_BLOCK_MAGIC_LENGTH)) {
+				fail(path + " is not a Prospero block trace");
+				return false;
+			}
+
+			if(header.version != PROSPERO_BLOCK_VERSION) {
+				fail(path + " has an unsupported block trace version");
+				return false;
+			}
+
+			if(! ProsperoBlockCodec::available(header.codec)) {
+				fail(path + " uses the " + ProsperoBlockCodec::name(header.codec) +
+					" codec which was not found when this was built");
+				return false;
+			}
+
+			if(! loadIndex()) {
+				fail(path + " has a damaged block index");
+				return false;
+			}
+
+			// Read every block unless told otherwise
+			schedule.resize(index.size());
+			for(size_t i = 0; i < index.size(); ++i) {
+				schedule[i] = i;
+			}
+		}
+		break;
+
+	default:
+		fail("unknown trace format");
+		return false;
+	}
+
+	if(NULL == traceInput) {
+		fail("unable to open " + path);
+		return false;
+	}
+
+	return true;
+}
+
+size_t ProsperoTraceFile::read(ProsperoTraceRecord* records, const size_t maxRecords) {
+	if(failed() || 0 == maxRecords) {
+		return 0;
+	}
+
+	switch(format) {
+	case PROSPERO_FORMAT_TEXT:
+		return readText(records, maxRecords);
+	case PROSPERO_FORMAT_BLOCK:
+		return readBlocks(records, maxRecords);
+	default:
+		return (NULL != mapped) ? readMapped(records, maxRecords) : readStream(records, maxRecords);
+	}
+}
+
+size_t ProsperoTraceFile::readText(ProsperoTraceRecord* records, const size_t maxRecords) {
+	size_t count = 0;
+
+	while(count < maxRecords) {
+		ProsperoTraceRecord& next = records[count];
+
+		if(4 != fscanf(traceInput, "%" SCNu64 " %c %" SCNu64 " %" SCNu32 "",
+			&next.cycles, &next.op, &next.address, &next.length)) {
+			break;
+		}
+
+		count++;
+	}
+
+	return count;
+}
+
+size_t ProsperoTraceFile::readStream(ProsperoTraceRecord* records, const size_t maxRecords) {
+	staging.resize(maxRecords * PROSPERO_RECORD_LENGTH);
+	size_t bytesRead = 0;
+
+	// Both readers stop at a partial trailing record, as the per-record readers do
+#ifdef HAVE_LIBZ
+	if(NULL != traceInputZ) {
+		while(bytesRead < staging.size()) {
+			const int chunk = gzread(traceInputZ, &staging[bytesRead], (unsigned int) (staging.size() - bytesRead));
+
+			if(chunk <= 0) {
+				break;
+			}
+
+			bytesRead += (size_t) chunk;
+		}
+	} else
+#endif
+	{
+		bytesRead = fread(&staging[0], 1, staging.size(), traceInput);
+	}
+
+	const size_t count = bytesRead / PROSPERO_RECORD_LENGTH;
+
+	for(size_t i = 0; i < count; ++i) {
+		ProsperoBlockCodec::unpack(&staging[i * PROSPERO_RECORD_LENGTH], records[i]);
+	}
+
+	return count;
+}
+
+size_t ProsperoTraceFile::readMapped(ProsperoTraceRecord* records, const size_t maxRecords) {
+	size_t count = (mappedBytes - mappedOffset) / PROSPERO_RECORD_LENGTH;
+
+	if(count > maxRecords) {
+		count = maxRecords;
+	}
+
+	for(size_t i = 0; i < count; ++i) {
+		ProsperoBlockCodec::unpack(mapped + mappedOffset, records[i]);
+		mappedOffset += PROSPERO_RECORD_LENGTH;
+	}
+
+	return count;
+}
+
+bool ProsperoTraceFile::loadIndex() {
+	if(0 != fseeko(traceInput, 0, SEEK_END)) {
+		return false;
+	}
+
+	const uint64_t fileBytes = (uint64_t) ftello(traceInput);
+	const uint64_t firstBlock = sizeof(ProsperoBlockFileHeader);
+	ProsperoBlockFooter footer;
+
+	bool indexed = fileBytes >= firstBlock + sizeof(footer) &&
+		0 == fseeko(traceInput, (off_t) (fileBytes - sizeof(footer)), SEEK_SET) &&
+		1 == fread(&footer, sizeof(footer), 1, traceInput) &&
+		0 == std::memcmp(footer.magic, PROSPERO_INDEX_MAGIC, PROSPERO_BLOCK_MAGIC_LENGTH);
+
+	if(indexed) {
+		if(footer.indexOffset < firstBlock ||
+			footer.indexOffset + footer.blockCount * sizeof(ProsperoBlockIndexEntry) + sizeof(footer) != fileBytes) {
+			return false;
+		}
+
+		index.resize(footer.blockCount);
+
+		if(0 != fseeko(traceInput, (off_t) footer.indexOffset, SEEK_SET) ||
+			(index.size() > 0 && 1 != fread(&index[0], sizeof(ProsperoBlockIndexEntry) * index.size(), 1, traceInput))) {
+			return false;
+		}
+	} else if(! scanIndex(fileBytes)) {
+		return false;
+	}
+
+	return 0 == fseeko(traceInput, (off_t) firstBlock, SEEK_SET);
+}
+
+bool ProsperoTraceFile::scanIndex(const uint64_t fileBytes) {
+	// Without a footer (the writer did not finish) rebuild the index from the block headers
+	uint64_t offset = sizeof(ProsperoBlockFileHeader);
+	uint64_t firstRecord = 0;
+	ProsperoBlockHeader blockHeader;
+
+	index.clear();
+
+	while(offset + sizeof(blockHeader) <= fileBytes) {
+		if(0 != fseeko(traceInput, (off_t) offset, SEEK_SET) ||
+			1 != fread(&blockHeader, sizeof(blockHeader), 1, traceInput)) {
+			return false;
+		}
+
+		// A partly written last block is dropped
+		if(offset + sizeof(blockHeader) + blockHeader.encodedBytes > fileBytes) {
+			break;
+		}
+
+		ProsperoBlockIndexEntry entry;
+		entry.offset = offset;
+		entry.firstRecord = firstRecord;
+		entry.firstCycle = blockHeader.firstCycle;
+		entry.records = blockHeader.records;
+		entry.reserved = 0;
+		index.push_back(entry);
+
+		offset += sizeof(blockHeader) + blockHeader.encodedBytes;
+		firstRecord += blockHeader.records;
+	}
+
+	return true;
+}
+
+bool ProsperoTraceFile::setSchedule(const std::vector<size_t>& blocks) {
+	for(size_t i = 0; i < blocks.size(); ++i) {
+		if(blocks[i] >= index.size() || (i > 0 && blocks[i] <= blocks[i - 1])) {
+			fail("block schedule is out of range or not in increasing order");
+			return false;
+		}
+	}
+
+	schedule = blocks;
+	scheduleNext = 0;
+	return true;
+}
+
+bool ProsperoTraceFile::nextBlock() {
+	if(scheduleNext == schedule.size()) {
+		return false;
+	}
+
+	const size_t next = schedule[scheduleNext];
+	const bool contiguous = (scheduleNext > 0) && (next == lastBlock + 1);
+
+	if(! contiguous) {
+		// Take out the time covered by the blocks that are skipped
+		const size_t skippedFrom = (scheduleNext > 0) ? lastBlock + 1 : 0;
+
+		if(next > skippedFrom) {
+			cycleShift += index[next].firstCycle - index[skippedFrom].firstCycle;
+		}
+
+		if(0 != fseeko(traceInput, (off_t) index[next].offset, SEEK_SET)) {
+			fail("unable to seek to a block");
+			return false;
+		}
+	}
+
+	scheduleNext++;
+	lastBlock = next;
+
+	ProsperoBlockHeader blockHeader;
+
+	if(1 != fread(&blockHeader, sizeof(blockHeader), 1, traceInput)) {
+		fail("block trace is truncated");
+		return false;
+	}
+
+	encoded.resize(blockHeader.encodedBytes);
+	decoded.resize(blockHeader.rawBytes);
+	block.resize(blockHeader.records);
+
+	if(blockHeader.encodedBytes > 0 && 1 != fread(&encoded[0], blockHeader.encodedBytes, 1, traceInput)) {
+		fail("block trace is truncated");
+		return false;
+	}
+
+	if(! ProsperoBlockCodec::decode(header.codec, encoded.data(), encoded.size(), decoded.data(), decoded.size()) ||
+		! ProsperoBlockCodec::unpackColumns(decoded.data(), decoded.size(), blockHeader.firstCycle - cycleShift,
+			block.data(), block.size())) {
+		fail(std::string("unable to decode a ") + ProsperoBlockCodec::name(header.codec) + " block");
+		return false;
+	}
+
+	blockNext = 0;
+	return true;
+}
+
+size_t ProsperoTraceFile::readBlocks(ProsperoTraceRecord* records, const size_t maxRecords) {
+	size_t count = 0;
+
+	while(count < maxRecords) {
+		if(blockNext == block.size() && ! nextBlock()) {
+			break;
+		}
+
+		const size_t available = std::min(block.size() - blockNext, maxRecords - count);
+		std::copy(block.begin() + blockNext, block.begin() + blockNext + available, records + count);
+		blockNext += available;
+		count += available;
+	}
+
+	return failed() ? 0 : count;
+}
+
+ProsperoTraceFileWriter::ProsperoTraceFileWriter() :
+	format(PROSPERO_FORMAT_BINARY), traceOutput(NULL),
+#ifdef HAVE_LIBZ
+	traceOutputZ(NULL),
+#endif
+	codec(PROSPERO_CODEC_NONE), level(0), blockRecords(0), records(0) {
+}
+
+ProsperoTraceFileWriter::~ProsperoTraceFileWriter() {
+	close();
+}
+
+bool ProsperoTraceFileWriter::open(const std::string& path, ProsperoTraceFormat outFormat,
+	uint32_t outCodec, int outLevel, uint32_t outBlockRecords) {
+
+	format = outFormat;
+	codec = outCodec;
+	level = outLevel;
+	blockRecords = outBlockRecords;
+
+	switch(format) {
+	case PROSPERO_FORMAT_TEXT:
+		traceOutput = fopen(path.c_str(), "wt");
+		break;
+
+	case PROSPERO_FORMAT_BINARY:
+		traceOutput = fopen(path.c_str(), "wb");
+		break;
+
+	case PROSPERO_FORMAT_COMPRESSED:
+#ifdef HAVE_LIBZ
+		traceOutputZ = gzopen(path.c_str(), "wb");
+		if(NULL == traceOutputZ) {
+			error = "zlib was unable to open " + path;
+			return false;
+		}
+		return true;
+#else
+		error = "compressed traces need zlib which was not found when this was built";
+		return false;
+#endif
+
+	case PROSPERO_FORMAT_BLOCK:
+		if(! ProsperoBlockCodec::available(codec)) {
+			error = std::string("the ") + ProsperoBlockCodec::name(codec) + " codec was not found when this was built";
+			return false;
+		}
+
+		if(0 == blockRecords) {
+			error = "blocks must hold at least one record";
+			return false;
+		}
+
+		traceOutput = fopen(path.c_str(), "wb");
+
+		if(NULL != traceOutput) {
+			ProsperoBlockFileHeader fileHeader;
+			std::memset(&fileHeader, 0, sizeof(fileHeader));
+			std::memcpy(fileHeader.magic, PROSPERO_BLOCK_MAGIC, PROSPERO_BLOCK_MAGIC_LENGTH);
+			fileHeader.version = PROSPERO_BLOCK_VERSION;
+			fileHeader.codec = codec;
+			fileHeader.blockRecords = blockRecords;
+
+			if(1 != fwrite(&fileHeader, sizeof(fileHeader), 1, traceOutput)) {
+				error = "unable to write to " + path;
+				return false;
+			}
+
+			pending.reserve(blockRecords);
+		}
+		break;
+
+	default:
+		error = "the output format must be text, binary, compressed or block";
+		return false;
+	}
+
+	if(NULL == traceOutput) {
+		error = "unable to open " + path;
+		return false;
+	}
+
+	return true;
+}
+
+bool ProsperoTraceFileWriter::write(const ProsperoTraceRecord& record) {
+	char packed[PROSPERO_RECORD_LENGTH];
+
+	switch(format) {
+	case PROSPERO_FORMAT_TEXT:
+		return fprintf(traceOutput, "%" PRIu64 " %c %" PRIu64 " %" PRIu32 "\n",
+			record.cycles, record.op, record.address, record.length) > 0;
+
+	case PROSPERO_FORMAT_BINARY:
+		ProsperoBlockCodec::pack(record, packed);
+		return 1 == fwrite(packed, sizeof(packed), 1, traceOutput);
+
+#ifdef HAVE_LIBZ
+	case PROSPERO_FORMAT_COMPRESSED:
+		ProsperoBlockCodec::pack(record, packed);
+		return (int) sizeof(packed) == gzwrite(traceOutputZ, packed, sizeof(packed));
+#endif
+
+	case PROSPERO_FORMAT_BLOCK:
+		pending.push_back(record);
+		return (pending.size() < blockRecords) || flushBlock();
+
+	default:
+		return false;
+	}
+}
+
+bool ProsperoTraceFileWriter::flushBlock() {
+	if(pending.empty()) {
+		return true;
+	}
+
+	ProsperoBlockCodec::packColumns(pending.data(), pending.size(), raw);
+
+	if(! ProsperoBlockCodec::encode(codec, level, raw, encoded)) {
+		error = std::string("unable to encode a ") + ProsperoBlockCodec::name(codec) + " block";
+		return false;
+	}
+
+	ProsperoBlockHeader blockHeader;
+	blockHeader.records = (uint32_t) pending.size();
+	blockHeader.encodedBytes = (uint32_t) encoded.size();
+	blockHeader.rawBytes = (uint32_t) raw.size();
+	blockHeader.reserved = 0;
+	blockHeader.firstCycle = pending[0].cycles;
+
+	ProsperoBlockIndexEntry entry;
+	entry.offset = (uint64_t) ftello(traceOutput);
+	entry.firstRecord = records;
+	entry.firstCycle = blockHeader.firstCycle;
+	entry.records = blockHeader.records;
+	entry.reserved = 0;
+	index.push_back(entry);
+
+	records += pending.size();
+	pending.clear();
+
+	if(1 != fwrite(&blockHeader, sizeof(blockHeader), 1, traceOutput) ||
+		(encoded.size() > 0 && 1 != fwrite(encoded.data(), encoded.size(), 1, traceOutput))) {
+		error = "unable to write a block";
+		return false;
+	}
+
+	return true;
+}
+
+bool ProsperoTraceFileWriter::writeIndex() {
+	ProsperoBlockFooter footer;
+	footer.indexOffset = (uint64_t) ftello(traceOutput);
+	footer.blockCount = index.size();
+	std::memcpy(footer.magic, PROSPERO_INDEX_MAGIC, PROSPERO_BLOCK_MAGIC_LENGTH);
+
+	if((index.size() > 0 && 1 != fwrite(index.data(), sizeof(ProsperoBlockIndexEntry) * index.size(), 1, traceOutput)) ||
+		1 != fwrite(&footer, sizeof(footer), 1, traceOutput)) {
+		error = "unable to write the block index";
+		return false;
+	}
+
+	return true;
+}
+
+bool ProsperoTraceFileWriter::close() {
+	bool success = true;
+
+	if(NULL != traceOutput) {
+		if(PROSPERO_FORMAT_BLOCK == format) {
+			success = flushBlock() && writeIndex();
+		}
+
+		success = (0 == fclose(traceOutput)) && success;
+		traceOutput = NULL;
+	}
+
+#ifdef HAVE_LIBZ
+	if(NULL != traceOutputZ) {
+		success = (Z_OK == gzclose(traceOutputZ)) && success;
+		traceOutputZ = NULL;
+	}
+#endif
+
+	return success;
+}
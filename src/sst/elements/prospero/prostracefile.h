@@ -0,0 +1,148 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_TRACE_FILE
+#define _H_SST_PROSPERO_TRACE_FILE
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "prosblockformat.h"
+
+namespace SST {
+namespace Prospero {
+
+typedef enum {
+	PROSPERO_FORMAT_AUTO,
+	PROSPERO_FORMAT_TEXT,
+	PROSPERO_FORMAT_BINARY,
+	PROSPERO_FORMAT_COMPRESSED,
+	PROSPERO_FORMAT_BLOCK
+} ProsperoTraceFormat;
+
+bool prosperoParseFormat(const std::string& name, ProsperoTraceFormat& format);
+const char* prosperoFormatName(const ProsperoTraceFormat format);
+
+/*
+ * Reads records in bulk from a trace in any of the Prospero formats. This
+ * has no dependence on the simulator so it is shared by the asynchronous
+ * reader and by sst-prospero-convert. Errors are reported through
+ * getError() rather than Output so the reader may decode on its own thread.
+ */
+class ProsperoTraceFile {
+public:
+	ProsperoTraceFile();
+	~ProsperoTraceFile();
+
+	/** Open a trace, PROSPERO_FORMAT_AUTO detects block, gzip or raw binary from the first bytes */
+	bool open(const std::string& path, ProsperoTraceFormat format, bool useMmap);
+
+	/** Decode up to maxRecords records, returns 0 at the end of the trace or on an error */
+	size_t read(ProsperoTraceRecord* records, const size_t maxRecords);
+
+	/** Blocks of an indexed block trace, 0 for the other formats */
+	size_t getBlockCount() const { return index.size(); }
+	const ProsperoBlockIndexEntry& getBlock(const size_t block) const { return index[block]; }
+
+	/**
+	 * Read only the given blocks (in increasing order) of a block trace, call
+	 * before the first read. Cycles are moved earlier by the length of the
+	 * blocks left out so the blocks that are read follow on from each other.
+	 */
+	bool setSchedule(const std::vector<size_t>& blocks);
+
+	bool failed() const { return ! error.empty(); }
+	const std::string& getError() const { return error; }
+	ProsperoTraceFormat getFormat() const { return format; }
+	uint32_t getCodec() const { return header.codec; }
+	bool isMapped() const { return NULL != mapped; }
+
+private:
+	size_t readText(ProsperoTraceRecord* records, const size_t maxRecords);
+	size_t readStream(ProsperoTraceRecord* records, const size_t maxRecords);
+	size_t readMapped(ProsperoTraceRecord* records, const size_t maxRecords);
+	size_t readBlocks(ProsperoTraceRecord* records, const size_t maxRecords);
+	bool nextBlock();
+	bool loadIndex();
+	bool scanIndex(const uint64_t fileBytes);
+	void fail(const std::string& message);
+
+	ProsperoTraceFormat format;
+	FILE* traceInput;
+#ifdef HAVE_LIBZ
+	gzFile traceInputZ;
+#endif
+	const char* mapped;
+	size_t mappedBytes;
+	size_t mappedOffset;
+
+	std::vector<char> staging;
+
+	ProsperoBlockFileHeader header;
+	std::vector<ProsperoBlockIndexEntry> index;
+	std::vector<size_t> schedule;
+	size_t scheduleNext;
+	size_t lastBlock;
+	uint64_t cycleShift;
+
+	std::vector<char> encoded;
+	std::vector<char> decoded;
+	std::vector<ProsperoTraceRecord> block;
+	size_t blockNext;
+
+	std::string error;
+};
+
+/* Writes records in any of the Prospero formats, used by sst-prospero-convert */
+class ProsperoTraceFileWriter {
+public:
+	ProsperoTraceFileWriter();
+	~ProsperoTraceFileWriter();
+
+	bool open(const std::string& path, ProsperoTraceFormat format,
+		uint32_t codec, int level, uint32_t blockRecords);
+	bool write(const ProsperoTraceRecord& record);
+	bool close();
+
+	const std::string& getError() const { return error; }
+
+private:
+	bool flushBlock();
+	bool writeIndex();
+
+	ProsperoTraceFormat format;
+	FILE* traceOutput;
+#ifdef HAVE_LIBZ
+	gzFile traceOutputZ;
+#endif
+	uint32_t codec;
+	int level;
+	uint32_t blockRecords;
+
+	std::vector<ProsperoTraceRecord> pending;
+	std::vector<char> raw;
+	std::vector<char> encoded;
+	std::vector<ProsperoBlockIndexEntry> index;
+	uint64_t records;
+
+	std::string error;
+};
+
+}
+}
+
+#endif
@@ -35,6 +35,14 @@ def main():
                 # print "args are ", o, "and", a
                 Tracetype = "CompressedBinary"
                 traceFile = "sstprospero-0-0-gz.trace"
+            elif a == "async":
+                # the binary trace through the background decoding reader
+                Tracetype = "Async"
+                traceFile = "sstprospero-0-0-bin.trace"
+            elif a == "block":
+                # the binary trace converted by sst-prospero-convert
+                Tracetype = "Async"
+                traceFile = "sstprospero-0-0-block.trace"
             else:
                 print("no match a= ", a)
                 print("Found nothing for o", o)
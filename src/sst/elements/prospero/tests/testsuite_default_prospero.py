@@ -4,6 +4,7 @@ from sst_unittest import *
 from sst_unittest_support import *
 import os
 import glob
+import filecmp
 
 USE_PIN_TRACES = True
 USE_TAR_TRACES = False
@@ -105,9 +106,83 @@ class testcase_prospero(SSTTestCase):
     def test_prospero_binary_withtimingdram_using_PIN_traces(self):
         self.prospero_test_template("binary", WITH_TIMINGDRAM, USE_PIN_TRACES)
 
+    # The same records as the binary trace, so the same results
+    def test_prospero_async_using_TAR_traces(self):
+        self.prospero_test_template("async", NO_TIMINGDRAM, USE_TAR_TRACES, ref_name="binary")
+
+    def test_prospero_block_using_TAR_traces(self):
+        self.prospero_convert_TAR_trace()
+        self.prospero_test_template("block", NO_TIMINGDRAM, USE_TAR_TRACES, ref_name="binary")
+
+    def test_prospero_tracefile_unit(self):
+        self.prospero_unit_test_template("testtracefile")
+
+    # text -> block -> binary -> block -> text must give back the text trace
+    def test_prospero_convert_roundtrip(self):
+        unitdir = "{0}/unit".format(self.get_testsuite_dir())
+        tmpdir = self.get_test_output_tmp_dir()
+
+        rtn = OSCommand("make prosconvert", set_cwd=unitdir).run()
+        log_debug("Prospero converter make result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "sst-prospero-convert failed to build")
+
+        records = 1000
+        textfile = "{0}/convert-in.trace".format(tmpdir)
+        with open(textfile, 'w') as trace:
+            for i in range(records):
+                trace.write("{0} {1} {2} {3}\n".format(1000 + 7 * i, "W" if i % 3 == 0 else "R", 65536 + 24 * i, 1 + i % 8))
+
+        steps = [ ("-i text -f block -c none -b 100", "convert-in.trace", "convert-a.trace"),
+                  ("-f binary", "convert-a.trace", "convert-b.trace"),
+                  ("-i binary -f block -c zlib -b 64", "convert-b.trace", "convert-c.trace"),
+                  ("-f text", "convert-c.trace", "convert-out.trace") ]
+
+        for options, infile, outfile in steps:
+            rtn = OSCommand("{0}/prosconvert {1} {2} {3}".format(unitdir, options, infile, outfile), set_cwd=tmpdir).run()
+            log_debug("sst-prospero-convert {0} result = {1}; output =\n{2}".format(options, rtn.result(), rtn.output()))
+            self.assertTrue(rtn.result() == 0, "sst-prospero-convert {0} {1} failed:\n{2}".format(options, infile, rtn.output()))
+
+        self.assertTrue(filecmp.cmp(textfile, "{0}/convert-out.trace".format(tmpdir), shallow=False),
+                        "The converted trace does not match the original text trace")
+
+        # a header line and one line per block
+        rtn = OSCommand("{0}/prosconvert --index convert-c.trace".format(unitdir), set_cwd=tmpdir).run()
+        self.assertTrue(rtn.result() == 0, "sst-prospero-convert --index failed:\n{0}".format(rtn.output()))
+        self.assertEqual(len(rtn.output().splitlines()), 1 + (records + 63) // 64, "Unexpected block index:\n{0}".format(rtn.output()))
+
+        rtn = OSCommand("{0}/prosconvert -c nosuchcodec convert-in.trace convert-d.trace".format(unitdir), set_cwd=tmpdir).run()
+        self.assertTrue(rtn.result() != 0, "sst-prospero-convert accepted an unknown codec")
+
 #####
 
-    def prospero_test_template(self, trace_name, with_timingdram, use_pin_traces, testtimeout=240):
+    # Header-only and standalone parts are checked by small programs
+    def prospero_unit_test_template(self, testname):
+        unitdir = "{0}/unit".format(self.get_testsuite_dir())
+        tmpdir = self.get_test_output_tmp_dir()
+
+        rtn = OSCommand("make {0}".format(testname), set_cwd=unitdir).run()
+        log_debug("Prospero unit test {0} make result = {1}; output =\n{2}".format(testname, rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "Prospero unit test {0} failed to build".format(testname))
+
+        rtn = OSCommand("{0}/{1}".format(unitdir, testname), set_cwd=tmpdir).run()
+        log_debug("Prospero unit test {0} result = {1}; output =\n{2}".format(testname, rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "Prospero unit test {0} failed:\n{1}".format(testname, rtn.output()))
+
+    # Converts the downloaded binary trace to a block trace with the installed converter
+    def prospero_convert_TAR_trace(self):
+        tmpdir = self.get_test_output_tmp_dir()
+        tracedir = "{0}/testProsperoTARTraces".format(tmpdir)
+
+        elem_bin_dir = sstsimulator_conf_get_value_str("SST_ELEMENT_LIBRARY", "SST_ELEMENT_LIBRARY_BINDIR", "BINDIR_UNDEFINED")
+        converter = "{0}/sst-prospero-convert".format(elem_bin_dir)
+        self.assertTrue(os.path.isfile(converter), "sst-prospero-convert not found in {0}".format(elem_bin_dir))
+
+        cmd = "{0} -i binary -f block -b 4096 sstprospero-0-0-bin.trace sstprospero-0-0-block.trace".format(converter)
+        rtn = OSCommand(cmd, set_cwd=tracedir).run()
+        log_debug("Prospero block trace convert result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "Converting the binary trace to a block trace failed")
+
+    def prospero_test_template(self, trace_name, with_timingdram, use_pin_traces, testtimeout=240, ref_name=None):
         pass
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
@@ -143,6 +218,8 @@ class testcase_prospero(SSTTestCase):
 
         sdlfile = "{0}/array/trace-common.py".format(test_path)
         reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+        if ref_name is not None:
+            reffile = reffile.replace("_{0}.out".format(trace_name), "_{0}.out".format(ref_name))
         outfile = "{0}/{1}_using_{2}_traces.out".format(outdir, testDataFileName, tracetype)
         errfile = "{0}/{1}_using_{2}_traces.out.err".format(outdir, testDataFileName, tracetype)
         mpioutfiles = "{0}/{1}_using_{2}_traces.out.testfile".format(outdir, testDataFileName, tracetype)
@@ -0,0 +1,2 @@
+// Stands in for the configured sst_config.h when the trace file code is
+// built on its own by the unit tests, HAVE_LIBZ comes from the Makefile.
@@ -0,0 +1,269 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Writes a trace in every format and codec, reads it back and checks the
+// block index, block schedules and damaged files
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include "prostracefile.h"
+
+using namespace SST::Prospero;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if ( ! (cond) ) { \
+            printf( "FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond ); \
+            failures++; \
+        } \
+    } while ( 0 )
+
+static const size_t RECORDS = 1000;
+static const uint32_t BLOCK_RECORDS = 96;
+
+// Strided accesses with a few far jumps, cycles mostly increase but not always
+static std::vector<ProsperoTraceRecord> makeRecords()
+{
+    std::vector<ProsperoTraceRecord> records( RECORDS );
+    uint64_t cycles = 1000;
+
+    for ( size_t i = 0; i < RECORDS; i++ ) {
+        cycles += ( i % 17 == 0 ) ? 5000 : ( i % 3 );
+        records[i].cycles = ( i % 50 == 49 ) ? cycles - 2 : cycles;
+        records[i].op = ( i % 4 == 0 ) ? 'W' : 'R';
+        records[i].address = ( i % 100 == 0 ) ? 0x7fffffff0000ull + i : 0x10000 + 8 * i;
+        records[i].length = 1 + ( i % 8 );
+    }
+
+    return records;
+}
+
+static bool sameRecord( const ProsperoTraceRecord& a, const ProsperoTraceRecord& b )
+{
+    return a.cycles == b.cycles && a.op == b.op && a.address == b.address && a.length == b.length;
+}
+
+static bool writeTrace( const std::string& path, ProsperoTraceFormat format, uint32_t codec,
+    const std::vector<ProsperoTraceRecord>& records )
+{
+    ProsperoTraceFileWriter writer;
+
+    if ( ! writer.open( path, format, codec, 0, BLOCK_RECORDS ) ) {
+        printf( "Unable to open %s: %s\n", path.c_str(), writer.getError().c_str() );
+        return false;
+    }
+
+    for ( size_t i = 0; i < records.size(); i++ ) {
+        if ( ! writer.write( records[i] ) ) {
+            return false;
+        }
+    }
+
+    return writer.close();
+}
+
+// Reads in uneven chunks so reads cross block boundaries
+static std::vector<ProsperoTraceRecord> readTrace( ProsperoTraceFile& trace )
+{
+    std::vector<ProsperoTraceRecord> records;
+    std::vector<ProsperoTraceRecord> chunk( 37 );
+    size_t count;
+
+    while ( ( count = trace.read( chunk.data(), chunk.size() ) ) > 0 ) {
+        records.insert( records.end(), chunk.begin(), chunk.begin() + count );
+    }
+
+    return records;
+}
+
+static void checkRoundTrip( const std::string& path, ProsperoTraceFormat format, uint32_t codec, bool useMmap )
+{
+    const std::vector<ProsperoTraceRecord> expected = makeRecords();
+
+    CHECK( writeTrace( path, format, codec, expected ) );
+
+    // Text is never detected, everything else is
+    ProsperoTraceFile trace;
+    CHECK( trace.open( path, PROSPERO_FORMAT_TEXT == format ? format : PROSPERO_FORMAT_AUTO, useMmap ) );
+    CHECK( trace.getFormat() == format );
+
+    const std::vector<ProsperoTraceRecord> records = readTrace( trace );
+    CHECK( ! trace.failed() );
+    CHECK( records.size() == expected.size() );
+
+    for ( size_t i = 0; i < records.size() && i < expected.size(); i++ ) {
+        if ( ! sameRecord( records[i], expected[i] ) ) {
+            printf( "FAILED %s (%s, %s): record %zu differs\n", path.c_str(), prosperoFormatName( format ),
+                ProsperoBlockCodec::name( codec ), i );
+            failures++;
+            break;
+        }
+    }
+}
+
+static void testFormats()
+{
+    checkRoundTrip( "tracefile-text.trace", PROSPERO_FORMAT_TEXT, PROSPERO_CODEC_NONE, false );
+    checkRoundTrip( "tracefile-binary.trace", PROSPERO_FORMAT_BINARY, PROSPERO_CODEC_NONE, false );
+    checkRoundTrip( "tracefile-binary.trace", PROSPERO_FORMAT_BINARY, PROSPERO_CODEC_NONE, true );
+    checkRoundTrip( "tracefile-compressed.trace", PROSPERO_FORMAT_COMPRESSED, PROSPERO_CODEC_NONE, false );
+
+    for ( uint32_t codec = PROSPERO_CODEC_NONE; codec <= PROSPERO_CODEC_ZSTD; codec++ ) {
+        if ( ProsperoBlockCodec::available( codec ) ) {
+            checkRoundTrip( std::string( "tracefile-block-" ) + ProsperoBlockCodec::name( codec ) + ".trace",
+                PROSPERO_FORMAT_BLOCK, codec, false );
+        }
+    }
+}
+
+static void testIndex()
+{
+    const std::vector<ProsperoTraceRecord> expected = makeRecords();
+    const size_t blocks = ( RECORDS + BLOCK_RECORDS - 1 ) / BLOCK_RECORDS;
+
+    CHECK( writeTrace( "tracefile-index.trace", PROSPERO_FORMAT_BLOCK, PROSPERO_CODEC_NONE, expected ) );
+
+    ProsperoTraceFile trace;
+    CHECK( trace.open( "tracefile-index.trace", PROSPERO_FORMAT_BLOCK, false ) );
+    CHECK( trace.getBlockCount() == blocks );
+
+    for ( size_t i = 0; i < trace.getBlockCount(); i++ ) {
+        const ProsperoBlockIndexEntry& block = trace.getBlock( i );
+        CHECK( block.firstRecord == i * BLOCK_RECORDS );
+        CHECK( block.firstCycle == expected[i * BLOCK_RECORDS].cycles );
+        CHECK( block.records == ( i + 1 < blocks ? BLOCK_RECORDS : RECORDS - i * BLOCK_RECORDS ) );
+    }
+
+    // Blocks 2 and 3 and then 6, the skipped time is taken out of the cycles
+    std::vector<size_t> schedule;
+    schedule.push_back( 2 );
+    schedule.push_back( 3 );
+    schedule.push_back( 6 );
+    CHECK( trace.setSchedule( schedule ) );
+
+    const std::vector<ProsperoTraceRecord> records = readTrace( trace );
+    CHECK( records.size() == 3 * BLOCK_RECORDS );
+
+    if ( records.size() == 3 * BLOCK_RECORDS ) {
+        const uint64_t shift2 = expected[2 * BLOCK_RECORDS].cycles - expected[0].cycles;
+        const uint64_t shift6 = shift2 + expected[6 * BLOCK_RECORDS].cycles - expected[4 * BLOCK_RECORDS].cycles;
+
+        for ( size_t i = 0; i < records.size(); i++ ) {
+            const size_t source = ( i < 2 * BLOCK_RECORDS ) ? 2 * BLOCK_RECORDS + i : 4 * BLOCK_RECORDS + i;
+            ProsperoTraceRecord shifted = expected[source];
+            shifted.cycles -= ( i < 2 * BLOCK_RECORDS ) ? shift2 : shift6;
+
+            if ( ! sameRecord( records[i], shifted ) ) {
+                printf( "FAILED scheduled record %zu differs\n", i );
+                failures++;
+                break;
+            }
+        }
+    }
+
+    ProsperoTraceFile unordered;
+    CHECK( unordered.open( "tracefile-index.trace", PROSPERO_FORMAT_BLOCK, false ) );
+    schedule[1] = 1;
+    CHECK( ! unordered.setSchedule( schedule ) );
+    CHECK( unordered.failed() );
+}
+
+// Cut the footer and the index off, the index is rebuilt from the block headers
+// and a partly written last block is dropped
+static void testTruncated()
+{
+    const std::vector<ProsperoTraceRecord> expected = makeRecords();
+    CHECK( writeTrace( "tracefile-truncated.trace", PROSPERO_FORMAT_BLOCK, PROSPERO_CODEC_NONE, expected ) );
+
+    ProsperoTraceFile complete;
+    CHECK( complete.open( "tracefile-truncated.trace", PROSPERO_FORMAT_BLOCK, false ) );
+    const uint64_t lastBlock = complete.getBlock( complete.getBlockCount() - 1 ).offset;
+
+    FILE* file = fopen( "tracefile-truncated.trace", "rb" );
+    std::vector<char> bytes( lastBlock + 10 );
+    CHECK( NULL != file && 1 == fread( bytes.data(), bytes.size(), 1, file ) );
+    if ( NULL != file ) {
+        fclose( file );
+    }
+
+    file = fopen( "tracefile-truncated.trace", "wb" );
+    CHECK( NULL != file && 1 == fwrite( bytes.data(), bytes.size(), 1, file ) );
+    if ( NULL != file ) {
+        fclose( file );
+    }
+
+    ProsperoTraceFile trace;
+    CHECK( trace.open( "tracefile-truncated.trace", PROSPERO_FORMAT_AUTO, false ) );
+    CHECK( trace.getBlockCount() == complete.getBlockCount() - 1 );
+
+    const std::vector<ProsperoTraceRecord> records = readTrace( trace );
+    CHECK( ! trace.failed() );
+    CHECK( records.size() == ( complete.getBlockCount() - 1 ) * BLOCK_RECORDS );
+}
+
+static void testCodec()
+{
+    const std::vector<ProsperoTraceRecord> expected = makeRecords();
+    std::vector<char> raw, encoded;
+
+    ProsperoBlockCodec::packColumns( expected.data(), BLOCK_RECORDS, raw );
+
+    for ( uint32_t codec = PROSPERO_CODEC_NONE; codec <= PROSPERO_CODEC_ZSTD; codec++ ) {
+        if ( ! ProsperoBlockCodec::available( codec ) ) {
+            CHECK( ! ProsperoBlockCodec::encode( codec, 0, raw, encoded ) );
+            continue;
+        }
+
+        CHECK( ProsperoBlockCodec::encode( codec, 0, raw, encoded ) );
+
+        std::vector<char> decoded( raw.size() );
+        CHECK( ProsperoBlockCodec::decode( codec, encoded.data(), encoded.size(), decoded.data(), decoded.size() ) );
+        CHECK( decoded == raw );
+
+        // The payload must decode to exactly the size in the block header
+        std::vector<char> longer( raw.size() + 1 );
+        CHECK( ! ProsperoBlockCodec::decode( codec, encoded.data(), encoded.size(), longer.data(), longer.size() ) );
+    }
+
+    std::vector<ProsperoTraceRecord> records( BLOCK_RECORDS );
+    CHECK( ProsperoBlockCodec::unpackColumns( raw.data(), raw.size(), expected[0].cycles, records.data(), records.size() ) );
+    CHECK( sameRecord( records[BLOCK_RECORDS - 1], expected[BLOCK_RECORDS - 1] ) );
+
+    // A count that does not match the payload is rejected
+    CHECK( ! ProsperoBlockCodec::unpackColumns( raw.data(), raw.size(), expected[0].cycles, records.data(), records.size() - 1 ) );
+    CHECK( ! ProsperoBlockCodec::unpackColumns( raw.data(), raw.size() - 1, expected[0].cycles, records.data(), records.size() ) );
+}
+
+int main( int argc, char* argv[] )
+{
+    testFormats();
+    testIndex();
+    testTruncated();
+    testCodec();
+
+    if ( failures ) {
+        printf( "%d checks failed\n", failures );
+        return EXIT_FAILURE;
+    }
+
+    printf( "All trace file checks passed\n" );
+    return EXIT_SUCCESS;
+}
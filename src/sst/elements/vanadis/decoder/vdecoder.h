@@ -182,6 +182,9 @@ public:
     virtual void                         tick(SST::Output* output, uint64_t cycle) = 0;
     virtual const VanadisDecoderOptions* getDecoderOptions() const                 = 0;
 
+    // Bytes in one vector register, 0 when the decoder has no vector state
+    virtual uint16_t getVectorLengthBytes() const { return 0; }
+
     uint64_t getInstructionPointer() const { return ip; }
 
     void setInstructionPointer(const uint64_t newIP)
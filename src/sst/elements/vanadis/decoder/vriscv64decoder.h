@@ -34,6 +34,10 @@
 #define VANADIS_RISCV_IMM5_MASK   0xF80
 #define VANADIS_RISCV_IMM20_MASK  0xFFFFF000
 
+// vl and vtype are held in two integer registers after the AMO temporaries
+#define VANADIS_RISCV_VL_REG    34
+#define VANADIS_RISCV_VTYPE_REG 35
+
 #define VANADIS_RISCV_SIGN12_MASK       0x800
 #define VANADIS_RISCV_SIGN12_UPPER_1_32 0xFFFFF000
 #define VANADIS_RISCV_SIGN12_UPPER_1_64 0xFFFFFFFFFFFFF000LL
@@ -58,12 +62,34 @@ public:
        "Number of cache lines that a cached prior to decoding (these support "
        "loading from cache prior to decode)"},
       {"halt_on_decode_fault",
-		"Fatal error if a decode fault occurs, used for debugging and not recommmended default is 0 (false)", "0"})
+		"Fatal error if a decode fault occurs, used for debugging and not recommmended default is 0 (false)", "0"},
+      {"vector_length_bits",
+       "Enable the RISC-V vector extension with this VLEN (power of two, 64 to 1024), 0 disables. Each vector register "
+       "uses VLEN/64 floating point registers so physical_fp_registers must be raised to match", "0"})
 
     VanadisRISCV64Decoder(ComponentId_t id, Params& params) : VanadisDecoder(id, params)
     {
+        const uint16_t vector_bits = params.find<uint16_t>("vector_length_bits", 0);
+
+        if ( (vector_bits > 0) && ((vector_bits < 64) || (vector_bits > (VANADIS_VECTOR_MAX_BYTES * 8)) ||
+                                   (0 != (vector_bits & (vector_bits - 1)))) ) {
+            getSimulationOutput().fatal(
+                CALL_INFO, -1, "Error: vector_length_bits must be a power of two between 64 and %d, got %" PRIu16 "\n",
+                VANADIS_VECTOR_MAX_BYTES * 8, vector_bits);
+        }
+
+        vector_bytes = vector_bits / 8;
+
         // we need TWO additional registers for AMO microcode operations, RISC-V has 32 + 2 int for our micro-code.
-        options = new VanadisDecoderOptions(static_cast<uint16_t>(0), 34, 32, 2, VANADIS_REGISTER_MODE_FP64);
+        // With vectors enabled vl and vtype follow those and each vector register is VLEN/64 FP registers.
+        if ( 0 == vector_bytes ) {
+            options = new VanadisDecoderOptions(static_cast<uint16_t>(0), 34, 32, 2, VANADIS_REGISTER_MODE_FP64);
+        }
+        else {
+            options = new VanadisDecoderOptions(
+                static_cast<uint16_t>(0), 36, 32 + (32 * (vector_bytes / VANADIS_VECTOR_SLICE_BYTES)), 2,
+                VANADIS_REGISTER_MODE_FP64);
+        }
         max_decodes_per_cycle = params.find<uint16_t>("decode_max_ins_per_cycle", 2);
 
         // See if we get an entry point the sub-component says we have to use
@@ -79,6 +105,7 @@ public:
     const char*                  getISAName() const override { return "RISCV64"; }
     uint16_t                     countISAIntReg() const override { return options->countISAIntRegisters(); }
     uint16_t                     countISAFPReg() const override { return options->countISAFPRegisters(); }
+    uint16_t                     getVectorLengthBytes() const override { return vector_bytes; }
     const VanadisDecoderOptions* getDecoderOptions() const override { return options; }
     VanadisFPRegisterMode        getFPRegisterMode() const override { return VANADIS_REGISTER_MODE_FP64; }
 
@@ -305,6 +332,7 @@ protected:
     uint16_t                     icache_max_bytes_per_cycle;
     uint16_t                     max_decodes_per_cycle;
     uint16_t                     decode_buffer_max_entries;
+    uint16_t                     vector_bytes;
 
     void decode(SST::Output* output, const uint64_t ins_address, const uint32_t ins, VanadisInstructionBundle* bundle)
     {
@@ -454,6 +482,14 @@ protected:
                         LOAD_FP_REGISTER));
                     decode_fault = false;
                 } break;
+                case 0x0:
+                case 0x5:
+                case 0x6:
+                case 0x7:
+                {
+                    // Vector loads
+                    decode_fault = !decodeVectorMemory(output, ins_address, ins, bundle, true);
+                } break;
                 }
             } break;
             case 0x23:
@@ -1103,6 +1139,30 @@ protected:
                                     ins_address, hw_thr, options, rd, thread_call));
                             decode_fault = false;
                         } break;
+                        case 0xfffffffffffffc20:
+                        case 0xfffffffffffffc21:
+                        {
+                            // Read vl or vtype (csrr rd, vl)
+                            if ( (vector_bytes > 0) && (0 == rs1) ) {
+                                output->verbose( CALL_INFO, 16, 0, "-------> CSRR %s\n", (0xfffffffffffffc20 == uimm64) ? "VL" : "VTYPE");
+
+                                bundle->addInstruction(new VanadisAddImmInstruction<int64_t>(
+                                    ins_address, hw_thr, options, rd,
+                                    (0xfffffffffffffc20 == uimm64) ? VANADIS_RISCV_VL_REG : VANADIS_RISCV_VTYPE_REG, 0));
+                                decode_fault = false;
+                            }
+                        } break;
+                        case 0xfffffffffffffc22:
+                        {
+                            // Read vlenb
+                            if ( (vector_bytes > 0) && (0 == rs1) ) {
+                                output->verbose( CALL_INFO, 16, 0, "-------> CSRR VLENB\n");
+
+                                bundle->addInstruction(new VanadisSetRegisterInstruction<int64_t>(
+                                    ins_address, hw_thr, options, rd, vector_bytes));
+                                decode_fault = false;
+                            }
+                        } break;
                         }
                     } break;
                     case 0x6:
@@ -1402,8 +1462,21 @@ protected:
                         ins_address, hw_thr, options, rs1, simm64, rs2, 8, MEM_TRANSACTION_NONE, STORE_FP_REGISTER));
                     	decode_fault = false;
 						} break;
+					case 0x0:
+					case 0x5:
+					case 0x6:
+					case 0x7:
+						{
+							// Vector stores
+							decode_fault = !decodeVectorMemory(output, ins_address, ins, bundle, false);
+						} break;
 					}
             } break;
+            case 0x57:
+            {
+                // Vector arithmetic and vsetvl (OP-V)
+                decode_fault = !decodeVectorArith(output, ins_address, ins, bundle);
+            } break;
             case 0x53:
             {
                 // floating point arithmetic
@@ -2706,6 +2779,344 @@ protected:
         }
     }
 
+    // Decode the OP-V major opcode (vector arithmetic and vsetvl family),
+    // returns false if the instruction is not supported
+    bool decodeVectorArith(
+        SST::Output* output, const uint64_t ins_address, const uint32_t ins, VanadisInstructionBundle* bundle)
+    {
+        if ( 0 == vector_bytes ) { return false; }
+
+        const uint16_t vd     = extract_rd(ins);
+        const uint16_t vs1    = extract_rs1(ins);
+        const uint16_t vs2    = extract_rs2(ins);
+        const uint32_t func3  = extract_func3(ins);
+        const uint32_t func6  = (ins >> 26) & 0x3F;
+        const bool     masked = (0 == (ins & 0x2000000));
+
+        // 5-bit immediate, shifts take it unsigned
+        const int64_t simm5 = (vs1 & 0x10) ? (int64_t)vs1 - 32 : (int64_t)vs1;
+
+        output->verbose(
+            CALL_INFO, 16, 0,
+            "-----> OP-V func3: %" PRIu32 " func6: 0x%" PRIx32 " vd: %" PRIu16 " vs1: %" PRIu16 " vs2: %" PRIu16
+            " masked: %s\n",
+            func3, func6, vd, vs1, vs2, masked ? "yes" : "no");
+
+        switch ( func3 ) {
+        case 0x7:
+        {
+            // OPCFG: vsetvli / vsetivli / vsetvl
+            if ( 0 == (ins & 0x80000000) ) {
+                // vsetvli
+                const uint64_t vtype_imm = (ins >> 20) & 0x7FF;
+                const VanadisVectorAVLSource avl_src = (0 != vs1) ? VanadisVectorAVLSource::REGISTER :
+                                                       (0 != vd)  ? VanadisVectorAVLSource::VLMAX :
+                                                                    VanadisVectorAVLSource::KEEP;
+
+                output->verbose(
+                    CALL_INFO, 16, 0, "-------> VSETVLI rd: %" PRIu16 " rs1: %" PRIu16 " vtype: 0x%" PRIx64 "\n", vd,
+                    vs1, vtype_imm);
+                bundle->addInstruction(new VanadisVectorSetVLInstruction(
+                    ins_address, hw_thr, options, vector_bytes, VANADIS_RISCV_VL_REG, VANADIS_RISCV_VTYPE_REG, vd, vs1,
+                    avl_src, 0, false, 0, vtype_imm));
+                return true;
+            }
+            else if ( 0xC0000000 == (ins & 0xC0000000) ) {
+                // vsetivli, rs1 field is the AVL
+                const uint64_t vtype_imm = (ins >> 20) & 0x3FF;
+
+                output->verbose(
+                    CALL_INFO, 16, 0, "-------> VSETIVLI rd: %" PRIu16 " avl: %" PRIu16 " vtype: 0x%" PRIx64 "\n", vd,
+                    vs1, vtype_imm);
+                bundle->addInstruction(new VanadisVectorSetVLInstruction(
+                    ins_address, hw_thr, options, vector_bytes, VANADIS_RISCV_VL_REG, VANADIS_RISCV_VTYPE_REG, vd, 0,
+                    VanadisVectorAVLSource::IMMEDIATE, vs1, false, 0, 0));
+                return true;
+            }
+            else if ( 0x80000000 == (ins & 0xFE000000) ) {
+                // vsetvl
+                const VanadisVectorAVLSource avl_src = (0 != vs1) ? VanadisVectorAVLSource::REGISTER :
+                                                       (0 != vd)  ? VanadisVectorAVLSource::VLMAX :
+                                                                    VanadisVectorAVLSource::KEEP;
+
+                output->verbose(
+                    CALL_INFO, 16, 0, "-------> VSETVL rd: %" PRIu16 " rs1: %" PRIu16 " rs2: %" PRIu16 "\n", vd, vs1,
+                    vs2);
+                bundle->addInstruction(new VanadisVectorSetVLInstruction(
+                    ins_address, hw_thr, options, vector_bytes, VANADIS_RISCV_VL_REG, VANADIS_RISCV_VTYPE_REG, vd, vs1,
+                    avl_src, 0, true, vs2, 0));
+                return true;
+            }
+        } break;
+        case 0x0:
+        case 0x3:
+        case 0x4:
+        {
+            // OPIVV, OPIVI, OPIVX
+            const VanadisVectorOperandForm form = (0x0 == func3) ? VanadisVectorOperandForm::VV :
+                                                  (0x3 == func3) ? VanadisVectorOperandForm::VI :
+                                                                   VanadisVectorOperandForm::VX;
+            bool               valid    = true;
+            bool               uimm     = false;
+            bool               use_mask = masked;
+            VanadisVectorIntOp op       = VanadisVectorIntOp::ADD;
+
+            switch ( func6 ) {
+            case 0x00: op = VanadisVectorIntOp::ADD; break;
+            case 0x02: op = VanadisVectorIntOp::SUB; valid = (VanadisVectorOperandForm::VI != form); break;
+            case 0x03: op = VanadisVectorIntOp::RSUB; valid = (VanadisVectorOperandForm::VV != form); break;
+            case 0x04: op = VanadisVectorIntOp::MINU; valid = (VanadisVectorOperandForm::VI != form); break;
+            case 0x05: op = VanadisVectorIntOp::MIN; valid = (VanadisVectorOperandForm::VI != form); break;
+            case 0x06: op = VanadisVectorIntOp::MAXU; valid = (VanadisVectorOperandForm::VI != form); break;
+            case 0x07: op = VanadisVectorIntOp::MAX; valid = (VanadisVectorOperandForm::VI != form); break;
+            case 0x09: op = VanadisVectorIntOp::AND; break;
+            case 0x0A: op = VanadisVectorIntOp::OR; break;
+            case 0x0B: op = VanadisVectorIntOp::XOR; break;
+            case 0x17:
+                // vmerge when masked (v0 selects), vmv.v.* otherwise
+                op    = masked ? VanadisVectorIntOp::MERGE : VanadisVectorIntOp::MV;
+                valid = masked || (0 == vs2);
+                break;
+            case 0x18: op = VanadisVectorIntOp::MSEQ; break;
+            case 0x19: op = VanadisVectorIntOp::MSNE; break;
+            case 0x1A: op = VanadisVectorIntOp::MSLTU; valid = (VanadisVectorOperandForm::VI != form); break;
+            case 0x1B: op = VanadisVectorIntOp::MSLT; valid = (VanadisVectorOperandForm::VI != form); break;
+            case 0x1C: op = VanadisVectorIntOp::MSLEU; break;
+            case 0x1D: op = VanadisVectorIntOp::MSLE; break;
+            case 0x1E: op = VanadisVectorIntOp::MSGTU; valid = (VanadisVectorOperandForm::VV != form); break;
+            case 0x1F: op = VanadisVectorIntOp::MSGT; valid = (VanadisVectorOperandForm::VV != form); break;
+            case 0x25: op = VanadisVectorIntOp::SLL; uimm = true; break;
+            case 0x27:
+                // vmv1r.v only, larger register groups are not modeled
+                op       = VanadisVectorIntOp::MV_WHOLE;
+                valid    = (VanadisVectorOperandForm::VI == form) && (0 == vs1) && !masked;
+                use_mask = false;
+                break;
+            case 0x28: op = VanadisVectorIntOp::SRL; uimm = true; break;
+            case 0x29: op = VanadisVectorIntOp::SRA; uimm = true; break;
+            default: valid = false; break;
+            }
+
+            if ( !valid ) { return false; }
+
+            output->verbose(
+                CALL_INFO, 16, 0, "-------> %s vd: %" PRIu16 " vs2: %" PRIu16 " src1: %" PRIu16 "\n",
+                getVectorIntOpName(op), vd, vs2, vs1);
+            bundle->addInstruction(new VanadisVectorIntInstruction(
+                ins_address, hw_thr, options, vector_bytes, VANADIS_RISCV_VL_REG, VANADIS_RISCV_VTYPE_REG, op, form, vd,
+                vs2, vs1, uimm ? (int64_t)vs1 : simm5, use_mask));
+            return true;
+        } break;
+        case 0x2:
+        case 0x6:
+        {
+            // OPMVV, OPMVX
+            const VanadisVectorOperandForm form =
+                (0x2 == func3) ? VanadisVectorOperandForm::VV : VanadisVectorOperandForm::VX;
+            const bool         is_vv = (VanadisVectorOperandForm::VV == form);
+            bool               valid = true;
+            VanadisVectorIntOp op    = VanadisVectorIntOp::ADD;
+
+            switch ( func6 ) {
+            case 0x00: op = VanadisVectorIntOp::REDSUM; valid = is_vv; break;
+            case 0x01: op = VanadisVectorIntOp::REDAND; valid = is_vv; break;
+            case 0x02: op = VanadisVectorIntOp::REDOR; valid = is_vv; break;
+            case 0x03: op = VanadisVectorIntOp::REDXOR; valid = is_vv; break;
+            case 0x04: op = VanadisVectorIntOp::REDMINU; valid = is_vv; break;
+            case 0x05: op = VanadisVectorIntOp::REDMIN; valid = is_vv; break;
+            case 0x06: op = VanadisVectorIntOp::REDMAXU; valid = is_vv; break;
+            case 0x07: op = VanadisVectorIntOp::REDMAX; valid = is_vv; break;
+            case 0x10:
+                // vmv.x.s (VWXUNARY0) or vmv.s.x (VRXUNARY0)
+                op    = is_vv ? VanadisVectorIntOp::MV_X_S : VanadisVectorIntOp::MV_S_X;
+                valid = !masked && (is_vv ? (0 == vs1) : (0 == vs2));
+                break;
+            case 0x14:
+                // vid.v (VMUNARY0)
+                op    = VanadisVectorIntOp::ID;
+                valid = is_vv && (0x11 == vs1) && (0 == vs2);
+                break;
+            case 0x20: op = VanadisVectorIntOp::DIVU; break;
+            case 0x21: op = VanadisVectorIntOp::DIV; break;
+            case 0x22: op = VanadisVectorIntOp::REMU; break;
+            case 0x23: op = VanadisVectorIntOp::REM; break;
+            case 0x25: op = VanadisVectorIntOp::MUL; break;
+            case 0x29: op = VanadisVectorIntOp::MADD; break;
+            case 0x2B: op = VanadisVectorIntOp::NMSUB; break;
+            case 0x2D: op = VanadisVectorIntOp::MACC; break;
+            case 0x2F: op = VanadisVectorIntOp::NMSAC; break;
+            default: valid = false; break;
+            }
+
+            if ( !valid ) { return false; }
+
+            output->verbose(
+                CALL_INFO, 16, 0, "-------> %s vd: %" PRIu16 " vs2: %" PRIu16 " src1: %" PRIu16 "\n",
+                getVectorIntOpName(op), vd, vs2, vs1);
+            bundle->addInstruction(new VanadisVectorIntInstruction(
+                ins_address, hw_thr, options, vector_bytes, VANADIS_RISCV_VL_REG, VANADIS_RISCV_VTYPE_REG, op, form, vd,
+                vs2, vs1, 0, masked));
+            return true;
+        } break;
+        case 0x1:
+        case 0x5:
+        {
+            // OPFVV, OPFVF
+            const VanadisVectorOperandForm form =
+                (0x1 == func3) ? VanadisVectorOperandForm::VV : VanadisVectorOperandForm::VX;
+            const bool        is_vv    = (VanadisVectorOperandForm::VV == form);
+            bool              valid    = true;
+            bool              use_mask = masked;
+            VanadisVectorFPOp op       = VanadisVectorFPOp::ADD;
+
+            switch ( func6 ) {
+            case 0x00: op = VanadisVectorFPOp::ADD; break;
+            case 0x01: op = VanadisVectorFPOp::REDSUM; valid = is_vv; break; // vfredusum
+            case 0x02: op = VanadisVectorFPOp::SUB; break;
+            case 0x03: op = VanadisVectorFPOp::REDSUM; valid = is_vv; break; // vfredosum
+            case 0x04: op = VanadisVectorFPOp::MIN; break;
+            case 0x05: op = VanadisVectorFPOp::REDMIN; valid = is_vv; break;
+            case 0x06: op = VanadisVectorFPOp::MAX; break;
+            case 0x07: op = VanadisVectorFPOp::REDMAX; valid = is_vv; break;
+            case 0x08: op = VanadisVectorFPOp::SGNJ; break;
+            case 0x09: op = VanadisVectorFPOp::SGNJN; break;
+            case 0x0A: op = VanadisVectorFPOp::SGNJX; break;
+            case 0x10:
+                // vfmv.f.s (VWFUNARY0) or vfmv.s.f (VRFUNARY0)
+                op       = is_vv ? VanadisVectorFPOp::MV_F_S : VanadisVectorFPOp::MV_S_F;
+                valid    = !masked && (is_vv ? (0 == vs1) : (0 == vs2));
+                use_mask = false;
+                break;
+            case 0x13:
+                // vfsqrt.v (VFUNARY1), other unary operations are not supported
+                op    = VanadisVectorFPOp::SQRT;
+                valid = is_vv && (0 == vs1);
+                break;
+            case 0x17:
+                // vfmerge.vfm when masked, vfmv.v.f otherwise
+                op    = masked ? VanadisVectorFPOp::MERGE : VanadisVectorFPOp::MV;
+                valid = !is_vv && (masked || (0 == vs2));
+                break;
+            case 0x18: op = VanadisVectorFPOp::MFEQ; break;
+            case 0x19: op = VanadisVectorFPOp::MFLE; break;
+            case 0x1B: op = VanadisVectorFPOp::MFLT; break;
+            case 0x1C: op = VanadisVectorFPOp::MFNE; break;
+            case 0x1D: op = VanadisVectorFPOp::MFGT; valid = !is_vv; break;
+            case 0x1F: op = VanadisVectorFPOp::MFGE; valid = !is_vv; break;
+            case 0x20: op = VanadisVectorFPOp::DIV; break;
+            case 0x21: op = VanadisVectorFPOp::RDIV; valid = !is_vv; break;
+            case 0x24: op = VanadisVectorFPOp::MUL; break;
+            case 0x27: op = VanadisVectorFPOp::RSUB; valid = !is_vv; break;
+            case 0x28: op = VanadisVectorFPOp::MADD; break;
+            case 0x29: op = VanadisVectorFPOp::NMADD; break;
+            case 0x2A: op = VanadisVectorFPOp::MSUB; break;
+            case 0x2B: op = VanadisVectorFPOp::NMSUB; break;
+            case 0x2C: op = VanadisVectorFPOp::MACC; break;
+            case 0x2D: op = VanadisVectorFPOp::NMACC; break;
+            case 0x2E: op = VanadisVectorFPOp::MSAC; break;
+            case 0x2F: op = VanadisVectorFPOp::NMSAC; break;
+            default: valid = false; break;
+            }
+
+            if ( !valid ) { return false; }
+
+            output->verbose(
+                CALL_INFO, 16, 0, "-------> %s vd: %" PRIu16 " vs2: %" PRIu16 " src1: %" PRIu16 "\n",
+                getVectorFPOpName(op), vd, vs2, vs1);
+            bundle->addInstruction(new VanadisVectorFPInstruction(
+                ins_address, hw_thr, options, vector_bytes, VANADIS_RISCV_VL_REG, VANADIS_RISCV_VTYPE_REG, op, form, vd,
+                vs2, vs1, use_mask));
+            return true;
+        } break;
+        }
+
+        return false;
+    }
+
+    // Decode vector loads and stores (LOAD-FP / STORE-FP with a vector width),
+    // segment loads/stores (nf > 0) and register groups are not supported
+    bool decodeVectorMemory(
+        SST::Output* output, const uint64_t ins_address, const uint32_t ins, VanadisInstructionBundle* bundle,
+        const bool is_load)
+    {
+        if ( 0 == vector_bytes ) { return false; }
+
+        const uint16_t vd     = extract_rd(ins);
+        const uint16_t rs1    = extract_rs1(ins);
+        const uint16_t rs2    = extract_rs2(ins);
+        const uint32_t width  = extract_func3(ins);
+        const uint32_t mop    = (ins >> 26) & 0x3;
+        const uint32_t mew    = (ins >> 28) & 0x1;
+        const uint32_t nf     = (ins >> 29) & 0x7;
+        const bool     masked = (0 == (ins & 0x2000000));
+
+        uint16_t eew_bytes = 0;
+
+        switch ( width ) {
+        case 0x0: eew_bytes = 1; break;
+        case 0x5: eew_bytes = 2; break;
+        case 0x6: eew_bytes = 4; break;
+        case 0x7: eew_bytes = 8; break;
+        }
+
+        if ( (0 != mew) || (0 != nf) ) { return false; }
+
+        VanadisVectorMemoryMode mode = VanadisVectorMemoryMode::UNIT;
+
+        switch ( mop ) {
+        case 0x0:
+        {
+            switch ( rs2 ) {
+            case 0x00:
+                mode = VanadisVectorMemoryMode::UNIT;
+                break;
+            case 0x08:
+                mode = VanadisVectorMemoryMode::WHOLE_REG;
+                if ( masked ) { return false; }
+                break;
+            case 0x0B:
+                mode = VanadisVectorMemoryMode::MASK;
+                if ( masked || (1 != eew_bytes) ) { return false; }
+                break;
+            case 0x10:
+                // fault-only-first loads are treated as normal unit stride loads
+                if ( !is_load ) { return false; }
+                mode = VanadisVectorMemoryMode::UNIT;
+                break;
+            default:
+                return false;
+            }
+        } break;
+        case 0x2:
+            mode = VanadisVectorMemoryMode::STRIDED;
+            break;
+        case 0x1:
+        case 0x3:
+            // unordered and ordered indexed are the same in this model
+            mode = VanadisVectorMemoryMode::INDEXED;
+            break;
+        }
+
+        output->verbose(
+            CALL_INFO, 16, 0,
+            "-------> VECTOR-%s mop: %" PRIu32 " eew: %" PRIu16 " v%" PRIu16 " rs1: %" PRIu16 " rs2: %" PRIu16
+            " masked: %s\n",
+            is_load ? "LOAD" : "STORE", mop, eew_bytes, vd, rs1, rs2, masked ? "yes" : "no");
+
+        if ( is_load ) {
+            bundle->addInstruction(new VanadisVectorLoadInstruction(
+                ins_address, hw_thr, options, vector_bytes, VANADIS_RISCV_VL_REG, VANADIS_RISCV_VTYPE_REG, mode, vd, rs1,
+                rs2, eew_bytes, masked));
+        }
+        else {
+            bundle->addInstruction(new VanadisVectorStoreInstruction(
+                ins_address, hw_thr, options, vector_bytes, VANADIS_RISCV_VL_REG, VANADIS_RISCV_VTYPE_REG, mode, vd, rs1,
+                rs2, eew_bytes, masked));
+        }
+
+        return true;
+    }
+
     uint16_t expand_rvc_int_register(const uint16_t reg_in) const { return reg_in + 8; }
 
     uint16_t extract_rs2_rvc(const uint32_t ins) const { return static_cast<uint16_t>((ins & 0x1C) >> 2); }
@@ -117,4 +117,11 @@
 #include "inst/vfpflagsset.h"
 #include "inst/vfpflagsread.h"
 
+// Vector
+#include "inst/vvecfp.h"
+#include "inst/vvecint.h"
+#include "inst/vvecload.h"
+#include "inst/vvecsetvl.h"
+#include "inst/vvecstore.h"
+
 #endif
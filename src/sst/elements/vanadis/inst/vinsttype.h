@@ -31,7 +31,9 @@ enum VanadisFunctionalUnitType {
     INST_SYSCALL,
     INST_FENCE,
     INST_NOOP,
-    INST_FAULT
+    INST_FAULT,
+    INST_VECTOR_INT_ARITH,
+    INST_VECTOR_FP_ARITH
 };
 
 const char*
@@ -62,6 +64,10 @@ funcTypeToString(VanadisFunctionalUnitType unit_type)
         return "FAULT";
     case INST_SYSCALL:
         return "SYSCALL";
+    case INST_VECTOR_INT_ARITH:
+        return "VEC_INT_ARITH";
+    case INST_VECTOR_FP_ARITH:
+        return "VEC_FP_ARITH";
     default:
         return "UNKNOWN";
     }
@@ -63,6 +63,7 @@ public:
     bool performSignExtension() const { return signed_extend; }
 
     virtual bool                      isPartialLoad() const { return false; }
+    virtual bool                      isVectorLoad() const { return false; }
     virtual VanadisFunctionalUnitType getInstFuncType() const { return INST_LOAD; }
     virtual const char*               getInstCode() const
     {
@@ -188,6 +189,20 @@ public:
     virtual uint16_t getRegisterOffset() const { return 0; }
 
 protected:
+    // Used by loads which need registers beyond the single address and target
+    // register, the derived class fills in the ISA register lists
+    VanadisLoadInstruction(
+        const uint64_t addr, const uint32_t hw_thr, const VanadisDecoderOptions* isa_opts, const int64_t offst,
+        const uint16_t load_bytes, const VanadisMemoryTransaction accessT, VanadisLoadRegisterType regT,
+        const uint16_t int_in, const uint16_t int_out, const uint16_t fp_in, const uint16_t fp_out) :
+        VanadisInstruction(addr, hw_thr, isa_opts, int_in, int_out, int_in, int_out, fp_in, fp_out, fp_in, fp_out),
+        offset(offst),
+        load_width(load_bytes),
+        signed_extend(false),
+        memAccessType(accessT),
+        regType(regT)
+    {}
+
     const bool               signed_extend;
     VanadisMemoryTransaction memAccessType;
     const int64_t            offset;
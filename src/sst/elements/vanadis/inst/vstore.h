@@ -72,6 +72,7 @@ public:
     VanadisStoreInstruction* clone() { return new VanadisStoreInstruction(*this); }
 
     virtual bool isPartialStore() { return false; }
+    virtual bool isVectorStore() const { return false; }
 
     virtual VanadisMemoryTransaction getTransactionType() const { return memAccessType; }
 
@@ -179,6 +180,19 @@ public:
     VanadisStoreRegisterType getValueRegisterType() const { return regType; }
 
 protected:
+    // Used by stores which need registers beyond the address and value register,
+    // the derived class fills in the ISA register lists
+    VanadisStoreInstruction(
+        const uint64_t addr, const uint32_t hw_thr, const VanadisDecoderOptions* isa_opts, const int64_t offst,
+        const uint16_t store_bytes, VanadisMemoryTransaction accessT, VanadisStoreRegisterType regT,
+        const uint16_t int_in, const uint16_t fp_in) :
+        VanadisInstruction(addr, hw_thr, isa_opts, int_in, 0, int_in, 0, fp_in, 0, fp_in, 0),
+        store_width(store_bytes),
+        offset(offst),
+        memAccessType(accessT),
+        regType(regT)
+    {}
+
     const int64_t            offset;
     const uint16_t           store_width;
     VanadisMemoryTransaction memAccessType;
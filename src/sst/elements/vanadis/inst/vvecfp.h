@@ -0,0 +1,350 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_VECTOR_FP_ARITH
+#define _H_VANADIS_VECTOR_FP_ARITH
+
+#include "inst/vvecint.h"
+
+#include <cmath>
+
+namespace SST {
+namespace Vanadis {
+
+enum class VanadisVectorFPOp {
+    ADD,
+    SUB,
+    RSUB,
+    MUL,
+    DIV,
+    RDIV,
+    MIN,
+    MAX,
+    SGNJ,
+    SGNJN,
+    SGNJX,
+    SQRT,
+    MACC,
+    NMACC,
+    MSAC,
+    NMSAC,
+    MADD,
+    NMADD,
+    MSUB,
+    NMSUB,
+    MV,
+    MERGE,
+    MFEQ,
+    MFNE,
+    MFLT,
+    MFLE,
+    MFGT,
+    MFGE,
+    REDSUM,
+    REDMIN,
+    REDMAX,
+    MV_F_S,
+    MV_S_F
+};
+
+inline const char*
+getVectorFPOpName(const VanadisVectorFPOp op)
+{
+    switch ( op ) {
+    case VanadisVectorFPOp::ADD: return "VFADD";
+    case VanadisVectorFPOp::SUB: return "VFSUB";
+    case VanadisVectorFPOp::RSUB: return "VFRSUB";
+    case VanadisVectorFPOp::MUL: return "VFMUL";
+    case VanadisVectorFPOp::DIV: return "VFDIV";
+    case VanadisVectorFPOp::RDIV: return "VFRDIV";
+    case VanadisVectorFPOp::MIN: return "VFMIN";
+    case VanadisVectorFPOp::MAX: return "VFMAX";
+    case VanadisVectorFPOp::SGNJ: return "VFSGNJ";
+    case VanadisVectorFPOp::SGNJN: return "VFSGNJN";
+    case VanadisVectorFPOp::SGNJX: return "VFSGNJX";
+    case VanadisVectorFPOp::SQRT: return "VFSQRT";
+    case VanadisVectorFPOp::MACC: return "VFMACC";
+    case VanadisVectorFPOp::NMACC: return "VFNMACC";
+    case VanadisVectorFPOp::MSAC: return "VFMSAC";
+    case VanadisVectorFPOp::NMSAC: return "VFNMSAC";
+    case VanadisVectorFPOp::MADD: return "VFMADD";
+    case VanadisVectorFPOp::NMADD: return "VFNMADD";
+    case VanadisVectorFPOp::MSUB: return "VFMSUB";
+    case VanadisVectorFPOp::NMSUB: return "VFNMSUB";
+    case VanadisVectorFPOp::MV: return "VFMV";
+    case VanadisVectorFPOp::MERGE: return "VFMERGE";
+    case VanadisVectorFPOp::MFEQ: return "VMFEQ";
+    case VanadisVectorFPOp::MFNE: return "VMFNE";
+    case VanadisVectorFPOp::MFLT: return "VMFLT";
+    case VanadisVectorFPOp::MFLE: return "VMFLE";
+    case VanadisVectorFPOp::MFGT: return "VMFGT";
+    case VanadisVectorFPOp::MFGE: return "VMFGE";
+    case VanadisVectorFPOp::REDSUM: return "VFREDSUM";
+    case VanadisVectorFPOp::REDMIN: return "VFREDMIN";
+    case VanadisVectorFPOp::REDMAX: return "VFREDMAX";
+    case VanadisVectorFPOp::MV_F_S: return "VFMV.F.S";
+    case VanadisVectorFPOp::MV_S_F: return "VFMV.S.F";
+    default: return "VFPUNK";
+    }
+}
+
+/*
+ * Vector floating point operations for SEW=32 and SEW=64, the VX form takes
+ * its scalar from an FP register (the .vf instructions). FP flags are not
+ * updated by vector operations.
+ */
+class VanadisVectorFPInstruction : public VanadisVectorInstruction
+{
+public:
+    VanadisVectorFPInstruction(
+        const uint64_t addr, const uint32_t hw_thr, const VanadisDecoderOptions* isa_opts, const uint16_t vlen_bytes,
+        const uint16_t vl_reg, const uint16_t vtype_reg, const VanadisVectorFPOp the_op,
+        const VanadisVectorOperandForm the_form, const uint16_t vd, const uint16_t vs2, const uint16_t src1,
+        const bool masked) :
+        VanadisVectorInstruction(
+            addr, hw_thr, isa_opts, vlen_bytes, vl_reg, vtype_reg, 0, 0,
+            (VanadisVectorOperandForm::VX == the_form) ? 1 : 0, (VanadisVectorFPOp::MV_F_S == the_op) ? 1 : 0,
+            countVectorIn(the_op, the_form, masked), (VanadisVectorFPOp::MV_F_S == the_op) ? 0 : 1),
+        op(the_op),
+        form(the_form),
+        is_masked(masked)
+    {
+        int16_t next = 0;
+
+        idx_vs2  = usesVS2(the_op) ? next++ : -1;
+        idx_vs1  = usesVS1(the_op, the_form) ? next++ : -1;
+        idx_vd   = (VanadisVectorFPOp::MV_F_S == the_op) ? -1 : next++;
+        idx_mask = masked ? next++ : -1;
+
+        if ( idx_vs2 >= 0 ) { setVectorRegIn(idx_vs2, vs2); }
+        if ( idx_vs1 >= 0 ) { setVectorRegIn(idx_vs1, src1); }
+        if ( idx_vd >= 0 ) {
+            setVectorRegIn(idx_vd, vd);
+            setVectorRegOut(vd);
+        }
+        if ( idx_mask >= 0 ) { setVectorRegIn(idx_mask, 0); }
+
+        if ( VanadisVectorOperandForm::VX == the_form ) { isa_fp_regs_in[0] = src1; }
+        if ( VanadisVectorFPOp::MV_F_S == the_op ) { isa_fp_regs_out[0] = vd; }
+    }
+
+    VanadisVectorFPInstruction* clone() override { return new VanadisVectorFPInstruction(*this); }
+    VanadisFunctionalUnitType   getInstFuncType() const override { return INST_VECTOR_FP_ARITH; }
+    const char*                 getInstCode() const override { return getVectorFPOpName(op); }
+
+    void printToBuffer(char* buffer, size_t buffer_size) override
+    {
+        snprintf(
+            buffer, buffer_size, "%s.%s vl: %5" PRIu16 " (phys: %5" PRIu16 ") / masked: %s", getInstCode(),
+            (VanadisVectorOperandForm::VV == form) ? "VV" : "VF", isa_int_regs_in[0], phys_int_regs_in[0],
+            is_masked ? "yes" : "no");
+    }
+
+    void execute(SST::Output* output, VanadisRegisterFile* regFile) override
+    {
+        const uint64_t vl = getVL(regFile);
+
+#ifdef VANADIS_BUILD_DEBUG
+        if(output->getVerboseLevel() >= 16) {
+            output->verbose(
+                CALL_INFO, 16, 0, "Execute: (addr=0x%llx) %s vl: %" PRIu64 " / sew: %" PRIu32 " bytes\n",
+                getInstructionAddress(), getInstCode(), vl, getSEWBytes(regFile));
+        }
+#endif
+
+        switch ( getSEWBytes(regFile) ) {
+        case 4:
+            executeSEW<float>(regFile, vl);
+            break;
+        case 8:
+            executeSEW<double>(regFile, vl);
+            break;
+        default:
+            flagError();
+            break;
+        }
+
+        markExecuted();
+    }
+
+protected:
+    static bool usesVS2(const VanadisVectorFPOp op)
+    {
+        return (VanadisVectorFPOp::MV != op) && (VanadisVectorFPOp::MV_S_F != op);
+    }
+
+    static bool usesVS1(const VanadisVectorFPOp op, const VanadisVectorOperandForm form)
+    {
+        return (VanadisVectorOperandForm::VV == form) && (VanadisVectorFPOp::MV_F_S != op) &&
+               (VanadisVectorFPOp::SQRT != op);
+    }
+
+    static uint16_t countVectorIn(const VanadisVectorFPOp op, const VanadisVectorOperandForm form, const bool masked)
+    {
+        return (usesVS2(op) ? 1 : 0) + (usesVS1(op, form) ? 1 : 0) + ((VanadisVectorFPOp::MV_F_S == op) ? 0 : 1) +
+               (masked ? 1 : 0);
+    }
+
+    static bool isReduction(const VanadisVectorFPOp op)
+    {
+        return (op >= VanadisVectorFPOp::REDSUM) && (op <= VanadisVectorFPOp::REDMAX);
+    }
+
+    static bool isCompare(const VanadisVectorFPOp op)
+    {
+        return (op >= VanadisVectorFPOp::MFEQ) && (op <= VanadisVectorFPOp::MFGE);
+    }
+
+    template <typename T>
+    T compute(const T a, const T b, const T d) const
+    {
+        switch ( op ) {
+        case VanadisVectorFPOp::ADD: return a + b;
+        case VanadisVectorFPOp::SUB: return a - b;
+        case VanadisVectorFPOp::RSUB: return b - a;
+        case VanadisVectorFPOp::MUL: return a * b;
+        case VanadisVectorFPOp::DIV: return a / b;
+        case VanadisVectorFPOp::RDIV: return b / a;
+        case VanadisVectorFPOp::MIN: return std::fmin(a, b);
+        case VanadisVectorFPOp::MAX: return std::fmax(a, b);
+        case VanadisVectorFPOp::SGNJ: return std::copysign(a, b);
+        case VanadisVectorFPOp::SGNJN: return std::copysign(a, -b);
+        case VanadisVectorFPOp::SGNJX: return std::signbit(b) ? -a : a;
+        case VanadisVectorFPOp::SQRT: return std::sqrt(a);
+        case VanadisVectorFPOp::MACC: return (b * a) + d;
+        case VanadisVectorFPOp::NMACC: return -(b * a) - d;
+        case VanadisVectorFPOp::MSAC: return (b * a) - d;
+        case VanadisVectorFPOp::NMSAC: return -(b * a) + d;
+        case VanadisVectorFPOp::MADD: return (b * d) + a;
+        case VanadisVectorFPOp::NMADD: return -(b * d) - a;
+        case VanadisVectorFPOp::MSUB: return (b * d) - a;
+        case VanadisVectorFPOp::NMSUB: return -(b * d) + a;
+        case VanadisVectorFPOp::MV: return b;
+        default: return d;
+        }
+    }
+
+    template <typename T>
+    bool compare(const T a, const T b) const
+    {
+        switch ( op ) {
+        case VanadisVectorFPOp::MFEQ: return a == b;
+        case VanadisVectorFPOp::MFNE: return a != b;
+        case VanadisVectorFPOp::MFLT: return a < b;
+        case VanadisVectorFPOp::MFLE: return a <= b;
+        case VanadisVectorFPOp::MFGT: return a > b;
+        case VanadisVectorFPOp::MFGE: return a >= b;
+        default: return false;
+        }
+    }
+
+    template <typename T>
+    T reduce(const T acc, const T value) const
+    {
+        switch ( op ) {
+        case VanadisVectorFPOp::REDSUM: return acc + value;
+        case VanadisVectorFPOp::REDMIN: return std::fmin(acc, value);
+        case VanadisVectorFPOp::REDMAX: return std::fmax(acc, value);
+        default: return acc;
+        }
+    }
+
+    template <typename T>
+    void executeSEW(VanadisRegisterFile* regFile, const uint64_t vl)
+    {
+        uint8_t vs2_buffer[VANADIS_VECTOR_MAX_BYTES];
+        uint8_t vs1_buffer[VANADIS_VECTOR_MAX_BYTES];
+        uint8_t vd_buffer[VANADIS_VECTOR_MAX_BYTES];
+        uint8_t mask_buffer[VANADIS_VECTOR_MAX_BYTES];
+
+        if ( idx_vs2 >= 0 ) { readVectorIn(regFile, idx_vs2, vs2_buffer); }
+        if ( idx_vs1 >= 0 ) { readVectorIn(regFile, idx_vs1, vs1_buffer); }
+        if ( idx_vd >= 0 ) { readVectorIn(regFile, idx_vd, vd_buffer); }
+        if ( idx_mask >= 0 ) { readVectorIn(regFile, idx_mask, mask_buffer); }
+
+        T scalar = 0;
+
+        if ( VanadisVectorOperandForm::VX == form ) { scalar = regFile->getFPReg<T>(phys_fp_regs_in[0]); }
+
+        const uint64_t max_vl     = vector_bytes / sizeof(T);
+        const uint64_t element_vl = (vl < max_vl) ? vl : max_vl;
+
+        if ( VanadisVectorFPOp::MV_F_S == op ) {
+            regFile->setFPReg<T>(phys_fp_regs_out[0], vanadis_vector_get<T>(vs2_buffer, 0));
+            return;
+        }
+        else if ( VanadisVectorFPOp::MV_S_F == op ) {
+            if ( element_vl > 0 ) { vanadis_vector_set<T>(vd_buffer, 0, scalar); }
+        }
+        else if ( isReduction(op) ) {
+            // ordered and unordered sums are both performed in element order
+            if ( element_vl > 0 ) {
+                T acc = vanadis_vector_get<T>(vs1_buffer, 0);
+
+                for ( uint64_t i = 0; i < element_vl; ++i ) {
+                    if ( (idx_mask < 0) || vanadis_vector_mask_active(mask_buffer, i) ) {
+                        acc = reduce<T>(acc, vanadis_vector_get<T>(vs2_buffer, i));
+                    }
+                }
+
+                vanadis_vector_set<T>(vd_buffer, 0, acc);
+            }
+        }
+        else if ( isCompare(op) ) {
+            for ( uint64_t i = 0; i < element_vl; ++i ) {
+                if ( (idx_mask >= 0) && !vanadis_vector_mask_active(mask_buffer, i) ) { continue; }
+
+                const T b = (idx_vs1 >= 0) ? vanadis_vector_get<T>(vs1_buffer, i) : scalar;
+
+                if ( compare<T>(vanadis_vector_get<T>(vs2_buffer, i), b) ) { vd_buffer[i >> 3] |= (1 << (i & 0x7)); }
+                else {
+                    vd_buffer[i >> 3] &= ~(1 << (i & 0x7));
+                }
+            }
+        }
+        else {
+            for ( uint64_t i = 0; i < element_vl; ++i ) {
+                const T b = (idx_vs1 >= 0) ? vanadis_vector_get<T>(vs1_buffer, i) : scalar;
+
+                if ( VanadisVectorFPOp::MERGE == op ) {
+                    vanadis_vector_set<T>(
+                        vd_buffer, i, vanadis_vector_mask_active(mask_buffer, i) ? b : vanadis_vector_get<T>(vs2_buffer, i));
+                    continue;
+                }
+
+                if ( (idx_mask >= 0) && !vanadis_vector_mask_active(mask_buffer, i) ) { continue; }
+
+                const T a = (idx_vs2 >= 0) ? vanadis_vector_get<T>(vs2_buffer, i) : 0;
+                vanadis_vector_set<T>(vd_buffer, i, compute<T>(a, b, vanadis_vector_get<T>(vd_buffer, i)));
+            }
+        }
+
+        writeVectorOut(regFile, vd_buffer);
+    }
+
+    const VanadisVectorFPOp        op;
+    const VanadisVectorOperandForm form;
+    const bool                     is_masked;
+
+    int16_t idx_vs2;
+    int16_t idx_vs1;
+    int16_t idx_vd;
+    int16_t idx_mask;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,261 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_VECTOR_INSTRUCTION
+#define _H_VANADIS_VECTOR_INSTRUCTION
+
+#include "inst/vinst.h"
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Largest vector register supported (VLEN = 1024 bits)
+#define VANADIS_VECTOR_MAX_BYTES 128
+
+// Width of one slice of a vector register, each slice is a renamed FP register
+#define VANADIS_VECTOR_SLICE_BYTES 8
+
+namespace SST {
+namespace Vanadis {
+
+/*
+ * Vector registers are not held in a separate register file. Each vector
+ * register is split into VLEN/64 slices and every slice is an additional ISA
+ * floating point register (numbered after the scalar FP registers) so the
+ * existing rename tables, ROB recovery and issue checks apply to vector
+ * state unchanged. The vl and vtype CSRs are likewise extra ISA integer
+ * registers, which makes vector instructions dependent on the vsetvl that
+ * configured them.
+ *
+ * Register groups (LMUL > 1) are not modeled, vsetvl clamps vl to VLEN/SEW
+ * which is always a legal choice for strip-mined loops.
+ */
+
+struct VanadisVectorMemoryAccess {
+    VanadisVectorMemoryAccess(const uint64_t addr, const uint32_t offs, const uint32_t w) :
+        address(addr), offset(offs), width(w) {}
+
+    uint64_t address;
+    uint32_t offset; // byte offset into the vector register
+    uint32_t width;
+};
+
+enum class VanadisVectorMemoryMode {
+    UNIT,      // unit stride, vle/vse
+    STRIDED,   // vlse/vsse
+    INDEXED,   // vluxei/vloxei/vsuxei/vsoxei
+    WHOLE_REG, // vl1r/vs1r
+    MASK       // vlm/vsm
+};
+
+inline uint16_t
+vanadis_vector_isa_reg(const uint16_t first_vec_reg, const uint16_t vreg, const uint16_t slice, const uint16_t slices)
+{
+    return first_vec_reg + (vreg * slices) + slice;
+}
+
+// SEW in bytes from vtype
+inline uint32_t
+vanadis_vector_sew_bytes(const uint64_t vtype)
+{
+    return 1 << ((vtype >> 3) & 0x7);
+}
+
+inline bool
+vanadis_vector_mask_active(const uint8_t* mask, const uint64_t element)
+{
+    return (mask[element >> 3] & (1 << (element & 0x7))) != 0;
+}
+
+inline void
+vanadis_vector_read(VanadisRegisterFile* regFile, const uint16_t* phys_regs, const uint16_t slices, uint8_t* buffer)
+{
+    for ( uint16_t i = 0; i < slices; ++i ) {
+        regFile->copyFromFPRegister(
+            phys_regs[i], 0, &buffer[i * VANADIS_VECTOR_SLICE_BYTES], VANADIS_VECTOR_SLICE_BYTES);
+    }
+}
+
+inline void
+vanadis_vector_write(VanadisRegisterFile* regFile, const uint16_t* phys_regs, const uint16_t slices, uint8_t* buffer)
+{
+    for ( uint16_t i = 0; i < slices; ++i ) {
+        regFile->copyToFPRegister(phys_regs[i], 0, &buffer[i * VANADIS_VECTOR_SLICE_BYTES], VANADIS_VECTOR_SLICE_BYTES);
+    }
+}
+
+template <typename T>
+inline T
+vanadis_vector_get(const uint8_t* buffer, const uint64_t element)
+{
+    T value;
+    std::memcpy(&value, &buffer[element * sizeof(T)], sizeof(T));
+    return value;
+}
+
+template <typename T>
+inline void
+vanadis_vector_set(uint8_t* buffer, const uint64_t element, const T value)
+{
+    std::memcpy(&buffer[element * sizeof(T)], &value, sizeof(T));
+}
+
+/*
+ * Generate the element accesses (address, offset in the register, width) for
+ * a vector memory operation. Only active elements below vl are generated. The
+ * index buffer is only used by INDEXED operations and the mask buffer is
+ * nullptr for unmasked operations. Returns false if the operation would need
+ * more than one vector register.
+ */
+inline bool
+vanadis_vector_compute_accesses(
+    const VanadisVectorMemoryMode mode, const uint16_t vector_bytes, const uint64_t base, const int64_t stride,
+    const uint64_t vl, const uint32_t sew_bytes, const uint32_t eew_bytes, const uint8_t* index_buffer,
+    const uint8_t* mask_buffer, std::vector<VanadisVectorMemoryAccess>& accesses)
+{
+    switch ( mode ) {
+    case VanadisVectorMemoryMode::WHOLE_REG:
+        accesses.emplace_back(base, 0, vector_bytes);
+        return true;
+    case VanadisVectorMemoryMode::MASK:
+    {
+        const uint64_t mask_bytes = (vl + 7) / 8;
+
+        if ( mask_bytes > vector_bytes ) { return false; }
+        if ( mask_bytes > 0 ) { accesses.emplace_back(base, 0, mask_bytes); }
+
+        return true;
+    }
+    default:
+        break;
+    }
+
+    // indexed operations use EEW for the index and SEW for the data
+    const uint32_t data_bytes = (VanadisVectorMemoryMode::INDEXED == mode) ? sew_bytes : eew_bytes;
+
+    if ( (vl * data_bytes) > vector_bytes || (vl * eew_bytes) > vector_bytes ) { return false; }
+
+    for ( uint64_t i = 0; i < vl; ++i ) {
+        if ( (nullptr != mask_buffer) && !vanadis_vector_mask_active(mask_buffer, i) ) { continue; }
+
+        uint64_t address = base;
+
+        switch ( mode ) {
+        case VanadisVectorMemoryMode::UNIT:
+            address = base + (i * eew_bytes);
+            break;
+        case VanadisVectorMemoryMode::STRIDED:
+            address = base + (uint64_t)(((int64_t)i) * stride);
+            break;
+        case VanadisVectorMemoryMode::INDEXED:
+        {
+            uint64_t index = 0;
+            std::memcpy(&index, &index_buffer[i * eew_bytes], eew_bytes);
+            address = base + index;
+        } break;
+        default:
+            break;
+        }
+
+        accesses.emplace_back(address, i * data_bytes, data_bytes);
+    }
+
+    return true;
+}
+
+/*
+ * Base for vector arithmetic. Integer registers in are { vl, vtype, scalars },
+ * FP registers in are { scalar fp, vector operands (slices each) } and the
+ * destination vector (if any) follows any scalar output.
+ */
+class VanadisVectorInstruction : public VanadisInstruction
+{
+public:
+    VanadisVectorInstruction(
+        const uint64_t addr, const uint32_t hw_thr, const VanadisDecoderOptions* isa_opts, const uint16_t vlen_bytes,
+        const uint16_t vl_reg, const uint16_t vtype_reg, const uint16_t scalar_int_in, const uint16_t scalar_int_out,
+        const uint16_t scalar_fp_in, const uint16_t scalar_fp_out, const uint16_t vec_in, const uint16_t vec_out) :
+        VanadisInstruction(
+            addr, hw_thr, isa_opts, 2 + scalar_int_in, scalar_int_out, 2 + scalar_int_in, scalar_int_out,
+            scalar_fp_in + (vec_in * (vlen_bytes / VANADIS_VECTOR_SLICE_BYTES)),
+            scalar_fp_out + (vec_out * (vlen_bytes / VANADIS_VECTOR_SLICE_BYTES)),
+            scalar_fp_in + (vec_in * (vlen_bytes / VANADIS_VECTOR_SLICE_BYTES)),
+            scalar_fp_out + (vec_out * (vlen_bytes / VANADIS_VECTOR_SLICE_BYTES))),
+        vector_bytes(vlen_bytes),
+        slices(vlen_bytes / VANADIS_VECTOR_SLICE_BYTES),
+        first_vec_reg(isa_opts->countISAFPRegisters() - (32 * (vlen_bytes / VANADIS_VECTOR_SLICE_BYTES))),
+        count_scalar_fp_in(scalar_fp_in),
+        count_scalar_fp_out(scalar_fp_out)
+    {
+        isa_int_regs_in[0] = vl_reg;
+        isa_int_regs_in[1] = vtype_reg;
+    }
+
+    uint16_t getVectorBytes() const { return vector_bytes; }
+
+    // Number of passes a functional unit with the given number of lanes needs
+    // to process every active element
+    virtual uint64_t countElementGroups(VanadisRegisterFile* regFile, const uint16_t lanes)
+    {
+        const uint64_t vl = getVL(regFile);
+        return (0 == lanes || 0 == vl) ? 1 : ((vl + lanes - 1) / lanes);
+    }
+
+protected:
+    void setVectorRegIn(const uint16_t index, const uint16_t vreg)
+    {
+        for ( uint16_t i = 0; i < slices; ++i ) {
+            isa_fp_regs_in[count_scalar_fp_in + (index * slices) + i] =
+                vanadis_vector_isa_reg(first_vec_reg, vreg, i, slices);
+        }
+    }
+
+    void setVectorRegOut(const uint16_t vreg)
+    {
+        for ( uint16_t i = 0; i < slices; ++i ) {
+            isa_fp_regs_out[count_scalar_fp_out + i] = vanadis_vector_isa_reg(first_vec_reg, vreg, i, slices);
+        }
+    }
+
+    void readVectorIn(VanadisRegisterFile* regFile, const uint16_t index, uint8_t* buffer)
+    {
+        vanadis_vector_read(regFile, &phys_fp_regs_in[count_scalar_fp_in + (index * slices)], slices, buffer);
+    }
+
+    void writeVectorOut(VanadisRegisterFile* regFile, uint8_t* buffer)
+    {
+        vanadis_vector_write(regFile, &phys_fp_regs_out[count_scalar_fp_out], slices, buffer);
+    }
+
+    uint64_t getVL(VanadisRegisterFile* regFile) { return regFile->getIntReg<uint64_t>(phys_int_regs_in[0]); }
+
+    uint32_t getSEWBytes(VanadisRegisterFile* regFile)
+    {
+        return vanadis_vector_sew_bytes(regFile->getIntReg<uint64_t>(phys_int_regs_in[1]));
+    }
+
+    const uint16_t vector_bytes;
+    const uint16_t slices;
+    const uint16_t first_vec_reg;
+    const uint16_t count_scalar_fp_in;
+    const uint16_t count_scalar_fp_out;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
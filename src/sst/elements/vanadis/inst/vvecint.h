@@ -0,0 +1,410 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_VECTOR_INT_ARITH
+#define _H_VANADIS_VECTOR_INT_ARITH
+
+#include "inst/vvecinst.h"
+
+#include <limits>
+
+namespace SST {
+namespace Vanadis {
+
+enum class VanadisVectorOperandForm { VV, VX, VI };
+
+enum class VanadisVectorIntOp {
+    ADD,
+    SUB,
+    RSUB,
+    MINU,
+    MIN,
+    MAXU,
+    MAX,
+    AND,
+    OR,
+    XOR,
+    SLL,
+    SRL,
+    SRA,
+    MUL,
+    DIVU,
+    DIV,
+    REMU,
+    REM,
+    MACC,
+    NMSAC,
+    MADD,
+    NMSUB,
+    MV,
+    MERGE,
+    MSEQ,
+    MSNE,
+    MSLTU,
+    MSLT,
+    MSLEU,
+    MSLE,
+    MSGTU,
+    MSGT,
+    REDSUM,
+    REDMAXU,
+    REDMAX,
+    REDMINU,
+    REDMIN,
+    REDAND,
+    REDOR,
+    REDXOR,
+    MV_X_S,
+    MV_S_X,
+    ID,
+    MV_WHOLE
+};
+
+inline const char*
+getVectorIntOpName(const VanadisVectorIntOp op)
+{
+    switch ( op ) {
+    case VanadisVectorIntOp::ADD: return "VADD";
+    case VanadisVectorIntOp::SUB: return "VSUB";
+    case VanadisVectorIntOp::RSUB: return "VRSUB";
+    case VanadisVectorIntOp::MINU: return "VMINU";
+    case VanadisVectorIntOp::MIN: return "VMIN";
+    case VanadisVectorIntOp::MAXU: return "VMAXU";
+    case VanadisVectorIntOp::MAX: return "VMAX";
+    case VanadisVectorIntOp::AND: return "VAND";
+    case VanadisVectorIntOp::OR: return "VOR";
+    case VanadisVectorIntOp::XOR: return "VXOR";
+    case VanadisVectorIntOp::SLL: return "VSLL";
+    case VanadisVectorIntOp::SRL: return "VSRL";
+    case VanadisVectorIntOp::SRA: return "VSRA";
+    case VanadisVectorIntOp::MUL: return "VMUL";
+    case VanadisVectorIntOp::DIVU: return "VDIVU";
+    case VanadisVectorIntOp::DIV: return "VDIV";
+    case VanadisVectorIntOp::REMU: return "VREMU";
+    case VanadisVectorIntOp::REM: return "VREM";
+    case VanadisVectorIntOp::MACC: return "VMACC";
+    case VanadisVectorIntOp::NMSAC: return "VNMSAC";
+    case VanadisVectorIntOp::MADD: return "VMADD";
+    case VanadisVectorIntOp::NMSUB: return "VNMSUB";
+    case VanadisVectorIntOp::MV: return "VMV";
+    case VanadisVectorIntOp::MERGE: return "VMERGE";
+    case VanadisVectorIntOp::MSEQ: return "VMSEQ";
+    case VanadisVectorIntOp::MSNE: return "VMSNE";
+    case VanadisVectorIntOp::MSLTU: return "VMSLTU";
+    case VanadisVectorIntOp::MSLT: return "VMSLT";
+    case VanadisVectorIntOp::MSLEU: return "VMSLEU";
+    case VanadisVectorIntOp::MSLE: return "VMSLE";
+    case VanadisVectorIntOp::MSGTU: return "VMSGTU";
+    case VanadisVectorIntOp::MSGT: return "VMSGT";
+    case VanadisVectorIntOp::REDSUM: return "VREDSUM";
+    case VanadisVectorIntOp::REDMAXU: return "VREDMAXU";
+    case VanadisVectorIntOp::REDMAX: return "VREDMAX";
+    case VanadisVectorIntOp::REDMINU: return "VREDMINU";
+    case VanadisVectorIntOp::REDMIN: return "VREDMIN";
+    case VanadisVectorIntOp::REDAND: return "VREDAND";
+    case VanadisVectorIntOp::REDOR: return "VREDOR";
+    case VanadisVectorIntOp::REDXOR: return "VREDXOR";
+    case VanadisVectorIntOp::MV_X_S: return "VMV.X.S";
+    case VanadisVectorIntOp::MV_S_X: return "VMV.S.X";
+    case VanadisVectorIntOp::ID: return "VID";
+    case VanadisVectorIntOp::MV_WHOLE: return "VMVR";
+    default: return "VINTUNK";
+    }
+}
+
+class VanadisVectorIntInstruction : public VanadisVectorInstruction
+{
+public:
+    VanadisVectorIntInstruction(
+        const uint64_t addr, const uint32_t hw_thr, const VanadisDecoderOptions* isa_opts, const uint16_t vlen_bytes,
+        const uint16_t vl_reg, const uint16_t vtype_reg, const VanadisVectorIntOp the_op,
+        const VanadisVectorOperandForm the_form, const uint16_t vd, const uint16_t vs2, const uint16_t src1,
+        const int64_t imm, const bool masked) :
+        VanadisVectorInstruction(
+            addr, hw_thr, isa_opts, vlen_bytes, vl_reg, vtype_reg, usesScalar(the_op, the_form) ? 1 : 0,
+            (VanadisVectorIntOp::MV_X_S == the_op) ? 1 : 0, 0, 0, countVectorIn(the_op, the_form, masked),
+            (VanadisVectorIntOp::MV_X_S == the_op) ? 0 : 1),
+        op(the_op),
+        form(the_form),
+        immediate(imm),
+        is_masked(masked)
+    {
+        int16_t next = 0;
+
+        idx_vs2  = usesVS2(the_op) ? next++ : -1;
+        idx_vs1  = usesVS1(the_op, the_form) ? next++ : -1;
+        idx_vd   = (VanadisVectorIntOp::MV_X_S == the_op) ? -1 : next++;
+        idx_mask = masked ? next++ : -1;
+
+        if ( idx_vs2 >= 0 ) { setVectorRegIn(idx_vs2, vs2); }
+        if ( idx_vs1 >= 0 ) { setVectorRegIn(idx_vs1, src1); }
+        if ( idx_vd >= 0 ) {
+            setVectorRegIn(idx_vd, vd);
+            setVectorRegOut(vd);
+        }
+        if ( idx_mask >= 0 ) { setVectorRegIn(idx_mask, 0); }
+
+        if ( usesScalar(the_op, the_form) ) { isa_int_regs_in[2] = src1; }
+        if ( VanadisVectorIntOp::MV_X_S == the_op ) { isa_int_regs_out[0] = vd; }
+    }
+
+    VanadisVectorIntInstruction* clone() override { return new VanadisVectorIntInstruction(*this); }
+    VanadisFunctionalUnitType    getInstFuncType() const override { return INST_VECTOR_INT_ARITH; }
+    const char*                  getInstCode() const override { return getVectorIntOpName(op); }
+
+    void printToBuffer(char* buffer, size_t buffer_size) override
+    {
+        snprintf(
+            buffer, buffer_size, "%s.%s vl: %5" PRIu16 " (phys: %5" PRIu16 ") / imm: %" PRId64 " / masked: %s",
+            getInstCode(),
+            (VanadisVectorOperandForm::VV == form) ? "VV" : (VanadisVectorOperandForm::VX == form) ? "VX" : "VI",
+            isa_int_regs_in[0], phys_int_regs_in[0], immediate, is_masked ? "yes" : "no");
+    }
+
+    void execute(SST::Output* output, VanadisRegisterFile* regFile) override
+    {
+        const uint64_t vl = getVL(regFile);
+
+#ifdef VANADIS_BUILD_DEBUG
+        if(output->getVerboseLevel() >= 16) {
+            output->verbose(
+                CALL_INFO, 16, 0, "Execute: (addr=0x%llx) %s vl: %" PRIu64 " / sew: %" PRIu32 " bytes\n",
+                getInstructionAddress(), getInstCode(), vl, getSEWBytes(regFile));
+        }
+#endif
+
+        switch ( getSEWBytes(regFile) ) {
+        case 1:
+            executeSEW<int8_t, uint8_t>(regFile, vl);
+            break;
+        case 2:
+            executeSEW<int16_t, uint16_t>(regFile, vl);
+            break;
+        case 4:
+            executeSEW<int32_t, uint32_t>(regFile, vl);
+            break;
+        case 8:
+            executeSEW<int64_t, uint64_t>(regFile, vl);
+            break;
+        default:
+            flagError();
+            break;
+        }
+
+        markExecuted();
+    }
+
+protected:
+    static bool usesVS2(const VanadisVectorIntOp op)
+    {
+        return (VanadisVectorIntOp::MV != op) && (VanadisVectorIntOp::MV_S_X != op) && (VanadisVectorIntOp::ID != op);
+    }
+
+    static bool usesVS1(const VanadisVectorIntOp op, const VanadisVectorOperandForm form)
+    {
+        return (VanadisVectorOperandForm::VV == form) && (VanadisVectorIntOp::MV_X_S != op) &&
+               (VanadisVectorIntOp::ID != op) && (VanadisVectorIntOp::MV_WHOLE != op);
+    }
+
+    static bool usesScalar(const VanadisVectorIntOp op, const VanadisVectorOperandForm form)
+    {
+        return (VanadisVectorOperandForm::VX == form);
+    }
+
+    static uint16_t countVectorIn(const VanadisVectorIntOp op, const VanadisVectorOperandForm form, const bool masked)
+    {
+        return (usesVS2(op) ? 1 : 0) + (usesVS1(op, form) ? 1 : 0) + ((VanadisVectorIntOp::MV_X_S == op) ? 0 : 1) +
+               (masked ? 1 : 0);
+    }
+
+    static bool isReduction(const VanadisVectorIntOp op)
+    {
+        return (op >= VanadisVectorIntOp::REDSUM) && (op <= VanadisVectorIntOp::REDXOR);
+    }
+
+    static bool isCompare(const VanadisVectorIntOp op)
+    {
+        return (op >= VanadisVectorIntOp::MSEQ) && (op <= VanadisVectorIntOp::MSGT);
+    }
+
+    template <typename T, typename U>
+    T compute(const T a, const T b, const T d) const
+    {
+        const uint32_t shift_mask = (sizeof(T) * 8) - 1;
+
+        switch ( op ) {
+        case VanadisVectorIntOp::ADD: return (T)((U)a + (U)b);
+        case VanadisVectorIntOp::SUB: return (T)((U)a - (U)b);
+        case VanadisVectorIntOp::RSUB: return (T)((U)b - (U)a);
+        case VanadisVectorIntOp::MINU: return ((U)a < (U)b) ? a : b;
+        case VanadisVectorIntOp::MIN: return (a < b) ? a : b;
+        case VanadisVectorIntOp::MAXU: return ((U)a > (U)b) ? a : b;
+        case VanadisVectorIntOp::MAX: return (a > b) ? a : b;
+        case VanadisVectorIntOp::AND: return a & b;
+        case VanadisVectorIntOp::OR: return a | b;
+        case VanadisVectorIntOp::XOR: return a ^ b;
+        case VanadisVectorIntOp::SLL: return (T)((U)a << ((U)b & shift_mask));
+        case VanadisVectorIntOp::SRL: return (T)((U)a >> ((U)b & shift_mask));
+        case VanadisVectorIntOp::SRA: return (T)(a >> ((U)b & shift_mask));
+        case VanadisVectorIntOp::MUL: return (T)((U)a * (U)b);
+        case VanadisVectorIntOp::DIVU: return (0 == b) ? (T)(~((U)0)) : (T)((U)a / (U)b);
+        case VanadisVectorIntOp::DIV:
+            if ( 0 == b ) { return (T)-1; }
+            if ( (-1 == b) && (std::numeric_limits<T>::min() == a) ) { return a; }
+            return a / b;
+        case VanadisVectorIntOp::REMU: return (0 == b) ? a : (T)((U)a % (U)b);
+        case VanadisVectorIntOp::REM:
+            if ( 0 == b ) { return a; }
+            if ( (-1 == b) && (std::numeric_limits<T>::min() == a) ) { return 0; }
+            return a % b;
+        case VanadisVectorIntOp::MACC: return (T)(((U)b * (U)a) + (U)d);
+        case VanadisVectorIntOp::NMSAC: return (T)((U)d - ((U)b * (U)a));
+        case VanadisVectorIntOp::MADD: return (T)(((U)b * (U)d) + (U)a);
+        case VanadisVectorIntOp::NMSUB: return (T)((U)a - ((U)b * (U)d));
+        case VanadisVectorIntOp::MV: return b;
+        default: return d;
+        }
+    }
+
+    template <typename T, typename U>
+    bool compare(const T a, const T b) const
+    {
+        switch ( op ) {
+        case VanadisVectorIntOp::MSEQ: return a == b;
+        case VanadisVectorIntOp::MSNE: return a != b;
+        case VanadisVectorIntOp::MSLTU: return (U)a < (U)b;
+        case VanadisVectorIntOp::MSLT: return a < b;
+        case VanadisVectorIntOp::MSLEU: return (U)a <= (U)b;
+        case VanadisVectorIntOp::MSLE: return a <= b;
+        case VanadisVectorIntOp::MSGTU: return (U)a > (U)b;
+        case VanadisVectorIntOp::MSGT: return a > b;
+        default: return false;
+        }
+    }
+
+    template <typename T, typename U>
+    T reduce(const T acc, const T value) const
+    {
+        switch ( op ) {
+        case VanadisVectorIntOp::REDSUM: return (T)((U)acc + (U)value);
+        case VanadisVectorIntOp::REDMAXU: return ((U)acc > (U)value) ? acc : value;
+        case VanadisVectorIntOp::REDMAX: return (acc > value) ? acc : value;
+        case VanadisVectorIntOp::REDMINU: return ((U)acc < (U)value) ? acc : value;
+        case VanadisVectorIntOp::REDMIN: return (acc < value) ? acc : value;
+        case VanadisVectorIntOp::REDAND: return acc & value;
+        case VanadisVectorIntOp::REDOR: return acc | value;
+        case VanadisVectorIntOp::REDXOR: return acc ^ value;
+        default: return acc;
+        }
+    }
+
+    template <typename T, typename U>
+    void executeSEW(VanadisRegisterFile* regFile, const uint64_t vl)
+    {
+        uint8_t vs2_buffer[VANADIS_VECTOR_MAX_BYTES];
+        uint8_t vs1_buffer[VANADIS_VECTOR_MAX_BYTES];
+        uint8_t vd_buffer[VANADIS_VECTOR_MAX_BYTES];
+        uint8_t mask_buffer[VANADIS_VECTOR_MAX_BYTES];
+
+        if ( idx_vs2 >= 0 ) { readVectorIn(regFile, idx_vs2, vs2_buffer); }
+        if ( idx_vs1 >= 0 ) { readVectorIn(regFile, idx_vs1, vs1_buffer); }
+        if ( idx_vd >= 0 ) { readVectorIn(regFile, idx_vd, vd_buffer); }
+        if ( idx_mask >= 0 ) { readVectorIn(regFile, idx_mask, mask_buffer); }
+
+        T scalar = static_cast<T>(immediate);
+
+        if ( VanadisVectorOperandForm::VX == form ) { scalar = regFile->getIntReg<T>(phys_int_regs_in[2]); }
+
+        const uint64_t max_vl     = vector_bytes / sizeof(T);
+        const uint64_t element_vl = (vl < max_vl) ? vl : max_vl;
+
+        if ( VanadisVectorIntOp::MV_X_S == op ) {
+            regFile->setIntReg<T>(phys_int_regs_out[0], vanadis_vector_get<T>(vs2_buffer, 0));
+            return;
+        }
+        else if ( VanadisVectorIntOp::MV_S_X == op ) {
+            if ( element_vl > 0 ) { vanadis_vector_set<T>(vd_buffer, 0, scalar); }
+        }
+        else if ( VanadisVectorIntOp::MV_WHOLE == op ) {
+            std::memcpy(vd_buffer, vs2_buffer, vector_bytes);
+        }
+        else if ( isReduction(op) ) {
+            if ( element_vl > 0 ) {
+                T acc = vanadis_vector_get<T>(vs1_buffer, 0);
+
+                for ( uint64_t i = 0; i < element_vl; ++i ) {
+                    if ( (idx_mask < 0) || vanadis_vector_mask_active(mask_buffer, i) ) {
+                        acc = reduce<T, U>(acc, vanadis_vector_get<T>(vs2_buffer, i));
+                    }
+                }
+
+                vanadis_vector_set<T>(vd_buffer, 0, acc);
+            }
+        }
+        else if ( isCompare(op) ) {
+            for ( uint64_t i = 0; i < element_vl; ++i ) {
+                if ( (idx_mask >= 0) && !vanadis_vector_mask_active(mask_buffer, i) ) { continue; }
+
+                const T b = (idx_vs1 >= 0) ? vanadis_vector_get<T>(vs1_buffer, i) : scalar;
+
+                if ( compare<T, U>(vanadis_vector_get<T>(vs2_buffer, i), b) ) {
+                    vd_buffer[i >> 3] |= (1 << (i & 0x7));
+                }
+                else {
+                    vd_buffer[i >> 3] &= ~(1 << (i & 0x7));
+                }
+            }
+        }
+        else {
+            for ( uint64_t i = 0; i < element_vl; ++i ) {
+                const T b = (idx_vs1 >= 0) ? vanadis_vector_get<T>(vs1_buffer, i) : scalar;
+
+                if ( VanadisVectorIntOp::MERGE == op ) {
+                    // v0 selects between the operand and vs2, it is not a mask here
+                    vanadis_vector_set<T>(
+                        vd_buffer, i, vanadis_vector_mask_active(mask_buffer, i) ? b : vanadis_vector_get<T>(vs2_buffer, i));
+                    continue;
+                }
+
+                if ( (idx_mask >= 0) && !vanadis_vector_mask_active(mask_buffer, i) ) { continue; }
+
+                if ( VanadisVectorIntOp::ID == op ) {
+                    vanadis_vector_set<T>(vd_buffer, i, static_cast<T>(i));
+                }
+                else {
+                    const T a = (idx_vs2 >= 0) ? vanadis_vector_get<T>(vs2_buffer, i) : 0;
+                    vanadis_vector_set<T>(vd_buffer, i, compute<T, U>(a, b, vanadis_vector_get<T>(vd_buffer, i)));
+                }
+            }
+        }
+
+        writeVectorOut(regFile, vd_buffer);
+    }
+
+    const VanadisVectorIntOp       op;
+    const VanadisVectorOperandForm form;
+    const int64_t                  immediate;
+    const bool                     is_masked;
+
+    int16_t idx_vs2;
+    int16_t idx_vs1;
+    int16_t idx_vd;
+    int16_t idx_mask;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,163 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_VECTOR_LOAD
+#define _H_VANADIS_VECTOR_LOAD
+
+#include "inst/vload.h"
+#include "inst/vvecinst.h"
+
+namespace SST {
+namespace Vanadis {
+
+/*
+ * Vector loads. Integer registers in are { rs1, vl, vtype, (stride) }, FP
+ * registers in are { old vd, (index vector), (v0) } so that inactive and tail
+ * elements are kept, FP registers out are the slices of vd. The LSQ computes
+ * the element accesses, coalesces them into cache line sized requests and
+ * writes the destination once every request has returned.
+ */
+class VanadisVectorLoadInstruction : public VanadisLoadInstruction
+{
+public:
+    VanadisVectorLoadInstruction(
+        const uint64_t addr, const uint32_t hw_thr, const VanadisDecoderOptions* isa_opts, const uint16_t vlen_bytes,
+        const uint16_t vl_reg, const uint16_t vtype_reg, const VanadisVectorMemoryMode mode, const uint16_t vd,
+        const uint16_t rs1, const uint16_t rs2_vs2, const uint16_t eew_bytes, const bool masked) :
+        VanadisLoadInstruction(
+            addr, hw_thr, isa_opts, 0, eew_bytes, MEM_TRANSACTION_NONE, LOAD_FP_REGISTER,
+            (VanadisVectorMemoryMode::STRIDED == mode) ? 4 : 3, 0,
+            (vlen_bytes / VANADIS_VECTOR_SLICE_BYTES) *
+                (1 + ((VanadisVectorMemoryMode::INDEXED == mode) ? 1 : 0) + (masked ? 1 : 0)),
+            vlen_bytes / VANADIS_VECTOR_SLICE_BYTES),
+        vector_bytes(vlen_bytes),
+        slices(vlen_bytes / VANADIS_VECTOR_SLICE_BYTES),
+        vec_mode(mode),
+        is_masked(masked)
+    {
+        const uint16_t first_vec_reg = isa_opts->countISAFPRegisters() - (32 * slices);
+
+        isa_int_regs_in[0] = rs1;
+        isa_int_regs_in[1] = vl_reg;
+        isa_int_regs_in[2] = vtype_reg;
+
+        if ( VanadisVectorMemoryMode::STRIDED == mode ) { isa_int_regs_in[3] = rs2_vs2; }
+
+        uint16_t next = 0;
+
+        for ( uint16_t i = 0; i < slices; ++i ) {
+            isa_fp_regs_in[next++] = vanadis_vector_isa_reg(first_vec_reg, vd, i, slices);
+            isa_fp_regs_out[i]     = vanadis_vector_isa_reg(first_vec_reg, vd, i, slices);
+        }
+
+        if ( VanadisVectorMemoryMode::INDEXED == mode ) {
+            for ( uint16_t i = 0; i < slices; ++i ) {
+                isa_fp_regs_in[next++] = vanadis_vector_isa_reg(first_vec_reg, rs2_vs2, i, slices);
+            }
+        }
+
+        if ( masked ) {
+            for ( uint16_t i = 0; i < slices; ++i ) {
+                isa_fp_regs_in[next++] = vanadis_vector_isa_reg(first_vec_reg, 0, i, slices);
+            }
+        }
+    }
+
+    VanadisVectorLoadInstruction* clone() override { return new VanadisVectorLoadInstruction(*this); }
+
+    bool        isVectorLoad() const override { return true; }
+    const char* getInstCode() const override
+    {
+        switch ( vec_mode ) {
+        case VanadisVectorMemoryMode::UNIT: return "VLE";
+        case VanadisVectorMemoryMode::STRIDED: return "VLSE";
+        case VanadisVectorMemoryMode::INDEXED: return "VLXEI";
+        case VanadisVectorMemoryMode::WHOLE_REG: return "VL1R";
+        case VanadisVectorMemoryMode::MASK: return "VLM";
+        default: return "VLOADUNK";
+        }
+    }
+
+    void printToBuffer(char* buffer, size_t buffer_size) override
+    {
+        snprintf(
+            buffer, buffer_size,
+            "%s (eew: %" PRIu16 " bytes) v%" PRIu16 " <- memory[ %5" PRIu16 " ] (phys: memory[ %5" PRIu16
+            " ]) / masked: %s",
+            getInstCode(), load_width, (uint16_t)((isa_fp_regs_out[0] - firstVectorRegister()) / slices),
+            isa_int_regs_in[0], phys_int_regs_in[0], is_masked ? "yes" : "no");
+    }
+
+    uint16_t getVectorBytes() const { return vector_bytes; }
+
+    // Returns false if the access pattern does not fit in one vector register
+    bool computeVectorAccesses(
+        SST::Output* output, VanadisRegisterFile* regFile, std::vector<VanadisVectorMemoryAccess>& accesses)
+    {
+        uint8_t index_buffer[VANADIS_VECTOR_MAX_BYTES];
+        uint8_t mask_buffer[VANADIS_VECTOR_MAX_BYTES];
+
+        uint16_t next = slices;
+
+        if ( VanadisVectorMemoryMode::INDEXED == vec_mode ) {
+            vanadis_vector_read(regFile, &phys_fp_regs_in[next], slices, index_buffer);
+            next += slices;
+        }
+
+        if ( is_masked ) { vanadis_vector_read(regFile, &phys_fp_regs_in[next], slices, mask_buffer); }
+
+        const uint64_t base   = regFile->getIntReg<uint64_t>(phys_int_regs_in[0]);
+        const uint64_t vl     = regFile->getIntReg<uint64_t>(phys_int_regs_in[1]);
+        const uint32_t sew    = vanadis_vector_sew_bytes(regFile->getIntReg<uint64_t>(phys_int_regs_in[2]));
+        const int64_t  stride = (VanadisVectorMemoryMode::STRIDED == vec_mode) ?
+                                    regFile->getIntReg<int64_t>(phys_int_regs_in[3]) : 0;
+
+        if(output->getVerboseLevel() >= 16) {
+            output->verbose(
+                CALL_INFO, 16, 0,
+                "Execute: (0x%llx) %s base: 0x%" PRIx64 " / vl: %" PRIu64 " / sew: %" PRIu32 " / eew: %" PRIu16
+                " / stride: %" PRId64 "\n",
+                getInstructionAddress(), getInstCode(), base, vl, sew, load_width, stride);
+        }
+
+        return vanadis_vector_compute_accesses(
+            vec_mode, vector_bytes, base, stride, vl, sew, load_width, index_buffer,
+            is_masked ? mask_buffer : nullptr, accesses);
+    }
+
+    // Current value of the destination, loaded data is merged into this
+    void readDestination(VanadisRegisterFile* regFile, uint8_t* buffer)
+    {
+        vanadis_vector_read(regFile, &phys_fp_regs_in[0], slices, buffer);
+    }
+
+    void writeDestination(VanadisRegisterFile* regFile, uint8_t* buffer)
+    {
+        vanadis_vector_write(regFile, &phys_fp_regs_out[0], slices, buffer);
+    }
+
+protected:
+    uint16_t firstVectorRegister() const { return isa_options->countISAFPRegisters() - (32 * slices); }
+
+    const uint16_t                vector_bytes;
+    const uint16_t                slices;
+    const VanadisVectorMemoryMode vec_mode;
+    const bool                    is_masked;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
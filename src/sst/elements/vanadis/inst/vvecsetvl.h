@@ -0,0 +1,156 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_VECTOR_SET_VL
+#define _H_VANADIS_VECTOR_SET_VL
+
+#include "inst/vvecinst.h"
+
+namespace SST {
+namespace Vanadis {
+
+enum class VanadisVectorAVLSource {
+    REGISTER,  // vsetvli / vsetvl with rs1 != x0
+    IMMEDIATE, // vsetivli
+    VLMAX,     // rs1 == x0, rd != x0
+    KEEP       // rs1 == x0, rd == x0 (keep the current vl)
+};
+
+/*
+ * vsetvli, vsetivli and vsetvl. The vtype comes either from the immediate
+ * or from a register (vsetvl). Writes rd, vl and vtype.
+ */
+class VanadisVectorSetVLInstruction : public VanadisInstruction
+{
+public:
+    VanadisVectorSetVLInstruction(
+        const uint64_t addr, const uint32_t hw_thr, const VanadisDecoderOptions* isa_opts, const uint16_t vlen_bytes,
+        const uint16_t vl_reg, const uint16_t vtype_reg, const uint16_t rd, const uint16_t rs1,
+        const VanadisVectorAVLSource avl_src, const uint64_t avl_imm, const bool vtype_from_reg, const uint16_t rs2,
+        const uint64_t vtype_imm) :
+        VanadisInstruction(
+            addr, hw_thr, isa_opts, 2 + (vtype_from_reg ? 1 : 0), 3, 2 + (vtype_from_reg ? 1 : 0), 3, 0, 0, 0, 0),
+        vector_bytes(vlen_bytes),
+        avl_source(avl_src),
+        avl_immediate(avl_imm),
+        vtype_register(vtype_from_reg),
+        vtype_immediate(vtype_imm)
+    {
+        // AVL (or zero when not needed) and the current vl
+        isa_int_regs_in[0] = (VanadisVectorAVLSource::REGISTER == avl_src) ? rs1 : 0;
+        isa_int_regs_in[1] = vl_reg;
+
+        if ( vtype_from_reg ) { isa_int_regs_in[2] = rs2; }
+
+        isa_int_regs_out[0] = rd;
+        isa_int_regs_out[1] = vl_reg;
+        isa_int_regs_out[2] = vtype_reg;
+    }
+
+    VanadisVectorSetVLInstruction* clone() override { return new VanadisVectorSetVLInstruction(*this); }
+    VanadisFunctionalUnitType      getInstFuncType() const override { return INST_INT_ARITH; }
+    const char*                    getInstCode() const override
+    {
+        return vtype_register ? "VSETVL" : (VanadisVectorAVLSource::IMMEDIATE == avl_source) ? "VSETIVLI" : "VSETVLI";
+    }
+
+    void printToBuffer(char* buffer, size_t buffer_size) override
+    {
+        snprintf(
+            buffer, buffer_size,
+            "%s %5" PRIu16 " <- avl: %5" PRIu16 " / imm: %" PRIu64 " / vtype: 0x%" PRIx64 " (phys: %5" PRIu16
+            " <- %5" PRIu16 ")",
+            getInstCode(), isa_int_regs_out[0], isa_int_regs_in[0], avl_immediate, vtype_immediate,
+            phys_int_regs_out[0], phys_int_regs_in[0]);
+    }
+
+    // Maximum number of elements for a vtype, LMUL > 1 is clamped to 1 because
+    // register groups are not modeled, returns 0 if the vtype is not supported
+    static uint64_t computeVLMax(const uint64_t vlen_bytes, const uint64_t vtype)
+    {
+        const uint64_t vsew  = (vtype >> 3) & 0x7;
+        const uint64_t vlmul = vtype & 0x7;
+
+        if ( vsew > 3 || 4 == vlmul ) { return 0; }
+
+        uint64_t vlmax = vlen_bytes >> vsew;
+
+        // fractional LMUL, 5 = 1/8, 6 = 1/4, 7 = 1/2
+        if ( vlmul > 4 ) { vlmax = vlmax >> (8 - vlmul); }
+
+        return vlmax;
+    }
+
+    void execute(SST::Output* output, VanadisRegisterFile* regFile) override
+    {
+        const uint64_t vtype = vtype_register ? regFile->getIntReg<uint64_t>(phys_int_regs_in[2]) : vtype_immediate;
+        const uint64_t vlmax = computeVLMax(vector_bytes, vtype);
+
+        uint64_t new_vl    = 0;
+        uint64_t new_vtype = vtype & 0xFF;
+
+        if ( 0 == vlmax ) {
+            // vill
+            new_vtype = 1ULL << 63;
+        }
+        else {
+            uint64_t avl = 0;
+
+            switch ( avl_source ) {
+            case VanadisVectorAVLSource::REGISTER:
+                avl = regFile->getIntReg<uint64_t>(phys_int_regs_in[0]);
+                break;
+            case VanadisVectorAVLSource::IMMEDIATE:
+                avl = avl_immediate;
+                break;
+            case VanadisVectorAVLSource::VLMAX:
+                avl = vlmax;
+                break;
+            case VanadisVectorAVLSource::KEEP:
+                avl = regFile->getIntReg<uint64_t>(phys_int_regs_in[1]);
+                break;
+            }
+
+            new_vl = (avl < vlmax) ? avl : vlmax;
+        }
+
+#ifdef VANADIS_BUILD_DEBUG
+        if(output->getVerboseLevel() >= 16) {
+            output->verbose(
+                CALL_INFO, 16, 0,
+                "Execute: (addr=0x%llx) %s vlmax: %" PRIu64 " / vl: %" PRIu64 " / vtype: 0x%" PRIx64 "\n",
+                getInstructionAddress(), getInstCode(), vlmax, new_vl, new_vtype);
+        }
+#endif
+
+        regFile->setIntReg<uint64_t>(phys_int_regs_out[0], new_vl);
+        regFile->setIntReg<uint64_t>(phys_int_regs_out[1], new_vl);
+        regFile->setIntReg<uint64_t>(phys_int_regs_out[2], new_vtype);
+
+        markExecuted();
+    }
+
+protected:
+    const uint16_t               vector_bytes;
+    const VanadisVectorAVLSource avl_source;
+    const uint64_t               avl_immediate;
+    const bool                   vtype_register;
+    const uint64_t               vtype_immediate;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
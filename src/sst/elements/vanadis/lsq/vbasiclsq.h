@@ -23,9 +23,11 @@
 #include "lsq/vlsq.h"
 #include "lsq/vbasiclsqentry.h"
 #include "util/vsignx.h"
+#include "util/vlinesplit.h"
 #include "inst/vstorecond.h"
 
 #include <cassert>
+#include <algorithm>
 #include <cinttypes>
 #include <cstdint>
 #include <vector>
@@ -70,7 +72,9 @@ public:
                                 { "stores_in_flight", "Count the number of stores which are in-flight", "operations", 1},
                                 { "store_buffer_entries", "Count the number of stores held in the store buffer", "operations", 1},
                                 { "split_stores", "Count the number of stores which are fractured due to cache boundaries", "operations", 1},
-                                { "split_loads", "Count the number of loads which are fractured due to cache boundaries", "operations", 1})
+                                { "split_loads", "Count the number of loads which are fractured due to cache boundaries", "operations", 1},
+                                { "vector_load_requests", "Count the number of memory requests generated by vector loads", "requests", 1},
+                                { "vector_store_requests", "Count the number of memory requests generated by vector stores", "requests", 1})
 
     VanadisBasicLoadStoreQueue(ComponentId_t id, Params& params) : VanadisLoadStoreQueue(id, params),
         max_stores(params.find<size_t>("max_stores", 8)),
@@ -103,6 +107,9 @@ public:
         stat_stores_pending = registerStatistic<uint64_t>("stores_in_flight", "1");
         stat_loads_pending = registerStatistic<uint64_t>("loads_in_flight", "1");
         stat_op_q_size = registerStatistic<uint64_t>("operations_pending");
+
+        stat_vector_load_requests = registerStatistic<uint64_t>("vector_load_requests", "1");
+        stat_vector_store_requests = registerStatistic<uint64_t>("vector_store_requests", "1");
     }
 
     virtual ~VanadisBasicLoadStoreQueue() {
@@ -292,6 +299,34 @@ protected:
                 load_ins->flagError();
             }
 
+            if(load_entry->isVectorEntry()) {
+                VanadisBasicVectorLoadPendingEntry* vector_entry = static_cast<VanadisBasicVectorLoadPendingEntry*>(load_entry);
+
+                if (ev->vAddr < 64) {
+                    load_ins->flagError();
+                }
+
+                vector_entry->copyResponse(ev->getID(), ev->data);
+                vector_entry->removeRequest(ev->getID());
+
+                if(0 == vector_entry->countRequests()) {
+                    out->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_LOAD_FLG,
+                        "---> LSQ Execute: %s (0x%llx / thr: %" PRIu32 ") vector load all requests returned, marked executed.\n",
+                        load_ins->getInstCode(), load_ins->getInstructionAddress(), hw_thr);
+
+                    static_cast<VanadisVectorLoadInstruction*>(load_ins)->writeDestination(
+                        lsq->registerFiles->at(hw_thr), vector_entry->getBuffer());
+
+                    load_ins->markExecuted();
+                    lsq->stat_loads_executed->addData(1);
+                    lsq->loads_pending.erase(load_itr);
+                    delete vector_entry;
+                }
+
+                delete ev;
+                return;
+            }
+
             uint16_t target_reg = 0;
             uint16_t target_isa_reg = 0;
             uint64_t reg_offset  = load_ins->getRegisterOffset();
@@ -583,6 +618,11 @@ protected:
     bool issueStore(VanadisBasicStorePendingEntry* store_entry, 
             VanadisStoreInstruction* store_ins) {
 
+        if(store_entry->isVectorEntry()) {
+            return issueVectorStore(static_cast<VanadisBasicVectorStorePendingEntry*>(store_entry),
+                static_cast<VanadisVectorStoreInstruction*>(store_ins));
+        }
+
         const uint64_t store_address = store_entry->getStoreAddress();
         const uint64_t store_width   = store_entry->getStoreWidth();
         StandardMem::Request* store_req = nullptr;
@@ -728,6 +768,124 @@ protected:
         return false;
     }
 
+    // vector stores are always standard stores, every segment is sent and tracked
+    // as an in-flight store so the entry can be retired immediately
+    bool issueVectorStore(VanadisBasicVectorStorePendingEntry* store_entry,
+            VanadisVectorStoreInstruction* store_ins) {
+
+        uint8_t store_data[VANADIS_VECTOR_MAX_BYTES];
+        store_ins->readStoreData(registerFiles->at(store_entry->getHWThread()), store_data);
+
+        for(const VanadisVectorMemoryAccess& segment : store_entry->getSegments()) {
+            std::vector<uint8_t> payload(&store_data[segment.offset], &store_data[segment.offset + segment.width]);
+
+            if(output->getVerboseLevel() >= 9) {
+                output->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_STORE_FLG, "---> [memory-transaction]: vector store ins: 0x%llx segment-at: 0x%llx width: %" PRIu32 " reg-offset: %" PRIu32 "\n",
+                    store_ins->getInstructionAddress(), segment.address, segment.width, segment.offset);
+            }
+
+            StandardMem::Request* store_req = new StandardMem::Write(segment.address & address_mask, payload.size(), payload,
+                false, 0, segment.address, store_ins->getInstructionAddress(), store_ins->getHWThread());
+
+            std_stores_in_flight.insert(store_req->getID());
+            memInterface->send(store_req);
+        }
+
+        stat_vector_store_requests->addData(store_entry->getSegments().size());
+        return true;
+    }
+
+    // Merge element accesses which are contiguous in memory and in the register into
+    // single requests, no request crosses a cache line
+    void buildVectorSegments(const std::vector<VanadisVectorMemoryAccess>& accesses,
+            std::vector<VanadisVectorMemoryAccess>& segments) const {
+
+        for(const VanadisVectorMemoryAccess& next : accesses) {
+            if(!segments.empty()) {
+                VanadisVectorMemoryAccess& last = segments.back();
+
+                if( (last.address + last.width == next.address) && (last.offset + last.width == next.offset) &&
+                    (vanadis_line_remainder(last.address, cache_line_width) >= (last.width + next.width)) ) {
+                    last.width += next.width;
+                    continue;
+                }
+            }
+
+            uint64_t address   = next.address;
+            uint32_t offset    = next.offset;
+            uint32_t remaining = next.width;
+
+            while(remaining > 0) {
+                const uint32_t line_bytes = (uint32_t) std::min((uint64_t) remaining,
+                    vanadis_line_remainder(address, cache_line_width));
+
+                segments.emplace_back(address, offset, line_bytes);
+
+                address   += line_bytes;
+                offset    += line_bytes;
+                remaining -= line_bytes;
+            }
+        }
+    }
+
+    // returns false if the load must wait for a conflicting store
+    bool issueVectorLoad(VanadisVectorLoadInstruction* load_ins, VanadisRegisterFile* hw_thr_reg) {
+        std::vector<VanadisVectorMemoryAccess> accesses;
+        std::vector<VanadisVectorMemoryAccess> segments;
+
+        if(UNLIKELY(! load_ins->computeVectorAccesses(output, hw_thr_reg, accesses))) {
+            output->verbose(CALL_INFO, 16, 0, "---> vector load ins: 0x%llx / thr: %" PRIu32 " access does not fit in a vector register, traps error.\n",
+                load_ins->getInstructionAddress(), load_ins->getHWThread());
+            load_ins->flagError();
+            return true;
+        }
+
+        buildVectorSegments(accesses, segments);
+
+        for(const VanadisVectorMemoryAccess& segment : segments) {
+            if(UNLIKELY(checkStoreConflict(load_ins->getHWThread(), segment.address, segment.width))) {
+                if(output->getVerboseLevel() >= 16) {
+                    output->verbose(CALL_INFO, 16, 0, "---> vector load ins: 0x%llx / thr: %" PRIu32 " conflicts with store entry, will not issue until conflict is resolved (segment-addr: 0x%llx / width: %" PRIu32 ")\n",
+                        load_ins->getInstructionAddress(), load_ins->getHWThread(), segment.address, segment.width);
+                }
+
+                return false;
+            }
+        }
+
+        uint8_t old_value[VANADIS_VECTOR_MAX_BYTES];
+        load_ins->readDestination(hw_thr_reg, old_value);
+
+        if(segments.empty()) {
+            // no active elements, destination is unchanged
+            load_ins->writeDestination(hw_thr_reg, old_value);
+            load_ins->markExecuted();
+            stat_loads_executed->addData(1);
+            return true;
+        }
+
+        VanadisBasicVectorLoadPendingEntry* load_entry = new VanadisBasicVectorLoadPendingEntry(load_ins,
+            segments.front().address, load_ins->getVectorBytes(), old_value);
+
+        for(const VanadisVectorMemoryAccess& segment : segments) {
+            if(output->getVerboseLevel() >= 9) {
+                output->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_LOAD_FLG, "---> [memory-transaction]: vector load ins: 0x%llx segment-at: 0x%llx width: %" PRIu32 " reg-offset: %" PRIu32 "\n",
+                    load_ins->getInstructionAddress(), segment.address, segment.width, segment.offset);
+            }
+
+            StandardMem::Request* load_req = new StandardMem::Read(segment.address & address_mask, segment.width, 0,
+                segment.address, load_ins->getInstructionAddress(), load_ins->getHWThread());
+
+            load_entry->addRequest(load_req->getID(), segment.offset);
+            memInterface->send(load_req);
+        }
+
+        stat_vector_load_requests->addData(segments.size());
+        loads_pending.push_back(load_entry);
+
+        return true;
+    }
+
     void issueLoad(VanadisLoadInstruction* load_ins, uint64_t load_address, uint64_t load_width) {
         StandardMem::Request* load_req = nullptr;
 
@@ -872,6 +1030,16 @@ protected:
 
                 VanadisRegisterFile* hw_thr_reg = registerFiles->at(load_ins->getHWThread());
 
+                if(load_ins->isVectorLoad()) {
+                    if(! issueVectorLoad(static_cast<VanadisVectorLoadInstruction*>(load_ins), hw_thr_reg)) {
+                        return false;
+                    }
+
+                    delete op_q.front();
+                    op_q.pop_front();
+                    return true;
+                }
+
                 uint64_t load_address = 0;
                 uint16_t load_width   = 0;
 
@@ -932,6 +1100,14 @@ protected:
                 
                 VanadisRegisterFile* hw_thr_reg = registerFiles->at(store_ins->getHWThread());
 
+                if(store_ins->isVectorStore()) {
+                    pushVectorStore(static_cast<VanadisVectorStoreInstruction*>(store_ins), hw_thr_reg);
+
+                    delete op_q.front();
+                    op_q.pop_front();
+                    return true;
+                }
+
                 uint64_t store_address = 0;
                 uint16_t store_width   = 0;
 
@@ -1002,6 +1178,44 @@ protected:
         return false;
     }
 
+    void pushVectorStore(VanadisVectorStoreInstruction* store_ins, VanadisRegisterFile* hw_thr_reg) {
+        std::vector<VanadisVectorMemoryAccess> accesses;
+        std::vector<VanadisVectorMemoryAccess> segments;
+
+        if(UNLIKELY(! store_ins->computeVectorAccesses(output, hw_thr_reg, accesses))) {
+            output->verbose(CALL_INFO, 16, 0, "----> warning: 0x%llx / thr: %" PRIu32 " vector store does not fit in a vector register, traps error.\n",
+                store_ins->getInstructionAddress(), store_ins->getHWThread());
+            store_ins->flagError();
+            store_ins->markExecuted();
+            return;
+        }
+
+        buildVectorSegments(accesses, segments);
+
+        if(segments.empty()) {
+            // no active elements so nothing is written
+            store_ins->markExecuted();
+            stat_stores_executed->addData(1);
+            return;
+        }
+
+        uint64_t span_start = segments.front().address;
+        uint64_t span_end   = segments.front().address + segments.front().width;
+
+        for(const VanadisVectorMemoryAccess& segment : segments) {
+            span_start = std::min(span_start, segment.address);
+            span_end   = std::max(span_end, segment.address + segment.width);
+        }
+
+        if(output->getVerboseLevel() >= 16) {
+            output->verbose(CALL_INFO, 16, 0, "----> vector store span: 0x%llx - 0x%llx segments: %" PRIu64 " thr: %" PRIu32 "\n",
+                span_start, span_end, (uint64_t) segments.size(), store_ins->getHWThread());
+        }
+
+        stores_pending.push_back(new VanadisBasicVectorStorePendingEntry(store_ins, span_start,
+            span_end - span_start, segments));
+    }
+
     bool operationStraddlesCacheLine(uint64_t address, uint64_t width) const {
         const uint64_t cache_line_left  = (address / cache_line_width);
         const uint64_t cache_line_right = ((address + width - 1) / cache_line_width);
@@ -1095,6 +1309,8 @@ protected:
     Statistic<uint64_t>* stat_split_loads;
     Statistic<uint64_t>* stat_stored_bytes;
     Statistic<uint64_t>* stat_loaded_bytes;
+    Statistic<uint64_t>* stat_vector_load_requests;
+    Statistic<uint64_t>* stat_vector_store_requests;
 };
 
 } // namespace Vanadis
@@ -5,6 +5,10 @@
 #include "inst/vload.h"
 #include "inst/vstore.h"
 #include "inst/vfence.h"
+#include "inst/vvecload.h"
+#include "inst/vvecstore.h"
+
+#include <unordered_map>
 
 using namespace SST::Interfaces;
 
@@ -70,6 +74,8 @@ public:
         requests.clear();
     }
 
+    virtual bool isVectorEntry() const { return false; }
+
     bool     isDispatched() const { return dispatched; }
     void     markDispatched() { dispatched = true; }
 
@@ -164,6 +170,24 @@ protected:
     const VanadisStoreRegisterType valueRegisterType;
 };
 
+// A vector store covers the span from its lowest to its highest byte so
+// conflict checks against later loads are conservative, the segments are
+// already coalesced and split at cache line boundaries.
+class VanadisBasicVectorStorePendingEntry : public VanadisBasicStorePendingEntry {
+public:
+    VanadisBasicVectorStorePendingEntry(VanadisVectorStoreInstruction* store_ins, uint64_t addr, uint64_t width,
+        std::vector<VanadisVectorMemoryAccess>& store_segments) :
+        VanadisBasicStorePendingEntry(store_ins, addr, width, STORE_FP_REGISTER, store_ins->getPhysFPRegIn(0)),
+        segments(store_segments) {}
+
+    bool isVectorEntry() const override { return true; }
+
+    const std::vector<VanadisVectorMemoryAccess>& getSegments() const { return segments; }
+
+protected:
+    std::vector<VanadisVectorMemoryAccess> segments;
+};
+
 class VanadisBasicLoadEntry : public VanadisBasicLoadStoreEntry {
 public:
     VanadisBasicLoadEntry(VanadisLoadInstruction* load_ins) : VanadisBasicLoadStoreEntry(load_ins) {}
@@ -186,6 +210,8 @@ public:
         requests.clear();
     }
 
+    virtual bool isVectorEntry() const { return false; }
+
     void addRequest(StandardMem::Request::id_t req) {
         requests.push_back(req);
     }
@@ -245,5 +271,41 @@ protected:
     const uint64_t load_width;
 };
 
+// A vector load is made of several memory requests (one per coalesced segment),
+// the data is gathered into a buffer initialized from the old destination and
+// written back to the vector register once every request has returned.
+class VanadisBasicVectorLoadPendingEntry : public VanadisBasicLoadPendingEntry {
+public:
+    VanadisBasicVectorLoadPendingEntry(VanadisVectorLoadInstruction* load_ins, uint64_t address, uint64_t width,
+        const uint8_t* old_value) :
+        VanadisBasicLoadPendingEntry(load_ins, address, width),
+        buffer(old_value, old_value + load_ins->getVectorBytes()) {}
+
+    bool isVectorEntry() const override { return true; }
+
+    void addRequest(StandardMem::Request::id_t req, uint32_t reg_offset) {
+        VanadisBasicLoadPendingEntry::addRequest(req);
+        request_offsets[req] = reg_offset;
+    }
+
+    void copyResponse(StandardMem::Request::id_t req, const std::vector<uint8_t>& data) {
+        auto offset_itr = request_offsets.find(req);
+
+        if(offset_itr != request_offsets.end()) {
+            for(size_t i = 0; i < data.size() && (offset_itr->second + i) < buffer.size(); ++i) {
+                buffer[offset_itr->second + i] = data[i];
+            }
+
+            request_offsets.erase(offset_itr);
+        }
+    }
+
+    uint8_t* getBuffer() { return &buffer[0]; }
+
+protected:
+    std::vector<uint8_t> buffer;
+    std::unordered_map<StandardMem::Request::id_t, uint32_t> request_offsets;
+};
+
 }
 }
\ No newline at end of file
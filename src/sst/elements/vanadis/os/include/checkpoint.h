@@ -0,0 +1,301 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_NODE_OS_INCLUDE_CHECKPOINT
+#define _H_VANADIS_NODE_OS_INCLUDE_CHECKPOINT
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+namespace OS {
+
+/*
+ * Architectural checkpoint of a node: the register state of every thread,
+ * the virtual memory layout, open files and the contents of every touched
+ * physical page. Pages that are all zero are stored as a flag only and
+ * read-only text pages are not stored at all, they are faulted back in
+ * from the ELF after a restore.
+ */
+struct Checkpoint {
+
+    static const uint64_t Magic   = 0x54504b4353444e56; // "VNDSCKPT"
+    static const uint32_t Version = 2;
+
+    struct Thread {
+        uint32_t core;
+        uint32_t hwThread;
+        uint32_t tid;
+        uint64_t instPtr;
+        uint64_t tlsPtr;
+        uint64_t tidAddress;
+        std::vector<uint64_t> intRegs;
+        std::vector<uint64_t> fpRegs;
+    };
+
+    struct Region {
+        std::string name;
+        uint64_t addr;
+        uint64_t length;
+        uint32_t perms;
+        bool     elfBacked;
+        uint64_t dataStartAddr;
+        std::vector<uint8_t> data;
+    };
+
+    struct Page {
+        uint32_t vpn;
+        uint32_t perms;
+        bool     zero;
+        std::vector<uint8_t> data;
+    };
+
+    struct File {
+        int32_t     fd;
+        int32_t     flags;
+        uint64_t    offset;
+        std::string path;
+    };
+
+    struct Process {
+        uint32_t pid;
+        uint32_t ppid;
+        uint32_t pgid;
+        uint64_t brk;
+        std::string exe;
+        std::vector<Region> regions;
+        std::vector<Page>   pages;
+        std::vector<File>   files;
+        std::vector<Thread> threads;
+    };
+
+    uint32_t pageSize;
+    uint64_t simTimeNano;
+    std::vector<Process> processes;
+
+    bool write( const std::string& path ) {
+        FILE* fp = fopen( path.c_str(), "wb" );
+        if ( nullptr == fp ) { return false; }
+
+        const uint64_t magic = Magic;
+        const uint32_t version = Version;
+
+        put( fp, magic );
+        put( fp, version );
+        put( fp, pageSize );
+        put( fp, simTimeNano );
+        put( fp, (uint32_t) processes.size() );
+
+        for ( auto& proc : processes ) {
+            put( fp, proc.pid );
+            put( fp, proc.ppid );
+            put( fp, proc.pgid );
+            put( fp, proc.brk );
+            putString( fp, proc.exe );
+
+            put( fp, (uint32_t) proc.regions.size() );
+            for ( auto& region : proc.regions ) {
+                putString( fp, region.name );
+                put( fp, region.addr );
+                put( fp, region.length );
+                put( fp, region.perms );
+                put( fp, (uint8_t) region.elfBacked );
+                put( fp, region.dataStartAddr );
+                put( fp, (uint64_t) region.data.size() );
+                fwrite( region.data.data(), 1, region.data.size(), fp );
+            }
+
+            put( fp, (uint32_t) proc.pages.size() );
+            for ( auto& page : proc.pages ) {
+                put( fp, page.vpn );
+                put( fp, page.perms );
+                put( fp, (uint8_t) page.zero );
+                if ( ! page.zero ) {
+                    fwrite( page.data.data(), 1, pageSize, fp );
+                }
+            }
+
+            put( fp, (uint32_t) proc.files.size() );
+            for ( auto& file : proc.files ) {
+                put( fp, file.fd );
+                put( fp, file.flags );
+                put( fp, file.offset );
+                putString( fp, file.path );
+            }
+
+            put( fp, (uint32_t) proc.threads.size() );
+            for ( auto& thread : proc.threads ) {
+                put( fp, thread.core );
+                put( fp, thread.hwThread );
+                put( fp, thread.tid );
+                put( fp, thread.instPtr );
+                put( fp, thread.tlsPtr );
+                put( fp, thread.tidAddress );
+                putVector( fp, thread.intRegs );
+                putVector( fp, thread.fpRegs );
+            }
+        }
+
+        bool ok = ( 0 == ferror( fp ) );
+        fclose( fp );
+        return ok;
+    }
+
+    bool read( const std::string& path ) {
+        FILE* fp = fopen( path.c_str(), "rb" );
+        if ( nullptr == fp ) { return false; }
+
+        bool ok = true;
+        uint64_t magic = 0;
+        uint32_t version = 0;
+        uint32_t count = 0;
+
+        ok = ok && get( fp, magic ) && magic == Magic;
+        ok = ok && get( fp, version ) && version == Version;
+        ok = ok && get( fp, pageSize ) && get( fp, simTimeNano ) && get( fp, count );
+
+        if ( ok ) { processes.resize( count ); }
+
+        for ( size_t p = 0; ok && p < processes.size(); p++ ) {
+            auto& proc = processes[p];
+
+            ok = ok && get( fp, proc.pid ) && get( fp, proc.ppid ) && get( fp, proc.pgid ) && get( fp, proc.brk );
+            ok = ok && getString( fp, proc.exe ) && get( fp, count );
+            if ( ! ok ) { break; }
+
+            proc.regions.resize( count );
+            for ( auto& region : proc.regions ) {
+                uint8_t elfBacked = 0;
+                uint64_t dataLength = 0;
+                ok = ok && getString( fp, region.name ) && get( fp, region.addr ) && get( fp, region.length );
+                ok = ok && get( fp, region.perms ) && get( fp, elfBacked );
+                ok = ok && get( fp, region.dataStartAddr ) && get( fp, dataLength );
+                region.elfBacked = elfBacked;
+                if ( ok ) {
+                    region.data.resize( dataLength );
+                    ok = ( dataLength == fread( region.data.data(), 1, dataLength, fp ) );
+                }
+            }
+
+            ok = ok && get( fp, count );
+            if ( ! ok ) { break; }
+
+            proc.pages.resize( count );
+            for ( auto& page : proc.pages ) {
+                uint8_t zero = 0;
+                ok = ok && get( fp, page.vpn ) && get( fp, page.perms ) && get( fp, zero );
+                page.zero = zero;
+                if ( ok && ! page.zero ) {
+                    page.data.resize( pageSize );
+                    ok = ( pageSize == fread( page.data.data(), 1, pageSize, fp ) );
+                }
+            }
+
+            ok = ok && get( fp, count );
+            if ( ! ok ) { break; }
+
+            proc.files.resize( count );
+            for ( auto& file : proc.files ) {
+                ok = ok && get( fp, file.fd ) && get( fp, file.flags ) && get( fp, file.offset );
+                ok = ok && getString( fp, file.path );
+            }
+
+            ok = ok && get( fp, count );
+            if ( ! ok ) { break; }
+
+            proc.threads.resize( count );
+            for ( auto& thread : proc.threads ) {
+                ok = ok && get( fp, thread.core ) && get( fp, thread.hwThread ) && get( fp, thread.tid );
+                ok = ok && get( fp, thread.instPtr ) && get( fp, thread.tlsPtr ) && get( fp, thread.tidAddress );
+                ok = ok && getVector( fp, thread.intRegs ) && getVector( fp, thread.fpRegs );
+            }
+        }
+
+        fclose( fp );
+        return ok;
+    }
+
+    static bool isZeroPage( const uint8_t* data, size_t length ) {
+        for ( size_t i = 0; i < length; i++ ) {
+            if ( data[i] ) { return false; }
+        }
+        return true;
+    }
+
+  private:
+    // Every integer is stored little-endian one byte at a time so a checkpoint
+    // does not depend on the byte order or struct layout of the host writing it
+    template<typename T>
+    static void put( FILE* fp, const T& value ) {
+        uint64_t bits = (uint64_t) value;
+        uint8_t bytes[sizeof(T)];
+        for ( size_t i = 0; i < sizeof(T); i++ ) {
+            bytes[i] = (uint8_t) ( bits >> ( 8 * i ) );
+        }
+        fwrite( bytes, 1, sizeof(T), fp );
+    }
+
+    template<typename T>
+    static bool get( FILE* fp, T& value ) {
+        uint8_t bytes[sizeof(T)];
+        if ( sizeof(T) != fread( bytes, 1, sizeof(T), fp ) ) { return false; }
+        uint64_t bits = 0;
+        for ( size_t i = 0; i < sizeof(T); i++ ) {
+            bits |= ( (uint64_t) bytes[i] ) << ( 8 * i );
+        }
+        value = (T) bits;
+        return true;
+    }
+
+    static void putString( FILE* fp, const std::string& str ) {
+        put( fp, (uint32_t) str.size() );
+        fwrite( str.data(), 1, str.size(), fp );
+    }
+
+    static bool getString( FILE* fp, std::string& str ) {
+        uint32_t length = 0;
+        if ( ! get( fp, length ) ) { return false; }
+        str.resize( length );
+        return length == fread( &str[0], 1, length, fp );
+    }
+
+    static void putVector( FILE* fp, const std::vector<uint64_t>& vec ) {
+        put( fp, (uint32_t) vec.size() );
+        for ( auto value : vec ) {
+            put( fp, value );
+        }
+    }
+
+    static bool getVector( FILE* fp, std::vector<uint64_t>& vec ) {
+        uint32_t length = 0;
+        if ( ! get( fp, length ) ) { return false; }
+        vec.resize( length );
+        for ( auto& value : vec ) {
+            if ( ! get( fp, value ) ) { return false; }
+        }
+        return true;
+    }
+};
+
+}
+}
+}
+
+#endif
@@ -25,6 +25,8 @@
 #include <unistd.h>
 #include <unordered_map>
 
+#include "os/include/checkpoint.h"
+
 namespace SST {
 namespace Vanadis {
 
@@ -168,6 +170,29 @@ public:
         return fd;
     }
 
+    void checkpoint( std::vector<Checkpoint::File>& files ) {
+        for ( const auto& kv: m_fileDescriptors ) {
+            Checkpoint::File file;
+            file.fd = kv.first;
+            file.path = kv.second->getPath();
+            file.flags = fcntl( kv.second->getFileDescriptor(), F_GETFL );
+            file.offset = lseek( kv.second->getFileDescriptor(), 0, SEEK_CUR );
+            files.push_back( file );
+        }
+    }
+
+    // reopen a checkpointed file at its saved offset, the file is expected to still exist
+    int restore( const Checkpoint::File& file ) {
+        if ( m_fileDescriptors.find(file.fd) != m_fileDescriptors.end() ) {
+            close( file.fd );
+        }
+        int fd = open( file.path, file.flags & ~( O_CREAT | O_TRUNC | O_EXCL ), 0, file.fd );
+        if ( fd >= 0 ) {
+            lseek( m_fileDescriptors[fd]->getFileDescriptor(), file.offset, SEEK_SET );
+        }
+        return fd;
+    }
+
     int getDescriptor( uint32_t handle ) {
         auto iter= m_fileDescriptors.find(handle);
         if (iter == m_fileDescriptors.end()) {
@@ -27,6 +27,7 @@
 #include "os/include/futex.h"
 #include "os/include/threadGrp.h"
 #include "os/include/page.h"
+#include "os/include/checkpoint.h"
 #include "os/vphysmemmanager.h"
 
 namespace SST {
@@ -307,6 +308,60 @@ class ProcessInfo {
         return m_fileTable->getPath( handle ); 
     }
 
+    void checkpoint( Checkpoint::Process& proc ) {
+        proc.pid = m_pid;
+        proc.ppid = m_ppid;
+        proc.pgid = m_pgid;
+        proc.brk = getBrk();
+
+        for ( const auto& kv : m_virtMemMap->getRegionMap() ) {
+            auto region = kv.second;
+            Checkpoint::Region tmp = { region->name, region->addr, region->length, region->perms, false, 0 };
+            if ( region->backing ) {
+                tmp.elfBacked = ( nullptr != region->backing->elfInfo );
+                // pages of the region that were never touched still have to come from the backing data 
+                if ( ! tmp.elfBacked && nullptr == region->backing->dev ) {
+                    tmp.dataStartAddr = region->backing->dataStartAddr;
+                    tmp.data = region->backing->data;
+                }
+            }
+            proc.regions.push_back( tmp );
+        }
+
+        m_fileTable->checkpoint( proc.files );
+    }
+
+    void restore( Checkpoint::Process& proc ) {
+        m_ppid = proc.ppid;
+        m_pgid = proc.pgid;
+
+        m_virtMemMap->clear();
+        for ( const auto& region : proc.regions ) {
+            MemoryBacking* backing = nullptr;
+            if ( region.elfBacked ) {
+                backing = new MemoryBacking( m_elfInfo );
+            } else if ( ! region.data.empty() ) {
+                backing = new MemoryBacking;
+                backing->dataStartAddr = region.dataStartAddr;
+                backing->data = region.data;
+            }
+            m_virtMemMap->restoreRegion( region.name, region.addr, region.length, region.perms, backing, proc.brk );
+        }
+
+        for ( const auto& file : proc.files ) {
+            if ( file.fd > 2 && m_fileTable->restore( file ) != file.fd ) {
+                m_dbg.fatal(CALL_INFO, -1, "Error: unable to restore file %s as fd %d\n", file.path.c_str(), file.fd );
+            }
+        }
+
+        if ( ! proc.threads.empty() ) {
+            m_tidAddress = proc.threads[0].tidAddress;
+        }
+
+        printRegions("after checkpoint restore");
+    }
+
+    VirtMemMap* getVirtMemMap() { return m_virtMemMap; }
     Params& getParams() { return m_params; }
     uint64_t getEntryPoint() { return m_elfInfo->getEntryPoint(); }
     VanadisELFInfo* getElfInfo() { return m_elfInfo; }
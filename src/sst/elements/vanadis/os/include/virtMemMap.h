@@ -88,6 +88,8 @@ struct MemoryRegion {
     }
     uint64_t end() { return addr + length; }
 
+    const std::map<unsigned, OS::Page* >& getPageMap() { return m_virtToPhysMap; }
+
     std::string name;
     uint64_t addr;
     size_t length;
@@ -279,6 +281,28 @@ public:
         return 0;
     }
 
+    const std::map< uint64_t, MemoryRegion* >& getRegionMap() { return m_regionMap; }
+
+    // drop every region so the layout can be rebuilt from a checkpoint
+    void clear() {
+        for (auto iter = m_regionMap.begin(); iter != m_regionMap.end(); iter++) {
+            delete iter->second;
+        }
+        m_regionMap.clear();
+        m_heapRegion = nullptr;
+
+        delete m_freeList;
+        m_freeList = new FreeList( 0x1000, 0x80000000); 
+    }
+
+    void restoreRegion( std::string name, uint64_t start, size_t length, uint32_t perms, MemoryBacking* backing, uint64_t brk ) {
+        addRegion( name, start, length, perms, backing );
+        if ( 0 == name.compare("heap") ) {
+            m_heapRegion = m_regionMap[start];
+            m_brk = brk;
+        }
+    }
+
     void initBrk( uint64_t addr ) { 
         VirtMemDbg("brk=%#" PRIx64 "\n",addr);
         auto start = addRegion( "heap", addr, 0x10000000, 0x6 );
@@ -17,6 +17,7 @@
 #include <stdint.h>
 #include <string>
 #include <math.h>
+#include <string.h>
 #include "os/velfloader.h"
 #include "os/vloadpage.h"
 #include "os/vosDbgFlags.h"
@@ -114,17 +115,12 @@ void loadElfFile( Output* output, Interfaces::StandardMem* mem_if, MMU_Lib::MMU*
     processInfo->initBrk( initial_brk );
 }
 
-uint8_t* readElfPage( Output* output, VanadisELFInfo* elf_info, int vpn, int page_size ) {
-    uint64_t virtAddr = vpn<<12;  
-    auto path = elf_info->getBinaryPath();
-    output->verbose( CALL_INFO, 2, VANADIS_OS_DBG_READ_ELF, "-> Loading %s, to locate program sections ...\n", path);
-    output->verbose( CALL_INFO, 2, VANADIS_OS_DBG_READ_ELF,"%s vpn=%d addr=%#" PRIx64 " page_size=%d\n",path,vpn,virtAddr,page_size);
-    FILE* exec_file = fopen(elf_info->getBinaryPath(), "rb");
-    if ( nullptr == exec_file ) {
-        output->fatal(CALL_INFO, -1, "Error: unable to open %s\n", path);
-    }
-    uint8_t* data = new uint8_t[page_size];
-    bzero(data, page_size); 
+// Locate the part of the executable image that backs a page. Returns false if
+// the page is entirely zero fill (bss), otherwise the file offset, the offset in
+// the page to copy to and the number of bytes
+static bool elfPageExtent( Output* output, VanadisELFInfo* elf_info, uint64_t virtAddr, int page_size,
+        size_t& fileOffset, size_t& dataOffset, size_t& numBytes )
+{
     const VanadisELFProgramHeaderEntry* secHdr = elf_info->findProgramHeader( virtAddr );
 
     assert( secHdr );
@@ -144,22 +140,43 @@ uint8_t* readElfPage( Output* output, VanadisELFInfo* elf_info, int vpn, int pag
      
     // The memory footprint of the section can be greater than the file image.
     // if the imageOffset is less than the secImageLen we had data to transfer
-    if ( imageOffset < secImageLen ) {
-        // we write the data to offset in the buffer 
-        size_t dataOffset = virtAddr < secAddr ? secAddr - virtAddr : 0;
-
-        // at most we read a page
-        size_t numBytes = page_size;
-    
-        // if we are not aligned we can, at most, read from the unaligned start to the end of the page
-        numBytes -= dataOffset;
-
-        // if there is not enough data to read a full pagge
-        numBytes = secImageLen - imageOffset < numBytes ? secImageLen - imageOffset : numBytes;
-    
-        output->verbose( CALL_INFO, 2, VANADIS_OS_DBG_READ_ELF,"imageOffset=%zu dataOffset=%zu numBytes=%zu toEnd=%zu\n", imageOffset, dataOffset, numBytes, secImageLen - imageOffset );
-        fseek(exec_file, secImageOffset + imageOffset, SEEK_SET); 
+    if ( imageOffset >= secImageLen ) {
+        return false;
+    }
+
+    // we write the data to offset in the buffer 
+    dataOffset = virtAddr < secAddr ? secAddr - virtAddr : 0;
+
+    // at most we read a page
+    numBytes = page_size;
+
+    // if we are not aligned we can, at most, read from the unaligned start to the end of the page
+    numBytes -= dataOffset;
+
+    // if there is not enough data to read a full pagge
+    numBytes = secImageLen - imageOffset < numBytes ? secImageLen - imageOffset : numBytes;
+
+    output->verbose( CALL_INFO, 2, VANADIS_OS_DBG_READ_ELF,"imageOffset=%zu dataOffset=%zu numBytes=%zu toEnd=%zu\n", imageOffset, dataOffset, numBytes, secImageLen - imageOffset );
+
+    fileOffset = secImageOffset + imageOffset;
+    return true;
+}
+
+uint8_t* readElfPage( Output* output, VanadisELFInfo* elf_info, int vpn, int page_size ) {
+    uint64_t virtAddr = vpn<<12;  
+    auto path = elf_info->getBinaryPath();
+    output->verbose( CALL_INFO, 2, VANADIS_OS_DBG_READ_ELF, "-> Loading %s, to locate program sections ...\n", path);
+    output->verbose( CALL_INFO, 2, VANADIS_OS_DBG_READ_ELF,"%s vpn=%d addr=%#" PRIx64 " page_size=%d\n",path,vpn,virtAddr,page_size);
+    FILE* exec_file = fopen(elf_info->getBinaryPath(), "rb");
+    if ( nullptr == exec_file ) {
+        output->fatal(CALL_INFO, -1, "Error: unable to open %s\n", path);
+    }
+    uint8_t* data = new uint8_t[page_size];
+    bzero(data, page_size); 
 
+    size_t fileOffset, dataOffset, numBytes;
+    if ( elfPageExtent( output, elf_info, virtAddr, page_size, fileOffset, dataOffset, numBytes ) ) {
+        fseek(exec_file, fileOffset, SEEK_SET); 
         fread( data + dataOffset, numBytes, 1, exec_file);
     }
 
@@ -167,6 +184,45 @@ uint8_t* readElfPage( Output* output, VanadisELFInfo* elf_info, int vpn, int pag
     return data; 
 }
 
+void readElfImage( Output* output, VanadisELFInfo* elf_info, std::vector<uint8_t>& image ) {
+    auto path = elf_info->getBinaryPath();
+    FILE* exec_file = fopen(path, "rb");
+    if ( nullptr == exec_file ) {
+        output->fatal(CALL_INFO, -1, "Error: unable to open %s\n", path);
+    }
+
+    fseek(exec_file, 0, SEEK_END);
+    long fileSize = ftell(exec_file);
+    fseek(exec_file, 0, SEEK_SET);
+
+    image.resize( fileSize );
+    if ( fileSize > 0 && 1 != fread( image.data(), fileSize, 1, exec_file ) ) {
+        output->fatal(CALL_INFO, -1, "Error: unable to read %s\n", path);
+    }
+    fclose(exec_file);
+
+    output->verbose( CALL_INFO, 2, VANADIS_OS_DBG_READ_ELF, "read %s, %ld bytes\n", path, fileSize );
+}
+
+uint8_t* readElfPage( Output* output, VanadisELFInfo* elf_info, const std::vector<uint8_t>& image, int vpn, int page_size ) {
+    uint64_t virtAddr = (uint64_t) vpn * page_size;
+    output->verbose( CALL_INFO, 2, VANADIS_OS_DBG_READ_ELF,"%s vpn=%d addr=%#" PRIx64 " page_size=%d\n",elf_info->getBinaryPath(),vpn,virtAddr,page_size);
+
+    uint8_t* data = new uint8_t[page_size];
+    bzero(data, page_size); 
+
+    size_t fileOffset, dataOffset, numBytes;
+    if ( elfPageExtent( output, elf_info, virtAddr, page_size, fileOffset, dataOffset, numBytes ) ) {
+        if ( fileOffset + numBytes > image.size() ) {
+            output->fatal(CALL_INFO, -1, "Error: %s is truncated, page at %#" PRIx64 " is beyond the end of the file\n",
+                elf_info->getBinaryPath(), virtAddr);
+        }
+        memcpy( data + dataOffset, image.data() + fileOffset, numBytes );
+    }
+
+    return data; 
+}
+
 
 } // namespace Vanadis
 } // namespace SST 
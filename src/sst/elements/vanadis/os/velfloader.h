@@ -22,12 +22,18 @@
 #include "os/vphysmemmanager.h"
 #include "os/include/process.h"
 
+#include <vector>
+
 namespace SST {
 namespace Vanadis {
 
 void loadElfFile( Output*, Interfaces::StandardMem*, MMU_Lib::MMU*, PhysMemManager*, VanadisELFInfo*, int hwThread, int page_size, OS::ProcessInfo* );
 uint8_t* readElfPage( Output*, VanadisELFInfo*, int vpn, int page_size );
 
+// Read the executable once so page faults can be served without reopening it
+void readElfImage( Output*, VanadisELFInfo*, std::vector<uint8_t>& image );
+uint8_t* readElfPage( Output*, VanadisELFInfo*, const std::vector<uint8_t>& image, int vpn, int page_size );
+
 }
 }
 #endif
@@ -32,7 +32,8 @@
 using namespace SST::Vanadis;
 
 VanadisNodeOSComponent::VanadisNodeOSComponent(SST::ComponentId_t id, SST::Params& params) 
-    : SST::Component(id), m_mmu(nullptr), m_physMemMgr(nullptr), m_currentTid(100) 
+    : SST::Component(id), m_mmu(nullptr), m_physMemMgr(nullptr), m_currentTid(100), m_syscallCount(0),
+      m_pendingCheckpoint(nullptr)
 {
 
     const uint32_t verbosity = params.find<uint32_t>("dbgLevel", 0);
@@ -87,6 +88,27 @@ VanadisNodeOSComponent::VanadisNodeOSComponent(SST::ComponentId_t id, SST::Param
 
     m_nodeNum = params.find<int>("nodeNum", -1);
 
+    m_checkpointFile = params.find<std::string>("checkpoint_file", "");
+    m_checkpointAfterSyscalls = params.find<uint64_t>("checkpoint_after_syscalls", 0);
+    m_restoreFile = params.find<std::string>("checkpoint_restore_file", "");
+
+    m_shareElfPages = params.find<bool>("share_elf_pages", true);
+    m_pageXferBlockSize = params.find<unsigned>("page_xfer_block_size", 64);
+    m_pageXferOutstanding = params.find<unsigned>("page_xfer_outstanding", 6);
+    // set from the memory interface's line size in setup()
+    m_lineSize = 0;
+    if ( 0 == m_pageXferBlockSize || 0 != m_pageSize % m_pageXferBlockSize ) {
+        output->fatal(CALL_INFO, -1, "Error: page_xfer_block_size (%u) must divide the page size (%d)\n",
+            m_pageXferBlockSize, m_pageSize );
+    }
+    if ( 0 == m_pageXferOutstanding ) {
+        output->fatal(CALL_INFO, -1, "Error: page_xfer_outstanding must be at least 1\n");
+    }
+
+    if ( ( ! m_checkpointFile.empty() || ! m_restoreFile.empty() ) && nullptr == m_mmu ) {
+        output->fatal(CALL_INFO, -1, "Error: checkpoint and restore require useMMU\n");
+    }
+
     int numProcess = 0;
     while( 1 ) {
         std::string name("process" + std::to_string(numProcess) );
@@ -198,6 +220,19 @@ VanadisNodeOSComponent::init(unsigned int phase) {
 
 void
 VanadisNodeOSComponent::setup() {
+    // page transfers are split into whole cache lines so they stay cacheable,
+    // with no caches in the way a whole block goes out as one request
+    m_lineSize = mem_if->getLineSize() > 0 ? mem_if->getLineSize() : m_pageXferBlockSize;
+    if ( 0 != m_pageSize % m_lineSize || 0 != m_pageXferBlockSize % m_lineSize ) {
+        output->fatal(CALL_INFO, -1, "Error: the cache line size (%u) must divide the page size (%d) and page_xfer_block_size (%u)\n",
+            m_lineSize, m_pageSize, m_pageXferBlockSize );
+    }
+
+    if ( ! m_restoreFile.empty() ) {
+        restoreCheckpoint();
+        return;
+    }
+
     // start all of the processes
     for ( const auto kv : m_threadMap ) {
         OS::HwThreadID* tmp = m_availHwThreads.front();
@@ -324,7 +359,9 @@ VanadisNodeOSComponent::handleIncomingSyscall(SST::Event* ev) {
         
         VanadisCoreEvent* event = dynamic_cast<VanadisCoreEvent*>(ev);
 
-        if ( nullptr != event ) { 
+        if ( nullptr != m_pendingCheckpoint && nullptr != dynamic_cast<VanadisGetThreadStateResp*>(ev) ) {
+            checkpointThreadState( static_cast<VanadisGetThreadStateResp*>(ev) );
+        } else if ( nullptr != event ) { 
             auto syscall = getSyscall( event->getCore(), event->getThread() );
             syscall->handleEvent( event );
             processSyscallPost( syscall );
@@ -334,6 +371,11 @@ VanadisNodeOSComponent::handleIncomingSyscall(SST::Event* ev) {
                       "a system-call event.\n");
         }
     } else {
+        if ( ! m_checkpointFile.empty() && ++m_syscallCount == m_checkpointAfterSyscalls ) {
+            startCheckpoint( sys_ev );
+            return;
+        }
+
         auto process = m_coreInfoMap.at(sys_ev->getCoreID()).getProcess( sys_ev->getThreadID() );
         auto syscall = handleIncomingSyscall( process, sys_ev, core_links[ sys_ev->getCoreID() ] );
 
@@ -414,6 +456,17 @@ void VanadisNodeOSComponent::pageFaultFini( PageFault* info, bool success )
     }
 }
 
+// the executable is read once, page faults copy from the in memory image 
+const std::vector<uint8_t>& VanadisNodeOSComponent::getElfImage( VanadisELFInfo* elf_info )
+{
+    auto iter = m_elfImageCache.find( elf_info );
+    if ( iter == m_elfImageCache.end() ) {
+        iter = m_elfImageCache.insert( std::make_pair( elf_info, std::vector<uint8_t>() ) ).first;
+        readElfImage( output, elf_info, iter->second );
+    }
+    return iter->second;
+}
+
 void VanadisNodeOSComponent::pageFault( PageFault *info )
 {
     MMU_Lib::RequestID reqId = info->reqId;
@@ -525,9 +578,11 @@ void VanadisNodeOSComponent::pageFault( PageFault *info )
         if ( region->backing ) {
             // if this region is mapped to an ELF file, check to see if the physical page is cached
             if ( region->backing->elfInfo ) {
-                page = checkPageCache( region->backing->elfInfo, vpn );
+                if ( isSharedElfRegion( region ) ) {
+                    page = checkPageCache( region->backing->elfInfo, vpn );
+                }
                 if ( nullptr == page ) {
-                    data = readElfPage( output, region->backing->elfInfo, vpn, m_pageSize );
+                    data = readElfPage( output, region->backing->elfInfo, getElfImage( region->backing->elfInfo ), vpn, m_pageSize );
                 }  else {
                     output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_PAGE_FAULT,"found elf page vpn %d -> ppn %d\n",vpn, page->getPPN());
                 }
@@ -556,7 +611,9 @@ void VanadisNodeOSComponent::pageFault( PageFault *info )
 
             thread->mapVirtToPage( vpn, page );
         } else {
+            // the process holds its own reference, dropped when the region is unmapped 
             page->incRefCnt();
+            thread->mapVirtToPage( vpn, page );
             output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_PAGE_FAULT,"using exiting physical page %d\n",page->getPPN());
         }
 
@@ -564,8 +621,10 @@ void VanadisNodeOSComponent::pageFault( PageFault *info )
         m_mmu->map( thread->getpid(), vpn, page->getPPN(), m_pageSize, region->perms );
         
         // if there's elfInfo for this region is mapped to a file update the page cache 
-        if ( region->backing && region->backing->elfInfo && 0 == region->name.compare("text") ) {
+        if ( region->backing && region->backing->elfInfo && isSharedElfRegion( region ) ) {
             if ( nullptr != data ) { 
+                // the cache holds a reference so the page outlives the process that faulted it in
+                page->incRefCnt();
                 updatePageCache( region->backing->elfInfo, vpn, page );
             } else {
                 output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_PAGE_FAULT,"fault handled link=%d pid=%d vpn=%d %#" PRIx32 " ppn=%d\n",link,pid,vpn, vpn << m_pageShift,page->getPPN());
@@ -602,7 +661,7 @@ bool VanadisNodeOSComponent::PageMemReadReq::handleResp( StandardMem::Request* e
 
     StandardMem::ReadResp* req = dynamic_cast<StandardMem::ReadResp*>(ev);
     assert( req );
-    assert( req->size == 64 );
+    assert( req->size == lineSize );
 
     memcpy( data + iter->second, req->data.data(), req->size );
     reqMap.erase( iter );
@@ -620,9 +679,9 @@ void VanadisNodeOSComponent::PageMemReadReq::sendReq() {
 
     //printf("PageMemReadReq::%s()\n",__func__);
     if ( m_currentReqOffset < length ) {
-        StandardMem::Request* req = new SST::Interfaces::StandardMem::Read( addr + m_currentReqOffset, 64 );
+        StandardMem::Request* req = new SST::Interfaces::StandardMem::Read( addr + m_currentReqOffset, lineSize );
         reqMap[req->getID()] = m_currentReqOffset;
-        m_currentReqOffset += 64;
+        m_currentReqOffset += lineSize;
         mem_if->send(req);
     }
 }
@@ -631,10 +690,18 @@ bool VanadisNodeOSComponent::PageMemWriteReq::handleResp( StandardMem::Request*
     //printf("PageMemWriteReq::%s()\n",__func__);
     auto iter = reqMap.find( ev->getID() ); 
     assert ( iter != reqMap.end() );
+
+    // the next block goes out once every line of this one has been written
+    auto block = linesLeft.find( iter->second );
+    assert ( block != linesLeft.end() );
     reqMap.erase( iter );
     delete ev;
-    if ( offset < length ) {
-        sendReq();
+
+    if ( 0 == --block->second ) {
+        linesLeft.erase( block );
+        if ( offset < length ) {
+            sendReq();
+        }
     }
     return reqMap.empty();
 }
@@ -642,12 +709,20 @@ bool VanadisNodeOSComponent::PageMemWriteReq::handleResp( StandardMem::Request*
 void VanadisNodeOSComponent::PageMemWriteReq::sendReq() {
     //printf("PageMemWriteReq::%s()\n",__func__);
     if ( offset < length ) {
-        std::vector< uint8_t > buffer( 64);  
-
-        memcpy( buffer.data(), data + offset, buffer.size() );
-        StandardMem::Request* req = new SST::Interfaces::StandardMem::Write( addr + offset, buffer.size(), buffer );
-        reqMap[req->getID()] = offset;
-        offset += buffer.size();
-        mem_if->send(req);
+        const size_t blockOffset = offset;
+        const size_t blockEnd = length - offset < blockSize ? length : offset + blockSize;
+
+        // one cacheable write per line, a write spanning lines would have to
+        // bypass the caches and leave stale copies of the page behind
+        while ( offset < blockEnd ) {
+            const size_t size = blockEnd - offset < lineSize ? blockEnd - offset : lineSize;
+            std::vector< uint8_t > buffer( data + offset, data + offset + size );
+
+            StandardMem::Request* req = new SST::Interfaces::StandardMem::Write( addr + offset, size, buffer );
+            reqMap[req->getID()] = blockOffset;
+            ++linesLeft[blockOffset];
+            offset += size;
+            mem_if->send(req);
+        }
     }
 }
@@ -26,9 +26,11 @@
 #include "os/include/hwThreadID.h"
 #include "os/voscallev.h"
 #include "os/vstartthreadreq.h"
+#include "os/vgetthreadstate.h"
 #include "os/vappruntimememory.h"
 #include "os/vphysmemmanager.h"
 #include "os/include/process.h"
+#include "os/include/checkpoint.h"
 #include "os/syscall/fork.h"
 #include "os/syscall/clone.h"
 #include "os/syscall/exit.h"
@@ -49,7 +51,15 @@ public:
     SST_ELI_DOCUMENT_PARAMS({ "verbose", "Set the output verbosity, 0 is no output, higher is more." },
                             { "cores", "Number of cores that can request OS services via a link." },
                             { "stdout", "File path to place stdout" }, { "stderr", "File path to place stderr" },
-                            { "stdin", "File path to place stdin" })
+                            { "stdin", "File path to place stdin" },
+                            { "checkpoint_file", "File path to write an architectural checkpoint to, empty disables checkpointing", "" },
+                            { "checkpoint_after_syscalls", "Take the checkpoint when this many system calls have been received", "0" },
+                            { "checkpoint_restore_file", "File path of a checkpoint to restore from instead of starting the processes from their entry points", "" },
+                            { "share_elf_pages", "Share the physical pages of read-only ELF segments between all processes running the same executable", "1" },
+                            { "page_xfer_block_size", "Bytes the OS writes per step when it fills a page, must divide the page size and be a multiple of the cache line size. "
+                                "A step is still sent as one cacheable write per cache line (the caches reject writes that span lines), so this only sets how many "
+                                "line writes go out together. Without a cache line size, as when the OS talks to memory directly, a step is one write", "64" },
+                            { "page_xfer_outstanding", "Number of page fill steps the OS keeps in flight", "6" })
 
     SST_ELI_DOCUMENT_PORTS({ "core%(cores)d", "Connects to a CPU core", {} })
 
@@ -66,8 +76,8 @@ private:
 
     class PageMemReq {
       public:
-        PageMemReq( StandardMem* mem_if, uint64_t addr, size_t length, uint8_t* data, Callback* callback ) : 
-            mem_if(mem_if), addr(addr), length(length), data(data), callback(callback), offset(0) { } 
+        PageMemReq( StandardMem* mem_if, uint64_t addr, size_t length, uint8_t* data, Callback* callback, size_t lineSize, size_t blockSize ) : 
+            mem_if(mem_if), addr(addr), length(length), data(data), callback(callback), offset(0), lineSize(lineSize), blockSize(blockSize) { } 
         virtual ~PageMemReq() {
             (*callback)();
             delete callback;
@@ -82,12 +92,14 @@ private:
         Callback* callback;
         std::map<StandardMem::Request::id_t,uint64_t> reqMap;
         uint8_t* data;
+        size_t lineSize;
+        size_t blockSize;
     };
 
     class PageMemWriteReq : public PageMemReq {
       public:
-        PageMemWriteReq( StandardMem* mem_if, uint64_t addr, size_t length, uint8_t* data, Callback* callback ) : 
-            PageMemReq( mem_if, addr, length, data, callback ) {}
+        PageMemWriteReq( StandardMem* mem_if, uint64_t addr, size_t length, uint8_t* data, Callback* callback, size_t lineSize, size_t blockSize ) : 
+            PageMemReq( mem_if, addr, length, data, callback, lineSize, blockSize ) {}
 
         virtual ~PageMemWriteReq() {
             delete[] data;
@@ -95,12 +107,15 @@ private:
 
         bool handleResp( StandardMem::Request* ev );
         void sendReq();
+      private:
+        // line writes still outstanding for each block, keyed by block offset
+        std::map<uint64_t,unsigned> linesLeft;
     };
 
     class PageMemReadReq : public PageMemReq {
       public:
-        PageMemReadReq( StandardMem* mem_if, uint64_t addr, size_t length, uint8_t* data, Callback* callback ) : 
-            PageMemReq( mem_if, addr, length, data, callback ), m_currentReqOffset(0) {}
+        PageMemReadReq( StandardMem* mem_if, uint64_t addr, size_t length, uint8_t* data, Callback* callback, size_t lineSize ) : 
+            PageMemReq( mem_if, addr, length, data, callback, lineSize, lineSize ), m_currentReqOffset(0) {}
 
         virtual ~PageMemReadReq() { }
 
@@ -151,6 +166,21 @@ private:
     void pageFaultHandler2( MMU_Lib::RequestID, unsigned link, unsigned core, unsigned hwThread,  unsigned pid,
         uint32_t vpn, uint32_t perms, uint64_t instPtr, uint64_t memVirtAddr, VanadisSyscall* syscall = nullptr );
 
+    struct PendingCheckpoint {
+        PendingCheckpoint( VanadisSyscallEvent* event, OS::ProcessInfo* process ) :
+            event(event), process(process), pagesOutstanding(0) {}
+        VanadisSyscallEvent* event;
+        OS::ProcessInfo* process;
+        OS::Checkpoint checkpoint;
+        unsigned pagesOutstanding;
+    };
+
+    void startCheckpoint( VanadisSyscallEvent* sys_ev );
+    void checkpointThreadState( VanadisGetThreadStateResp* resp );
+    void checkpointPage( uint32_t vpn, uint8_t* data );
+    void finishCheckpoint();
+    void restoreCheckpoint();
+
     void pageFault( PageFault* );
     void pageFaultFini( PageFault*, bool success = true );
     void startProcess( OS::HwThreadID&, OS::ProcessInfo* process );
@@ -165,12 +195,12 @@ private:
 
     void writePage( uint64_t physAddr, uint8_t* data, unsigned page_size, Callback* callback )
     {
-        queueBlockMemoryReq( new PageMemWriteReq( mem_if, physAddr, page_size, data, callback ) );
+        queueBlockMemoryReq( new PageMemWriteReq( mem_if, physAddr, page_size, data, callback, m_lineSize, m_pageXferBlockSize ) );
     }
 
     void readPage( uint64_t physAddr, uint8_t* data, unsigned page_size, Callback* callback )
     {
-        queueBlockMemoryReq( new PageMemReadReq( mem_if, physAddr, page_size, data, callback ) );
+        queueBlockMemoryReq( new PageMemReadReq( mem_if, physAddr, page_size, data, callback, m_lineSize ) );
     }
 
     void queueBlockMemoryReq( PageMemReq* req ) {
@@ -182,9 +212,8 @@ private:
 
     void startBlockXfer( PageMemReq* req ) {
         // this specfies how many requests should be initially sent before waiting for a response 
-        // this value was choose because hight does not increase performance, for the configuration used to test
-        unsigned startWithNum = 6;
-        for ( int i = 0; i < startWithNum; i++ ) {  
+        // the default of 6 was choosen because higher does not increase performance, for the configuration used to test
+        for ( unsigned i = 0; i < m_pageXferOutstanding; i++ ) {  
             req->sendReq();
         }
     }
@@ -213,6 +242,13 @@ private:
         m_elfPageCache[elf_info][vpn] = page;
     } 
 
+    // pages of read-only ELF segments are never modified so one physical copy is shared by every process
+    bool isSharedElfRegion( OS::MemoryRegion* region ) {
+        return m_shareElfPages && 0 == ( region->perms & 0x2 );
+    }
+
+    const std::vector<uint8_t>& getElfImage( VanadisELFInfo* elf_info );
+
     void writeMem( OS::ProcessInfo*, uint64_t virtAddr, std::vector<uint8_t>* data, int perms, unsigned pageSize, Callback* callback );
 
     template<typename T>
@@ -348,6 +384,11 @@ private:
     std::queue<PageMemReq*>                         m_blockMemoryWriteReqQ;
 
     std::map< VanadisELFInfo*, std::map<int,OS::Page*> >            m_elfPageCache;
+    std::map< VanadisELFInfo*, std::vector<uint8_t> >              m_elfImageCache;
+    bool                                                            m_shareElfPages;
+    unsigned                                                        m_pageXferBlockSize;
+    unsigned                                                        m_lineSize;
+    unsigned                                                        m_pageXferOutstanding;
     std::unordered_map<StandardMem::Request::id_t, VanadisSyscall*> m_memRespMap;
 
     std::queue< OS::HwThreadID* > m_availHwThreads;
@@ -356,6 +397,12 @@ private:
 
     int m_currentTid;
 
+    std::string        m_checkpointFile;
+    std::string        m_restoreFile;
+    uint64_t           m_checkpointAfterSyscalls;
+    uint64_t           m_syscallCount;
+    PendingCheckpoint* m_pendingCheckpoint;
+
     OS::Page* allocPage() {
         auto page = new OS::Page(m_physMemMgr);
         output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_PAGE_FAULT,"ppn=%d\n",page->getPPN());
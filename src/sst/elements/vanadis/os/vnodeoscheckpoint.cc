@@ -0,0 +1,225 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <memory>
+
+#include "os/vnodeos.h"
+#include "os/vgetthreadstate.h"
+#include "os/vstartthreadreq.h"
+
+using namespace SST::Vanadis;
+
+// A checkpoint is taken when a thread makes a system call. The syscall is
+// held while the thread state and the touched pages are captured and then
+// processed as normal, so the checkpoint represents the state just before
+// the syscall was executed. A restored thread restarts at the syscall
+// instruction and issues it again.
+
+void VanadisNodeOSComponent::startCheckpoint( VanadisSyscallEvent* sys_ev )
+{
+    auto process = m_coreInfoMap.at(sys_ev->getCoreID()).getProcess( sys_ev->getThreadID() );
+
+    // only a node running a single thread is guaranteed to be quiesced at this point
+    if ( 1 != m_threadMap.size() ) {
+        output->verbose(CALL_INFO, 0, 0, "Warning: checkpoint skipped, %zu threads are active, only single-threaded "
+                "nodes can be checkpointed\n", m_threadMap.size() );
+        auto syscall = handleIncomingSyscall( process, sys_ev, core_links[ sys_ev->getCoreID() ] );
+        processSyscallPost( syscall );
+        return;
+    }
+
+    output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_SYSCALL, "start checkpoint core=%d hwThread=%d syscall=%" PRIu64 "\n",
+            sys_ev->getCoreID(), sys_ev->getThreadID(), m_syscallCount );
+
+    m_pendingCheckpoint = new PendingCheckpoint( sys_ev, process );
+    m_pendingCheckpoint->checkpoint.pageSize = m_pageSize;
+    m_pendingCheckpoint->checkpoint.simTimeNano = getCurrentSimTimeNano();
+
+    core_links.at( sys_ev->getCoreID() )->send( new VanadisGetThreadStateReq( sys_ev->getThreadID() ) );
+}
+
+void VanadisNodeOSComponent::checkpointThreadState( VanadisGetThreadStateResp* resp )
+{
+    auto process = m_pendingCheckpoint->process;
+    auto& ckpt = m_pendingCheckpoint->checkpoint;
+
+    ckpt.processes.resize(1);
+    OS::Checkpoint::Process& proc = ckpt.processes.back();
+    proc.exe = process->getElfInfo()->getBinaryPath();
+    process->checkpoint( proc );
+
+    OS::Checkpoint::Thread thread;
+    thread.core = resp->getCore();
+    thread.hwThread = resp->getThread();
+    thread.tid = process->gettid();
+    thread.instPtr = resp->getInstPtr();
+    thread.tlsPtr = resp->getTlsPtr();
+    thread.tidAddress = process->getTidAddress();
+    thread.intRegs = resp->intRegs;
+    thread.fpRegs = resp->fpRegs;
+    proc.threads.push_back( thread );
+
+    delete resp;
+
+    // read back every page that has been materialized, read-only ELF pages are clean and come from the ELF
+    for ( const auto& kv : process->getVirtMemMap()->getRegionMap() ) {
+        auto region = kv.second;
+        if ( region->backing && region->backing->elfInfo && 0 == ( region->perms & 0x2 ) ) {
+            continue;
+        }
+        if ( region->backing && region->backing->dev ) {
+            continue;
+        }
+
+        for ( const auto& page : region->getPageMap() ) {
+            uint32_t vpn = page.first;
+            uint8_t* data = new uint8_t[m_pageSize];
+
+            ++m_pendingCheckpoint->pagesOutstanding;
+            readPage( (uint64_t) page.second->getPPN() << m_pageShift, data, m_pageSize,
+                    new Callback( [=]() { checkpointPage( vpn, data ); } ) );
+        }
+    }
+
+    if ( 0 == m_pendingCheckpoint->pagesOutstanding ) {
+        finishCheckpoint();
+    }
+}
+
+void VanadisNodeOSComponent::checkpointPage( uint32_t vpn, uint8_t* data )
+{
+    auto& proc = m_pendingCheckpoint->checkpoint.processes.back();
+
+    OS::Checkpoint::Page page;
+    page.vpn = vpn;
+    page.perms = m_mmu->getPerms( proc.pid, vpn );
+    page.zero = OS::Checkpoint::isZeroPage( data, m_pageSize );
+    if ( ! page.zero ) {
+        page.data.assign( data, data + m_pageSize );
+    }
+    proc.pages.push_back( std::move(page) );
+
+    delete[] data;
+
+    if ( 0 == --m_pendingCheckpoint->pagesOutstanding ) {
+        finishCheckpoint();
+    }
+}
+
+void VanadisNodeOSComponent::finishCheckpoint()
+{
+    auto pending = m_pendingCheckpoint;
+    m_pendingCheckpoint = nullptr;
+
+    if ( ! pending->checkpoint.write( m_checkpointFile ) ) {
+        output->fatal(CALL_INFO, -1, "Error: unable to write checkpoint file %s\n", m_checkpointFile.c_str() );
+    }
+
+    size_t numPages = pending->checkpoint.processes.back().pages.size();
+    output->verbose(CALL_INFO, 0, 0, "wrote checkpoint %s at %" PRIu64 " ns, %zu pages\n",
+            m_checkpointFile.c_str(), pending->checkpoint.simTimeNano, numPages );
+
+    auto sys_ev = pending->event;
+    delete pending;
+
+    auto syscall = handleIncomingSyscall( m_coreInfoMap.at(sys_ev->getCoreID()).getProcess( sys_ev->getThreadID() ),
+                                            sys_ev, core_links[ sys_ev->getCoreID() ] );
+    processSyscallPost( syscall );
+}
+
+void VanadisNodeOSComponent::restoreCheckpoint()
+{
+    OS::Checkpoint ckpt;
+
+    if ( ! ckpt.read( m_restoreFile ) ) {
+        output->fatal(CALL_INFO, -1, "Error: unable to read checkpoint file %s\n", m_restoreFile.c_str() );
+    }
+    if ( ckpt.pageSize != m_pageSize ) {
+        output->fatal(CALL_INFO, -1, "Error: checkpoint page size %" PRIu32 " does not match page_size %d\n",
+                ckpt.pageSize, m_pageSize );
+    }
+    if ( ckpt.processes.size() != m_threadMap.size() ) {
+        output->fatal(CALL_INFO, -1, "Error: checkpoint has %zu processes, %zu are configured\n",
+                ckpt.processes.size(), m_threadMap.size() );
+    }
+
+    output->verbose(CALL_INFO, 0, 0, "restoring checkpoint %s taken at %" PRIu64 " ns\n",
+            m_restoreFile.c_str(), ckpt.simTimeNano );
+
+    auto ckptProc = ckpt.processes.begin();
+    for ( const auto kv : m_threadMap ) {
+        auto process = kv.second;
+        auto& proc = *ckptProc++;
+
+        if ( proc.exe.compare( process->getElfInfo()->getBinaryPath() ) ) {
+            output->verbose(CALL_INFO, 0, 0, "Warning: checkpoint was taken from %s, restoring into %s\n",
+                    proc.exe.c_str(), process->getElfInfo()->getBinaryPath() );
+        }
+
+        OS::HwThreadID* threadID = m_availHwThreads.front();
+        m_availHwThreads.pop();
+        process->setHwThread( *threadID );
+
+        m_mmu->initPageTable( process->getpid() );
+        m_mmu->setCoreToPageTable( threadID->core, threadID->hwThread, process->getpid() );
+
+        process->restore( proc );
+        m_coreInfoMap.at(threadID->core).setProcess( threadID->hwThread, process );
+
+        auto& thread = proc.threads.front();
+        auto req = new VanadisStartThreadRestoreReq( threadID->hwThread, thread.instPtr, thread.tlsPtr );
+        req->setIntRegs( thread.intRegs );
+        req->setFpRegs( thread.fpRegs );
+
+        unsigned core = threadID->core;
+        delete threadID;
+
+        if ( proc.pages.empty() ) {
+            core_links.at(core)->send( req );
+            continue;
+        }
+
+        // the thread is started once all of its pages have been written back
+        auto pagesOutstanding = std::make_shared<size_t>( proc.pages.size() );
+
+        for ( auto& ckptPage : proc.pages ) {
+            OS::Page* page;
+            try {
+                page = allocPage( );
+            } catch ( int err ) {
+                output->fatal(CALL_INFO, -1, "Error: ran out of physical memory\n");
+            }
+
+            process->mapVirtToPage( ckptPage.vpn, page );
+            m_mmu->map( process->getpid(), ckptPage.vpn, page->getPPN(), m_pageSize, ckptPage.perms );
+
+            uint8_t* data = new uint8_t[m_pageSize];
+            if ( ckptPage.zero ) {
+                bzero( data, m_pageSize );
+            } else {
+                memcpy( data, ckptPage.data.data(), m_pageSize );
+            }
+
+            writePage( (uint64_t) page->getPPN() << m_pageShift, data, m_pageSize,
+                new Callback( [=]() {
+                    if ( 0 == --(*pagesOutstanding) ) {
+                        core_links.at(core)->send( req );
+                    }
+                }) );
+        }
+    }
+}
@@ -98,6 +98,17 @@ private:
     ImplementSerializable(SST::Vanadis::VanadisStartThreadCloneReq);
 };
 
+class VanadisStartThreadRestoreReq : public _VanadisStartThreadBaseReq {
+public:
+    VanadisStartThreadRestoreReq() : _VanadisStartThreadBaseReq() {}
+
+    VanadisStartThreadRestoreReq( int thread, uint64_t instPtr, uint64_t tlsAddr ) : 
+        _VanadisStartThreadBaseReq( thread, instPtr, 0, 0, tlsAddr ) {} 
+
+private:
+    ImplementSerializable(SST::Vanadis::VanadisStartThreadRestoreReq);
+};
+
 } // namespace Vanadis
 } // namespace SST
 
@@ -126,6 +126,9 @@ osParams = {
     "heap_verbose" : verbosity,
     "physMemSize" : physMemSize,
     "useMMU" : True,
+    "checkpoint_file" : os.getenv("VANADIS_CHECKPOINT_FILE", ""),
+    "checkpoint_after_syscalls" : os.getenv("VANADIS_CHECKPOINT_AFTER_SYSCALLS", 0),
+    "checkpoint_restore_file" : os.getenv("VANADIS_CHECKPOINT_RESTORE_FILE", ""),
 }
 
 
@@ -224,6 +227,9 @@ decoderParams = {
     "predecode_cache_entries" : 4
 }
 
+if vanadis_isa == "RISCV64":
+    decoderParams["vector_length_bits"] = os.getenv("VANADIS_VECTOR_LENGTH_BITS", 0)
+
 osHdlrParams = {
     "verbose" : os_verbosity,
 }
@@ -255,6 +261,14 @@ cpuParams = {
     "start_verbose_when_issue_address": dbgAddr,
     "stop_verbose_when_retire_address": stopDbg,
     "print_rob" : False,
+    "fast_forward_instructions" : os.getenv("VANADIS_FAST_FORWARD_INS", 0),
+    "fast_forward_until_address" : os.getenv("VANADIS_FAST_FORWARD_ADDRESS", 0),
+    "sample_period" : os.getenv("VANADIS_SAMPLE_PERIOD", 0),
+    "sample_detailed_instructions" : os.getenv("VANADIS_SAMPLE_DETAILED_INS", 10000),
+    "sample_warming_instructions" : os.getenv("VANADIS_SAMPLE_WARMING_INS", 2000),
+    "cpi_stack" : os.getenv("VANADIS_CPI_STACK", "none"),
+    "cpi_stack_file" : os.getenv("VANADIS_CPI_STACK_FILE", ""),
+    "cpi_stack_binary" : full_exe_name,
 }
 
 lsqParams = {
@@ -0,0 +1,287 @@
+#!/usr/bin/env python3
+#
+# Copyright 2009-2022 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2022, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Writes a static RV64GV executable which exercises the RISC-V vector
+# instructions Vanadis decodes. The musl cross compilers used by the other
+# tests do not accept vector code, so the program is assembled here. It checks
+# each result in memory against the expected value and prints one line per
+# check, a failed check prints FAIL and exits with status 1.
+#
+# The checks assume VLEN=256 (vector_length_bits=256), four 64-bit elements.
+#
+#   python3 vector-ops.py riscv64/vector-ops
+
+import struct
+import sys
+
+TEXT_ADDR = 0x10000
+DATA_ADDR = 0x20000
+
+# integer registers
+ZERO, T0, T1, T2, A0, A1, A2, A3, A7, T3, T4, T5 = 0, 5, 6, 7, 10, 11, 12, 13, 17, 28, 29, 30
+
+E64_M1 = 0xd8 # e64, m1, tail and mask agnostic
+
+def r_type(f7, rs2, rs1, f3, rd, op):
+    return (f7 << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | op
+
+def i_type(imm, rs1, f3, rd, op):
+    return ((imm & 0xfff) << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | op
+
+def s_type(imm, rs2, rs1, f3, op):
+    return (((imm >> 5) & 0x7f) << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) | ((imm & 0x1f) << 7) | op
+
+def b_type(imm, rs2, rs1, f3):
+    return (((imm >> 12) & 1) << 31) | (((imm >> 5) & 0x3f) << 25) | (rs2 << 20) | (rs1 << 15) | \
+        (f3 << 12) | (((imm >> 1) & 0xf) << 8) | (((imm >> 11) & 1) << 7) | 0x63
+
+def op_v(f6, vm, vs2, vs1, f3, vd):
+    return (f6 << 26) | (vm << 25) | (vs2 << 20) | (vs1 << 15) | (f3 << 12) | (vd << 7) | 0x57
+
+class Assembler:
+    def __init__(self):
+        self.code = []
+        self.labels = {}
+        self.fixups = []
+
+    def pc(self):
+        return TEXT_ADDR + 4 * len(self.code)
+
+    def emit(self, word):
+        self.code.append(word)
+
+    def label(self, name):
+        self.labels[name] = self.pc()
+
+    def li(self, rd, value):
+        lo = value & 0xfff
+        if lo >= 0x800:
+            lo -= 0x1000
+        hi = (value - lo) >> 12
+        if hi:
+            self.emit(((hi & 0xfffff) << 12) | (rd << 7) | 0x37)   # lui
+            self.emit(i_type(lo, rd, 0, rd, 0x13))                 # addi
+        else:
+            self.emit(i_type(lo, ZERO, 0, rd, 0x13))
+
+    def addi(self, rd, rs1, imm):
+        self.emit(i_type(imm, rs1, 0, rd, 0x13))
+
+    def ld(self, rd, rs1, imm):
+        self.emit(i_type(imm, rs1, 3, rd, 0x03))
+
+    def bne(self, rs1, rs2, name):
+        self.fixups.append((len(self.code), name, rs1, rs2, 1))
+        self.emit(0)
+
+    def jump(self, name):
+        self.fixups.append((len(self.code), name, ZERO, ZERO, 0))
+        self.emit(0)
+
+    def ecall(self):
+        self.emit(0x73)
+
+    def csrr(self, rd, csr):
+        self.emit(i_type(csr, ZERO, 2, rd, 0x73))
+
+    def vsetvli(self, rd, rs1, vtype):
+        self.emit((vtype << 20) | (rs1 << 15) | (7 << 12) | (rd << 7) | 0x57)
+
+    def vle64(self, vd, rs1):
+        self.emit((1 << 25) | (rs1 << 15) | (7 << 12) | (vd << 7) | 0x07)
+
+    def vlse64(self, vd, rs1, rs2):
+        self.emit((2 << 26) | (1 << 25) | (rs2 << 20) | (rs1 << 15) | (7 << 12) | (vd << 7) | 0x07)
+
+    def vse64(self, vs3, rs1):
+        self.emit((1 << 25) | (rs1 << 15) | (7 << 12) | (vs3 << 7) | 0x27)
+
+    def finish(self):
+        for index, name, rs1, rs2, f3 in self.fixups:
+            offset = self.labels[name] - (TEXT_ADDR + 4 * index)
+            self.code[index] = b_type(offset, rs2, rs1, f3)
+        return b"".join(struct.pack("<I", word) for word in self.code)
+
+class Data:
+    def __init__(self):
+        self.blob = bytearray()
+
+    def add(self, raw):
+        while len(self.blob) % 8:
+            self.blob.append(0)
+        addr = DATA_ADDR + len(self.blob)
+        self.blob += raw
+        return addr
+
+    def quads(self, values):
+        return self.add(b"".join(struct.pack("<Q", v & 0xffffffffffffffff) for v in values))
+
+    def doubles(self, values):
+        return self.add(b"".join(struct.pack("<d", v) for v in values))
+
+def build():
+    asm = Assembler()
+    data = Data()
+
+    a = data.quads([1, 2, 3, 4, 5, 6, 7, 8])
+    b = data.quads([10, 20, 30, 40])
+    fa = data.doubles([1.5, 2.5, 3.5, 4.5])
+    out = data.quads([0] * 4)
+
+    checks = []
+
+    def check(name, expected):
+        # compare the four doublewords at 'out' against 'expected'
+        exp = data.add(expected)
+        ok = data.add((name + ": ok\n").encode())
+        fail = data.add((name + ": FAIL\n").encode())
+        asm.li(A1, out)
+        asm.li(A2, exp)
+        asm.li(A3, len(expected) // 8)
+        loop = "loop%d" % len(checks)
+        bad = "bad%d" % len(checks)
+        done = "done%d" % len(checks)
+        asm.label(loop)
+        asm.ld(T3, A1, 0)
+        asm.ld(T4, A2, 0)
+        asm.bne(T3, T4, bad)
+        asm.addi(A1, A1, 8)
+        asm.addi(A2, A2, 8)
+        asm.addi(A3, A3, -1)
+        asm.bne(A3, ZERO, loop)
+        print_message(ok, len(name) + 5)
+        asm.jump(done)
+        asm.label(bad)
+        print_message(fail, len(name) + 7)
+        asm.li(A0, 1)
+        asm.li(A7, 94)
+        asm.ecall()
+        asm.label(done)
+        checks.append(name)
+
+    def print_message(addr, length):
+        asm.li(A0, 1)
+        asm.li(A1, addr)
+        asm.li(A2, length)
+        asm.li(A7, 64)
+        asm.ecall()
+
+    def quads(values):
+        return b"".join(struct.pack("<Q", v & 0xffffffffffffffff) for v in values)
+
+    def doubles(values):
+        return b"".join(struct.pack("<d", v) for v in values)
+
+    def store(vreg):
+        asm.li(T0, out)
+        asm.vse64(vreg, T0)
+
+    def store_scalar(reg):
+        asm.li(T0, out)
+        asm.emit(s_type(0, reg, T0, 3, 0x23))  # sd
+
+    # vlenb and the vl granted for e64
+    asm.csrr(T1, 0xc22)
+    store_scalar(T1)
+    check("csrr vlenb", quads([32]))
+
+    asm.li(A0, 8)
+    asm.vsetvli(T1, A0, E64_M1)
+    store_scalar(T1)
+    check("vsetvli", quads([4]))
+
+    asm.li(T0, a)
+    asm.vle64(1, T0)
+    asm.li(T0, b)
+    asm.vle64(2, T0)
+    store(1)
+    check("vle64.v", quads([1, 2, 3, 4]))
+
+    asm.emit(op_v(0x00, 1, 1, 2, 0, 3))            # vadd.vv v3, v1, v2
+    store(3)
+    check("vadd.vv", quads([11, 22, 33, 44]))
+
+    asm.emit(op_v(0x00, 1, 1, 5, 3, 4))            # vadd.vi v4, v1, 5
+    store(4)
+    check("vadd.vi", quads([6, 7, 8, 9]))
+
+    asm.li(T2, 100)
+    asm.emit(op_v(0x02, 1, 2, T2, 4, 4))           # vsub.vx v4, v2, t2
+    store(4)
+    check("vsub.vx", quads([-90, -80, -70, -60]))
+
+    asm.emit(op_v(0x25, 1, 1, 2, 2, 5))            # vmul.vv v5, v1, v2
+    store(5)
+    check("vmul.vv", quads([10, 40, 90, 160]))
+
+    asm.emit(op_v(0x10, 1, 0, ZERO, 6, 6))         # vmv.s.x v6, zero
+    asm.emit(op_v(0x00, 1, 3, 6, 2, 7))            # vredsum.vs v7, v3, v6
+    asm.emit(op_v(0x10, 1, 7, 0, 2, T1))           # vmv.x.s t1, v7
+    store_scalar(T1)
+    check("vredsum.vs", quads([110]))
+
+    asm.emit(op_v(0x18, 1, 1, 3, 3, 0))            # vmseq.vi v0, v1, 3
+    asm.emit(op_v(0x17, 0, 1, 2, 0, 8))            # vmerge.vvm v8, v1, v2, v0
+    store(8)
+    check("vmerge.vvm", quads([1, 2, 30, 4]))
+
+    asm.li(T0, a)
+    asm.li(T2, 16)
+    asm.vlse64(9, T0, T2)
+    store(9)
+    check("vlse64.v", quads([1, 3, 5, 7]))
+
+    asm.li(T0, fa)
+    asm.vle64(10, T0)
+    asm.emit(op_v(0x00, 1, 10, 10, 1, 11))         # vfadd.vv v11, v10, v10
+    store(11)
+    check("vfadd.vv", doubles([3.0, 5.0, 7.0, 9.0]))
+
+    asm.emit(op_v(0x24, 1, 10, 10, 1, 12))         # vfmul.vv v12, v10, v10
+    store(12)
+    check("vfmul.vv", doubles([2.25, 6.25, 12.25, 20.25]))
+
+    asm.emit(op_v(0x28, 1, 10, 10, 1, 12))         # vfmadd.vv v12, v10, v10: v12 = v12 * v10 + v10
+    store(12)
+    check("vfmadd.vv", doubles([4.875, 18.125, 46.375, 95.625]))
+
+    asm.li(A0, 0)
+    asm.li(A7, 94)
+    asm.ecall()
+
+    return asm.finish(), bytes(data.blob)
+
+def write_elf(path, text, data):
+    phnum = 2
+    text_off = 0x1000
+    data_off = text_off + ((len(text) + 0xfff) & ~0xfff)
+
+    ident = b"\x7fELF" + bytes([2, 1, 1, 0]) + bytes(8)
+    # EXEC, RISC-V, double-float ABI
+    header = ident + struct.pack("<HHIQQQIHHHHHH", 2, 243, 1, TEXT_ADDR, 64, 0, 0x4, 64, 56, phnum, 64, 0, 0)
+
+    text_phdr = struct.pack("<IIQQQQQQ", 1, 5, text_off, TEXT_ADDR, TEXT_ADDR, len(text), len(text), 0x1000)
+    data_phdr = struct.pack("<IIQQQQQQ", 1, 6, data_off, DATA_ADDR, DATA_ADDR, len(data), len(data), 0x1000)
+
+    image = bytearray(header + text_phdr + data_phdr)
+    image += bytes(text_off - len(image))
+    image += text
+    image += bytes(data_off - len(image))
+    image += data
+
+    with open(path, "wb") as fp:
+        fp.write(image)
+
+if __name__ == "__main__":
+    text, data = build()
+    write_elf(sys.argv[1] if len(sys.argv) > 1 else "riscv64/vector-ops", text, data)
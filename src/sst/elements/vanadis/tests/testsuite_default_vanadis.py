@@ -3,11 +3,16 @@
 from sst_unittest import *
 from sst_unittest_support import *
 from sst_unittest_parameterized import parameterized
+import re
 import subprocess
 
 module_init = 0
 module_sema = threading.Semaphore()
 vanadis_test_matrix = []
+vanadis_sampled_test_matrix = []
+vanadis_functional_test_matrix = []
+vanadis_cpistack_test_matrix = []
+vanadis_vector_test_matrix = []
 
 MakeTests = False
 #MakeTests = True
@@ -82,10 +87,110 @@ def build_vanadis_test_matrix():
         test_data = (testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, timeout_sec)
         vanadis_test_matrix.append(test_data)
 
+# The sampled runs fast-forward functionally, then alternate functional,
+# warming and detailed windows. Program output must match the detailed gold
+# files and the extrapolated cycle count must land near the detailed run.
+def build_vanadis_sampled_test_matrix():
+    global vanadis_sampled_test_matrix
+    vanadis_sampled_test_matrix = []
+
+    sample_env = {
+        "VANADIS_FAST_FORWARD_INS" : "20000",
+        "VANADIS_SAMPLE_PERIOD" : "100000",
+        "VANADIS_SAMPLE_DETAILED_INS" : "10000",
+        "VANADIS_SAMPLE_WARMING_INS" : "10000",
+    }
+
+    testlist = []
+    for arch in ["mipsel","riscv64"]:
+        testlist.append(["small/basic-math", "sqrt-double", arch])
+        testlist.append(["small/basic-ops", "test-branch", arch])
+        testlist.append(["small/misc", "stream", arch])
+
+    for testnum, test_info in enumerate(testlist):
+        testnum = testnum + 1
+        elftestdir = test_info[0]
+        elffile = test_info[1]
+        isa = test_info[2]
+        testname = "sampled_{0}_{1}_{2}".format(elftestdir.replace("/", "_"), elffile, isa)
+
+        test_data = (testnum, testname, "basic_vanadis.py", elftestdir, elffile, isa, 1, 1, 300, sample_env)
+        vanadis_sampled_test_matrix.append(test_data)
+
+# The functional runs fast-forward through the whole program, every branch
+# (and every MIPS delay slot) retires on the functional path. The program
+# must retire the same instructions as the detailed run.
+def build_vanadis_functional_test_matrix():
+    global vanadis_functional_test_matrix
+    vanadis_functional_test_matrix = []
+
+    functional_env = {
+        "VANADIS_FAST_FORWARD_INS" : "1000000000",
+    }
+
+    testlist = []
+    for arch in ["mipsel","riscv64"]:
+        testlist.append(["small/basic-ops", "test-branch", arch])
+
+    for testnum, test_info in enumerate(testlist):
+        testnum = testnum + 1
+        elftestdir = test_info[0]
+        elffile = test_info[1]
+        isa = test_info[2]
+        testname = "functional_{0}_{1}_{2}".format(elftestdir.replace("/", "_"), elffile, isa)
+
+        test_data = (testnum, testname, "basic_vanadis.py", elftestdir, elffile, isa, 1, 1, 300, functional_env)
+        vanadis_functional_test_matrix.append(test_data)
+
+# The CPI stack runs account every retire slot by PC or by function and write
+# a profile that sst-vanadis-cpistack reads back
+def build_vanadis_cpistack_test_matrix():
+    global vanadis_cpistack_test_matrix
+    vanadis_cpistack_test_matrix = []
+
+    testlist = []
+    for arch in ["mipsel","riscv64"]:
+        for mode in ["pc", "function"]:
+            testlist.append(["small/basic-ops", "test-branch", arch, mode])
+
+    for testnum, test_info in enumerate(testlist):
+        testnum = testnum + 1
+        elftestdir = test_info[0]
+        elffile = test_info[1]
+        isa = test_info[2]
+        mode = test_info[3]
+        testname = "cpistack_{0}_{1}_{2}_{3}".format(mode, elftestdir.replace("/", "_"), elffile, isa)
+
+        test_data = (testnum, testname, "basic_vanadis.py", elftestdir, elffile, isa, 1, 1, 300, mode)
+        vanadis_cpistack_test_matrix.append(test_data)
+
+# The vector programs are assembled by a script in their directory and check
+# their own results, they need the RISC-V vector extension enabled
+def build_vanadis_vector_test_matrix():
+    global vanadis_vector_test_matrix
+    vanadis_vector_test_matrix = []
+
+    vector_env = {
+        "VANADIS_VECTOR_LENGTH_BITS" : "256",
+    }
+
+    location = "small/rvv"
+    vector_tests = ["vector-ops"]
+    for testnum, test in enumerate(vector_tests):
+        testnum = testnum + 1
+        testname = "{0}_{1}_riscv64".format(location.replace("/", "_"), test)
+
+        test_data = (testnum, testname, "basic_vanadis.py", location, test, "riscv64", 1, 1, 300, vector_env)
+        vanadis_vector_test_matrix.append(test_data)
+
 ################################################################################
 
 # At startup, build the test matrix
 build_vanadis_test_matrix()
+build_vanadis_sampled_test_matrix()
+build_vanadis_functional_test_matrix()
+build_vanadis_cpistack_test_matrix()
+build_vanadis_vector_test_matrix()
 
 def gen_custom_name(testcase_func, param_num, param):
 # Full TestCaseName
@@ -143,9 +248,65 @@ class testcase_vanadis(SSTTestCase):
         log_debug("Running Vanadis test #{0} ({1}): elffile={4} in dir {3}, isa {5}; using sdl={2}".format(testnum, testname, sdlfile, elftestdir, elffile, isa, timeout_sec))
         self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, timeout_sec)
 
+    @parameterized.expand(vanadis_sampled_test_matrix, name_func=gen_custom_name)
+    def test_vanadis_sampled_tests(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, timeout_sec, sampleEnv):
+        self._checkSkipConditions( isa )
+
+        log_debug("Running Vanadis sampled test #{0} ({1}): elffile={4} in dir {3}, isa {5}; using sdl={2}".format(testnum, testname, sdlfile, elftestdir, elffile, isa))
+        for key, value in sampleEnv.items():
+            os.environ[key] = value
+        try:
+            self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, timeout_sec, sampled=True)
+        finally:
+            for key in sampleEnv:
+                del os.environ[key]
+
+    @parameterized.expand(vanadis_functional_test_matrix, name_func=gen_custom_name)
+    def test_vanadis_functional_tests(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, timeout_sec, functionalEnv):
+        self._checkSkipConditions( isa )
+
+        log_debug("Running Vanadis functional test #{0} ({1}): elffile={4} in dir {3}, isa {5}; using sdl={2}".format(testnum, testname, sdlfile, elftestdir, elffile, isa))
+        for key, value in functionalEnv.items():
+            os.environ[key] = value
+        try:
+            self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, timeout_sec, functional=True)
+        finally:
+            for key in functionalEnv:
+                del os.environ[key]
+
+    @parameterized.expand(vanadis_cpistack_test_matrix, name_func=gen_custom_name)
+    def test_vanadis_cpistack_tests(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, timeout_sec, cpiMode):
+        self._checkSkipConditions( isa )
+
+        log_debug("Running Vanadis CPI stack test #{0} ({1}): elffile={4} in dir {3}, isa {5}; using sdl={2}".format(testnum, testname, sdlfile, elftestdir, elffile, isa))
+        cpiEnv = {
+            "VANADIS_CPI_STACK" : cpiMode,
+            "VANADIS_CPI_STACK_FILE" : "cpistack.bin",
+        }
+        for key, value in cpiEnv.items():
+            os.environ[key] = value
+        try:
+            self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, timeout_sec, cpi_stack=cpiMode)
+        finally:
+            for key in cpiEnv:
+                del os.environ[key]
+
+    @parameterized.expand(vanadis_vector_test_matrix, name_func=gen_custom_name)
+    def test_vanadis_vector_tests(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, timeout_sec, vectorEnv):
+        self._checkSkipConditions( isa )
+
+        log_debug("Running Vanadis vector test #{0} ({1}): elffile={4} in dir {3}, isa {5}; using sdl={2}".format(testnum, testname, sdlfile, elftestdir, elffile, isa))
+        for key, value in vectorEnv.items():
+            os.environ[key] = value
+        try:
+            self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, timeout_sec)
+        finally:
+            for key in vectorEnv:
+                del os.environ[key]
+
 #####
 
-    def vanadis_test_template(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, testtimeout=120):
+    def vanadis_test_template(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, testtimeout=120, sampled=False, functional=False, cpi_stack=None):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = "{0}/vanadis_tests/{1}/{2}/{3}".format(self.get_test_output_run_dir(), elftestdir,elffile,isa)
@@ -193,7 +354,13 @@ class testcase_vanadis(SSTTestCase):
         self.assertTrue(os_outfileexists, "Vanadis test outfile-os not found in directory {0}".format(outdir))
         self.assertTrue(os_errfileexists, "Vanadis test errfile-os not found in directory {0}".format(outdir))
 
-        if ( os.path.exists( ref_sst_outfile ) ):
+        if sampled:
+            self._checkExtrapolatedCycles(testname, sst_outfile, ref_sst_outfile)
+        elif functional:
+            self._checkFunctionalInstructions(testname, sst_outfile, ref_sst_outfile)
+        elif cpi_stack:
+            self._checkCPIStack(testname, sst_outfile, outdir, cpi_stack, numHwThreads)
+        elif ( os.path.exists( ref_sst_outfile ) ):
             cmp_result = testing_compare_filtered_diff(testname, sst_outfile, ref_sst_outfile ,filters=[StartsWithFilter(" v0.instructions_issued.1")])
             if (cmp_result == False):
                 diffdata = testing_get_diff_data(testname)
@@ -235,8 +402,138 @@ class testcase_vanadis(SSTTestCase):
         # DEVELOPER NOTE: In the future, we may want to compare the SST output (statisics) vs some reference file
 
 
+    # Header-only components are checked by small standalone programs
+    def vanadis_unit_test_template(self, testname):
+        unitdir = "{0}/unit".format(self.get_testsuite_dir())
+        tmpdir = self.get_test_output_tmp_dir()
+
+        rtn = OSCommand("make {0}".format(testname), set_cwd=unitdir).run()
+        log_debug("Vanadis unit test {0} make result = {1}; output =\n{2}".format(testname, rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "Vanadis unit test {0} failed to build".format(testname))
+
+        rtn = OSCommand("{0}/{1}".format(unitdir, testname), set_cwd=tmpdir).run()
+        log_debug("Vanadis unit test {0} result = {1}; output =\n{2}".format(testname, rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "Vanadis unit test {0} failed:\n{1}".format(testname, rtn.output()))
+
+    def test_vanadis_checkpoint_roundtrip(self):
+        self.vanadis_unit_test_template("testcheckpoint")
+
 ###############################################
 
+    # Compare the sampler's extrapolated cycle count against the cycle count of
+    # the detailed run, the number of samples of the per-cycle retire statistic
+    def _checkExtrapolatedCycles(self, testname, sst_outfile, ref_sst_outfile):
+        if not os.path.exists( ref_sst_outfile ):
+            log_testing_note("vanadis test {0} SST gold file does not exist, did not compare cycles".format(testname))
+            return
+
+        detailed_cycles = None
+        with open(ref_sst_outfile) as fp:
+            for line in fp:
+                if ".cpu0.instructions_retired.1 " in line:
+                    detailed_cycles = int(line.split("Count.u64 = ")[1].split(";")[0])
+
+        extrapolated_cycles = None
+        with open(sst_outfile) as fp:
+            for line in fp:
+                if "-> Extrapolated:" in line:
+                    extrapolated_cycles = float(line.split("-> Extrapolated:")[1].split()[0])
+
+        self.assertTrue(detailed_cycles is not None, "Vanadis gold file {0} has no retire statistic".format(ref_sst_outfile))
+        self.assertTrue(extrapolated_cycles is not None, "Vanadis output file {0} has no sampling summary".format(sst_outfile))
+
+        error = abs(extrapolated_cycles - detailed_cycles) / detailed_cycles
+        log_debug("Vanadis test {0}: extrapolated {1} cycles, detailed {2} cycles, error {3:.3f}".format(testname, extrapolated_cycles, detailed_cycles, error))
+        self.assertTrue(error < 0.25, "Vanadis test {0} extrapolated {1} cycles, detailed run took {2}".format(testname, extrapolated_cycles, detailed_cycles))
+
+    # Every instruction of a functional run retires functionally, and as many
+    # retire as in the detailed run
+    def _checkFunctionalInstructions(self, testname, sst_outfile, ref_sst_outfile):
+        retired = self._readStatisticSum(sst_outfile, ".cpu0.instructions_retired.1 ")
+        functional = self._readStatisticSum(sst_outfile, ".cpu0.functional_instructions.1 ")
+
+        self.assertTrue(retired is not None, "Vanadis output file {0} has no retire statistic".format(sst_outfile))
+        self.assertTrue(functional is not None, "Vanadis output file {0} has no functional statistic".format(sst_outfile))
+        self.assertTrue(retired > 0 and functional == retired,
+            "Vanadis test {0} retired {1} instructions, {2} of them functionally".format(testname, retired, functional))
+
+        if not os.path.exists( ref_sst_outfile ):
+            log_testing_note("vanadis test {0} SST gold file does not exist, did not compare instructions".format(testname))
+            return
+
+        detailed = self._readStatisticSum(ref_sst_outfile, ".cpu0.instructions_retired.1 ")
+        self.assertTrue(detailed == retired,
+            "Vanadis test {0} retired {1} instructions functionally, the detailed run retired {2}".format(testname, retired, detailed))
+
+    # The core's summary and the profile read back by sst-vanadis-cpistack
+    # must both charge every retire slot of every cycle exactly once
+    def _checkCPIStack(self, testname, sst_outfile, outdir, mode, numHwThreads):
+        retires_per_cycle = int(os.getenv("VANADIS_RETIRES_PER_CYCLE", 4))
+
+        header = None
+        categories = {}
+        with open(sst_outfile) as fp:
+            for line in fp:
+                m = re.search(r"Vanadis Core 0 CPI Stack \((\d+) cycles, (\d+) slots\)", line)
+                if m:
+                    header = (int(m.group(1)), int(m.group(2)))
+                m = re.search(r"-> (\S+)\s+(\d+) slots /", line)
+                if m and header is not None:
+                    categories[m.group(1)] = int(m.group(2))
+
+        self.assertTrue(header is not None, "Vanadis output file {0} has no CPI stack summary".format(sst_outfile))
+        cycles, slots = header
+        self.assertTrue(cycles > 0, "Vanadis test {0} accounted no cycles".format(testname))
+        self.assertEqual(sum(categories.values()), slots,
+            "Vanadis test {0}: CPI stack categories add up to {1} slots, not {2}".format(testname, sum(categories.values()), slots))
+        self.assertEqual(slots, cycles * retires_per_cycle * numHwThreads,
+            "Vanadis test {0}: {1} slots for {2} cycles of {3} slots".format(testname, slots, cycles, retires_per_cycle * numHwThreads))
+
+        # a branch and its delay slot share one retiring slot
+        retired = self._readStatisticSum(sst_outfile, ".cpu0.instructions_retired.1 ")
+        self.assertTrue(0 < categories.get("retiring", 0) <= retired,
+            "Vanadis test {0}: {1} retiring slots for {2} retired instructions".format(testname, categories.get("retiring", 0), retired))
+
+        elem_bin_dir = sstsimulator_conf_get_value_str("SST_ELEMENT_LIBRARY", "SST_ELEMENT_LIBRARY_BINDIR", "BINDIR_UNDEFINED")
+        tool = "{0}/sst-vanadis-cpistack".format(elem_bin_dir)
+        self.assertTrue(os.path.isfile(tool), "sst-vanadis-cpistack not found in {0}".format(elem_bin_dir))
+
+        rtn = OSCommand("{0} --top 5 cpistack.bin".format(tool), set_cwd=outdir).run()
+        self.assertTrue(rtn.result() == 0, "sst-vanadis-cpistack failed on {0}:\n{1}".format(testname, rtn.output()))
+        summary = rtn.output()
+
+        m = re.search(r"Core 0: (\d+) cycles, (\d+) retire slots x (\d+) threads, (\d+) records", summary)
+        self.assertTrue(m is not None, "sst-vanadis-cpistack printed no header:\n{0}".format(summary))
+        self.assertEqual((int(m.group(1)), int(m.group(2)), int(m.group(3))), (cycles, retires_per_cycle, numHwThreads),
+            "sst-vanadis-cpistack header does not match the core summary:\n{0}".format(summary))
+        self.assertTrue(int(m.group(4)) > 0, "sst-vanadis-cpistack found no records:\n{0}".format(summary))
+
+        for name, count in categories.items():
+            self.assertTrue(re.search(r"^  {0}\s+{1} ".format(name, count), summary, re.MULTILINE) is not None,
+                "sst-vanadis-cpistack does not report {0} {1} slots:\n{2}".format(name, count, summary))
+
+        rtn = OSCommand("{0} --folded cpistack.bin".format(tool), set_cwd=outdir).run()
+        self.assertTrue(rtn.result() == 0, "sst-vanadis-cpistack --folded failed on {0}:\n{1}".format(testname, rtn.output()))
+        folded = [ line.rsplit(" ", 1) for line in rtn.output().splitlines() if line.strip() ]
+        self.assertEqual(sum(int(count) for stack, count in folded), slots,
+            "Vanadis test {0}: folded stacks do not add up to {1} slots".format(testname, slots))
+
+        # test-branch spends almost all of its time in its loop in main
+        if mode == "function":
+            self.assertTrue(any(stack.startswith("main;") for stack, count in folded),
+                "Vanadis test {0}: no folded stack for main".format(testname))
+        else:
+            self.assertTrue(all(stack.startswith("0x") for stack, count in folded),
+                "Vanadis test {0}: folded stacks are not keyed by PC".format(testname))
+
+    def _readStatisticSum(self, sst_outfile, name):
+        value = None
+        with open(sst_outfile) as fp:
+            for line in fp:
+                if name in line:
+                    value = int(line.split("Sum.u64 = ")[1].split(";")[0])
+        return value
+
     def _checkSkipConditions(self,isa):
         # Check to see if the musl compiler is missing
         if MakeTests:
@@ -0,0 +1,184 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Save/restore round trip of the node OS checkpoint file
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "checkpoint.h"
+
+using namespace SST::Vanadis::OS;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if ( ! (cond) ) { \
+            printf( "FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond ); \
+            failures++; \
+        } \
+    } while ( 0 )
+
+static Checkpoint makeCheckpoint()
+{
+    Checkpoint ckpt;
+    ckpt.pageSize = 4096;
+    ckpt.simTimeNano = 123456789012ull;
+
+    Checkpoint::Process proc;
+    proc.pid = 100;
+    proc.ppid = 0;
+    proc.pgid = 100;
+    proc.brk = 0x10a000;
+    proc.exe = "/path/to/exe";
+
+    Checkpoint::Region text = { "text", 0x10000, 0x8000, 5, true, 0x10000, {} };
+    Checkpoint::Region heap = { "heap", 0x100000, 0xa000, 3, false, 0, { 1, 2, 3, 0xff } };
+    proc.regions.push_back( text );
+    proc.regions.push_back( heap );
+
+    Checkpoint::Page zero = { 0x100, 3, true, {} };
+    Checkpoint::Page data = { 0x101, 3, false, std::vector<uint8_t>( ckpt.pageSize ) };
+    for ( size_t i = 0; i < data.data.size(); i++ ) {
+        data.data[i] = (uint8_t) ( i * 7 + 1 );
+    }
+    proc.pages.push_back( zero );
+    proc.pages.push_back( data );
+
+    Checkpoint::File file = { 3, -1, 0x123456789ull, "input.txt" };
+    proc.files.push_back( file );
+
+    Checkpoint::Thread thread;
+    thread.core = 1;
+    thread.hwThread = 0;
+    thread.tid = 100;
+    thread.instPtr = 0x10abc;
+    thread.tlsPtr = 0x7fff0000;
+    thread.tidAddress = 0;
+    for ( uint64_t i = 0; i < 32; i++ ) {
+        thread.intRegs.push_back( i * 0x0101010101010101ull );
+        thread.fpRegs.push_back( ~i );
+    }
+    proc.threads.push_back( thread );
+
+    ckpt.processes.push_back( proc );
+    return ckpt;
+}
+
+static void compare( const Checkpoint& a, const Checkpoint& b )
+{
+    CHECK( a.pageSize == b.pageSize );
+    CHECK( a.simTimeNano == b.simTimeNano );
+    CHECK( a.processes.size() == b.processes.size() );
+    if ( a.processes.size() != b.processes.size() ) { return; }
+
+    for ( size_t p = 0; p < a.processes.size(); p++ ) {
+        auto& x = a.processes[p];
+        auto& y = b.processes[p];
+
+        CHECK( x.pid == y.pid && x.ppid == y.ppid && x.pgid == y.pgid );
+        CHECK( x.brk == y.brk && x.exe == y.exe );
+
+        CHECK( x.regions.size() == y.regions.size() );
+        for ( size_t i = 0; i < x.regions.size() && i < y.regions.size(); i++ ) {
+            CHECK( x.regions[i].name == y.regions[i].name );
+            CHECK( x.regions[i].addr == y.regions[i].addr );
+            CHECK( x.regions[i].length == y.regions[i].length );
+            CHECK( x.regions[i].perms == y.regions[i].perms );
+            CHECK( x.regions[i].elfBacked == y.regions[i].elfBacked );
+            CHECK( x.regions[i].dataStartAddr == y.regions[i].dataStartAddr );
+            CHECK( x.regions[i].data == y.regions[i].data );
+        }
+
+        CHECK( x.pages.size() == y.pages.size() );
+        for ( size_t i = 0; i < x.pages.size() && i < y.pages.size(); i++ ) {
+            CHECK( x.pages[i].vpn == y.pages[i].vpn );
+            CHECK( x.pages[i].perms == y.pages[i].perms );
+            CHECK( x.pages[i].zero == y.pages[i].zero );
+            CHECK( x.pages[i].data == y.pages[i].data );
+        }
+
+        CHECK( x.files.size() == y.files.size() );
+        for ( size_t i = 0; i < x.files.size() && i < y.files.size(); i++ ) {
+            CHECK( x.files[i].fd == y.files[i].fd );
+            CHECK( x.files[i].flags == y.files[i].flags );
+            CHECK( x.files[i].offset == y.files[i].offset );
+            CHECK( x.files[i].path == y.files[i].path );
+        }
+
+        CHECK( x.threads.size() == y.threads.size() );
+        for ( size_t i = 0; i < x.threads.size() && i < y.threads.size(); i++ ) {
+            CHECK( x.threads[i].core == y.threads[i].core );
+            CHECK( x.threads[i].hwThread == y.threads[i].hwThread );
+            CHECK( x.threads[i].tid == y.threads[i].tid );
+            CHECK( x.threads[i].instPtr == y.threads[i].instPtr );
+            CHECK( x.threads[i].tlsPtr == y.threads[i].tlsPtr );
+            CHECK( x.threads[i].tidAddress == y.threads[i].tidAddress );
+            CHECK( x.threads[i].intRegs == y.threads[i].intRegs );
+            CHECK( x.threads[i].fpRegs == y.threads[i].fpRegs );
+        }
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    const std::string path = "testcheckpoint.ckpt";
+
+    Checkpoint saved = makeCheckpoint();
+    CHECK( saved.write( path ) );
+
+    Checkpoint restored;
+    CHECK( restored.read( path ) );
+    compare( saved, restored );
+
+    // The file is little-endian whatever the host, the magic reads as text
+    FILE* fp = fopen( path.c_str(), "rb" );
+    char magic[9] = { 0 };
+    CHECK( nullptr != fp && 8 == fread( magic, 1, 8, fp ) );
+    CHECK( std::string( magic ) == "VNDSCKPT" );
+
+    // version follows the magic
+    uint8_t version[4] = { 0 };
+    CHECK( nullptr != fp && 4 == fread( version, 1, 4, fp ) );
+    CHECK( version[0] == Checkpoint::Version && version[1] == 0 && version[2] == 0 && version[3] == 0 );
+
+    fseek( fp, 0, SEEK_END );
+    const long length = ftell( fp );
+    fclose( fp );
+
+    // A truncated checkpoint must be rejected
+    std::vector<char> bytes( length );
+    fp = fopen( path.c_str(), "rb" );
+    CHECK( length == (long) fread( bytes.data(), 1, length, fp ) );
+    fclose( fp );
+
+    fp = fopen( path.c_str(), "wb" );
+    fwrite( bytes.data(), 1, length - 1, fp );
+    fclose( fp );
+
+    Checkpoint truncated;
+    CHECK( ! truncated.read( path ) );
+
+    remove( path.c_str() );
+
+    if ( failures ) {
+        printf( "testcheckpoint: %d checks failed\n", failures );
+        return 1;
+    }
+
+    printf( "testcheckpoint: passed\n" );
+    return 0;
+}
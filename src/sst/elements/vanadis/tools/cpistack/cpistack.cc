@@ -0,0 +1,270 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Reads a Vanadis CPI stack profile (cpi_stack_file) and prints either a
+// summary of the most expensive PCs/functions or folded stacks suitable for
+// flamegraph.pl ("<pc or function>;<category> <slots>").
+
+#include "vcpistackfmt.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace SST::Vanadis;
+
+struct ProfileRecord {
+    uint64_t              key;
+    std::string           name;
+    std::vector<uint64_t> counts;
+    uint64_t              total;
+};
+
+static bool
+read_u32(FILE* input_file, uint32_t& value) {
+    value = 0;
+
+    for (int i = 0; i < 4; ++i) {
+        const int next = fgetc(input_file);
+
+        if (EOF == next) {
+            return false;
+        }
+
+        value |= ((uint32_t)next) << (8 * i);
+    }
+
+    return true;
+}
+
+static bool
+read_u64(FILE* input_file, uint64_t& value) {
+    value = 0;
+
+    for (int i = 0; i < 8; ++i) {
+        const int next = fgetc(input_file);
+
+        if (EOF == next) {
+            return false;
+        }
+
+        value |= ((uint64_t)next) << (8 * i);
+    }
+
+    return true;
+}
+
+static void
+truncated(const char* path) {
+    fprintf(stderr, "Error: profile %s is truncated or corrupt.\n", path);
+    exit(1);
+}
+
+static std::string
+record_label(const ProfileRecord& record, const uint32_t granularity) {
+    char buffer[64];
+
+    if (((uint32_t)VanadisCPIGranularity::FUNCTION) == granularity) {
+        if (record.name.empty()) {
+            snprintf(buffer, 64, "0x%" PRIx64, record.key);
+            return std::string(buffer);
+        }
+
+        return record.name;
+    }
+
+    if (((uint32_t)VanadisCPIGranularity::PC) == granularity) {
+        snprintf(buffer, 64, "0x%" PRIx64, record.key);
+        return std::string(buffer);
+    }
+
+    return std::string("all");
+}
+
+int
+main(int argc, char* argv[]) {
+    const char* profile_path = nullptr;
+    bool folded = false;
+    size_t top_n = 20;
+
+    for (int i = 1; i < argc; ++i) {
+        if (0 == strcmp(argv[i], "--folded")) {
+            folded = true;
+        } else if ((0 == strcmp(argv[i], "--top")) && (i + 1 < argc)) {
+            top_n = (size_t)atol(argv[++i]);
+        } else {
+            profile_path = argv[i];
+        }
+    }
+
+    if (nullptr == profile_path) {
+        fprintf(stderr, "usage: sst-vanadis-cpistack [--folded] [--top N] <profile>\n");
+        exit(1);
+    }
+
+    FILE* input_file = fopen(profile_path, "rb");
+
+    if (nullptr == input_file) {
+        fprintf(stderr, "Error: unable to open %s\n", profile_path);
+        exit(1);
+    }
+
+    char magic[4];
+
+    if ((4 != fread(magic, 1, 4, input_file)) || (0 != memcmp(magic, VANADIS_CPI_STACK_MAGIC, 4))) {
+        fprintf(stderr, "Error: %s is not a Vanadis CPI stack profile.\n", profile_path);
+        exit(1);
+    }
+
+    uint32_t version = 0, core = 0, granularity = 0, slots = 0, threads = 0, category_count = 0;
+    uint64_t cycles = 0;
+
+    if (!read_u32(input_file, version) || !read_u32(input_file, core) || !read_u32(input_file, granularity) ||
+        !read_u32(input_file, slots) || !read_u32(input_file, threads) || !read_u64(input_file, cycles) ||
+        !read_u32(input_file, category_count)) {
+        truncated(profile_path);
+    }
+
+    if (VANADIS_CPI_STACK_VERSION != version) {
+        fprintf(stderr, "Error: unsupported profile version %" PRIu32 "\n", version);
+        exit(1);
+    }
+
+    std::vector<std::string> categories;
+
+    for (uint32_t i = 0; i < category_count; ++i) {
+        const int len = fgetc(input_file);
+
+        if (EOF == len) {
+            truncated(profile_path);
+        }
+
+        std::string name(len, '\0');
+
+        if ((size_t)len != fread(&name[0], 1, len, input_file)) {
+            truncated(profile_path);
+        }
+
+        categories.push_back(name);
+    }
+
+    uint64_t record_count = 0;
+
+    if (!vanadis_cpi_read_varint(input_file, record_count)) {
+        truncated(profile_path);
+    }
+
+    std::vector<ProfileRecord> records;
+    std::vector<uint64_t> totals(category_count, 0);
+    uint64_t key = 0;
+
+    for (uint64_t i = 0; i < record_count; ++i) {
+        ProfileRecord record;
+        uint64_t delta = 0;
+
+        if (!vanadis_cpi_read_varint(input_file, delta)) {
+            truncated(profile_path);
+        }
+
+        key += delta;
+        record.key = key;
+        record.total = 0;
+
+        if (((uint32_t)VanadisCPIGranularity::FUNCTION) == granularity) {
+            uint64_t name_len = 0;
+
+            if (!vanadis_cpi_read_varint(input_file, name_len)) {
+                truncated(profile_path);
+            }
+
+            record.name.resize(name_len);
+
+            if ((name_len > 0) && (name_len != fread(&record.name[0], 1, name_len, input_file))) {
+                truncated(profile_path);
+            }
+        }
+
+        for (uint32_t j = 0; j < category_count; ++j) {
+            uint64_t count = 0;
+
+            if (!vanadis_cpi_read_varint(input_file, count)) {
+                truncated(profile_path);
+            }
+
+            record.counts.push_back(count);
+            record.total += count;
+            totals[j] += count;
+        }
+
+        records.push_back(record);
+    }
+
+    fclose(input_file);
+
+    if (folded) {
+        for (const ProfileRecord& record : records) {
+            const std::string label = record_label(record, granularity);
+
+            for (uint32_t j = 0; j < category_count; ++j) {
+                if (record.counts[j] > 0) {
+                    printf("%s;%s %" PRIu64 "\n", label.c_str(), categories[j].c_str(), record.counts[j]);
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    uint64_t total_slots = 0;
+
+    for (uint64_t next : totals) {
+        total_slots += next;
+    }
+
+    printf("Core %" PRIu32 ": %" PRIu64 " cycles, %" PRIu32 " retire slots x %" PRIu32 " threads, %" PRIu64
+           " records\n",
+           core, cycles, slots, threads, record_count);
+
+    for (uint32_t j = 0; j < category_count; ++j) {
+        printf("  %-16s %15" PRIu64 " %6.2f%%\n", categories[j].c_str(), totals[j],
+               (total_slots > 0) ? (100.0 * totals[j]) / total_slots : 0.0);
+    }
+
+    std::sort(records.begin(), records.end(),
+              [](const ProfileRecord& a, const ProfileRecord& b) { return a.total > b.total; });
+
+    printf("\nTop %" PRIu64 " by slots:\n", (uint64_t)std::min(top_n, records.size()));
+
+    for (size_t i = 0; i < std::min(top_n, records.size()); ++i) {
+        const ProfileRecord& record = records[i];
+        uint32_t worst = 0;
+
+        for (uint32_t j = 1; j < category_count; ++j) {
+            if (record.counts[j] > record.counts[worst]) {
+                worst = j;
+            }
+        }
+
+        printf("  %-40s %15" PRIu64 " %6.2f%%  (mostly %s)\n", record_label(record, granularity).c_str(),
+               record.total, (total_slots > 0) ? (100.0 * record.total) / total_slots : 0.0,
+               categories[worst].c_str());
+    }
+
+    return 0;
+}
@@ -152,6 +152,23 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
             thread_decoders[i]->getISAName(), thread_decoders[i]->countISAIntReg(),
             thread_decoders[i]->countISAFPReg());
 
+        // vector state is held in extra ISA registers so the physical files must be able to hold all of them
+        // and still leave registers free for renaming
+        if ( thread_decoders[i]->getVectorLengthBytes() > 0 ) {
+            const uint32_t required_int = (uint32_t)thread_decoders[i]->countISAIntReg() + 1;
+            const uint32_t required_fp  = (uint32_t)thread_decoders[i]->countISAFPReg() + 1;
+
+            if ( (required_int > int_reg_count) || (required_fp > fp_reg_count) ) {
+                output->fatal(
+                    CALL_INFO, -1,
+                    "Error: thread %" PRIu32 " has %" PRIu16 "-bit vector registers and needs at least %" PRIu32
+                    " integer and %" PRIu32 " floating point physical registers, configured with %" PRIu16
+                    " and %" PRIu16 ". Increase physical_integer_registers/physical_fp_registers.\n",
+                    i, (uint16_t)(thread_decoders[i]->getVectorLengthBytes() * 8), required_int, required_fp,
+                    int_reg_count, fp_reg_count);
+            }
+        }
+
         register_files.push_back(new VanadisRegisterFile(
             i, thread_decoders[i]->getDecoderOptions(), int_reg_count, fp_reg_count, thr_decoder->getFPRegisterMode()));
         int_register_stacks.push_back(new VanadisRegisterStack(int_reg_count));
@@ -298,6 +315,32 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
         fu_fp_div.push_back(new VanadisFunctionalUnit(fu_id++, INST_FP_DIV, fp_div_cycles));
     }
 
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    const uint16_t vector_lanes            = params.find<uint16_t>("vector_lanes", 4);
+    const uint16_t vector_int_arith_units  = params.find<uint16_t>("vector_int_arith_units", 1);
+    const uint16_t vector_int_arith_cycles = params.find<uint16_t>("vector_int_arith_cycles", 2);
+    const uint16_t vector_fp_arith_units   = params.find<uint16_t>("vector_fp_arith_units", 1);
+    const uint16_t vector_fp_arith_cycles  = params.find<uint16_t>("vector_fp_arith_cycles", 8);
+
+    if ( 0 == vector_lanes ) { output->fatal(CALL_INFO, -1, "Error: vector_lanes must be at least 1.\n"); }
+
+    output->verbose(
+        CALL_INFO, 2, 0,
+        "Creating %" PRIu16 " vector integer units, latency = %" PRIu16 " and %" PRIu16
+        " vector floating point units, latency = %" PRIu16 " (lanes = %" PRIu16 ")...\n",
+        vector_int_arith_units, vector_int_arith_cycles, vector_fp_arith_units, vector_fp_arith_cycles, vector_lanes);
+
+    for ( uint16_t i = 0; i < vector_int_arith_units; ++i ) {
+        fu_vector_int.push_back(
+            new VanadisFunctionalUnit(fu_id++, INST_VECTOR_INT_ARITH, vector_int_arith_cycles, vector_lanes));
+    }
+
+    for ( uint16_t i = 0; i < vector_fp_arith_units; ++i ) {
+        fu_vector_fp.push_back(
+            new VanadisFunctionalUnit(fu_id++, INST_VECTOR_FP_ARITH, vector_fp_arith_cycles, vector_lanes));
+    }
+
     //////////////////////////////////////////////////////////////////////////////////////
     for ( uint32_t i = 0; i < hw_threads; ++i ) {
         thread_decoders[i]->getOSHandler()->setCoreID(core_id);
@@ -334,6 +377,68 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
     start_verbose_when_issue_address = params.find<uint64_t>("start_verbose_when_issue_address", 0);
     stop_verbose_when_retire_address = params.find<uint64_t>("stop_verbose_when_retire_address", 0);
 
+    const uint64_t ff_instructions   = params.find<uint64_t>("fast_forward_instructions", 0);
+    const uint64_t ff_address        = params.find<uint64_t>("fast_forward_until_address", 0);
+    const uint64_t sample_period     = params.find<uint64_t>("sample_period", 0);
+    const uint64_t sample_detailed   = params.find<uint64_t>("sample_detailed_instructions", 10000);
+    const uint64_t sample_warming    = params.find<uint64_t>("sample_warming_instructions", 2000);
+    fast_forward_rounds              = std::max(params.find<uint32_t>("fast_forward_rounds_per_cycle", 16), (uint32_t)1);
+
+    sampler = new VanadisSampler(ff_instructions, ff_address, sample_period, sample_detailed, sample_warming);
+
+    if ( sampler->isEnabled() ) {
+        output->verbose(CALL_INFO, 2, 0, "Fast-forward/sampling configuration:\n");
+        output->verbose(CALL_INFO, 2, 0, "-> Fast-forward instructions:  %" PRIu64 "\n", ff_instructions);
+        output->verbose(CALL_INFO, 2, 0, "-> Fast-forward until address: 0x%" PRIx64 "\n", ff_address);
+        output->verbose(CALL_INFO, 2, 0, "-> Sample period:              %" PRIu64 "\n", sample_period);
+        output->verbose(CALL_INFO, 2, 0, "-> Sample detailed/warming:    %" PRIu64 " / %" PRIu64 "\n",
+            sample_detailed, sample_warming);
+        output->verbose(CALL_INFO, 2, 0, "-> Initial execution mode:     %s\n",
+            getExecutionModeName(sampler->getMode()));
+    }
+
+    const std::string cpi_stack_mode = params.find<std::string>("cpi_stack", "none");
+    cpi_stack_path                   = params.find<std::string>("cpi_stack_file", "");
+    cpi_stack                        = nullptr;
+    cpi_last_cycle                   = 0;
+
+    if ( cpi_stack_mode != "none" ) {
+        VanadisCPIGranularity granularity = VanadisCPIGranularity::GLOBAL;
+
+        if ( cpi_stack_mode == "global" ) { granularity = VanadisCPIGranularity::GLOBAL; }
+        else if ( cpi_stack_mode == "pc" ) {
+            granularity = VanadisCPIGranularity::PC;
+        }
+        else if ( cpi_stack_mode == "function" ) {
+            granularity = VanadisCPIGranularity::FUNCTION;
+        }
+        else {
+            output->fatal(
+                CALL_INFO, -1, "Error: cpi_stack must be none, global, pc or function (got: %s)\n",
+                cpi_stack_mode.c_str());
+        }
+
+        cpi_stack = new VanadisCPIStack(granularity, retires_per_cycle, hw_threads);
+
+        if ( granularity == VanadisCPIGranularity::FUNCTION ) {
+            const std::string cpi_binary = params.find<std::string>("cpi_stack_binary", "");
+
+            if ( cpi_binary.empty() ) {
+                output->fatal(CALL_INFO, -1, "Error: cpi_stack = function requires cpi_stack_binary to be set.\n");
+            }
+
+            VanadisELFInfo* cpi_elf_info = readBinaryELFInfo(output, cpi_binary.c_str());
+            cpi_stack->loadSymbols(cpi_elf_info);
+            delete cpi_elf_info;
+
+            output->verbose(
+                CALL_INFO, 2, 0, "CPI stack loaded %" PRIu64 " function symbols from %s\n",
+                (uint64_t)cpi_stack->countFunctions(), cpi_binary.c_str());
+        }
+
+        output->verbose(CALL_INFO, 2, 0, "CPI stack accounting enabled (granularity: %s)\n", cpi_stack_mode.c_str());
+    }
+
     // Register statistics ///////////////////////////////////////////////////////
     stat_ins_retired          = registerStatistic<uint64_t>("instructions_retired", "1");
     stat_ins_decoded          = registerStatistic<uint64_t>("instructions_decoded", "1");
@@ -348,6 +453,10 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
     stat_syscall_cycles       = registerStatistic<uint64_t>("syscall-cycles", "1");
     stat_int_phys_regs_in_use = registerStatistic<uint64_t>("phys_int_reg_in_use", "1");
     stat_fp_phys_regs_in_use  = registerStatistic<uint64_t>("phys_fp_reg_in_use", "1");
+    stat_functional_ins       = registerStatistic<uint64_t>("functional_instructions", "1");
+    stat_functional_cycles    = registerStatistic<uint64_t>("functional_cycles", "1");
+    stat_sampled_ins          = registerStatistic<uint64_t>("sampled_instructions", "1");
+    stat_sampled_cycles       = registerStatistic<uint64_t>("sampled_cycles", "1");
 
     //registerAsPrimaryComponent();
     //primaryComponentDoNotEndSim();
@@ -357,6 +466,8 @@ VANADIS_COMPONENT::~VANADIS_COMPONENT()
 {
     delete[] instPrintBuffer;
     delete lsq;
+    delete sampler;
+    delete cpi_stack;
 
     for ( int i= 0; i < rob.size(); i++ ) {
         delete rob[i];
@@ -674,6 +785,24 @@ VANADIS_COMPONENT::performExecute(const uint64_t cycle)
     for ( VanadisFunctionalUnit* next_fu : fu_fp_div ) {
         next_fu->tick(cycle, output, register_files);
 
+#ifdef VANADIS_BUILD_DEBUG
+        if(verbose_level >= 16)
+            next_fu->print(output);
+#endif
+    }
+
+    for ( VanadisFunctionalUnit* next_fu : fu_vector_int ) {
+        next_fu->tick(cycle, output, register_files);
+
+#ifdef VANADIS_BUILD_DEBUG
+        if(verbose_level >= 16)
+            next_fu->print(output);
+#endif
+    }
+
+    for ( VanadisFunctionalUnit* next_fu : fu_vector_fp ) {
+        next_fu->tick(cycle, output, register_files);
+
 #ifdef VANADIS_BUILD_DEBUG
         if(verbose_level >= 16)
             next_fu->print(output);
@@ -900,6 +1029,12 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
                 fprintf(pipelineTrace, "0x%08llx %s\n", rob_front->getInstructionAddress(), rob_front->getInstCode());
             }
 
+            if ( UNLIKELY(sampler->checkMarker(rob_front->getInstructionAddress())) ) {
+                output->verbose(
+                    CALL_INFO, 1, 0, "Retired fast-forward marker 0x%llx, switching to %s execution at cycle %" PRIu64 "\n",
+                    rob_front->getInstructionAddress(), getExecutionModeName(sampler->getMode()), cycle);
+            }
+
 			if(UNLIKELY(rob_front->updatesFPFlags())) {
                 output->verbose(CALL_INFO, 16, 0, "------> updating floating-point flags.\n");
 				rob_front->updateFPFlags();
@@ -925,6 +1060,10 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
 
             ins_retired_this_cycle++;
 
+            if ( UNLIKELY(nullptr != cpi_stack) && !sampler->isFunctional() ) {
+                cpi_stack->retire(ins_thread, rob_front->getInstructionAddress());
+            }
+
             if ( perform_delay_cleanup ) {
 
                 VanadisInstruction* delay_ins = rob->pop();
@@ -955,6 +1094,10 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
 #endif
                 ins_retired_this_cycle++;
 
+                if ( UNLIKELY(nullptr != cpi_stack) && !sampler->isFunctional() ) {
+                    cpi_stack->retireDelaySlot(ins_thread);
+                }
+
                 delete delay_ins;
             }
 
@@ -998,6 +1141,10 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
 #endif
                 handleMisspeculate(ins_thread, pipeline_reset_addr);
 
+                if ( UNLIKELY(nullptr != cpi_stack) ) {
+                    cpi_stack->misspeculate(ins_thread, rob_front->getInstructionAddress());
+                }
+
                 stat_branch_mispredicts->addData(1);
             }
 
@@ -1062,6 +1209,154 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
     return 0;
 }
 
+// Branches with a MIPS delay slot, the slot must have executed before they retire
+static bool
+hasDelaySlot(VanadisInstruction* ins)
+{
+    VanadisSpeculatedInstruction* spec_ins = dynamic_cast<VanadisSpeculatedInstruction*>(ins);
+
+    return (nullptr != spec_ins) && (VANADIS_NO_DELAY_SLOT != spec_ins->getDelaySlotType());
+}
+
+bool
+VANADIS_COMPONENT::performFunctional(const uint64_t cycle)
+{
+    bool declock = false;
+
+    // Each thread runs up to fast_forward_rounds instructions strictly in order.
+    // The ROB only buffers the decoded stream, an instruction is taken from its
+    // head, executed against the register file and retired before the next is
+    // looked at, so nothing is renamed ahead, scheduled or speculated.
+    for ( uint32_t i = 0; i < hw_threads; ++i ) {
+        for ( uint32_t step = 0; step < fast_forward_rounds; ++step ) {
+            if ( halted_masks[i] ) { break; }
+
+            if ( rob[i]->empty() ) {
+                thread_decoders[i]->tick(output, cycle);
+                ins_decoded_this_cycle += rob[i]->size();
+
+                if ( rob[i]->empty() ) { break; }
+            }
+
+            VanadisInstruction* ins        = rob[i]->peek();
+            bool                delay_wait = false;
+
+            if ( !ins->completedIssue() && (0 != issueFunctional(i, ins)) ) { break; }
+
+            // A MIPS delay slot executes after its branch and retires with it,
+            // retire waits for it so it has to be issued in this same step
+            if ( hasDelaySlot(ins) ) {
+                if ( rob[i]->size() < 2 ) {
+                    const size_t decoded = rob[i]->size();
+                    thread_decoders[i]->tick(output, cycle);
+                    ins_decoded_this_cycle += rob[i]->size() - decoded;
+
+                    if ( rob[i]->size() < 2 ) { break; }
+                }
+
+                VanadisInstruction* delay_ins = rob[i]->peekAt(1);
+
+                if ( !delay_ins->completedIssue() && (0 != issueFunctional(i, delay_ins)) ) { break; }
+
+                delay_wait = !delay_ins->completedExecution();
+            }
+
+            const int retire_rc = performRetire(rob[i], cycle);
+
+            if ( retire_rc == INT_MAX ) {
+                declock = true;
+                break;
+            }
+            else if ( (retire_rc != 0) || delay_wait ) {
+                // the head or its delay slot is waiting on memory
+                break;
+            }
+        }
+    }
+
+    // Instructions issued before a switch from detailed execution drain through
+    // the functional units, this also ticks the LSQ
+    performExecute(cycle);
+
+    return declock;
+}
+
+int
+VANADIS_COMPONENT::issueFunctional(const uint32_t hw_thr, VanadisInstruction* ins)
+{
+    if ( 0 != checkInstructionResources(
+                  ins, int_register_stacks[hw_thr], fp_register_stacks[hw_thr], issue_isa_tables[hw_thr]) ) {
+        return 1;
+    }
+
+    // Memory operations and syscalls are the only instructions which
+    // leave the core, they go to the LSQ and OS as usual
+    const bool direct = executesFunctionally(ins);
+
+    if ( !direct && (0 != allocateFunctionalUnit(ins)) ) { return 1; }
+
+    assignRegistersToInstruction(
+        thread_decoders[hw_thr]->countISAIntReg(), thread_decoders[hw_thr]->countISAFPReg(), ins,
+        int_register_stacks[hw_thr], fp_register_stacks[hw_thr], issue_isa_tables[hw_thr]);
+
+    if ( direct ) {
+        ins->execute(output, register_files[hw_thr]);
+
+        // The next instruction runs in this same cycle, so the zero
+        // register must be cleared again rather than once per tick
+        const uint16_t zero_reg = isa_options[hw_thr]->getRegisterIgnoreWrites();
+
+        if ( zero_reg < isa_options[hw_thr]->countISAIntRegisters() ) {
+            register_files[hw_thr]->setIntReg<uint64_t>(issue_isa_tables[hw_thr]->getIntPhysReg(zero_reg), 0);
+        }
+    }
+
+    ins->markIssued();
+    ins_issued_this_cycle++;
+
+    return 0;
+}
+
+VanadisCPICategory
+VANADIS_COMPONENT::classifyRetireStall(const uint32_t hw_thr, uint64_t& stall_addr)
+{
+    VanadisCircularQueue<VanadisInstruction*>* thr_rob = rob[hw_thr];
+
+    if ( thr_rob->empty() ) {
+        if ( cpi_stack->isRecovering(hw_thr) ) {
+            stall_addr = cpi_stack->getRecoveryAddress(hw_thr);
+            return VanadisCPICategory::BAD_SPECULATION;
+        }
+
+        stall_addr = thread_decoders[hw_thr]->getInstructionPointer();
+        return VanadisCPICategory::FRONTEND;
+    }
+
+    VanadisInstruction*             rob_front = thr_rob->peek();
+    const VanadisFunctionalUnitType fu_type   = rob_front->getInstFuncType();
+    const bool                      is_load   = (INST_LOAD == fu_type);
+    const bool                      is_store  = (INST_STORE == fu_type) || (INST_FENCE == fu_type);
+
+    stall_addr = rob_front->getInstructionAddress();
+
+    if ( INST_SYSCALL == fu_type ) { return VanadisCPICategory::SYSCALL; }
+    if ( rob_front->completedIssue() && rob_front->completedExecution() ) { return VanadisCPICategory::OTHER; }
+
+    if ( !rob_front->completedIssue() ) {
+        if ( (is_load && lsq->loadFull()) || ((INST_STORE == fu_type) && lsq->storeFull()) ) {
+            return VanadisCPICategory::LSQ_FULL;
+        }
+    }
+    else {
+        if ( is_load ) { return VanadisCPICategory::MEMORY_LOAD; }
+        if ( is_store ) { return VanadisCPICategory::MEMORY_STORE; }
+    }
+
+    if ( thr_rob->full() ) { return VanadisCPICategory::ROB_FULL; }
+
+    return rob_front->completedIssue() ? VanadisCPICategory::EXECUTE : VanadisCPICategory::DEPENDENCY;
+}
+
 bool
 VANADIS_COMPONENT::mapInstructiontoFunctionalUnit(
     VanadisInstruction* ins, std::vector<VanadisFunctionalUnit*>& functional_units)
@@ -1134,6 +1429,14 @@ VANADIS_COMPONENT::allocateFunctionalUnit(VanadisInstruction* ins)
         allocated_fu = mapInstructiontoFunctionalUnit(ins, fu_fp_div);
         break;
 
+    case INST_VECTOR_INT_ARITH:
+        allocated_fu = mapInstructiontoFunctionalUnit(ins, fu_vector_int);
+        break;
+
+    case INST_VECTOR_FP_ARITH:
+        allocated_fu = mapInstructiontoFunctionalUnit(ins, fu_vector_fp);
+        break;
+
     case INST_FENCE:
     {
         VanadisFenceInstruction* fence_ins = dynamic_cast<VanadisFenceInstruction*>(ins);
@@ -1182,6 +1485,26 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
     const auto output_verbosity = output->getVerboseLevel();
 #endif
 
+    // the core is not clocked while a syscall is outstanding, charge the
+    // missed cycles to the syscall at the head of the ROB
+    if ( UNLIKELY(nullptr != cpi_stack) ) {
+        if ( (cpi_last_cycle > 0) && (cycle > (cpi_last_cycle + 1)) && !sampler->isFunctional() ) {
+            const uint64_t idle_cycles = cycle - cpi_last_cycle - 1;
+
+            for ( uint32_t i = 0; i < hw_threads; ++i ) {
+                if ( !halted_masks[i] ) {
+                    cpi_stack->chargeIdleCycles(
+                        VanadisCPICategory::SYSCALL, rob[i]->empty() ? 0 : rob[i]->peek()->getInstructionAddress(),
+                        idle_cycles);
+                }
+            }
+
+            cpi_stack->addCycles(idle_cycles);
+        }
+
+        cpi_last_cycle = cycle;
+    }
+
     stat_cycles->addData(1);
     ins_issued_this_cycle  = 0;
     ins_retired_this_cycle = 0;
@@ -1226,114 +1549,151 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
         }
     }
 
-    // Fetch
-    // //////////////////////////////////////////////////////////////////////////
-#ifdef VANADIS_BUILD_DEBUG
-    if(output_verbosity >= 9) {
-        output->verbose(
-            CALL_INFO, 9, 0,
-            "=> Fetch Stage "
-            "<==========================================================\n");
+    bool tick_return = false;
+
+    if ( UNLIKELY(sampler->isFunctional()) ) {
+        tick_return = performFunctional(cycle);
     }
+    else {
+        // Fetch
+        // //////////////////////////////////////////////////////////////////////////
+#ifdef VANADIS_BUILD_DEBUG
+        if(output_verbosity >= 9) {
+            output->verbose(
+                CALL_INFO, 9, 0,
+                "=> Fetch Stage "
+                "<==========================================================\n");
+        }
 #endif
-    for ( uint32_t i = 0; i < fetches_per_cycle; ++i ) {
-        if ( performFetch(cycle) != 0 ) { break; }
-    }
+        for ( uint32_t i = 0; i < fetches_per_cycle; ++i ) {
+            if ( performFetch(cycle) != 0 ) { break; }
+        }
 
-    // Decode
-    // //////////////////////////////////////////////////////////////////////////
+        // Decode
+        // //////////////////////////////////////////////////////////////////////////
 #ifdef VANADIS_BUILD_DEBUG
-    if(output_verbosity >= 9) {
-        output->verbose(
-            CALL_INFO, 9, 0,
-            "=> Decode Stage "
-            "<==========================================================\n");
-    }
+        if(output_verbosity >= 9) {
+            output->verbose(
+                CALL_INFO, 9, 0,
+                "=> Decode Stage "
+                "<==========================================================\n");
+        }
 #endif
-    for ( uint32_t i = 0; i < decodes_per_cycle; ++i ) {
-        if ( performDecode(cycle) != 0 ) { break; }
-    }
-
-    stat_ins_decoded->addData(ins_decoded_this_cycle);
+        for ( uint32_t i = 0; i < decodes_per_cycle; ++i ) {
+            if ( performDecode(cycle) != 0 ) { break; }
+        }
 
-    // Issue
-    // //////////////////////////////////////////////////////////////////////////
+        // Issue
+        // //////////////////////////////////////////////////////////////////////////
 #ifdef VANADIS_BUILD_DEBUG
-    if(output_verbosity >= 9) {
-        output->verbose(
-            CALL_INFO, 9, 0,
-            "=> Issue Stage  "
-            "<==========================================================\n");
-    }
+        if(output_verbosity >= 9) {
+            output->verbose(
+                CALL_INFO, 9, 0,
+                "=> Issue Stage  "
+                "<==========================================================\n");
+        }
 #endif
-    // Clear our temps on a per-thread basis
-    for ( uint32_t i = 0; i < hw_threads; ++i ) {
-        resetRegisterUseTemps(thread_decoders[i]->countISAIntReg(), thread_decoders[i]->countISAFPReg());
-    }
-
-    uint32_t rob_start   = 0;
-    bool unallocated_memory_op_seen = false;
+        // Clear our temps on a per-thread basis
+        for ( uint32_t i = 0; i < hw_threads; ++i ) {
+            resetRegisterUseTemps(thread_decoders[i]->countISAIntReg(), thread_decoders[i]->countISAFPReg());
+        }
 
-    // Attempt to perform issues, cranking through the entire ROB call by call or until we
-    // reach the max issues this cycle
-    for ( uint32_t i = 0; i < issues_per_cycle; ++i ) {
-        if ( performIssue(cycle, rob_start, unallocated_memory_op_seen) != 0 ) { break; }
-    }
+        uint32_t rob_start   = 0;
+        bool unallocated_memory_op_seen = false;
 
-    // Record how many instructions we issued this cycle
-    stat_ins_issued->addData(ins_issued_this_cycle);
+        // Attempt to perform issues, cranking through the entire ROB call by call or until we
+        // reach the max issues this cycle
+        for ( uint32_t i = 0; i < issues_per_cycle; ++i ) {
+            if ( performIssue(cycle, rob_start, unallocated_memory_op_seen) != 0 ) { break; }
+        }
 
-    // Execute
-    // //////////////////////////////////////////////////////////////////////////
+        // Execute
+        // //////////////////////////////////////////////////////////////////////////
 #ifdef VANADIS_BUILD_DEBUG
-    if(output_verbosity >= 9) {
-        output->verbose(
-            CALL_INFO, 9, 0,
-            "=> Execute Stage "
-            "<==========================================================\n");
-    }
+        if(output_verbosity >= 9) {
+            output->verbose(
+                CALL_INFO, 9, 0,
+                "=> Execute Stage "
+                "<==========================================================\n");
+        }
 #endif
-    performExecute(cycle);
-
-    bool tick_return = false;
+        performExecute(cycle);
 
 #ifdef VANADIS_BUILD_DEBUG
-    if(output_verbosity >= 9) {
-        output->verbose(
-            CALL_INFO, 9, 0,
-            "=> Retire Stage "
-            "<==========================================================\n");
-    }
+        if(output_verbosity >= 9) {
+            output->verbose(
+                CALL_INFO, 9, 0,
+                "=> Retire Stage "
+                "<==========================================================\n");
+        }
 #endif
-    // Retire
-    // //////////////////////////////////////////////////////////////////////////
-    for ( uint32_t i = 0; i < retires_per_cycle; ++i ) {
-        for ( uint32_t j = 0; j < rob.size(); ++j ) {
-            const int retire_rc = performRetire(rob[j], cycle);
-
-            if ( retire_rc == INT_MAX ) {
-                // we will return true and tell the handler not to clock us until
-                // re-register
-                tick_return = true;
+        // Retire
+        // //////////////////////////////////////////////////////////////////////////
+        for ( uint32_t i = 0; i < retires_per_cycle; ++i ) {
+            for ( uint32_t j = 0; j < rob.size(); ++j ) {
+                const int retire_rc = performRetire(rob[j], cycle);
+
+                if ( retire_rc == INT_MAX ) {
+                    // we will return true and tell the handler not to clock us until
+                    // re-register
+                    tick_return = true;
 #ifdef VANADIS_BUILD_DEBUG
-                if(output_verbosity >= 8) {
-                    output->verbose(
-                        CALL_INFO, 8, 0,
-                        "--> declocking core, result from retire is SYSCALL "
-                        "pending front of ROB\n");
-                }
+                    if(output_verbosity >= 8) {
+                        output->verbose(
+                            CALL_INFO, 8, 0,
+                            "--> declocking core, result from retire is SYSCALL "
+                            "pending front of ROB\n");
+                    }
 #endif
-            }
-            else {
-                // Signal from retire calls that we can't make progress is non-zero
-                if ( retire_rc != 0 ) { break; }
+                }
+                else {
+                    // Signal from retire calls that we can't make progress is non-zero
+                    if ( retire_rc != 0 ) { break; }
+                }
             }
         }
     }
 
+    stat_ins_decoded->addData(ins_decoded_this_cycle);
+
+    // Record how many instructions we issued this cycle
+    stat_ins_issued->addData(ins_issued_this_cycle);
+
     // Record how many instructions we retired this cycle
     stat_ins_retired->addData(ins_retired_this_cycle);
 
+    // slot accounting is only meaningful for timed execution
+    if ( UNLIKELY(nullptr != cpi_stack) && !sampler->isFunctional() ) {
+        for ( uint32_t i = 0; i < hw_threads; ++i ) {
+            if ( halted_masks[i] ) { continue; }
+
+            uint64_t                 stall_addr = 0;
+            const VanadisCPICategory stall_cat  = classifyRetireStall(i, stall_addr);
+            cpi_stack->endCycle(i, stall_cat, stall_addr);
+        }
+
+        cpi_stack->addCycles(1);
+    }
+
+    if ( UNLIKELY(sampler->isEnabled()) ) {
+        const VanadisExecutionMode cycle_mode = sampler->getMode();
+
+        if ( cycle_mode == VanadisExecutionMode::FUNCTIONAL ) {
+            stat_functional_ins->addData(ins_retired_this_cycle);
+            stat_functional_cycles->addData(1);
+        }
+        else if ( cycle_mode == VanadisExecutionMode::DETAILED ) {
+            stat_sampled_ins->addData(ins_retired_this_cycle);
+            stat_sampled_cycles->addData(1);
+        }
+
+        if ( sampler->tick(ins_retired_this_cycle) ) {
+            output->verbose(
+                CALL_INFO, 2, 0, "Switching from %s to %s execution at cycle %" PRIu64 "\n",
+                getExecutionModeName(cycle_mode), getExecutionModeName(sampler->getMode()), current_cycle);
+        }
+    }
+
     uint64_t rob_total_count = 0;
     for ( uint32_t i = 0; i < hw_threads; ++i ) {
         rob_total_count += rob[i]->size();
@@ -1726,7 +2086,15 @@ VANADIS_COMPONENT::setup()
 
 void
 VANADIS_COMPONENT::finish()
-{}
+{
+    if ( sampler->isEnabled() ) { sampler->print(output, core_id); }
+
+    if ( nullptr != cpi_stack ) {
+        cpi_stack->print(output, core_id);
+
+        if ( !cpi_stack_path.empty() ) { cpi_stack->write(output, cpi_stack_path.c_str(), core_id); }
+    }
+}
 
 void
 VANADIS_COMPONENT::printStatus(SST::Output& output)
@@ -1827,6 +2195,8 @@ VANADIS_COMPONENT::handleMisspeculate(const uint32_t hw_thr, const uint64_t new_
     clearFuncUnit(hw_thr, fu_int_div);
     clearFuncUnit(hw_thr, fu_fp_arith);
     clearFuncUnit(hw_thr, fu_fp_div);
+    clearFuncUnit(hw_thr, fu_vector_int);
+    clearFuncUnit(hw_thr, fu_vector_fp);
     clearFuncUnit(hw_thr, fu_branch);
 
     lsq->clearLSQByThreadID(hw_thr);
@@ -2011,7 +2381,13 @@ void VANADIS_COMPONENT::recvOSEvent(SST::Event* ev) {
                             if (nullptr != req ) {
                                 dumpRegs(req);
                             } else { 
-                                assert(0);
+
+                                VanadisStartThreadRestoreReq* req = dynamic_cast<VanadisStartThreadRestoreReq*>(ev);
+                                if ( nullptr != req ) {
+                                    startThreadRestore( req );
+                                } else {
+                                    assert(0);
+                                }
                             }
                         } 
                     }
@@ -2100,6 +2476,38 @@ void VANADIS_COMPONENT::startThreadFork( VanadisStartThreadForkReq* req )
     handleMisspeculate( hw_thr, req->getInstPtr() + 4 );
 }
 
+void VANADIS_COMPONENT::startThreadRestore( VanadisStartThreadRestoreReq* req )
+{
+    auto hw_thr = req->getThread();
+    auto thr_decoder = thread_decoders[hw_thr];
+    auto isa_table = retire_isa_tables[hw_thr];
+    auto reg_file = register_files[hw_thr];
+
+    resetHwThread( hw_thr );
+    reregisterClock(cpuClockTC, cpuClockHandler);
+
+    output->verbose(CALL_INFO, 8, 0,"restore thread from checkpoint, thread=%d instPtr=%lx tlsPtr=%lx\n",
+                req->getThread(), req->getInstPtr(), req->getTlsAddr() );
+
+    for ( int i = 0; i < req->getIntRegs().size(); i++ ) {
+        reg_file->setIntReg<uint64_t>(isa_table->getIntPhysReg(i), req->getIntRegs()[i]);
+    }
+
+    for ( int i = 0; i < req->getFpRegs().size(); i++ ) {
+        if ( VANADIS_REGISTER_MODE_FP32 == thr_decoder->getFPRegisterMode() ) {
+            reg_file->setFPReg<uint32_t>(isa_table->getFPPhysReg(i), req->getFpRegs()[i]);
+        } else {
+            reg_file->setFPReg<uint64_t>(isa_table->getFPPhysReg(i), req->getFpRegs()[i]);
+        }
+    }
+    thr_decoder->setThreadLocalStoragePointer( req->getTlsAddr() );
+
+    // the checkpoint was taken with a syscall at the front of the ROB, restart
+    // at that instruction so the syscall is issued again
+    halted_masks[hw_thr]            = false;
+    handleMisspeculate( hw_thr, req->getInstPtr() );
+}
+
 void VANADIS_COMPONENT::getThreadState( VanadisGetThreadStateReq* req )
 {
     int hw_thr = req->getThread();
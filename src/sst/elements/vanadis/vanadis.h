@@ -27,6 +27,8 @@
 #include "velf/velfinfo.h"
 #include "vfpflags.h"
 #include "vfuncunit.h"
+#include "vcpistack.h"
+#include "vsampler.h"
 
 #include "os/vgetthreadstate.h"
 #include "os/vdumpregsreq.h"
@@ -34,6 +36,7 @@
 #include <array>
 #include <limits>
 #include <set>
+#include <string>
 #include <sst/core/component.h>
 #include <sst/core/interfaces/stdMem.h>
 #include <sst/core/link.h>
@@ -123,7 +126,13 @@ public:
         { "fp_arith_units", "Number of floating point arithmetic units" },
         { "fp_arith_cycles", "Cycles per floating point arithmetic" },
         { "fp_div_units", "Number of floating point division units" },
-        { "fp_div_cycles", "Cycles per floating point division" }, { "load_units", "Number of memory load units" },
+        { "fp_div_cycles", "Cycles per floating point division" },
+        { "vector_int_arith_units", "Number of vector integer arithmetic units (used by RISC-V vector instructions)", "1" },
+        { "vector_int_arith_cycles", "Cycles per vector integer arithmetic operation on one group of lanes", "2" },
+        { "vector_fp_arith_units", "Number of vector floating point arithmetic units", "1" },
+        { "vector_fp_arith_cycles", "Cycles per vector floating point operation on one group of lanes", "8" },
+        { "vector_lanes", "Number of elements a vector unit processes per cycle, a vector instruction occupies a unit for ceil(vl/lanes) cycles", "4" },
+        { "load_units", "Number of memory load units" },
         { "store_units", "Number of memory store units" },
         { "max_loads_per_cycle", "Maximum number of loads that can issue to the cache per cycle" },
         { "max_stores_per_cycle", "Maximum number of stores that can issue to the cache per cycle" },
@@ -136,7 +145,24 @@ public:
         { "print_issue_tables", "Print registers during issue step (default is yes)" },
         { "print_int_reg", "Print integer registers true/false, auto set to true if verbose > 16" },
         { "print_fp_reg", "Print floating-point registers true/false, auto set to "
-                          "true if verbose > 16" })
+                          "true if verbose > 16" },
+        { "fast_forward_instructions", "Number of instructions to execute functionally before switching to detailed "
+                                       "simulation (0 = no instruction limit)", "0" },
+        { "fast_forward_until_address", "Execute functionally until an instruction at this address retires, then "
+                                        "switch to detailed simulation (0 = disabled)", "0" },
+        { "fast_forward_rounds_per_cycle", "Maximum number of instructions each hardware thread executes per cycle "
+                                           "while executing functionally", "16" },
+        { "sample_period", "Length in instructions of each sampling period after fast-forward (0 = no sampling, "
+                           "remain detailed)", "0" },
+        { "sample_detailed_instructions", "Instructions measured in detail at the end of each sampling period",
+          "10000" },
+        { "sample_warming_instructions", "Instructions simulated in detail but not measured before each "
+                                         "measurement window", "2000" },
+        { "cpi_stack", "Charge every retire slot each cycle to a stall category: none, global, pc or function",
+          "none" },
+        { "cpi_stack_file", "Path of the binary CPI stack profile written at the end of simulation (empty = print "
+                            "the summary only)", "" },
+        { "cpi_stack_binary", "ELF executable whose function symbols are used when cpi_stack is function", "" })
 
     SST_ELI_DOCUMENT_STATISTICS(
         { "cycles", "Number of cycles the core executed", "cycles", 1 },
@@ -155,7 +181,13 @@ public:
         { "stores_issued", "Number of store instructions issued to the LSQ", "instructions", 1 },
         { "phys_int_reg_in_use", "Number of physical integer registers that are in use each cycle", "registers", 1 },
         { "phys_fp_reg_in_use", "Number of physical floating point registers than are in use each cycle", "registers",
-          1 })
+          1 },
+        { "functional_instructions", "Number of instructions retired while executing functionally", "instructions",
+          1 },
+        { "functional_cycles", "Number of cycles spent executing functionally", "cycles", 1 },
+        { "sampled_instructions", "Number of instructions retired in detailed measurement windows", "instructions",
+          1 },
+        { "sampled_cycles", "Number of cycles spent in detailed measurement windows", "cycles", 1 })
 
     SST_ELI_DOCUMENT_PORTS({ "icache_link", "Connects the CPU to the instruction cache", {} },
                            { "dcache_link", "Connects the CPU to the data cache", {} },
@@ -196,6 +228,7 @@ public:
     void startThread(int thr, uint64_t stackStart, uint64_t instructionPointer );
     void startThreadFork( VanadisStartThreadForkReq* req );
     void startThreadClone( VanadisStartThreadCloneReq* req );
+    void startThreadRestore( VanadisStartThreadRestoreReq* req );
     void getThreadState( VanadisGetThreadStateReq* req );
     void dumpRegs( VanadisDumpRegsReq* req );
 
@@ -231,8 +264,29 @@ private:
     int  performIssue(const uint64_t cycle, uint32_t& rob_start, bool& unallocated_memory_op_seen);
     int  performExecute(const uint64_t cycle);
     int  performRetire(VanadisCircularQueue<VanadisInstruction*>* rob, const uint64_t cycle);
+    bool performFunctional(const uint64_t cycle);
+    int  issueFunctional(const uint32_t hw_thr, VanadisInstruction* ins);
+    VanadisCPICategory classifyRetireStall(const uint32_t hw_thr, uint64_t& stall_addr);
     int  allocateFunctionalUnit(VanadisInstruction* ins);
     bool mapInstructiontoFunctionalUnit(VanadisInstruction* ins, std::vector<VanadisFunctionalUnit*>& functional_units);
+
+    // Instruction classes the functional path executes without a functional unit
+    bool executesFunctionally(VanadisInstruction* ins) const
+    {
+        switch ( ins->getInstFuncType() ) {
+        case INST_INT_ARITH:
+        case INST_INT_DIV:
+        case INST_BRANCH:
+        case INST_FP_ARITH:
+        case INST_FP_DIV:
+        case INST_VECTOR_INT_ARITH:
+        case INST_VECTOR_FP_ARITH:
+            return true;
+        default:
+            return false;
+        }
+    }
+
     void printRob(VanadisCircularQueue<VanadisInstruction*>* rob);
 
     void resetHwThread(uint32_t thr);
@@ -258,6 +312,8 @@ private:
     std::vector<VanadisFunctionalUnit*> fu_branch;
     std::vector<VanadisFunctionalUnit*> fu_fp_arith;
     std::vector<VanadisFunctionalUnit*> fu_fp_div;
+    std::vector<VanadisFunctionalUnit*> fu_vector_int;
+    std::vector<VanadisFunctionalUnit*> fu_vector_fp;
 
     std::vector<VanadisRegisterFile*>  register_files;
     std::vector<VanadisRegisterStack*> int_register_stacks;
@@ -306,6 +362,10 @@ private:
     Statistic<uint64_t>* stat_syscall_cycles;
     Statistic<uint64_t>* stat_int_phys_regs_in_use;
     Statistic<uint64_t>* stat_fp_phys_regs_in_use;
+    Statistic<uint64_t>* stat_functional_ins;
+    Statistic<uint64_t>* stat_functional_cycles;
+    Statistic<uint64_t>* stat_sampled_ins;
+    Statistic<uint64_t>* stat_sampled_cycles;
 
     uint32_t ins_issued_this_cycle;
     uint32_t ins_retired_this_cycle;
@@ -317,6 +377,13 @@ private:
 
     std::vector<VanadisFloatingPointFlags*> fp_flags;
 
+    VanadisSampler* sampler;
+    uint32_t        fast_forward_rounds;
+
+    VanadisCPIStack* cpi_stack;
+    std::string      cpi_stack_path;
+    SST::Cycle_t     cpi_last_cycle;
+
     SST::Link* os_link;
 };
 
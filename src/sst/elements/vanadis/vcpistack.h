@@ -0,0 +1,314 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_CPI_STACK
+#define _H_VANADIS_CPI_STACK
+
+#include "velf/velfinfo.h"
+#include "vcpistackfmt.h"
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sst/core/output.h>
+
+namespace SST {
+namespace Vanadis {
+
+/*
+ * Top-down style CPI stack. Every cycle each hardware thread has a fixed
+ * number of retire slots. A slot that retires an instruction is charged to
+ * RETIRING against the retired PC, the unused slots are charged to the reason
+ * the head of the ROB could not retire, against the head PC (or the fetch PC
+ * when the ROB is empty, or the mispredicted branch while the pipeline
+ * refills). With PC granularity every PC gets its own stack, with FUNCTION
+ * granularity PCs are folded into the enclosing ELF function symbol.
+ * A MIPS branch retires with its delay slot in one slot, so the slots of a
+ * thread always add up to its cycles times the slots per cycle.
+ */
+class VanadisCPIStack
+{
+public:
+    typedef std::array<uint64_t, (size_t)VanadisCPICategory::COUNT> CategoryCounts;
+
+    VanadisCPIStack(const VanadisCPIGranularity granularity, const uint32_t slots, const uint32_t threads) :
+        mode(granularity),
+        slots_per_cycle(slots),
+        hw_threads(threads),
+        cycles(0),
+        instructions(0),
+        retired(threads, 0),
+        recovering(threads, false),
+        recovery_address(threads, 0),
+        last_key(UINT64_MAX),
+        last_counts(nullptr),
+        func_cache_start(1),
+        func_cache_end(0),
+        func_cache_key(0)
+    {
+        totals.fill(0);
+    }
+
+    // Function symbols from the executable, used for FUNCTION granularity
+    void loadSymbols(VanadisELFInfo* elf_info)
+    {
+        for ( size_t i = 0; i < elf_info->countSymbols(); ++i ) {
+            const VanadisSymbolTableEntry* sym = elf_info->getSymbol(i);
+
+            if ( (SYMBOL_FUNCTION == sym->getType()) && (0 != sym->getAddress()) ) {
+                functions.emplace_back(sym->getAddress(), sym->getSize(), sym->getName());
+            }
+        }
+
+        std::sort(functions.begin(), functions.end(), [](const FunctionSymbol& a, const FunctionSymbol& b) {
+            return a.start < b.start;
+        });
+    }
+
+    size_t countFunctions() const { return functions.size(); }
+
+    void retire(const uint32_t thr, const uint64_t ins_addr)
+    {
+        charge(VanadisCPICategory::RETIRING, ins_addr, 1);
+        retired[thr]++;
+        instructions++;
+        recovering[thr] = false;
+    }
+
+    // The delay slot retired in the same slot as its branch
+    void retireDelaySlot(const uint32_t thr) { instructions++; }
+
+    void misspeculate(const uint32_t thr, const uint64_t branch_addr)
+    {
+        recovering[thr]       = true;
+        recovery_address[thr] = branch_addr;
+    }
+
+    bool     isRecovering(const uint32_t thr) const { return recovering[thr]; }
+    uint64_t getRecoveryAddress(const uint32_t thr) const { return recovery_address[thr]; }
+
+    // Charge the slots a thread did not use this cycle
+    void endCycle(const uint32_t thr, const VanadisCPICategory cat, const uint64_t stall_addr)
+    {
+        if ( retired[thr] < slots_per_cycle ) { charge(cat, stall_addr, slots_per_cycle - retired[thr]); }
+
+        retired[thr] = 0;
+    }
+
+    // Charge cycles in which the core was not clocked (waiting on a syscall)
+    void chargeIdleCycles(const VanadisCPICategory cat, const uint64_t addr, const uint64_t count)
+    {
+        charge(cat, addr, count * slots_per_cycle);
+    }
+
+    void addCycles(const uint64_t count) { cycles += count; }
+
+    void print(SST::Output* output, const uint16_t core) const
+    {
+        uint64_t total_slots = 0;
+
+        for ( auto next : totals ) {
+            total_slots += next;
+        }
+
+        output->output("Vanadis Core %" PRIu16 " CPI Stack (%" PRIu64 " cycles, %" PRIu64 " slots):\n", core, cycles,
+            total_slots);
+
+        if ( 0 == total_slots ) { return; }
+
+        const double retired_ins = (double)instructions;
+
+        for ( size_t i = 0; i < totals.size(); ++i ) {
+            const double cpi = (retired_ins > 0) ?
+                ((double)cycles * ((double)totals[i] / (double)total_slots)) / retired_ins : 0;
+
+            output->output("-> %-16s %15" PRIu64 " slots / %6.2f%% / CPI %.4f\n",
+                getCPICategoryName((VanadisCPICategory)i), totals[i], 100.0 * (double)totals[i] / (double)total_slots,
+                cpi);
+        }
+    }
+
+    void write(SST::Output* output, const char* path, const uint32_t core) const
+    {
+        FILE* profile = fopen(path, "wb");
+
+        if ( nullptr == profile ) {
+            output->fatal(CALL_INFO, -1, "Error: unable to open CPI stack profile %s for writing.\n", path);
+        }
+
+        fwrite(VANADIS_CPI_STACK_MAGIC, 1, 4, profile);
+        writeU32(profile, VANADIS_CPI_STACK_VERSION);
+        writeU32(profile, core);
+        writeU32(profile, (uint32_t)mode);
+        writeU32(profile, slots_per_cycle);
+        writeU32(profile, hw_threads);
+        writeU64(profile, cycles);
+        writeU32(profile, (uint32_t)VanadisCPICategory::COUNT);
+
+        for ( size_t i = 0; i < (size_t)VanadisCPICategory::COUNT; ++i ) {
+            const char* name = getCPICategoryName((VanadisCPICategory)i);
+            fputc((int)strlen(name), profile);
+            fwrite(name, 1, strlen(name), profile);
+        }
+
+        std::vector<uint64_t> keys;
+        keys.reserve(counts.size());
+
+        for ( auto& next : counts ) {
+            keys.push_back(next.first);
+        }
+
+        std::sort(keys.begin(), keys.end());
+        vanadis_cpi_write_varint(profile, keys.size());
+
+        uint64_t prev_key = 0;
+
+        for ( const uint64_t key : keys ) {
+            vanadis_cpi_write_varint(profile, key - prev_key);
+            prev_key = key;
+
+            if ( VanadisCPIGranularity::FUNCTION == mode ) {
+                const char* name = functionName(key);
+                vanadis_cpi_write_varint(profile, strlen(name));
+                fwrite(name, 1, strlen(name), profile);
+            }
+
+            for ( const uint64_t next_count : counts.at(key) ) {
+                vanadis_cpi_write_varint(profile, next_count);
+            }
+        }
+
+        fclose(profile);
+
+        output->verbose(CALL_INFO, 1, 0, "Wrote CPI stack profile with %" PRIu64 " records to %s\n",
+            (uint64_t)keys.size(), path);
+    }
+
+private:
+    struct FunctionSymbol {
+        FunctionSymbol(const uint64_t s, const uint64_t l, const char* n) : start(s), length(l), name(n) {}
+
+        uint64_t    start;
+        uint64_t    length;
+        std::string name;
+    };
+
+    void charge(const VanadisCPICategory cat, const uint64_t ins_addr, const uint64_t slots)
+    {
+        totals[(size_t)cat] += slots;
+
+        if ( VanadisCPIGranularity::GLOBAL == mode ) { return; }
+
+        const uint64_t key = (VanadisCPIGranularity::FUNCTION == mode) ? functionKey(ins_addr) : ins_addr;
+
+        // consecutive charges usually hit the same key, entries are never
+        // erased so the cached pointer stays valid across rehashing
+        if ( key != last_key ) {
+            auto entry = counts.find(key);
+
+            if ( entry == counts.end() ) {
+                CategoryCounts zero;
+                zero.fill(0);
+                entry = counts.emplace(key, zero).first;
+            }
+
+            last_key    = key;
+            last_counts = &(entry->second);
+        }
+
+        (*last_counts)[(size_t)cat] += slots;
+    }
+
+    // Start address of the function containing ins_addr, 0 if unknown
+    uint64_t functionKey(const uint64_t ins_addr)
+    {
+        if ( (ins_addr >= func_cache_start) && (ins_addr < func_cache_end) ) { return func_cache_key; }
+
+        auto next = std::upper_bound(
+            functions.begin(), functions.end(), ins_addr,
+            [](const uint64_t addr, const FunctionSymbol& sym) { return addr < sym.start; });
+
+        if ( next == functions.begin() ) { return 0; }
+
+        const uint64_t next_start = (next == functions.end()) ? UINT64_MAX : next->start;
+        --next;
+
+        // symbols without a size extend to the next symbol
+        const uint64_t end = (next->length > 0) ? std::min(next->start + next->length, next_start) : next_start;
+
+        if ( ins_addr >= end ) { return 0; }
+
+        func_cache_start = next->start;
+        func_cache_end   = end;
+        func_cache_key   = next->start;
+
+        return next->start;
+    }
+
+    const char* functionName(const uint64_t key) const
+    {
+        auto match = std::lower_bound(
+            functions.begin(), functions.end(), key,
+            [](const FunctionSymbol& sym, const uint64_t addr) { return sym.start < addr; });
+
+        return ((match != functions.end()) && (match->start == key)) ? match->name.c_str() : "[unknown]";
+    }
+
+    static void writeU32(FILE* file, const uint32_t value)
+    {
+        for ( int i = 0; i < 4; ++i ) {
+            fputc((value >> (8 * i)) & 0xFF, file);
+        }
+    }
+
+    static void writeU64(FILE* file, const uint64_t value)
+    {
+        for ( int i = 0; i < 8; ++i ) {
+            fputc((value >> (8 * i)) & 0xFF, file);
+        }
+    }
+
+    const VanadisCPIGranularity mode;
+    const uint32_t              slots_per_cycle;
+    const uint32_t              hw_threads;
+    uint64_t                    cycles;
+    uint64_t                    instructions;
+
+    std::vector<uint32_t> retired;
+    std::vector<bool>     recovering;
+    std::vector<uint64_t> recovery_address;
+
+    CategoryCounts                               totals;
+    std::unordered_map<uint64_t, CategoryCounts> counts;
+    uint64_t                                     last_key;
+    CategoryCounts*                              last_counts;
+
+    std::vector<FunctionSymbol> functions;
+    uint64_t                    func_cache_start;
+    uint64_t                    func_cache_end;
+    uint64_t                    func_cache_key;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,119 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_CPI_STACK_FORMAT
+#define _H_VANADIS_CPI_STACK_FORMAT
+
+#include <cstdint>
+#include <cstdio>
+
+/*
+ * Binary CPI stack profile, shared by the core and sst-vanadis-cpistack.
+ * Fixed width fields are little endian, "varint" is unsigned LEB128.
+ *
+ *   char[4]  "VCPS"
+ *   uint32   format version
+ *   uint32   core id
+ *   uint32   granularity (VanadisCPIGranularity)
+ *   uint32   retire slots per cycle per thread
+ *   uint32   hardware threads
+ *   uint64   cycles accounted
+ *   uint32   category count
+ *   per category: uint8 name length, name bytes
+ *   varint   record count
+ *   per record, sorted by key:
+ *     varint key delta from the previous record (pc or function start)
+ *     varint name length, name bytes (function granularity only)
+ *     varint slot count, one per category
+ */
+
+#define VANADIS_CPI_STACK_MAGIC   "VCPS"
+#define VANADIS_CPI_STACK_VERSION 1
+
+namespace SST {
+namespace Vanadis {
+
+enum class VanadisCPIGranularity : uint32_t { NONE, GLOBAL, PC, FUNCTION };
+
+enum class VanadisCPICategory : uint8_t {
+    RETIRING,        // slot retired an instruction
+    FRONTEND,        // ROB empty, fetch/decode did not supply instructions
+    BAD_SPECULATION, // ROB empty while refilling after a branch misprediction
+    MEMORY_LOAD,     // head is an issued load waiting on the memory system
+    MEMORY_STORE,    // head is a store or fence waiting on the memory system
+    LSQ_FULL,        // head is a memory operation that cannot enter the LSQ
+    ROB_FULL,        // ROB is full and the head is not a memory operation
+    EXECUTE,         // head is executing in a functional unit
+    DEPENDENCY,      // head is waiting on operands or a functional unit to issue
+    SYSCALL,         // head is a system call waiting on the OS
+    OTHER,           // head is complete but retire bandwidth was exhausted
+    COUNT
+};
+
+inline const char*
+getCPICategoryName(const VanadisCPICategory cat)
+{
+    switch ( cat ) {
+    case VanadisCPICategory::RETIRING: return "retiring";
+    case VanadisCPICategory::FRONTEND: return "frontend";
+    case VanadisCPICategory::BAD_SPECULATION: return "bad_speculation";
+    case VanadisCPICategory::MEMORY_LOAD: return "memory_load";
+    case VanadisCPICategory::MEMORY_STORE: return "memory_store";
+    case VanadisCPICategory::LSQ_FULL: return "lsq_full";
+    case VanadisCPICategory::ROB_FULL: return "rob_full";
+    case VanadisCPICategory::EXECUTE: return "execute";
+    case VanadisCPICategory::DEPENDENCY: return "dependency";
+    case VanadisCPICategory::SYSCALL: return "syscall";
+    case VanadisCPICategory::OTHER: return "other";
+    default: return "unknown";
+    }
+}
+
+inline void
+vanadis_cpi_write_varint(FILE* file, uint64_t value)
+{
+    do {
+        uint8_t next = value & 0x7F;
+        value >>= 7;
+
+        if ( value != 0 ) { next |= 0x80; }
+
+        fputc(next, file);
+    } while ( value != 0 );
+}
+
+// Returns false at end of file or if the encoding is longer than 64 bits
+inline bool
+vanadis_cpi_read_varint(FILE* file, uint64_t& value)
+{
+    value = 0;
+
+    for ( int shift = 0; shift < 64; shift += 7 ) {
+        const int next = fgetc(file);
+
+        if ( EOF == next ) { return false; }
+
+        value |= ((uint64_t)(next & 0x7F)) << shift;
+
+        if ( 0 == (next & 0x80) ) { return true; }
+    }
+
+    return false;
+}
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
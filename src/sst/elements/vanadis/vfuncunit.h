@@ -19,9 +19,11 @@
 #include <cinttypes>
 #include <climits>
 #include <cstdint>
+#include <algorithm>
 #include <deque>
 
 #include "inst/vinst.h"
+#include "inst/vvecinst.h"
 
 namespace SST {
 namespace Vanadis {
@@ -29,7 +31,7 @@ namespace Vanadis {
 class VanadisFunctionalUnitInsRecord {
 public:
     VanadisFunctionalUnitInsRecord(VanadisInstruction* base_ins, uint16_t cycles)
-        : ins(base_ins), cycles_left(cycles) {}
+        : ins(base_ins), cycles_left(cycles), busy_left(0), sized(false) {}
     ~VanadisFunctionalUnitInsRecord() {}
 
     uint16_t getCycles() const { return cycles_left; }
@@ -38,6 +40,14 @@ public:
 
     void tick() { cycles_left = (cycles_left > 0) ? cycles_left - 1 : 0; }
 
+    // vector instructions occupy the unit for extra cycles depending on vl
+    bool isSized() const { return sized; }
+    void addCycles(uint16_t extra) { cycles_left += extra; busy_left = extra; sized = true; }
+
+    // cycles this instruction still blocks the unit from accepting another
+    uint16_t getBusyCycles() const { return busy_left; }
+    void tickBusy() { busy_left = (busy_left > 0) ? busy_left - 1 : 0; }
+
     uint32_t getHardwareThread() const { return ins->getHWThread(); }
 
     VanadisInstruction* getInstruction() { return ins; }
@@ -45,13 +55,15 @@ public:
 private:
     VanadisInstruction* ins;
     uint16_t cycles_left;
+    uint16_t busy_left;
+    bool sized;
 };
 
 class VanadisFunctionalUnit {
 
 public:
-    VanadisFunctionalUnit(uint16_t id, VanadisFunctionalUnitType unit_type, uint16_t lat)
-        : fu_id(id), fu_type(unit_type), latency(lat), accept_this_cycle(true) {
+    VanadisFunctionalUnit(uint16_t id, VanadisFunctionalUnitType unit_type, uint16_t lat, uint16_t vector_lanes = 0)
+        : fu_id(id), fu_type(unit_type), latency(lat), accept_this_cycle(true), lanes(vector_lanes), busy_cycles(0) {
     }
 
     ~VanadisFunctionalUnit() {
@@ -62,7 +74,7 @@ public:
 
     VanadisFunctionalUnitType getType() const { return fu_type; }
 
-    bool isInstructionSlotFree() const { return accept_this_cycle; }
+    bool isInstructionSlotFree() const { return accept_this_cycle && (0 == busy_cycles); }
 
     void insertInstruction(VanadisInstruction* ins) {
         //assert(accept_this_cycle == true);
@@ -76,6 +88,17 @@ public:
         for(auto q_itr = pending_execute.begin(); q_itr != pending_execute.end();) {
             VanadisFunctionalUnitInsRecord* q_item = (*q_itr);
 
+            // a vector unit processes 'lanes' elements per cycle, the element count is
+            // only known once the instruction has its registers so size it here
+            if(lanes > 0 && !q_item->isSized()) {
+                VanadisVectorInstruction* vec_ins = static_cast<VanadisVectorInstruction*>(q_item->getInstruction());
+                const uint64_t groups = vec_ins->countElementGroups(regFile[vec_ins->getHWThread()], lanes);
+                const uint16_t extra  = (uint16_t) std::min(groups - 1, (uint64_t) (UINT16_MAX - latency));
+
+                q_item->addCycles(extra);
+                busy_cycles += extra;
+            }
+
             if(q_item->readyToExecute()) {
                 VanadisInstruction* inner_ins = q_item->getInstruction();
                 inner_ins->execute(output, regFile[inner_ins->getHWThread()]);
@@ -96,6 +119,18 @@ public:
         }
 
         accept_this_cycle = true;
+
+        // the unit drains the occupancy of its oldest sized vector instruction first
+        if(busy_cycles > 0) {
+            busy_cycles--;
+
+            for(auto q_item : pending_execute) {
+                if(q_item->getBusyCycles() > 0) {
+                    q_item->tickBusy();
+                    break;
+                }
+            }
+        }
     }
 
     void clearByHWThreadID(SST::Output* output, const uint16_t hw_thr) {
@@ -104,6 +139,8 @@ public:
         for (auto q_itr = pending_execute.begin(); q_itr != pending_execute.end();) {
             // if we get a hardware thread match, remove and carry out
             if ((*q_itr)->getHardwareThread() == hw_thr) {
+                // other threads' vector instructions keep their occupancy
+                busy_cycles -= std::min(busy_cycles, (uint32_t) (*q_itr)->getBusyCycles());
                 delete (*q_itr);
                 q_itr = pending_execute.erase(q_itr);
             } else {
@@ -130,6 +167,8 @@ private:
     VanadisFunctionalUnitType fu_type;
     const uint16_t fu_id;
     bool accept_this_cycle;
+    const uint16_t lanes;
+    uint32_t busy_cycles;
 };
 
 } // namespace Vanadis
@@ -0,0 +1,258 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_SAMPLER
+#define _H_VANADIS_SAMPLER
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+
+#include <sst/core/output.h>
+
+namespace SST {
+namespace Vanadis {
+
+enum class VanadisExecutionMode { FUNCTIONAL, WARMING, DETAILED };
+
+inline const char*
+getExecutionModeName(const VanadisExecutionMode mode)
+{
+    switch ( mode ) {
+    case VanadisExecutionMode::FUNCTIONAL:
+        return "functional";
+    case VanadisExecutionMode::WARMING:
+        return "warming";
+    case VanadisExecutionMode::DETAILED:
+        return "detailed";
+    default:
+        return "unknown";
+    }
+}
+
+/*
+ * Decides which execution mode the core runs in. The core starts in
+ * functional mode when a fast-forward length or marker address is given
+ * and switches to detailed mode when either is reached. If a sampling
+ * period is set, each period after the fast-forward is split into a
+ * functional section, a detailed warming window (timed but not measured)
+ * and a detailed measurement window, SMARTS-style. Caches are still
+ * accessed during functional execution so they stay warm across windows.
+ */
+class VanadisSampler
+{
+public:
+    VanadisSampler(
+        const uint64_t ff_ins, const uint64_t ff_addr, const uint64_t period, const uint64_t detailed_len,
+        const uint64_t warming_len) :
+        ff_instructions(ff_ins),
+        ff_address(ff_addr),
+        sample_period(period),
+        sample_detailed(detailed_len),
+        sample_warming(warming_len),
+        in_fast_forward((ff_ins > 0) || (ff_addr > 0)),
+        period_ins(0),
+        total_ins(0),
+        total_cycles(0),
+        functional_ins(0),
+        functional_cycles(0),
+        warming_ins(0),
+        warming_cycles(0),
+        measured_ins(0),
+        measured_cycles(0),
+        window_ins(0),
+        window_cycles(0),
+        window_count(0),
+        window_cpi_sum(0),
+        window_cpi_sq_sum(0)
+    {
+        if ( sample_period > 0 && (sample_detailed + sample_warming) > sample_period ) {
+            sample_warming = (sample_detailed < sample_period) ? sample_period - sample_detailed : 0;
+            sample_detailed = sample_period - sample_warming;
+        }
+
+        mode = in_fast_forward ? VanadisExecutionMode::FUNCTIONAL : modeForPeriodPosition();
+    }
+
+    VanadisExecutionMode getMode() const { return mode; }
+    bool                 isFunctional() const { return mode == VanadisExecutionMode::FUNCTIONAL; }
+    bool                 isSampling() const { return sample_period > 0; }
+    bool                 isEnabled() const { return (ff_instructions > 0) || (ff_address > 0) || (sample_period > 0); }
+
+    // Called when an instruction retires, returns true if the marker address
+    // was hit and the fast-forward ends
+    bool checkMarker(const uint64_t ins_addr)
+    {
+        if ( in_fast_forward && (ff_address > 0) && (ins_addr == ff_address) ) {
+            endFastForward();
+            return true;
+        }
+
+        return false;
+    }
+
+    // Account for one core cycle in which retired instructions retired, returns
+    // true if the execution mode changed as a result
+    bool tick(const uint64_t retired)
+    {
+        const VanadisExecutionMode prev_mode = mode;
+
+        total_ins += retired;
+        total_cycles++;
+
+        switch ( mode ) {
+        case VanadisExecutionMode::FUNCTIONAL:
+            functional_ins += retired;
+            functional_cycles++;
+            break;
+        case VanadisExecutionMode::WARMING:
+            warming_ins += retired;
+            warming_cycles++;
+            break;
+        case VanadisExecutionMode::DETAILED:
+            measured_ins += retired;
+            measured_cycles++;
+            window_ins += retired;
+            window_cycles++;
+            break;
+        }
+
+        if ( in_fast_forward ) {
+            if ( (ff_instructions > 0) && (functional_ins >= ff_instructions) ) { endFastForward(); }
+        }
+        else if ( sample_period > 0 ) {
+            period_ins += retired;
+
+            if ( period_ins >= sample_period ) {
+                period_ins -= sample_period;
+            }
+
+            mode = modeForPeriodPosition();
+        }
+
+        if ( (prev_mode == VanadisExecutionMode::DETAILED) && (mode != VanadisExecutionMode::DETAILED) ) {
+            closeWindow();
+        }
+
+        return prev_mode != mode;
+    }
+
+    uint64_t getMeasuredInstructions() const { return measured_ins; }
+    uint64_t getMeasuredCycles() const { return measured_cycles; }
+    uint64_t getFunctionalInstructions() const { return functional_ins; }
+
+    double getMeasuredCPI() const
+    {
+        return (measured_ins > 0) ? ((double)measured_cycles) / ((double)measured_ins) : 0;
+    }
+
+    // Estimate of cycles the whole run would have taken had every instruction
+    // been simulated in detail
+    double getExtrapolatedCycles() const { return getMeasuredCPI() * (double)total_ins; }
+
+    void print(SST::Output* output, const uint16_t core)
+    {
+        if ( window_cycles > 0 ) { closeWindow(); }
+
+        output->output(
+            "Vanadis Core %" PRIu16 " Sampling Summary:\n", core);
+        output->output(
+            "-> Functional:    %15" PRIu64 " instructions / %15" PRIu64 " cycles\n", functional_ins,
+            functional_cycles);
+        output->output(
+            "-> Warming:       %15" PRIu64 " instructions / %15" PRIu64 " cycles\n", warming_ins, warming_cycles);
+        output->output(
+            "-> Detailed:      %15" PRIu64 " instructions / %15" PRIu64 " cycles\n", measured_ins,
+            measured_cycles);
+        output->output("-> Measured CPI:  %15.4f\n", getMeasuredCPI());
+        output->output(
+            "-> Extrapolated:  %15.0f cycles for %" PRIu64 " instructions\n", getExtrapolatedCycles(), total_ins);
+
+        if ( window_count > 1 ) {
+            const double mean     = window_cpi_sum / (double)window_count;
+            const double variance = (window_cpi_sq_sum - (window_cpi_sum * mean)) / (double)(window_count - 1);
+            const double std_dev  = (variance > 0) ? std::sqrt(variance) : 0;
+
+            // 99.7% confidence interval on the mean window CPI
+            output->output(
+                "-> Windows:       %15" PRIu64 " / mean CPI %.4f +/- %.4f (99.7%% conf.)\n", window_count, mean,
+                3.0 * std_dev / std::sqrt((double)window_count));
+        }
+    }
+
+private:
+    void endFastForward()
+    {
+        in_fast_forward = false;
+        period_ins      = 0;
+        mode            = modeForPeriodPosition();
+    }
+
+    VanadisExecutionMode modeForPeriodPosition() const
+    {
+        if ( 0 == sample_period ) { return VanadisExecutionMode::DETAILED; }
+
+        const uint64_t detailed_start = sample_period - sample_detailed;
+        const uint64_t warming_start  = detailed_start - sample_warming;
+
+        if ( period_ins >= detailed_start ) { return VanadisExecutionMode::DETAILED; }
+        if ( period_ins >= warming_start ) { return VanadisExecutionMode::WARMING; }
+
+        return VanadisExecutionMode::FUNCTIONAL;
+    }
+
+    void closeWindow()
+    {
+        if ( window_ins > 0 ) {
+            const double window_cpi = ((double)window_cycles) / ((double)window_ins);
+            window_cpi_sum += window_cpi;
+            window_cpi_sq_sum += window_cpi * window_cpi;
+            window_count++;
+        }
+
+        window_ins    = 0;
+        window_cycles = 0;
+    }
+
+    const uint64_t ff_instructions;
+    const uint64_t ff_address;
+    const uint64_t sample_period;
+    uint64_t       sample_detailed;
+    uint64_t       sample_warming;
+
+    VanadisExecutionMode mode;
+    bool                 in_fast_forward;
+
+    uint64_t period_ins;
+    uint64_t total_ins;
+    uint64_t total_cycles;
+    uint64_t functional_ins;
+    uint64_t functional_cycles;
+    uint64_t warming_ins;
+    uint64_t warming_cycles;
+    uint64_t measured_ins;
+    uint64_t measured_cycles;
+
+    uint64_t window_ins;
+    uint64_t window_cycles;
+    uint64_t window_count;
+    double   window_cpi_sum;
+    double   window_cpi_sq_sum;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -31,6 +31,7 @@
 
 #include "sirius/siriusconst.h"
 
+#include "zreader.h"
 #include "zevent.h"
 #include "zinitevent.h"
 #include "zsendevent.h"
@@ -49,7 +50,7 @@ using namespace SST::Hermes::MP;
 namespace SST {
 namespace Zodiac {
 
-class SiriusReader {
+class SiriusReader : public ZodiacReader {
     public:
 	SiriusReader(char* file, uint32_t rank, uint32_t qLimit, std::queue<ZodiacEvent*>* eventQueue, int verbose);
         void close();
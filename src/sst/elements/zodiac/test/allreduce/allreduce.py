@@ -8,6 +8,7 @@ iterations = 1;
 msgSize = 0;
 shape = "2"
 num_vNics = 1
+traceFormat = "sirius"
 
 netPktSizeBytes="64B"
 netFlitSize="8B"
@@ -17,8 +18,9 @@ def main():
     global msgSize
     global shape
     global num_vNics
+    global traceFormat
     try:
-        opts, args = getopt.getopt(sys.argv[1:], "", ["msgSize=","iter=","shape=","numCores="])
+        opts, args = getopt.getopt(sys.argv[1:], "", ["msgSize=","iter=","shape=","numCores=","format="])
     except getopt.GetopError as err:
         print (str(err))
         sys.exit(2)
@@ -31,6 +33,8 @@ def main():
             num_vNics = a
         elif o in ("--shape"):
             shape = a
+        elif o in ("--format"):
+            traceFormat = a
         else:
             assert False, "unhandle option" 
 
@@ -98,7 +102,8 @@ driverParams = ({
 		"bufLen" : 8,
 		"hermesModule" : "firefly.hades",
 		"os.module" : "firefly.hades",
-		"trace" : "npe-" + str(numRanks) + "/allred-" + str(numRanks) +".stf",
+		"trace" : "npe-" + str(numRanks) + "/allred-" + str(numRanks) + (".zbin" if traceFormat == "zbin" else ".stf"),
+		"format" : traceFormat,
 		"sharedTrace" : "allred-128.stf",
 		"printStats" : 1,
 		"buffersize" : 140,
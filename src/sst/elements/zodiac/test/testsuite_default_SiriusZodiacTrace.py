@@ -4,7 +4,7 @@ from sst_unittest import *
 from sst_unittest_support import *
 
 #import os
-#import shutil
+import shutil
 
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
@@ -60,9 +60,36 @@ class testcase_SiriusZodiacTrace(SSTTestCase):
     def test_Sirius_Zodiac_128(self):
         self.SiriusZodiacTrace_test_template("8x8x2")
 
+    @unittest.skipIf(shutil.which("sst-zodiac-convert") is None, "SiriusZodiacTrace: sst-zodiac-convert not found")
+    def test_Sirius_Zodiac_16_zbin(self):
+        self.SiriusZodiacTrace_test_template("4x4", traceformat="zbin")
+
+    @unittest.skipIf(shutil.which("sst-zodiac-convert") is None, "SiriusZodiacTrace: sst-zodiac-convert not found")
+    def test_Sirius_Zodiac_128_zbin(self):
+        self.SiriusZodiacTrace_test_template("8x8x2", traceformat="zbin")
+
+    def test_Sirius_Zodiac_zbin_unit(self):
+        self.SiriusZodiacTrace_unit_test_template("testzbin")
+
+#####
+
+    # Builds a stand-alone driver under test/unit and runs it in the tmp dir,
+    # where it writes and removes its own traces
+    def SiriusZodiacTrace_unit_test_template(self, testname):
+        unitdir = "{0}/unit".format(self.get_testsuite_dir())
+        tmpdir = self.get_test_output_tmp_dir()
+
+        rtn = OSCommand("make {0}".format(testname), set_cwd=unitdir).run()
+        log_debug("SiriusZodiacTrace unit test {0} make result = {1}; output =\n{2}".format(testname, rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "SiriusZodiacTrace unit test {0} failed to build".format(testname))
+
+        rtn = OSCommand("{0}/{1}".format(unitdir, testname), set_cwd=tmpdir).run()
+        log_debug("SiriusZodiacTrace unit test {0} result = {1}; output =\n{2}".format(testname, rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "SiriusZodiacTrace unit test {0} failed:\n{1}".format(testname, rtn.output()))
+
 #####
 
-    def SiriusZodiacTrace_test_template(self, testcase, testtimeout = 60):
+    def SiriusZodiacTrace_test_template(self, testcase, testtimeout = 60, traceformat = "sirius"):
 
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
@@ -78,14 +105,24 @@ class testcase_SiriusZodiacTrace(SSTTestCase):
         testDataFileName="test_Sirius_allred_{0}".format(testcase)
 
         reffile = "{0}/sirius/tests/refFiles/{1}.out".format(self.SiriusZodiacTraceElementDir, testDataFileName)
-        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
-        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
-        tmpfile1 = "{0}/{1}_grepped.tmp".format(outdir, testDataFileName)
-        tmpfile2 = "{0}/{1}_filtered.tmp".format(outdir, testDataFileName)
-        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+        # the binary traces replay the same events, so they share the reference file
+        outName = testDataFileName if traceformat == "sirius" else "{0}_{1}".format(testDataFileName, traceformat)
+        outfile = "{0}/{1}.out".format(outdir, outName)
+        errfile = "{0}/{1}.err".format(outdir, outName)
+        tmpfile1 = "{0}/{1}_grepped.tmp".format(outdir, outName)
+        tmpfile2 = "{0}/{1}_filtered.tmp".format(outdir, outName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, outName)
 
         sdlfile = "{0}/allreduce/allreduce.py".format(test_path)
-        otherargs = '--model-options \"--shape={0}\"'.format(testcase)
+        otherargs = '--model-options \"--shape={0} --format={1}\"'.format(testcase, traceformat)
+
+        if traceformat == "zbin":
+            numRanks = 1
+            for dim in testcase.split('x'):
+                numRanks *= int(dim)
+            tracePrefix = "{0}/npe-{1}/allred-{1}".format(self.testSiriusZodiacTraceTestsDir, numRanks)
+            cmd = "sst-zodiac-convert {0}.stf {0}.zbin".format(tracePrefix)
+            self.assertTrue(os.system(cmd) == 0, "Failed to convert the traces at {0}.stf".format(tracePrefix))
 
         # Run SST
         self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles,
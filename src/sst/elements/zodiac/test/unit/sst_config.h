@@ -0,0 +1,2 @@
+// Stands in for the configured sst_config.h when the binary trace code is
+// built on its own by the unit tests, it needs nothing from it.
@@ -0,0 +1,444 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Round trips of the binary trace records, files written and decoded in
+// small chunks, and the prefetch rings and decoder pool under several
+// readers, including traces closed while their refill is queued
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "zbinfile.h"
+#include "zbinprefetch.h"
+
+using namespace SST::Zodiac;
+
+static std::atomic<int> failures(0);
+
+#define CHECK(cond) \
+    do { \
+        if ( ! (cond) ) { \
+            printf( "FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond ); \
+            failures++; \
+        } \
+    } while ( 0 )
+
+static ZodiacBinRecord makeRecord(uint8_t type)
+{
+    ZodiacBinRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.type = type;
+    return rec;
+}
+
+static bool sameRecord(const ZodiacBinRecord& a, const ZodiacBinRecord& b)
+{
+    return a.type == b.type && a.dtype == b.dtype && a.op == b.op && a.peer == b.peer &&
+        a.count == b.count && a.tag == b.tag && a.comm == b.comm && a.req == b.req &&
+        a.computePs == b.computePs;
+}
+
+// Every record type, with peers on both sides of the rank, negative tags
+// and requests that go back as well as forward
+static std::vector<ZodiacBinRecord> makeTrace(uint32_t rank, size_t calls)
+{
+    std::vector<ZodiacBinRecord> records;
+    uint64_t req = 1000;
+
+    records.push_back(makeRecord(ZBIN_INIT));
+
+    for ( size_t i = 0; i < calls; i++ ) {
+        ZodiacBinRecord compute = makeRecord(ZBIN_COMPUTE);
+        compute.computePs = 1000 + (i * 7919) % 100000;
+        records.push_back(compute);
+
+        ZodiacBinRecord rec;
+        switch ( i % 6 ) {
+        case 0:
+        case 1:
+            rec = makeRecord(0 == i % 6 ? ZBIN_SEND : ZBIN_RECV);
+            rec.dtype = ZBIN_DOUBLE;
+            rec.count = 1 + (uint32_t) (i % 4096);
+            rec.peer = (int32_t) ((rank + (i % 2 ? 1 : -1) * (1 + i % 5)) & 0xffff);
+            rec.tag = (int32_t) (i % 3) - 1;
+            break;
+        case 2:
+            rec = makeRecord(ZBIN_IRECV);
+            rec.dtype = ZBIN_INT;
+            rec.count = (uint32_t) i;
+            rec.peer = 0;
+            rec.tag = (int32_t) i;
+            rec.req = req + 2 * i;
+            break;
+        case 3:
+            // wait on an earlier request
+            rec = makeRecord(ZBIN_WAIT);
+            rec.req = req + 2 * (i - 1) - 7;
+            break;
+        case 4:
+            rec = makeRecord(ZBIN_ALLREDUCE);
+            rec.dtype = ZBIN_DOUBLE;
+            rec.op = (uint8_t) (i % 3);
+            rec.count = 8;
+            break;
+        default:
+            rec = makeRecord(ZBIN_BARRIER);
+            rec.comm = (uint32_t) (i % 2);
+            break;
+        }
+        records.push_back(rec);
+    }
+
+    records.push_back(makeRecord(ZBIN_FINALIZE));
+    return records;
+}
+
+static void checkRoundTrip(const ZodiacBinRecord& rec, uint32_t rank)
+{
+    uint8_t buffer[ZODIAC_BIN_MAX_RECORD_LENGTH];
+    uint64_t encodeReq = 12345;
+    uint64_t decodeReq = 12345;
+    const size_t length = zodiacEncodeRecord(rec, rank, encodeReq, buffer);
+
+    CHECK(length > 0 && length <= ZODIAC_BIN_MAX_RECORD_LENGTH);
+
+    ZodiacBinRecord out = makeRecord(0);
+    CHECK(length == zodiacDecodeRecord(buffer, buffer + length, rank, decodeReq, out));
+    CHECK(sameRecord(rec, out));
+    CHECK(encodeReq == decodeReq);
+
+    // any record cut short is rejected
+    for ( size_t cut = 0; cut < length; cut++ ) {
+        uint64_t cutReq = 12345;
+        CHECK(0 == zodiacDecodeRecord(buffer, buffer + cut, rank, cutReq, out));
+    }
+}
+
+static void testVarints()
+{
+    uint8_t buffer[16];
+    uint64_t value;
+    const uint64_t values[] = { 0, 1, 127, 128, 16383, 16384, 0xffffffffull, 0x8000000000000000ull, ~0ull };
+
+    for ( size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++ ) {
+        const size_t length = zodiacPutVarint(buffer, values[i]);
+        CHECK(length == zodiacGetVarint(buffer, buffer + length, value));
+        CHECK(values[i] == value);
+        CHECK(0 == zodiacGetVarint(buffer, buffer + length - 1, value));
+    }
+
+    CHECK(10 == zodiacPutVarint(buffer, ~0ull));
+    CHECK(1 == zodiacPutVarint(buffer, 127));
+
+    // more than ten bytes is not a varint
+    memset(buffer, 0x80, sizeof(buffer));
+    CHECK(0 == zodiacGetVarint(buffer, buffer + sizeof(buffer), value));
+
+    const int64_t signedValues[] = { 0, -1, 1, -64, 64, INT64_MIN, INT64_MAX };
+    for ( size_t i = 0; i < sizeof(signedValues) / sizeof(signedValues[0]); i++ ) {
+        CHECK(signedValues[i] == zodiacUnZigZag(zodiacZigZag(signedValues[i])));
+    }
+    CHECK(1 == zodiacZigZag(-1));
+    CHECK(2 == zodiacZigZag(1));
+}
+
+static void testRecords()
+{
+    const uint32_t ranks[] = { 0, 1, 1023, 0x7fffffff };
+
+    for ( size_t r = 0; r < sizeof(ranks) / sizeof(ranks[0]); r++ ) {
+        const uint32_t rank = ranks[r];
+
+        ZodiacBinRecord rec = makeRecord(ZBIN_COMPUTE);
+        rec.computePs = ~0ull;
+        checkRoundTrip(rec, rank);
+        rec.computePs = 0;
+        checkRoundTrip(rec, rank);
+
+        const uint8_t p2p[] = { ZBIN_SEND, ZBIN_RECV, ZBIN_IRECV };
+        for ( size_t t = 0; t < sizeof(p2p); t++ ) {
+            rec = makeRecord(p2p[t]);
+            rec.dtype = ZBIN_DOUBLE;
+            rec.count = 0xffffffff;
+            rec.peer = 0;
+            rec.tag = INT32_MIN;
+            rec.comm = 0xffffffff;
+            rec.req = 0;
+            checkRoundTrip(rec, rank);
+
+            rec.peer = 0x7fffffff;
+            rec.tag = INT32_MAX;
+            // only an irecv carries a request
+            rec.req = ZBIN_IRECV == p2p[t] ? ~0ull : 0;
+            checkRoundTrip(rec, rank);
+        }
+
+        rec = makeRecord(ZBIN_WAIT);
+        rec.req = 1;
+        checkRoundTrip(rec, rank);
+        rec.req = ~0ull;
+        checkRoundTrip(rec, rank);
+
+        rec = makeRecord(ZBIN_ALLREDUCE);
+        rec.dtype = ZBIN_INT;
+        rec.op = ZBIN_MIN;
+        rec.count = 0xffffffff;
+        rec.comm = 3;
+        checkRoundTrip(rec, rank);
+
+        rec = makeRecord(ZBIN_BARRIER);
+        rec.comm = 0xffffffff;
+        checkRoundTrip(rec, rank);
+
+        checkRoundTrip(makeRecord(ZBIN_INIT), rank);
+        checkRoundTrip(makeRecord(ZBIN_FINALIZE), rank);
+    }
+
+    // requests carry over from record to record
+    std::vector<ZodiacBinRecord> records = makeTrace(5, 600);
+    std::vector<uint8_t> stream(records.size() * ZODIAC_BIN_MAX_RECORD_LENGTH);
+    uint64_t prevReq = 0;
+    size_t used = 0;
+    for ( size_t i = 0; i < records.size(); i++ ) {
+        used += zodiacEncodeRecord(records[i], 5, prevReq, stream.data() + used);
+    }
+
+    prevReq = 0;
+    size_t pos = 0;
+    for ( size_t i = 0; i < records.size(); i++ ) {
+        ZodiacBinRecord out = makeRecord(0);
+        const size_t length = zodiacDecodeRecord(stream.data() + pos, stream.data() + used, 5, prevReq, out);
+        CHECK(length > 0);
+        CHECK(sameRecord(records[i], out));
+        pos += length;
+    }
+    CHECK(pos == used);
+
+    // unknown types are rejected
+    uint8_t bad = 0xf;
+    ZodiacBinRecord out;
+    CHECK(0 == zodiacDecodeRecord(&bad, &bad + 1, 0, prevReq, out));
+}
+
+static std::string traceName(uint32_t rank)
+{
+    char name[64];
+    snprintf(name, sizeof(name), "testzbin.%u", rank);
+    return name;
+}
+
+static bool writeTrace(uint32_t rank, const std::vector<ZodiacBinRecord>& records)
+{
+    ZodiacBinWriter writer;
+    bool ok = writer.open(traceName(rank), rank);
+
+    for ( size_t i = 0; ok && i < records.size(); i++ ) {
+        ok = writer.write(records[i]);
+    }
+
+    ok = writer.close() && ok;
+    CHECK(records.size() == writer.getRecordCount());
+    return ok;
+}
+
+static void testFile()
+{
+    const std::vector<ZodiacBinRecord> records = makeTrace(3, 2000);
+    CHECK(writeTrace(3, records));
+
+    // chunk sizes from the minimum up, so records straddle every chunk boundary
+    const size_t chunks[] = { 1, 103, 4096, 1 << 20 };
+    for ( size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++ ) {
+        ZodiacBinDecoder decoder;
+        CHECK(decoder.open(traceName(3), chunks[c]));
+        CHECK(3 == decoder.getRank());
+        CHECK(records.size() == decoder.getRecordCount());
+
+        ZodiacBinRecord rec;
+        size_t count = 0;
+        while ( decoder.next(rec) ) {
+            CHECK(count < records.size() && sameRecord(records[count], rec));
+            count++;
+        }
+        CHECK(records.size() == count);
+        CHECK(! decoder.failed());
+    }
+
+    // a file cut short is an error, not an early end
+    FILE* whole = fopen(traceName(3).c_str(), "rb");
+    std::vector<uint8_t> bytes(1 << 20);
+    const size_t length = fread(bytes.data(), 1, bytes.size(), whole);
+    fclose(whole);
+
+    FILE* cut = fopen(traceName(4).c_str(), "wb");
+    fwrite(bytes.data(), 1, length - 3, cut);
+    fclose(cut);
+
+    ZodiacBinDecoder decoder;
+    CHECK(decoder.open(traceName(4), 128));
+    ZodiacBinRecord rec;
+    while ( decoder.next(rec) ) { }
+    CHECK(decoder.failed());
+
+    ZodiacBinDecoder missing;
+    CHECK(! missing.open("testzbin.missing"));
+    CHECK(missing.failed());
+
+    remove(traceName(3).c_str());
+    remove(traceName(4).c_str());
+}
+
+// Readers on their own threads each drain a share of the traces through
+// rings of ringRecords records filled by a pool of two workers
+static void testPrefetch(uint32_t ringRecords)
+{
+    const uint32_t traces = 24;
+    const uint32_t readers = 4;
+    std::vector<std::vector<ZodiacBinRecord> > expected(traces);
+
+    for ( uint32_t t = 0; t < traces; t++ ) {
+        expected[t] = makeTrace(t, 1000 + 250 * t);
+        CHECK(writeTrace(t, expected[t]));
+    }
+
+    std::vector<std::thread> threads;
+    for ( uint32_t r = 0; r < readers; r++ ) {
+        threads.push_back(std::thread([&expected, r, ringRecords, traces, readers]() {
+            std::vector<std::unique_ptr<ZodiacBinPrefetcher> > mine;
+            std::vector<size_t> counts;
+
+            for ( uint32_t t = r; t < traces; t += readers ) {
+                mine.push_back(std::unique_ptr<ZodiacBinPrefetcher>(new ZodiacBinPrefetcher(ringRecords, 2)));
+                CHECK(mine.back()->open(traceName(t), 4096));
+                counts.push_back(0);
+            }
+
+            // interleave the traces as the ranks of one simulation thread would
+            bool more = true;
+            while ( more ) {
+                more = false;
+                for ( size_t i = 0; i < mine.size(); i++ ) {
+                    const std::vector<ZodiacBinRecord>& want = expected[r + i * readers];
+                    ZodiacBinRecord rec;
+
+                    for ( int burst = 0; burst < 5 && counts[i] < want.size(); burst++ ) {
+                        if ( ! mine[i]->pop(rec) ) {
+                            break;
+                        }
+                        CHECK(sameRecord(want[counts[i]], rec));
+                        counts[i]++;
+                        more = true;
+                    }
+                }
+            }
+
+            for ( size_t i = 0; i < mine.size(); i++ ) {
+                ZodiacBinRecord rec;
+                CHECK(expected[r + i * readers].size() == counts[i]);
+                CHECK(! mine[i]->pop(rec));
+                CHECK(! mine[i]->failed());
+                CHECK(r + i * readers == mine[i]->getRank());
+                mine[i]->close();
+            }
+        }));
+    }
+
+    for ( size_t i = 0; i < threads.size(); i++ ) {
+        threads[i].join();
+    }
+
+    for ( uint32_t t = 0; t < traces; t++ ) {
+        remove(traceName(t).c_str());
+    }
+}
+
+// With one worker and many traces, closing right after a read that asked
+// for a refill finds most refills still queued behind the others
+static void testCloseWhileQueued()
+{
+    const uint32_t traces = 16;
+    const uint32_t ring = 64;
+    std::vector<std::vector<ZodiacBinRecord> > expected(traces);
+
+    for ( uint32_t t = 0; t < traces; t++ ) {
+        expected[t] = makeTrace(t, 5000);
+        CHECK(writeTrace(t, expected[t]));
+    }
+
+    for ( int round = 0; round < 20; round++ ) {
+        std::vector<std::unique_ptr<ZodiacBinPrefetcher> > open;
+
+        for ( uint32_t t = 0; t < traces; t++ ) {
+            open.push_back(std::unique_ptr<ZodiacBinPrefetcher>(new ZodiacBinPrefetcher(ring, 1)));
+            CHECK(open.back()->open(traceName(t), 1024));
+        }
+
+        // read past half a ring of every trace so each has a refill requested
+        for ( uint32_t t = 0; t < traces; t++ ) {
+            ZodiacBinRecord rec;
+            for ( uint32_t i = 0; i < ring / 2 + 1 + round; i++ ) {
+                CHECK(open[t]->pop(rec));
+                CHECK(sameRecord(expected[t][i], rec));
+            }
+        }
+
+        // odd rounds close explicitly, even ones leave it to the destructor
+        for ( uint32_t t = 0; t < traces; t++ ) {
+            if ( round % 2 ) {
+                open[t]->close();
+            }
+            open[t].reset();
+        }
+    }
+
+    // a trace closed before anything was read
+    ZodiacBinPrefetcher unread(ring, 1);
+    CHECK(unread.open(traceName(0), 1024));
+    unread.close();
+
+    for ( uint32_t t = 0; t < traces; t++ ) {
+        remove(traceName(t).c_str());
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    testVarints();
+    testRecords();
+    testFile();
+
+    // a ring of fewer than two records is rounded up to two
+    testPrefetch(1);
+    testPrefetch(2);
+    testPrefetch(64);
+    testPrefetch(4096);
+
+    testCloseWhileQueued();
+
+    if ( failures ) {
+        printf( "%d checks failed\n", failures.load() );
+        return EXIT_FAILURE;
+    }
+
+    printf( "All Zodiac binary trace checks passed\n" );
+    return EXIT_SUCCESS;
+}
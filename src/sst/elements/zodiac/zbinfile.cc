@@ -0,0 +1,358 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include <inttypes.h>
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "zbinfile.h"
+#include "sirius/siriusconst.h"
+
+using namespace SST::Zodiac;
+
+ZodiacSiriusParser::ZodiacSiriusParser() :
+	trace(NULL), prevEventTime(0), started(false), foundFinalize(false), havePending(false) {
+}
+
+ZodiacSiriusParser::~ZodiacSiriusParser() {
+	close();
+}
+
+bool ZodiacSiriusParser::open(const std::string& file) {
+	trace = fopen(file.c_str(), "rb");
+	if(NULL == trace) {
+		error = "unable to open Sirius trace " + file;
+		return false;
+	}
+	return true;
+}
+
+void ZodiacSiriusParser::close() {
+	if(NULL != trace) {
+		fclose(trace);
+		trace = NULL;
+	}
+}
+
+bool ZodiacSiriusParser::next(ZodiacBinRecord& rec) {
+	if(! error.empty() || NULL == trace) {
+		return false;
+	}
+
+	memset(&rec, 0, sizeof(rec));
+
+	// the Sirius reader always starts with an init
+	if(! started) {
+		started = true;
+		rec.type = ZBIN_INIT;
+		return true;
+	}
+
+	if(havePending) {
+		havePending = false;
+		rec = pending;
+		return true;
+	}
+
+	if(foundFinalize) {
+		return false;
+	}
+
+	uint32_t callType;
+	double callTime;
+	if(! read(&callType, sizeof(callType)) || ! read(&callTime, sizeof(callTime))) {
+		return false;
+	}
+
+	memset(&pending, 0, sizeof(pending));
+	if(! readCall(callType)) {
+		return false;
+	}
+
+	// the profiled MPI time, then the function result
+	double mpiTime;
+	int32_t result;
+	if(! read(&mpiTime, sizeof(mpiTime)) || ! read(&result, sizeof(result))) {
+		return false;
+	}
+
+	const double evTimeDiff = callTime - prevEventTime;
+	prevEventTime = mpiTime;
+
+	if(evTimeDiff > 0) {
+		rec.type = ZBIN_COMPUTE;
+		rec.computePs = (uint64_t) llround(evTimeDiff * 1.0e12);
+		havePending = true;
+	} else {
+		rec = pending;
+	}
+	return true;
+}
+
+bool ZodiacSiriusParser::readCall(uint32_t callType) {
+	uint64_t buffer;
+	uint32_t dtype;
+	uint32_t op;
+
+	switch(callType) {
+	case SIRIUS_MPI_SEND:
+	case SIRIUS_MPI_RECV:
+	case SIRIUS_MPI_IRECV:
+		pending.type = SIRIUS_MPI_SEND == callType ? ZBIN_SEND :
+			(SIRIUS_MPI_RECV == callType ? ZBIN_RECV : ZBIN_IRECV);
+		if(! read(&buffer, sizeof(buffer)) ||
+			! read(&pending.count, sizeof(pending.count)) ||
+			! read(&dtype, sizeof(dtype)) ||
+			! read(&pending.peer, sizeof(pending.peer)) ||
+			! read(&pending.tag, sizeof(pending.tag)) ||
+			! read(&pending.comm, sizeof(pending.comm))) {
+			return false;
+		}
+		pending.dtype = convertType(dtype);
+		if(ZBIN_IRECV == pending.type && ! read(&pending.req, sizeof(pending.req))) {
+			return false;
+		}
+		break;
+
+	case SIRIUS_MPI_ALLREDUCE:
+		pending.type = ZBIN_ALLREDUCE;
+		if(! read(&buffer, sizeof(buffer)) ||
+			! read(&buffer, sizeof(buffer)) ||
+			! read(&pending.count, sizeof(pending.count)) ||
+			! read(&dtype, sizeof(dtype)) ||
+			! read(&op, sizeof(op)) ||
+			! read(&pending.comm, sizeof(pending.comm))) {
+			return false;
+		}
+		pending.dtype = convertType(dtype);
+		pending.op = convertOp(op);
+		break;
+
+	case SIRIUS_MPI_BARRIER:
+		pending.type = ZBIN_BARRIER;
+		if(! read(&pending.comm, sizeof(pending.comm))) {
+			return false;
+		}
+		break;
+
+	case SIRIUS_MPI_WAIT:
+		pending.type = ZBIN_WAIT;
+		if(! read(&pending.req, sizeof(pending.req)) || ! read(&buffer, sizeof(buffer))) {
+			return false;
+		}
+		break;
+
+	case SIRIUS_MPI_INIT:
+		pending.type = ZBIN_INIT;
+		break;
+
+	case SIRIUS_MPI_FINALIZE:
+		pending.type = ZBIN_FINALIZE;
+		foundFinalize = true;
+		break;
+
+	default: {
+		char msg[128];
+		snprintf(msg, sizeof(msg), "unknown MPI command in trace (%" PRIu32 ") position: %ld",
+			callType, ftell(trace));
+		error = msg;
+		return false;
+		}
+	}
+
+	return error.empty();
+}
+
+bool ZodiacSiriusParser::read(void* value, size_t bytes) {
+	if(1 != fread(value, bytes, 1, trace)) {
+		error = "Sirius trace ended before MPI_Finalize";
+		return false;
+	}
+	return true;
+}
+
+uint8_t ZodiacSiriusParser::convertType(uint32_t dtype) {
+	if(SIRIUS_MPI_INTEGER == dtype) {
+		return ZBIN_INT;
+	} else if(SIRIUS_MPI_DOUBLE == dtype) {
+		return ZBIN_DOUBLE;
+	}
+	return ZBIN_CHAR;
+}
+
+uint8_t ZodiacSiriusParser::convertOp(uint32_t op) {
+	switch(op) {
+	case SIRIUS_MPI_SUM:
+		return ZBIN_SUM;
+	case SIRIUS_MPI_MAX:
+		return ZBIN_MAX;
+	case SIRIUS_MPI_MIN:
+		return ZBIN_MIN;
+	default:
+		error = "unknown MPI operation, cannot convert to Hermes";
+		return ZBIN_SUM;
+	}
+}
+
+ZodiacBinWriter::ZodiacBinWriter() :
+	trace(NULL), rank(0), prevReq(0), records(0), bytes(0), buffer(1 << 20), used(0) {
+}
+
+ZodiacBinWriter::~ZodiacBinWriter() {
+	close();
+}
+
+bool ZodiacBinWriter::open(const std::string& file, uint32_t traceRank) {
+	trace = fopen(file.c_str(), "wb");
+	if(NULL == trace) {
+		error = "unable to open " + file + " for writing";
+		return false;
+	}
+
+	rank = traceRank;
+	prevReq = 0;
+	records = 0;
+	used = 0;
+
+	// the record count is filled in by close()
+	ZodiacBinFileHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, ZODIAC_BIN_MAGIC, strlen(ZODIAC_BIN_MAGIC));
+	header.version = ZODIAC_BIN_VERSION;
+	header.rank = rank;
+
+	if(1 != fwrite(&header, sizeof(header), 1, trace)) {
+		error = "unable to write the header of " + file;
+		return false;
+	}
+	bytes = sizeof(header);
+	return true;
+}
+
+bool ZodiacBinWriter::write(const ZodiacBinRecord& rec) {
+	if(buffer.size() - used < ZODIAC_BIN_MAX_RECORD_LENGTH && ! flush()) {
+		return false;
+	}
+	used += zodiacEncodeRecord(rec, rank, prevReq, buffer.data() + used);
+	records++;
+	return true;
+}
+
+bool ZodiacBinWriter::flush() {
+	if(used > 0 && 1 != fwrite(buffer.data(), used, 1, trace)) {
+		error = "write failed";
+		return false;
+	}
+	bytes += used;
+	used = 0;
+	return true;
+}
+
+bool ZodiacBinWriter::close() {
+	if(NULL == trace) {
+		return error.empty();
+	}
+
+	bool ok = flush();
+	if(ok) {
+		const size_t countOffset = offsetof(ZodiacBinFileHeader, records);
+		ok = 0 == fseek(trace, countOffset, SEEK_SET) &&
+			1 == fwrite(&records, sizeof(records), 1, trace);
+		if(! ok) {
+			error = "unable to write the record count";
+		}
+	}
+
+	fclose(trace);
+	trace = NULL;
+	return ok;
+}
+
+ZodiacBinDecoder::ZodiacBinDecoder() :
+	trace(NULL), prevReq(0), decoded(0), pos(0), end(0), eof(false) {
+	memset(&header, 0, sizeof(header));
+}
+
+ZodiacBinDecoder::~ZodiacBinDecoder() {
+	close();
+}
+
+bool ZodiacBinDecoder::open(const std::string& file, size_t chunkBytes) {
+	trace = fopen(file.c_str(), "rb");
+	if(NULL == trace) {
+		error = "unable to open Zodiac binary trace " + file;
+		return false;
+	}
+
+	if(1 != fread(&header, sizeof(header), 1, trace) ||
+		0 != memcmp(header.magic, ZODIAC_BIN_MAGIC, strlen(ZODIAC_BIN_MAGIC))) {
+		error = file + " is not a Zodiac binary trace";
+		return false;
+	}
+
+	if(ZODIAC_BIN_VERSION != header.version) {
+		error = file + " has an unsupported version";
+		return false;
+	}
+
+	buffer.resize(chunkBytes < 2 * ZODIAC_BIN_MAX_RECORD_LENGTH ? 2 * ZODIAC_BIN_MAX_RECORD_LENGTH : chunkBytes);
+	return true;
+}
+
+void ZodiacBinDecoder::close() {
+	if(NULL != trace) {
+		fclose(trace);
+		trace = NULL;
+	}
+}
+
+bool ZodiacBinDecoder::refill() {
+	// move the tail of a record cut by the end of the last chunk to the front
+	memmove(buffer.data(), buffer.data() + pos, end - pos);
+	end -= pos;
+	pos = 0;
+
+	size_t got = fread(buffer.data() + end, 1, buffer.size() - end, trace);
+	if(got < buffer.size() - end) {
+		eof = true;
+	}
+	end += got;
+	return got > 0;
+}
+
+bool ZodiacBinDecoder::next(ZodiacBinRecord& rec) {
+	if(! error.empty() || NULL == trace || decoded == header.records) {
+		return false;
+	}
+
+	if(end - pos < ZODIAC_BIN_MAX_RECORD_LENGTH && ! eof) {
+		refill();
+	}
+
+	memset(&rec, 0, sizeof(rec));
+	size_t used = zodiacDecodeRecord(buffer.data() + pos, buffer.data() + end, header.rank, prevReq, rec);
+	if(0 == used) {
+		error = "corrupt or truncated Zodiac binary trace";
+		return false;
+	}
+
+	pos += used;
+	decoded++;
+	return true;
+}
@@ -0,0 +1,121 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ZODIAC_BIN_FILE
+#define _H_ZODIAC_BIN_FILE
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "zbinformat.h"
+
+namespace SST {
+namespace Zodiac {
+
+// Reads a Sirius trace into the records the Sirius reader would have made
+// events from, in the same order. Used by the converter, so it does not
+// depend on the simulator.
+class ZodiacSiriusParser {
+    public:
+	ZodiacSiriusParser();
+	~ZodiacSiriusParser();
+
+	bool open(const std::string& file);
+	void close();
+
+	// returns false after the finalize record or on an error
+	bool next(ZodiacBinRecord& rec);
+	bool failed() { return ! error.empty(); }
+	const std::string& getError() { return error; }
+
+    private:
+	bool readCall(uint32_t callType);
+	bool read(void* value, size_t bytes);
+	uint8_t convertType(uint32_t dtype);
+	uint8_t convertOp(uint32_t op);
+
+	FILE* trace;
+	double prevEventTime;
+	bool started;
+	bool foundFinalize;
+	bool havePending;
+	ZodiacBinRecord pending;
+	std::string error;
+};
+
+class ZodiacBinWriter {
+    public:
+	ZodiacBinWriter();
+	~ZodiacBinWriter();
+
+	bool open(const std::string& file, uint32_t rank);
+	bool write(const ZodiacBinRecord& rec);
+	bool close();
+
+	uint64_t getRecordCount() { return records; }
+	uint64_t getByteCount() { return bytes; }
+	const std::string& getError() { return error; }
+
+    private:
+	bool flush();
+
+	FILE* trace;
+	uint32_t rank;
+	uint64_t prevReq;
+	uint64_t records;
+	uint64_t bytes;
+	std::vector<uint8_t> buffer;
+	size_t used;
+	std::string error;
+};
+
+// Decodes a binary trace a chunk of the file at a time
+class ZodiacBinDecoder {
+    public:
+	ZodiacBinDecoder();
+	~ZodiacBinDecoder();
+
+	bool open(const std::string& file, size_t chunkBytes = 1 << 20);
+	void close();
+
+	// returns false after the last record or on an error
+	bool next(ZodiacBinRecord& rec);
+	bool failed() { return ! error.empty(); }
+	const std::string& getError() { return error; }
+
+	uint32_t getRank() { return header.rank; }
+	uint64_t getRecordCount() { return header.records; }
+
+    private:
+	bool refill();
+
+	FILE* trace;
+	ZodiacBinFileHeader header;
+	uint64_t prevReq;
+	uint64_t decoded;
+	std::vector<uint8_t> buffer;
+	size_t pos;
+	size_t end;
+	bool eof;
+	std::string error;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,258 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ZODIAC_BIN_FORMAT
+#define _H_ZODIAC_BIN_FORMAT
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Zodiac binary trace format, as written by sst-zodiac-convert. There is
+ * one file per rank, named <prefix>.<rank> like the Sirius traces:
+ *
+ *   file header   "ZODBIN" and two NULs, uint32 version, uint32 rank,
+ *                 uint64 record count
+ *   records       one after the other until the finalize record
+ *
+ * The records are the events the Sirius reader would have generated, with
+ * the compute gaps between calls already worked out. Each record starts
+ * with a byte holding the record type in the low four bits, the data type
+ * in bits 4-5 and the reduction in bits 6-7, followed by the fields of
+ * that type as varints:
+ *
+ *   compute       picoseconds
+ *   send, recv    count, zig-zag peer - rank, zig-zag tag, communicator
+ *   irecv         as recv, then zig-zag request - previous request
+ *   wait          zig-zag request - previous request
+ *   allreduce     count, communicator
+ *   barrier       communicator
+ *   init, finalize
+ *
+ * Integers in the file header are in host byte order.
+ */
+
+#define ZODIAC_BIN_MAGIC           "ZODBIN"
+#define ZODIAC_BIN_MAGIC_LENGTH    8
+#define ZODIAC_BIN_VERSION         1
+
+namespace SST {
+namespace Zodiac {
+
+typedef enum {
+	ZBIN_COMPUTE = 1,
+	ZBIN_SEND,
+	ZBIN_RECV,
+	ZBIN_IRECV,
+	ZBIN_WAIT,
+	ZBIN_ALLREDUCE,
+	ZBIN_BARRIER,
+	ZBIN_INIT,
+	ZBIN_FINALIZE
+} ZodiacBinRecordType;
+
+typedef enum {
+	ZBIN_CHAR = 0,
+	ZBIN_INT,
+	ZBIN_DOUBLE
+} ZodiacBinDataType;
+
+typedef enum {
+	ZBIN_SUM = 0,
+	ZBIN_MAX,
+	ZBIN_MIN
+} ZodiacBinOp;
+
+typedef struct {
+	char     magic[ZODIAC_BIN_MAGIC_LENGTH];
+	uint32_t version;
+	uint32_t rank;
+	uint64_t records;
+} ZodiacBinFileHeader;
+
+// A decoded record, the same size whatever the type so records can be
+// handed between threads in a plain array
+typedef struct {
+	uint8_t  type;
+	uint8_t  dtype;
+	uint8_t  op;
+	int32_t  peer;
+	uint32_t count;
+	int32_t  tag;
+	uint32_t comm;
+	uint64_t req;
+	uint64_t computePs;
+} ZodiacBinRecord;
+
+inline size_t zodiacPutVarint(uint8_t* out, uint64_t value) {
+	size_t n = 0;
+	while(value >= 0x80) {
+		out[n++] = (uint8_t) (value | 0x80);
+		value >>= 7;
+	}
+	out[n++] = (uint8_t) value;
+	return n;
+}
+
+// returns the bytes used, 0 if the varint runs past end or is too long
+inline size_t zodiacGetVarint(const uint8_t* in, const uint8_t* end, uint64_t& value) {
+	value = 0;
+	for(size_t n = 0; n < 10 && in + n < end; n++) {
+		value |= (uint64_t) (in[n] & 0x7f) << (7 * n);
+		if(0 == (in[n] & 0x80)) {
+			return n + 1;
+		}
+	}
+	return 0;
+}
+
+inline uint64_t zodiacZigZag(int64_t value) {
+	return ((uint64_t) value << 1) ^ (uint64_t) (value >> 63);
+}
+
+inline int64_t zodiacUnZigZag(uint64_t value) {
+	return (int64_t) (value >> 1) ^ -(int64_t) (value & 1);
+}
+
+// longest encoding of any record
+#define ZODIAC_BIN_MAX_RECORD_LENGTH  (1 + 5 * 10)
+
+// Encodes rec into out, which has room for ZODIAC_BIN_MAX_RECORD_LENGTH
+// bytes. prevReq carries the request of the last irecv or wait between calls.
+inline size_t zodiacEncodeRecord(const ZodiacBinRecord& rec, uint32_t rank, uint64_t& prevReq, uint8_t* out) {
+	size_t n = 0;
+	out[n++] = (uint8_t) ((rec.type & 0xf) | ((rec.dtype & 0x3) << 4) | ((rec.op & 0x3) << 6));
+
+	switch(rec.type) {
+	case ZBIN_COMPUTE:
+		n += zodiacPutVarint(out + n, rec.computePs);
+		break;
+	case ZBIN_SEND:
+	case ZBIN_RECV:
+	case ZBIN_IRECV:
+		n += zodiacPutVarint(out + n, rec.count);
+		n += zodiacPutVarint(out + n, zodiacZigZag((int64_t) rec.peer - (int64_t) rank));
+		n += zodiacPutVarint(out + n, zodiacZigZag(rec.tag));
+		n += zodiacPutVarint(out + n, rec.comm);
+		if(ZBIN_IRECV == rec.type) {
+			n += zodiacPutVarint(out + n, zodiacZigZag((int64_t) (rec.req - prevReq)));
+			prevReq = rec.req;
+		}
+		break;
+	case ZBIN_WAIT:
+		n += zodiacPutVarint(out + n, zodiacZigZag((int64_t) (rec.req - prevReq)));
+		prevReq = rec.req;
+		break;
+	case ZBIN_ALLREDUCE:
+		n += zodiacPutVarint(out + n, rec.count);
+		n += zodiacPutVarint(out + n, rec.comm);
+		break;
+	case ZBIN_BARRIER:
+		n += zodiacPutVarint(out + n, rec.comm);
+		break;
+	default:
+		break;
+	}
+	return n;
+}
+
+// Decodes the record at in, returns the bytes used or 0 if the record is
+// cut short by end or has an unknown type
+inline size_t zodiacDecodeRecord(const uint8_t* in, const uint8_t* end, uint32_t rank, uint64_t& prevReq,
+	ZodiacBinRecord& rec) {
+
+	if(in >= end) {
+		return 0;
+	}
+
+	const uint8_t* p = in;
+	uint64_t value[5] = { 0, 0, 0, 0, 0 };
+	int fields = 0;
+
+	rec.type  = *p & 0xf;
+	rec.dtype = (*p >> 4) & 0x3;
+	rec.op    = (*p >> 6) & 0x3;
+	p++;
+
+	switch(rec.type) {
+	case ZBIN_COMPUTE:
+	case ZBIN_WAIT:
+	case ZBIN_BARRIER:
+		fields = 1;
+		break;
+	case ZBIN_ALLREDUCE:
+		fields = 2;
+		break;
+	case ZBIN_SEND:
+	case ZBIN_RECV:
+		fields = 4;
+		break;
+	case ZBIN_IRECV:
+		fields = 5;
+		break;
+	case ZBIN_INIT:
+	case ZBIN_FINALIZE:
+		break;
+	default:
+		return 0;
+	}
+
+	for(int i = 0; i < fields; i++) {
+		size_t used = zodiacGetVarint(p, end, value[i]);
+		if(0 == used) {
+			return 0;
+		}
+		p += used;
+	}
+
+	switch(rec.type) {
+	case ZBIN_COMPUTE:
+		rec.computePs = value[0];
+		break;
+	case ZBIN_SEND:
+	case ZBIN_RECV:
+	case ZBIN_IRECV:
+		rec.count = (uint32_t) value[0];
+		rec.peer  = (int32_t) (zodiacUnZigZag(value[1]) + (int64_t) rank);
+		rec.tag   = (int32_t) zodiacUnZigZag(value[2]);
+		rec.comm  = (uint32_t) value[3];
+		if(ZBIN_IRECV == rec.type) {
+			rec.req = prevReq + (uint64_t) zodiacUnZigZag(value[4]);
+			prevReq = rec.req;
+		}
+		break;
+	case ZBIN_WAIT:
+		rec.req = prevReq + (uint64_t) zodiacUnZigZag(value[0]);
+		prevReq = rec.req;
+		break;
+	case ZBIN_ALLREDUCE:
+		rec.count = (uint32_t) value[0];
+		rec.comm  = (uint32_t) value[1];
+		break;
+	case ZBIN_BARRIER:
+		rec.comm = (uint32_t) value[0];
+		break;
+	default:
+		break;
+	}
+
+	return p - in;
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,194 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include "zbinprefetch.h"
+
+using namespace SST::Zodiac;
+
+std::mutex ZodiacBinDecoderPool::poolLock;
+std::weak_ptr<ZodiacBinDecoderPool> ZodiacBinDecoderPool::pool;
+
+std::shared_ptr<ZodiacBinDecoderPool> ZodiacBinDecoderPool::get(uint32_t threads) {
+	std::lock_guard<std::mutex> guard(poolLock);
+
+	std::shared_ptr<ZodiacBinDecoderPool> current = pool.lock();
+	if(! current) {
+		current.reset(new ZodiacBinDecoderPool(threads));
+		pool = current;
+	}
+
+	return current;
+}
+
+ZodiacBinDecoderPool::ZodiacBinDecoderPool(uint32_t threads) : stopping(false) {
+	if(0 == threads) {
+		threads = 1;
+	}
+
+	for(uint32_t i = 0; i < threads; i++) {
+		workers.push_back(std::thread(&ZodiacBinDecoderPool::work, this));
+	}
+}
+
+ZodiacBinDecoderPool::~ZodiacBinDecoderPool() {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	wake.notify_all();
+
+	for(size_t i = 0; i < workers.size(); i++) {
+		workers[i].join();
+	}
+}
+
+void ZodiacBinDecoderPool::submit(ZodiacBinPrefetcher* trace) {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		pending.push_back(trace);
+	}
+	wake.notify_one();
+}
+
+void ZodiacBinDecoderPool::work() {
+	std::unique_lock<std::mutex> guard(lock);
+
+	while(true) {
+		while(! stopping && pending.empty()) {
+			wake.wait(guard);
+		}
+
+		if(pending.empty()) {
+			return;
+		}
+
+		ZodiacBinPrefetcher* trace = pending.front();
+		pending.pop_front();
+
+		guard.unlock();
+		trace->fill();
+		guard.lock();
+	}
+}
+
+ZodiacBinPrefetcher::ZodiacBinPrefetcher(uint32_t ringRecords, uint32_t threads) :
+	pool(ZodiacBinDecoderPool::get(threads)),
+	tail(0), head(0), decoderDone(false), queued(false), waiting(false), stopping(false)
+{
+	uint64_t size = 2;
+	while(size < ringRecords) {
+		size <<= 1;
+	}
+	ring.resize(size);
+	ringMask = size - 1;
+}
+
+ZodiacBinPrefetcher::~ZodiacBinPrefetcher() {
+	close();
+}
+
+bool ZodiacBinPrefetcher::open(const std::string& file, size_t chunkBytes) {
+	return decoder.open(file, chunkBytes);
+}
+
+void ZodiacBinPrefetcher::close() {
+	stopping.store(true);
+
+	// a queued refill still runs, it sees stopping and returns at once
+	std::unique_lock<std::mutex> guard(lock);
+	while(queued.load()) {
+		wake.wait(guard);
+	}
+
+	decoder.close();
+}
+
+void ZodiacBinPrefetcher::request() {
+	if(! decoderDone.load(std::memory_order_acquire) && ! stopping.load(std::memory_order_relaxed) &&
+			! queued.exchange(true)) {
+		pool->submit(this);
+	}
+}
+
+void ZodiacBinPrefetcher::notify() {
+	std::lock_guard<std::mutex> guard(lock);
+	wake.notify_all();
+}
+
+// Runs on a pool worker, never on two at once because the trace is only
+// submitted again after queued is cleared
+void ZodiacBinPrefetcher::fill() {
+	ZodiacBinRecord rec;
+
+	while(! stopping.load(std::memory_order_relaxed)) {
+		const uint64_t slot = tail.load(std::memory_order_relaxed);
+
+		if(slot - head.load(std::memory_order_acquire) == ring.size()) {
+			break;
+		}
+
+		if(! decoder.next(rec)) {
+			decoderDone.store(true);
+			break;
+		}
+
+		ring[slot & ringMask] = rec;
+		tail.store(slot + 1);
+
+		// the reader sets waiting before it looks at tail for the last
+		// time, so one of the two sees the other
+		if(waiting.load()) {
+			notify();
+		}
+	}
+
+	queued.store(false);
+	notify();
+}
+
+bool ZodiacBinPrefetcher::pop(ZodiacBinRecord& rec) {
+	const uint64_t slot = head.load(std::memory_order_relaxed);
+
+	if(slot == tail.load(std::memory_order_acquire)) {
+		std::unique_lock<std::mutex> guard(lock);
+		waiting.store(true);
+
+		while(slot == tail.load() && ! decoderDone.load()) {
+			// the refill may have stopped on a full ring before this
+			// reader emptied it, ask again every time
+			request();
+			wake.wait(guard);
+		}
+
+		waiting.store(false);
+
+		// the decoder may have queued its last record before finishing
+		if(slot == tail.load()) {
+			return false;
+		}
+	}
+
+	rec = ring[slot & ringMask];
+	head.store(slot + 1, std::memory_order_release);
+
+	if(tail.load(std::memory_order_acquire) - (slot + 1) <= ring.size() / 2) {
+		request();
+	}
+
+	return true;
+}
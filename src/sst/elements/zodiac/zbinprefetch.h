@@ -0,0 +1,116 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ZODIAC_BIN_PREFETCH
+#define _H_ZODIAC_BIN_PREFETCH
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "zbinfile.h"
+
+namespace SST {
+namespace Zodiac {
+
+class ZodiacBinPrefetcher;
+
+/*
+ * Threads that decode binary traces ahead of the simulation, one pool for
+ * every trace in the process. A trace asks for a refill when its ring is
+ * half empty and a worker fills it up again, so the number of threads does
+ * not grow with the number of ranks.
+ */
+class ZodiacBinDecoderPool {
+    public:
+	// The pool of this process. The first call starts it with threads
+	// workers, it stops when the last trace lets go of it.
+	static std::shared_ptr<ZodiacBinDecoderPool> get(uint32_t threads);
+	~ZodiacBinDecoderPool();
+
+	void submit(ZodiacBinPrefetcher* trace);
+
+    private:
+	ZodiacBinDecoderPool(uint32_t threads);
+	void work();
+
+	std::mutex lock;
+	std::condition_variable wake;
+	std::deque<ZodiacBinPrefetcher*> pending;
+	bool stopping;
+	std::vector<std::thread> workers;
+
+	static std::mutex poolLock;
+	static std::weak_ptr<ZodiacBinDecoderPool> pool;
+};
+
+/*
+ * The decoded records of one trace. The ring has one writer, the worker
+ * filling it, and one reader, the simulation thread, so records are handed
+ * over with a pair of atomic counters. Only a reader that finds the ring
+ * empty waits, on a condition variable, it never spins.
+ */
+class ZodiacBinPrefetcher {
+    public:
+	ZodiacBinPrefetcher(uint32_t ringRecords, uint32_t threads);
+	~ZodiacBinPrefetcher();
+
+	bool open(const std::string& file, size_t chunkBytes);
+	void close();
+
+	// returns false after the last record or on an error
+	bool pop(ZodiacBinRecord& rec);
+
+	bool failed() { return decoder.failed(); }
+	const std::string& getError() { return decoder.getError(); }
+	uint32_t getRank() { return decoder.getRank(); }
+
+    private:
+	friend class ZodiacBinDecoderPool;
+
+	void request();
+	void fill();
+	void notify();
+
+	std::shared_ptr<ZodiacBinDecoderPool> pool;
+	ZodiacBinDecoder decoder;
+	std::vector<ZodiacBinRecord> ring;
+	uint64_t ringMask;
+
+	// tail is only written by the worker filling the ring and head only by
+	// the simulation thread, they are kept on separate cache lines
+	alignas(64) std::atomic<uint64_t> tail;
+	alignas(64) std::atomic<uint64_t> head;
+	std::atomic<bool> decoderDone;
+	std::atomic<bool> queued;
+	std::atomic<bool> waiting;
+	std::atomic<bool> stopping;
+
+	std::mutex lock;
+	std::condition_variable wake;
+};
+
+}
+}
+
+#endif
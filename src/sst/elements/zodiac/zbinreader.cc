@@ -0,0 +1,153 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include "zbinreader.h"
+#include "zinitevent.h"
+#include "zsendevent.h"
+#include "zirecvevent.h"
+#include "zrecvevent.h"
+#include "zbarrierevent.h"
+#include "zcomputeevent.h"
+#include "zwaitevent.h"
+#include "zfinalizeevent.h"
+#include "zallredevent.h"
+
+using namespace SST;
+using namespace SST::Zodiac;
+using namespace SST::Hermes::MP;
+
+ZodiacBinReader::ZodiacBinReader(const std::string& traceFile, uint32_t focusOnRank, uint32_t maxQLen,
+	std::queue<ZodiacEvent*>* evQ, uint32_t ringRecords, uint32_t decoderThreads, int verbose) :
+	file(traceFile), rank(focusOnRank), qLimit(maxQLen), foundFinalize(false), eventQ(evQ),
+	trace(ringRecords, decoderThreads)
+{
+	output = new Output("ZodiacBinReader", verbose, 0, Output::STDOUT);
+	ownOutput = true;
+
+	// the ring holds the records decoded ahead, the file only needs to be
+	// read in small chunks
+	if(! trace.open(file, 64 * 1024)) {
+		output->fatal(CALL_INFO, -1, "Error: %s\n", trace.getError().c_str());
+	}
+
+	if(trace.getRank() != rank) {
+		output->fatal(CALL_INFO, -1, "Error: %s holds the trace of rank %" PRIu32 ", not rank %" PRIu32 "\n",
+			file.c_str(), trace.getRank(), rank);
+	}
+}
+
+ZodiacBinReader::~ZodiacBinReader() {
+	close();
+	if(ownOutput) {
+		delete output;
+	}
+}
+
+void ZodiacBinReader::close() {
+	trace.close();
+}
+
+void ZodiacBinReader::setOutput(Output* oput) {
+	if(ownOutput) {
+		delete output;
+	}
+	output = oput;
+	ownOutput = false;
+}
+
+uint32_t ZodiacBinReader::generateNextEvents() {
+	ZodiacBinRecord rec;
+
+	while((foundFinalize == false) && (eventQ->size() < qLimit)) {
+		if(! trace.pop(rec)) {
+			if(trace.failed()) {
+				output->fatal(CALL_INFO, -1, "Error: reading %s: %s\n", file.c_str(), trace.getError().c_str());
+			}
+			output->fatal(CALL_INFO, -1, "Error: %s ended before MPI_Finalize\n", file.c_str());
+		}
+		eventQ->push(makeEvent(rec));
+	}
+
+	return (uint32_t) eventQ->size();
+}
+
+ZodiacEvent* ZodiacBinReader::makeEvent(const ZodiacBinRecord& rec) {
+	switch(rec.type) {
+	case ZBIN_COMPUTE:
+		return new ZodiacComputeEvent(rec.computePs * 1.0e-12);
+
+	case ZBIN_SEND:
+		return new ZodiacSendEvent((uint32_t) rec.peer, rec.count,
+			convertToHermesType(rec.dtype), (uint32_t) rec.tag, rec.comm);
+
+	case ZBIN_RECV:
+		return new ZodiacRecvEvent((uint32_t) rec.peer, rec.count,
+			convertToHermesType(rec.dtype), (uint32_t) rec.tag, rec.comm);
+
+	case ZBIN_IRECV:
+		return new ZodiacIRecvEvent((uint32_t) rec.peer, rec.count,
+			convertToHermesType(rec.dtype), (uint32_t) rec.tag, rec.comm, rec.req);
+
+	case ZBIN_WAIT:
+		return new ZodiacWaitEvent(rec.req);
+
+	case ZBIN_ALLREDUCE:
+		return new ZodiacAllreduceEvent(rec.count, convertToHermesType(rec.dtype),
+			convertToHermesOp(rec.op), rec.comm);
+
+	case ZBIN_BARRIER:
+		return new ZodiacBarrierEvent(rec.comm);
+
+	case ZBIN_INIT:
+		return new ZodiacInitEvent();
+
+	case ZBIN_FINALIZE:
+		foundFinalize = true;
+		return new ZodiacFinalizeEvent();
+
+	default:
+		output->fatal(CALL_INFO, -1, "Error: unknown record type %" PRIu8 " in %s\n", rec.type, file.c_str());
+		return NULL;
+	}
+}
+
+PayloadDataType ZodiacBinReader::convertToHermesType(uint8_t dtype) {
+	switch(dtype) {
+	case ZBIN_INT:
+		return INT;
+	case ZBIN_DOUBLE:
+		return DOUBLE;
+	default:
+		return CHAR;
+	}
+}
+
+ReductionOperation ZodiacBinReader::convertToHermesOp(uint8_t op) {
+	switch(op) {
+	case ZBIN_MAX:
+		return MAX;
+	case ZBIN_MIN:
+		return MIN;
+	default:
+		return SUM;
+	}
+}
+
+bool ZodiacBinReader::hasReachedFinalize() {
+	return foundFinalize;
+}
@@ -0,0 +1,71 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ZODIAC_BIN_READER
+#define _H_ZODIAC_BIN_READER
+
+#include <stdint.h>
+
+#include <queue>
+#include <string>
+
+#include "sst/core/output.h"
+#include "sst/elements/hermes/msgapi.h"
+
+#include "zbinprefetch.h"
+#include "zreader.h"
+#include "zevent.h"
+
+namespace SST {
+namespace Zodiac {
+
+/*
+ * Replays a binary trace written by sst-zodiac-convert. The threads of the
+ * process wide decoder pool decode the file into a ring of fixed size
+ * records ahead of the simulation, the simulation thread only turns
+ * records into events.
+ */
+class ZodiacBinReader : public ZodiacReader {
+    public:
+	ZodiacBinReader(const std::string& file, uint32_t rank, uint32_t qLimit,
+		std::queue<ZodiacEvent*>* eventQueue, uint32_t ringRecords, uint32_t decoderThreads, int verbose);
+	~ZodiacBinReader();
+
+	void close();
+	void setOutput(Output* oput);
+	uint32_t generateNextEvents();
+	bool hasReachedFinalize();
+
+    private:
+	ZodiacEvent* makeEvent(const ZodiacBinRecord& rec);
+	Hermes::MP::PayloadDataType convertToHermesType(uint8_t dtype);
+	Hermes::MP::ReductionOperation convertToHermesOp(uint8_t op);
+
+	Output* output;
+	bool ownOutput;
+	std::string file;
+	uint32_t rank;
+	uint32_t qLimit;
+	bool foundFinalize;
+	std::queue<ZodiacEvent*>* eventQ;
+
+	ZodiacBinPrefetcher trace;
+};
+
+}
+}
+
+#endif
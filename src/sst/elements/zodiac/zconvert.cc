@@ -0,0 +1,205 @@
+// Copyright 2009-2022 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2022, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "zbinfile.h"
+
+using namespace SST::Zodiac;
+
+void printUsage() {
+	printf("sst-zodiac-convert [options] <Sirius trace prefix> <output prefix>\n");
+	printf("sst-zodiac-convert --bench [options] <Sirius trace prefix> <binary trace prefix>\n");
+	printf("\n");
+	printf("Converts the per rank Sirius traces <prefix>.<rank> into Zodiac binary\n");
+	printf("traces <output prefix>.<rank>, read with the ZodiacSiriusTraceReader\n");
+	printf("parameter format=zbin.\n");
+	printf("\n");
+	printf("Options:\n");
+	printf("  -n <ranks>    Number of ranks, default is every rank found starting from 0\n");
+	printf("  --bench       Time reading every record of each rank from the Sirius trace\n");
+	printf("                and from the binary trace, nothing is written\n");
+}
+
+static std::string rankFile(const std::string& prefix, uint32_t rank) {
+	return prefix + "." + std::to_string(rank);
+}
+
+static bool convertRank(const std::string& input, const std::string& output, uint32_t rank,
+	uint64_t& inBytes, uint64_t& outBytes, uint64_t& records) {
+
+	ZodiacSiriusParser parser;
+	if(! parser.open(input)) {
+		fprintf(stderr, "Error: %s\n", parser.getError().c_str());
+		return false;
+	}
+
+	ZodiacBinWriter writer;
+	if(! writer.open(output, rank)) {
+		fprintf(stderr, "Error: %s\n", writer.getError().c_str());
+		return false;
+	}
+
+	ZodiacBinRecord rec;
+	while(parser.next(rec)) {
+		if(! writer.write(rec)) {
+			fprintf(stderr, "Error: writing %s: %s\n", output.c_str(), writer.getError().c_str());
+			return false;
+		}
+	}
+
+	if(parser.failed()) {
+		fprintf(stderr, "Error: reading %s: %s\n", input.c_str(), parser.getError().c_str());
+		return false;
+	}
+
+	if(! writer.close()) {
+		fprintf(stderr, "Error: writing %s: %s\n", output.c_str(), writer.getError().c_str());
+		return false;
+	}
+
+	FILE* in = fopen(input.c_str(), "rb");
+	if(NULL != in) {
+		fseek(in, 0, SEEK_END);
+		inBytes += ftell(in);
+		fclose(in);
+	}
+	outBytes += writer.getByteCount();
+	records += writer.getRecordCount();
+	return true;
+}
+
+template<class T>
+static bool timeRead(T& reader, const std::string& file, double& seconds, uint64_t& records) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	if(! reader.open(file)) {
+		fprintf(stderr, "Error: %s\n", reader.getError().c_str());
+		return false;
+	}
+
+	ZodiacBinRecord rec;
+	while(reader.next(rec)) {
+		records++;
+	}
+
+	if(reader.failed()) {
+		fprintf(stderr, "Error: reading %s: %s\n", file.c_str(), reader.getError().c_str());
+		return false;
+	}
+
+	seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return true;
+}
+
+int main(int argc, char* argv[]) {
+	bool bench = false;
+	int64_t numRanks = -1;
+	std::vector<std::string> files;
+
+	for(int i = 1; i < argc; i++) {
+		const bool hasValue = (i + 1 < argc);
+
+		if(std::strcmp(argv[i], "--help") == 0 ||
+			std::strcmp(argv[i], "-help") == 0 ||
+			std::strcmp(argv[i], "-h") == 0) {
+
+			printUsage();
+			exit(0);
+		} else if(std::strcmp(argv[i], "--bench") == 0) {
+			bench = true;
+		} else if(std::strcmp(argv[i], "-n") == 0 && hasValue) {
+			numRanks = strtol(argv[++i], NULL, 10);
+		} else if(argv[i][0] == '-') {
+			fprintf(stderr, "Error: unknown option %s\n", argv[i]);
+			printUsage();
+			exit(-1);
+		} else {
+			files.push_back(argv[i]);
+		}
+	}
+
+	if(files.size() != 2) {
+		printUsage();
+		exit(-1);
+	}
+
+	if(numRanks < 0) {
+		numRanks = 0;
+		while(0 == access(rankFile(files[0], numRanks).c_str(), R_OK)) {
+			numRanks++;
+		}
+	}
+
+	if(0 == numRanks) {
+		fprintf(stderr, "Error: no trace found at %s\n", rankFile(files[0], 0).c_str());
+		exit(-1);
+	}
+
+	if(bench) {
+		double siriusSeconds = 0;
+		double binSeconds = 0;
+		uint64_t siriusRecords = 0;
+		uint64_t binRecords = 0;
+
+		for(uint32_t rank = 0; rank < numRanks; rank++) {
+			ZodiacSiriusParser parser;
+			ZodiacBinDecoder decoder;
+
+			if(! timeRead(parser, rankFile(files[0], rank), siriusSeconds, siriusRecords) ||
+				! timeRead(decoder, rankFile(files[1], rank), binSeconds, binRecords)) {
+				exit(-1);
+			}
+		}
+
+		if(siriusRecords != binRecords) {
+			fprintf(stderr, "Error: Sirius traces hold %" PRIu64 " records, binary traces %" PRIu64 "\n",
+				siriusRecords, binRecords);
+			exit(-1);
+		}
+
+		printf("%-8s %-12s %-12s %-16s\n", "Format", "Records", "Seconds", "Records/s");
+		printf("%-8s %-12" PRIu64 " %-12.6f %-16.0f\n", "sirius", siriusRecords, siriusSeconds,
+			siriusSeconds > 0 ? siriusRecords / siriusSeconds : 0.0);
+		printf("%-8s %-12" PRIu64 " %-12.6f %-16.0f\n", "zbin", binRecords, binSeconds,
+			binSeconds > 0 ? binRecords / binSeconds : 0.0);
+		return 0;
+	}
+
+	uint64_t inBytes = 0;
+	uint64_t outBytes = 0;
+	uint64_t records = 0;
+
+	for(uint32_t rank = 0; rank < numRanks; rank++) {
+		if(! convertRank(rankFile(files[0], rank), rankFile(files[1], rank), rank, inBytes, outBytes, records)) {
+			exit(-1);
+		}
+	}
+
+	printf("Converted %" PRId64 " ranks, %" PRIu64 " records, %" PRIu64 " bytes to %" PRIu64 " bytes\n",
+		numRanks, records, inBytes, outBytes);
+	return 0;
+}
@@ -14,28 +14,26 @@
 // distribution.
 
 
-#ifndef _H_SST_ARIEL_FREE_EVENT
-#define _H_SST_ARIEL_FREE_EVENT
+#ifndef _H_ZODIAC_READER
+#define _H_ZODIAC_READER
 
-#include "arielevent.h"
+#include <stdint.h>
 
-using namespace SST;
+#include "sst/core/output.h"
 
 namespace SST {
-namespace ArielComponent {
-
-class ArielFreeEvent : public ArielEvent {
+namespace Zodiac {
 
+// A per rank trace that fills the replaying component's event queue
+class ZodiacReader {
     public:
-        ArielFreeEvent(uint64_t vAddr) : virtualAddress(vAddr) {}
-        ~ArielFreeEvent() {}
-
-        ArielEventType getEventType() const { return FREE; }
-        uint64_t getVirtualAddress() const { return virtualAddress; }
-
-    protected:
-        const uint64_t virtualAddress;
+	virtual ~ZodiacReader() {}
+	virtual void close() = 0;
+	virtual void setOutput(Output* oput) = 0;
 
+	// refills the queue up to its limit, returns the number queued
+	virtual uint32_t generateNextEvents() = 0;
+	virtual bool hasReachedFinalize() = 0;
 };
 
 }
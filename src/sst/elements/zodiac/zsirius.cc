@@ -67,6 +67,14 @@ ZodiacSiriusTraceReader::ZodiacSiriusTraceReader(ComponentId_t id, Params& param
         std::cout << "Trace prefix: " << trace_file << std::endl;
     }
 
+    trace_format = params.find<std::string>("format", "sirius");
+    if("sirius" != trace_format && "zbin" != trace_format) {
+        std::cerr << "Error: unknown trace format " << trace_format << std::endl;
+        exit(-1);
+    }
+    ringRecords = params.find<uint32_t>("ringrecords", 4096);
+    decoderThreads = params.find<uint32_t>("decoderthreads", 1);
+
     eventQ = new std::queue<ZodiacEvent*>();
 
     verbosityLevel = params.find("verbose", 0);
@@ -101,7 +109,11 @@ void ZodiacSiriusTraceReader::setup() {
     sprintf(trace_name, "%s.%d", trace_file.c_str(), rank);
 
     printf("Opening trace file: %s\n", trace_name);
-    trace = new SiriusReader(trace_name, rank, 64, eventQ, verbosityLevel);
+    if("zbin" == trace_format) {
+        trace = new ZodiacBinReader(trace_name, rank, 64, eventQ, ringRecords, decoderThreads, verbosityLevel);
+    } else {
+        trace = new SiriusReader(trace_name, rank, 64, eventQ, verbosityLevel);
+    }
     trace->setOutput(&zOut);
 
     int count = trace->generateNextEvents();
@@ -31,6 +31,7 @@
 #include <sst/elements/hermes/msgapi.h>
 
 #include "siriusreader.h"
+#include "zbinreader.h"
 #include "zevent.h"
 
 using namespace SST::Hermes;
@@ -58,6 +59,9 @@ public:
 
   SST_ELI_DOCUMENT_PARAMS(
 	{ "trace", "Set the trace file to be read in for this end point." },
+	{ "format", "Format of the trace, sirius or zbin for binary traces written by sst-zodiac-convert", "sirius" },
+	{ "ringrecords", "Records a zbin trace decodes ahead of the simulation", "4096" },
+	{ "decoderthreads", "Threads decoding zbin traces for all the ranks of the process, the first rank to start sets it", "1" },
 	{ "os.module", "Sets the messaging API to use for generation and handling of the message protocol" },
 	{ "scalecompute", "Scale compute event times by a double precision value (allows dilation of times in traces), default is 1.0", "1.0" },
 	{ "verbose", "Sets the verbosity level for the component to output debug/information messages", "0" },
@@ -108,7 +112,7 @@ private:
   Output zOut;
   OS* os;
   MP::Interface* msgapi;
-  SiriusReader* trace;
+  ZodiacReader* trace;
   std::queue<ZodiacEvent*>* eventQ;
   SST::Link* selfLink;
   SST::TimeConverter* tConv;
@@ -129,6 +133,9 @@ private:
   MessageResponse* currentRecv;
   int rank;
   string trace_file;
+  string trace_format;
+  uint32_t ringRecords;
+  uint32_t decoderThreads;
   int verbosityLevel;
 
   uint64_t zSendCount;